@@ -246,6 +246,7 @@
 
 #include "Framework/Conventions/Units.h"
 #include "Framework/EventGen/EventRecord.h"
+#include "Framework/EventGen/EventRecordPool.h"
 #include "Framework/EventGen/GFluxI.h"
 #include "Framework/EventGen/GMCJDriver.h"
 #include "Framework/EventGen/GMCJMonitor.h"
@@ -412,7 +413,7 @@ int main(int argc, char** argv)
     mcjmonitor.Update(iev,event);
 
     // clean-up
-    delete event;
+    EventRecordPool::Instance()->Release(event);
 
     if (gOptSecExposure > 0 && mcj_driver->NFluxNeutrinos()/mcj_driver->GlobProbScale() > expected_neutrinos) {
       break;
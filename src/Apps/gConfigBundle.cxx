@@ -0,0 +1,129 @@
+//____________________________________________________________________________
+/*!
+
+\program gcfgbundle
+
+\brief   Compiles the GENIE XML algorithm configuration of a tune into a
+         binary configuration bundle that AlgConfigPool can memory-map.
+
+         A bundle is used by passing it to any GENIE application with the
+         --config-bundle option (or by setting the GCONFIGBUNDLE environment
+         variable). No XML file is then parsed at start-up: the bundle is
+         mapped read-only, so all jobs running on the same node share a single
+         copy, and each configuration registry is only built when it is first
+         requested. A checksum stored in the bundle is verified when it is
+         loaded, and a bundle is refused if it was compiled for a tune other
+         than the one requested.
+
+         Syntax :
+           gcfgbundle [--tune tune_name] [--xml-path path] -o output.gcfg
+                      [--message-thresholds xml_file]
+
+         Options :
+           --tune
+              The tune whose configuration is compiled
+           --xml-path
+              XML path override, as in all GENIE applications
+           -o
+              output bundle file
+           --message-thresholds
+              Allows users to customize the message stream thresholds.
+              The thresholds are specified using an XML file.
+              See $GENIE/config/Messenger.xml for the XML schema.
+
+         Examples :
+
+           shell% gcfgbundle --tune G18_02a_00_000 -o G18_02a_00_000.gcfg
+           shell% gevgen ... --tune G18_02a_00_000 --config-bundle G18_02a_00_000.gcfg
+
+\author  GENIE Collaboration
+
+\created October 16, 2026
+
+\cpright Copyright (c) 2003-2023, The GENIE Collaboration
+         For the full text of the license visit http://copyright.genie-mc.org
+
+*/
+//____________________________________________________________________________
+
+#include <cstdlib>
+#include <string>
+
+#include <TSystem.h>
+
+#include "Framework/Algorithm/AlgConfigPool.h"
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Utils/RunOpt.h"
+#include "Framework/Utils/AppInit.h"
+#include "Framework/Utils/CmdLnArgParser.h"
+
+using std::string;
+
+using namespace genie;
+
+void GetCommandLineArgs (int argc, char ** argv);
+void PrintSyntax        (void);
+
+//User-specified options:
+string gOutFile;   ///< output bundle file
+
+//____________________________________________________________________________
+int main(int argc, char ** argv)
+{
+  // the configuration must be compiled from the XML files
+  gSystem->Unsetenv("GCONFIGBUNDLE");
+
+  GetCommandLineArgs(argc,argv);
+
+  utils::app_init::MesgThresholds(RunOpt::Instance()->MesgThresholdFiles());
+
+  RunOpt::Instance()->BuildTune();
+
+  LOG("gcfgbundle", pNOTICE)
+     << " ****** Compiling the configuration of tune "
+     << RunOpt::Instance()->Tune()->Name() << " into : " << gOutFile;
+  bool ok = AlgConfigPool::Instance()->SaveBundle(gOutFile);
+  if(!ok) {
+    LOG("gcfgbundle", pFATAL) << "Could not write: " << gOutFile;
+    exit(1);
+  }
+
+  return 0;
+}
+//____________________________________________________________________________
+void GetCommandLineArgs(int argc, char ** argv)
+{
+  LOG("gcfgbundle", pNOTICE) << "Parsing command line arguments";
+
+  // Common run options.
+  RunOpt::Instance()->ReadFromCommandLine(argc,argv);
+
+  if( RunOpt::Instance()->ConfigBundle().size() > 0 ) {
+    LOG("gcfgbundle", pFATAL)
+      << "The --config-bundle option can not be used when compiling a bundle";
+    PrintSyntax();
+    exit(1);
+  }
+
+  // Parse run options for this app
+
+  CmdLnArgParser parser(argc,argv);
+
+  if( parser.OptionExists('o') ) {
+    LOG("gcfgbundle", pINFO) << "Reading output file name";
+    gOutFile = parser.ArgAsString('o');
+  } else {
+    LOG("gcfgbundle", pFATAL) << "You must specify an output file name";
+    PrintSyntax();
+    exit(1);
+  }
+}
+//____________________________________________________________________________
+void PrintSyntax(void)
+{
+  LOG("gcfgbundle", pNOTICE)
+    << "\n\n" << "Syntax:" << "\n"
+    << "   gcfgbundle [--tune tune_name] [--xml-path path] -o output.gcfg\n"
+    << "              [--message-thresholds xml_file]\n";
+}
+//____________________________________________________________________________
@@ -8,14 +8,21 @@
          with MC truth quantity plots (& comparisons with a reference event 
          sample is specified)
 
+         All plots are booked up-front from a declarative plot list and are
+         filled in a single pass over each input file (the test sample takes
+         an extra, usually partial, pass to determine the histogram ranges
+         exactly as TTree::Draw() would).
+
          Syntax :
-           gevcomp -f sample [-r reference_sample]
+           gevcomp -f sample [-r reference_sample] [-j nthreads]
 
          Options:
            [] Denotes an optional argument
            -f Specifies the GENIE/ROOT file with the generated event sample
 	   -r Specifies another GENIE/ROOT event sample file for comparison 
            -n Specifies how many events to analyze [default: all]
+           -j Number of threads used for decompressing the input trees
+              [default: 0, no multithreading]
 
          Notes:
            The input ROOT files are the gst summary ntuples generated by 
@@ -36,13 +43,22 @@
 //____________________________________________________________________________
 
 #include <cassert>
+#include <cfloat>
+#include <map>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <TSystem.h>
+#include <TROOT.h>
+#include <TEnv.h>
 #include <TFile.h>
 #include <TDirectory.h>
 #include <TTree.h>
+#include <TTreeFormula.h>
+#include <TTreeFormulaManager.h>
+#include <TTreeCacheUnzip.h>
+#include <TLeaf.h>
 #include <TVector3.h>
 #include <TLorentzVector.h>
 #include <TPostScript.h>
@@ -55,6 +71,7 @@
 #include <TText.h>
 #include <TStyle.h>
 #include <TLegend.h>
+#include <THLimitsFinder.h>
 
 #include "Framework/Messenger/Messenger.h"
 #include "Framework/ParticleData/PDGUtils.h"
@@ -64,19 +81,63 @@
 
 using std::ostringstream;
 using std::string;
+using std::vector;
+using std::map;
+using std::pair;
 
 using namespace genie;
 
+// declarative plot list
+typedef enum EGstPage {
+  kPgText = 0,  // text page
+  kPgCounts,    // event numbers
+  kPgPlots      // 1 plot, or 4 plots in a 2x2 grid
+} GstPage_t;
+
+typedef pair<string,string> GstPlotSpec_t; // (variable, selection)
+
+struct GstPlot_t {
+  string   var;        // plotted variable
+  string   sel;        // selection (used as weight, as in TTree::Draw)
+  bool     count_only; // only count the selected entries
+  double   vmin;       // range of the first `estimate' selected values
+  double   vmax;       //   of the test sample (as TTree::Draw)
+  Long64_t nest;       // number of values used for the range estimate
+  TH1F *   hist[2];    // test & reference sample histograms
+  double   nsel[2];    // number of selected entries in test & reference sample
+};
+
+struct GstPageDef_t {
+  GstPage_t      type;
+  vector<string> text;   // text lines, or event number labels
+  vector<int>    plots;  // indices in gPlots
+  string         header; // legend header
+};
+
+vector<GstPlot_t>    gPlots;
+vector<GstPageDef_t> gPages;
+map<string,int>      gPlotIdx;
+
 // function prototypes
 void   GetCommandLineArgs   (int argc, char ** argv);
 void   PrintSyntax          (void);
 bool   CheckRootFilename    (string filename);
 string OutputFileName       (string input_file_name);
 void   CreatePlots          (string filename, string filename_ref);
+void   BookPages            (bool show_coh_plots);
+int    AddPlot              (string var, string sel, bool count_only=false);
+void   AddTextPage          (vector<string> text);
+void   AddCountPage         (vector<GstPlotSpec_t> counts);
+void   AddPlotPage          (string var, string sel, string header);
+void   AddPlotPage          (vector<GstPlotSpec_t> plots, string header);
+void   ProcessTree          (TTree * tree, int isample, bool estimate);
+void   BookHistograms       (TTree * tree, int isample);
+void   DrawPages            (TPostScript * ps, TCanvas * c, TLegend * ls, bool has_ref);
 
 // command-line arguments
 string   gOptInpFile     = ""; // (-f) input GENIE event sample file
 string   gOptInpFileRef  = ""; // (-r) input GENIE event sample file (reference)
+int      gOptNThreads    = 0;  // (-j) number of threads for tree decompression
 
 //_________________________________________________________________________________
 int main(int argc, char ** argv)
@@ -119,6 +180,16 @@ void CreatePlots(string inp_filename, string inp_filename_ref)
     gst_1->SetMarkerStyle(20);
     gst_1->SetMarkerSize(1);
   }
+
+  if(gOptNThreads > 0) {
+#ifdef R__USE_IMT
+    ROOT::EnableImplicitMT(gOptNThreads);
+    TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+#else
+    LOG("gevcomp", pWARN)
+      << "ROOT was built without implicit multithreading - Ignoring -j";
+#endif
+  }
   
   // Set global plot style
   //
@@ -126,17 +197,25 @@ void CreatePlots(string inp_filename, string inp_filename_ref)
   gStyle->SetOptStat(0);
   gStyle->SetHistTopMargin(0.33);
   gStyle->SetHistMinimumZero(true);
-  
-  // Plotting options
+
+  // Book all plots (reads only the tgt branch)
   //
-  bool monoenergetic_sample = true;
-  bool show_coh_plots       = true;
-  bool show_calc_kinematics = true;
-  bool show_mult_per_proc   = true;
-  bool show_primary_hadsyst = true;
-  
-  gst_0->Draw("1","tgt>1000010010","GOFF");
-  show_coh_plots = (gst_0->GetSelectedRows() > 0); 
+  bool show_coh_plots = (gst_0->GetEntries("tgt>1000010010") > 0);
+  BookPages(show_coh_plots);
+
+  LOG("gevcomp", pNOTICE)
+    << "Booked " << gPlots.size() << " plots on " << gPages.size() << " pages";
+
+  // Fill all plots: the test sample histogram ranges are estimated as in
+  // TTree::Draw() and the reference sample histograms use the same binning
+  //
+  ProcessTree   (gst_0, 0, true);
+  BookHistograms(gst_0, 0);
+  ProcessTree   (gst_0, 0, false);
+  if(gst_1) {
+    BookHistograms(gst_1, 1);
+    ProcessTree   (gst_1, 1, false);
+  }
 
   TCanvas * c = new TCanvas("c","",20,20,500,650);
   c->SetBorderMode(0);
@@ -150,664 +229,251 @@ void CreatePlots(string inp_filename, string inp_filename_ref)
 
   string ps_filename = OutputFileName(inp_filename);
   TPostScript * ps = new TPostScript(ps_filename.c_str(), 111);
-  
+
+  DrawPages(ps, c, ls, gst_1 != 0);
+
+  ps->Close();
+
+  fin_0->Close();
+  delete fin_0;
+  if(fin_1) {
+     fin_1->Close();
+     delete fin_1;
+  }
+}
+//_________________________________________________________________________________
+void BookPages(bool show_coh_plots)
+{
+  // Plotting options
+  //
+  bool monoenergetic_sample = true;
+  bool show_calc_kinematics = true;
+  bool show_mult_per_proc   = true;
+  bool show_primary_hadsyst = true;
+
   //
   // SECTION: PS File Header
   //
-
-  ps->NewPage();
-  c->Range(0,0,100,100);
-  TPavesText hdr(10,40,90,70,3,"tr");
-  hdr.AddText("GENIE Event Sample Comparisons");
-  hdr.AddText(" ");
-  hdr.AddText(" ");
-  hdr.AddText("Event Sample:");
-  //hdr.AddText(sample);
-  hdr.AddText(" ");
-  hdr.AddText("Notes:");
-  hdr.AddText(" ");
-  hdr.AddText(" ");
-  hdr.Draw();
-  c->Update();
+  AddTextPage({
+    "GENIE Event Sample Comparisons",
+    " ",
+    " ",
+    "Event Sample:",
+    " ",
+    "Notes:",
+    " ",
+    " "
+  });
 
   //
   // SECTION: Event Numbers
   //
-
-  TH1F * h0num = new TH1F("h0num","", 2, 0., 2.);
-  TH1F * h1num = new TH1F("h1num","", 2, 0., 2.);
-  float n0=0, n1=0;
-  ps->NewPage();
-  c->Range(0,0,100,100);
-  TPavesText evn(10,10,90,90,3,"tr");
-  evn.AddText("Event Numbers:");
-  evn.AddText("  ");
- 
-            gst_0->Draw("1>>h0num","1","goff");
-  if(gst_1) gst_1->Draw("1>>h1num","1","goff");
-  n0 =           h0num->GetEntries();
-  n1 = (gst_1) ? h1num->GetEntries() : 0;
-  evn.AddText( Form("ALL    : %7.0f [test sample], %7.0f [ref sample]", n0, n1) );
-
-            gst_0->Draw("1>>h0num","qel","goff");
-  if(gst_1) gst_1->Draw("1>>h1num","qel","goff");
-  n0 =           h0num->GetEntries();
-  n1 = (gst_1) ? h1num->GetEntries() : 0;
-  evn.AddText( Form("QEL    : %7.0f [test sample], %7.0f [ref sample]", n0, n1) );
-
-            gst_0->Draw("1>>h0num","qel&&cc","goff");
-  if(gst_1) gst_1->Draw("1>>h1num","qel&&cc","goff");
-  n0 =           h0num->GetEntries();
-  n1 = (gst_1) ? h1num->GetEntries() : 0;
-  evn.AddText( Form("QEL-CC : %7.0f [test sample], %7.0f [ref sample]", n0, n1) );
-
-            gst_0->Draw("1>>h0num","qel&&nc","goff");
-  if(gst_1) gst_1->Draw("1>>h1num","qel&&nc","goff");
-  n0 =           h0num->GetEntries();
-  n1 = (gst_1) ? h1num->GetEntries() : 0;
-  evn.AddText( Form("QEL-NC : %7.0f [test sample], %7.0f [ref sample]", n0, n1) );
-
-            gst_0->Draw("1>>h0num","res","goff");
-  if(gst_1) gst_1->Draw("1>>h1num","res","goff");
-  n0 =           h0num->GetEntries();
-  n1 = (gst_1) ? h1num->GetEntries() : 0;
-  evn.AddText( Form("RES    : %7.0f [test sample], %7.0f [ref sample]", n0, n1) );
-
-            gst_0->Draw("1>>h0num","res&&cc","goff");
-  if(gst_1) gst_1->Draw("1>>h1num","res&&cc","goff");
-  n0 =           h0num->GetEntries();
-  n1 = (gst_1) ? h1num->GetEntries() : 0;
-  evn.AddText( Form("RES-CC : %7.0f [test sample], %7.0f [ref sample]", n0, n1) );
-
-            gst_0->Draw("1>>h0num","res&&nc","goff");
-  if(gst_1) gst_1->Draw("1>>h1num","res&&nc","goff");
-  n0 =           h0num->GetEntries();
-  n1 = (gst_1) ? h1num->GetEntries() : 0;
-  evn.AddText( Form("RES-NC : %7.0f [test sample], %7.0f [ref sample]", n0, n1) );
-
-            gst_0->Draw("1>>h0num","dis","goff");
-  if(gst_1) gst_1->Draw("1>>h1num","dis","goff");
-  n0 =           h0num->GetEntries();
-  n1 = (gst_1) ? h1num->GetEntries() : 0;
-  evn.AddText( Form("DIS    : %7.0f [test sample], %7.0f [ref sample]", n0, n1) );
-
-            gst_0->Draw("1>>h0num","dis&&cc","goff");
-  if(gst_1) gst_1->Draw("1>>h1num","dis&&cc","goff");
-  n0 =           h0num->GetEntries();
-  n1 = (gst_1) ? h1num->GetEntries() : 0;
-  evn.AddText( Form("DIS-CC : %7.0f [test sample], %7.0f [ref sample]", n0, n1) );
-
-            gst_0->Draw("1>>h0num","dis&&nc","goff");
-  if(gst_1) gst_1->Draw("1>>h1num","dis&&nc","goff");
-  n0 =           h0num->GetEntries();
-  n1 = (gst_1) ? h1num->GetEntries() : 0;
-  evn.AddText( Form("DIS-NC : %7.0f [test sample], %7.0f [ref sample]", n0, n1) );
-
-            gst_0->Draw("1>>h0num","coh","goff");
-  if(gst_1) gst_1->Draw("1>>h1num","coh","goff");
-  n0 =           h0num->GetEntries();
-  n1 = (gst_1) ? h1num->GetEntries() : 0;
-  evn.AddText( Form("COH      : %7.0f [test sample], %7.0f [ref sample]", n0, n1) );
-
-            gst_0->Draw("1>>h0num","coh&&cc","goff");
-  if(gst_1) gst_1->Draw("1>>h1num","coh&&cc","goff");
-  n0 =           h0num->GetEntries();
-  n1 = (gst_1) ? h1num->GetEntries() : 0;
-  evn.AddText( Form("COH-CC   : %7.0f [test sample], %7.0f [ref sample]", n0, n1) );
-
-            gst_0->Draw("1>>h0num","coh&&nc","goff");
-  if(gst_1) gst_1->Draw("1>>h1num","coh&&nc","goff");
-  n0 =           h0num->GetEntries();
-  n1 = (gst_1) ? h1num->GetEntries() : 0;
-  evn.AddText( Form("COH-NC   : %7.0f [test sample], %7.0f [ref sample]", n0, n1) );
-
-            gst_0->Draw("1>>h0num","imd","goff");
-  if(gst_1) gst_1->Draw("1>>h1num","imd","goff");
-  n0 =           h0num->GetEntries();
-  n1 = (gst_1) ? h1num->GetEntries() : 0;
-  evn.AddText( Form("IMD    : %7.0f [test sample], %7.0f [ref sample]", n0, n1) );
-
-            gst_0->Draw("1>>h0num","nuel","goff");
-  if(gst_1) gst_1->Draw("1>>h1num","nuel","goff");
-  n0 =           h0num->GetEntries();
-  n1 = (gst_1) ? h1num->GetEntries() : 0;
-  evn.AddText( Form("NuE-EL : %7.0f [test sample], %7.0f [ref sample]", n0, n1) );
-
-            gst_0->Draw("1>>h0num","dis&&cc&&charm","goff");
-  if(gst_1) gst_1->Draw("1>>h1num","dis&&cc&&charm","goff");
-  n0 =           h0num->GetEntries();
-  n1 = (gst_1) ? h1num->GetEntries() : 0;
-  evn.AddText( Form("DIS-CHARM: %7.0f [test sample], %7.0f [ref sample]", n0, n1) );
-
-            gst_0->Draw("1>>h0num","qel&&cc&&charm","goff");
-  if(gst_1) gst_1->Draw("1>>h1num","qel&&cc&&charm","goff");
-  n0 =           h0num->GetEntries();
-  n1 = (gst_1) ? h1num->GetEntries() : 0;
-  evn.AddText( Form("QEL-CHARM: %7.0f [test sample], %7.0f [ref sample]", n0, n1) );
-
-  evn.Draw();
-  c->Update();
+  AddCountPage({
+    { "ALL    ",   "1"              },
+    { "QEL    ",   "qel"            },
+    { "QEL-CC ",   "qel&&cc"        },
+    { "QEL-NC ",   "qel&&nc"        },
+    { "RES    ",   "res"            },
+    { "RES-CC ",   "res&&cc"        },
+    { "RES-NC ",   "res&&nc"        },
+    { "DIS    ",   "dis"            },
+    { "DIS-CC ",   "dis&&cc"        },
+    { "DIS-NC ",   "dis&&nc"        },
+    { "COH      ", "coh"            },
+    { "COH-CC   ", "coh&&cc"        },
+    { "COH-NC   ", "coh&&nc"        },
+    { "IMD    ",   "imd"            },
+    { "NuE-EL ",   "nuel"           },
+    { "DIS-CHARM", "dis&&cc&&charm" },
+    { "QEL-CHARM", "qel&&cc&&charm" }
+  });
 
   if(!monoenergetic_sample) {
-              gst_0->Draw("Ev","","");
-    if(gst_1) gst_1->Draw("Ev","","perrsame");
-    ls->Clear();
-    ls->SetHeader("Neutrino Energy Spectrum");
-    ls->Draw();
-    c->Update();  
+    AddPlotPage("Ev", "", "Neutrino Energy Spectrum");
   }
 
   //
   // SECTION: Kinematics
   //
-  ps->NewPage();
-  c->Clear();
-  c->Range(0,0,100,100);
-  TPavesText hdrk(10,40,90,70,3,"tr");
-  hdrk.AddText("Selected Kinematical Quantities");
-  hdrk.AddText(" ");
-  hdrk.Draw();
-  c->Update();
+  AddTextPage({"Selected Kinematical Quantities", " "});
 
   //------ selected Q2 for all events
-  ps->NewPage();
-  gst_0->Draw("Q2s","Q2s>0","");
-  if(gst_1) gst_1->Draw("Q2s","Q2s>0","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected Q2 for all events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("Q2s", "Q2s>0", "selected Q2 for all events");
 
   //------ selected Q2 for QEL
-  ps->NewPage();
-  gst_0->Draw("Q2s","qel&&!charm","");
-  if(gst_1) gst_1->Draw("Q2s","qel&&!charm","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected Q2 for QEL events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("Q2s", "qel&&!charm", "selected Q2 for QEL events");
 
   //------ selected Q2 for QEL CC
-  ps->NewPage();
-  gst_0->Draw("Q2s","qel&&cc&&!charm","");
-  if(gst_1) gst_1->Draw("Q2s","qel&&cc&&!charm","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected Q2 for QEL CC events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("Q2s", "qel&&cc&&!charm", "selected Q2 for QEL CC events");
 
   //------ selected Q2 for QEL NC
-  ps->NewPage();
-  gst_0->Draw("Q2s","qel&&nc&&!charm","");
-  if(gst_1) gst_1->Draw("Q2s","qel&&nc&&!charm","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected Q2 for QEL NC events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("Q2s", "qel&&nc&&!charm", "selected Q2 for QEL NC events");
 
   //------ selected Q2 for RES
-  ps->NewPage();
-  gst_0->Draw("Q2s","res","");
-  if(gst_1) gst_1->Draw("Q2s","res","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected Q2 for RES events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("Q2s", "res", "selected Q2 for RES events");
 
   //------ selected Q2 for RES CC
-  ps->NewPage();
-  gst_0->Draw("Q2s","res&&cc","");
-  if(gst_1) gst_1->Draw("Q2s","res&&cc","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected Q2 for RES CC events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("Q2s", "res&&cc", "selected Q2 for RES CC events");
 
   //------ selected Q2 for RES NC
-  ps->NewPage();
-  gst_0->Draw("Q2s","res&&nc","");
-  if(gst_1) gst_1->Draw("Q2s","res&&nc","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected Q2 for RES NC events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("Q2s", "res&&nc", "selected Q2 for RES NC events");
 
   //------ selected Q2 for DIS
-  ps->NewPage();
-  gst_0->Draw("Q2s","dis","");
-  if(gst_1) gst_1->Draw("Q2s","dis","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected Q2 for DIS events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("Q2s", "dis", "selected Q2 for DIS events");
 
   //------ selected Q2 for DIS CC
-  ps->NewPage();
-  gst_0->Draw("Q2s","dis&&cc","");
-  if(gst_1) gst_1->Draw("Q2s","dis&&cc","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected Q2 for DIS CC events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("Q2s", "dis&&cc", "selected Q2 for DIS CC events");
 
   //------ selected Q2 for DIS NC
-  ps->NewPage();
-  gst_0->Draw("Q2s","dis&&nc","");
-  if(gst_1) gst_1->Draw("Q2s","dis&&nc","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected Q2 for DIS NC events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("Q2s", "dis&&nc", "selected Q2 for DIS NC events");
 
   //------ selected Q2 for Charm/DIS
-  ps->NewPage();
-  gst_0->Draw("Q2s","dis&&charm","");
-  if(gst_1) gst_1->Draw("Q2s","dis&&charm","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected Q2 for Charm/DIS events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("Q2s", "dis&&charm", "selected Q2 for Charm/DIS events");
 
   if(show_coh_plots) {
      //------ selected Q2 for COH
-     ps->NewPage();
-     gst_0->Draw("Q2s","coh","");
-     if(gst_1) gst_1->Draw("Q2s","coh","perrsame");
-     ls->Clear();
-     ls->SetHeader("selected Q2 for COH events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("Q2s", "coh", "selected Q2 for COH events");
 
      //------ selected Q2 for COH CC
-     ps->NewPage();
-     gst_0->Draw("Q2s","coh&&cc","");
-     if(gst_1) gst_1->Draw("Q2s","coh&&cc","perrsame");
-     ls->Clear();
-     ls->SetHeader("selected Q2 for COH CC events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("Q2s", "coh&&cc", "selected Q2 for COH CC events");
 
      //------ selected Q2 for COH NC
-     ps->NewPage();
-     gst_0->Draw("Q2s","coh&&nc","");
-     if(gst_1) gst_1->Draw("Q2s","coh&&nc","perrsame");
-     ls->Clear();
-     ls->SetHeader("selected Q2 for COH NC events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("Q2s", "coh&&nc", "selected Q2 for COH NC events");
   }
-  
+
   //------ selected W for all events
-  ps->NewPage();
-  gst_0->Draw("Ws","Ws>0","");
-  if(gst_1) gst_1->Draw("Ws","Ws>0","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected W for all events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("Ws", "Ws>0", "selected W for all events");
 
   //------ selected W for QEL
-  ps->NewPage();
-  gst_0->Draw("Ws","qel&&!charm","");
-  if(gst_1) gst_1->Draw("Ws","qel&&!charm","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected W for QEL events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("Ws", "qel&&!charm", "selected W for QEL events");
 
   //------ selected W for RES
-  ps->NewPage();
-  gst_0->Draw("Ws","res","");
-  if(gst_1) gst_1->Draw("Ws","res","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected W for RES events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("Ws", "res", "selected W for RES events");
 
   //------ selected W for DIS
-  ps->NewPage();
-  gst_0->Draw("Ws","dis","");
-  if(gst_1) gst_1->Draw("Ws","dis","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected W for DIS events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("Ws", "dis", "selected W for DIS events");
 
   //------ selected W for DIS CC
-  ps->NewPage();
-  gst_0->Draw("Ws","dis&&cc","");
-  if(gst_1) gst_1->Draw("Ws","dis&&cc","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected W for DIS CC events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("Ws", "dis&&cc", "selected W for DIS CC events");
 
   //------ selected W for DIS NC
-  ps->NewPage();
-  gst_0->Draw("Ws","dis&&nc","");
-  if(gst_1) gst_1->Draw("Ws","dis&&nc","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected W for DIS NC events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("Ws", "dis&&nc", "selected W for DIS NC events");
 
   //------ selected x for all events
-  ps->NewPage();
-  gst_0->Draw("xs","","");
-  if(gst_1) gst_1->Draw("xs","","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected x for all events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("xs", "", "selected x for all events");
 
   //------ selected x for QEL
-  ps->NewPage();
-  gst_0->Draw("xs","qel&&!charm","");
-  if(gst_1) gst_1->Draw("xs","qel&&!charm","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected x for QEL events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("xs", "qel&&!charm", "selected x for QEL events");
 
   //------ selected x for RES
-  ps->NewPage();
-  gst_0->Draw("xs","res","");
-  if(gst_1) gst_1->Draw("xs","res","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected x for RES events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("xs", "res", "selected x for RES events");
 
   //------ selected x for DIS
-  ps->NewPage();
-  gst_0->Draw("xs","dis","");
-  if(gst_1) gst_1->Draw("xs","dis","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected x for DIS events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("xs", "dis", "selected x for DIS events");
 
   //------ selected x for DIS CC
-  ps->NewPage();
-  gst_0->Draw("xs","dis&&cc","");
-  if(gst_1) gst_1->Draw("xs","dis&&cc","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected x for DIS CC events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("xs", "dis&&cc", "selected x for DIS CC events");
 
   //------ selected x for DIS NC
-  ps->NewPage();
-  gst_0->Draw("xs","dis&&nc","");
-  if(gst_1) gst_1->Draw("xs","dis&&nc","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected x for DIS NC events");
-  ls->Draw();
-  c->Update();
-
-  //------ selected x for Charm/DIS 
-  ps->NewPage();
-  gst_0->Draw("xs","dis&&charm","");
-  if(gst_1) gst_1->Draw("xs","dis&&charm","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected x for Charm/DIS events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("xs", "dis&&nc", "selected x for DIS NC events");
+
+  //------ selected x for Charm/DIS
+  AddPlotPage("xs", "dis&&charm", "selected x for Charm/DIS events");
 
   if(show_coh_plots) {
      //------ selected x for COH
-     ps->NewPage();
-     gst_0->Draw("xs","coh","");
-     if(gst_1) gst_1->Draw("xs","coh","perrsame");
-     ls->Clear();
-     ls->SetHeader("selected x for COH events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("xs", "coh", "selected x for COH events");
 
      //------ selected x for COH CC
-     ps->NewPage();
-     gst_0->Draw("xs","coh&&cc","");
-     if(gst_1) gst_1->Draw("xs","coh&&cc","perrsame");
-     ls->Clear();
-     ls->SetHeader("selected x for COH CC events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("xs", "coh&&cc", "selected x for COH CC events");
 
      //------ selected x for COH NC
-     ps->NewPage();
-     gst_0->Draw("xs","coh&&nc","");
-     if(gst_1) gst_1->Draw("xs","coh&&nc","perrsame");
-     ls->Clear();
-     ls->SetHeader("selected x for COH NC events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("xs", "coh&&nc", "selected x for COH NC events");
   }
 
   //------ selected y for all events
-  ps->NewPage();
-  gst_0->Draw("ys","","");
-  if(gst_1) gst_1->Draw("ys","","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected y for all events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("ys", "", "selected y for all events");
 
   //------ selected y for QEL
-  ps->NewPage();
-  gst_0->Draw("ys","qel&&!charm","");
-  if(gst_1) gst_1->Draw("ys","qel&&!charm","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected y for QEL events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("ys", "qel&&!charm", "selected y for QEL events");
 
   //------ selected y for RES
-  ps->NewPage();
-  gst_0->Draw("ys","res","");
-  if(gst_1) gst_1->Draw("ys","res","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected y for RES events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("ys", "res", "selected y for RES events");
 
   //------ selected y for DIS
-  ps->NewPage();
-  gst_0->Draw("ys","dis","");
-  if(gst_1) gst_1->Draw("ys","dis","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected y for DIS events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("ys", "dis", "selected y for DIS events");
 
   //------ selected y for DIS CC
-  ps->NewPage();
-  gst_0->Draw("ys","dis&&cc","");
-  if(gst_1) gst_1->Draw("ys","dis&&cc","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected y for DIS CC events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("ys", "dis&&cc", "selected y for DIS CC events");
 
   //------ selected y for DIS NC
-  ps->NewPage();
-  gst_0->Draw("ys","dis&&nc","");
-  if(gst_1) gst_1->Draw("ys","dis&&nc","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected y for DIS NC events");
-  ls->Draw();
-  c->Update();
-
-  //------ selected y for Charm/DIS 
-  ps->NewPage();
-  gst_0->Draw("ys","dis&&charm","");
-  if(gst_1) gst_1->Draw("ys","dis&&charm","perrsame");
-  ls->Clear();
-  ls->SetHeader("selected y for Charm/DIS events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("ys", "dis&&nc", "selected y for DIS NC events");
+
+  //------ selected y for Charm/DIS
+  AddPlotPage("ys", "dis&&charm", "selected y for Charm/DIS events");
 
   if(show_coh_plots) {
      //------ selected y for COH
-     ps->NewPage();
-     gst_0->Draw("ys","coh","");
-     if(gst_1) gst_1->Draw("ys","coh","perrsame");
-     ls->Clear();
-     ls->SetHeader("selected y for COH events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("ys", "coh", "selected y for COH events");
 
      //------ selected y for COH CC
-     ps->NewPage();
-     gst_0->Draw("ys","coh&&cc","");
-     if(gst_1) gst_1->Draw("ys","coh&&cc","perrsame");
-     ls->Clear();
-     ls->SetHeader("selected y for COH CC events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("ys", "coh&&cc", "selected y for COH CC events");
 
      //------ selected y for COH NC
-     ps->NewPage();
-     gst_0->Draw("ys","coh&&nc","");
-     if(gst_1) gst_1->Draw("ys","coh&&nc","perrsame");
-     ls->Clear();
-     ls->SetHeader("selected y for COH NC events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("ys", "coh&&nc", "selected y for COH NC events");
 
      //------ selected t for COH
-     ps->NewPage();
-     gst_0->Draw("ts","coh","");
-     if(gst_1) gst_1->Draw("ts","coh","perrsame");
-     ls->Clear();
-     ls->SetHeader("selected t for COH events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("ts", "coh", "selected t for COH events");
   }
 
   if(show_calc_kinematics) {
 
      //
-     // SECTION: Computed Kinematics 
+     // SECTION: Computed Kinematics
      //
-     ps->NewPage();
-     c->Clear();
-     c->Range(0,0,100,100);
-     TPavesText hdrck(10,40,90,70,3,"tr");
-     hdrck.AddText("Kinematical Quantities");
-     hdrck.AddText(" ");
-     hdrck.AddText(" ");
-     hdrck.AddText("Similar to the previous set of plots but");
-     hdrck.AddText("showing 'computed' rather than 'selected' variables");
-     hdrck.Draw();
-     c->Update();
+     AddTextPage({
+       "Kinematical Quantities",
+       " ",
+       " ",
+       "Similar to the previous set of plots but",
+       "showing 'computed' rather than 'selected' variables"
+     });
 
      //------ Q2 for all events
-     ps->NewPage();
-               gst_0->Draw("Q2","","");
-     if(gst_1) gst_1->Draw("Q2","","perrsame");
-     ls->Clear();
-     ls->SetHeader("computed Q2 for all events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("Q2", "", "computed Q2 for all events");
 
      //------ Q2 for QEL
-     ps->NewPage();
-               gst_0->Draw("Q2","qel&&!charm","");
-     if(gst_1) gst_1->Draw("Q2","qel&&!charm","perrsame");
-     ls->Clear();
-     ls->SetHeader("computed Q2 for QEL events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("Q2", "qel&&!charm", "computed Q2 for QEL events");
 
      //------ Q2 for RES
-     ps->NewPage();
-               gst_0->Draw("Q2","res","");
-     if(gst_1) gst_1->Draw("Q2","res","perrsame");
-     ls->Clear();
-     ls->SetHeader("computed Q2 for RES events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("Q2", "res", "computed Q2 for RES events");
 
      //------ Q2 for DIS
-     ps->NewPage();
-               gst_0->Draw("Q2","dis","");
-     if(gst_1) gst_1->Draw("Q2","dis","perrsame");
-     ls->Clear();
-     ls->SetHeader("computed Q2 for DIS events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("Q2", "dis", "computed Q2 for DIS events");
 
      //------ x for all events
-     ps->NewPage();
-     gst_0->Draw("x","","");
-     if(gst_1) gst_1->Draw("x","","perrsame");
-     ls->Clear();
-     ls->SetHeader("computed x for all events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("x", "", "computed x for all events");
 
      //------ x for QEL
-     ps->NewPage();
-     gst_0->Draw("x","qel&&!charm","");
-     if(gst_1) gst_1->Draw("x","qel&&!charm","perrsame");
-     ls->Clear();
-     ls->SetHeader("computed x for QEL events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("x", "qel&&!charm", "computed x for QEL events");
 
      //------ x for RES
-     ps->NewPage();
-     gst_0->Draw("x","res","");
-     if(gst_1) gst_1->Draw("x","res","perrsame");
-     ls->Clear();
-     ls->SetHeader("computed x for RES events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("x", "res", "computed x for RES events");
 
      //------ x for DIS
-     ps->NewPage();
-     gst_0->Draw("x","dis","");
-     if(gst_1) gst_1->Draw("x","dis","perrsame");
-     ls->Clear();
-     ls->SetHeader("computed x for DIS events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("x", "dis", "computed x for DIS events");
 
      //------ y for all events
-     ps->NewPage();
-     gst_0->Draw("y","","");
-     if(gst_1) gst_1->Draw("y","","perrsame");
-     ls->Clear();
-     ls->SetHeader("computed y for all events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("y", "", "computed y for all events");
 
      //------ y for QEL
-     ps->NewPage();
-     gst_0->Draw("y","qel&&!charm","");
-     if(gst_1) gst_1->Draw("y","qel&&!charm","perrsame");
-     ls->Clear();
-     ls->SetHeader("computed y for QEL events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("y", "qel&&!charm", "computed y for QEL events");
 
      //------ y for RES
-     ps->NewPage();
-     gst_0->Draw("y","res","");
-     if(gst_1) gst_1->Draw("y","res","perrsame");
-     ls->Clear();
-     ls->SetHeader("computed y for RES events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("y", "res", "computed y for RES events");
 
      //------ y for DIS
-     ps->NewPage();
-     gst_0->Draw("y","dis","");
-     if(gst_1) gst_1->Draw("y","dis","perrsame");
-     ls->Clear();
-     ls->SetHeader("computed y for DIS events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("y", "dis", "computed y for DIS events");
 
   }//show?
 
@@ -815,397 +481,157 @@ void CreatePlots(string inp_filename, string inp_filename_ref)
   //
   // SECTION: Initial State nucleon
   //
-  ps->NewPage();
-  c->Clear();
-  c->Range(0,0,100,100);
-  TPavesText hdrinuc(10,40,90,70,3,"tr");
-  hdrinuc.AddText("Initial state nucleon 4-Momentum");
-  hdrinuc.Draw();
-  c->Update();
+  AddTextPage({"Initial state nucleon 4-Momentum"});
 
   //------ selected hit nucleon px
-  ps->NewPage();
-  c->Clear();
-  c->Divide(2,2);
-  c->cd(1);
-  gst_0->Draw("pxn","","");
-  if(gst_1) gst_1->Draw("pxn","","perrsame");
-  c->cd(2);
-  gst_0->Draw("pyn","","");
-  if(gst_1) gst_1->Draw("pyn","","perrsame");
-  c->cd(3);
-  gst_0->Draw("pzn","","");
-  if(gst_1) gst_1->Draw("pzn","","perrsame");
-  c->cd(4);
-  gst_0->Draw("En","En>.2","");
-  if(gst_1) gst_1->Draw("En","En>.2","perrsame");
-  c->Update();
+  AddPlotPage({
+    { "pxn", "" },
+    { "pyn", "" },
+    { "pzn", "" },
+    { "En", "En>.2" }
+  }, "");
 
   //
   // SECTION: Final State Primary Lepton
   //
-  ps->NewPage();
-  c->Clear();
-  c->Range(0,0,100,100);
-  TPavesText hdrfsl(10,40,90,70,3,"tr");
-  hdrfsl.AddText("Final State Primary Lepton 4-Momentum");
-  hdrfsl.Draw();
-  c->Update();
+  AddTextPage({"Final State Primary Lepton 4-Momentum"});
 
   //------ f/s primary lepton : all events
-  ps->NewPage();
-  c->Divide(2,2);
-  c->cd(1);
-  gst_0->Draw("pxl","","");
-  if(gst_1) gst_1->Draw("pxl","","perrsame");
-  c->cd(2);
-  gst_0->Draw("pyl","","");
-  if(gst_1) gst_1->Draw("pyl","","perrsame");
-  c->cd(3);
-  gst_0->Draw("pzl","","");
-  if(gst_1) gst_1->Draw("pzl","","perrsame");
-  c->cd(4);
-  gst_0->Draw("El","","");
-  if(gst_1) gst_1->Draw("El","","perrsame");
-  c->cd();
-  ls->Clear();
-  ls->SetHeader("Final state primary lepton 4-p: All events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage({
+    { "pxl", "" },
+    { "pyl", "" },
+    { "pzl", "" },
+    { "El", "" }
+  }, "Final state primary lepton 4-p: All events");
 
   //------ f/s primary lepton : all CC events
-  ps->NewPage();
-  c->Clear();
-  c->Divide(2,2);
-  c->cd(1);
-  gst_0->Draw("pxl","cc","");
-  if(gst_1) gst_1->Draw("pxl","cc","perrsame");
-  c->cd(2);
-  gst_0->Draw("pyl","cc","");
-  if(gst_1) gst_1->Draw("pyl","cc","perrsame");
-  c->cd(3);
-  gst_0->Draw("pzl","cc","");
-  if(gst_1) gst_1->Draw("pzl","cc","perrsame");
-  c->cd(4);
-  gst_0->Draw("El","cc","");
-  if(gst_1) gst_1->Draw("El","cc","perrsame");
-  c->cd();
-  ls->Clear();
-  ls->SetHeader("Final state primary lepton 4-p: All CC events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage({
+    { "pxl", "cc" },
+    { "pyl", "cc" },
+    { "pzl", "cc" },
+    { "El", "cc" }
+  }, "Final state primary lepton 4-p: All CC events");
 
   //------ f/s primary lepton : all NC events
-  ps->NewPage();
-  c->Clear();
-  c->Divide(2,2);
-  c->cd(1);
-  gst_0->Draw("pxl","nc","");
-  if(gst_1) gst_1->Draw("pxl","nc","perrsame");
-  c->cd(2);
-  gst_0->Draw("pyl","nc","");
-  if(gst_1) gst_1->Draw("pyl","nc","perrsame");
-  c->cd(3);
-  gst_0->Draw("pzl","nc","");
-  if(gst_1) gst_1->Draw("pzl","nc","perrsame");
-  c->cd(4);
-  gst_0->Draw("El","nc","");
-  if(gst_1) gst_1->Draw("El","nc","perrsame");
-  c->cd();
-  ls->Clear();
-  ls->SetHeader("Final state primary lepton 4-p: All NC events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage({
+    { "pxl", "nc" },
+    { "pyl", "nc" },
+    { "pzl", "nc" },
+    { "El", "nc" }
+  }, "Final state primary lepton 4-p: All NC events");
 
   //------ f/s primary lepton : QEL events
-  ps->NewPage();
-  c->Clear();
-  c->Divide(2,2);
-  c->cd(1);
-  gst_0->Draw("pxl","qel&&!charm","");
-  if(gst_1) gst_1->Draw("pxl","qel&&!charm","perrsame");
-  c->cd(2);
-  gst_0->Draw("pyl","qel&&!charm","");
-  if(gst_1) gst_1->Draw("pyl","qel&&!charm","perrsame");
-  c->cd(3);
-  gst_0->Draw("pzl","qel&&!charm","");
-  if(gst_1) gst_1->Draw("pzl","qel&&!charm","perrsame");
-  c->cd(4);
-  gst_0->Draw("El","qel&&!charm","");
-  if(gst_1) gst_1->Draw("El","qel&&!charm","perrsame");
-  c->cd();
-  ls->Clear();
-  ls->SetHeader("Final state primary lepton 4-p: QEL events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage({
+    { "pxl", "qel&&!charm" },
+    { "pyl", "qel&&!charm" },
+    { "pzl", "qel&&!charm" },
+    { "El", "qel&&!charm" }
+  }, "Final state primary lepton 4-p: QEL events");
 
   //------ f/s primary lepton : RES events
-  ps->NewPage();
-  c->Clear();
-  c->Divide(2,2);
-  c->cd(1);
-  gst_0->Draw("pxl","res","");
-  if(gst_1) gst_1->Draw("pxl","res","perrsame");
-  c->cd(2);
-  gst_0->Draw("pyl","res","");
-  if(gst_1) gst_1->Draw("pyl","res","perrsame");
-  c->cd(3);
-  gst_0->Draw("pzl","res","");
-  if(gst_1) gst_1->Draw("pzl","res","perrsame");
-  c->cd(4);
-  gst_0->Draw("El","res","");
-  if(gst_1) gst_1->Draw("El","res","perrsame");
-  c->cd();
-  ls->Clear();
-  ls->SetHeader("Final state primary lepton 4-p: RES events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage({
+    { "pxl", "res" },
+    { "pyl", "res" },
+    { "pzl", "res" },
+    { "El", "res" }
+  }, "Final state primary lepton 4-p: RES events");
 
   //------ f/s primary lepton : DIS events
-  ps->NewPage();
-  c->Clear();
-  c->Divide(2,2);
-  c->cd(1);
-  gst_0->Draw("pxl","dis","");
-  if(gst_1) gst_1->Draw("pxl","dis","perrsame");
-  c->cd(2);
-  gst_0->Draw("pyl","dis","");
-  if(gst_1) gst_1->Draw("pyl","dis","perrsame");
-  c->cd(3);
-  gst_0->Draw("pzl","dis","");
-  if(gst_1) gst_1->Draw("pzl","dis","perrsame");
-  c->cd(4);
-  gst_0->Draw("El","dis","");
-  if(gst_1) gst_1->Draw("El","dis","perrsame");
-  c->cd();
-  ls->Clear();
-  ls->SetHeader("Final state primary lepton 4-p: All DIS events");
-  ls->Draw();
-  c->Update();
+  AddPlotPage({
+    { "pxl", "dis" },
+    { "pyl", "dis" },
+    { "pzl", "dis" },
+    { "El", "dis" }
+  }, "Final state primary lepton 4-p: All DIS events");
 
   if(show_coh_plots) {
      //------ f/s primary lepton : COH events
-     ps->NewPage();
-     c->Clear();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxl","coh","");
-     if(gst_1) gst_1->Draw("pxl","coh","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyl","coh","");
-     if(gst_1) gst_1->Draw("pyl","coh","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzl","coh","");
-     if(gst_1) gst_1->Draw("pzl","coh","perrsame");
-     c->cd(4);
-     gst_0->Draw("El","coh","");
-     if(gst_1) gst_1->Draw("El","coh","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Final state primary lepton 4-p: COH events");
-     ls->Draw();
-     c->Update();
+     AddPlotPage({
+       { "pxl", "coh" },
+       { "pyl", "coh" },
+       { "pzl", "coh" },
+       { "El", "coh" }
+     }, "Final state primary lepton 4-p: COH events");
   }
 
   //
   // SECTION: Final State Hadronic System Multiplicities & 4P
   //
-  ps->NewPage();
-  c->Clear();
-  c->Range(0,0,100,100);
-  TPavesText hdrfhad(10,40,90,70,3,"tr");
-  hdrfhad.AddText("Final State Hadronic System");
-  hdrfhad.AddText("Multiplicities and 4-Momenta");
-  hdrfhad.AddText(" ");
-  hdrfhad.AddText(" ");
-  hdrfhad.AddText(" ");
-  hdrfhad.AddText(" ");
-  hdrfhad.AddText("Note:");
-  hdrfhad.AddText("For nuclear targets these plots include the effect");
-  hdrfhad.AddText("of intranuclear hadron transport / rescattering");
-  hdrfhad.Draw();
-  c->Update();
+  AddTextPage({
+    "Final State Hadronic System",
+    "Multiplicities and 4-Momenta",
+    " ",
+    " ",
+    " ",
+    " ",
+    "Note:",
+    "For nuclear targets these plots include the effect",
+    "of intranuclear hadron transport / rescattering"
+  });
 
   //------ number of final state p
-  ps->NewPage();
-  gst_0->Draw("nfp","","");
-  if(gst_1) gst_1->Draw("nfp","","perrsame");
-  ls->Clear();
-  ls->SetHeader("Number of final state protons");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("nfp", "", "Number of final state protons");
 
   //------ number of final state n
-  ps->NewPage();
-  gst_0->Draw("nfn","","");
-  if(gst_1) gst_1->Draw("nfn","","perrsame");
-  ls->Clear();
-  ls->SetHeader("Number of final state neutrons");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("nfn", "", "Number of final state neutrons");
 
   //------ number of final state pi+
-  ps->NewPage();
-  gst_0->Draw("nfpip","","");
-  if(gst_1) gst_1->Draw("nfpip","","perrsame");
-  ls->Clear();
-  ls->SetHeader("Number of final state pi+");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("nfpip", "", "Number of final state pi+");
 
   //------ number of final state pi-
-  ps->NewPage();
-  gst_0->Draw("nfpim","","");
-  if(gst_1) gst_1->Draw("nfpim","","perrsame");
-  ls->Clear();
-  ls->SetHeader("Number of final state pi-");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("nfpim", "", "Number of final state pi-");
 
   //------ number of final state pi0
-  ps->NewPage();
-  gst_0->Draw("nfpi0","","");
-  if(gst_1) gst_1->Draw("nfpi0","","perrsame");
-  ls->Clear();
-  ls->SetHeader("Number of final state pi0");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("nfpi0", "", "Number of final state pi0");
 
   //------ number of final state K+
-  ps->NewPage();
-  gst_0->Draw("nfkp","","");
-  if(gst_1) gst_1->Draw("nfkp","","perrsame");
-  ls->Clear();
-  ls->SetHeader("Number of final state K+");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("nfkp", "", "Number of final state K+");
 
   //------ number of final state K-
-  ps->NewPage();
-  gst_0->Draw("nfkm","","");
-  if(gst_1) gst_1->Draw("nfkm","","perrsame");
-  ls->Clear();
-  ls->SetHeader("Number of final state K-");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("nfkm", "", "Number of final state K-");
 
   //------ number of final state K0
-  ps->NewPage();
-  gst_0->Draw("nfk0","","");
-  if(gst_1) gst_1->Draw("nfk0","","perrsame");
-  ls->Clear();
-  ls->SetHeader("Number of final state K0");
-  ls->Draw();
-  c->Update();
+  AddPlotPage("nfk0", "", "Number of final state K0");
 
   //------ momentum of final state p
-  ps->NewPage();
-  c->Divide(2,2);
-  c->cd(1);
-  gst_0->Draw("pxf","pdgf==2212","");
-  if(gst_1) gst_1->Draw("pxf","pdgf==2212","perrsame");
-  c->cd(2);
-  gst_0->Draw("pyf","pdgf==2212","");
-  if(gst_1) gst_1->Draw("pyf","pdgf==2212","perrsame");
-  c->cd(3);
-  gst_0->Draw("pzf","pdgf==2212","");
-  if(gst_1) gst_1->Draw("pzf","pdgf==2212","perrsame"); 
-  c->cd(4);
-  gst_0->Draw("Ef","pdgf==2212","");
-  if(gst_1) gst_1->Draw("Ef","pdgf==2212","perrsame");
-  c->cd();
-  ls->Clear();
-  ls->SetHeader("Final state protons 4-momentum");
-  ls->Draw();
-  c->Update();
+  AddPlotPage({
+    { "pxf", "pdgf==2212" },
+    { "pyf", "pdgf==2212" },
+    { "pzf", "pdgf==2212" },
+    { "Ef", "pdgf==2212" }
+  }, "Final state protons 4-momentum");
 
   //------ momentum of final state n
-  ps->NewPage();
-  c->Clear();
-  c->Divide(2,2);
-  c->cd(1);
-  gst_0->Draw("pxf","pdgf==2112","");
-  if(gst_1) gst_1->Draw("pxf","pdgf==2112","perrsame");
-  c->cd(2);
-  gst_0->Draw("pyf","pdgf==2112","");
-  if(gst_1) gst_1->Draw("pyf","pdgf==2112","perrsame");
-  c->cd(3);
-  gst_0->Draw("pzf","pdgf==2112","");
-  if(gst_1) gst_1->Draw("pzf","pdgf==2112","perrsame");
-  c->cd(4);
-  gst_0->Draw("Ef","pdgf==2112","");
-  if(gst_1) gst_1->Draw("Ef","pdgf==2112","perrsame");
-  c->cd();
-  ls->Clear();
-  ls->SetHeader("Final state neutrons 4-momentum");
-  ls->Draw();
-  c->Update();
+  AddPlotPage({
+    { "pxf", "pdgf==2112" },
+    { "pyf", "pdgf==2112" },
+    { "pzf", "pdgf==2112" },
+    { "Ef", "pdgf==2112" }
+  }, "Final state neutrons 4-momentum");
 
   //------ momentum of final state pi0
-  ps->NewPage();
-  c->Clear();
-  c->Divide(2,2);
-  c->cd(1);
-  gst_0->Draw("pxf","pdgf==111","");
-  if(gst_1) gst_1->Draw("pxf","pdgf==111","perrsame");
-  c->cd(2);
-  gst_0->Draw("pyf","pdgf==111","");
-  if(gst_1) gst_1->Draw("pyf","pdgf==111","perrsame");
-  c->cd(3);
-  gst_0->Draw("pzf","pdgf==111","");
-  if(gst_1) gst_1->Draw("pzf","pdgf==111","perrsame");
-  c->cd(4);
-  gst_0->Draw("Ef","pdgf==111","");
-  if(gst_1) gst_1->Draw("Ef","pdgf==111","perrsame");
-  c->cd();
-  ls->Clear();
-  ls->SetHeader("Final state pi0's 4-momentum");
-  ls->Draw();
-  c->Update();
+  AddPlotPage({
+    { "pxf", "pdgf==111" },
+    { "pyf", "pdgf==111" },
+    { "pzf", "pdgf==111" },
+    { "Ef", "pdgf==111" }
+  }, "Final state pi0's 4-momentum");
 
   //------ momentum of final state pi+
-  ps->NewPage();
-  c->Clear();
-  c->Divide(2,2);
-  c->cd(1);
-  gst_0->Draw("pxf","pdgf==211","");
-  if(gst_1) gst_1->Draw("pxf","pdgf==211","perrsame");
-  c->cd(2);
-  gst_0->Draw("pyf","pdgf==211","");
-  if(gst_1) gst_1->Draw("pyf","pdgf==211","perrsame");
-  c->cd(3);
-  gst_0->Draw("pzf","pdgf==211","");
-  if(gst_1) gst_1->Draw("pzf","pdgf==211","perrsame");
-  c->cd(4);
-  gst_0->Draw("Ef","pdgf==211","");
-  if(gst_1) gst_1->Draw("Ef","pdgf==211","perrsame");
-  c->cd();
-  ls->Clear();
-  ls->SetHeader("Final state pi+'s 4-momentum");
-  ls->Draw();
-  c->Update();
+  AddPlotPage({
+    { "pxf", "pdgf==211" },
+    { "pyf", "pdgf==211" },
+    { "pzf", "pdgf==211" },
+    { "Ef", "pdgf==211" }
+  }, "Final state pi+'s 4-momentum");
 
   //------ momentum of final state pi+
-  ps->NewPage();
-  c->Clear();
-  c->Divide(2,2);
-  c->cd(1);
-  gst_0->Draw("pxf","pdgf==-211","");
-  if(gst_1) gst_1->Draw("pxf","pdgf==-211","perrsame");
-  c->cd(2);
-  gst_0->Draw("pyf","pdgf==-211","");
-  if(gst_1) gst_1->Draw("pyf","pdgf==-211","perrsame");
-  c->cd(3);
-  gst_0->Draw("pzf","pdgf==-211","");
-  if(gst_1) gst_1->Draw("pzf","pdgf==-211","perrsame");
-  c->cd(4);
-  gst_0->Draw("Ef","pdgf==-211","");
-  if(gst_1) gst_1->Draw("Ef","pdgf==-211","perrsame");
-  c->cd();
-  ls->Clear();
-  ls->SetHeader("Final state pi-'s 4-momentum");
-  ls->Draw();
-  c->Update();
+  AddPlotPage({
+    { "pxf", "pdgf==-211" },
+    { "pyf", "pdgf==-211" },
+    { "pzf", "pdgf==-211" },
+    { "Ef", "pdgf==-211" }
+  }, "Final state pi-'s 4-momentum");
 
   if(show_mult_per_proc) {
 
@@ -1214,768 +640,533 @@ void CreatePlots(string inp_filename, string inp_filename_ref)
      //
 
      //------ number of final state p /QEL
-     ps->NewPage();
-     if(gst_1) gst_1->Draw("nfp","qel&&!charm","");
-     gst_0->Draw("nfp","qel&&!charm","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state protons / QEL only");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("nfp", "qel&&!charm", "Number of final state protons / QEL only");
 
      //------ number of final state n /QEL
-     ps->NewPage();
-     if(gst_1) gst_1->Draw("nfn","qel&&!charm","");
-     gst_0->Draw("nfn","qel&&!charm","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state neutrons / QEL only");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("nfn", "qel&&!charm", "Number of final state neutrons / QEL only");
 
      //------ number of final state pi+ /QEL
-     ps->NewPage();
-     gst_0->Draw("nfpip","qel&&!charm","");
-     if(gst_1) gst_1->Draw("nfpip","qel&&!charm","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state pi+ / QEL only");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("nfpip", "qel&&!charm", "Number of final state pi+ / QEL only");
 
      //------ number of final state pi- /QEL
-     ps->NewPage();
-     gst_0->Draw("nfpim","qel&&!charm","");
-     if(gst_1) gst_1->Draw("nfpim","qel&&!charm","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state pi- / QEL only");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("nfpim", "qel&&!charm", "Number of final state pi- / QEL only");
 
      //------ number of final state pi0 /QEL
-     ps->NewPage();
-     gst_0->Draw("nfpi0","qel&&!charm","");
-     if(gst_1) gst_1->Draw("nfpi0","qel&&!charm","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state pi0 / QEL only");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("nfpi0", "qel&&!charm", "Number of final state pi0 / QEL only");
 
      //------ number of final state K+ /QEL
-     ps->NewPage();
-     gst_0->Draw("nfkp","qel&&!charm","");
-     if(gst_1) gst_1->Draw("nfkp","qel&&!charm","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state K+ / QEL only");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("nfkp", "qel&&!charm", "Number of final state K+ / QEL only");
 
      //------ number of final state K- /QEL
-     ps->NewPage();
-     gst_0->Draw("nfkm","qel&&!charm","");
-     if(gst_1) gst_1->Draw("nfkm","qel&&!charm","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state K- / QEL only");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("nfkm", "qel&&!charm", "Number of final state K- / QEL only");
 
      //------ number of final state K0 /QEL
-     ps->NewPage();
-     gst_0->Draw("nfk0","qel&&!charm","");
-     if(gst_1) gst_1->Draw("nfk0","qel&&!charm","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state K0 / QEL only");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("nfk0", "qel&&!charm", "Number of final state K0 / QEL only");
 
      //------ momentum of final state p /QEL
-     ps->NewPage();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxf","qel&&!charm&&pdgf==2212","");
-     if(gst_1) gst_1->Draw("pxf","qel&&!charm&&pdgf==2212","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyf","qel&&!charm&&pdgf==2212","");
-     if(gst_1) gst_1->Draw("pyf","qel&&!charm&&pdgf==2212","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzf","qel&&!charm&&pdgf==2212","");
-     if(gst_1) gst_1->Draw("pzf","qel&&!charm&&pdgf==2212","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ef","qel&&!charm&&pdgf==2212","");
-     if(gst_1) gst_1->Draw("Ef","qel&&!charm&&pdgf==2212","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Final state protons 4-momentum / QEL only");
-     ls->Draw();
-     c->Update();
+     AddPlotPage({
+       { "pxf", "qel&&!charm&&pdgf==2212" },
+       { "pyf", "qel&&!charm&&pdgf==2212" },
+       { "pzf", "qel&&!charm&&pdgf==2212" },
+       { "Ef", "qel&&!charm&&pdgf==2212" }
+     }, "Final state protons 4-momentum / QEL only");
 
      //------ momentum of final state n /QEL
-     ps->NewPage();
-     c->Clear();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxf","qel&&!charm&&pdgf==2112","");
-     if(gst_1) gst_1->Draw("pxf","qel&&!charm&&pdgf==2112","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyf","qel&&!charm&&pdgf==2112","");
-     if(gst_1) gst_1->Draw("pyf","qel&&!charm&&pdgf==2112","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzf","qel&&!charm&&pdgf==2112","");
-     if(gst_1) gst_1->Draw("pzf","qel&&!charm&&pdgf==2112","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ef","qel&&!charm&&pdgf==2112","");
-     if(gst_1) gst_1->Draw("Ef","qel&&!charm&&pdgf==2112","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Final state neutrons 4-momentum / QEL only");
-     ls->Draw();
-     c->Update();
+     AddPlotPage({
+       { "pxf", "qel&&!charm&&pdgf==2112" },
+       { "pyf", "qel&&!charm&&pdgf==2112" },
+       { "pzf", "qel&&!charm&&pdgf==2112" },
+       { "Ef", "qel&&!charm&&pdgf==2112" }
+     }, "Final state neutrons 4-momentum / QEL only");
 
      //------ momentum of final state pi0 /QEL
-     ps->NewPage();
-     c->Clear();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxf","qel&&!charm&&pdgf==111","");
-     if(gst_1) gst_1->Draw("pxf","qel&&!charm&&pdgf==111","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyf","qel&&!charm&&pdgf==111","");
-     if(gst_1) gst_1->Draw("pyf","qel&&!charm&&pdgf==111","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzf","qel&&!charm&&pdgf==111","");
-     if(gst_1) gst_1->Draw("pzf","qel&&!charm&&pdgf==111","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ef","qel&&!charm&&pdgf==111","");
-     if(gst_1) gst_1->Draw("Ef","qel&&!charm&&pdgf==111","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Final state pi0's 4-momentum / QEL only");
-     ls->Draw();
-     c->Update();
+     AddPlotPage({
+       { "pxf", "qel&&!charm&&pdgf==111" },
+       { "pyf", "qel&&!charm&&pdgf==111" },
+       { "pzf", "qel&&!charm&&pdgf==111" },
+       { "Ef", "qel&&!charm&&pdgf==111" }
+     }, "Final state pi0's 4-momentum / QEL only");
 
      //------ momentum of final state pi+ /QEL
-     ps->NewPage();
-     c->Clear();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxf","qel&&!charm&&pdgf==211","");
-     if(gst_1) gst_1->Draw("pxf","qel&&!charm&&pdgf==211","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyf","qel&&!charm&&pdgf==211","");
-     if(gst_1) gst_1->Draw("pyf","qel&&!charm&&pdgf==211","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzf","qel&&!charm&&pdgf==211","");
-     if(gst_1) gst_1->Draw("pzf","qel&&!charm&&pdgf==211","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ef","qel&&!charm&&pdgf==211","");
-     if(gst_1) gst_1->Draw("Ef","qel&&!charm&&pdgf==211","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Final state pi+'s 4-momentum / QEL only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage({
+       { "pxf", "qel&&!charm&&pdgf==211" },
+       { "pyf", "qel&&!charm&&pdgf==211" },
+       { "pzf", "qel&&!charm&&pdgf==211" },
+       { "Ef", "qel&&!charm&&pdgf==211" }
+     }, "Final state pi+'s 4-momentum / QEL only");
+
      //------ momentum of final state pi+ /QEL
-     ps->NewPage();
-     c->Clear();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxf","qel&&!charm&&pdgf==-211","");
-     if(gst_1) gst_1->Draw("pxf","qel&&!charm&&pdgf==-211","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyf","qel&&!charm&&pdgf==-211","");
-     if(gst_1) gst_1->Draw("pyf","qel&&!charm&&pdgf==-211","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzf","qel&&!charm&&pdgf==-211","");
-     if(gst_1) gst_1->Draw("pzf","qel&&!charm&&pdgf==-211","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ef","qel&&!charm&&pdgf==-211","");
-     if(gst_1) gst_1->Draw("Ef","qel&&!charm&&pdgf==-211","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Final state pi-'s 4-momentum/ QEL only");
-     ls->Draw();
-     c->Update();
-          
+     AddPlotPage({
+       { "pxf", "qel&&!charm&&pdgf==-211" },
+       { "pyf", "qel&&!charm&&pdgf==-211" },
+       { "pzf", "qel&&!charm&&pdgf==-211" },
+       { "Ef", "qel&&!charm&&pdgf==-211" }
+     }, "Final state pi-'s 4-momentum/ QEL only");
+
      //
      // similarly but for RES events only
      //
-     
+
      //------ number of final state p /RES
-     ps->NewPage();
-               gst_0->Draw("nfp","res","");
-     if(gst_1) gst_1->Draw("nfp","res","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state protons / RES only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nfp", "res", "Number of final state protons / RES only");
+
      //------ number of final state n /RES
-     ps->NewPage();
-               gst_0->Draw("nfn","res","");
-     if(gst_1) gst_1->Draw("nfn","res","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state neutrons / RES only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nfn", "res", "Number of final state neutrons / RES only");
+
      //------ number of final state pi+ /RES
-     ps->NewPage();
-               gst_0->Draw("nfpip","res","");
-     if(gst_1) gst_1->Draw("nfpip","res","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state pi+ / RES only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nfpip", "res", "Number of final state pi+ / RES only");
+
      //------ number of final state pi- /RES
-     ps->NewPage();
-               gst_0->Draw("nfpim","res","");
-     if(gst_1) gst_1->Draw("nfpim","res","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state pi- / RES only");
-     ls->Draw();
-     c->Update();
+     AddPlotPage("nfpim", "res", "Number of final state pi- / RES only");
 
      //------ number of final state pi0 /RES
-     ps->NewPage();
-               gst_0->Draw("nfpi0","res","");
-     if(gst_1) gst_1->Draw("nfpi0","res","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state pi0 / RES only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nfpi0", "res", "Number of final state pi0 / RES only");
+
      //------ number of final state K+ /RES
-     ps->NewPage();
-     gst_0->Draw("nfkp","res","");
-     if(gst_1) gst_1->Draw("nfkp","res","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state K+ / RES only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nfkp", "res", "Number of final state K+ / RES only");
+
      //------ number of final state K- /RES
-     ps->NewPage();
-     gst_0->Draw("nfkm","res","");
-     if(gst_1) gst_1->Draw("nfkm","res","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state K- / RES only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nfkm", "res", "Number of final state K- / RES only");
+
      //------ number of final state K0 /RES
-     ps->NewPage();
-     gst_0->Draw("nfk0","res","");
-     if(gst_1) gst_1->Draw("nfk0","res","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state K0 / RES only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nfk0", "res", "Number of final state K0 / RES only");
+
      //------ momentum of final state p /RES
-     ps->NewPage();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxf","res&&pdgf==2212","");
-     if(gst_1) gst_1->Draw("pxf","res&&pdgf==2212","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyf","res&&pdgf==2212","");
-     if(gst_1) gst_1->Draw("pyf","res&&pdgf==2212","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzf","res&&pdgf==2212","");
-     if(gst_1) gst_1->Draw("pzf","res&&pdgf==2212","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ef","res&&pdgf==2212","");
-     if(gst_1) gst_1->Draw("Ef","res&&pdgf==2212","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Final state protons 4-momentum / RES only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage({
+       { "pxf", "res&&pdgf==2212" },
+       { "pyf", "res&&pdgf==2212" },
+       { "pzf", "res&&pdgf==2212" },
+       { "Ef", "res&&pdgf==2212" }
+     }, "Final state protons 4-momentum / RES only");
+
      //------ momentum of final state n /RES
-     ps->NewPage();
-     c->Clear();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxf","res&&pdgf==2112","");
-     if(gst_1) gst_1->Draw("pxf","res&&pdgf==2112","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyf","res&&pdgf==2112","");
-     if(gst_1) gst_1->Draw("pyf","res&&pdgf==2112","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzf","res&&pdgf==2112","");
-     if(gst_1) gst_1->Draw("pzf","res&&pdgf==2112","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ef","res&&pdgf==2112","");
-     if(gst_1) gst_1->Draw("Ef","res&&pdgf==2112","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Final state neutrons 4-momentum / RES only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage({
+       { "pxf", "res&&pdgf==2112" },
+       { "pyf", "res&&pdgf==2112" },
+       { "pzf", "res&&pdgf==2112" },
+       { "Ef", "res&&pdgf==2112" }
+     }, "Final state neutrons 4-momentum / RES only");
+
      //------ momentum of final state pi0 /RES
-     ps->NewPage();
-     c->Clear();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxf","res&&pdgf==111","");
-     if(gst_1) gst_1->Draw("pxf","res&&pdgf==111","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyf","res&&pdgf==111","");
-     if(gst_1) gst_1->Draw("pyf","res&&pdgf==111","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzf","res&&pdgf==111","");
-     if(gst_1) gst_1->Draw("pzf","res&&pdgf==111","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ef","res&&pdgf==111","");
-     if(gst_1) gst_1->Draw("Ef","res&&pdgf==111","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Final state pi0's 4-momentum / RES only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage({
+       { "pxf", "res&&pdgf==111" },
+       { "pyf", "res&&pdgf==111" },
+       { "pzf", "res&&pdgf==111" },
+       { "Ef", "res&&pdgf==111" }
+     }, "Final state pi0's 4-momentum / RES only");
+
      //------ momentum of final state pi+ /RES
-     ps->NewPage();
-     c->Clear();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxf","res&&pdgf==211","");
-     if(gst_1) gst_1->Draw("pxf","res&&pdgf==211","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyf","res&&pdgf==211","");
-     if(gst_1) gst_1->Draw("pyf","res&&pdgf==211","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzf","res&&pdgf==211","");
-     if(gst_1) gst_1->Draw("pzf","res&&pdgf==211","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ef","res&&pdgf==211","");
-     if(gst_1) gst_1->Draw("Ef","res&&pdgf==211","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Final state pi+'s 4-momentum / RES only");
-     ls->Draw();
-     c->Update();
+     AddPlotPage({
+       { "pxf", "res&&pdgf==211" },
+       { "pyf", "res&&pdgf==211" },
+       { "pzf", "res&&pdgf==211" },
+       { "Ef", "res&&pdgf==211" }
+     }, "Final state pi+'s 4-momentum / RES only");
 
      //------ momentum of final state pi+ /RES
-     ps->NewPage();
-     c->Clear();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxf","res&&pdgf==-211","");
-     if(gst_1) gst_1->Draw("pxf","res&&pdgf==-211","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyf","res&&pdgf==-211","");
-     if(gst_1) gst_1->Draw("pyf","res&&pdgf==-211","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzf","res&&pdgf==-211","");
-     if(gst_1) gst_1->Draw("pzf","res&&pdgf==-211","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ef","res&&pdgf==-211","");
-     if(gst_1) gst_1->Draw("Ef","res&&pdgf==-211","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Final state pi-'s 4-momentum/ RES only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage({
+       { "pxf", "res&&pdgf==-211" },
+       { "pyf", "res&&pdgf==-211" },
+       { "pzf", "res&&pdgf==-211" },
+       { "Ef", "res&&pdgf==-211" }
+     }, "Final state pi-'s 4-momentum/ RES only");
+
      //
      // similarly but for DIS events only
      //
-     
+
      //------ number of final state p /DIS
-     ps->NewPage();
-     gst_0->Draw("nfp","dis","");
-     if(gst_1) gst_1->Draw("nfp","dis","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state protons / DIS only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nfp", "dis", "Number of final state protons / DIS only");
+
      //------ number of final state n /DIS
-     ps->NewPage();
-     gst_0->Draw("nfn","dis","");
-     if(gst_1) gst_1->Draw("nfn","dis","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state neutrons / DIS only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nfn", "dis", "Number of final state neutrons / DIS only");
+
      //------ number of final state pi+ /DIS
-     ps->NewPage();
-     gst_0->Draw("nfpip","dis","");
-     if(gst_1) gst_1->Draw("nfpip","dis","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state pi+ / DIS only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nfpip", "dis", "Number of final state pi+ / DIS only");
+
      //------ number of final state pi- /DIS
-     ps->NewPage();
-     gst_0->Draw("nfpim","dis","");
-     if(gst_1) gst_1->Draw("nfpim","dis","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state pi- / DIS only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nfpim", "dis", "Number of final state pi- / DIS only");
+
      //------ number of final state pi0 /DIS
-     ps->NewPage();
-     gst_0->Draw("nfpi0","dis","");
-     if(gst_1) gst_1->Draw("nfpi0","dis","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state pi0 / DIS only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nfpi0", "dis", "Number of final state pi0 / DIS only");
+
      //------ number of final state K+ /DIS
-     ps->NewPage();
-     gst_0->Draw("nfkp","dis","");
-     if(gst_1) gst_1->Draw("nfkp","dis","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state K+ / DIS only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nfkp", "dis", "Number of final state K+ / DIS only");
+
      //------ number of final state K- /DIS
-     ps->NewPage();
-     gst_0->Draw("nfkm","dis","");
-     if(gst_1) gst_1->Draw("nfkm","dis","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state K- / DIS only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nfkm", "dis", "Number of final state K- / DIS only");
+
      //------ number of final state K0 /DIS
-     ps->NewPage();
-     gst_0->Draw("nfk0","dis","");
-     if(gst_1) gst_1->Draw("nfk0","dis","perrsame");
-     ls->Clear();
-     ls->SetHeader("Number of final state K0 / DIS only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nfk0", "dis", "Number of final state K0 / DIS only");
+
      //------ momentum of final state p /DIS
-     ps->NewPage();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxf","dis&&pdgf==2212","");
-     if(gst_1) gst_1->Draw("pxf","dis&&pdgf==2212","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyf","dis&&pdgf==2212","");
-     if(gst_1) gst_1->Draw("pyf","dis&&pdgf==2212","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzf","dis&&pdgf==2212","");
-     if(gst_1) gst_1->Draw("pzf","dis&&pdgf==2212","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ef","dis&&pdgf==2212","");
-     if(gst_1) gst_1->Draw("Ef","dis&&pdgf==2212","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Final state protons 4-momentum / DIS only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage({
+       { "pxf", "dis&&pdgf==2212" },
+       { "pyf", "dis&&pdgf==2212" },
+       { "pzf", "dis&&pdgf==2212" },
+       { "Ef", "dis&&pdgf==2212" }
+     }, "Final state protons 4-momentum / DIS only");
+
      //------ momentum of final state n /DIS
-     ps->NewPage();
-     c->Clear();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxf","dis&&pdgf==2112","");
-     if(gst_1) gst_1->Draw("pxf","dis&&pdgf==2112","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyf","dis&&pdgf==2112","");
-     if(gst_1) gst_1->Draw("pyf","dis&&pdgf==2112","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzf","dis&&pdgf==2112","");
-     if(gst_1) gst_1->Draw("pzf","dis&&pdgf==2112","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ef","dis&&pdgf==2112","");
-     if(gst_1) gst_1->Draw("Ef","dis&&pdgf==2112","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Final state neutrons 4-momentum / DIS only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage({
+       { "pxf", "dis&&pdgf==2112" },
+       { "pyf", "dis&&pdgf==2112" },
+       { "pzf", "dis&&pdgf==2112" },
+       { "Ef", "dis&&pdgf==2112" }
+     }, "Final state neutrons 4-momentum / DIS only");
+
      //------ momentum of final state pi0 /DIS
-     ps->NewPage();
-     c->Clear();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxf","dis&&pdgf==111","");
-     if(gst_1) gst_1->Draw("pxf","dis&&pdgf==111","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyf","dis&&pdgf==111","");
-     if(gst_1) gst_1->Draw("pyf","dis&&pdgf==111","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzf","dis&&pdgf==111","");
-     if(gst_1) gst_1->Draw("pzf","dis&&pdgf==111","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ef","dis&&pdgf==111","");
-     if(gst_1) gst_1->Draw("Ef","dis&&pdgf==111","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Final state pi0's 4-momentum / DIS only");
-     ls->Draw();
-     c->Update();
+     AddPlotPage({
+       { "pxf", "dis&&pdgf==111" },
+       { "pyf", "dis&&pdgf==111" },
+       { "pzf", "dis&&pdgf==111" },
+       { "Ef", "dis&&pdgf==111" }
+     }, "Final state pi0's 4-momentum / DIS only");
 
      //------ momentum of final state pi+ /DIS
-     ps->NewPage();
-     c->Clear();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxf","dis&&pdgf==211","");
-     if(gst_1) gst_1->Draw("pxf","dis&&pdgf==211","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyf","dis&&pdgf==211","");
-     if(gst_1) gst_1->Draw("pyf","dis&&pdgf==211","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzf","dis&&pdgf==211","");
-     if(gst_1) gst_1->Draw("pzf","dis&&pdgf==211","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ef","dis&&pdgf==211","");
-     if(gst_1) gst_1->Draw("Ef","dis&&pdgf==211","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Final state pi+'s 4-momentum / DIS only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage({
+       { "pxf", "dis&&pdgf==211" },
+       { "pyf", "dis&&pdgf==211" },
+       { "pzf", "dis&&pdgf==211" },
+       { "Ef", "dis&&pdgf==211" }
+     }, "Final state pi+'s 4-momentum / DIS only");
+
      //------ momentum of final state pi+ /DIS
-     ps->NewPage();
-     c->Clear();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxf","dis&&pdgf==-211","");
-     if(gst_1) gst_1->Draw("pxf","dis&&pdgf==-211","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyf","dis&&pdgf==-211","");
-     if(gst_1) gst_1->Draw("pyf","dis&&pdgf==-211","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzf","dis&&pdgf==-211","");
-     if(gst_1) gst_1->Draw("pzf","dis&&pdgf==-211","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ef","dis&&pdgf==-211","");
-     if(gst_1) gst_1->Draw("Ef","dis&&pdgf==-211","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Final state pi-'s 4-momentum/ DIS only");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage({
+       { "pxf", "dis&&pdgf==-211" },
+       { "pyf", "dis&&pdgf==-211" },
+       { "pzf", "dis&&pdgf==-211" },
+       { "Ef", "dis&&pdgf==-211" }
+     }, "Final state pi-'s 4-momentum/ DIS only");
+
   } // per-proc
 
   //
   // SECTION: Primary Hadronic System Multiplicities & 4P
   //
   if(show_primary_hadsyst) {
-     
-     ps->NewPage();
-     c->Clear();
-     c->Range(0,0,100,100);
-     TPavesText hdrihad(10,40,90,70,3,"tr");
-     hdrihad.AddText("Parimary Hadronic System");
-     hdrihad.AddText("Multiplicities and 4-Momenta");
-     hdrihad.AddText(" ");
-     hdrihad.AddText(" ");
-     hdrihad.AddText(" ");
-     hdrihad.AddText(" ");
-     hdrihad.AddText("Note:");
-     hdrihad.AddText("For nuclear targets these plots show the hadronic system");
-     hdrihad.AddText("BEFORE any intranuclear hadron transport / rescattering");
-     hdrihad.Draw();
-     c->Update();
-     
+
+     AddTextPage({
+       "Parimary Hadronic System",
+       "Multiplicities and 4-Momenta",
+       " ",
+       " ",
+       " ",
+       " ",
+       "Note:",
+       "For nuclear targets these plots show the hadronic system",
+       "BEFORE any intranuclear hadron transport / rescattering"
+     });
+
      //------ number of prim p
-     ps->NewPage();
-     gst_0->Draw("nip","","");
-     if(gst_1) gst_1->Draw("nip","","perrsame");
-     ls->Clear();
-     ls->SetHeader("Primary Hadronic System: Number of protons");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nip", "", "Primary Hadronic System: Number of protons");
+
      //------ number of prim n
-     ps->NewPage();
-     gst_0->Draw("nin","","");
-     if(gst_1) gst_1->Draw("nin","","perrsame");
-     ls->Clear();
-     ls->SetHeader("Primary Hadronic System: Number of neutrons");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nin", "", "Primary Hadronic System: Number of neutrons");
+
      //------ number of prim pi+
-     ps->NewPage();
-     gst_0->Draw("nipip","","");
-     if(gst_1) gst_1->Draw("nipip","","perrsame");
-     ls->Clear();
-     ls->SetHeader("Primary Hadronic System: Number of pi+");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nipip", "", "Primary Hadronic System: Number of pi+");
+
      //------ number of prim pi-
-     ps->NewPage();
-     gst_0->Draw("nipim","","");
-     if(gst_1) gst_1->Draw("nipim","","perrsame");
-     ls->Clear();
-     ls->SetHeader("Primary Hadronic System: Number of pi-");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nipim", "", "Primary Hadronic System: Number of pi-");
+
      //------ number of prim pi0
-     ps->NewPage();
-     gst_0->Draw("nipi0","","");
-     if(gst_1) gst_1->Draw("nipi0","","perrsame");
-     ls->Clear();
-     ls->SetHeader("Primary Hadronic System: Number of pi0");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nipi0", "", "Primary Hadronic System: Number of pi0");
+
      //------ number of prim K+
-     ps->NewPage();
-     gst_0->Draw("nikp","","");
-     if(gst_1) gst_1->Draw("nikp","","perrsame");
-     ls->Clear();
-     ls->SetHeader("Primary Hadronic System: Number of K+");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nikp", "", "Primary Hadronic System: Number of K+");
+
      //------ number of prim K-
-     ps->NewPage();
-     gst_0->Draw("nikm","","");
-     if(gst_1) gst_1->Draw("nikm","","perrsame");
-     ls->Clear();
-     ls->SetHeader("Primary Hadronic System: Number of K-");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nikm", "", "Primary Hadronic System: Number of K-");
+
      //------ number of prim K0
-     ps->NewPage();
-     gst_0->Draw("nik0","","");
-     if(gst_1) gst_1->Draw("nik0","","perrsame");
-     ls->Clear();
-     ls->SetHeader("Primary Hadronic System: Number of K0");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage("nik0", "", "Primary Hadronic System: Number of K0");
+
      //------ momentum of prim, p
-     ps->NewPage();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxi","pdgi==2212","");
-     if(gst_1) gst_1->Draw("pxi","pdgi==2212","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyi","pdgi==2212","");
-     if(gst_1) gst_1->Draw("pyi","pdgi==2212","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzi","pdgi==2212","");
-     if(gst_1) gst_1->Draw("pzi","pdgi==2212","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ei","pdgi==2212","");
-     if(gst_1) gst_1->Draw("Ei","pdgi==2212","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Primary Hadronic System: proton 4-momentum");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage({
+       { "pxi", "pdgi==2212" },
+       { "pyi", "pdgi==2212" },
+       { "pzi", "pdgi==2212" },
+       { "Ei", "pdgi==2212" }
+     }, "Primary Hadronic System: proton 4-momentum");
+
      //------ momentum of prim. n
-     ps->NewPage();
-     c->Clear();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxi","pdgi==2112","");
-     if(gst_1) gst_1->Draw("pxi","pdgi==2112","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyi","pdgi==2112","");
-     if(gst_1) gst_1->Draw("pyi","pdgi==2112","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzi","pdgi==2112","");
-     if(gst_1) gst_1->Draw("pzi","pdgi==2112","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ei","pdgi==2112","");
-     if(gst_1) gst_1->Draw("Ei","pdgi==2112","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Primary Hadronic System: neutron 4-momentum");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage({
+       { "pxi", "pdgi==2112" },
+       { "pyi", "pdgi==2112" },
+       { "pzi", "pdgi==2112" },
+       { "Ei", "pdgi==2112" }
+     }, "Primary Hadronic System: neutron 4-momentum");
+
      //------ momentum of prim. pi0
-     ps->NewPage();
-     c->Clear();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxi","pdgi==111","");
-     if(gst_1) gst_1->Draw("pxi","pdgi==111","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyi","pdgi==111","");
-     if(gst_1) gst_1->Draw("pyi","pdgi==111","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzi","pdgi==111","");
-     if(gst_1) gst_1->Draw("pzi","pdgi==111","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ei","pdgi==111","");
-     if(gst_1) gst_1->Draw("Ei","pdgi==111","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Primary Hadronic System: pi0's 4-momentum");
-     ls->Draw();
-     c->Update();
+     AddPlotPage({
+       { "pxi", "pdgi==111" },
+       { "pyi", "pdgi==111" },
+       { "pzi", "pdgi==111" },
+       { "Ei", "pdgi==111" }
+     }, "Primary Hadronic System: pi0's 4-momentum");
 
      //------ momentum of prim pi+
-     ps->NewPage();
-     c->Clear();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxi","pdgi==211","");
-     if(gst_1) gst_1->Draw("pxi","pdgi==211","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyi","pdgi==211","");
-     if(gst_1) gst_1->Draw("pyi","pdgi==211","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzi","pdgi==211","");
-     if(gst_1) gst_1->Draw("pzi","pdgi==211","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ei","pdgi==211","");
-     if(gst_1) gst_1->Draw("Ei","pdgi==211","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Primary Hadronic System:pi+'s 4-momentum");
-     ls->Draw();
-     c->Update();
-     
+     AddPlotPage({
+       { "pxi", "pdgi==211" },
+       { "pyi", "pdgi==211" },
+       { "pzi", "pdgi==211" },
+       { "Ei", "pdgi==211" }
+     }, "Primary Hadronic System:pi+'s 4-momentum");
+
      //------ momentum of prim. pi+
-     ps->NewPage();
-     c->Clear();
-     c->Divide(2,2);
-     c->cd(1);
-     gst_0->Draw("pxi","pdgi==-211","");
-     if(gst_1) gst_1->Draw("pxi","pdgi==-211","perrsame");
-     c->cd(2);
-     gst_0->Draw("pyi","pdgi==-211","");
-     if(gst_1) gst_1->Draw("pyi","pdgi==-211","perrsame");
-     c->cd(3);
-     gst_0->Draw("pzi","pdgi==-211","");
-     if(gst_1) gst_1->Draw("pzi","pdgi==-211","perrsame");
-     c->cd(4);
-     gst_0->Draw("Ei","pdgi==-211","");
-     if(gst_1) gst_1->Draw("Ei","pdgi==-211","perrsame");
-     c->cd();
-     ls->Clear();
-     ls->SetHeader("Primary Hadronic System:  pi-'s 4-momentum");
-     ls->Draw();
-     c->Update();
+     AddPlotPage({
+       { "pxi", "pdgi==-211" },
+       { "pyi", "pdgi==-211" },
+       { "pzi", "pdgi==-211" },
+       { "Ei", "pdgi==-211" }
+     }, "Primary Hadronic System:  pi-'s 4-momentum");
   }//show?
-       
-  ps->Close();
 
-  fin_0->Close();
-  delete fin_0;
-  if(fin_1) {
-     fin_1->Close();
-     delete fin_1;
+}
+//_________________________________________________________________________________
+int AddPlot(string var, string sel, bool count_only)
+{
+// Books a plot; plots of the same variable & selection are filled once
+
+  string key = var + "\n" + sel + (count_only ? "\nN" : "");
+  map<string,int>::const_iterator it = gPlotIdx.find(key);
+  if(it != gPlotIdx.end()) return it->second;
+
+  GstPlot_t plot;
+  plot.var        = var;
+  plot.sel        = sel;
+  plot.count_only = count_only;
+  plot.vmin       =  DBL_MAX;
+  plot.vmax       = -DBL_MAX;
+  plot.nest       = 0;
+  plot.hist[0]    = plot.hist[1] = 0;
+  plot.nsel[0]    = plot.nsel[1] = 0;
+  gPlots.push_back(plot);
+
+  int idx = gPlots.size() - 1;
+  gPlotIdx[key] = idx;
+  return idx;
+}
+//_________________________________________________________________________________
+void AddTextPage(vector<string> text)
+{
+  GstPageDef_t page;
+  page.type = kPgText;
+  page.text = text;
+  gPages.push_back(page);
+}
+//_________________________________________________________________________________
+void AddCountPage(vector<GstPlotSpec_t> counts)
+{
+  GstPageDef_t page;
+  page.type = kPgCounts;
+  for(unsigned int i = 0; i < counts.size(); i++) {
+    page.text .push_back(counts[i].first);
+    page.plots.push_back(AddPlot("1", counts[i].second, true));
+  }
+  gPages.push_back(page);
+}
+//_________________________________________________________________________________
+void AddPlotPage(string var, string sel, string header)
+{
+  AddPlotPage(vector<GstPlotSpec_t>(1, GstPlotSpec_t(var,sel)), header);
+}
+//_________________________________________________________________________________
+void AddPlotPage(vector<GstPlotSpec_t> plots, string header)
+{
+  assert(plots.size() == 1 || plots.size() == 4);
+
+  GstPageDef_t page;
+  page.type   = kPgPlots;
+  page.header = header;
+  for(unsigned int i = 0; i < plots.size(); i++) {
+    page.plots.push_back(AddPlot(plots[i].first, plots[i].second));
+  }
+  gPages.push_back(page);
+}
+//_________________________________________________________________________________
+void ProcessTree(TTree * tree, int isample, bool estimate)
+{
+// Evaluates all booked plots in a single pass over the input tree.
+// The selection is used as weight and array variables are handled as in
+// TTree::Draw(). In `estimate' mode, only the range of the first
+// tree->GetEstimate() selected values of each plot is found (the pass stops
+// as soon as all plots have enough values); otherwise the histograms and
+// the selected entry counts are filled.
+
+  unsigned int nplots = gPlots.size();
+  Long64_t     nest   = tree->GetEstimate();
+
+  vector<TTreeFormula *>        vars(nplots, (TTreeFormula*)0);
+  vector<TTreeFormula *>        sels(nplots, (TTreeFormula*)0);
+  vector<TTreeFormulaManager *> mgrs(nplots, (TTreeFormulaManager*)0);
+
+  tree->SetCacheSize(100*1024*1024);
+  for(unsigned int i = 0; i < nplots; i++) {
+    GstPlot_t & plot = gPlots[i];
+    if(estimate && plot.count_only) continue;
+    if(!estimate && !plot.count_only && !plot.hist[isample]) continue;
+
+    mgrs[i] = new TTreeFormulaManager;
+    if(plot.sel.size() > 0) {
+      sels[i] = new TTreeFormula(Form("sel%d",i), plot.sel.c_str(), tree);
+      mgrs[i]->Add(sels[i]);
+    }
+    vars[i] = new TTreeFormula(Form("var%d",i), plot.var.c_str(), tree);
+    mgrs[i]->Add(vars[i]);
+    mgrs[i]->Sync();
+
+    // only read the branches needed by the plots
+    TTreeFormula * f[2] = { vars[i], sels[i] };
+    for(int k = 0; k < 2; k++) {
+      if(!f[k]) continue;
+      for(int j = 0; j < f[k]->GetNcodes(); j++) {
+        TLeaf * leaf = f[k]->GetLeaf(j);
+        if(leaf) tree->AddBranchToCache(leaf->GetBranch(), true);
+      }
+    }
+  }
+  tree->StopCacheLearningPhase();
+
+  Long64_t nentries = tree->GetEntries();
+  Long64_t ientry   = 0;
+  for( ; ientry < nentries; ientry++) {
+    if(tree->LoadTree(ientry) < 0) break;
+
+    int nactive = 0;
+    for(unsigned int i = 0; i < nplots; i++) {
+      if(!mgrs[i]) continue;
+      GstPlot_t & plot = gPlots[i];
+      if(estimate && plot.nest >= nest) continue;
+      nactive++;
+
+      int ndata = mgrs[i]->GetNdata();
+      for(int k = 0; k < ndata; k++) {
+        double w = (sels[i]) ? sels[i]->EvalInstance(k) : 1.;
+        if(w == 0) continue;
+        if(plot.count_only) {
+          plot.nsel[isample]++;
+          continue;
+        }
+        double v = vars[i]->EvalInstance(k);
+        if(estimate) {
+          plot.vmin = TMath::Min(plot.vmin, v);
+          plot.vmax = TMath::Max(plot.vmax, v);
+          if(++plot.nest >= nest) break;
+        } else {
+          plot.hist[isample]->Fill(v, w);
+          plot.nsel[isample]++;
+        }
+      }
+    }
+    if(nactive == 0) break;
+  }
+
+  LOG("gevcomp", pNOTICE)
+    << (estimate ? "Estimated the histogram ranges from " : "Filled all plots from ")
+    << ientry << " entries of " << tree->GetCurrentFile()->GetName();
+
+  // a formula removes itself from its manager, which is deleted along with
+  // its last formula: the managers must not be deleted here
+  for(unsigned int i = 0; i < nplots; i++) {
+    mgrs[i] = 0;
+    if(vars[i]) delete vars[i];
+    if(sels[i]) delete sels[i];
+  }
+  tree->SetCacheSize(0);
+}
+//_________________________________________________________________________________
+void BookHistograms(TTree * tree, int isample)
+{
+// Books the histograms as TTree::Draw() does: the test sample histograms get
+// `good' limits around the estimated range and can extend; the reference
+// sample histograms (drawn with "same") take the final test sample binning
+
+  int nbins = gEnv->GetValue("Hist.Binning.1D.x", 100);
+
+  for(unsigned int i = 0; i < gPlots.size(); i++) {
+    GstPlot_t & plot = gPlots[i];
+    if(plot.count_only) continue;
+
+    string title = plot.var;
+    if(plot.sel.size() > 0) title += " {" + plot.sel + "}";
+
+    TH1F * h = 0;
+    if(isample == 0) {
+      if(plot.nest == 0) continue; // nothing selected: not drawn
+      h = new TH1F(Form("h%d_%d",isample,i), title.c_str(), nbins, 0., 0.);
+      h->SetCanExtend(TH1::kAllAxes);
+      TTreeFormula var("var", plot.var.c_str(), tree);
+      if(var.IsInteger()) h->GetXaxis()->SetBit(TAxis::kIsInteger);
+      THLimitsFinder::GetLimitsFinder()->FindGoodLimits(h, plot.vmin, plot.vmax);
+    } else {
+      const TH1F * h0 = plot.hist[0];
+      if(!h0) continue;
+      h = new TH1F(Form("h%d_%d",isample,i), title.c_str(),
+             h0->GetNbinsX(), h0->GetXaxis()->GetXmin(), h0->GetXaxis()->GetXmax());
+    }
+    h->SetDirectory(0);
+    h->GetXaxis()->SetTitle(plot.var.c_str());
+    tree->TAttLine  ::Copy(*h);
+    tree->TAttFill  ::Copy(*h);
+    tree->TAttMarker::Copy(*h);
+    plot.hist[isample] = h;
+  }
+}
+//_________________________________________________________________________________
+void DrawPages(TPostScript * ps, TCanvas * c, TLegend * ls, bool has_ref)
+{
+  for(unsigned int ip = 0; ip < gPages.size(); ip++) {
+    const GstPageDef_t & page = gPages[ip];
+
+    ps->NewPage();
+    c->Clear();
+
+    if(page.type == kPgText || page.type == kPgCounts) {
+      c->Range(0,0,100,100);
+      TPavesText * txt = (page.type == kPgText) ?
+          new TPavesText(10,40,90,70,3,"tr") :
+          new TPavesText(10,10,90,90,3,"tr");
+      txt->SetBit(kCanDelete);
+      if(page.type == kPgText) {
+        for(unsigned int i = 0; i < page.text.size(); i++) {
+          txt->AddText(page.text[i].c_str());
+        }
+      } else {
+        txt->AddText("Event Numbers:");
+        txt->AddText("  ");
+        for(unsigned int i = 0; i < page.text.size(); i++) {
+          const GstPlot_t & plot = gPlots[page.plots[i]];
+          float n0 = plot.nsel[0];
+          float n1 = (has_ref) ? plot.nsel[1] : 0;
+          txt->AddText( Form("%s: %7.0f [test sample], %7.0f [ref sample]",
+                              page.text[i].c_str(), n0, n1) );
+        }
+      }
+      txt->Draw();
+      c->Update();
+      continue;
+    }
+
+    bool grid = (page.plots.size() == 4);
+    if(grid) c->Divide(2,2);
+    for(unsigned int i = 0; i < page.plots.size(); i++) {
+      if(grid) c->cd(i+1);
+      const GstPlot_t & plot = gPlots[page.plots[i]];
+      if(!plot.hist[0] || plot.nsel[0] <= 0) continue;
+      plot.hist[0]->Draw("");
+      if(has_ref && plot.hist[1] && plot.nsel[1] > 0) {
+        plot.hist[1]->Draw("perrsame");
+      }
+    }
+    if(grid) c->cd();
+    if(page.header.size() > 0) {
+      ls->Clear();
+      ls->SetHeader(page.header.c_str());
+      ls->Draw();
+    }
+    c->Update();
   }
 }
 //_________________________________________________________________________________
@@ -2021,13 +1212,18 @@ void GetCommandLineArgs(int argc, char ** argv)
   } else {
     LOG("gevcomp", pNOTICE) << "Unspecified 'reference' event sample";
   }
+
+  // number of threads for decompressing the input trees
+  if( parser.OptionExists('j') ) {
+    gOptNThreads = parser.ArgAsInt('j');
+  }
 }
 //_________________________________________________________________________________
 void PrintSyntax(void)
 {
   LOG("gevcomp", pNOTICE)
     << "\n\n" << "Syntax:" << "\n"
-    << " gevcomp -f sample.root [-n nev] [-r reference_sample.root]\n";
+    << " gevcomp -f sample.root [-n nev] [-r reference_sample.root] [-j nthreads]\n";
 }
 //_________________________________________________________________________________
 bool CheckRootFilename(string filename)
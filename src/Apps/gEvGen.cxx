@@ -166,6 +166,7 @@ Syntax:
 #include "Framework/Conventions/GBuild.h"
 #include "Framework/Conventions/Controls.h"
 #include "Framework/EventGen/EventRecord.h"
+#include "Framework/EventGen/EventRecordPool.h"
 #include "Framework/EventGen/GFluxI.h"
 #include "Framework/EventGen/GEVGDriver.h"
 #include "Framework/EventGen/GMCJDriver.h"
@@ -352,7 +353,7 @@ void GenerateEventsAtFixedInitState(void)
      ntpw.AddEventRecord(ievent, event);
      mcjmonitor.Update(ievent,event);
      ievent++;
-     delete event;
+     EventRecordPool::Instance()->Release(event);
   }
 
   // Save the generated MC events
@@ -416,7 +417,7 @@ void GenerateEventsUsingFluxOrTgtMix(void)
      ntpw.AddEventRecord(ievent, event);
      mcjmonitor.Update(ievent,event);
      ievent++;
-     delete event;
+     EventRecordPool::Instance()->Release(event);
   }
 
   // Save the generated MC events
@@ -154,6 +154,7 @@
 #include "Framework/Conventions/Constants.h"
 #include "Framework/Conventions/Units.h"
 #include "Framework/EventGen/EventRecord.h"
+#include "Framework/EventGen/EventRecordPool.h"
 #include "Framework/EventGen/GFluxI.h"
 #include "Framework/EventGen/GEVGDriver.h"
 #include "Framework/EventGen/GMCJDriver.h"
@@ -361,7 +362,7 @@ void GenerateEventsAtFixedInitState(void)
     ntpw.AddEventRecord(ievent, event);
     mcjmonitor.Update(ievent,event);
     ievent++;
-    delete event;
+    EventRecordPool::Instance()->Release(event);
   }
 
   // Save the generated MC events
@@ -422,7 +423,7 @@ void GenerateEventsUsingFluxOrTgtMix(void)
      ntpw.AddEventRecord(ievent, event);
      mcjmonitor.Update(ievent,event);
      ievent++;
-     delete event;
+     EventRecordPool::Instance()->Release(event);
   }
 
   // Save the generated MC events
@@ -6,10 +6,17 @@
 \brief   A utility that reads-in a GHEP event tree and performs basic sanity 
          checks / test whether the generated events obey basic conservation laws
 
+         All enabled checks run as visitors over a single pass on the event
+         tree. The requested event range is split in chunks which are
+         processed by a number of worker threads and the per-chunk results
+         are merged in event order, so that the output does not depend on the
+         number of threads.
+
 \syntax  gevscan
              -f ghep_event_file 
             [-o output_error_log_file]
             [-n nev1[,nev2]]
+            [-j nthreads]
             [--add-event-printout-in-error-log]
             [--max-num-of-errors-shown n]
             [--event-record-print-level level]
@@ -37,14 +44,19 @@
 
 #include <string>
 #include <vector>
+#include <map>
 #include <iomanip>
 #include <sstream>
 #include <fstream>
+#include <thread>
+#include <atomic>
 
 #include <TSystem.h>
+#include <TROOT.h>
 #include <TFile.h>
 #include <TTree.h>
 #include <TH1D.h>
+#include <TAxis.h>
 #include <TLorentzVector.h>
 
 #include "Framework/Conventions/Constants.h"
@@ -66,6 +78,7 @@ using std::ostringstream;
 using std::ofstream;
 using std::string;
 using std::vector;
+using std::map;
 using std::setw;
 using std::setprecision;
 using std::setfill;
@@ -75,24 +88,19 @@ using std::endl;
 using namespace genie;
 using namespace genie::constants;
 
+class EvScanCheck;
+
 void GetCommandLineArgs (int argc, char ** argv);
 void PrintSyntax        (void);
 bool CheckRootFilename  (string filename);
-
-// checks
-void CheckEnergyMomentumConservation (void);
-void CheckChargeConservation (void);
-void CheckForPseudoParticlesInFinState (void);
-void CheckForOffMassShellParticlesInFinState (void);
-void CheckForNumFinStateNucleonsInconsistentWithTarget (void);
-void CheckVertexDistribution (void);
-void CheckDecayerConsistency (void);
+void ScanEvents         (const vector<EvScanCheck *> & checks);
 
 // options
 string   gOptInpFilename = "";
 string   gOptOutFilename = "";
 Long64_t gOptNEvtL = -1;
 Long64_t gOptNEvtH = -1;
+int      gOptNThreads = 1;
 int      gOptMaxNumErrs = -1; 
 bool     gOptAddEventPrintoutInErrLog = false;
 bool     gOptCheckEnergyMomentumConservation = false;
@@ -111,113 +119,116 @@ NtpMCEventRecord * gMCRec = 0;
 ofstream           gErrLog;
 
 //____________________________________________________________________________
-int main(int argc, char ** argv)
+// Event checks.
+// A check is cloned for each chunk of events and the clone visits all events
+// of the chunk (possibly in a worker thread). The chunk results are then
+// merged, in event order, into the original check which writes the report.
+// Checks should not modify the input event or use any shared state.
+//
+class EvScanCheck
 {
-  GetCommandLineArgs (argc, argv);
-
-  // Set GHEP print level
-  GHepRecord::SetPrintLevel(RunOpt::Instance()->EventRecordPrintLevel());
-
-  TFile file(gOptInpFilename.c_str(),"READ");
-
-  NtpMCTreeHeader * thdr = dynamic_cast <NtpMCTreeHeader *> ( file.Get("header") );
-  LOG("gevscan", pINFO) << "Input tree header: " << *thdr;
-  NtpMCFormat_t format = thdr->format;
-  if(format != kNFGHEP) {
-      LOG("gevscan", pERROR) 
-        << "*** Unsupported event-tree format : "
-        << NtpMCFormat::AsString(format);
-      file.Close();
-      return 3;
+public:
+  virtual ~EvScanCheck() {}
+
+  virtual EvScanCheck * Clone  (void) const = 0;
+  virtual void          Visit  (Long64_t iev, const EventRecord & event) = 0;
+  virtual void          Merge  (const EvScanCheck & chunk) = 0;
+  virtual void          Report (void) = 0;
+};
+//____________________________________________________________________________
+// Checks flagging individual events
+//
+class EvScanEventCheck : public EvScanCheck
+{
+public:
+  EvScanEventCheck(string start_mesg, string errlog_title,
+                   string err_mesg, string summary_mesg) :
+    fStartMesg(start_mesg), fErrLogTitle(errlog_title),
+    fErrMesg(err_mesg), fSummaryMesg(summary_mesg), fErrLogEndl(true)
+  {
   }
 
-  gEventTree = dynamic_cast <TTree *> (file.Get("gtree"));
-  gEventTree->SetBranchAddress("gmcrec", &gMCRec);
+  void Visit(Long64_t iev, const EventRecord & event)
+  {
+    if(gOptMaxNumErrs != -1 && (int)fFailed.size() >= gOptMaxNumErrs) return;
+    if(this->Pass(event)) return;
 
-  Long64_t nev = gEventTree->GetEntries();
-  if(gOptNEvtL == -1 && gOptNEvtH == -1) {
-    // read all events
-    gFirstEventNum = 0;
-    gLastEventNum  = nev-1;
-  }
-  else {
-    // read a range of events
-    gFirstEventNum = TMath::Max((Long64_t)0,  gOptNEvtL);
-    gLastEventNum = TMath::Min(nev-1,        gOptNEvtH);
-    if(gLastEventNum - gFirstEventNum < 0) {
-      LOG("gevdump", pFATAL) << "Invalid event range";
-      PrintSyntax();
-      gAbortingInErr = true;
-      exit(1);
-    }
+    ostringstream printout;
+    printout << event;
+    fFailed  .push_back(iev);
+    fPrintout.push_back(printout.str());
   }
 
-  
-  if(gOptOutFilename.size() == 0) {
-     ostringstream logfile;
-     logfile << gOptInpFilename << ".errlog";
-     gOptOutFilename = logfile.str();
-  }
-  if(gOptOutFilename != "none") {
-     gErrLog.open(gOptOutFilename.c_str());
-     gErrLog << "# ..................................................................................." << endl;
-     gErrLog << "# Error log for event file " << gOptInpFilename << endl;
-     gErrLog << "# ..................................................................................." << endl;
-     gErrLog << "# " << endl;
+  void Merge(const EvScanCheck & chunk)
+  {
+    const EvScanEventCheck & other = dynamic_cast<const EvScanEventCheck &>(chunk);
+    for(unsigned int i = 0; i < other.fFailed.size(); i++) {
+      if(gOptMaxNumErrs != -1 && (int)fFailed.size() >= gOptMaxNumErrs) break;
+      fFailed  .push_back(other.fFailed  [i]);
+      fPrintout.push_back(other.fPrintout[i]);
+    }
   }
 
-  if (gOptCheckEnergyMomentumConservation) {
-	  CheckEnergyMomentumConservation();
-  }
-  if (gOptCheckChargeConservation) {
-          CheckChargeConservation();
-  }
-  if (gOptCheckForPseudoParticlesInFinState) {
-          CheckForPseudoParticlesInFinState();
-  }
-  if (gOptCheckForOffMassShellParticlesInFinState) {
-          CheckForOffMassShellParticlesInFinState();
-  }
-  if (gOptCheckForNumFinStateNucleonsInconsistentWithTarget) {
-          CheckForNumFinStateNucleonsInconsistentWithTarget();
-  }
-  if (gOptCheckVertexDistribution) {
-          CheckVertexDistribution();
-  }
-  if (gOptCheckDecayerConsistency) {
-          CheckDecayerConsistency();
-  }
+  void Report(void)
+  {
+    LOG("gevscan", pNOTICE) << fStartMesg;
 
+    if(gErrLog.is_open()) {
+      gErrLog << "# " << fErrLogTitle << ":" << endl;
+      gErrLog << "# " << endl;
+    }
+    for(unsigned int i = 0; i < fFailed.size(); i++) {
+      LOG("gevscan", pERROR) 
+        << " ** " << fErrMesg << " in event: " << fFailed[i] 
+        << "\n"
+        << fPrintout[i];
+      if(gErrLog.is_open()) {
+        gErrLog << fFailed[i];
+        if(fErrLogEndl) gErrLog << endl;
+        if(gOptAddEventPrintoutInErrLog) {
+          gErrLog << fPrintout[i];
+        }
+      }
+    }
+    if(gErrLog.is_open()) {
+      if(fFailed.size() == 0) {
+        gErrLog << "none" << endl;    
+      }
+    }
 
-  if(gOptOutFilename != "none") {
-     gErrLog.close();
+    LOG("gevscan", pNOTICE) 
+       << "Found " << fFailed.size() << " " << fSummaryMesg;
   }
 
-  return 0;
-}
+protected:
+  virtual bool Pass (const EventRecord & event) const = 0;
+
+  string           fStartMesg;    ///< logged before the report
+  string           fErrLogTitle;  ///< error log section title
+  string           fErrMesg;      ///< logged for each failing event
+  string           fSummaryMesg;  ///< logged after the number of failing events
+  bool             fErrLogEndl;   ///< end line after each failing event number in the error log
+  vector<Long64_t> fFailed;       ///< failing events (in event order)
+  vector<string>   fPrintout;     ///< failing event printouts
+};
 //____________________________________________________________________________
-void CheckEnergyMomentumConservation (void)
+class CheckEnergyMomentumConservation : public EvScanEventCheck
 {
-  LOG("gevscan", pNOTICE) << "Checking energy/momentum conservation...";
-
-  if(gErrLog.is_open()) {
-    gErrLog << "# Events failing the energy-momentum conservation test:" << endl;
-    gErrLog << "# " << endl;
+public:
+  CheckEnergyMomentumConservation() :
+    EvScanEventCheck(
+      "Checking energy/momentum conservation...",
+      "Events failing the energy-momentum conservation test",
+      "Energy-momentum non-conservation",
+      "events failing the energy/momentum conservation test")
+  {
+    fErrLogEndl = false;
   }
+  EvScanCheck * Clone(void) const { return new CheckEnergyMomentumConservation; }
 
-  int nerr = 0;
-
-  for(Long64_t i = gFirstEventNum; i <= gLastEventNum; i++) 
+protected:
+  bool Pass(const EventRecord & event) const
   {
-    if(gOptMaxNumErrs != -1 && nerr >= gOptMaxNumErrs) break;
-
-    gEventTree->GetEntry(i);
-
-    NtpMCRecHeader rec_header = gMCRec->hdr;
-    EventRecord &  event      = *(gMCRec->event);
-
-    LOG("gevscan", pINFO) << "Checking event.... " << i;
-
     double E_init  = 0, E_fin  = 0; // E
     double px_init = 0, px_fin = 0; // px
     double py_init = 0, py_fin = 0; // py
@@ -253,461 +264,290 @@ void CheckEnergyMomentumConservation (void)
     bool py_conserved = TMath::Abs(py_init - py_fin) < epsilon;
     bool pz_conserved = TMath::Abs(pz_init - pz_fin) < epsilon;
 
-    bool ok = E_conserved  && 
-              px_conserved &&
-              py_conserved &&
-              pz_conserved;
-
-    if(!ok) {
-       LOG("gevscan", pERROR) 
-         << " ** Energy-momentum non-conservation in event: " << i 
-         << "\n"
-         << event;
-       if(gErrLog.is_open()) {
-           gErrLog << i;
-           if(gOptAddEventPrintoutInErrLog) {
-               gErrLog << event;
-           }
-       }
-       nerr++;
-    }
-    
-    gMCRec->Clear(); // clear out explicitly to prevent memory leak w/Root6
-
-  }//i
-
-  if(gErrLog.is_open()) {
-     if(nerr == 0) {
-         gErrLog << "none" << endl;    
-     }
+    return E_conserved  && 
+           px_conserved &&
+           py_conserved &&
+           pz_conserved;
   }
-
-  LOG("gevscan", pNOTICE) 
-     << "Found " << nerr 
-     << " events failing the energy/momentum conservation test";
-}
+};
 //____________________________________________________________________________
-void CheckChargeConservation(void)
+class CheckChargeConservation : public EvScanEventCheck
 {
-  LOG("gevscan", pNOTICE) << "Checking charge conservation...";
-
-  if(gErrLog.is_open()) {
-     gErrLog << "# Events failing the charge conservation test:" << endl;
-     gErrLog << "# " << endl;
+public:
+  CheckChargeConservation() :
+    EvScanEventCheck(
+      "Checking charge conservation...",
+      "Events failing the charge conservation test",
+      "Charge non-conservation",
+      "events failing the charge conservation test")
+  {
   }
+  EvScanCheck * Clone(void) const { return new CheckChargeConservation; }
 
-  int nerr = 0;
-
-  for(Long64_t i = gFirstEventNum; i <= gLastEventNum; i++) 
+protected:
+  bool Pass(const EventRecord & event) const
   {
-    if(gOptMaxNumErrs != -1 && nerr >= gOptMaxNumErrs) break;
-
-    gEventTree->GetEntry(i);
-
-    NtpMCRecHeader rec_header = gMCRec->hdr;
-    EventRecord &  event      = *(gMCRec->event);
-
-    LOG("gevscan", pINFO) << "Checking event.... " << i;
-
     // Can't run the test for neutrinos scattered off nuclear targets
     // because of intranuclear rescattering effects and the presence, in the event
     // record, of a charged nuclear remnant pseudo-particle whose charge is not stored.
     // To check charge conservation in the primary interaction, use a sample generated
     // for a free nucleon targets.
-    GHepParticle * nucltgt = event.TargetNucleus();
-    if (nucltgt) {
-      LOG("gevscan", pINFO)
-           << "Event in nuclear target - Skipping test...";
-    }
-    else {
-      double Q_init  = 0;
-      double Q_fin   = 0; 
+    if(event.TargetNucleus()) return true;
 
-      GHepParticle * p = 0;
-      TIter event_iter(&event);
-      while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
+    double Q_init  = 0;
+    double Q_fin   = 0; 
 
-        GHepStatus_t ist  = p->Status();
+    GHepParticle * p = 0;
+    TIter event_iter(&event);
+    while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
 
-        if(ist == kIStInitialState) 
-        {
-           Q_init  += p->Charge();
-         }
-         if(ist == kIStStableFinalState)
-         {
-           Q_fin  += p->Charge();
-         }
-      }//p
-
-      double epsilon = 1E-3; 
-      bool ok = TMath::Abs(Q_init - Q_fin)  < epsilon;
-      if(!ok) {
-         LOG("gevscan", pERROR) 
-           << " ** Charge non-conservation in event: " << i 
-           << "\n"
-           << event;
-         if(gErrLog.is_open()) {
-            gErrLog << i << endl;    
-            if(gOptAddEventPrintoutInErrLog) {
-                 gErrLog << event;
-            }
-         }
-         nerr++;
-      }
-      
-    }
-    gMCRec->Clear(); // clear out explicitly to prevent memory leak w/Root6
-  }//i
+      GHepStatus_t ist  = p->Status();
 
-  if(gErrLog.is_open()) {
-     if(nerr == 0) {
-        gErrLog << "none" << endl;    
-     }
-  }
+      if(ist == kIStInitialState) 
+      {
+         Q_init  += p->Charge();
+       }
+       if(ist == kIStStableFinalState)
+       {
+         Q_fin  += p->Charge();
+       }
+    }//p
 
-  LOG("gevscan", pNOTICE) 
-     << "Found " << nerr 
-     << " events failing the charge conservation test";
-}
+    double epsilon = 1E-3; 
+    return TMath::Abs(Q_init - Q_fin) < epsilon;
+  }
+};
 //____________________________________________________________________________
-void CheckForPseudoParticlesInFinState(void)
+class CheckForPseudoParticlesInFinState : public EvScanEventCheck
 {
-  LOG("gevscan", pNOTICE) 
-      << "Checking for pseudo-particles appearing in final state...";
-
-  if(gErrLog.is_open()) {
-     gErrLog << "# Events with pseudo-particles in final state:" << endl;
-     gErrLog << "# " << endl;
+public:
+  CheckForPseudoParticlesInFinState() :
+    EvScanEventCheck(
+      "Checking for pseudo-particles appearing in final state...",
+      "Events with pseudo-particles in final state",
+      "Pseudo-particle final state particle",
+      "events with pseudo-particles in  final state")
+  {
   }
+  EvScanCheck * Clone(void) const { return new CheckForPseudoParticlesInFinState; }
 
-  int nerr = 0;
-
-  for(Long64_t i = gFirstEventNum; i <= gLastEventNum; i++) 
+protected:
+  bool Pass(const EventRecord & event) const
   {
-    if(gOptMaxNumErrs != -1 && nerr >= gOptMaxNumErrs) break;
-
-    gEventTree->GetEntry(i);
-
-    NtpMCRecHeader rec_header = gMCRec->hdr;
-    EventRecord &  event      = *(gMCRec->event);
-
-    LOG("gevscan", pINFO) << "Checking event.... " << i;
-
     GHepParticle * p = 0;
     TIter event_iter(&event);
-    bool ok = true;
     while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
-
       GHepStatus_t ist = p->Status();
       if(ist != kIStStableFinalState) continue;
-      int pdgc = p->Pdg();      
-      if(pdg::IsPseudoParticle(pdgc))
-      {
-        ok = false;
-        break;
-      }      
+      if(pdg::IsPseudoParticle(p->Pdg())) return false;
     }//p
-
-    if(!ok) {
-       LOG("gevscan", pERROR) 
-         << " ** Pseudo-particle final state particle in event: " << i 
-         << "\n"
-         << event;
-       if(gErrLog.is_open()) {
-          gErrLog << i << endl;    
-          if(gOptAddEventPrintoutInErrLog) {
-               gErrLog << event;
-          }
-       }
-       nerr++;
-    }
-
-    gMCRec->Clear(); // clear out explicitly to prevent memory leak w/Root6
-
-  }//i
-
-  if(gErrLog.is_open()) {
-     if(nerr == 0) {
-        gErrLog << "none" << endl;    
-     }
+    return true;
   }
-
-  LOG("gevscan", pNOTICE) 
-     << "Found " << nerr 
-     << " events with pseudo-particles in  final state";
-}
+};
 //____________________________________________________________________________
-void CheckForOffMassShellParticlesInFinState(void)
+class CheckForOffMassShellParticlesInFinState : public EvScanEventCheck
 {
-  LOG("gevscan", pNOTICE) 
-      << "Checking for off-mass-shell particles appearing in the final state...";
-
-  if(gErrLog.is_open()) {
-     gErrLog << "# Events with off-mass-shell particles in final state:" << endl;
-     gErrLog << "# " << endl;
+public:
+  CheckForOffMassShellParticlesInFinState() :
+    EvScanEventCheck(
+      "Checking for off-mass-shell particles appearing in the final state...",
+      "Events with off-mass-shell particles in final state",
+      "Off-mass-shell final state particle",
+      "events with off-mass-shell particles in final state")
+  {
   }
+  EvScanCheck * Clone(void) const { return new CheckForOffMassShellParticlesInFinState; }
 
-  int nerr = 0;
-
-  for(Long64_t i = gFirstEventNum; i <= gLastEventNum; i++) 
+protected:
+  bool Pass(const EventRecord & event) const
   {
-    if(gOptMaxNumErrs != -1 && nerr >= gOptMaxNumErrs) break;
-
-    gEventTree->GetEntry(i);
-
-    NtpMCRecHeader rec_header = gMCRec->hdr;
-    EventRecord &  event      = *(gMCRec->event);
-
-    LOG("gevscan", pINFO) << "Checking event.... " << i;
-
     GHepParticle * p = 0;
     TIter event_iter(&event);
-    bool ok = true;
     while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
-
       GHepStatus_t ist = p->Status();
       if(ist != kIStStableFinalState) continue;
-      if(p->IsOffMassShell())
-      {
-        ok = false;
-        break;
-      }      
+      if(p->IsOffMassShell()) return false;
     }//p
-
-    if(!ok) {
-       LOG("gevscan", pERROR) 
-         << " ** Off-mass-shell final state particle in event: " << i 
-         << "\n"
-         << event;
-       if(gErrLog.is_open()) {
-          gErrLog << i << endl;    
-          if(gOptAddEventPrintoutInErrLog) {
-               gErrLog << event;
-          }
-       }
-       nerr++;
-    }
-
-    gMCRec->Clear(); // clear out explicitly to prevent memory leak w/Root6
-
-  }//i
-
-  if(gErrLog.is_open()) {
-     if(nerr == 0) {
-        gErrLog << "none" << endl;    
-     }
+    return true;
   }
-
-  LOG("gevscan", pNOTICE) 
-     << "Found " << nerr 
-     << " events with off-mass-shell particles in final state";
-}
+};
 //____________________________________________________________________________
-void CheckForNumFinStateNucleonsInconsistentWithTarget(void)
+class CheckForNumFinStateNucleonsInconsistentWithTarget : public EvScanEventCheck
 {
-  LOG("gevscan", pNOTICE) 
-     << "Checking for number of final state nucleons inconsistent with target...";
-
-  if(gErrLog.is_open()) {
-    gErrLog << "# Events with number of final state nucleons inconsistent with target:" << endl;
-    gErrLog << "# " << endl;
+public:
+  CheckForNumFinStateNucleonsInconsistentWithTarget() :
+    EvScanEventCheck(
+      "Checking for number of final state nucleons inconsistent with target...",
+      "Events with number of final state nucleons inconsistent with target",
+      "Number of final state nucleons inconsistent with target",
+      "events with a number of final state nucleons inconsistent with target")
+  {
   }
+  EvScanCheck * Clone(void) const { return new CheckForNumFinStateNucleonsInconsistentWithTarget; }
 
-  int nerr = 0;
-
-  for(Long64_t i = gFirstEventNum; i <= gLastEventNum; i++) 
+protected:
+  bool Pass(const EventRecord & event) const
   {
-    if(gOptMaxNumErrs != -1 && nerr >= gOptMaxNumErrs) break;
-
-    gEventTree->GetEntry(i);
-
-    NtpMCRecHeader rec_header = gMCRec->hdr;
-    EventRecord &  event      = *(gMCRec->event);
-
-    LOG("gevscan", pINFO) << "Checking event.... " << i;
-
     // get target nucleus
     GHepParticle * nucltgt = event.TargetNucleus();
-    if (!nucltgt) {
-      LOG("gevscan", pINFO)
-           << "Event not in nuclear target - Skipping test...";
-    }
-    else {
-      GHepParticle * p = 0;
-
-      int Z = 0;
-      int N = 0;
-
-      // get number of spectator nucleons 
-      int fd = nucltgt->FirstDaughter();
-      int ld = nucltgt->LastDaughter();
-      for(int d = fd; d <= ld; d++) {
-        p = event.Particle(d);
-        if(!p) continue;
-        int pdgc = p->Pdg();
-        if(pdg::IsIon(pdgc)) {
-          Z = p->Z();
-          N = p->A() - p->Z();
-        }
-      }
-      // add nucleons from the primary interaction
-      TIter event_iter(&event);
-      while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
-        GHepStatus_t ist = p->Status();
-        if(ist != kIStHadronInTheNucleus) continue;
-        int pdgc = p->Pdg();
-        if(pdg::IsProton (pdgc)) { Z++; }
-        if(pdg::IsNeutron(pdgc)) { N++; }
-      }//p
-
-      LOG("gevscan", pINFO)
-         << "Before intranuclear hadron transport: Z = " << Z << ", N = " << N;
-
-      // count final state nucleons
-      int Zf = 0;
-      int Nf = 0;
-      event_iter.Reset();
-      while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
-        GHepStatus_t ist = p->Status();
-        if(ist != kIStStableFinalState) continue;
-        int pdgc = p->Pdg();
-        if(pdg::IsProton (pdgc)) { Zf++; }
-        if(pdg::IsNeutron(pdgc)) { Nf++; }
-      }
-      LOG("gevscan", pINFO)
-         << "In the final state: Z = " << Zf << ", N = " << Nf;
-
-      bool ok = (Zf <= Z && Nf <= N);
-      if(!ok) {
-         LOG("gevscan", pERROR) 
-           << " ** Number of final state nucleons inconsistent with target in event: " << i 
-           << "\n"
-           << event;
-         if(gErrLog.is_open()) {
-             gErrLog << i << endl;    
-             if(gOptAddEventPrintoutInErrLog) {
-                 gErrLog << event;
-             }
-         }
-         nerr++;
-      }
-    } //nucltgt
+    if (!nucltgt) return true;
 
-    gMCRec->Clear(); // clear out explicitly to prevent memory leak w/Root6
+    GHepParticle * p = 0;
 
-  }//i
+    int Z = 0;
+    int N = 0;
 
+    // get number of spectator nucleons 
+    int fd = nucltgt->FirstDaughter();
+    int ld = nucltgt->LastDaughter();
+    for(int d = fd; d <= ld; d++) {
+      p = event.Particle(d);
+      if(!p) continue;
+      int pdgc = p->Pdg();
+      if(pdg::IsIon(pdgc)) {
+        Z = p->Z();
+        N = p->A() - p->Z();
+      }
+    }
+    // add nucleons from the primary interaction
+    TIter event_iter(&event);
+    while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
+      GHepStatus_t ist = p->Status();
+      if(ist != kIStHadronInTheNucleus) continue;
+      int pdgc = p->Pdg();
+      if(pdg::IsProton (pdgc)) { Z++; }
+      if(pdg::IsNeutron(pdgc)) { N++; }
+    }//p
 
-  if(gErrLog.is_open()) {
-     if(nerr == 0) {
-         gErrLog << "none" << endl;    
-     }
-  }
+    // count final state nucleons
+    int Zf = 0;
+    int Nf = 0;
+    event_iter.Reset();
+    while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
+      GHepStatus_t ist = p->Status();
+      if(ist != kIStStableFinalState) continue;
+      int pdgc = p->Pdg();
+      if(pdg::IsProton (pdgc)) { Zf++; }
+      if(pdg::IsNeutron(pdgc)) { Nf++; }
+    }
 
-  LOG("gevscan", pNOTICE) 
-     << "Found " << nerr 
-     << " events with a number of final state nucleons inconsistent with target";
-}
+    return (Zf <= Z && Nf <= N);
+  }
+};
 //____________________________________________________________________________
-void CheckVertexDistribution(void)
+class CheckVertexDistribution : public EvScanCheck
 {
-  LOG("gevscan", pNOTICE) 
-     << "Checking intra-nuclear vertex distribution...";
-
-  if(gErrLog.is_open()) {
-    gErrLog << "# Intranuclear vertex distribution check:" << endl;
-    gErrLog << "# " << endl;
-  }
+// The vertex radius distribution is histogrammed separately for each nuclear
+// target (this test is run on a MC sample for a given target) and the target
+// seen first in the scanned event range is tested in the end
 
-  TH1D * r_distr_mc       = new TH1D("r_distr_mc","",      150,0,30); //fm
-  TH1D * r_distr_expected = new TH1D("r_distr_expected","",150,0,30); //fm
+public:
+  CheckVertexDistribution() : fFirstTarget(-1), fRAxis(150,0,30) /*fm*/ { }
+  EvScanCheck * Clone(void) const { return new CheckVertexDistribution; }
 
-  int Z = -1;
-  int A = -1;
-
-  // get vertex position distribution
-  for(Long64_t i = gFirstEventNum; i <= gLastEventNum; i++) 
+  void Visit(Long64_t /*iev*/, const EventRecord & event)
   {
-    gEventTree->GetEntry(i);
+    // get target nucleus
+    GHepParticle * nucltgt = event.TargetNucleus();
+    if (!nucltgt) return;
 
-    NtpMCRecHeader rec_header = gMCRec->hdr;
-    EventRecord &  event      = *(gMCRec->event);
+    int target = 1000*nucltgt->Z() + nucltgt->A();
+    if(fFirstTarget == -1) fFirstTarget = target;
 
-    LOG("gevscan", pINFO) << "Checking event.... " << i;
+    GHepParticle * probe = event.Particle(0);
+    double r = probe->X4()->Vect().Mag();
 
-    // get target nucleus
-    GHepParticle * nucltgt = event.TargetNucleus();
-    if (!nucltgt) {
-      LOG("gevscan", pINFO)
-           << "Event not in nuclear target - Skipping...";
+    vector<double> & nvtx = fNVtx[target];
+    if(nvtx.size() == 0) nvtx.resize(fRAxis.GetNbins()+2, 0.);
+    nvtx[fRAxis.FindFixBin(r)]++;
+  }
+
+  void Merge(const EvScanCheck & chunk)
+  {
+    const CheckVertexDistribution & other =
+       dynamic_cast<const CheckVertexDistribution &>(chunk);
+    if(fFirstTarget == -1) fFirstTarget = other.fFirstTarget;
+    map<int, vector<double> >::const_iterator it = other.fNVtx.begin();
+    for( ; it != other.fNVtx.end(); ++it) {
+      vector<double> & nvtx = fNVtx[it->first];
+      if(nvtx.size() == 0) nvtx.resize(it->second.size(), 0.);
+      for(unsigned int i = 0; i < nvtx.size(); i++) nvtx[i] += it->second[i];
     }
-    else {
-      if(Z == -1 && A == -1) {
-         Z = nucltgt->Z();
-         A = nucltgt->A();
-      }
+  }
 
-      // this test is run on a MC sample for a given target
-      if(Z != nucltgt->Z() || A != nucltgt->A()) {
-        LOG("gevscan", pINFO)
-             << "Event not in nuclear target seen first - Skipping...";
-      }
-      else {
-        GHepParticle * probe = event.Particle(0);
-        double r = probe->X4()->Vect().Mag();
+  void Report(void)
+  {
+    LOG("gevscan", pNOTICE) 
+       << "Checking intra-nuclear vertex distribution...";
 
-        r_distr_mc->Fill(r);
-      }
-    } //nucltgt
+    if(gErrLog.is_open()) {
+      gErrLog << "# Intranuclear vertex distribution check:" << endl;
+      gErrLog << "# " << endl;
+    }
 
-    gMCRec->Clear(); // clear out explicitly to prevent memory leak w/Root6
+    int A = (fFirstTarget == -1) ? -1 : fFirstTarget % 1000;
 
-  }//i
+    if(A > 1) {
+      TH1D * r_distr_mc       = new TH1D("r_distr_mc","",      150,0,30); //fm
+      TH1D * r_distr_expected = new TH1D("r_distr_expected","",150,0,30); //fm
 
-  if(A > 1) {
-    // get expected vertex position distribution
-    for(int ir = 1; ir <= r_distr_expected->GetNbinsX(); ir++) {
-      double r = r_distr_expected->GetBinCenter(ir);
-      double rho  = utils::nuclear::Density(r,A);
-      double nexp = 4*kPi*r*r*rho;
-      r_distr_expected->SetBinContent(ir,nexp);
-    }
+      // get vertex position distribution
+      const vector<double> & nvtx = fNVtx[fFirstTarget];
+      double nentries = 0;
+      for(unsigned int ir = 0; ir < nvtx.size(); ir++) {
+        r_distr_mc->SetBinContent(ir, nvtx[ir]);
+        nentries += nvtx[ir];
+      }
+      r_distr_mc->SetEntries(nentries);
+
+      // get expected vertex position distribution
+      for(int ir = 1; ir <= r_distr_expected->GetNbinsX(); ir++) {
+        double r = r_distr_expected->GetBinCenter(ir);
+        double rho  = utils::nuclear::Density(r,A);
+        double nexp = 4*kPi*r*r*rho;
+        r_distr_expected->SetBinContent(ir,nexp);
+      }
 
-    // normalize 
-    double N = r_distr_mc->GetEntries();
-    r_distr_expected -> Scale (N / r_distr_expected -> Integral());
+      // normalize 
+      double N = r_distr_mc->GetEntries();
+      r_distr_expected -> Scale (N / r_distr_expected -> Integral());
 
-    // check consistency
-    double pvalue = r_distr_mc->Chi2Test(r_distr_expected,"WWP");
-    LOG("gevscan", pNOTICE) << "p-value {\\chi^2 test} = " << pvalue;
+      // check consistency
+      double pvalue = r_distr_mc->Chi2Test(r_distr_expected,"WWP");
+      LOG("gevscan", pNOTICE) << "p-value {\\chi^2 test} = " << pvalue;
 
-    if(gErrLog.is_open()) {
-       if(pvalue < 0.99) {
-         gErrLog << "Problem! p-value = " << pvalue << endl;    
-       } else {
-         gErrLog << "OK! p-value = " << pvalue << endl;    
-       }
-    }
+      if(gErrLog.is_open()) {
+         if(pvalue < 0.99) {
+           gErrLog << "Problem! p-value = " << pvalue << endl;    
+         } else {
+           gErrLog << "OK! p-value = " << pvalue << endl;    
+         }
+      }
 
 #ifdef __debug__
-    TFile f("./check_vtx.root","recreate");
-    r_distr_mc -> Write();
-    r_distr_expected -> Write();
-    f.Close();
+      TFile f("./check_vtx.root","recreate");
+      r_distr_mc -> Write();
+      r_distr_expected -> Write();
+      f.Close();
 #endif
 
-  }//A
-  else {
+    }//A
+    else {
 
-    if(gErrLog.is_open()) {
-      gErrLog << "Can not run test with current sample" << endl;   
-    }
+      if(gErrLog.is_open()) {
+        gErrLog << "Can not run test with current sample" << endl;   
+      }
 
+    }
   }
 
-}
+private:
+  int                      fFirstTarget; ///< first nuclear target seen (1000*Z+A)
+  TAxis                    fRAxis;       ///< vertex radius binning
+  map<int, vector<double> > fNVtx;       ///< vertex radius distribution per target, incl. under/overflow
+};
 //____________________________________________________________________________
-void CheckDecayerConsistency(void)
+class CheckDecayerConsistency : public EvScanCheck
 {
 // Check that particles seen in the final state in some events do not appear to 
 // have decayed in other events.
@@ -716,79 +556,91 @@ void CheckDecayerConsistency(void)
 // PYTHIA hadronization. It might also happen if the decayed particle status is
 // used incorrectly in some modules (eg intranuke).
 //
-  LOG("gevscan", pNOTICE) 
-     << "Checking decayer consistency...";
+public:
+  CheckDecayerConsistency() : 
+    fFinalStateParticles(false), fDecayedParticles(false) { }
+  EvScanCheck * Clone(void) const { return new CheckDecayerConsistency; }
 
-  if(gErrLog.is_open()) {
-    gErrLog << "# Decayer consistency check:" << endl;
-    gErrLog << "# " << endl;
-  }
-
-  bool allowdup = false;
-  PDGCodeList final_state_particles(allowdup);
-  PDGCodeList decayed_particles(allowdup);
-
-  for(Long64_t i = gFirstEventNum; i <= gLastEventNum; i++) 
+  void Visit(Long64_t iev, const EventRecord & event)
   {
-    gEventTree->GetEntry(i);
-
-    NtpMCRecHeader rec_header = gMCRec->hdr;
-    EventRecord &  event      = *(gMCRec->event);
-
-    LOG("gevscan", pINFO) << "Checking event.... " << i;
-
     GHepParticle * p = 0;
     TIter event_iter(&event);
     while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
       GHepStatus_t ist = p->Status();
       int pdgc = p->Pdg();
-      if(ist == kIStStableFinalState) { final_state_particles.push_back(pdgc); }
-      if(ist == kIStDecayedState    ) { decayed_particles.push_back(pdgc);     }
+      if(ist == kIStStableFinalState) { this->AddFinalState(pdgc, iev); }
+      if(ist == kIStDecayedState    ) { this->AddDecayed   (pdgc, iev); }
     }//p
-    gMCRec->Clear(); // clear out explicitly to prevent memory leak w/Root6
-  }//i
-
-  // find particles which appear in both lists
-  PDGCodeList particles_in_both_lists(allowdup);
+  }
 
-  PDGCodeList::const_iterator iter;
-  for(iter = final_state_particles.begin(); 
-      iter != final_state_particles.end(); ++iter) 
+  void Merge(const EvScanCheck & chunk)
   {
-     int pdgc = *iter;
-     if(decayed_particles.ExistsInPDGCodeList(pdgc)) 
-     {
-        particles_in_both_lists.push_back(pdgc);
-     }
+    const CheckDecayerConsistency & other =
+       dynamic_cast<const CheckDecayerConsistency &>(chunk);
+    // particles are added in the order they were first seen in the chunk
+    for(unsigned int i = 0; i < other.fFinalStateParticles.size(); i++) {
+      int pdgc = other.fFinalStateParticles[i];
+      this->AddFinalState(pdgc, other.fFirstFinalStateEvent.find(pdgc)->second);
+    }
+    for(unsigned int i = 0; i < other.fDecayedParticles.size(); i++) {
+      int pdgc = other.fDecayedParticles[i];
+      this->AddDecayed(pdgc, other.fFirstDecayEvent.find(pdgc)->second);
+    }
   }
 
-  bool ok = true;
-  ostringstream mesg;
-  if(particles_in_both_lists.size() == 0) {
-    mesg << "OK.\n" << "No particle seen both in the final state and to have decayed.";
-  } else {
-    ok = false;
-    mesg << "Problem!\n" << particles_in_both_lists.size() << " particles seen both final state and to have decayed.";
-  }
+  void Report(void)
+  {
+    LOG("gevscan", pNOTICE) 
+       << "Checking decayer consistency...";
+
+    if(gErrLog.is_open()) {
+      gErrLog << "# Decayer consistency check:" << endl;
+      gErrLog << "# " << endl;
+    }
+
+    bool allowdup = false;
+
+    // find particles which appear in both lists
+    PDGCodeList particles_in_both_lists(allowdup);
+
+    PDGCodeList::const_iterator iter;
+    for(iter = fFinalStateParticles.begin(); 
+        iter != fFinalStateParticles.end(); ++iter) 
+    {
+       int pdgc = *iter;
+       if(fDecayedParticles.ExistsInPDGCodeList(pdgc)) 
+       {
+          particles_in_both_lists.push_back(pdgc);
+       }
+    }
+
+    bool ok = true;
+    ostringstream mesg;
+    if(particles_in_both_lists.size() == 0) {
+      mesg << "OK.\n" << "No particle seen both in the final state and to have decayed.";
+    } else {
+      ok = false;
+      mesg << "Problem!\n" << particles_in_both_lists.size() << " particles seen both final state and to have decayed.";
+    }
  
-  LOG("gevscan", pNOTICE) 
-    << mesg.str();
-  LOG("gevscan", pNOTICE) 
-    << "Particles seen in final state: " << final_state_particles;
-  LOG("gevscan", pNOTICE) 
-    << "Particles seen to have decayed: " << decayed_particles;
-  LOG("gevscan", pNOTICE) 
-    << "Particles seen in both lists: " << particles_in_both_lists;
-
-  if(gErrLog.is_open()) {
-     gErrLog << mesg.str() << endl;
-     gErrLog << "\nParticles seen in final state:" << final_state_particles << endl;
-     gErrLog << "\nParticles seen to have decayed:" << decayed_particles << endl;
-     gErrLog << "\nParticles seen in both lists:" << particles_in_both_lists << endl;
-   }
-
-   // find example events
-   if(!ok) {
+    LOG("gevscan", pNOTICE) 
+      << mesg.str();
+    LOG("gevscan", pNOTICE) 
+      << "Particles seen in final state: " << fFinalStateParticles;
+    LOG("gevscan", pNOTICE) 
+      << "Particles seen to have decayed: " << fDecayedParticles;
+    LOG("gevscan", pNOTICE) 
+      << "Particles seen in both lists: " << particles_in_both_lists;
+
+    if(gErrLog.is_open()) {
+       gErrLog << mesg.str() << endl;
+       gErrLog << "\nParticles seen in final state:" << fFinalStateParticles << endl;
+       gErrLog << "\nParticles seen to have decayed:" << fDecayedParticles << endl;
+       gErrLog << "\nParticles seen in both lists:" << particles_in_both_lists << endl;
+    }
+
+    // example events: first events where the particle was seen
+    if(!ok) {
       if(gErrLog.is_open()) {
          gErrLog << "\nExample events: " << endl;          
       }
@@ -796,27 +648,8 @@ void CheckDecayerConsistency(void)
           iter != particles_in_both_lists.end(); ++iter) 
       {
          int pdgc_bothlists = *iter;
-         int iev_decay = -1;
-         int iev_fs    = -1;
-         bool have_example = false;
-         for(Long64_t i = gFirstEventNum; i <= gLastEventNum; i++) 
-         {
-           have_example = (iev_decay != -1 && iev_fs != -1);
-           if(have_example) break;
-
-           gEventTree->GetEntry(i);
-           EventRecord &  event = *(gMCRec->event);
-           GHepParticle * p = 0;
-           TIter event_iter(&event);
-           while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
-              int pdgc = p->Pdg();
-              if(pdgc != pdgc_bothlists) continue;
-              GHepStatus_t ist = p->Status();
-              if(ist == kIStStableFinalState && iev_fs    == -1) { iev_fs    = i; }
-              if(ist == kIStDecayedState     && iev_decay == -1) { iev_decay = i; }
-           }//p
-           gMCRec->Clear(); // clear out explicitly to prevent memory leak w/Root6
-         }//i
+         Long64_t iev_decay = fFirstDecayEvent     [pdgc_bothlists];
+         Long64_t iev_fs    = fFirstFinalStateEvent[pdgc_bothlists];
          if(gErrLog.is_open()) {
             gErrLog << ">> " << PDGLibrary::Instance()->Find(pdgc_bothlists)->GetName()
                     << ": Decayed in event " << iev_decay 
@@ -826,15 +659,202 @@ void CheckDecayerConsistency(void)
                EventRecord & event_dec = *(gMCRec->event);
                gErrLog << "Event " << iev_decay << ":";
                gErrLog << event_dec;
+               gMCRec->Clear();
                gEventTree->GetEntry(iev_fs);
                EventRecord & event_fs = *(gMCRec->event);
                gErrLog << "Event: " << iev_fs << ":";
                gErrLog << event_fs;
+               gMCRec->Clear();
             }
          }
       }//pdgc
-   }//!ok
+    }//!ok
+  }
+
+private:
+  void AddFinalState(int pdgc, Long64_t iev)
+  {
+    if(fFirstFinalStateEvent.count(pdgc)) return;
+    fFinalStateParticles.push_back(pdgc);
+    fFirstFinalStateEvent[pdgc] = iev;
+  }
+  void AddDecayed(int pdgc, Long64_t iev)
+  {
+    if(fFirstDecayEvent.count(pdgc)) return;
+    fDecayedParticles.push_back(pdgc);
+    fFirstDecayEvent[pdgc] = iev;
+  }
+
+  PDGCodeList          fFinalStateParticles;  ///< particles seen in final state
+  PDGCodeList          fDecayedParticles;     ///< particles seen to have decayed
+  map<int, Long64_t>   fFirstFinalStateEvent; ///< first event with the particle in final state
+  map<int, Long64_t>   fFirstDecayEvent;      ///< first event with the particle decayed
+};
+//____________________________________________________________________________
+int main(int argc, char ** argv)
+{
+  GetCommandLineArgs (argc, argv);
 
+  // Set GHEP print level
+  GHepRecord::SetPrintLevel(RunOpt::Instance()->EventRecordPrintLevel());
+
+  TFile file(gOptInpFilename.c_str(),"READ");
+
+  NtpMCTreeHeader * thdr = dynamic_cast <NtpMCTreeHeader *> ( file.Get("header") );
+  LOG("gevscan", pINFO) << "Input tree header: " << *thdr;
+  NtpMCFormat_t format = thdr->format;
+  if(format != kNFGHEP) {
+      LOG("gevscan", pERROR) 
+        << "*** Unsupported event-tree format : "
+        << NtpMCFormat::AsString(format);
+      file.Close();
+      return 3;
+  }
+
+  gEventTree = dynamic_cast <TTree *> (file.Get("gtree"));
+  gEventTree->SetBranchAddress("gmcrec", &gMCRec);
+
+  Long64_t nev = gEventTree->GetEntries();
+  if(gOptNEvtL == -1 && gOptNEvtH == -1) {
+    // read all events
+    gFirstEventNum = 0;
+    gLastEventNum  = nev-1;
+  }
+  else {
+    // read a range of events
+    gFirstEventNum = TMath::Max((Long64_t)0,  gOptNEvtL);
+    gLastEventNum = TMath::Min(nev-1,        gOptNEvtH);
+    if(gLastEventNum - gFirstEventNum < 0) {
+      LOG("gevdump", pFATAL) << "Invalid event range";
+      PrintSyntax();
+      gAbortingInErr = true;
+      exit(1);
+    }
+  }
+
+  
+  if(gOptOutFilename.size() == 0) {
+     ostringstream logfile;
+     logfile << gOptInpFilename << ".errlog";
+     gOptOutFilename = logfile.str();
+  }
+  if(gOptOutFilename != "none") {
+     gErrLog.open(gOptOutFilename.c_str());
+     gErrLog << "# ..................................................................................." << endl;
+     gErrLog << "# Error log for event file " << gOptInpFilename << endl;
+     gErrLog << "# ..................................................................................." << endl;
+     gErrLog << "# " << endl;
+  }
+
+  // enabled checks, in report order
+  vector<EvScanCheck *> checks;
+  if (gOptCheckEnergyMomentumConservation) {
+     checks.push_back(new CheckEnergyMomentumConservation);
+  }
+  if (gOptCheckChargeConservation) {
+     checks.push_back(new CheckChargeConservation);
+  }
+  if (gOptCheckForPseudoParticlesInFinState) {
+     checks.push_back(new CheckForPseudoParticlesInFinState);
+  }
+  if (gOptCheckForOffMassShellParticlesInFinState) {
+     checks.push_back(new CheckForOffMassShellParticlesInFinState);
+  }
+  if (gOptCheckForNumFinStateNucleonsInconsistentWithTarget) {
+     checks.push_back(new CheckForNumFinStateNucleonsInconsistentWithTarget);
+  }
+  if (gOptCheckVertexDistribution) {
+     checks.push_back(new CheckVertexDistribution);
+  }
+  if (gOptCheckDecayerConsistency) {
+     checks.push_back(new CheckDecayerConsistency);
+  }
+
+  if(checks.size() > 0) {
+     ScanEvents(checks);
+  }
+
+  for(unsigned int k = 0; k < checks.size(); k++) {
+     checks[k]->Report();
+     delete checks[k];
+  }
+
+  if(gOptOutFilename != "none") {
+     gErrLog.close();
+  }
+
+  return 0;
+}
+//____________________________________________________________________________
+void ScanEvents(const vector<EvScanCheck *> & checks)
+{
+// Runs all checks over the selected event range in a single pass.
+// The range is split in chunks, each read by a worker thread through its own
+// TFile (ROOT I/O objects can not be shared between threads). Chunks are
+// handed out dynamically but their results are merged in event order.
+
+  Long64_t nev      = gLastEventNum - gFirstEventNum + 1;
+  int      nthreads = TMath::Max(1, gOptNThreads);
+  int      nchunks  = (int) TMath::Min(nev, (Long64_t) 8*nthreads);
+
+  LOG("gevscan", pNOTICE)
+     << "Running " << checks.size() << " checks over events "
+     << gFirstEventNum << " - " << gLastEventNum
+     << " using " << nthreads << " thread(s)";
+
+  vector< vector<EvScanCheck *> > chunk_checks(nchunks);
+  std::atomic<int> next_chunk(0);
+
+  auto worker = [&]() {
+    TFile file(gOptInpFilename.c_str(),"READ");
+    TTree * tree = dynamic_cast <TTree *> (file.Get("gtree"));
+    NtpMCEventRecord * mcrec = 0;
+    tree->SetBranchAddress("gmcrec", &mcrec);
+
+    int ichunk = 0;
+    while( (ichunk = next_chunk++) < nchunks ) {
+      Long64_t first = gFirstEventNum + (nev *  ichunk   ) / nchunks;
+      Long64_t last  = gFirstEventNum + (nev * (ichunk+1)) / nchunks - 1;
+
+      vector<EvScanCheck *> & cc = chunk_checks[ichunk];
+      for(unsigned int k = 0; k < checks.size(); k++) {
+        cc.push_back(checks[k]->Clone());
+      }
+      for(Long64_t i = first; i <= last; i++) {
+        tree->GetEntry(i);
+        const EventRecord & event = *(mcrec->event);
+        for(unsigned int k = 0; k < cc.size(); k++) {
+          cc[k]->Visit(i, event);
+        }
+        mcrec->Clear(); // clear out explicitly to prevent memory leak w/Root6
+      }
+    }
+    file.Close();
+    delete mcrec; // allocated by the tree on the first GetEntry()
+  };
+
+  if(nthreads == 1) {
+    worker();
+  } else {
+    // make sure that the shared (read-only) state is initialized upfront
+    ROOT::EnableThreadSafety();
+    PDGLibrary::Instance();
+
+    vector<std::thread> threads;
+    for(int ithr = 0; ithr < nthreads; ithr++) {
+      threads.push_back(std::thread(worker));
+    }
+    for(unsigned int ithr = 0; ithr < threads.size(); ithr++) {
+      threads[ithr].join();
+    }
+  }
+
+  for(int ichunk = 0; ichunk < nchunks; ichunk++) {
+    for(unsigned int k = 0; k < checks.size(); k++) {
+      checks[k]->Merge(*chunk_checks[ichunk][k]);
+      delete chunk_checks[ichunk][k];
+    }
+  }
 }
 //____________________________________________________________________________
 void GetCommandLineArgs(int argc, char ** argv)
@@ -889,6 +909,11 @@ void GetCommandLineArgs(int argc, char ** argv)
     gOptNEvtH = -1;
   }
 
+  // number of threads
+  if( parser.OptionExists('j') ) {
+    gOptNThreads = TMath::Max(1, parser.ArgAsInt('j'));
+  }
+
   gOptAddEventPrintoutInErrLog =
      parser.OptionExists("add-event-printout-in-error-log");
 
@@ -920,7 +945,7 @@ void PrintSyntax(void)
 {
   LOG("gevscan", pNOTICE)
     << "\n\n" << "Syntax:" << "\n"
-    << " gevscan -f sample.root [-n n1[,n2]] [-o errlog] [check names]\n";
+    << " gevscan -f sample.root [-n n1[,n2]] [-j nthreads] [-o errlog] [check names]\n";
 }
 //_________________________________________________________________________________
 bool CheckRootFilename(string filename)
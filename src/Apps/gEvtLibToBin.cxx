@@ -0,0 +1,125 @@
+//____________________________________________________________________________
+/*!
+
+\program gevtlib2bin
+
+\brief   Converts a ROOT event library (see genie::evtlib::EventLibraryInterface)
+         into the columnar binary format that the EventLibraryInterface can
+         memory-map.
+
+         In the binary format the records of each library are sorted by
+         energy, with their particles stored in a columnar particle pool.
+         The file is mapped read-only, so the EventLibraryInterface starts
+         without reading or allocating the records, all jobs running on the
+         same node share a single copy, and each record look-up is a binary
+         search on a contiguous energy array. Binary libraries can be used
+         anywhere a ROOT library is accepted (EventLibraryPath); the format
+         is detected from the file contents.
+
+         Syntax :
+           gevtlib2bin -f input.root -o output.bin
+                       [--message-thresholds xml_file]
+
+         Options :
+           -f
+              input ROOT event library
+           -o
+              output binary event library
+           --message-thresholds
+              Allows users to customize the message stream thresholds.
+              The thresholds are specified using an XML file.
+              See $GENIE/config/Messenger.xml for the XML schema.
+
+         Examples :
+
+           shell% gevtlib2bin -f evtlib.root -o evtlib.bin
+
+\author  GENIE Collaboration
+
+\created October 16, 2026
+
+\cpright Copyright (c) 2003-2023, The GENIE Collaboration
+         For the full text of the license visit http://copyright.genie-mc.org
+
+*/
+//____________________________________________________________________________
+
+#include <cstdlib>
+#include <string>
+
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Utils/RunOpt.h"
+#include "Framework/Utils/AppInit.h"
+#include "Framework/Utils/CmdLnArgParser.h"
+#include "Tools/EvtLib/MappedLibrary.h"
+#include "Tools/EvtLib/Utils.h"
+
+using std::string;
+
+using namespace genie;
+
+void GetCommandLineArgs (int argc, char ** argv);
+void PrintSyntax        (void);
+
+//User-specified options:
+string gInpFile;  ///< input ROOT event library
+string gOutFile;  ///< output binary event library
+
+//____________________________________________________________________________
+int main(int argc, char ** argv)
+{
+  GetCommandLineArgs(argc,argv);
+
+  utils::app_init::MesgThresholds(RunOpt::Instance()->MesgThresholdFiles());
+
+  evtlib::Expand(gInpFile);
+
+  LOG("gevtlib2bin", pNOTICE)
+     << " ****** Converting event library : " << gInpFile << " to : " << gOutFile;
+  bool ok = evtlib::MappedLibrary::Convert(gInpFile, gOutFile);
+  if(!ok) {
+    LOG("gevtlib2bin", pFATAL) << "Could not convert: " << gInpFile;
+    exit(1);
+  }
+
+  return 0;
+}
+//____________________________________________________________________________
+void GetCommandLineArgs(int argc, char ** argv)
+{
+  LOG("gevtlib2bin", pNOTICE) << "Parsing command line arguments";
+
+  // Common run options.
+  RunOpt::Instance()->ReadFromCommandLine(argc,argv);
+
+  // Parse run options for this app
+
+  CmdLnArgParser parser(argc,argv);
+
+  if( parser.OptionExists('f') ) {
+    LOG("gevtlib2bin", pINFO) << "Reading input file name";
+    gInpFile = parser.ArgAsString('f');
+  } else {
+    LOG("gevtlib2bin", pFATAL) << "You must specify an input file";
+    PrintSyntax();
+    exit(1);
+  }
+
+  if( parser.OptionExists('o') ) {
+    LOG("gevtlib2bin", pINFO) << "Reading output file name";
+    gOutFile = parser.ArgAsString('o');
+  } else {
+    LOG("gevtlib2bin", pFATAL) << "You must specify an output file name";
+    PrintSyntax();
+    exit(1);
+  }
+}
+//____________________________________________________________________________
+void PrintSyntax(void)
+{
+  LOG("gevtlib2bin", pNOTICE)
+    << "\n\n" << "Syntax:" << "\n"
+    << "   gevtlib2bin -f input.root -o output.bin\n"
+    << "               [--message-thresholds xml_file]\n";
+}
+//____________________________________________________________________________
@@ -6,6 +6,7 @@
          Syntax :
            gmksf [-h]
                   --tune genie_tune
+                 [--jobs number_of_processes]
                  [--message-thresholds xml_file]
          Note :
            [] marks optional arguments.
@@ -14,6 +15,10 @@
          Options :
            --tune
               Specifies a GENIE comprehensive neutrino interaction model tune.
+           --jobs
+              Number of processes among which the (x,Q2) grid points of each
+              table are computed. Overrides the HEDIS_SF_NJOBS environment
+              variable. Default: 1
            --message-thresholds
               Allows users to customize the message stream thresholds.
               The thresholds are specified using an XML file.
@@ -37,6 +42,9 @@
 #include "Framework/Interaction/Interaction.h"
 #include "Framework/Interaction/InitialState.h"
 #include "Framework/Messenger/Messenger.h"
+#include "Framework/Utils/CmdLnArgParser.h"
+
+#include <TSystem.h>
 
 using namespace genie;
 
@@ -54,6 +62,17 @@ int main(int argc, char ** argv)
   }
   RunOpt::Instance()->BuildTune();
 
+  // Number of processes used by HEDISStrucFunc to compute the tables
+  CmdLnArgParser parser(argc,argv);
+  if ( parser.OptionExists("jobs") ) {
+    int njobs = parser.ArgAsInt("jobs");
+    if ( njobs<1 ) {
+      LOG("gmkhedissf", pFATAL) << "Invalid number of jobs: " << njobs;
+      exit(-1);
+    }
+    gSystem->Setenv("HEDIS_SF_NJOBS", std::to_string(njobs).c_str());
+  }
+
   utils::app_init::MesgThresholds(RunOpt::Instance()->MesgThresholdFiles());
 
   GEVGDriver evg_driver;
@@ -75,6 +94,7 @@ void PrintSyntax(void)
     << "\n\n" << "Syntax:" << "\n"
     << "\n      gmkhedissf [-h]"
     << "\n                  --tune genie_tune"
+    << "\n                 [--jobs number_of_processes]"
     << "\n                  --message-thresholds xml_file"
     << "\n";
 }
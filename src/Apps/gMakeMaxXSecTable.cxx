@@ -0,0 +1,269 @@
+//____________________________________________________________________________
+/*!
+
+\program gmkmaxxsec
+
+\brief   GENIE utility program precomputing the maximum differential cross
+         sections used by the kinematic generators in the rejection method,
+         for all interactions of the input initial states, and saving them
+         in a compact binary table. Event generation jobs load the table
+         (see --max-xsec-table, or $GMAXXSECTABLE) and start with warm max
+         xsec caches instead of scanning the kinematic phase space for each
+         channel. The table is memory mapped, so jobs running on the same
+         node share a single copy.
+
+         Syntax :
+
+           gmkmaxxsec -p nupdg -t tgtpdg
+                     [-o output_file]
+                     [-n nknots]
+                     [-e min_energy,max_energy]
+                     [--seed seed_number]
+                     [--cross-sections xml_file]
+
+                     // command line args handled by RunOpt:
+                     [--event-generator-list list_name]
+                     [--tune tune_name]
+                     [--xml-path path]
+                     [--message-thresholds xml_file]
+
+         Options :
+           -p
+               A comma separated list of probe PDG codes.
+           -t
+               A comma separated list of target PDG codes (format: 10LZZZAAAI).
+           -o
+               Name of the output table. Default: `max_xsec_table.bin'.
+           -n
+               Number of energy points (log-spaced) per interaction, at
+               least 41 (entries with fewer points are not interpolated).
+               Default: 100.
+           -e
+               Probe energy range (GeV). Default: 0.1 GeV to the max energy
+               in the validity range of the event generators.
+           --seed
+               Random number seed.
+           --cross-sections
+               Name of an XML file with pre-computed cross-section splines
+               (speeds-up the driver initialization).
+
+         The table is only valid for the tune and configuration it was built
+         with: entries computed with a different kinematic generator or cross
+         section model configuration are ignored at run time. Interactions
+         whose max xsec depends on the event-time state (eg on a nucleon bound
+         in a nucleus) are not tabulated and stay lazily cached.
+
+\author  GENIE Collaboration
+
+\created October 16, 2026
+
+\cpright Copyright (c) 2003-2023, The GENIE Collaboration
+         For the full text of the license visit http://copyright.genie-mc.org
+
+*/
+//____________________________________________________________________________
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <TMath.h>
+
+#include "Framework/EventGen/EventGenerator.h"
+#include "Framework/EventGen/GEVGDriver.h"
+#include "Framework/EventGen/InteractionList.h"
+#include "Framework/EventGen/XSecAlgorithmI.h"
+#include "Framework/Interaction/Interaction.h"
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/ParticleData/PDGCodeList.h"
+#include "Framework/Utils/AppInit.h"
+#include "Framework/Utils/CmdLnArgParser.h"
+#include "Framework/Utils/MaxXSecTable.h"
+#include "Framework/Utils/PrintUtils.h"
+#include "Framework/Utils/RunOpt.h"
+#include "Framework/Utils/StringUtils.h"
+#include "Physics/Common/KineGeneratorWithCache.h"
+
+using std::string;
+using std::vector;
+
+using namespace genie;
+
+// Prototypes:
+void GetCommandLineArgs (int argc, char ** argv);
+void PrintSyntax        (void);
+
+// User-specified options:
+string   gOptProbePdgCodeList = "";
+string   gOptTgtPdgCodeList   = "";
+string   gOptOutFile          = "max_xsec_table.bin";
+int      gOptNPoints          = 100;
+double   gOptEmin             = 0.1;
+double   gOptEmax             = -1;
+long int gOptRanSeed          = -1;
+string   gOptInpXSecFile      = "";
+
+//____________________________________________________________________________
+int main(int argc, char ** argv)
+{
+  GetCommandLineArgs(argc,argv);
+
+  if ( ! RunOpt::Instance()->Tune() ) {
+    LOG("gmkmaxxsec", pFATAL) << " No TuneId in RunOption";
+    exit(-1);
+  }
+  RunOpt::Instance()->BuildTune();
+
+  utils::app_init::MesgThresholds(RunOpt::Instance()->MesgThresholdFiles());
+  utils::app_init::RandGen(gOptRanSeed);
+  utils::app_init::XSecTable(gOptInpXSecFile, false);
+
+  PDGCodeList probes (false);
+  PDGCodeList targets(false);
+  vector<string> vp = utils::str::Split(gOptProbePdgCodeList, ",");
+  vector<string> vt = utils::str::Split(gOptTgtPdgCodeList,   ",");
+  for(unsigned int i = 0; i < vp.size(); i++) probes .push_back(atoi(vp[i].c_str()));
+  for(unsigned int i = 0; i < vt.size(); i++) targets.push_back(atoi(vt[i].c_str()));
+
+  MaxXSecTable * table = MaxXSecTable::Instance();
+
+  int nentries = 0;
+  for(unsigned int ip = 0; ip < probes.size(); ip++) {
+    for(unsigned int it = 0; it < targets.size(); it++) {
+
+      InitialState init_state(targets[it], probes[ip]);
+      GEVGDriver driver;
+      driver.SetEventGeneratorList(RunOpt::Instance()->EventGeneratorList());
+      driver.Configure(init_state);
+
+      double Emax = driver.ValidEnergyRange().max;
+      if(gOptEmax > 0) Emax = TMath::Min(Emax, gOptEmax);
+      double Emin = gOptEmin;
+      if(Emax <= Emin) {
+        LOG("gmkmaxxsec", pWARN)
+          << "Empty energy range for " << init_state.AsString() << " - Skipping";
+        continue;
+      }
+      vector<double> Ev(gOptNPoints);
+      double dlogE = (TMath::Log10(Emax) - TMath::Log10(Emin)) / TMath::Max(1, gOptNPoints-1);
+      for(int i = 0; i < gOptNPoints; i++) {
+        Ev[i] = TMath::Power(10., TMath::Log10(Emin) + i * dlogE);
+      }
+
+      const InteractionList * ilst = driver.Interactions();
+      InteractionList::const_iterator intliter = ilst->begin();
+      for( ; intliter != ilst->end(); ++intliter) {
+        const Interaction * interaction = *intliter;
+        const EventGenerator * evg =
+           dynamic_cast<const EventGenerator *> (driver.FindGenerator(interaction));
+        if(!evg || !evg->Modules()) continue;
+
+        const vector<const EventRecordVisitorI *> & modules = *evg->Modules();
+        for(unsigned int im = 0; im < modules.size(); im++) {
+          const KineGeneratorWithCache * kine =
+             dynamic_cast<const KineGeneratorWithCache *> (modules[im]);
+          if(!kine) continue;
+          if(kine->AddToMaxXSecTable(evg->CrossSectionAlg(), interaction, Ev, table)) {
+            nentries++;
+          }
+        }
+      }
+    }
+  }
+
+  LOG("gmkmaxxsec", pNOTICE)
+    << "Computed max xsec values for " << nentries << " (generator, interaction) pairs";
+
+  if(!table->Save(gOptOutFile, RunOpt::Instance()->Tune()->Name())) {
+    LOG("gmkmaxxsec", pFATAL) << "Could not save the max xsec table";
+    exit(1);
+  }
+
+  return 0;
+}
+//____________________________________________________________________________
+void GetCommandLineArgs(int argc, char ** argv)
+{
+  RunOpt::Instance()->ReadFromCommandLine(argc,argv);
+
+  CmdLnArgParser parser(argc,argv);
+
+  if( parser.OptionExists('p') ) {
+    gOptProbePdgCodeList = parser.ArgAsString('p');
+  } else {
+    LOG("gmkmaxxsec", pFATAL) << "Unspecified probe PDG code list - Exiting";
+    PrintSyntax();
+    exit(1);
+  }
+
+  if( parser.OptionExists('t') ) {
+    gOptTgtPdgCodeList = parser.ArgAsString('t');
+  } else {
+    LOG("gmkmaxxsec", pFATAL) << "Unspecified target PDG code list - Exiting";
+    PrintSyntax();
+    exit(1);
+  }
+
+  if( parser.OptionExists('o') ) {
+    gOptOutFile = parser.ArgAsString('o');
+  }
+
+  if( parser.OptionExists('n') ) {
+    gOptNPoints = parser.ArgAsInt('n');
+    if(gOptNPoints < MaxXSecTable::kNMinInterpolation) {
+      LOG("gmkmaxxsec", pFATAL)
+        << "Need at least " << MaxXSecTable::kNMinInterpolation
+        << " energy points - Exiting";
+      exit(1);
+    }
+  }
+
+  if( parser.OptionExists('e') ) {
+    vector<double> erange = parser.ArgAsDoubleTokens('e', ",");
+    if(erange.size() != 2 || erange[0] <= 0 || erange[1] <= erange[0]) {
+      LOG("gmkmaxxsec", pFATAL) << "Invalid energy range - Exiting";
+      PrintSyntax();
+      exit(1);
+    }
+    gOptEmin = erange[0];
+    gOptEmax = erange[1];
+  }
+
+  if( parser.OptionExists("seed") ) {
+    gOptRanSeed = parser.ArgAsLong("seed");
+  }
+
+  if( parser.OptionExists("cross-sections") ) {
+    gOptInpXSecFile = parser.ArgAsString("cross-sections");
+  }
+
+  LOG("gmkmaxxsec", pNOTICE)
+     << "\n"
+     << utils::print::PrintFramedMesg("gmkmaxxsec job configuration")
+     << "\n Probe PDG codes : " << gOptProbePdgCodeList
+     << "\n Target PDG codes : " << gOptTgtPdgCodeList
+     << "\n Output table : " << gOptOutFile
+     << "\n Energy points : " << gOptNPoints
+     << "\n Energy range : " << gOptEmin << " - "
+     << ((gOptEmax > 0) ? std::to_string(gOptEmax) : string("validity range max"))
+     << "\n Input cross-section file : " << gOptInpXSecFile
+     << "\n Random number seed : " << gOptRanSeed
+     << "\n";
+
+  LOG("gmkmaxxsec", pNOTICE) << *RunOpt::Instance();
+}
+//____________________________________________________________________________
+void PrintSyntax(void)
+{
+  LOG("gmkmaxxsec", pNOTICE)
+    << "\n\n" << "Syntax:" << "\n"
+    << "   gmkmaxxsec -p probe_pdg -t target_pdg"
+    << "\n    [-o output_file]"
+    << "\n    [-n npoints]"
+    << "\n    [-e min_energy,max_energy]"
+    << "\n    [--seed seed_number]"
+    << "\n    [--cross-sections xml_file]"
+    << RunOpt::RunOptSyntaxString(false)
+    << "\n";
+}
+//____________________________________________________________________________
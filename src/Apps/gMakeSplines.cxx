@@ -16,6 +16,9 @@
                   <-o | --output-cross-sections> xsec_xml_file_name
                   [-n nknots]
                   [-e max_energy]
+                  [--adaptive-knots tolerance]
+                  [--incremental]
+                  [--knot-store directory]
                   [--no-copy]
                   [--seed seed_number]
                   [--input-cross-sections xml_file]
@@ -51,6 +54,28 @@
                Maximum energy in spline.
                Default: The max energy in the validity range of the spline
                generating thread.
+           --adaptive-knots
+               Place the knots adaptively: start from a coarse grid and
+               bisect the energy intervals where the interpolated cross
+               section differs from the computed one by more than the given
+               relative tolerance (eg 0.005). The number of knots (see -n)
+               becomes the maximum number of knots per spline. The estimated
+               error achieved for each spline is reported at the end.
+           --incremental
+               Merge with the splines read via --input-cross-sections at the
+               knot level: the splines needed for the requested initial
+               states keep their knots (and those in the knot store), and
+               only the energies of the requested range & number of knots
+               that they don't cover are computed and added. Splines with
+               nothing to add are kept as they are. Use it to extend the
+               energy range or add knots to an existing spline file.
+           --knot-store
+               Directory of a content-addressed store of computed knots.
+               Every computed point is saved under a hash of the full cross
+               section algorithm configuration and of the interaction, and is
+               reused by any later job building a spline for the same
+               configuration (eg in successive tune iterations, where only
+               the modified models need to be recomputed).
            --no-copy
                Does not write out the input cross-sections in the output file
            --seed
@@ -89,6 +114,7 @@
 #include <cassert>
 #include <cstdlib>
 #include <string>
+#include <sstream>
 #include <vector>
 
 #if defined(HAVE_FENV_H) && defined(HAVE_FEENABLEEXCEPT)
@@ -102,12 +128,14 @@
 #include "Framework/Interaction/Interaction.h"
 #include "Framework/Messenger/Messenger.h"
 #include "Framework/Numerical/RandomGen.h"
+#include "Framework/Numerical/Spline.h"
 #include "Framework/ParticleData/PDGCodeList.h"
 #include "Framework/Utils/RunOpt.h"
 #include "Framework/Utils/AppInit.h"
 #include "Framework/Utils/StringUtils.h"
 //#include "Framework/Utils/SystemUtils.h"
 #include "Framework/Utils/PrintUtils.h"
+#include "Framework/Utils/XSecKnotStore.h"
 #include "Framework/Utils/XSecSplineList.h"
 #include "Framework/Utils/CmdLnArgParser.h"
 
@@ -117,6 +145,7 @@
 
 using std::string;
 using std::vector;
+using std::ostringstream;
 
 using namespace genie;
 
@@ -136,6 +165,9 @@ string   gOptTgtPdgCodeList = "";
 string   gOptGeomFilename   = "";
 int      gOptNKnots         = -1;
 double   gOptMaxE           = -1.;
+double   gOptAdaptiveTol    = -1.;  // adaptive knot tolerance (<=0: off)
+bool     gOptIncremental    = false; // knot-level merge with input splines
+string   gOptKnotStore      = "";   // knot store directory
 bool     gOptNoCopy         = false;
 long int gOptRanSeed        = -1;   // random number seed
 string   gOptInpXSecFile    = "";   // input cross-section file
@@ -163,6 +195,15 @@ int main(int argc, char ** argv)
   utils::app_init::RandGen(gOptRanSeed);
   utils::app_init::XSecTable(gOptInpXSecFile, false);
 
+  XSecSplineList * xspl = XSecSplineList::Instance();
+  if(gOptAdaptiveTol > 0.) {
+    xspl->SetAdaptiveKnots(true, gOptAdaptiveTol);
+  }
+  if(gOptKnotStore.size() > 0) {
+    xspl->SetKnotStore(new XSecKnotStore(gOptKnotStore));
+  }
+  xspl->SetIncremental(gOptIncremental);
+
   // Get list of neutrinos and nuclear targets
 
   PDGCodeList * neutrinos = GetNeutrinoCodes();
@@ -200,8 +241,24 @@ int main(int argc, char ** argv)
     }
   }
 
+  // Report the interpolation error achieved by the adaptive knot placement
+  if(xspl->UseAdaptiveKnots()) {
+    ostringstream report;
+    report << utils::print::PrintFramedMesg("Adaptive knot placement");
+    const vector<string> * keys = xspl->GetSplineKeys();
+    vector<string>::const_iterator kiter = keys->begin();
+    for( ; kiter != keys->end(); ++kiter) {
+      double err = xspl->KnotPlacementError(*kiter);
+      if(err < 0.) continue;
+      const Spline * spl = xspl->GetSpline(*kiter);
+      report << "\n " << *kiter << " : " << spl->NKnots()
+             << " knots, max. rel. error ~ " << err;
+    }
+    delete keys;
+    LOG("gmkspl", pNOTICE) << report.str();
+  }
+
   // Save the splines at the requested XML file
-  XSecSplineList * xspl = XSecSplineList::Instance();
   bool save_init = !gOptNoCopy;
   xspl->SaveAsXml(gOptOutXSecFile, save_init);
 
@@ -259,6 +316,28 @@ void GetCommandLineArgs(int argc, char ** argv)
     gOptMaxE = -1;
   }
 
+  // adaptive knot placement
+  if( parser.OptionExists("adaptive-knots") ) {
+    LOG("gmkspl", pINFO) << "Reading adaptive knot placement tolerance";
+    gOptAdaptiveTol = parser.ArgAsDouble("adaptive-knots");
+  } else {
+    gOptAdaptiveTol = -1;
+  }
+
+  // knot-level merge with the input splines
+  if( parser.OptionExists("incremental") ) {
+    LOG("gmkspl", pINFO) << "Building splines incrementally";
+    gOptIncremental = true;
+  }
+
+  // knot store
+  if( parser.OptionExists("knot-store") ) {
+    LOG("gmkspl", pINFO) << "Reading knot store directory";
+    gOptKnotStore = parser.ArgAsString("knot-store");
+  } else {
+    gOptKnotStore = "";
+  }
+
   // write out input splines?
   if( parser.OptionExists("no-copy") ) {
     LOG("gmkspl", pINFO) << "Not copying input splines to output";
@@ -341,6 +420,9 @@ void GetCommandLineArgs(int argc, char ** argv)
      << "\n Output cross-section file : " << gOptOutXSecFile
      << "\n Input cross-section file : " << gOptInpXSecFile
      << "\n Random number seed : " << gOptRanSeed
+     << "\n Adaptive knot tolerance : " << gOptAdaptiveTol
+     << "\n Incremental : " << gOptIncremental
+     << "\n Knot store : " << gOptKnotStore
      << "\n";
 
   LOG("gmkspl", pNOTICE) << *RunOpt::Instance();
@@ -355,6 +437,9 @@ void PrintSyntax(void)
     << "\n    <-o | --output-cross-sections> xsec_xml_file_name"
     << "\n    [-n nknots]"
     << "\n    [-e max_energy]"
+    << "\n    [--adaptive-knots tolerance]"
+    << "\n    [--incremental]"
+    << "\n    [--knot-store directory]"
     << "\n    [--no-copy]"
     << "\n    [--seed seed_number]"
     << "\n    [--input-cross-sections xml_file]"
@@ -7,7 +7,8 @@
          plain text, XML or bare-ROOT formats.
 
          Syntax:
-           gntpc -i input_file [-o output_file] -f format [-n nev] [-v vrs] [-c] 
+           gntpc -i input_file [-o output_file] -f format[,format,...] [-n nev] [-v vrs] [-c]
+                 [-j nworkers]
                  [--seed random_number_seed]
                  [--message-thresholds xml_file]
                  [--event-record-print-level level]
@@ -25,8 +26,16 @@
               (optional, default: use latest version of each format)
            -c 
               Copy MC job metadata (gconfig and genv TFolders) from the input GHEP file.
+           -j 
+              Number of worker processes (optional, default: 1).
+              The input events are split in contiguous chunks, each converted by a
+              separate worker process into temporary files which are merged, in order,
+              at the end. The output entries are kept in the original event order.
            -f 
               A string that specifies the output file format. 
+              Several comma-separated formats may be given (eg `-f gst,rootracker'),
+              in which case all output files are produced in a single pass over the
+              input event tree.
               >>
 	      >> Generic formats:
               >>
@@ -76,6 +85,8 @@
    		     NUANCE-style tracker text-based format 
            -o  
               Specifies the output filename. 
+              If several output formats were requested, a comma-separated list with
+              one output filename per format should be given.
               If not specified a the default filename is constructed by the 
               input base name and an extension depending on the file format: 
                `gst'                  -> *.gst.root
@@ -118,6 +129,7 @@
 //_____________________________________________________________________________________________
 
 #include <cassert>
+#include <cstdio>
 #include <string>
 #include <sstream>
 #include <fstream>
@@ -125,12 +137,19 @@
 #include <vector>
 #include <algorithm>
 
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include "libxml/parser.h"
 #include "libxml/xmlmemory.h"
 
 #include <TSystem.h>
 #include <TFile.h>
 #include <TTree.h>
+#include <TChain.h>
+#include <TKey.h>
+#include <TClass.h>
 #include <TFolder.h>
 #include <TBits.h>
 #include <TObjString.h>
@@ -173,6 +192,7 @@
 using std::string;
 using std::ostringstream;
 using std::ofstream;
+using std::ifstream;
 using std::endl;
 using std::setw;
 using std::setprecision;
@@ -184,24 +204,6 @@ using std::vector;
 using namespace genie;
 using namespace genie::constants;
 
-//func prototypes
-void   ConvertToGST              (void);
-void   ConvertToGXML             (void);
-void   ConvertToGHepMock         (void);
-void   ConvertToGTracker         (void);
-void   ConvertToGRooTracker      (void);
-void   ConvertToGHad             (void);
-void   ConvertToGINuke           (void);
-void   GetCommandLineArgs        (int argc, char ** argv);
-void   PrintSyntax               (void);
-string DefaultOutputFile         (void);
-int    LatestFormatVersionNumber (void);
-bool   CheckRootFilename         (string filename);
-int    HAProbeFSI                (int, int, int, double [], int [], int, int, int); //Test code
-#ifdef __GENIE_HEAVY_NEUTRAL_LEPTON_ENABLED__
-void   DeclareHNLBranches        (TTree * tree, TTree * intree, 
-				  double * dVars, int * iVars);
-#endif // #ifdef __GENIE_HEAVY_NEUTRAL_LEPTON_ENABLED__
 //format enum
 typedef enum EGNtpcFmt {
   kConvFmt_undef = 0,
@@ -218,20 +220,44 @@ typedef enum EGNtpcFmt {
   kConvFmt_ginuke
 } GNtpcFmt_t;
 
+//func prototypes
+class GNtpcConverter;
+void   ConvertEvents             (Long64_t first, Long64_t last, const vector<string> & filenames);
+void   ConvertInChunks           (Long64_t nev);
+GNtpcConverter * CreateConverter (GNtpcFmt_t fmt, string filename);
+void   MergeChunks               (GNtpcFmt_t fmt, string filename, int nchunks);
+string ChunkFileName             (string filename, int ichunk);
+bool   IsRootFormat              (GNtpcFmt_t fmt);
+void   GetCommandLineArgs        (int argc, char ** argv);
+void   PrintSyntax               (void);
+string DefaultOutputFile         (GNtpcFmt_t fmt);
+int    LatestFormatVersionNumber (GNtpcFmt_t fmt);
+bool   CheckRootFilename         (string filename);
+int    HAProbeFSI                (int, int, int, double [], int [], int, int, int); //Test code
+#ifdef __GENIE_HEAVY_NEUTRAL_LEPTON_ENABLED__
+void   DeclareHNLBranches        (TTree * tree, TTree * intree, 
+				  double * dVars, int * iVars);
+#endif // #ifdef __GENIE_HEAVY_NEUTRAL_LEPTON_ENABLED__
+
 //input options (from command line arguments):
-string     gOptInpFileName;         ///< input file name
-string     gOptOutFileName;         ///< output file name
-GNtpcFmt_t gOptOutFileFormat;       ///< output file format id
-int        gOptVersion;             ///< output file format version
-Long64_t   gOptN;                   ///< number of events to process
-bool       gOptCopyJobMeta = false; ///< copy MC job metadata (gconfig, genv TFolders)
-long int   gOptRanSeed;             ///< random number seed
+string             gOptInpFileName;         ///< input file name
+vector<string>     gOptOutFileNames;        ///< output file names (one per format)
+vector<GNtpcFmt_t> gOptOutFileFormats;      ///< output file format ids
+int                gOptVersion;             ///< output file format version (-1: latest)
+Long64_t           gOptN;                   ///< number of events to process
+bool               gOptCopyJobMeta = false; ///< copy MC job metadata (gconfig, genv TFolders)
+long int           gOptRanSeed;             ///< random number seed
+int                gOptNWorkers = 1;        ///< number of worker processes
 
 //genie version used to generate the input event file 
 int gFileMajorVrs = -1;
 int gFileMinorVrs = -1;
 int gFileRevisVrs = -1;
 
+//chunk of events converted by the current process
+bool gIsFirstChunk = true;  ///< write file headers
+bool gIsLastChunk  = true;  ///< write file trailers
+
 //consts
 const int kNPmax = 250;
 //____________________________________________________________________________________
@@ -245,66 +271,80 @@ int main(int argc, char ** argv)
   GHepRecord::SetPrintLevel(RunOpt::Instance()->EventRecordPrintLevel());
 
   PDGLibrary::Instance()->AddDarkMatter( 1.0, 0.5 ) ;
-  
-  // Call the appropriate conversion function
-  switch(gOptOutFileFormat) {
-
-   case (kConvFmt_gst)  :
-
-	ConvertToGST();        
-	break;  
-
-   case (kConvFmt_gxml) :  
-
-	ConvertToGXML();         
-	break;
-
-   case (kConvFmt_ghep_mock_data) :  
-
-	ConvertToGHepMock();         
-	break;
-
-   case (kConvFmt_rootracker          ) :  
-   case (kConvFmt_rootracker_mock_data) :  
-   case (kConvFmt_t2k_rootracker      ) :  
-   case (kConvFmt_numi_rootracker     ) :  
-
-	ConvertToGRooTracker(); 
-	break;
-
-   case (kConvFmt_t2k_tracker   )  :  
-   case (kConvFmt_nuance_tracker)  :  
 
-	ConvertToGTracker();        
-	break;
-
-   case (kConvFmt_ghad) :  
-
-	ConvertToGHad();         
-	break;
-
-   case (kConvFmt_ginuke) :  
-
-	ConvertToGINuke();         
-	break;
+  // Figure out how many events to convert
+  Long64_t nev = 0;
+  {
+    TFile fin(gOptInpFileName.c_str(),"READ");
+    TTree * gtree = dynamic_cast <TTree *> ( fin.Get("gtree") );
+    if (!gtree) {
+      LOG("gntpc", pFATAL) << "Null input GHEP event tree";
+      gAbortingInErr = true;
+      exit(1);
+    }
+    nev = (gOptN<0) ? 
+       gtree->GetEntries() : TMath::Min( gtree->GetEntries(), gOptN );
+    fin.Close();
+  }
+  LOG("gntpc", pNOTICE) << "*** Analyzing: " << nev << " events";
 
-   default:
-     LOG("gntpc", pFATAL)
-          << "Invalid output format [" << gOptOutFileFormat << "]";
-     PrintSyntax();
-     gAbortingInErr = true;
-     exit(3);
+  // Convert all events in this process or in chunks, in worker processes
+  if(gOptNWorkers > 1 && nev > 1) {
+    ConvertInChunks(nev);
+  } else {
+    ConvertEvents(0, nev-1, gOptOutFileNames);
   }
+
   return 0;
 }
 //____________________________________________________________________________________
+// Converters from the GENIE GHEP event tree to each of the supported formats.
+// All requested converters are fed with the events read in a single pass over
+// the input event tree: Begin() is called after the input file is opened,
+// Convert() for each event and End() before the input file is closed.
+//____________________________________________________________________________________
+class GNtpcConverter
+{
+public:
+  GNtpcConverter(GNtpcFmt_t fmt, string filename, int vrs) :
+    fFormat(fmt), fOutFileName(filename), fVersion(vrs) { }
+  virtual ~GNtpcConverter() { }
+
+  virtual void Begin   (TFile & fin, TTree * gtree, NtpMCTreeHeader * thdr) = 0;
+  virtual void Convert (Long64_t iev, NtpMCEventRecord * mcrec) = 0;
+  virtual void End     (TFile & fin, TTree * gtree) = 0;
+
+protected:
+  GNtpcFmt_t fFormat;       ///< output file format id
+  string     fOutFileName;  ///< output file name
+  int        fVersion;      ///< output file format version
+};
+//____________________________________________________________________________________
+// The flux pass-through branch may be read by several of the requested converters:
+// its address is set once and the flux object is shared by all of them
+//____________________________________________________________________________________
+template<class T> void SetFluxBranchAddress(TTree * tree, T ** flux_info)
+{
+  static T * shared_flux_info = 0;
+  if(!shared_flux_info) {
+    tree->SetBranchAddress("flux", &shared_flux_info);
+  }
+  *flux_info = shared_flux_info;
+}
+//____________________________________________________________________________________
 // GENIE GHEP EVENT TREE FORMAT -> GENIE SUMMARY NTUPLE 
 //____________________________________________________________________________________
-void ConvertToGST(void)
+class GNtpcGSTConverter : public GNtpcConverter
 {
-  // Some constants
-  const double e_h = 1.3; // typical e/h ratio used for computing mean `calorimetric response'
+public:
+  GNtpcGSTConverter(GNtpcFmt_t fmt, string filename, int vrs) :
+    GNtpcConverter(fmt, filename, vrs) { }
+
+  void Begin   (TFile & fin, TTree * gtree, NtpMCTreeHeader * thdr);
+  void Convert (Long64_t iev, NtpMCEventRecord * mcrec);
+  void End     (TFile & fin, TTree * gtree);
 
+private:
   // Define branch variables
   //
   int    brIev         = 0;      // Event number 
@@ -411,14 +451,20 @@ void ConvertToGST(void)
   Double_t  brXSec;              // the event cross section in 1E-38cm^2
   Double_t  brDXSec;             // is the differential cross section for the selected in 1E-38cm^2/{K^n}
   UInt_t    brKPS;               // phase space that the xsec has been evaluated into
-                              
+
+  TFile * fout;                  // output file
+  TTree * s_tree;                // output summary tree
+};
+//____________________________________________________________________________________
+void GNtpcGSTConverter::Begin(TFile & /*fin*/, TTree * /*gtree*/, NtpMCTreeHeader * /*thdr*/)
+{
   // Open output file & create output summary tree & create the tree branches
   //
   LOG("gntpc", pNOTICE) 
-       << "*** Saving summary tree to: " << gOptOutFileName;
-  TFile fout(gOptOutFileName.c_str(),"recreate");
+       << "*** Saving summary tree to: " << fOutFileName;
+  fout = new TFile(fOutFileName.c_str(),"recreate");
 
-  TTree * s_tree = new TTree("gst","GENIE Summary Event Tree");
+  s_tree = new TTree("gst","GENIE Summary Event Tree");
 
   // Create tree branches
   //
@@ -521,232 +567,203 @@ void ConvertToGST(void)
   s_tree->Branch("XSec",         &brXSec,	    "XSec/D"    );
   s_tree->Branch("DXSec",         &brDXSec,	    "DXSec/D"    );
   s_tree->Branch("KPS",          &brKPS,	    "KPS/i"    );
+}
+//____________________________________________________________________________________
+void GNtpcGSTConverter::Convert(Long64_t iev, NtpMCEventRecord * mcrec)
+{
+  // Some constants
+  const double e_h = 1.3; // typical e/h ratio used for computing mean `calorimetric response'
 
-  // Open the ROOT file and get the TTree & its header
-  TFile fin(gOptInpFileName.c_str(),"READ");
-  TTree *           er_tree = 0;
-  NtpMCTreeHeader * thdr    = 0;
-  er_tree = dynamic_cast <TTree *>           ( fin.Get("gtree")  );
-  thdr    = dynamic_cast <NtpMCTreeHeader *> ( fin.Get("header") );
-  if (!er_tree) {
-    LOG("gntpc", pERROR) << "Null input GHEP event tree";
-    return;
-  }
-  LOG("gntpc", pINFO) << "Input tree header: " << *thdr;
+  TLorentzVector pdummy(0,0,0,0);
 
-  // Get the mc record
-  NtpMCEventRecord * mcrec = 0;
-  er_tree->SetBranchAddress("gmcrec", &mcrec);
-  if (!mcrec) {
-    LOG("gntpc", pERROR) << "Null MC record";
-    return;
-  }
-  
-  // Figure out how many events to analyze
-  Long64_t nmax = (gOptN<0) ? 
-       er_tree->GetEntries() : TMath::Min( er_tree->GetEntries(), gOptN );
-  if (nmax<0) {
-    LOG("gntpc", pERROR) << "Number of events = 0";
-    return;
-  }
+  NtpMCRecHeader rec_header = mcrec->hdr;
+  EventRecord &  event      = *(mcrec->event);
 
-  LOG("gntpc", pNOTICE) << "*** Analyzing: " << nmax << " events";
+  LOG("gntpc", pINFO) << rec_header;
+  LOG("gntpc", pINFO) << event;
 
-  TLorentzVector pdummy(0,0,0,0);
-    
-  // Event loop
-  for(Long64_t iev = 0; iev < nmax; iev++) {
-    er_tree->GetEntry(iev);
-
-    NtpMCRecHeader rec_header = mcrec->hdr;
-    EventRecord &  event      = *(mcrec->event);
-
-    LOG("gntpc", pINFO) << rec_header;
-    LOG("gntpc", pINFO) << event;
-
-    // Go further only if the event is physical
-    bool is_unphysical = event.IsUnphysical();
-    if(is_unphysical) {
-      LOG("gntpc", pINFO) << "Skipping unphysical event";
-      mcrec->Clear();
-      continue;
-    }
+  // Go further only if the event is physical
+  bool is_unphysical = event.IsUnphysical();
+  if(is_unphysical) {
+    LOG("gntpc", pINFO) << "Skipping unphysical event";
+    return;
+  }
 
-    // Clean-up arrays
-    //
-    for(int j=0; j<kNPmax; j++) {
-       brPdgi   [j] =  0;     
-       brResc   [j] = -1;     
-       brEi     [j] =  0;     
-       brPxi    [j] =  0;     
-       brPyi    [j] =  0;     
-       brPzi    [j] =  0;     
-       brPdgf   [j] =  0;     
-       brEf     [j] =  0;     
-       brPxf    [j] =  0;     
-       brPyf    [j] =  0;     
-       brPzf    [j] =  0;     
-       brPf     [j] =  0;     
-       brCosthf [j] =  0;     
-    }
+  // Clean-up arrays
+  //
+  for(int j=0; j<kNPmax; j++) {
+     brPdgi   [j] =  0;     
+     brResc   [j] = -1;     
+     brEi     [j] =  0;     
+     brPxi    [j] =  0;     
+     brPyi    [j] =  0;     
+     brPzi    [j] =  0;     
+     brPdgf   [j] =  0;     
+     brEf     [j] =  0;     
+     brPxf    [j] =  0;     
+     brPyf    [j] =  0;     
+     brPzf    [j] =  0;     
+     brPf     [j] =  0;     
+     brCosthf [j] =  0;     
+  }
 
-    // Computing event characteristics
-    //
+  // Computing event characteristics
+  //
 
-    //input particles
-    GHepParticle * neutrino = event.Probe();
-    GHepParticle * target = event.Particle(1);
-    assert(target);
-    GHepParticle * fsl = event.FinalStatePrimaryLepton();
-    GHepParticle * hitnucl = event.HitNucleon();
+  //input particles
+  GHepParticle * neutrino = event.Probe();
+  GHepParticle * target = event.Particle(1);
+  assert(target);
+  GHepParticle * fsl = event.FinalStatePrimaryLepton();
+  GHepParticle * hitnucl = event.HitNucleon();
 
-    if( neutrino ) { LOG("gntpc", pDEBUG) << "neutrino p4 = ( " 
+  if( neutrino ) { LOG("gntpc", pDEBUG) << "neutrino p4 = ( " 
 					  << neutrino->GetP4()->E() << ", "
 					  << neutrino->GetP4()->Px() << ", "
 					  << neutrino->GetP4()->Py() << ", "
 					  << neutrino->GetP4()->Pz() << " )"; }
-    if( target ) { LOG("gntpc", pDEBUG) << "target p4 = ( " 
+  if( target ) { LOG("gntpc", pDEBUG) << "target p4 = ( " 
 					  << target->GetP4()->E() << ", "
 					  << target->GetP4()->Px() << ", "
 					  << target->GetP4()->Py() << ", "
 					  << target->GetP4()->Pz() << " )"; }
-    if( fsl ) { LOG("gntpc", pDEBUG) << "fsl p4 = ( " 
+  if( fsl ) { LOG("gntpc", pDEBUG) << "fsl p4 = ( " 
 					  << fsl->GetP4()->E() << ", "
 					  << fsl->GetP4()->Px() << ", "
 					  << fsl->GetP4()->Py() << ", "
 					  << fsl->GetP4()->Pz() << " )"; }
 
-    if( hitnucl ) { LOG("gntpc", pDEBUG) << "hitnucl p4 = ( " 
+  if( hitnucl ) { LOG("gntpc", pDEBUG) << "hitnucl p4 = ( " 
 					  << hitnucl->GetP4()->E() << ", "
 					  << hitnucl->GetP4()->Px() << ", "
 					  << hitnucl->GetP4()->Py() << ", "
 					  << hitnucl->GetP4()->Pz() << " )"; }
 
-    int tgtZ = 0;
-    int tgtA = 0;
-    if(pdg::IsIon(target->Pdg())) {
-       tgtZ = pdg::IonPdgCodeToZ(target->Pdg());
-       tgtA = pdg::IonPdgCodeToA(target->Pdg());
-    } 
-    if(target->Pdg() == kPdgProton   ) { tgtZ = 1; tgtA = 1; }    
-    if(target->Pdg() == kPdgNeutron  ) { tgtZ = 0; tgtA = 1; }    
+  int tgtZ = 0;
+  int tgtA = 0;
+  if(pdg::IsIon(target->Pdg())) {
+     tgtZ = pdg::IonPdgCodeToZ(target->Pdg());
+     tgtA = pdg::IonPdgCodeToA(target->Pdg());
+  } 
+  if(target->Pdg() == kPdgProton   ) { tgtZ = 1; tgtA = 1; }    
+  if(target->Pdg() == kPdgNeutron  ) { tgtZ = 0; tgtA = 1; }    
+
+  // Summary info
+  const Interaction * interaction = event.Summary();
+  const InitialState & init_state = interaction->InitState();
+  const ProcessInfo &  proc_info  = interaction->ProcInfo();
+  const Kinematics &   kine       = interaction->Kine();
+  const XclsTag &      xcls       = interaction->ExclTag();
+  const Target &       tgt        = init_state.Tgt();
+
+  // Vertex in detector coord system
+  TLorentzVector * vtx = event.Vertex();
+
+  // Process id
+  bool is_qel    = proc_info.IsQuasiElastic();
+  bool is_res    = proc_info.IsResonant();
+  bool is_dis    = proc_info.IsDeepInelastic();
+  bool is_coh    = proc_info.IsCoherentProduction();
+  bool is_coh_el = proc_info.IsCoherentElastic();
+  bool is_dfr    = proc_info.IsDiffractive();
+  bool is_imd    = proc_info.IsInverseMuDecay();
+  bool is_imdanh = proc_info.IsIMDAnnihilation();
+  bool is_singlek = proc_info.IsSingleKaon();    
+  bool is_nuel      = proc_info.IsNuElectronElastic();
+  bool is_em        = proc_info.IsEM();
+  bool is_weakcc    = proc_info.IsWeakCC();
+  bool is_weaknc    = proc_info.IsWeakNC();
+  bool is_mec       = proc_info.IsMEC();
+  bool is_amnugamma = proc_info.IsAMNuGamma();
+  bool is_hnl       = proc_info.IsHNLDecay();
+  bool is_norm      = proc_info.IsNorm();
   
-    // Summary info
-    const Interaction * interaction = event.Summary();
-    const InitialState & init_state = interaction->InitState();
-    const ProcessInfo &  proc_info  = interaction->ProcInfo();
-    const Kinematics &   kine       = interaction->Kine();
-    const XclsTag &      xcls       = interaction->ExclTag();
-    const Target &       tgt        = init_state.Tgt();
-
-    // Vertex in detector coord system
-    TLorentzVector * vtx = event.Vertex();
-
-    // Process id
-    bool is_qel    = proc_info.IsQuasiElastic();
-    bool is_res    = proc_info.IsResonant();
-    bool is_dis    = proc_info.IsDeepInelastic();
-    bool is_coh    = proc_info.IsCoherentProduction();
-    bool is_coh_el = proc_info.IsCoherentElastic();
-    bool is_dfr    = proc_info.IsDiffractive();
-    bool is_imd    = proc_info.IsInverseMuDecay();
-    bool is_imdanh = proc_info.IsIMDAnnihilation();
-    bool is_singlek = proc_info.IsSingleKaon();    
-    bool is_nuel      = proc_info.IsNuElectronElastic();
-    bool is_em        = proc_info.IsEM();
-    bool is_weakcc    = proc_info.IsWeakCC();
-    bool is_weaknc    = proc_info.IsWeakNC();
-    bool is_mec       = proc_info.IsMEC();
-    bool is_amnugamma = proc_info.IsAMNuGamma();
-    bool is_hnl       = proc_info.IsHNLDecay();
-    bool is_norm      = proc_info.IsNorm();
-    
-    if (!hitnucl && neutrino) {
-        assert(is_coh || is_imd || is_imdanh || is_nuel | is_amnugamma || is_coh_el || is_hnl || is_norm);
-    }
-  
-    // Hit quark - set only for DIS events
-    int  qrk  = (is_dis) ? tgt.HitQrkPdg() : 0;     
-    bool seaq = (is_dis) ? tgt.HitSeaQrk() : false; 
+  if (!hitnucl && neutrino) {
+      assert(is_coh || is_imd || is_imdanh || is_nuel | is_amnugamma || is_coh_el || is_hnl || is_norm);
+  }
 
-    // Resonance id ($GENIE/src/BaryonResonance/BaryonResonance.h) -
-    // set only for resonance neutrinoproduction
-    int resid = (is_res) ? EResonance(xcls.Resonance()) : -99;
+  // Hit quark - set only for DIS events
+  int  qrk  = (is_dis) ? tgt.HitQrkPdg() : 0;     
+  bool seaq = (is_dis) ? tgt.HitSeaQrk() : false; 
 
-    // (qel or dis) charm production?
-    bool charm = xcls.IsCharmEvent();
+  // Resonance id ($GENIE/src/BaryonResonance/BaryonResonance.h) -
+  // set only for resonance neutrinoproduction
+  int resid = (is_res) ? EResonance(xcls.Resonance()) : -99;
 
-    // Get NEUT and NUANCE equivalent reaction codes (if any)
-    brCodeNeut    = utils::ghep::NeutReactionCode(&event);
-    brCodeNuance  = utils::ghep::NuanceReactionCode(&event);
+  // (qel or dis) charm production?
+  bool charm = xcls.IsCharmEvent();
 
-    // Get event weight
-    double weight = event.Weight();
+  // Get NEUT and NUANCE equivalent reaction codes (if any)
+  brCodeNeut    = utils::ghep::NeutReactionCode(&event);
+  brCodeNuance  = utils::ghep::NuanceReactionCode(&event);
 
-    // Access kinematical params _exactly_ as they were selected internally
-    // (at the hit nucleon rest frame; 
-    // for bound nucleons: taking into account fermi momentum and off-shell kinematics)
-    //
-    bool get_selected = true;
-    double xs  = kine.x (get_selected);
-    double ys  = kine.y (get_selected);
-    double ts  = (is_coh || is_dfr || is_hnl) ? kine.t (get_selected) : -1;
-    double Q2s = kine.Q2(get_selected);
-    double Ws  = kine.W (get_selected);
-
-    LOG("gntpc", pDEBUG) 
-       << "[Select] Q2 = " << Q2s << ", W = " << Ws 
-       << ", x = " << xs << ", y = " << ys << ", t = " << ts;
-
-    // Calculate the same kinematical params but now as an experimentalist would 
-    // measure them by neglecting the fermi momentum and off-shellness of bound nucleons
-    //
+  // Get event weight
+  double weight = event.Weight();
+
+  // Access kinematical params _exactly_ as they were selected internally
+  // (at the hit nucleon rest frame; 
+  // for bound nucleons: taking into account fermi momentum and off-shell kinematics)
+  //
+  bool get_selected = true;
+  double xs  = kine.x (get_selected);
+  double ys  = kine.y (get_selected);
+  double ts  = (is_coh || is_dfr || is_hnl) ? kine.t (get_selected) : -1;
+  double Q2s = kine.Q2(get_selected);
+  double Ws  = kine.W (get_selected);
+
+  LOG("gntpc", pDEBUG) 
+     << "[Select] Q2 = " << Q2s << ", W = " << Ws 
+     << ", x = " << xs << ", y = " << ys << ", t = " << ts;
+
+  // Calculate the same kinematical params but now as an experimentalist would 
+  // measure them by neglecting the fermi momentum and off-shellness of bound nucleons
+  //
 
-    const TLorentzVector & k1 = (neutrino) ? *(neutrino->P4()) : pdummy;  // v 4-p (k1)
-    const TLorentzVector & k2 = (fsl)      ? *(fsl->P4())      : pdummy;  // l 4-p (k2)
-    const TLorentzVector & p1 = (hitnucl)  ? *(hitnucl->P4())  : pdummy;  // N 4-p (p1)      
+  const TLorentzVector & k1 = (neutrino) ? *(neutrino->P4()) : pdummy;  // v 4-p (k1)
+  const TLorentzVector & k2 = (fsl)      ? *(fsl->P4())      : pdummy;  // l 4-p (k2)
+  const TLorentzVector & p1 = (hitnucl)  ? *(hitnucl->P4())  : pdummy;  // N 4-p (p1)      
 
-    double M  = kNucleonMass; 
-    TLorentzVector q  = k1-k2;                     // q=k1-k2, 4-p transfer
-    double Q2 = -1 * q.M2();                       // momentum transfer
-    
-    double v  = (hitnucl) ? q.Energy()       : -1; // v (E transfer to the nucleus)
-    double x, y, W2, W;
-    if(!is_coh){ 
-    
-       x  = (hitnucl) ? 0.5*Q2/(M*v)     : -1; // Bjorken x
-       y  = (hitnucl) ? v/k1.Energy()    : -1; // Inelasticity, y = q*P1/k1*P1
+  double M  = kNucleonMass; 
+  TLorentzVector q  = k1-k2;                     // q=k1-k2, 4-p transfer
+  double Q2 = -1 * q.M2();                       // momentum transfer
+  
+  double v  = (hitnucl) ? q.Energy()       : -1; // v (E transfer to the nucleus)
+  double x, y, W2, W;
+  if(!is_coh){ 
+  
+     x  = (hitnucl) ? 0.5*Q2/(M*v)     : -1; // Bjorken x
+     y  = (hitnucl) ? v/k1.Energy()    : -1; // Inelasticity, y = q*P1/k1*P1
 
-       W2 = (hitnucl) ? M*M + 2*M*v - Q2 : -1; // Hadronic Invariant mass ^ 2
-       W  = (hitnucl) ? TMath::Sqrt(W2)  : -1; 
-    } else if( is_hnl ) {
-      
-       x = -1;
-       y = -1;
+     W2 = (hitnucl) ? M*M + 2*M*v - Q2 : -1; // Hadronic Invariant mass ^ 2
+     W  = (hitnucl) ? TMath::Sqrt(W2)  : -1; 
+  } else if( is_hnl ) {
+    
+     x = -1;
+     y = -1;
 
-       LOG("gntpc", pDEBUG)
+     LOG("gntpc", pDEBUG)
 	 << "Here is k1 = ( " << k1.E() << ", " << k1.Px() << ", " << k1.Py() << ", " << k1.Pz() << " )";
 
-       W2 = k1.M2(); // Invariant mass ^ 2 of HNL
-       W = TMath::Sqrt(W2);
-    } else{
+     W2 = k1.M2(); // Invariant mass ^ 2 of HNL
+     W = TMath::Sqrt(W2);
+  } else{
 
-       v = q.Energy();
-       x  =  0.5*Q2/(M*v);      // Bjorken x
-       y  = v/k1.Energy();    // Inelasticity, y = q*P1/k1*P1
+     v = q.Energy();
+     x  =  0.5*Q2/(M*v);      // Bjorken x
+     y  = v/k1.Energy();    // Inelasticity, y = q*P1/k1*P1
 
-       W2 = M*M + 2*M*v - Q2;  // Hadronic Invariant mass ^ 2
-       W  = TMath::Sqrt(W2); 
+     W2 = M*M + 2*M*v - Q2;  // Hadronic Invariant mass ^ 2
+     W  = TMath::Sqrt(W2); 
 
-    }
-  
-    double t  = (is_coh || is_dfr || is_hnl) ? kine.t (get_selected) : -1;
+  }
 
-    // Get v 4-p at hit nucleon rest-frame
-    TLorentzVector k1_rf = k1;         
-    if(hitnucl) {
-       k1_rf.Boost(-1.*p1.BoostVector());
-    }
+  double t  = (is_coh || is_dfr || is_hnl) ? kine.t (get_selected) : -1;
+
+  // Get v 4-p at hit nucleon rest-frame
+  TLorentzVector k1_rf = k1;         
+  if(hitnucl) {
+     k1_rf.Boost(-1.*p1.BoostVector());
+  }
 
 //    if(is_mec){
 //      v = q.Energy();
@@ -756,50 +773,50 @@ void ConvertToGST(void)
 //      W = TMath::Sqrt(W2);
 //    }
 
-    LOG("gntpc", pDEBUG) 
-       << "[Calc] Q2 = " << Q2 << ", W = " << W 
-       << ", x = " << x << ", y = " << y << ", t = " << t;
+  LOG("gntpc", pDEBUG) 
+     << "[Calc] Q2 = " << Q2 << ", W = " << W 
+     << ", x = " << x << ", y = " << y << ", t = " << t;
 
-    // Extract more info on the hadronic system
-    // Only for QEL/RES/DIS/COH/MEC events
-    // Edit: Add in HNL events
-    //
-    bool study_hadsyst = (is_qel || is_res || is_dis || is_coh || is_dfr || is_mec || is_singlek || is_hnl);
-    
-    //
-    TObjArrayIter piter(&event);
-    GHepParticle * p = 0;
-    int ip=-1;
+  // Extract more info on the hadronic system
+  // Only for QEL/RES/DIS/COH/MEC events
+  // Edit: Add in HNL events
+  //
+  bool study_hadsyst = (is_qel || is_res || is_dis || is_coh || is_dfr || is_mec || is_singlek || is_hnl);
+  
+  //
+  TObjArrayIter piter(&event);
+  GHepParticle * p = 0;
+  int ip=-1;
 
-    //
-    // Extract the final state system originating from the hadronic vertex 
-    // (after the intranuclear rescattering step)
-    //
+  //
+  // Extract the final state system originating from the hadronic vertex 
+  // (after the intranuclear rescattering step)
+  //
 
-    LOG("gntpc", pDEBUG) << "Extracting final state hadronic system";
+  LOG("gntpc", pDEBUG) << "Extracting final state hadronic system";
 
-    vector<int> final_had_syst;
-    while( (p = (GHepParticle *) piter.Next()) && study_hadsyst)
-    {
-      ip++;
-      // don't count final state lepton as part hadronic system 
-      //if(!is_coh && event.Particle(ip)->FirstMother()==0) continue;
-      if(!is_hnl && event.Particle(ip)->FirstMother()==0) continue;
-      if(is_hnl && event.Particle(0)->FirstDaughter()==ip) continue;
-      if(pdg::IsPseudoParticle(p->Pdg())) continue;
-      int pdgc = p->Pdg();
-      int ist  = p->Status();
-      if(ist==kIStStableFinalState && !is_hnl) {
-         if (pdgc == kPdgGamma || pdgc == kPdgElectron || pdgc == kPdgPositron)  {
-            int igmom = p->FirstMother();
-            if(igmom!=-1) {
+  vector<int> final_had_syst;
+  while( (p = (GHepParticle *) piter.Next()) && study_hadsyst)
+  {
+    ip++;
+    // don't count final state lepton as part hadronic system 
+    //if(!is_coh && event.Particle(ip)->FirstMother()==0) continue;
+    if(!is_hnl && event.Particle(ip)->FirstMother()==0) continue;
+    if(is_hnl && event.Particle(0)->FirstDaughter()==ip) continue;
+    if(pdg::IsPseudoParticle(p->Pdg())) continue;
+    int pdgc = p->Pdg();
+    int ist  = p->Status();
+    if(ist==kIStStableFinalState && !is_hnl) {
+       if (pdgc == kPdgGamma || pdgc == kPdgElectron || pdgc == kPdgPositron)  {
+          int igmom = p->FirstMother();
+          if(igmom!=-1) {
 	      final_had_syst.push_back(ip);
-            }
-         } else {
+          }
+       } else {
 	   final_had_syst.push_back(ip);
-         }
-      }
-      else if(ist==kIStStableFinalState && is_hnl) {
+       }
+    }
+    else if(ist==kIStStableFinalState && is_hnl) {
 	// HNL have decays with multiple leptons, such as v + mu + mu
 	// only one of these will be primary, so don't add this to hadronic system
 	if( std::abs(pdgc) == kPdgElectron || 
@@ -810,42 +827,41 @@ void ConvertToGST(void)
 	    std::abs(pdgc) == kPdgNuTau ) continue;
 	LOG( "gntpc", pDEBUG ) << "Adding pdg code " << ip << " to FS hadronic system";
 	final_had_syst.push_back(ip);
-      } 
-    }//particle-loop
+    } 
+  }//particle-loop
 
-    if( count(final_had_syst.begin(), final_had_syst.end(), -1) > 0) {
-        mcrec->Clear();
- 	continue;
-    }
+  if( count(final_had_syst.begin(), final_had_syst.end(), -1) > 0) {
+      return;
+  }
 
-    //
-    // Extract info on the primary hadronic system (before any intranuclear rescattering)
-    // looking for particles with status_code == kIStHadronInTheNucleus 
-    // An exception is the coherent production and scattering off free nucleon targets 
-    // (no intranuclear rescattering) in which case primary hadronic system is set to be 
-    // 'identical' with the final  state hadronic system
-    //
+  //
+  // Extract info on the primary hadronic system (before any intranuclear rescattering)
+  // looking for particles with status_code == kIStHadronInTheNucleus 
+  // An exception is the coherent production and scattering off free nucleon targets 
+  // (no intranuclear rescattering) in which case primary hadronic system is set to be 
+  // 'identical' with the final  state hadronic system
+  //
 
-    LOG("gntpc", pDEBUG) << "Extracting primary hadronic system";
-    
-    ip = -1;
-    TObjArrayIter piter_prim(&event);
+  LOG("gntpc", pDEBUG) << "Extracting primary hadronic system";
+  
+  ip = -1;
+  TObjArrayIter piter_prim(&event);
 
-    vector<int> prim_had_syst;
-    if(study_hadsyst) {
-      // if coherent or free nucleon target set primary states equal to final states
-      // Edit: same for HNL
-      
-      if(!pdg::IsIon(target->Pdg()) || (is_coh) || (is_hnl)) {
+  vector<int> prim_had_syst;
+  if(study_hadsyst) {
+    // if coherent or free nucleon target set primary states equal to final states
+    // Edit: same for HNL
+    
+    if(!pdg::IsIon(target->Pdg()) || (is_coh) || (is_hnl)) {
 
 	for( vector<int>::const_iterator hiter = final_had_syst.begin();
 	     hiter != final_had_syst.end(); ++hiter) {
 
 	  prim_had_syst.push_back(*hiter);
 	}
-      } 
-      
-      else {
+    } 
+    
+    else {
 
 	// otherwise loop over all particles and store indices of those which are hadrons
 	// created within the nucleus
@@ -929,465 +945,446 @@ void ConvertToGST(void)
 	}      
 
 	
-      } // else from ( not ion or coherent ) 
-      
-    }//study_hadsystem?
+    } // else from ( not ion or coherent ) 
     
-    if( count(prim_had_syst.begin(), prim_had_syst.end(), -1) > 0) {
-        mcrec->Clear();
- 	continue;
-    }
+  }//study_hadsystem?
+  
+  if( count(prim_had_syst.begin(), prim_had_syst.end(), -1) > 0) {
+      return;
+  }
 
-    //
-    // Al information has been assembled -- Start filling up the tree branches
-    //
-    brIev        = (int) iev;      
-    brNeutrino   = (neutrino) ? neutrino->Pdg() : 0;      
-    brFSPrimLept = (fsl) ? fsl->Pdg() : 0;
-    brTarget     = target->Pdg(); 
-    brTargetZ    = tgtZ;
-    brTargetA    = tgtA;   
-    brHitNuc     = (hitnucl) ? hitnucl->Pdg() : 0;      
-    brHitQrk     = qrk;     
-    brFromSea    = seaq;  
-    brResId      = resid;
-    brIsQel      = is_qel;
-    brIsRes      = is_res;
-    brIsDis      = is_dis;  
-    brIsCoh      = is_coh;  
-    brIsDfr      = is_dfr;  
-    brIsImd      = is_imd;
-    brIsNrm      = is_norm;
-    brIsSingleK  = is_singlek;    
-    brIsNuEL     = is_nuel;  
-    brIsEM       = is_em;  
-    brIsMec      = is_mec;
-    brIsCC       = is_weakcc;  
-    brIsNC       = is_weaknc;  
-    brIsCharmPro = charm;
-    brIsAMNuGamma= is_amnugamma;
-    brIsHNL      = is_hnl;
-    brWeight     = weight;      
-    brKineXs     = xs;      
-    brKineYs     = ys;      
-    brKineTs     = ts;      
-    brKineQ2s    = Q2s;            
-    brKineWs     = Ws;      
-    brKineX      = x;      
-    brKineY      = y;      
-    brKineT      = t;      
-    brKineQ2     = Q2;      
-    brKineW      = W;      
-    brEvRF       = k1_rf.Energy();      
-    brEv         = k1.Energy();      
-    brPxv        = k1.Px();  
-    brPyv        = k1.Py();  
-    brPzv        = k1.Pz();  
-    brEn         = (hitnucl) ? p1.Energy() : 0;      
-    brPxn        = (hitnucl) ? p1.Px()     : 0;      
-    brPyn        = (hitnucl) ? p1.Py()     : 0;      
-    brPzn        = (hitnucl) ? p1.Pz()     : 0;            
-    brEl         = k2.Energy();      
-    brPxl        = k2.Px();      
-    brPyl        = k2.Py();      
-    brPzl        = k2.Pz();      
-    brPl         = k2.P();
-    brCosthl     = TMath::Cos( k2.Vect().Angle(k1.Vect()) );
-
-    // XSec Info
-
-    brXSec  = event.XSec()*(1E+38/units::cm2);
-    brDXSec = event.DiffXSec()*(1E+38/units::cm2);
-    brKPS   = event.DiffXSecVars();
-
-    // Primary hadronic system (from primary neutrino interaction, before FSI)
-    brNiP        = 0;
-    brNiN        = 0;    
-    brNiPip      = 0;    
-    brNiPim      = 0;    
-    brNiPi0      = 0;    
-    brNiKp       = 0;  
-    brNiKm       = 0;  
-    brNiK0       = 0;  
-    brNiEM       = 0;  
-    brNiOther    = 0;  
-    brNi = prim_had_syst.size();
-    for(int j=0; j<brNi; j++) {
-      p = event.Particle(prim_had_syst[j]);
-      assert(p);
-      brPdgi[j] = p->Pdg();     
-      brResc[j] = p->RescatterCode();     
-      brEi  [j] = p->Energy();     
-      brPxi [j] = p->Px();     
-      brPyi [j] = p->Py();     
-      brPzi [j] = p->Pz();     
-
-      if      (p->Pdg() == kPdgProton  || p->Pdg() == kPdgAntiProton)   brNiP++;
-      else if (p->Pdg() == kPdgNeutron || p->Pdg() == kPdgAntiNeutron)  brNiN++;
-      else if (p->Pdg() == kPdgPiP) brNiPip++; 
-      else if (p->Pdg() == kPdgPiM) brNiPim++; 
-      else if (p->Pdg() == kPdgPi0) brNiPi0++; 
-      else if (p->Pdg() == kPdgKP)  brNiKp++;  
-      else if (p->Pdg() == kPdgKM)  brNiKm++;  
-      else if (p->Pdg() == kPdgK0    || p->Pdg() == kPdgAntiK0)  brNiK0++; 
-      else if (p->Pdg() == kPdgGamma || p->Pdg() == kPdgElectron || p->Pdg() == kPdgPositron) brNiEM++;
-      else brNiOther++;
-
-      LOG("gntpc", pINFO) 
-        << "Counting in primary hadronic system: idx = " << prim_had_syst[j]
-        << " -> " << p->Name();
-    }
+  //
+  // Al information has been assembled -- Start filling up the tree branches
+  //
+  brIev        = (int) iev;      
+  brNeutrino   = (neutrino) ? neutrino->Pdg() : 0;      
+  brFSPrimLept = (fsl) ? fsl->Pdg() : 0;
+  brTarget     = target->Pdg(); 
+  brTargetZ    = tgtZ;
+  brTargetA    = tgtA;   
+  brHitNuc     = (hitnucl) ? hitnucl->Pdg() : 0;      
+  brHitQrk     = qrk;     
+  brFromSea    = seaq;  
+  brResId      = resid;
+  brIsQel      = is_qel;
+  brIsRes      = is_res;
+  brIsDis      = is_dis;  
+  brIsCoh      = is_coh;  
+  brIsDfr      = is_dfr;  
+  brIsImd      = is_imd;
+  brIsNrm      = is_norm;
+  brIsSingleK  = is_singlek;    
+  brIsNuEL     = is_nuel;  
+  brIsEM       = is_em;  
+  brIsMec      = is_mec;
+  brIsCC       = is_weakcc;  
+  brIsNC       = is_weaknc;  
+  brIsCharmPro = charm;
+  brIsAMNuGamma= is_amnugamma;
+  brIsHNL      = is_hnl;
+  brWeight     = weight;      
+  brKineXs     = xs;      
+  brKineYs     = ys;      
+  brKineTs     = ts;      
+  brKineQ2s    = Q2s;            
+  brKineWs     = Ws;      
+  brKineX      = x;      
+  brKineY      = y;      
+  brKineT      = t;      
+  brKineQ2     = Q2;      
+  brKineW      = W;      
+  brEvRF       = k1_rf.Energy();      
+  brEv         = k1.Energy();      
+  brPxv        = k1.Px();  
+  brPyv        = k1.Py();  
+  brPzv        = k1.Pz();  
+  brEn         = (hitnucl) ? p1.Energy() : 0;      
+  brPxn        = (hitnucl) ? p1.Px()     : 0;      
+  brPyn        = (hitnucl) ? p1.Py()     : 0;      
+  brPzn        = (hitnucl) ? p1.Pz()     : 0;            
+  brEl         = k2.Energy();      
+  brPxl        = k2.Px();      
+  brPyl        = k2.Py();      
+  brPzl        = k2.Pz();      
+  brPl         = k2.P();
+  brCosthl     = TMath::Cos( k2.Vect().Angle(k1.Vect()) );
+
+  // XSec Info
+
+  brXSec  = event.XSec()*(1E+38/units::cm2);
+  brDXSec = event.DiffXSec()*(1E+38/units::cm2);
+  brKPS   = event.DiffXSecVars();
+
+  // Primary hadronic system (from primary neutrino interaction, before FSI)
+  brNiP        = 0;
+  brNiN        = 0;    
+  brNiPip      = 0;    
+  brNiPim      = 0;    
+  brNiPi0      = 0;    
+  brNiKp       = 0;  
+  brNiKm       = 0;  
+  brNiK0       = 0;  
+  brNiEM       = 0;  
+  brNiOther    = 0;  
+  brNi = prim_had_syst.size();
+  for(int j=0; j<brNi; j++) {
+    p = event.Particle(prim_had_syst[j]);
+    assert(p);
+    brPdgi[j] = p->Pdg();     
+    brResc[j] = p->RescatterCode();     
+    brEi  [j] = p->Energy();     
+    brPxi [j] = p->Px();     
+    brPyi [j] = p->Py();     
+    brPzi [j] = p->Pz();     
+
+    if      (p->Pdg() == kPdgProton  || p->Pdg() == kPdgAntiProton)   brNiP++;
+    else if (p->Pdg() == kPdgNeutron || p->Pdg() == kPdgAntiNeutron)  brNiN++;
+    else if (p->Pdg() == kPdgPiP) brNiPip++; 
+    else if (p->Pdg() == kPdgPiM) brNiPim++; 
+    else if (p->Pdg() == kPdgPi0) brNiPi0++; 
+    else if (p->Pdg() == kPdgKP)  brNiKp++;  
+    else if (p->Pdg() == kPdgKM)  brNiKm++;  
+    else if (p->Pdg() == kPdgK0    || p->Pdg() == kPdgAntiK0)  brNiK0++; 
+    else if (p->Pdg() == kPdgGamma || p->Pdg() == kPdgElectron || p->Pdg() == kPdgPositron) brNiEM++;
+    else brNiOther++;
 
     LOG("gntpc", pINFO) 
-     << "N(p):"             << brNiP
-     << ", N(n):"           << brNiN
-     << ", N(pi+):"         << brNiPip
-     << ", N(pi-):"         << brNiPim
-     << ", N(pi0):"         << brNiPi0
-     << ", N(K+,K-,K0):"    << brNiKp+brNiKm+brNiK0
-     << ", N(gamma,e-,e+):" << brNiEM
-     << ", N(etc):"         << brNiOther << "\n";
-
-    // Final state (visible) hadronic system
-    brNfP        = 0;
-    brNfN        = 0;    
-    brNfPip      = 0;    
-    brNfPim      = 0;    
-    brNfPi0      = 0;    
-    brNfKp       = 0;  
-    brNfKm       = 0;  
-    brNfK0       = 0;  
-    brNfEM       = 0;  
-    brNfOther    = 0;  
-
-    brSumKEf     = (fsl) ? fsl->KinE() : 0;
-    brCalResp0   = 0;
-
-    brNf = final_had_syst.size();
-    for(int j=0; j<brNf; j++) {
-      p = event.Particle(final_had_syst[j]);
-      assert(p);
+      << "Counting in primary hadronic system: idx = " << prim_had_syst[j]
+      << " -> " << p->Name();
+  }
 
-      int    hpdg = p->Pdg();     
-      double hE   = p->Energy();     
-      double hKE  = p->KinE();     
-      double hpx  = p->Px();     
-      double hpy  = p->Py();     
-      double hpz  = p->Pz();     
-      double hp   = TMath::Sqrt(hpx*hpx + hpy*hpy + hpz*hpz);
-      double hm   = p->Mass();     
-      double hcth = TMath::Cos( p->P4()->Vect().Angle(k1.Vect()) );
-
-      brPdgf  [j] = hpdg;
-      brEf    [j] = hE;
-      brPxf   [j] = hpx;
-      brPyf   [j] = hpy;
-      brPzf   [j] = hpz;
-      brPf    [j] = hp;
-      brCosthf[j] = hcth;
-
-      brSumKEf += hKE;
-
-      if      ( hpdg == kPdgProton      )  { brNfP++;     brCalResp0 += hKE;        }
-      else if ( hpdg == kPdgAntiProton  )  { brNfP++;     brCalResp0 += (hE + 2*hm);}
-      else if ( hpdg == kPdgNeutron     )  { brNfN++;     brCalResp0 += hKE;        }
-      else if ( hpdg == kPdgAntiNeutron )  { brNfN++;     brCalResp0 += (hE + 2*hm);}
-      else if ( hpdg == kPdgPiP         )  { brNfPip++;   brCalResp0 += hKE;        }
-      else if ( hpdg == kPdgPiM         )  { brNfPim++;   brCalResp0 += hKE;        }
-      else if ( hpdg == kPdgPi0         )  { brNfPi0++;   brCalResp0 += (e_h * hE); }
-      else if ( hpdg == kPdgKP          )  { brNfKp++;    brCalResp0 += hKE;        }
-      else if ( hpdg == kPdgKM          )  { brNfKm++;    brCalResp0 += hKE;        }
-      else if ( hpdg == kPdgK0          )  { brNfK0++;    brCalResp0 += hKE;        }
-      else if ( hpdg == kPdgAntiK0      )  { brNfK0++;    brCalResp0 += hKE;        }
-      else if ( hpdg == kPdgGamma       )  { brNfEM++;    brCalResp0 += (e_h * hE); }
-      else if ( hpdg == kPdgElectron    )  { brNfEM++;    brCalResp0 += (e_h * hE); }
-      else if ( hpdg == kPdgPositron    )  { brNfEM++;    brCalResp0 += (e_h * hE); }
-      else                                 { brNfOther++; brCalResp0 += hKE;        }
-
-      LOG("gntpc", pINFO) 
-        << "Counting in f/s system from hadronic vtx: idx = " << final_had_syst[j]
-        << " -> " << p->Name();
-    }
+  LOG("gntpc", pINFO) 
+   << "N(p):"             << brNiP
+   << ", N(n):"           << brNiN
+   << ", N(pi+):"         << brNiPip
+   << ", N(pi-):"         << brNiPim
+   << ", N(pi0):"         << brNiPi0
+   << ", N(K+,K-,K0):"    << brNiKp+brNiKm+brNiK0
+   << ", N(gamma,e-,e+):" << brNiEM
+   << ", N(etc):"         << brNiOther << "\n";
+
+  // Final state (visible) hadronic system
+  brNfP        = 0;
+  brNfN        = 0;    
+  brNfPip      = 0;    
+  brNfPim      = 0;    
+  brNfPi0      = 0;    
+  brNfKp       = 0;  
+  brNfKm       = 0;  
+  brNfK0       = 0;  
+  brNfEM       = 0;  
+  brNfOther    = 0;  
+
+  brSumKEf     = (fsl) ? fsl->KinE() : 0;
+  brCalResp0   = 0;
+
+  brNf = final_had_syst.size();
+  for(int j=0; j<brNf; j++) {
+    p = event.Particle(final_had_syst[j]);
+    assert(p);
+
+    int    hpdg = p->Pdg();     
+    double hE   = p->Energy();     
+    double hKE  = p->KinE();     
+    double hpx  = p->Px();     
+    double hpy  = p->Py();     
+    double hpz  = p->Pz();     
+    double hp   = TMath::Sqrt(hpx*hpx + hpy*hpy + hpz*hpz);
+    double hm   = p->Mass();     
+    double hcth = TMath::Cos( p->P4()->Vect().Angle(k1.Vect()) );
+
+    brPdgf  [j] = hpdg;
+    brEf    [j] = hE;
+    brPxf   [j] = hpx;
+    brPyf   [j] = hpy;
+    brPzf   [j] = hpz;
+    brPf    [j] = hp;
+    brCosthf[j] = hcth;
+
+    brSumKEf += hKE;
+
+    if      ( hpdg == kPdgProton      )  { brNfP++;     brCalResp0 += hKE;        }
+    else if ( hpdg == kPdgAntiProton  )  { brNfP++;     brCalResp0 += (hE + 2*hm);}
+    else if ( hpdg == kPdgNeutron     )  { brNfN++;     brCalResp0 += hKE;        }
+    else if ( hpdg == kPdgAntiNeutron )  { brNfN++;     brCalResp0 += (hE + 2*hm);}
+    else if ( hpdg == kPdgPiP         )  { brNfPip++;   brCalResp0 += hKE;        }
+    else if ( hpdg == kPdgPiM         )  { brNfPim++;   brCalResp0 += hKE;        }
+    else if ( hpdg == kPdgPi0         )  { brNfPi0++;   brCalResp0 += (e_h * hE); }
+    else if ( hpdg == kPdgKP          )  { brNfKp++;    brCalResp0 += hKE;        }
+    else if ( hpdg == kPdgKM          )  { brNfKm++;    brCalResp0 += hKE;        }
+    else if ( hpdg == kPdgK0          )  { brNfK0++;    brCalResp0 += hKE;        }
+    else if ( hpdg == kPdgAntiK0      )  { brNfK0++;    brCalResp0 += hKE;        }
+    else if ( hpdg == kPdgGamma       )  { brNfEM++;    brCalResp0 += (e_h * hE); }
+    else if ( hpdg == kPdgElectron    )  { brNfEM++;    brCalResp0 += (e_h * hE); }
+    else if ( hpdg == kPdgPositron    )  { brNfEM++;    brCalResp0 += (e_h * hE); }
+    else                                 { brNfOther++; brCalResp0 += hKE;        }
 
     LOG("gntpc", pINFO) 
-     << "N(p):"             << brNfP
-     << ", N(n):"           << brNfN
-     << ", N(pi+):"         << brNfPip
-     << ", N(pi-):"         << brNfPim
-     << ", N(pi0):"         << brNfPi0
-     << ", N(K+,K-,K0):"    << brNfKp+brNfKm+brNfK0
-     << ", N(gamma,e-,e+):" << brNfEM
-     << ", N(etc):"         << brNfOther << "\n";
-
-    brVtxX = vtx->X();   
-    brVtxY = vtx->Y();   
-    brVtxZ = vtx->Z();   
-    brVtxT = vtx->T();
-
-    s_tree->Fill();
-
-    mcrec->Clear();
-
-  } // event loop
-
+      << "Counting in f/s system from hadronic vtx: idx = " << final_had_syst[j]
+      << " -> " << p->Name();
+  }
 
+  LOG("gntpc", pINFO) 
+   << "N(p):"             << brNfP
+   << ", N(n):"           << brNfN
+   << ", N(pi+):"         << brNfPip
+   << ", N(pi-):"         << brNfPim
+   << ", N(pi0):"         << brNfPi0
+   << ", N(K+,K-,K0):"    << brNfKp+brNfKm+brNfK0
+   << ", N(gamma,e-,e+):" << brNfEM
+   << ", N(etc):"         << brNfOther << "\n";
+
+  brVtxX = vtx->X();   
+  brVtxY = vtx->Y();   
+  brVtxZ = vtx->Z();   
+  brVtxT = vtx->T();
+
+  s_tree->Fill();
+}
+//____________________________________________________________________________________
+void GNtpcGSTConverter::End(TFile & fin, TTree * /*gtree*/)
+{
   // Copy MC job metadata (gconfig and genv TFolders)
   if(gOptCopyJobMeta) {
     TFolder * genv    = (TFolder*) fin.Get("genv");
     TFolder * gconfig = (TFolder*) fin.Get("gconfig");
-    fout.cd();       
+    fout->cd();       
     genv    -> Write("genv");
     gconfig -> Write("gconfig");
   }
 
-  fin.Close();
-
-  fout.Write();
-  fout.Close();
+  fout->Write();
+  fout->Close();
+  delete fout;
 }
 //____________________________________________________________________________________
 // GENIE GHEP EVENT TREE FORMAT -> GENIE XML EVENT FILE FORMAT 
 //____________________________________________________________________________________
-void ConvertToGXML(void)
+class GNtpcGXMLConverter : public GNtpcConverter
 {
-  //-- open the ROOT file and get the TTree & its header
-  TFile fin(gOptInpFileName.c_str(),"READ");
-  TTree *           tree = 0;
-  NtpMCTreeHeader * thdr = 0;
-  tree = dynamic_cast <TTree *>           ( fin.Get("gtree")  );
-  thdr = dynamic_cast <NtpMCTreeHeader *> ( fin.Get("header") );
-
-  LOG("gntpc", pINFO) << "Input tree header: " << *thdr;
+public:
+  GNtpcGXMLConverter(GNtpcFmt_t fmt, string filename, int vrs) :
+    GNtpcConverter(fmt, filename, vrs) { }
 
-  //-- get mc record
-  NtpMCEventRecord * mcrec = 0;
-  tree->SetBranchAddress("gmcrec", &mcrec);
+  void Begin   (TFile & fin, TTree * gtree, NtpMCTreeHeader * thdr);
+  void Convert (Long64_t iev, NtpMCEventRecord * mcrec);
+  void End     (TFile & fin, TTree * gtree);
 
+private:
+  ofstream output;  // output stream
+};
+//____________________________________________________________________________________
+void GNtpcGXMLConverter::Begin(TFile & /*fin*/, TTree * /*gtree*/, NtpMCTreeHeader * /*thdr*/)
+{
   //-- open the output stream
-  ofstream output(gOptOutFileName.c_str(), ios::out);
+  output.open(fOutFileName.c_str(), ios::out);
 
   //-- add required header
-  output << "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?>";
-  output << endl << endl;
-  output << "<!-- generated by GENIE gntpc utility -->";   
-  output << endl << endl;
-  output << "<genie_event_list version=\"1.00\">" << endl;
-
-  //-- figure out how many events to analyze
-  Long64_t nmax = (gOptN<0) ? 
-       tree->GetEntries() : TMath::Min(tree->GetEntries(), gOptN);
-  if (nmax<0) {
-    LOG("gntpc", pERROR) << "Number of events = 0";
-    return;
+  if(gIsFirstChunk) {
+    output << "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?>";
+    output << endl << endl;
+    output << "<!-- generated by GENIE gntpc utility -->";   
+    output << endl << endl;
+    output << "<genie_event_list version=\"1.00\">" << endl;
   }
-  LOG("gntpc", pNOTICE) << "*** Analyzing: " << nmax << " events";
-
-  //-- event loop
-  for(Long64_t iev = 0; iev < nmax; iev++) {
-    tree->GetEntry(iev);
-    NtpMCRecHeader rec_header = mcrec->hdr;
-    EventRecord &  event      = *(mcrec->event);
+}
+//____________________________________________________________________________________
+void GNtpcGXMLConverter::Convert(Long64_t iev, NtpMCEventRecord * mcrec)
+{
+  NtpMCRecHeader rec_header = mcrec->hdr;
+  EventRecord &  event      = *(mcrec->event);
 
-    LOG("gntpc", pINFO) << rec_header;
-    LOG("gntpc", pINFO) << event;
+  LOG("gntpc", pINFO) << rec_header;
+  LOG("gntpc", pINFO) << event;
 
-    //
-    // convert the current event
-    //
+  //
+  // convert the current event
+  //
 
-    output << endl << endl;
-    output << "  <!-- GENIE GHEP event -->" << endl;
-    output << "  <ghep np=\"" << event.GetEntries() 
-           << "\" unphysical=\"" 
-           << (event.IsUnphysical() ? "true" : "false") << "\">" << endl;
-    output << setiosflags(ios::scientific);
-
-    // write-out the event-wide properties
-    output << "   ";
-    output << "  <!-- event weight   -->";
-    output << " <wgt> " << event.Weight()   << " </wgt>";
+  output << endl << endl;
+  output << "  <!-- GENIE GHEP event -->" << endl;
+  output << "  <ghep np=\"" << event.GetEntries() 
+         << "\" unphysical=\"" 
+         << (event.IsUnphysical() ? "true" : "false") << "\">" << endl;
+  output << setiosflags(ios::scientific);
+
+  // write-out the event-wide properties
+  output << "   ";
+  output << "  <!-- event weight   -->";
+  output << " <wgt> " << event.Weight()   << " </wgt>";
+  output << endl;
+  output << "   ";
+  output << "  <!-- cross sections -->";
+  output << " <xsec_evnt> " << event.XSec()     << " </xsec_evnt>";
+  output << " <xsec_kine> " << event.DiffXSec() << " </xsec_kine>";
+  output << endl;
+  output << "   ";
+  output << "  <!-- event vertex   -->";
+  output << " <vx> " << event.Vertex()->X() << " </vx>";
+  output << " <vy> " << event.Vertex()->Y() << " </vy>";
+  output << " <vz> " << event.Vertex()->Z() << " </vz>";
+  output << " <vt> " << event.Vertex()->T() << " </vt>";
+  output << endl;
+
+  //  write-out the generated particle list
+  output << "     <!-- particle list  -->" << endl;
+  unsigned int i=0;
+  GHepParticle * p = 0;
+  TIter event_iter(&event);
+  while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
+    string type = "U";
+    if      (pdg::IsPseudoParticle(p->Pdg())) type = "F";
+    else if (pdg::IsParticle      (p->Pdg())) type = "P";
+    else if (pdg::IsIon           (p->Pdg())) type = "N";
+    
+    output << "     <p idx=\"" << i << "\" type=\"" << type << "\">" << endl;
+    output << "        ";
+    output << " <pdg> " << p->Pdg()       << " </pdg>";
+    output << " <ist> " << p->Status()    << " </ist>";
     output << endl;
-    output << "   ";
-    output << "  <!-- cross sections -->";
-    output << " <xsec_evnt> " << event.XSec()     << " </xsec_evnt>";
-    output << " <xsec_kine> " << event.DiffXSec() << " </xsec_kine>";
+    output << "        ";
+    output << " <mother>   "  
+           << " <fst> " << setfill(' ') << setw(3) << p->FirstMother() << " </fst> "
+           << " <lst> " << setfill(' ') << setw(3) << p->LastMother()  << " </lst> "
+           << " </mother>";
     output << endl;
-    output << "   ";
-    output << "  <!-- event vertex   -->";
-    output << " <vx> " << event.Vertex()->X() << " </vx>";
-    output << " <vy> " << event.Vertex()->Y() << " </vy>";
-    output << " <vz> " << event.Vertex()->Z() << " </vz>";
-    output << " <vt> " << event.Vertex()->T() << " </vt>";
+    output << "        ";
+    output << " <daughter> "  
+           << " <fst> " << setfill(' ') << setw(3) << p->FirstDaughter() << " </fst> "
+           << " <lst> " << setfill(' ') << setw(3) << p->LastDaughter()  << " </lst> "
+           << " </daughter>";
+    output << endl;
+    output << "        ";
+    output << " <px> " << setfill(' ') << setw(20) << p->Px() << " </px>";
+    output << " <py> " << setfill(' ') << setw(20) << p->Py() << " </py>";
+    output << " <pz> " << setfill(' ') << setw(20) << p->Pz() << " </pz>";
+    output << " <E>  " << setfill(' ') << setw(20) << p->E()  << " </E> ";
+    output << endl;
+    output << "        ";
+    output << " <x>  " << setfill(' ') << setw(20) << p->Vx() << " </x> ";
+    output << " <y>  " << setfill(' ') << setw(20) << p->Vy() << " </y> ";
+    output << " <z>  " << setfill(' ') << setw(20) << p->Vz() << " </z> ";
+    output << " <t>  " << setfill(' ') << setw(20) << p->Vt() << " </t> ";
     output << endl;
 
-    //  write-out the generated particle list
-    output << "     <!-- particle list  -->" << endl;
-    unsigned int i=0;
-    GHepParticle * p = 0;
-    TIter event_iter(&event);
-    while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
-      string type = "U";
-      if      (pdg::IsPseudoParticle(p->Pdg())) type = "F";
-      else if (pdg::IsParticle      (p->Pdg())) type = "P";
-      else if (pdg::IsIon           (p->Pdg())) type = "N";
-      
-      output << "     <p idx=\"" << i << "\" type=\"" << type << "\">" << endl;
-      output << "        ";
-      output << " <pdg> " << p->Pdg()       << " </pdg>";
-      output << " <ist> " << p->Status()    << " </ist>";
-      output << endl;
-      output << "        ";
-      output << " <mother>   "  
-             << " <fst> " << setfill(' ') << setw(3) << p->FirstMother() << " </fst> "
-             << " <lst> " << setfill(' ') << setw(3) << p->LastMother()  << " </lst> "
-             << " </mother>";
-      output << endl;
-      output << "        ";
-      output << " <daughter> "  
-             << " <fst> " << setfill(' ') << setw(3) << p->FirstDaughter() << " </fst> "
-             << " <lst> " << setfill(' ') << setw(3) << p->LastDaughter()  << " </lst> "
-             << " </daughter>";
-      output << endl;
+    if(p->PolzIsSet()) {
       output << "        ";
-      output << " <px> " << setfill(' ') << setw(20) << p->Px() << " </px>";
-      output << " <py> " << setfill(' ') << setw(20) << p->Py() << " </py>";
-      output << " <pz> " << setfill(' ') << setw(20) << p->Pz() << " </pz>";
-      output << " <E>  " << setfill(' ') << setw(20) << p->E()  << " </E> ";
+      output << " <ppolar> " << p->PolzPolarAngle()   << " </ppolar>";
+      output << " <pazmth> " << p->PolzAzimuthAngle() << " </pazmth>";
       output << endl;
-      output << "        ";
-      output << " <x>  " << setfill(' ') << setw(20) << p->Vx() << " </x> ";
-      output << " <y>  " << setfill(' ') << setw(20) << p->Vy() << " </y> ";
-      output << " <z>  " << setfill(' ') << setw(20) << p->Vz() << " </z> ";
-      output << " <t>  " << setfill(' ') << setw(20) << p->Vt() << " </t> ";
-      output << endl;
-
-      if(p->PolzIsSet()) {
-        output << "        ";
-        output << " <ppolar> " << p->PolzPolarAngle()   << " </ppolar>";
-        output << " <pazmth> " << p->PolzAzimuthAngle() << " </pazmth>";
-        output << endl;
-      }
-
-      if(p->RescatterCode() != -1) {
-        output << "        ";
-        output << " <rescatter> " << p->RescatterCode()   << " </rescatter>";
-        output << endl;       
-      }
+    }
 
-      output << "     </p>" << endl;
-      i++;
+    if(p->RescatterCode() != -1) {
+      output << "        ";
+      output << " <rescatter> " << p->RescatterCode()   << " </rescatter>";
+      output << endl;       
     }
-    output << "  </ghep>" << endl;
 
-    mcrec->Clear();
-  } // event loop
+    output << "     </p>" << endl;
+    i++;
+  }
+  output << "  </ghep>" << endl;
 
+}
+//____________________________________________________________________________________
+void GNtpcGXMLConverter::End(TFile & /*fin*/, TTree * /*gtree*/)
+{
   //-- add required footer
-  output << endl << endl;
-  output << "<genie_event_list version=\"1.00\">";
+  if(gIsLastChunk) {
+    output << endl << endl;
+    output << "<genie_event_list version=\"1.00\">";
+  }
 
   output.close();
-  fin.Close();
 
   LOG("gntpc", pINFO) << "\nDone converting GENIE's GHEP ntuple";
 }
 //____________________________________________________________________________________
 // GENIE GHEP FORMAT -> GHEP MOCK DATA FORMAT
 //____________________________________________________________________________________
-void ConvertToGHepMock(void)
+class GNtpcGHepMockConverter : public GNtpcConverter
 {
-  //-- open the ROOT file and get the TTree & its header
-  TFile fin(gOptInpFileName.c_str(),"READ");
-  TTree *           tree = 0;
-  NtpMCTreeHeader * thdr = 0;
-  tree = dynamic_cast <TTree *>           ( fin.Get("gtree")  );
-  thdr = dynamic_cast <NtpMCTreeHeader *> ( fin.Get("header") );
-        
-  LOG("gntpc", pINFO) << "Input tree header: " << *thdr;
-   
-  //-- get mc record
-  NtpMCEventRecord * mcrec = 0;
-  tree->SetBranchAddress("gmcrec", &mcrec);
-        
-  //-- figure out how many events to analyze
-  Long64_t nmax = (gOptN<0) ?
-       tree->GetEntries() : TMath::Min(tree->GetEntries(), gOptN);
-  if (nmax<0) {
-    LOG("gntpc", pERROR) << "Number of events = 0";
-    return;
-  }
-  LOG("gntpc", pNOTICE) << "*** Analyzing: " << nmax << " events";
-
-  //-- initialize an Ntuple Writer
-  NtpWriter ntpw(kNFGHEP, thdr->runnu);
-  ntpw.CustomizeFilename(gOptOutFileName);
-  ntpw.Initialize();
-
-  //-- event loop
-  for(Long64_t iev = 0; iev < nmax; iev++) {
-    tree->GetEntry(iev);
-    NtpMCRecHeader rec_header = mcrec->hdr;
-    EventRecord &  event      = *(mcrec->event);
-
-    LOG("gntpc", pINFO) << rec_header;
-    LOG("gntpc", pINFO) << event;
-
-    EventRecord * stripped_event = new EventRecord;
-    Interaction * nullint = new Interaction;
+public:
+  GNtpcGHepMockConverter(GNtpcFmt_t fmt, string filename, int vrs) :
+    GNtpcConverter(fmt, filename, vrs) { }
 
-    stripped_event -> AttachSummary (nullint);
-    stripped_event -> SetWeight     (event.Weight());
-    stripped_event -> SetVertex     (*event.Vertex());
-
-    GHepParticle * p = 0;
-    TIter iter(&event);
-    while( (p = (GHepParticle *)iter.Next()) ) {
-       if(!p) continue;
-       GHepStatus_t ist = p->Status();
-       if(ist!=kIStStableFinalState) continue;
-       stripped_event->AddParticle(
-          p->Pdg(), ist, -1,-1,-1,-1, *p->P4(), *p->X4());
-    }//p
-
-    ntpw.AddEventRecord(iev,stripped_event);
-
-    mcrec->Clear();
-  } // event loop
+  void Begin   (TFile & fin, TTree * gtree, NtpMCTreeHeader * thdr);
+  void Convert (Long64_t iev, NtpMCEventRecord * mcrec);
+  void End     (TFile & fin, TTree * gtree);
 
+private:
+  NtpWriter * ntpw;  // output ntuple writer
+};
+//____________________________________________________________________________________
+void GNtpcGHepMockConverter::Begin(TFile & /*fin*/, TTree * /*gtree*/, NtpMCTreeHeader * thdr)
+{
+  //-- initialize an Ntuple Writer
+  ntpw = new NtpWriter(kNFGHEP, thdr->runnu);
+  ntpw->CustomizeFilename(fOutFileName);
+  ntpw->Initialize();
+}
+//____________________________________________________________________________________
+void GNtpcGHepMockConverter::Convert(Long64_t iev, NtpMCEventRecord * mcrec)
+{
+  NtpMCRecHeader rec_header = mcrec->hdr;
+  EventRecord &  event      = *(mcrec->event);
+
+  LOG("gntpc", pINFO) << rec_header;
+  LOG("gntpc", pINFO) << event;
+
+  EventRecord * stripped_event = new EventRecord;
+  Interaction * nullint = new Interaction;
+
+  stripped_event -> AttachSummary (nullint);
+  stripped_event -> SetWeight     (event.Weight());
+  stripped_event -> SetVertex     (*event.Vertex());
+
+  GHepParticle * p = 0;
+  TIter iter(&event);
+  while( (p = (GHepParticle *)iter.Next()) ) {
+     if(!p) continue;
+     GHepStatus_t ist = p->Status();
+     if(ist!=kIStStableFinalState) continue;
+     stripped_event->AddParticle(
+        p->Pdg(), ist, -1,-1,-1,-1, *p->P4(), *p->X4());
+  }//p
+
+  ntpw->AddEventRecord(iev,stripped_event);
+}
+//____________________________________________________________________________________
+void GNtpcGHepMockConverter::End(TFile & /*fin*/, TTree * /*gtree*/)
+{
   //-- save the generated MC events
-  ntpw.Save();
+  ntpw->Save();
+  delete ntpw;
 
-  //-- rename the output file
-      
-  fin.Close();
-      
   LOG("gntpc", pINFO) << "\nDone converting GENIE's GHEP ntuple";
 }
 //____________________________________________________________________________________
 // GENIE GHEP EVENT TREE FORMAT -> TRACKER FORMATS
 //____________________________________________________________________________________
-void ConvertToGTracker(void)
+class GNtpcGTrackerConverter : public GNtpcConverter
 {
-  //-- open the ROOT file and get the TTree & its header
-  TFile fin(gOptInpFileName.c_str(),"READ");
-  TTree *           tree = 0;
-  NtpMCTreeHeader * thdr = 0;
-  tree = dynamic_cast <TTree *>           ( fin.Get("gtree")  );
-  thdr = dynamic_cast <NtpMCTreeHeader *> ( fin.Get("header") );
-
-  LOG("gntpc", pINFO) << "Input tree header: " << *thdr;
-
-  gFileMajorVrs = utils::system::GenieMajorVrsNum(thdr->cvstag.GetString().Data());
-  gFileMinorVrs = utils::system::GenieMinorVrsNum(thdr->cvstag.GetString().Data());
-  gFileRevisVrs = utils::system::GenieRevisVrsNum(thdr->cvstag.GetString().Data());
+public:
+  GNtpcGTrackerConverter(GNtpcFmt_t fmt, string filename, int vrs) :
+    GNtpcConverter(fmt, filename, vrs) { }
 
-  //-- get mc record
-  NtpMCEventRecord * mcrec = 0;
-  tree->SetBranchAddress("gmcrec", &mcrec);
+  void Begin   (TFile & fin, TTree * gtree, NtpMCTreeHeader * thdr);
+  void Convert (Long64_t iev, NtpMCEventRecord * mcrec);
+  void End     (TFile & fin, TTree * gtree);
 
+private:
 #ifdef __GENIE_FLUX_DRIVERS_ENABLED__
-  flux::GJPARCNuFluxPassThroughInfo * flux_info = 0;
-  tree->SetBranchAddress("flux", &flux_info);
+  flux::GJPARCNuFluxPassThroughInfo * flux_info;  // flux pass-through info
+#endif
+  ofstream output;  // output stream
+};
+//____________________________________________________________________________________
+void GNtpcGTrackerConverter::Begin(TFile & /*fin*/, TTree * tree, NtpMCTreeHeader * /*thdr*/)
+{
+#ifdef __GENIE_FLUX_DRIVERS_ENABLED__
+  flux_info = 0;
+  SetFluxBranchAddress(tree, &flux_info);
 #else
   LOG("gntpc", pWARN) 
     << "\n Flux drivers are not enabled." 
@@ -1397,200 +1394,191 @@ void ConvertToGTracker(void)
 #endif
 
   //-- open the output stream
-  ofstream output(gOptOutFileName.c_str(), ios::out);
-
-  //-- figure out how many events to analyze
-  Long64_t nmax = (gOptN<0) ? 
-       tree->GetEntries() : TMath::Min(tree->GetEntries(), gOptN);
-  if (nmax<0) {
-    LOG("gntpc", pERROR) << "Number of events = 0";
-    return;
-  }
-  LOG("gntpc", pNOTICE) << "*** Analyzing: " << nmax << " events";
+  output.open(fOutFileName.c_str(), ios::out);
+}
+//____________________________________________________________________________________
+void GNtpcGTrackerConverter::Convert(Long64_t iev, NtpMCEventRecord * mcrec)
+{
+  NtpMCRecHeader rec_header = mcrec->hdr;
+  EventRecord &  event      = *(mcrec->event);
+  Interaction * interaction = event.Summary();
 
-  //-- event loop
-  for(Long64_t iev = 0; iev < nmax; iev++) {
-    tree->GetEntry(iev);
-    NtpMCRecHeader rec_header = mcrec->hdr;
-    EventRecord &  event      = *(mcrec->event);
-    Interaction * interaction = event.Summary();
+  LOG("gntpc", pINFO) << rec_header;
+  LOG("gntpc", pINFO) << event;
 
-    LOG("gntpc", pINFO) << rec_header;
-    LOG("gntpc", pINFO) << event;
+  GHepParticle * p = 0;
+  TIter event_iter(&event);
+  int iparticle = -1;
 
-    GHepParticle * p = 0;
-    TIter event_iter(&event);
-    int iparticle = -1;
+  // **** Convert the current event:
 
-    // **** Convert the current event:
+  //
+  // -- Add tracker begin tag
+  //
+  output << "$ begin" << endl;
 
-    //
-    // -- Add tracker begin tag
-    //
-    output << "$ begin" << endl;
+  //
+  // -- Add the appropriate reaction code
+  //
 
-    //
-    // -- Add the appropriate reaction code
-    //
+  // add 'NEUT'-like event type
+  if(fFormat == kConvFmt_t2k_tracker) {
+  	int evtype = utils::ghep::NeutReactionCode(&event);
+      LOG("gntpc", pNOTICE) << "NEUT-like event type = " << evtype;
+  	output << "$ genie " << evtype << endl;
+  } //neut code
+
+  // add 'NUANCE'-like event type
+  else if(fFormat == kConvFmt_nuance_tracker) {
+  	int evtype = utils::ghep::NuanceReactionCode(&event);
+      LOG("gntpc", pNOTICE) << "NUANCE-like event type = " << evtype;
+  	output << "$ nuance " << evtype << endl;
+  } // nuance code
+
+  else {
+      gAbortingInErr = true;
+      exit(1);
+  }
 
-    // add 'NEUT'-like event type
-    if(gOptOutFileFormat == kConvFmt_t2k_tracker) {
-    	int evtype = utils::ghep::NeutReactionCode(&event);
-        LOG("gntpc", pNOTICE) << "NEUT-like event type = " << evtype;
-    	output << "$ genie " << evtype << endl;
-    } //neut code
+  //
+  // -- Add '$vertex' line
+  //
+  output << "$ vertex " 
+         << event.Vertex()->X() << " "
+         << event.Vertex()->Y() << " "
+         << event.Vertex()->Z() << " "
+         << event.Vertex()->T() << endl;
 
-    // add 'NUANCE'-like event type
-    else if(gOptOutFileFormat == kConvFmt_nuance_tracker) {
-    	int evtype = utils::ghep::NuanceReactionCode(&event);
-        LOG("gntpc", pNOTICE) << "NUANCE-like event type = " << evtype;
-    	output << "$ nuance " << evtype << endl;
-    } // nuance code
+  //
+  // -- Add '$track' lines
+  //
 
-    else {
-        gAbortingInErr = true;
-        exit(1);
-    }
+  // Loop over the generated GHEP particles and decide which ones 
+  // to write-out in $track lines
+  vector<int> tracks;
 
-    //
-    // -- Add '$vertex' line
-    //
-    output << "$ vertex " 
-           << event.Vertex()->X() << " "
-           << event.Vertex()->Y() << " "
-           << event.Vertex()->Z() << " "
-           << event.Vertex()->T() << endl;
+  event_iter.Reset();
+  iparticle = -1;
+  while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) 
+  {
+     iparticle++;
+
+     int          ghep_pdgc   = p->Pdg();
+     GHepStatus_t ghep_ist    = (GHepStatus_t) p->Status();
+
+     // Neglect all GENIE pseudo-particles
+     if(pdg::IsPseudoParticle(ghep_pdgc)) continue;
+
+     //  
+     // Keep 'initial state', 'nucleon target', 'hadron in the nucleus' and 'final state' particles.
+     // Neglect pi0 decays if they were performed within GENIE (write out the decayed pi0 and neglect 
+     // the {gamma + gamma} or {gamma + e- + e+} final state
+     //
+
+     // is pi0 decay?
+     bool is_pi0_dec = false;
+     if(ghep_ist == kIStDecayedState && ghep_pdgc == kPdgPi0) {
+       vector<int> pi0dv; // daughters vector
+       int ghep_fd = p->FirstDaughter();
+       int ghep_ld = p->LastDaughter();
+       for(int jd = ghep_fd; jd <= ghep_ld; jd++) {
+         if(jd!=-1) {
+            pi0dv.push_back(event.Particle(jd)->Pdg());
+         }
+       }
+       sort(pi0dv.begin(), pi0dv.end());
+       is_pi0_dec = (pi0dv.size()==2 && pi0dv[0]==kPdgGamma && pi0dv[1]==kPdgGamma) ||
+                    (pi0dv.size()==3 && pi0dv[0]==kPdgPositron && pi0dv[1]==kPdgElectron && pi0dv[2]==kPdgGamma);
+     }
 
-    //
-    // -- Add '$track' lines
-    //
+     // is pi0 decay product?
+     int ghep_fm     = p->FirstMother();
+     int ghep_fmpdgc = (ghep_fm==-1) ? 0 : event.Particle(ghep_fm)->Pdg();
+     bool is_pi0_dpro = (ghep_pdgc == kPdgGamma    && ghep_fmpdgc == kPdgPi0) ||
+                        (ghep_pdgc == kPdgElectron && ghep_fmpdgc == kPdgPi0) ||
+                        (ghep_pdgc == kPdgPositron && ghep_fmpdgc == kPdgPi0);
+
+     bool keep = (ghep_ist == kIStInitialState)       ||
+                 (ghep_ist == kIStNucleonTarget)      ||
+                 (ghep_ist == kIStHadronInTheNucleus) ||
+                 (ghep_ist == kIStDecayedState     &&  is_pi0_dec ) ||
+                 (ghep_ist == kIStStableFinalState && !is_pi0_dpro);
+     if(!keep) continue;
+
+     // Apparently SKDETSIM chokes with O16 - Neglect the nuclear target in this case
+     //
+     if (fFormat == kConvFmt_t2k_tracker && pdg::IsIon(p->Pdg())) continue;
+
+     tracks.push_back(iparticle);
+  }
 
-    // Loop over the generated GHEP particles and decide which ones 
-    // to write-out in $track lines
-    vector<int> tracks;
+  //bool info_added  = false;
 
-    event_iter.Reset();
-    iparticle = -1;
-    while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) 
+  // Looping twice to ensure that all final state particle are grouped together.
+  // On the second loop add only f/s particles. On the first loop add all but f/s particles
+  for(int iloop=0; iloop<=1; iloop++) 
+  {
+    for(vector<int>::const_iterator ip = tracks.begin(); ip != tracks.end(); ++ip) 
     {
-       iparticle++;
-
-       int          ghep_pdgc   = p->Pdg();
-       GHepStatus_t ghep_ist    = (GHepStatus_t) p->Status();
+       iparticle = *ip;
+       p = event.Particle(iparticle);
 
-       // Neglect all GENIE pseudo-particles
-       if(pdg::IsPseudoParticle(ghep_pdgc)) continue;
+       int ghep_pdgc = p->Pdg();
+       GHepStatus_t ghep_ist = (GHepStatus_t) p->Status();
 
-       //  
-       // Keep 'initial state', 'nucleon target', 'hadron in the nucleus' and 'final state' particles.
-       // Neglect pi0 decays if they were performed within GENIE (write out the decayed pi0 and neglect 
-       // the {gamma + gamma} or {gamma + e- + e+} final state
-       //
+       bool fs = (ghep_ist==kIStStableFinalState) || 
+                 (ghep_ist==kIStDecayedState && ghep_pdgc==kPdgPi0);
 
-       // is pi0 decay?
-       bool is_pi0_dec = false;
-       if(ghep_ist == kIStDecayedState && ghep_pdgc == kPdgPi0) {
-         vector<int> pi0dv; // daughters vector
-         int ghep_fd = p->FirstDaughter();
-         int ghep_ld = p->LastDaughter();
-         for(int jd = ghep_fd; jd <= ghep_ld; jd++) {
-           if(jd!=-1) {
-              pi0dv.push_back(event.Particle(jd)->Pdg());
-           }
-         }
-         sort(pi0dv.begin(), pi0dv.end());
-         is_pi0_dec = (pi0dv.size()==2 && pi0dv[0]==kPdgGamma && pi0dv[1]==kPdgGamma) ||
-                      (pi0dv.size()==3 && pi0dv[0]==kPdgPositron && pi0dv[1]==kPdgElectron && pi0dv[2]==kPdgGamma);
-       }
+       if(iloop==0 &&  fs) continue;
+       if(iloop==1 && !fs) continue;
 
-       // is pi0 decay product?
-       int ghep_fm     = p->FirstMother();
-       int ghep_fmpdgc = (ghep_fm==-1) ? 0 : event.Particle(ghep_fm)->Pdg();
-       bool is_pi0_dpro = (ghep_pdgc == kPdgGamma    && ghep_fmpdgc == kPdgPi0) ||
-                          (ghep_pdgc == kPdgElectron && ghep_fmpdgc == kPdgPi0) ||
-                          (ghep_pdgc == kPdgPositron && ghep_fmpdgc == kPdgPi0);
-
-       bool keep = (ghep_ist == kIStInitialState)       ||
-                   (ghep_ist == kIStNucleonTarget)      ||
-                   (ghep_ist == kIStHadronInTheNucleus) ||
-                   (ghep_ist == kIStDecayedState     &&  is_pi0_dec ) ||
-                   (ghep_ist == kIStStableFinalState && !is_pi0_dpro);
-       if(!keep) continue;
-
-       // Apparently SKDETSIM chokes with O16 - Neglect the nuclear target in this case
+       // Convert GENIE's GHEP pdgc & status to NUANCE's equivalent
        //
-       if (gOptOutFileFormat == kConvFmt_t2k_tracker && pdg::IsIon(p->Pdg())) continue;
-
-       tracks.push_back(iparticle);
-    }
-
-    //bool info_added  = false;
-
-    // Looping twice to ensure that all final state particle are grouped together.
-    // On the second loop add only f/s particles. On the first loop add all but f/s particles
-    for(int iloop=0; iloop<=1; iloop++) 
-    {
-      for(vector<int>::const_iterator ip = tracks.begin(); ip != tracks.end(); ++ip) 
-      {
-         iparticle = *ip;
-         p = event.Particle(iparticle);
-
-         int ghep_pdgc = p->Pdg();
-         GHepStatus_t ghep_ist = (GHepStatus_t) p->Status();
-
-         bool fs = (ghep_ist==kIStStableFinalState) || 
-                   (ghep_ist==kIStDecayedState && ghep_pdgc==kPdgPi0);
-
-         if(iloop==0 &&  fs) continue;
-         if(iloop==1 && !fs) continue;
-
-         // Convert GENIE's GHEP pdgc & status to NUANCE's equivalent
-         //
-         int ist;
-         switch (ghep_ist) {
-           case kIStInitialState:             ist = -1;                              break;
-           case kIStStableFinalState:         ist =  0;                              break;
-           case kIStIntermediateState:        ist = -2;                              break;
-           case kIStDecayedState:             ist = (ghep_pdgc==kPdgPi0) ? 0 : -2;   break;
-           case kIStNucleonTarget:            ist = -1;                              break;
-           case kIStDISPreFragmHadronicState: ist = -999;                            break;
-           case kIStPreDecayResonantState:    ist = -999;                            break;
-           case kIStHadronInTheNucleus:       ist = -2;                              break;
-           case kIStUndefined:                ist = -999;                            break;
-           default:                           ist = -999;                            break;
-         }
-         // Convert GENIE pdg code -> nuance PDG code
-         // For most particles both generators use the standard PDG codes.
-         // For nuclei GENIE follows the PDG-convention: 10LZZZAAAI
-         // NUANCE is using: ZZZAAA
-         int pdgc = ghep_pdgc;
-         if ( pdg::IsIon(p->Pdg()) ) {
-           int Z = pdg::IonPdgCodeToZ(ghep_pdgc);
-           int A = pdg::IonPdgCodeToA(ghep_pdgc);
-           pdgc = 1000*Z + A;
-         }
+       int ist;
+       switch (ghep_ist) {
+         case kIStInitialState:             ist = -1;                              break;
+         case kIStStableFinalState:         ist =  0;                              break;
+         case kIStIntermediateState:        ist = -2;                              break;
+         case kIStDecayedState:             ist = (ghep_pdgc==kPdgPi0) ? 0 : -2;   break;
+         case kIStNucleonTarget:            ist = -1;                              break;
+         case kIStDISPreFragmHadronicState: ist = -999;                            break;
+         case kIStPreDecayResonantState:    ist = -999;                            break;
+         case kIStHadronInTheNucleus:       ist = -2;                              break;
+         case kIStUndefined:                ist = -999;                            break;
+         default:                           ist = -999;                            break;
+       }
+       // Convert GENIE pdg code -> nuance PDG code
+       // For most particles both generators use the standard PDG codes.
+       // For nuclei GENIE follows the PDG-convention: 10LZZZAAAI
+       // NUANCE is using: ZZZAAA
+       int pdgc = ghep_pdgc;
+       if ( pdg::IsIon(p->Pdg()) ) {
+         int Z = pdg::IonPdgCodeToZ(ghep_pdgc);
+         int A = pdg::IonPdgCodeToA(ghep_pdgc);
+         pdgc = 1000*Z + A;
+       }
 
-         // The SK detector MC expects K0_Long, K0_Short - not K0, \bar{K0}
-         // Do the conversion here:
-         if(gOptOutFileFormat == kConvFmt_t2k_tracker) {
-           if(pdgc==kPdgK0 || pdgc==kPdgAntiK0) {
-              RandomGen * rnd = RandomGen::Instance();
-              double R =  rnd->RndGen().Rndm();
-              if(R>0.5) pdgc = kPdgK0L;
-              else      pdgc = kPdgK0S;
-           }
+       // The SK detector MC expects K0_Long, K0_Short - not K0, \bar{K0}
+       // Do the conversion here:
+       if(fFormat == kConvFmt_t2k_tracker) {
+         if(pdgc==kPdgK0 || pdgc==kPdgAntiK0) {
+            RandomGen * rnd = RandomGen::Instance();
+            double R =  rnd->RndGen().Rndm();
+            if(R>0.5) pdgc = kPdgK0L;
+            else      pdgc = kPdgK0S;
          }
-         // Get particle's energy & momentum
-         const TLorentzVector * p4 = p->P4();
-         double E  = p4->Energy() / units::MeV;
-         double Px = p4->Px()     / units::MeV;
-         double Py = p4->Py()     / units::MeV;
-         double Pz = p4->Pz()     / units::MeV;
-         double P  = p4->P()      / units::MeV;
-         // Compute direction cosines
-         double dcosx = (P>0) ? Px/P : -999;
-         double dcosy = (P>0) ? Py/P : -999;
-         double dcosz = (P>0) ? Pz/P : -999;
+       }
+       // Get particle's energy & momentum
+       const TLorentzVector * p4 = p->P4();
+       double E  = p4->Energy() / units::MeV;
+       double Px = p4->Px()     / units::MeV;
+       double Py = p4->Py()     / units::MeV;
+       double Pz = p4->Pz()     / units::MeV;
+       double P  = p4->P()      / units::MeV;
+       // Compute direction cosines
+       double dcosx = (P>0) ? Px/P : -999;
+       double dcosy = (P>0) ? Py/P : -999;
+       double dcosz = (P>0) ? Pz/P : -999;
 
 // <obsolte/>
 //         GHepStatus_t gist = (GHepStatus_t) p->Status();
@@ -1605,153 +1593,153 @@ void ConvertToGTracker(void)
 //         }
 // </obsolte>
 
-         LOG("gntpc", pNOTICE) 
-           << "Adding $track corrsponding to GHEP particle at position: " << iparticle
-           << " (tracker status code: " << ist << ")";
+       LOG("gntpc", pNOTICE) 
+         << "Adding $track corrsponding to GHEP particle at position: " << iparticle
+         << " (tracker status code: " << ist << ")";
 
-         output << "$ track " << pdgc << " " << E << " "
-                << dcosx << " " << dcosy << " " << dcosz << " "
-                << ist << endl;
+       output << "$ track " << pdgc << " " << E << " "
+              << dcosx << " " << dcosy << " " << dcosz << " "
+              << ist << endl;
 
-      }//tracks
-    }//iloop
+    }//tracks
+  }//iloop
 
+  //
+  // -- Add $info lines as necessary
+  //
+
+  if(fFormat == kConvFmt_t2k_tracker) {
+    //
+    // Writing $info lines with information identical to the one saved at the rootracker-format 
+    // files for the nd280MC. SKDETSIM can propagate all that complete MC truth information into 
+    // friend event trees that can be 'linked' with the SK DSTs.
+    // Having identical generator info for both SK and nd280 will enable global studies
+    //
+    // The $info lines are formatted as follows:
+    //
+    // version 1: 
+    //
+    // $ info event_num err_flag string_event_code
+    // $ info xsec_event diff_xsec_kinematics weight prob
+    // $ info vtxx vtxy vtxz vtxt
+    // $ info nparticles
+    // $ info 0 pdg_code status_code first_daughter last_daughter first_mother last_mother px py pz E x y z t polx poly polz 
+    // $ info 1 pdg_code status_code first_daughter last_daughter first_mother last_mother px py pz E x y z t polx poly polz 
+    // ... ... ...
+    // $ info n pdg_code status_code first_daughter last_daughter first_mother last_mother px py pz E x y z t polx poly polz 
+    //
+    // version 2:
+    //
+    // $ info event_num err_flag string_event_code
+    // $ info xsec_event diff_xsec_kinematics weight prob
+    // $ info vtxx vtxy vtxz vtxt
+    // $ info etc
+    // $ info nparticles
+    // $ info 0 pdg_code status_code first_daughter last_daughter first_mother last_mother px py pz E x y z t polx poly polz rescatter_code
+    // $ info 1 pdg_code status_code first_daughter last_daughter first_mother last_mother px py pz E x y z t polx poly polz rescatter_code
+    // ... ... ...
+    // $ info n pdg_code status_code first_daughter last_daughter first_mother last_mother px py pz E x y z t polx poly polz rescatter_code
     //
-    // -- Add $info lines as necessary
+    // Comments:
+    // - The err_flag is a bit field (16 bits)
+    // - The string_event_code is a rather long string which encapsulates lot of summary info on the event
+    //   (neutrino/nuclear target/hit nucleon/hit quark(if any)/process type/...).
+    //   Information on how to parse that string code is available at the T2K event reweighting package.
+    // - event_xsec is the event cross section in 1E-38cm^2
+    // - diff_event_xsec is the cross section for the selected in 1E-38cm^2/{K^n}
+    // - weight is the event weight (1 for unweighted MC)
+    // - prob is the event probability (given cross sectios and density-weighted path-length)
+    // - vtxx,y,z,t is the vertex position/time in SI units 
+    // - etc (added in format vrs >= 2) is used to pass any additional information with event-scope. 
+    //   For the time being it is being used to pass the hit quark id (for DIS events) that was lost before 
+    //   as SKDETSIM doesn't read the string_event_code where this info is nominally contained.
+    //   The quark id is set as (quark_pdg_code) x 10 + i, where i=0 for valence and i=1 for sea quarks. Set to -1 for non-DIS events.
+    // - nparticles is the number of particles in the GHEP record (number of $info lines to follow before the start of the JNUBEAM block)
+    // - first_/last_daughter first_/last_mother indicate the particle
+    // - px,py,pz,E is the particle 4-momentum at the LAB frame (in GeV)
+    // - x,y,z,t is the particle 4-position at the hit nucleus coordinate system (in fm, t is not set)
+    // - polx,y,z is the particle polarization vector
+    // - rescatter_code (added in format vrs >= 2) is a model-dependent intranuclear rescattering code
+    //   added to simplify the event analysis (although, in principle, it is recoverable from the particle record).
+    //   See $GENIE/src/HadronTransport/INukeHadroFates.h for the meaning of various codes when INTRANUKE is in use.
+    //   The rescattering code is stored at the GHEP event record for files generated with GENIE vrs >= 2.5.1.
+    // See also ConvertToGRooTracker() for further descriptions of the variables stored at
+    // the rootracker files.
     //
+    // event info
+    //
+    output << "$ info " << (int) iev << " " << *(event.EventFlags()) << " " << interaction->AsString() << endl;
+    output << "$ info " << (1E+38/units::cm2) * event.XSec() << " "
+                        << (1E+38/units::cm2) * event.DiffXSec() << " "  
+                        << event.Weight() << " "
+                        << event.Probability()
+                        << endl;
+    output << "$ info " << event.Vertex()->X() << " "
+                        << event.Vertex()->Y() << " "
+                        << event.Vertex()->Z() << " "
+                        << event.Vertex()->T() 
+                        << endl;
+
+    // insert etc info line for format versions >= 2
+    if(fVersion >= 2) {
+       int quark_id = -1;
+       if( interaction->ProcInfo().IsDeepInelastic() && interaction->InitState().Tgt().HitQrkIsSet() ) {
+          int quark_pdg = interaction->InitState().Tgt().HitQrkPdg();
+          int sorv      = ( interaction->InitState().Tgt().HitSeaQrk() ) ? 1 : 0; // sea q: 1, valence q: 0
+          quark_id = 10 * quark_pdg + sorv;
+       }
+       output << "$ info " << quark_id << endl;
+    }
 
-    if(gOptOutFileFormat == kConvFmt_t2k_tracker) {
-      //
-      // Writing $info lines with information identical to the one saved at the rootracker-format 
-      // files for the nd280MC. SKDETSIM can propagate all that complete MC truth information into 
-      // friend event trees that can be 'linked' with the SK DSTs.
-      // Having identical generator info for both SK and nd280 will enable global studies
-      //
-      // The $info lines are formatted as follows:
-      //
-      // version 1: 
-      //
-      // $ info event_num err_flag string_event_code
-      // $ info xsec_event diff_xsec_kinematics weight prob
-      // $ info vtxx vtxy vtxz vtxt
-      // $ info nparticles
-      // $ info 0 pdg_code status_code first_daughter last_daughter first_mother last_mother px py pz E x y z t polx poly polz 
-      // $ info 1 pdg_code status_code first_daughter last_daughter first_mother last_mother px py pz E x y z t polx poly polz 
-      // ... ... ...
-      // $ info n pdg_code status_code first_daughter last_daughter first_mother last_mother px py pz E x y z t polx poly polz 
-      //
-      // version 2:
-      //
-      // $ info event_num err_flag string_event_code
-      // $ info xsec_event diff_xsec_kinematics weight prob
-      // $ info vtxx vtxy vtxz vtxt
-      // $ info etc
-      // $ info nparticles
-      // $ info 0 pdg_code status_code first_daughter last_daughter first_mother last_mother px py pz E x y z t polx poly polz rescatter_code
-      // $ info 1 pdg_code status_code first_daughter last_daughter first_mother last_mother px py pz E x y z t polx poly polz rescatter_code
-      // ... ... ...
-      // $ info n pdg_code status_code first_daughter last_daughter first_mother last_mother px py pz E x y z t polx poly polz rescatter_code
-      //
-      // Comments:
-      // - The err_flag is a bit field (16 bits)
-      // - The string_event_code is a rather long string which encapsulates lot of summary info on the event
-      //   (neutrino/nuclear target/hit nucleon/hit quark(if any)/process type/...).
-      //   Information on how to parse that string code is available at the T2K event reweighting package.
-      // - event_xsec is the event cross section in 1E-38cm^2
-      // - diff_event_xsec is the cross section for the selected in 1E-38cm^2/{K^n}
-      // - weight is the event weight (1 for unweighted MC)
-      // - prob is the event probability (given cross sectios and density-weighted path-length)
-      // - vtxx,y,z,t is the vertex position/time in SI units 
-      // - etc (added in format vrs >= 2) is used to pass any additional information with event-scope. 
-      //   For the time being it is being used to pass the hit quark id (for DIS events) that was lost before 
-      //   as SKDETSIM doesn't read the string_event_code where this info is nominally contained.
-      //   The quark id is set as (quark_pdg_code) x 10 + i, where i=0 for valence and i=1 for sea quarks. Set to -1 for non-DIS events.
-      // - nparticles is the number of particles in the GHEP record (number of $info lines to follow before the start of the JNUBEAM block)
-      // - first_/last_daughter first_/last_mother indicate the particle
-      // - px,py,pz,E is the particle 4-momentum at the LAB frame (in GeV)
-      // - x,y,z,t is the particle 4-position at the hit nucleus coordinate system (in fm, t is not set)
-      // - polx,y,z is the particle polarization vector
-      // - rescatter_code (added in format vrs >= 2) is a model-dependent intranuclear rescattering code
-      //   added to simplify the event analysis (although, in principle, it is recoverable from the particle record).
-      //   See $GENIE/src/HadronTransport/INukeHadroFates.h for the meaning of various codes when INTRANUKE is in use.
-      //   The rescattering code is stored at the GHEP event record for files generated with GENIE vrs >= 2.5.1.
-      // See also ConvertToGRooTracker() for further descriptions of the variables stored at
-      // the rootracker files.
-      //
-      // event info
-      //
-      output << "$ info " << (int) iev << " " << *(event.EventFlags()) << " " << interaction->AsString() << endl;
-      output << "$ info " << (1E+38/units::cm2) * event.XSec() << " "
-                          << (1E+38/units::cm2) * event.DiffXSec() << " "  
-                          << event.Weight() << " "
-                          << event.Probability()
-                          << endl;
-      output << "$ info " << event.Vertex()->X() << " "
-                          << event.Vertex()->Y() << " "
-                          << event.Vertex()->Z() << " "
-                          << event.Vertex()->T() 
-                          << endl;
-
-      // insert etc info line for format versions >= 2
-      if(gOptVersion >= 2) {
-         int quark_id = -1;
-         if( interaction->ProcInfo().IsDeepInelastic() && interaction->InitState().Tgt().HitQrkIsSet() ) {
-            int quark_pdg = interaction->InitState().Tgt().HitQrkPdg();
-            int sorv      = ( interaction->InitState().Tgt().HitSeaQrk() ) ? 1 : 0; // sea q: 1, valence q: 0
-            quark_id = 10 * quark_pdg + sorv;
-         }
-         output << "$ info " << quark_id << endl;
+    //
+    // copy stdhep-like particle list
+    //
+    iparticle = 0;
+    event_iter.Reset();
+    output << "$ info " << event.GetEntries() << endl;
+    while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) 
+    {
+      assert(p);
+      output << "$ info " 
+             << iparticle << " " 
+             << p->Pdg() << " " << (int) p->Status() << " "
+             << p->FirstDaughter() << " " << p->LastDaughter() << " " 
+             << p->FirstMother() << " " << p->LastMother() << " "
+             << p->X4()->X()  << " " << p->X4()->Y()  << " " << p->X4()->Z()  << " " << p->X4()->T() << " "
+             << p->P4()->Px() << " " << p->P4()->Py() << " " << p->P4()->Pz() << " " << p->P4()->E() << " ";
+      if(p->PolzIsSet()) {
+          output << TMath::Sin(p->PolzPolarAngle()) * TMath::Cos(p->PolzAzimuthAngle()) << " "
+                 << TMath::Sin(p->PolzPolarAngle()) * TMath::Sin(p->PolzAzimuthAngle()) << " "
+                 << TMath::Cos(p->PolzPolarAngle());
+      } else {
+          output << "0. 0. 0.";
       }
 
-      //
-      // copy stdhep-like particle list
-      //
-      iparticle = 0;
-      event_iter.Reset();
-      output << "$ info " << event.GetEntries() << endl;
-      while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) 
-      {
-        assert(p);
-        output << "$ info " 
-               << iparticle << " " 
-               << p->Pdg() << " " << (int) p->Status() << " "
-               << p->FirstDaughter() << " " << p->LastDaughter() << " " 
-               << p->FirstMother() << " " << p->LastMother() << " "
-               << p->X4()->X()  << " " << p->X4()->Y()  << " " << p->X4()->Z()  << " " << p->X4()->T() << " "
-               << p->P4()->Px() << " " << p->P4()->Py() << " " << p->P4()->Pz() << " " << p->P4()->E() << " ";
-        if(p->PolzIsSet()) {
-            output << TMath::Sin(p->PolzPolarAngle()) * TMath::Cos(p->PolzAzimuthAngle()) << " "
-                   << TMath::Sin(p->PolzPolarAngle()) * TMath::Sin(p->PolzAzimuthAngle()) << " "
-                   << TMath::Cos(p->PolzPolarAngle());
-        } else {
-            output << "0. 0. 0.";
-        }
-
-        // append rescattering code for format versions >= 2 
-        if(gOptVersion >= 2) {
-           int rescat_code = -1;
-           bool have_rescat_code = false;
-           if(gFileMajorVrs >= 2) {
-             if(gFileMinorVrs >= 5) {
-                if(gFileRevisVrs >= 1) {
-                    have_rescat_code = true;
-                }
-             }
+      // append rescattering code for format versions >= 2 
+      if(fVersion >= 2) {
+         int rescat_code = -1;
+         bool have_rescat_code = false;
+         if(gFileMajorVrs >= 2) {
+           if(gFileMinorVrs >= 5) {
+              if(gFileRevisVrs >= 1) {
+                  have_rescat_code = true;
+              }
            }
-           if(have_rescat_code) {
-             rescat_code = p->RescatterCode();
-           }
-           output << " ";
-           output << rescat_code;
-        }
-
-        output << endl;
-        iparticle++;
+         }
+         if(have_rescat_code) {
+           rescat_code = p->RescatterCode();
+         }
+         output << " ";
+         output << rescat_code;
       }
-      //
-      // JNUBEAM flux info - this info will only be available if events were generated 
-      // by gT2Kevgen using JNUBEAM flux ntuples as inputs
-      //
+
+      output << endl;
+      iparticle++;
+    }
+    //
+    // JNUBEAM flux info - this info will only be available if events were generated 
+    // by gT2Kevgen using JNUBEAM flux ntuples as inputs
+    //
 /*
 The T2K/SK collaboration produces MC based on JNUBEAM flux histograms, not flux ntuples.
 Therefore JNUBEAM flux pass-through info is never available for generated events.
@@ -1761,67 +1749,77 @@ to the latest version of JNUBEAM and an appropriate updated t2k_tracker format n
 be agreed with the SKDETSIM maintainers.
 
 #ifdef __GENIE_FLUX_DRIVERS_ENABLED__
-      PDGLibrary * pdglib = PDGLibrary::Instance();
-      if(flux_info) {
-         // parent hadron pdg code and decay mode
-         output << "$ info " << pdg::GeantToPdg(flux_info->ppid) << " " << flux_info->mode << endl;
-         // parent hadron px,py,pz,E at decay
-         output << "$ info " << flux_info->ppi * flux_info->npi[0] << " " 
-                             << flux_info->ppi * flux_info->npi[1] << " " 
-                             << flux_info->ppi * flux_info->npi[2] << " " 
-                             << TMath::Sqrt(
-                                   TMath::Power(pdglib->Find(pdg::GeantToPdg(flux_info->ppid))->Mass(), 2.)
-                                 + TMath::Power(flux_info->ppi, 2.)
-                                )  << endl;
-         // parent hadron x,y,z,t at decay
-         output << "$ info " << flux_info->xpi[0] << " "
-                             << flux_info->xpi[1] << " "
-                             << flux_info->xpi[2] << " "
-                             << "0." 
-                             << endl;
-         // parent hadron px,py,pz,E at production
-         output << "$ info " << flux_info->ppi0 * flux_info->npi0[0] << " "
-                             << flux_info->ppi0 * flux_info->npi0[1] << " "
-                             << flux_info->ppi0 * flux_info->npi0[2] << " "
-                             << TMath::Sqrt(
-                                   TMath::Power(pdglib->Find(pdg::GeantToPdg(flux_info->ppid))->Mass(), 2.)
-                                 + TMath::Power(flux_info->ppi0, 2.)
-                                ) << endl;
-         // parent hadron x,y,z,t at production
-         output << "$ info " << flux_info->xpi0[0] << " "
-                             << flux_info->xpi0[1] << " "
-                             << flux_info->xpi0[2] << " "
-                             << "0." 
-                             << endl;
-         // nvtx
-         output << "$ info " << output << "$info " << endl;
-     }
+    PDGLibrary * pdglib = PDGLibrary::Instance();
+    if(flux_info) {
+       // parent hadron pdg code and decay mode
+       output << "$ info " << pdg::GeantToPdg(flux_info->ppid) << " " << flux_info->mode << endl;
+       // parent hadron px,py,pz,E at decay
+       output << "$ info " << flux_info->ppi * flux_info->npi[0] << " " 
+                           << flux_info->ppi * flux_info->npi[1] << " " 
+                           << flux_info->ppi * flux_info->npi[2] << " " 
+                           << TMath::Sqrt(
+                                 TMath::Power(pdglib->Find(pdg::GeantToPdg(flux_info->ppid))->Mass(), 2.)
+                               + TMath::Power(flux_info->ppi, 2.)
+                              )  << endl;
+       // parent hadron x,y,z,t at decay
+       output << "$ info " << flux_info->xpi[0] << " "
+                           << flux_info->xpi[1] << " "
+                           << flux_info->xpi[2] << " "
+                           << "0." 
+                           << endl;
+       // parent hadron px,py,pz,E at production
+       output << "$ info " << flux_info->ppi0 * flux_info->npi0[0] << " "
+                           << flux_info->ppi0 * flux_info->npi0[1] << " "
+                           << flux_info->ppi0 * flux_info->npi0[2] << " "
+                           << TMath::Sqrt(
+                                 TMath::Power(pdglib->Find(pdg::GeantToPdg(flux_info->ppid))->Mass(), 2.)
+                               + TMath::Power(flux_info->ppi0, 2.)
+                              ) << endl;
+       // parent hadron x,y,z,t at production
+       output << "$ info " << flux_info->xpi0[0] << " "
+                           << flux_info->xpi0[1] << " "
+                           << flux_info->xpi0[2] << " "
+                           << "0." 
+                           << endl;
+       // nvtx
+       output << "$ info " << output << "$info " << endl;
+   }
 #endif
 */
-    }//fmt==kConvFmt_t2k_tracker
-
-    //
-    // -- Add  tracker end tag
-    //
-    output << "$ end" << endl;
-
-    mcrec->Clear();
-  } // event loop
+  }//fmt==kConvFmt_t2k_tracker
 
+  //
+  // -- Add  tracker end tag
+  //
+  output << "$ end" << endl;
+}
+//____________________________________________________________________________________
+void GNtpcGTrackerConverter::End(TFile & /*fin*/, TTree * /*gtree*/)
+{
   // add tracker end-of-file tag
-  output << "$ stop" << endl;
+  if(gIsLastChunk) {
+    output << "$ stop" << endl;
+  }
 
   output.close();
-  fin.Close();
 
   LOG("gntpc", pINFO) << "\nDone converting GENIE's GHEP ntuple";
 }
 //____________________________________________________________________________________
 // GENIE GHEP EVENT TREE FORMAT -> ROOTRACKER FORMATS 
 //____________________________________________________________________________________
-void ConvertToGRooTracker(void)
+class GNtpcGRooTrackerConverter : public GNtpcConverter
 {
-  //-- define the output rootracker tree branches
+public:
+  GNtpcGRooTrackerConverter(GNtpcFmt_t fmt, string filename, int vrs) :
+    GNtpcConverter(fmt, filename, vrs) { }
+
+  void Begin   (TFile & fin, TTree * gtree, NtpMCTreeHeader * thdr);
+  void Convert (Long64_t iev, NtpMCEventRecord * mcrec);
+  void End     (TFile & fin, TTree * gtree);
+
+private:
+  //-- output rootracker tree branches
 
   // event info
 
@@ -1993,14 +1991,31 @@ void ConvertToGRooTracker(void)
   double     brNumiFluxBeampy;            // Primary proton momentum, Y - component
   double     brNumiFluxBeampz;            // Primary proton momentum, Z - component
 
+  TFile * fout;             // output file
+  TTree * rootracker_tree;  // output rootracker tree
+  bool    hide_truth;       // is it a `mock data' variance?
+
+#ifdef __GENIE_FLUX_DRIVERS_ENABLED__
+  flux::GJPARCNuFluxPassThroughInfo * jnubeam_flux_info;  // JNUBEAM pass-through info
+  flux::GNuMIFluxPassThroughInfo *    gnumi_flux_info;    // GNuMI pass-through info
+#ifdef __GENIE_HEAVY_NEUTRAL_LEPTON_ENABLED__
+  hnl::FluxContainer * gnumi_flux_ster;  // HNL flux info
+  double dVars[9];                       // HNL branch variables
+  int    iVars[4];                       //
+#endif // #ifdef __GENIE_HEAVY_NEUTRAL_LEPTON_ENABLED__
+#endif
+};
+//____________________________________________________________________________________
+void GNtpcGRooTrackerConverter::Begin(TFile & /*fin*/, TTree * gtree, NtpMCTreeHeader * /*thdr*/)
+{
   //-- open the output ROOT file
-  TFile fout(gOptOutFileName.c_str(), "RECREATE");
+  fout = new TFile(fOutFileName.c_str(), "RECREATE");
 
   //-- create the output ROOT tree
-  TTree * rootracker_tree = new TTree("gRooTracker","GENIE event tree rootracker format");
+  rootracker_tree = new TTree("gRooTracker","GENIE event tree rootracker format");
 
   //-- is it a `mock data' variance?
-  bool hide_truth = (gOptOutFileFormat == kConvFmt_rootracker_mock_data);
+  hide_truth = (fFormat == kConvFmt_rootracker_mock_data);
 
   //-- create the output ROOT tree branches
 
@@ -2039,7 +2054,7 @@ void ConvertToGRooTracker(void)
   }
 
   // extra branches of the t2k rootracker variance
-  if(gOptOutFileFormat == kConvFmt_t2k_rootracker) 
+  if(fFormat == kConvFmt_t2k_rootracker) 
   {
     // NEUT-like reaction code
     rootracker_tree->Branch("G2NeutEvtCode",   &brNeutCode,        "G2NeutEvtCode/I");   
@@ -2094,7 +2109,7 @@ void ConvertToGRooTracker(void)
   }
 
   // extra branches of the numi rootracker variance
-  if(gOptOutFileFormat == kConvFmt_numi_rootracker) 
+  if(fFormat == kConvFmt_numi_rootracker) 
   {
    // GNuMI pass-through info
    rootracker_tree->Branch("NumiFluxRun",      &brNumiFluxRun,       "NumiFluxRun/I");
@@ -2161,23 +2176,10 @@ void ConvertToGRooTracker(void)
    rootracker_tree->Branch("NumiFluxBeampz",   &brNumiFluxBeampz,    "NumiFluxBeampz/D");
   }
 
-  //-- open the input GENIE ROOT file and get the TTree & its header
-  TFile fin(gOptInpFileName.c_str(),"READ");
-  TTree *           gtree = 0;
-  NtpMCTreeHeader * thdr  = 0;
-  gtree = dynamic_cast <TTree *>           ( fin.Get("gtree")  );
-  thdr  = dynamic_cast <NtpMCTreeHeader *> ( fin.Get("header") );
-
-  LOG("gntpc", pINFO) << "Input tree header: " << *thdr;
-
-  //-- get mc record
-  NtpMCEventRecord * mcrec = 0;
-  gtree->SetBranchAddress("gmcrec", &mcrec);
-
   //-- print-out metadata associated with the input event file in case the
   //   event file was generated using the gT2Kevgen driver
   //   (assuming this is the case if the requested output format is the t2k_rootracker format)
-  if(gOptOutFileFormat == kConvFmt_t2k_rootracker) 
+  if(fFormat == kConvFmt_t2k_rootracker) 
   {
     // Check can find the MetaData
     genie::utils::T2KEvGenMetaData * metadata = NULL;
@@ -2193,23 +2195,23 @@ void ConvertToGRooTracker(void)
   }
 
 #ifdef __GENIE_FLUX_DRIVERS_ENABLED__
-  flux::GJPARCNuFluxPassThroughInfo * jnubeam_flux_info = 0;
-  if(gOptOutFileFormat == kConvFmt_t2k_rootracker) {
-     gtree->SetBranchAddress("flux", &jnubeam_flux_info);
+  jnubeam_flux_info = 0;
+  if(fFormat == kConvFmt_t2k_rootracker) {
+     SetFluxBranchAddress(gtree, &jnubeam_flux_info);
   }
-  flux::GNuMIFluxPassThroughInfo * gnumi_flux_info = 0;
-  if(gOptOutFileFormat == kConvFmt_numi_rootracker) {
-     gtree->SetBranchAddress("flux", &gnumi_flux_info);
+  gnumi_flux_info = 0;
+  if(fFormat == kConvFmt_numi_rootracker) {
+     SetFluxBranchAddress(gtree, &gnumi_flux_info);
   }
 #ifdef __GENIE_HEAVY_NEUTRAL_LEPTON_ENABLED__
   // gnumi_flux_ster ==> the "new flux" for HNL neutrino
-  hnl::FluxContainer * gnumi_flux_ster = 0;
-  if(gOptOutFileFormat == kConvFmt_numi_rootracker) {
-    gtree->SetBranchAddress("flux", &gnumi_flux_ster);
+  gnumi_flux_ster = 0;
+  if(fFormat == kConvFmt_numi_rootracker) {
+    SetFluxBranchAddress(gtree, &gnumi_flux_ster);
   }
   // extra branches for HNL declared here
-  double dVars[9] = { -9.9, -9.9, -9.9, -9.9, -9.9, -9.9, -9.9, -9.9, -9.9 };
-  int    iVars[4] = { -9, -9, -9, -9 };
+  for(int k=0; k<9; k++) { dVars[k] = -9.9; }
+  for(int k=0; k<4; k++) { iVars[k] = -9;   }
   DeclareHNLBranches( rootracker_tree, gtree, dVars, iVars );
 #endif // #ifdef __GENIE_HEAVY_NEUTRAL_LEPTON_ENABLED__
 #else
@@ -2220,369 +2222,360 @@ void ConvertToGRooTracker(void)
     << "--with-flux-drivers in the configuration step.";
 #endif
 
-  //-- figure out how many events to analyze
-  Long64_t nmax = (gOptN<0) ? 
-      gtree->GetEntries() : TMath::Min(gtree->GetEntries(), gOptN);
-  if (nmax<0) {
-    LOG("gntpc", pERROR) << "Number of events = 0";
-    return;
-  }
-  LOG("gntpc", pNOTICE) << "*** Analyzing: " << nmax << " events";
-
-  //-- event loop
-  for(Long64_t iev = 0; iev < nmax; iev++) {
-    gtree->GetEntry(iev);
-
-    NtpMCRecHeader rec_header = mcrec->hdr;
-    EventRecord &  event      = *(mcrec->event);
-    Interaction * interaction = event.Summary();
+}
+//____________________________________________________________________________________
+void GNtpcGRooTrackerConverter::Convert(Long64_t iev, NtpMCEventRecord * mcrec)
+{
+  NtpMCRecHeader rec_header = mcrec->hdr;
+  EventRecord &  event      = *(mcrec->event);
+  Interaction * interaction = event.Summary();
 
-    LOG("gntpc", pINFO) << rec_header;
-    LOG("gntpc", pINFO) << event;
-    LOG("gntpc", pINFO) << *interaction;
+  LOG("gntpc", pINFO) << rec_header;
+  LOG("gntpc", pINFO) << event;
+  LOG("gntpc", pINFO) << *interaction;
 #ifdef __GENIE_FLUX_DRIVERS_ENABLED__
-    if(gOptOutFileFormat == kConvFmt_t2k_rootracker) {
-       if(jnubeam_flux_info) {
-          LOG("gntpc", pINFO) << *jnubeam_flux_info;
-       } else {
-          LOG("gntpc", pINFO) << "No JNUBEAM flux info associated with this event";
-       }
-    }
+  if(fFormat == kConvFmt_t2k_rootracker) {
+     if(jnubeam_flux_info) {
+        LOG("gntpc", pINFO) << *jnubeam_flux_info;
+     } else {
+        LOG("gntpc", pINFO) << "No JNUBEAM flux info associated with this event";
+     }
+  }
 #endif
 
-    //
-    // clear output tree branches
-    //
-    if(brEvtFlags) delete brEvtFlags;
-    brEvtFlags  = 0;
-    if(brEvtCode) delete brEvtCode;
-    brEvtCode   = 0;
-    brEvtNum    = 0;    
-    brEvtXSec   = 0;
-    brEvtDXSec  = 0;
-    brEvtKPS    = 0;
-    brEvtWght   = 0;
-    brEvtProb   = 0;
-    for(int k=0; k<4; k++) { 
-      brEvtVtx[k] = 0;
-    }
-    brStdHepN = 0; 
-    for(int i=0; i<kNPmax; i++) {
-       brStdHepPdg   [i] =  0;  
-       brStdHepStatus[i] = -1;  
-       brStdHepRescat[i] = -1;  
-       for(int k=0; k<4; k++) {
-         brStdHepX4 [i][k] = 0;  
-         brStdHepP4 [i][k] = 0;  
-       }
-       for(int k=0; k<3; k++) {
-         brStdHepPolz [i][k] = 0;  
-       }
-       brStdHepFd    [i] = 0;  
-       brStdHepLd    [i] = 0;  
-       brStdHepFm    [i] = 0;  
-       brStdHepLm    [i] = 0;  
-    }
-    brNuParentPdg     = 0;           
-    brNuParentDecMode = 0;       
-    for(int k=0; k<4; k++) {  
-      brNuParentDecP4 [k] = 0;     
-      brNuParentDecX4 [k] = 0;     
-      brNuParentProP4 [k] = 0;     
-      brNuParentProX4 [k] = 0;     
-    }
-    brNuParentProNVtx = 0;     
-    brNeutCode = 0;     
-    brNuFluxEntry = -1;
-    brNuIdfd = -999999;
-    brNuCospibm = -999999.;
-    brNuCospi0bm = -999999.;
-    brNuGipart = -1;
-    brNuGamom0 = -999999.;   
-    for(int k=0; k< 3; k++){
-      brNuGvec0[k] = -999999.;
-      brNuGpos0[k] = -999999.;
-    }    
-    // variables added since 10d flux compatibility changes
-    for(int k=0; k<2; k++) {
-      brNuXnu[k] = brNuBpos[k] = brNuBtilt[k] = brNuBrms[k] = brNuEmit[k] = brNuAlpha[k] = -999999.; 
-    }
-    for(int k=0; k<3; k++) brNuHcur[k] = -999999.; 
-    for(int np = 0; np < flux::fNgmax; np++){
-        for(int  k=0; k<3; k++){
-          brNuGv[np][k] = -999999.;
-          brNuGp[np][k] = -999999.;
-        }
-      brNuGpid[np] = -999999;
-      brNuGmec[np] = -999999;
-      brNuGmat[np] = -999999;
-      brNuGcosbm[np]  = -999999.;
-      brNuGdistc[np]  = -999999.;
-      brNuGdistal[np] = -999999.;
-      brNuGdistti[np] = -999999.;
-      brNuGdistfe[np] = -999999.;
-    }  
-    brNuNg     = -999999;
-    brNuRnu    = -999999.;
-    brNuNorm   = -999999.;
-    brNuEnusk  = -999999.;
-    brNuNormsk = -999999.;
-    brNuAnorm  = -999999.;
-    brNuVersion= -999999.;
-    brNuNtrig  = -999999;
-    brNuTuneid = -999999;
-    brNuPint   = -999999;
-    brNuRand = -999999;
-    if(brNuFileName) delete brNuFileName;
-    brNuFileName = 0;
+  //
+  // clear output tree branches
+  //
+  if(brEvtFlags) delete brEvtFlags;
+  brEvtFlags  = 0;
+  if(brEvtCode) delete brEvtCode;
+  brEvtCode   = 0;
+  brEvtNum    = 0;    
+  brEvtXSec   = 0;
+  brEvtDXSec  = 0;
+  brEvtKPS    = 0;
+  brEvtWght   = 0;
+  brEvtProb   = 0;
+  for(int k=0; k<4; k++) { 
+    brEvtVtx[k] = 0;
+  }
+  brStdHepN = 0; 
+  for(int i=0; i<kNPmax; i++) {
+     brStdHepPdg   [i] =  0;  
+     brStdHepStatus[i] = -1;  
+     brStdHepRescat[i] = -1;  
+     for(int k=0; k<4; k++) {
+       brStdHepX4 [i][k] = 0;  
+       brStdHepP4 [i][k] = 0;  
+     }
+     for(int k=0; k<3; k++) {
+       brStdHepPolz [i][k] = 0;  
+     }
+     brStdHepFd    [i] = 0;  
+     brStdHepLd    [i] = 0;  
+     brStdHepFm    [i] = 0;  
+     brStdHepLm    [i] = 0;  
+  }
+  brNuParentPdg     = 0;           
+  brNuParentDecMode = 0;       
+  for(int k=0; k<4; k++) {  
+    brNuParentDecP4 [k] = 0;     
+    brNuParentDecX4 [k] = 0;     
+    brNuParentProP4 [k] = 0;     
+    brNuParentProX4 [k] = 0;     
+  }
+  brNuParentProNVtx = 0;     
+  brNeutCode = 0;     
+  brNuFluxEntry = -1;
+  brNuIdfd = -999999;
+  brNuCospibm = -999999.;
+  brNuCospi0bm = -999999.;
+  brNuGipart = -1;
+  brNuGamom0 = -999999.;   
+  for(int k=0; k< 3; k++){
+    brNuGvec0[k] = -999999.;
+    brNuGpos0[k] = -999999.;
+  }    
+  // variables added since 10d flux compatibility changes
+  for(int k=0; k<2; k++) {
+    brNuXnu[k] = brNuBpos[k] = brNuBtilt[k] = brNuBrms[k] = brNuEmit[k] = brNuAlpha[k] = -999999.; 
+  }
+  for(int k=0; k<3; k++) brNuHcur[k] = -999999.; 
+  for(int np = 0; np < flux::fNgmax; np++){
+      for(int  k=0; k<3; k++){
+        brNuGv[np][k] = -999999.;
+        brNuGp[np][k] = -999999.;
+      }
+    brNuGpid[np] = -999999;
+    brNuGmec[np] = -999999;
+    brNuGmat[np] = -999999;
+    brNuGcosbm[np]  = -999999.;
+    brNuGdistc[np]  = -999999.;
+    brNuGdistal[np] = -999999.;
+    brNuGdistti[np] = -999999.;
+    brNuGdistfe[np] = -999999.;
+  }  
+  brNuNg     = -999999;
+  brNuRnu    = -999999.;
+  brNuNorm   = -999999.;
+  brNuEnusk  = -999999.;
+  brNuNormsk = -999999.;
+  brNuAnorm  = -999999.;
+  brNuVersion= -999999.;
+  brNuNtrig  = -999999;
+  brNuTuneid = -999999;
+  brNuPint   = -999999;
+  brNuRand = -999999;
+  if(brNuFileName) delete brNuFileName;
+  brNuFileName = 0;
 
-    //
-    // copy current event info to output tree
-    //
+  //
+  // copy current event info to output tree
+  //
 
-    brEvtFlags  = new TBits(*event.EventFlags());   
-    brEvtCode   = new TObjString(event.Summary()->AsString().c_str());   
-    brEvtNum    = (int) iev;    
-    brEvtXSec   = (1E+38/units::cm2) * event.XSec();    
-    brEvtDXSec  = (1E+38/units::cm2) * event.DiffXSec();    
-    brEvtKPS    = event.DiffXSecVars();
-    LOG( "gntpc", pDEBUG )
-      << "brEvtKPS = " << brEvtKPS
-      << ", event.DiffXSecVars() = " << event.DiffXSecVars();
-    brEvtWght   = event.Weight();    
-    brEvtProb   = event.Probability();    
-    brEvtVtx[0] = event.Vertex()->X();    
-    brEvtVtx[1] = event.Vertex()->Y();    
-    brEvtVtx[2] = event.Vertex()->Z();    
-    brEvtVtx[3] = event.Vertex()->T();    
-
-    int iparticle=0;
-    GHepParticle * p = 0;
-    TIter event_iter(&event);
-    while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
-        assert(p);
-
-        // for mock_data variances write out only stable final state particles
-        if(hide_truth && p->Status() != kIStStableFinalState) continue;
-
-        brStdHepPdg   [iparticle] = p->Pdg(); 
-        brStdHepStatus[iparticle] = (int) p->Status(); 
-        brStdHepRescat[iparticle] = p->RescatterCode(); 
-        brStdHepX4    [iparticle][0] = p->X4()->X(); 
-        brStdHepX4    [iparticle][1] = p->X4()->Y(); 
-        brStdHepX4    [iparticle][2] = p->X4()->Z(); 
-        brStdHepX4    [iparticle][3] = p->X4()->T(); 
-        brStdHepP4    [iparticle][0] = p->P4()->Px(); 
-        brStdHepP4    [iparticle][1] = p->P4()->Py(); 
-        brStdHepP4    [iparticle][2] = p->P4()->Pz(); 
-        brStdHepP4    [iparticle][3] = p->P4()->E(); 
-        if(p->PolzIsSet()) {
-          brStdHepPolz  [iparticle][0] = TMath::Sin(p->PolzPolarAngle()) * TMath::Cos(p->PolzAzimuthAngle());
-          brStdHepPolz  [iparticle][1] = TMath::Sin(p->PolzPolarAngle()) * TMath::Sin(p->PolzAzimuthAngle());
-          brStdHepPolz  [iparticle][2] = TMath::Cos(p->PolzPolarAngle());
-        }
-        brStdHepFd    [iparticle] = p->FirstDaughter(); 
-        brStdHepLd    [iparticle] = p->LastDaughter(); 
-        brStdHepFm    [iparticle] = p->FirstMother(); 
-        brStdHepLm    [iparticle] = p->LastMother(); 
-        iparticle++;
-    }
-    brStdHepN = iparticle; 
+  brEvtFlags  = new TBits(*event.EventFlags());   
+  brEvtCode   = new TObjString(event.Summary()->AsString().c_str());   
+  brEvtNum    = (int) iev;    
+  brEvtXSec   = (1E+38/units::cm2) * event.XSec();    
+  brEvtDXSec  = (1E+38/units::cm2) * event.DiffXSec();    
+  brEvtKPS    = event.DiffXSecVars();
+  LOG( "gntpc", pDEBUG )
+    << "brEvtKPS = " << brEvtKPS
+    << ", event.DiffXSecVars() = " << event.DiffXSecVars();
+  brEvtWght   = event.Weight();    
+  brEvtProb   = event.Probability();    
+  brEvtVtx[0] = event.Vertex()->X();    
+  brEvtVtx[1] = event.Vertex()->Y();    
+  brEvtVtx[2] = event.Vertex()->Z();    
+  brEvtVtx[3] = event.Vertex()->T();    
+
+  int iparticle=0;
+  GHepParticle * p = 0;
+  TIter event_iter(&event);
+  while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
+      assert(p);
 
-    //
-    // fill in additional info for the t2k_rootracker format
-    //
-    if(gOptOutFileFormat == kConvFmt_t2k_rootracker) {
+      // for mock_data variances write out only stable final state particles
+      if(hide_truth && p->Status() != kIStStableFinalState) continue;
+
+      brStdHepPdg   [iparticle] = p->Pdg(); 
+      brStdHepStatus[iparticle] = (int) p->Status(); 
+      brStdHepRescat[iparticle] = p->RescatterCode(); 
+      brStdHepX4    [iparticle][0] = p->X4()->X(); 
+      brStdHepX4    [iparticle][1] = p->X4()->Y(); 
+      brStdHepX4    [iparticle][2] = p->X4()->Z(); 
+      brStdHepX4    [iparticle][3] = p->X4()->T(); 
+      brStdHepP4    [iparticle][0] = p->P4()->Px(); 
+      brStdHepP4    [iparticle][1] = p->P4()->Py(); 
+      brStdHepP4    [iparticle][2] = p->P4()->Pz(); 
+      brStdHepP4    [iparticle][3] = p->P4()->E(); 
+      if(p->PolzIsSet()) {
+        brStdHepPolz  [iparticle][0] = TMath::Sin(p->PolzPolarAngle()) * TMath::Cos(p->PolzAzimuthAngle());
+        brStdHepPolz  [iparticle][1] = TMath::Sin(p->PolzPolarAngle()) * TMath::Sin(p->PolzAzimuthAngle());
+        brStdHepPolz  [iparticle][2] = TMath::Cos(p->PolzPolarAngle());
+      }
+      brStdHepFd    [iparticle] = p->FirstDaughter(); 
+      brStdHepLd    [iparticle] = p->LastDaughter(); 
+      brStdHepFm    [iparticle] = p->FirstMother(); 
+      brStdHepLm    [iparticle] = p->LastMother(); 
+      iparticle++;
+  }
+  brStdHepN = iparticle; 
 
-      // map GENIE event to NEUT reaction codes
-      brNeutCode = utils::ghep::NeutReactionCode(&event);
+  //
+  // fill in additional info for the t2k_rootracker format
+  //
+  if(fFormat == kConvFmt_t2k_rootracker) {
+
+    // map GENIE event to NEUT reaction codes
+    brNeutCode = utils::ghep::NeutReactionCode(&event);
 
 #ifdef __GENIE_FLUX_DRIVERS_ENABLED__
-      // Copy flux info if this is the t2k rootracker variance.
-      // The flux may not be available, eg if events were generated using plain flux 
-      // histograms and not the JNUBEAM simulation's output flux ntuples.
-      PDGLibrary * pdglib = PDGLibrary::Instance();
-      if(jnubeam_flux_info) {
-        brNuParentPdg       = pdg::GeantToPdg(jnubeam_flux_info->ppid);
-        brNuParentDecMode   = jnubeam_flux_info->mode;
-
-        brNuParentDecP4 [0] = jnubeam_flux_info->ppi * jnubeam_flux_info->npi[0]; // px
-        brNuParentDecP4 [1] = jnubeam_flux_info->ppi * jnubeam_flux_info->npi[1]; // py
-        brNuParentDecP4 [2] = jnubeam_flux_info->ppi * jnubeam_flux_info->npi[2]; // px
-        brNuParentDecP4 [3] = TMath::Sqrt(
-                                 TMath::Power(pdglib->Find(brNuParentPdg)->Mass(), 2.)
-                               + TMath::Power(jnubeam_flux_info->ppi, 2.)
-                              ); // E
-        brNuParentDecX4 [0] = jnubeam_flux_info->xpi[0]; // x
-        brNuParentDecX4 [1] = jnubeam_flux_info->xpi[1]; // y       
-        brNuParentDecX4 [2] = jnubeam_flux_info->xpi[2]; // x   
-        brNuParentDecX4 [3] = 0;                 // t
-
-        brNuParentProP4 [0] = jnubeam_flux_info->ppi0 * jnubeam_flux_info->npi0[0]; // px
-        brNuParentProP4 [1] = jnubeam_flux_info->ppi0 * jnubeam_flux_info->npi0[1]; // py
-        brNuParentProP4 [2] = jnubeam_flux_info->ppi0 * jnubeam_flux_info->npi0[2]; // px
-        brNuParentProP4 [3] = TMath::Sqrt(
-                                TMath::Power(pdglib->Find(brNuParentPdg)->Mass(), 2.)
-                              + TMath::Power(jnubeam_flux_info->ppi0, 2.)
-                              ); // E
-        brNuParentProX4 [0] = jnubeam_flux_info->xpi0[0]; // x
-        brNuParentProX4 [1] = jnubeam_flux_info->xpi0[1]; // y       
-        brNuParentProX4 [2] = jnubeam_flux_info->xpi0[2]; // x   
-        brNuParentProX4 [3] = 0;                // t
-
-        brNuParentProNVtx   = jnubeam_flux_info->nvtx0;
-
-        // Copy info added post JNUBEAM '10a' compatibility changes 
-        brNuFluxEntry = jnubeam_flux_info->fluxentry;
-        brNuIdfd = jnubeam_flux_info->idfd;
-        brNuCospibm = jnubeam_flux_info->cospibm;
-        brNuCospi0bm = jnubeam_flux_info->cospi0bm;
-        brNuGipart = jnubeam_flux_info->gipart;
-        brNuGamom0 = jnubeam_flux_info->gamom0;
-        for(int k=0; k<3; k++){
-            brNuGpos0[k] = (double) jnubeam_flux_info->gpos0[k];
-            brNuGvec0[k] = (double) jnubeam_flux_info->gvec0[k];
-        }
-        // Copy info added post JNUBEAM '10d' compatibility changes 
-        brNuXnu[0] = (double) jnubeam_flux_info->xnu;
-        brNuXnu[1] = (double) jnubeam_flux_info->ynu;
-        brNuRnu    = (double) jnubeam_flux_info->rnu; 
-        for(int k=0; k<2; k++){
-          brNuBpos[k] = (double) jnubeam_flux_info->bpos[k];
-          brNuBtilt[k] = (double) jnubeam_flux_info->btilt[k];
-          brNuBrms[k] = (double) jnubeam_flux_info->brms[k];
-          brNuEmit[k] = (double) jnubeam_flux_info->emit[k];
-          brNuAlpha[k] = (double) jnubeam_flux_info->alpha[k];
-        } 
-        for(int k=0; k<3; k++) brNuHcur[k] = jnubeam_flux_info->hcur[k]; 
-        for(int np = 0; np < flux::fNgmax; np++){
-          brNuGv[np][0] = jnubeam_flux_info->gvx[np];
-          brNuGv[np][1] = jnubeam_flux_info->gvy[np];
-          brNuGv[np][2] = jnubeam_flux_info->gvz[np];
-          brNuGp[np][0] = jnubeam_flux_info->gpx[np];
-          brNuGp[np][1] = jnubeam_flux_info->gpy[np];
-          brNuGp[np][2] = jnubeam_flux_info->gpz[np];
-          brNuGpid[np]  = jnubeam_flux_info->gpid[np];
-          brNuGmec[np]  = jnubeam_flux_info->gmec[np];
-          brNuGcosbm[np]  = jnubeam_flux_info->gcosbm[np];
-          brNuGmat[np]    = jnubeam_flux_info->gmat[np];
-          brNuGdistc[np]  = jnubeam_flux_info->gdistc[np];
-          brNuGdistal[np] = jnubeam_flux_info->gdistal[np];
-          brNuGdistti[np] = jnubeam_flux_info->gdistti[np];
-          brNuGdistfe[np] = jnubeam_flux_info->gdistfe[np];
-        }  
-        brNuNg     = jnubeam_flux_info->ng;
-        brNuNorm   = jnubeam_flux_info->norm;
-        brNuEnusk  = jnubeam_flux_info->Enusk;
-        brNuNormsk = jnubeam_flux_info->normsk;
-        brNuAnorm  = jnubeam_flux_info->anorm;
-        brNuVersion= jnubeam_flux_info->version;
-        brNuNtrig  = jnubeam_flux_info->ntrig;
-        brNuTuneid = jnubeam_flux_info->tuneid;
-        brNuPint   = jnubeam_flux_info->pint;
-        brNuRand   = jnubeam_flux_info->rand;
-        brNuFileName = new TObjString(jnubeam_flux_info->fluxfilename.c_str()); 
-      }//jnubeam_flux_info
+    // Copy flux info if this is the t2k rootracker variance.
+    // The flux may not be available, eg if events were generated using plain flux 
+    // histograms and not the JNUBEAM simulation's output flux ntuples.
+    PDGLibrary * pdglib = PDGLibrary::Instance();
+    if(jnubeam_flux_info) {
+      brNuParentPdg       = pdg::GeantToPdg(jnubeam_flux_info->ppid);
+      brNuParentDecMode   = jnubeam_flux_info->mode;
+
+      brNuParentDecP4 [0] = jnubeam_flux_info->ppi * jnubeam_flux_info->npi[0]; // px
+      brNuParentDecP4 [1] = jnubeam_flux_info->ppi * jnubeam_flux_info->npi[1]; // py
+      brNuParentDecP4 [2] = jnubeam_flux_info->ppi * jnubeam_flux_info->npi[2]; // px
+      brNuParentDecP4 [3] = TMath::Sqrt(
+                               TMath::Power(pdglib->Find(brNuParentPdg)->Mass(), 2.)
+                             + TMath::Power(jnubeam_flux_info->ppi, 2.)
+                            ); // E
+      brNuParentDecX4 [0] = jnubeam_flux_info->xpi[0]; // x
+      brNuParentDecX4 [1] = jnubeam_flux_info->xpi[1]; // y       
+      brNuParentDecX4 [2] = jnubeam_flux_info->xpi[2]; // x   
+      brNuParentDecX4 [3] = 0;                 // t
+
+      brNuParentProP4 [0] = jnubeam_flux_info->ppi0 * jnubeam_flux_info->npi0[0]; // px
+      brNuParentProP4 [1] = jnubeam_flux_info->ppi0 * jnubeam_flux_info->npi0[1]; // py
+      brNuParentProP4 [2] = jnubeam_flux_info->ppi0 * jnubeam_flux_info->npi0[2]; // px
+      brNuParentProP4 [3] = TMath::Sqrt(
+                              TMath::Power(pdglib->Find(brNuParentPdg)->Mass(), 2.)
+                            + TMath::Power(jnubeam_flux_info->ppi0, 2.)
+                            ); // E
+      brNuParentProX4 [0] = jnubeam_flux_info->xpi0[0]; // x
+      brNuParentProX4 [1] = jnubeam_flux_info->xpi0[1]; // y       
+      brNuParentProX4 [2] = jnubeam_flux_info->xpi0[2]; // x   
+      brNuParentProX4 [3] = 0;                // t
+
+      brNuParentProNVtx   = jnubeam_flux_info->nvtx0;
+
+      // Copy info added post JNUBEAM '10a' compatibility changes 
+      brNuFluxEntry = jnubeam_flux_info->fluxentry;
+      brNuIdfd = jnubeam_flux_info->idfd;
+      brNuCospibm = jnubeam_flux_info->cospibm;
+      brNuCospi0bm = jnubeam_flux_info->cospi0bm;
+      brNuGipart = jnubeam_flux_info->gipart;
+      brNuGamom0 = jnubeam_flux_info->gamom0;
+      for(int k=0; k<3; k++){
+          brNuGpos0[k] = (double) jnubeam_flux_info->gpos0[k];
+          brNuGvec0[k] = (double) jnubeam_flux_info->gvec0[k];
+      }
+      // Copy info added post JNUBEAM '10d' compatibility changes 
+      brNuXnu[0] = (double) jnubeam_flux_info->xnu;
+      brNuXnu[1] = (double) jnubeam_flux_info->ynu;
+      brNuRnu    = (double) jnubeam_flux_info->rnu; 
+      for(int k=0; k<2; k++){
+        brNuBpos[k] = (double) jnubeam_flux_info->bpos[k];
+        brNuBtilt[k] = (double) jnubeam_flux_info->btilt[k];
+        brNuBrms[k] = (double) jnubeam_flux_info->brms[k];
+        brNuEmit[k] = (double) jnubeam_flux_info->emit[k];
+        brNuAlpha[k] = (double) jnubeam_flux_info->alpha[k];
+      } 
+      for(int k=0; k<3; k++) brNuHcur[k] = jnubeam_flux_info->hcur[k]; 
+      for(int np = 0; np < flux::fNgmax; np++){
+        brNuGv[np][0] = jnubeam_flux_info->gvx[np];
+        brNuGv[np][1] = jnubeam_flux_info->gvy[np];
+        brNuGv[np][2] = jnubeam_flux_info->gvz[np];
+        brNuGp[np][0] = jnubeam_flux_info->gpx[np];
+        brNuGp[np][1] = jnubeam_flux_info->gpy[np];
+        brNuGp[np][2] = jnubeam_flux_info->gpz[np];
+        brNuGpid[np]  = jnubeam_flux_info->gpid[np];
+        brNuGmec[np]  = jnubeam_flux_info->gmec[np];
+        brNuGcosbm[np]  = jnubeam_flux_info->gcosbm[np];
+        brNuGmat[np]    = jnubeam_flux_info->gmat[np];
+        brNuGdistc[np]  = jnubeam_flux_info->gdistc[np];
+        brNuGdistal[np] = jnubeam_flux_info->gdistal[np];
+        brNuGdistti[np] = jnubeam_flux_info->gdistti[np];
+        brNuGdistfe[np] = jnubeam_flux_info->gdistfe[np];
+      }  
+      brNuNg     = jnubeam_flux_info->ng;
+      brNuNorm   = jnubeam_flux_info->norm;
+      brNuEnusk  = jnubeam_flux_info->Enusk;
+      brNuNormsk = jnubeam_flux_info->normsk;
+      brNuAnorm  = jnubeam_flux_info->anorm;
+      brNuVersion= jnubeam_flux_info->version;
+      brNuNtrig  = jnubeam_flux_info->ntrig;
+      brNuTuneid = jnubeam_flux_info->tuneid;
+      brNuPint   = jnubeam_flux_info->pint;
+      brNuRand   = jnubeam_flux_info->rand;
+      brNuFileName = new TObjString(jnubeam_flux_info->fluxfilename.c_str()); 
+    }//jnubeam_flux_info
 #endif
-    }//kConvFmt_t2k_rootracker
+  }//kConvFmt_t2k_rootracker
 
-    //
-    // fill in additional info for the numi_rootracker format
-    //
-    if(gOptOutFileFormat == kConvFmt_numi_rootracker) {
+  //
+  // fill in additional info for the numi_rootracker format
+  //
+  if(fFormat == kConvFmt_numi_rootracker) {
 #ifdef __GENIE_FLUX_DRIVERS_ENABLED__
 
-     // Copy flux info if this is the numi rootracker variance.
-     if(gnumi_flux_info) {
-       brNumiFluxRun      = gnumi_flux_info->run;
-       brNumiFluxEvtno    = gnumi_flux_info->evtno;
-       brNumiFluxNdxdz    = gnumi_flux_info->ndxdz;
-       brNumiFluxNdydz    = gnumi_flux_info->ndydz;
-       brNumiFluxNpz      = gnumi_flux_info->npz;
-       brNumiFluxNenergy  = gnumi_flux_info->nenergy;
-       brNumiFluxNdxdznea = gnumi_flux_info->ndxdznea;
-       brNumiFluxNdydznea = gnumi_flux_info->ndydznea;
-       brNumiFluxNenergyn = gnumi_flux_info->nenergyn;
-       brNumiFluxNwtnear  = gnumi_flux_info->nwtnear;
-       brNumiFluxNdxdzfar = gnumi_flux_info->ndxdzfar;
-       brNumiFluxNdydzfar = gnumi_flux_info->ndydzfar;
-       brNumiFluxNenergyf = gnumi_flux_info->nenergyf;
-       brNumiFluxNwtfar   = gnumi_flux_info->nwtfar;
-       brNumiFluxNorig    = gnumi_flux_info->norig;
-       brNumiFluxNdecay   = gnumi_flux_info->ndecay;
-       brNumiFluxNtype    = gnumi_flux_info->ntype;
-       brNumiFluxVx       = gnumi_flux_info->vx;
-       brNumiFluxVy       = gnumi_flux_info->vy;
-       brNumiFluxVz       = gnumi_flux_info->vz;
-       brNumiFluxPdpx     = gnumi_flux_info->pdpx;
-       brNumiFluxPdpy     = gnumi_flux_info->pdpy;
-       brNumiFluxPdpz     = gnumi_flux_info->pdpz;
-       brNumiFluxPpdxdz   = gnumi_flux_info->ppdxdz;
-       brNumiFluxPpdydz   = gnumi_flux_info->ppdydz;
-       brNumiFluxPppz     = gnumi_flux_info->pppz;
-       brNumiFluxPpenergy = gnumi_flux_info->ppenergy;
-       brNumiFluxPpmedium = gnumi_flux_info->ppmedium;
-       brNumiFluxPtype    = gnumi_flux_info->ptype;
-       brNumiFluxPpvx     = gnumi_flux_info->ppvx;
-       brNumiFluxPpvy     = gnumi_flux_info->ppvy;
-       brNumiFluxPpvz     = gnumi_flux_info->ppvz;
-       brNumiFluxMuparpx  = gnumi_flux_info->muparpx;
-       brNumiFluxMuparpy  = gnumi_flux_info->muparpy;
-       brNumiFluxMuparpz  = gnumi_flux_info->muparpz;
-       brNumiFluxMupare   = gnumi_flux_info->mupare;
-       brNumiFluxNecm     = gnumi_flux_info->necm;
-       brNumiFluxNimpwt   = gnumi_flux_info->nimpwt;
-       brNumiFluxXpoint   = gnumi_flux_info->xpoint;
-       brNumiFluxYpoint   = gnumi_flux_info->ypoint;
-       brNumiFluxZpoint   = gnumi_flux_info->zpoint;
-       brNumiFluxTvx      = gnumi_flux_info->tvx;
-       brNumiFluxTvy      = gnumi_flux_info->tvy;
-       brNumiFluxTvz      = gnumi_flux_info->tvz;
-       brNumiFluxTpx      = gnumi_flux_info->tpx;
-       brNumiFluxTpy      = gnumi_flux_info->tpy;
-       brNumiFluxTpz      = gnumi_flux_info->tpz;
-       brNumiFluxTptype   = gnumi_flux_info->tptype;
-       brNumiFluxTgen     = gnumi_flux_info->tgen;
-       brNumiFluxTgptype  = gnumi_flux_info->tgptype;
-       brNumiFluxTgppx    = gnumi_flux_info->tgppx;
-       brNumiFluxTgppy    = gnumi_flux_info->tgppy;
-       brNumiFluxTgppz    = gnumi_flux_info->tgppz;
-       brNumiFluxTprivx   = gnumi_flux_info->tprivx;
-       brNumiFluxTprivy   = gnumi_flux_info->tprivy;
-       brNumiFluxTprivz   = gnumi_flux_info->tprivz;
-       brNumiFluxBeamx    = gnumi_flux_info->beamx;
-       brNumiFluxBeamy    = gnumi_flux_info->beamy;
-       brNumiFluxBeamz    = gnumi_flux_info->beamz;
-       brNumiFluxBeampx   = gnumi_flux_info->beampx;
-       brNumiFluxBeampy   = gnumi_flux_info->beampy;
-       brNumiFluxBeampz   = gnumi_flux_info->beampz;
-     } // gnumi_flux_info
+   // Copy flux info if this is the numi rootracker variance.
+   if(gnumi_flux_info) {
+     brNumiFluxRun      = gnumi_flux_info->run;
+     brNumiFluxEvtno    = gnumi_flux_info->evtno;
+     brNumiFluxNdxdz    = gnumi_flux_info->ndxdz;
+     brNumiFluxNdydz    = gnumi_flux_info->ndydz;
+     brNumiFluxNpz      = gnumi_flux_info->npz;
+     brNumiFluxNenergy  = gnumi_flux_info->nenergy;
+     brNumiFluxNdxdznea = gnumi_flux_info->ndxdznea;
+     brNumiFluxNdydznea = gnumi_flux_info->ndydznea;
+     brNumiFluxNenergyn = gnumi_flux_info->nenergyn;
+     brNumiFluxNwtnear  = gnumi_flux_info->nwtnear;
+     brNumiFluxNdxdzfar = gnumi_flux_info->ndxdzfar;
+     brNumiFluxNdydzfar = gnumi_flux_info->ndydzfar;
+     brNumiFluxNenergyf = gnumi_flux_info->nenergyf;
+     brNumiFluxNwtfar   = gnumi_flux_info->nwtfar;
+     brNumiFluxNorig    = gnumi_flux_info->norig;
+     brNumiFluxNdecay   = gnumi_flux_info->ndecay;
+     brNumiFluxNtype    = gnumi_flux_info->ntype;
+     brNumiFluxVx       = gnumi_flux_info->vx;
+     brNumiFluxVy       = gnumi_flux_info->vy;
+     brNumiFluxVz       = gnumi_flux_info->vz;
+     brNumiFluxPdpx     = gnumi_flux_info->pdpx;
+     brNumiFluxPdpy     = gnumi_flux_info->pdpy;
+     brNumiFluxPdpz     = gnumi_flux_info->pdpz;
+     brNumiFluxPpdxdz   = gnumi_flux_info->ppdxdz;
+     brNumiFluxPpdydz   = gnumi_flux_info->ppdydz;
+     brNumiFluxPppz     = gnumi_flux_info->pppz;
+     brNumiFluxPpenergy = gnumi_flux_info->ppenergy;
+     brNumiFluxPpmedium = gnumi_flux_info->ppmedium;
+     brNumiFluxPtype    = gnumi_flux_info->ptype;
+     brNumiFluxPpvx     = gnumi_flux_info->ppvx;
+     brNumiFluxPpvy     = gnumi_flux_info->ppvy;
+     brNumiFluxPpvz     = gnumi_flux_info->ppvz;
+     brNumiFluxMuparpx  = gnumi_flux_info->muparpx;
+     brNumiFluxMuparpy  = gnumi_flux_info->muparpy;
+     brNumiFluxMuparpz  = gnumi_flux_info->muparpz;
+     brNumiFluxMupare   = gnumi_flux_info->mupare;
+     brNumiFluxNecm     = gnumi_flux_info->necm;
+     brNumiFluxNimpwt   = gnumi_flux_info->nimpwt;
+     brNumiFluxXpoint   = gnumi_flux_info->xpoint;
+     brNumiFluxYpoint   = gnumi_flux_info->ypoint;
+     brNumiFluxZpoint   = gnumi_flux_info->zpoint;
+     brNumiFluxTvx      = gnumi_flux_info->tvx;
+     brNumiFluxTvy      = gnumi_flux_info->tvy;
+     brNumiFluxTvz      = gnumi_flux_info->tvz;
+     brNumiFluxTpx      = gnumi_flux_info->tpx;
+     brNumiFluxTpy      = gnumi_flux_info->tpy;
+     brNumiFluxTpz      = gnumi_flux_info->tpz;
+     brNumiFluxTptype   = gnumi_flux_info->tptype;
+     brNumiFluxTgen     = gnumi_flux_info->tgen;
+     brNumiFluxTgptype  = gnumi_flux_info->tgptype;
+     brNumiFluxTgppx    = gnumi_flux_info->tgppx;
+     brNumiFluxTgppy    = gnumi_flux_info->tgppy;
+     brNumiFluxTgppz    = gnumi_flux_info->tgppz;
+     brNumiFluxTprivx   = gnumi_flux_info->tprivx;
+     brNumiFluxTprivy   = gnumi_flux_info->tprivy;
+     brNumiFluxTprivz   = gnumi_flux_info->tprivz;
+     brNumiFluxBeamx    = gnumi_flux_info->beamx;
+     brNumiFluxBeamy    = gnumi_flux_info->beamy;
+     brNumiFluxBeamz    = gnumi_flux_info->beamz;
+     brNumiFluxBeampx   = gnumi_flux_info->beampx;
+     brNumiFluxBeampy   = gnumi_flux_info->beampy;
+     brNumiFluxBeampz   = gnumi_flux_info->beampz;
+   } // gnumi_flux_info
 #endif
-    } // kConvFmt_numi_rootracker
+  } // kConvFmt_numi_rootracker
 
-    //
-    // if HNL, fill in additional branch info
-    //
+  //
+  // if HNL, fill in additional branch info
+  //
 #ifdef __GENIE_HEAVY_NEUTRAL_LEPTON_ENABLED__
-    if( gnumi_flux_ster ){
-      iVars[1] = gnumi_flux_ster->prodChan;
-      iVars[2] = gnumi_flux_ster->nuPdg;
-      iVars[3] = gnumi_flux_ster->lepPdg;
-      
-      dVars[4] = gnumi_flux_ster->p4User.Px() / gnumi_flux_ster->p4User.Pz();
-      dVars[5] = gnumi_flux_ster->p4User.Py() / gnumi_flux_ster->p4User.Pz();
-      dVars[6] = gnumi_flux_ster->p4User.Pz();
-      dVars[7] = gnumi_flux_ster->nuEcm;
-      dVars[8] = gnumi_flux_ster->accCorr;
-    }
+  if( gnumi_flux_ster ){
+    iVars[1] = gnumi_flux_ster->prodChan;
+    iVars[2] = gnumi_flux_ster->nuPdg;
+    iVars[3] = gnumi_flux_ster->lepPdg;
+    
+    dVars[4] = gnumi_flux_ster->p4User.Px() / gnumi_flux_ster->p4User.Pz();
+    dVars[5] = gnumi_flux_ster->p4User.Py() / gnumi_flux_ster->p4User.Pz();
+    dVars[6] = gnumi_flux_ster->p4User.Pz();
+    dVars[7] = gnumi_flux_ster->nuEcm;
+    dVars[8] = gnumi_flux_ster->accCorr;
+  }
 #endif // #ifdef __GENIE_HEAVY_NEUTRAL_LEPTON_ENABLED__
 
-    // fill tree
-    rootracker_tree->Fill();
-    mcrec->Clear();
-
-  } // event loop
-
+  // fill tree
+  rootracker_tree->Fill();
+}
+//____________________________________________________________________________________
+void GNtpcGRooTrackerConverter::End(TFile & fin, TTree * gtree)
+{
   // Copy POT normalization for the generated sample
   double pot = gtree->GetWeight();
   rootracker_tree->SetWeight(pot);
@@ -2591,22 +2584,39 @@ void ConvertToGRooTracker(void)
   if(gOptCopyJobMeta) {
     TFolder * genv    = (TFolder*) fin.Get("genv");
     TFolder * gconfig = (TFolder*) fin.Get("gconfig");    
-    fout.cd();
+    fout->cd();
     genv    -> Write("genv");
     gconfig -> Write("gconfig");
   }
 
-  fin.Close();
-
-  fout.Write();
-  fout.Close();
+  fout->Write();
+  fout->Close();
+  delete fout;
 
   LOG("gntpc", pINFO) << "\nDone converting GENIE's GHEP ntuple";
 }
 //____________________________________________________________________________________
 // GENIE GHEP EVENT TREE -> NEUGEN-style format for AGKY studies 
 //____________________________________________________________________________________
-void ConvertToGHad(void)
+class GNtpcGHadConverter : public GNtpcConverter
+{
+public:
+  GNtpcGHadConverter(GNtpcFmt_t fmt, string filename, int vrs) :
+    GNtpcConverter(fmt, filename, vrs) { }
+
+  void Begin   (TFile & fin, TTree * gtree, NtpMCTreeHeader * thdr);
+  void Convert (Long64_t iev, NtpMCEventRecord * mcrec);
+  void End     (TFile & fin, TTree * gtree);
+
+private:
+  ofstream output;  // output stream
+#ifdef __GHAD_NTP__
+  TFile *  fout;    // output file
+  TTree *  ghad;    // output ntuple
+#endif
+};
+//____________________________________________________________________________________
+void GNtpcGHadConverter::Begin(TFile & /*fin*/, TTree * /*gtree*/, NtpMCTreeHeader * /*thdr*/)
 {
 // Neugen-style text format for the AGKY hadronization model studies
 // Format:
@@ -2620,26 +2630,14 @@ void ConvertToGHad(void)
 // ... then for each stable daughter
 // particle id, 5 vec 
 
-  //-- open the ROOT file and get the TTree & its header
-  TFile fin(gOptInpFileName.c_str(),"READ");
-  TTree *           tree = 0;
-  NtpMCTreeHeader * thdr = 0;
-  tree = dynamic_cast <TTree *>           ( fin.Get("gtree")  );
-  thdr = dynamic_cast <NtpMCTreeHeader *> ( fin.Get("header") );
-
-  LOG("gntpc", pINFO) << "Input tree header: " << *thdr;
-
-  //-- get mc record
-  NtpMCEventRecord * mcrec = 0;
-  tree->SetBranchAddress("gmcrec", &mcrec);
 
   //-- open the output stream
-  ofstream output(gOptOutFileName.c_str(), ios::out);
+  output.open(fOutFileName.c_str(), ios::out);
 
   //-- open output root file and create ntuple -- if required
 #ifdef __GHAD_NTP__
-  TFile fout("ghad.root","recreate");  
-  TTree * ghad = new TTree("ghad","");   
+  fout = new TFile("ghad.root","recreate");  
+  ghad = new TTree("ghad","");   
   ghad->Branch("i",       &brIev,          "i/I" );
   ghad->Branch("W",       &brW,            "W/D" );
   ghad->Branch("n",       &brN,            "n/I" );
@@ -2649,201 +2647,190 @@ void ConvertToGHad(void)
   ghad->Branch("py",       brPy,           "py[n]/D"   );
   ghad->Branch("pz",       brPz,           "pz[n]/D"   );
 #endif
+}
+//____________________________________________________________________________________
+void GNtpcGHadConverter::Convert(Long64_t iev, NtpMCEventRecord * mcrec)
+{
+  NtpMCRecHeader rec_header = mcrec->hdr;
+  EventRecord &  event      = *(mcrec->event);
 
-  //-- figure out how many events to analyze
-  Long64_t nmax = (gOptN<0) ? 
-      tree->GetEntries() : TMath::Min(tree->GetEntries(), gOptN);
-  if (nmax<0) {
-    LOG("gntpc", pERROR) << "Number of events = 0";
-    return;
-  }
-  LOG("gntpc", pNOTICE) << "*** Analyzing: " << nmax << " events";
-
-  //-- event loop
-  for(Long64_t iev = 0; iev < nmax; iev++) {
-    tree->GetEntry(iev);
-    NtpMCRecHeader rec_header = mcrec->hdr;
-    EventRecord &  event      = *(mcrec->event);
-
-    LOG("gntpc", pINFO) << rec_header;
-    LOG("gntpc", pINFO) << event;
+  LOG("gntpc", pINFO) << rec_header;
+  LOG("gntpc", pINFO) << event;
 
 #ifdef __GHAD_NTP__
-    brN = 0;  
-    for(int k=0; k<kNPmax; k++) {
-      brPdg[k]=0;       
-      brE  [k]=0;  
-      brPx [k]=0; 
-      brPy [k]=0; 
-      brPz [k]=0;  
-    }
+  brN = 0;  
+  for(int k=0; k<kNPmax; k++) {
+    brPdg[k]=0;       
+    brE  [k]=0;  
+    brPx [k]=0; 
+    brPy [k]=0; 
+    brPz [k]=0;  
+  }
 #endif
 
-    //
-    // convert the current event
-    //
-    const Interaction * interaction = event.Summary();
-    const ProcessInfo &  proc_info  = interaction->ProcInfo();
-    const InitialState & init_state = interaction->InitState();
-
-    bool is_dis = proc_info.IsDeepInelastic();
-    bool is_res = proc_info.IsResonant();
-    bool is_cc  = proc_info.IsWeakCC();
-
-    bool pass   = is_cc && (is_dis || is_res);
-    if(!pass) {
-      mcrec->Clear();
-      continue;
-    }
+  //
+  // convert the current event
+  //
+  const Interaction * interaction = event.Summary();
+  const ProcessInfo &  proc_info  = interaction->ProcInfo();
+  const InitialState & init_state = interaction->InitState();
+
+  bool is_dis = proc_info.IsDeepInelastic();
+  bool is_res = proc_info.IsResonant();
+  bool is_cc  = proc_info.IsWeakCC();
+
+  bool pass   = is_cc && (is_dis || is_res);
+  if(!pass) {
+    return;
+  }
 
-    int ccnc   = is_cc ? 1 : 0;
-    int inttyp = 3; 
-
-    int im     = -1;
-    if      (init_state.IsNuP    ()) im = 1; 
-    else if (init_state.IsNuN    ()) im = 2; 
-    else if (init_state.IsNuBarP ()) im = 3; 
-    else if (init_state.IsNuBarN ()) im = 4; 
-    else return;
-
-    GHepParticle * neutrino = event.Probe();
-    assert(neutrino);
-    GHepParticle * target = event.Particle(1);
-    assert(target);
-    GHepParticle * fsl = event.FinalStatePrimaryLepton();
-    assert(fsl);
-    GHepParticle * hitnucl = event.HitNucleon();
-    assert(hitnucl);
-
-    int nupdg  = neutrino->Pdg();
-    int fslpdg = fsl->Pdg();
-    int A      = target->A();
-    int Z      = target->Z();
-
-    const TLorentzVector & k1 = *(neutrino->P4());  // v 4-p (k1)
-    const TLorentzVector & k2 = *(fsl->P4());       // l 4-p (k2)
+  int ccnc   = is_cc ? 1 : 0;
+  int inttyp = 3; 
+
+  int im     = -1;
+  if      (init_state.IsNuP    ()) im = 1; 
+  else if (init_state.IsNuN    ()) im = 2; 
+  else if (init_state.IsNuBarP ()) im = 3; 
+  else if (init_state.IsNuBarN ()) im = 4; 
+  else return;
+
+  GHepParticle * neutrino = event.Probe();
+  assert(neutrino);
+  GHepParticle * target = event.Particle(1);
+  assert(target);
+  GHepParticle * fsl = event.FinalStatePrimaryLepton();
+  assert(fsl);
+  GHepParticle * hitnucl = event.HitNucleon();
+  assert(hitnucl);
+
+  int nupdg  = neutrino->Pdg();
+  int fslpdg = fsl->Pdg();
+  int A      = target->A();
+  int Z      = target->Z();
+
+  const TLorentzVector & k1 = *(neutrino->P4());  // v 4-p (k1)
+  const TLorentzVector & k2 = *(fsl->P4());       // l 4-p (k2)
 //  const TLorentzVector & p1 = *(hitnucl->P4());   // N 4-p (p1)      
 //  const TLorentzVector & ph = *(hadsyst->P4());   // had-syst 4-p 
-  
-    TLorentzVector ph;
-    if(is_dis) {
-      GHepParticle * hadsyst = event.FinalStateHadronicSystem();
-      assert(hadsyst);
-      ph = *(hadsyst->P4());
-    }   
-    if(is_res) {
-      GHepParticle * hadres = event.Particle(hitnucl->FirstDaughter());
-      ph = *(hadres->P4());
-    }
-   
-    const Kinematics & kine = interaction->Kine();
-    bool get_selected = true;
-    double x  = kine.x (get_selected);
-    double y  = kine.y (get_selected);
-    double W  = kine.W (get_selected);
-
-    int hadmod  = -1;
-    int ihadmom = -1;
-    TIter event_iter(&event);
-    GHepParticle * p = 0;
-    int i=-1;
-    while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
-      i++;
-      int pdg = p->Pdg();
-      if (pdg == kPdgHadronicSyst )  { hadmod= 2; ihadmom=i; }
-      if (pdg == kPdgString       )  { hadmod=11; ihadmom=i; }
-      if (pdg == kPdgCluster      )  { hadmod=12; ihadmom=i; }
-      if (pdg == kPdgIndep        )  { hadmod=13; ihadmom=i; }
-    }
-
-    output << endl;
-    output << iev    << "\t"  
-           << nupdg  << "\t"  << ccnc << "\t"  << im << "\t"  
-           << A      << "\t"  << Z << endl;
-    output << inttyp << "\t" << x << "\t" << y << "\t" << W << "\t" 
-           << hadmod << endl;
-    output << nupdg       << "\t"
-           << k1.Px()     << "\t" << k1.Py() << "\t" << k1.Pz() << "\t"
-           << k1.Energy() << "\t" << k1.M()  << endl;
-    output << fslpdg      << "\t"
-           << k2.Px()     << "\t" << k2.Py() << "\t" << k2.Pz() << "\t"
-           << k2.Energy() << "\t" << k2.M()  << endl;
-    output << 111111 << "\t"
-           << ph.Px()     << "\t" << ph.Py() << "\t" << ph.Pz() << "\t"
-           << ph.Energy() << "\t" << ph.M()  << endl;
-
-    vector<int> hadv;
 
-    event_iter.Reset();
-    i=-1;
-    while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
-      i++;
-      if(i<ihadmom) continue;
-
-      GHepStatus_t ist = p->Status();
-      int pdg = p->Pdg();
-
-      if(ist == kIStDISPreFragmHadronicState) continue;
-
-      if(ist == kIStStableFinalState) {
-        GHepParticle * mom = event.Particle(p->FirstMother());
-        GHepStatus_t mom_ist = mom->Status();
-        int mom_pdg = mom->Pdg();
-        bool skip = (mom_pdg == kPdgPi0 && mom_ist== kIStDecayedState);
-        if(!skip) { hadv.push_back(i); }
-      }
+  TLorentzVector ph;
+  if(is_dis) {
+    GHepParticle * hadsyst = event.FinalStateHadronicSystem();
+    assert(hadsyst);
+    ph = *(hadsyst->P4());
+  }   
+  if(is_res) {
+    GHepParticle * hadres = event.Particle(hitnucl->FirstDaughter());
+    ph = *(hadres->P4());
+  }
+ 
+  const Kinematics & kine = interaction->Kine();
+  bool get_selected = true;
+  double x  = kine.x (get_selected);
+  double y  = kine.y (get_selected);
+  double W  = kine.W (get_selected);
+
+  int hadmod  = -1;
+  int ihadmom = -1;
+  TIter event_iter(&event);
+  GHepParticle * p = 0;
+  int i=-1;
+  while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
+    i++;
+    int pdg = p->Pdg();
+    if (pdg == kPdgHadronicSyst )  { hadmod= 2; ihadmom=i; }
+    if (pdg == kPdgString       )  { hadmod=11; ihadmom=i; }
+    if (pdg == kPdgCluster      )  { hadmod=12; ihadmom=i; }
+    if (pdg == kPdgIndep        )  { hadmod=13; ihadmom=i; }
+  }
 
-      if(pdg==kPdgPi0 && ist==kIStDecayedState) { hadv.push_back(i); }
+  output << endl;
+  output << iev    << "\t"  
+         << nupdg  << "\t"  << ccnc << "\t"  << im << "\t"  
+         << A      << "\t"  << Z << endl;
+  output << inttyp << "\t" << x << "\t" << y << "\t" << W << "\t" 
+         << hadmod << endl;
+  output << nupdg       << "\t"
+         << k1.Px()     << "\t" << k1.Py() << "\t" << k1.Pz() << "\t"
+         << k1.Energy() << "\t" << k1.M()  << endl;
+  output << fslpdg      << "\t"
+         << k2.Px()     << "\t" << k2.Py() << "\t" << k2.Pz() << "\t"
+         << k2.Energy() << "\t" << k2.M()  << endl;
+  output << 111111 << "\t"
+         << ph.Px()     << "\t" << ph.Py() << "\t" << ph.Pz() << "\t"
+         << ph.Energy() << "\t" << ph.M()  << endl;
+
+  vector<int> hadv;
+
+  event_iter.Reset();
+  i=-1;
+  while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
+    i++;
+    if(i<ihadmom) continue;
+
+    GHepStatus_t ist = p->Status();
+    int pdg = p->Pdg();
+
+    if(ist == kIStDISPreFragmHadronicState) continue;
+
+    if(ist == kIStStableFinalState) {
+      GHepParticle * mom = event.Particle(p->FirstMother());
+      GHepStatus_t mom_ist = mom->Status();
+      int mom_pdg = mom->Pdg();
+      bool skip = (mom_pdg == kPdgPi0 && mom_ist== kIStDecayedState);
+      if(!skip) { hadv.push_back(i); }
     }
 
-    output << hadv.size() << endl;
+    if(pdg==kPdgPi0 && ist==kIStDecayedState) { hadv.push_back(i); }
+  }
+
+  output << hadv.size() << endl;
 
 #ifdef __GHAD_NTP__
-    brIev = (int) iev;   
-    brW   = W;  
-    brN   = hadv.size();
-    int k=0;
+  brIev = (int) iev;   
+  brW   = W;  
+  brN   = hadv.size();
+  int k=0;
 #endif
 
-    vector<int>::const_iterator hiter = hadv.begin();
-    for( ; hiter != hadv.end(); ++hiter) {
-      int id = *hiter;
-      GHepParticle * particle = event.Particle(id);
-      int pdg = particle->Pdg();
-      double px = particle->P4()->Px();
-      double py = particle->P4()->Py();
-      double pz = particle->P4()->Pz();
-      double E  = particle->P4()->Energy();
-      double m  = particle->P4()->M();
-      output << pdg << "\t" 
-             << px  << "\t" << py << "\t" << pz << "\t"
-             << E   << "\t" << m  << endl;
+  vector<int>::const_iterator hiter = hadv.begin();
+  for( ; hiter != hadv.end(); ++hiter) {
+    int id = *hiter;
+    GHepParticle * particle = event.Particle(id);
+    int pdg = particle->Pdg();
+    double px = particle->P4()->Px();
+    double py = particle->P4()->Py();
+    double pz = particle->P4()->Pz();
+    double E  = particle->P4()->Energy();
+    double m  = particle->P4()->M();
+    output << pdg << "\t" 
+           << px  << "\t" << py << "\t" << pz << "\t"
+           << E   << "\t" << m  << endl;
 
 #ifdef __GHAD_NTP__
-      brPx[k]  = px;
-      brPy[k]  = py;
-      brPz[k]  = pz;
-      brE[k]   = E;
-      brPdg[k] = pdg;
-      k++;
+    brPx[k]  = px;
+    brPy[k]  = py;
+    brPz[k]  = pz;
+    brE[k]   = E;
+    brPdg[k] = pdg;
+    k++;
 #endif
-    }
+  }
 
 #ifdef __GHAD_NTP__
-    ghad->Fill();
+  ghad->Fill();
 #endif
-
-    mcrec->Clear();
-
-  } // event loop
-
+}
+//____________________________________________________________________________________
+void GNtpcGHadConverter::End(TFile & /*fin*/, TTree * /*gtree*/)
+{
   output.close();
-  fin.Close();
 
 #ifdef __GHAD_NTP__
   ghad->Write("ghad");
-  fout.Write();
-  fout.Close();
+  fout->Write();
+  fout->Close();
+  delete fout;
 #endif
 
   LOG("gntpc", pINFO) << "\nDone converting GENIE's GHEP ntuple";
@@ -2851,8 +2838,17 @@ void ConvertToGHad(void)
 //____________________________________________________________________________________
 // GENIE GHEP EVENT TREE -> Summary tree for INTRANUKE studies 
 //____________________________________________________________________________________
-void ConvertToGINuke(void)
+class GNtpcGINukeConverter : public GNtpcConverter
 {
+public:
+  GNtpcGINukeConverter(GNtpcFmt_t fmt, string filename, int vrs) :
+    GNtpcConverter(fmt, filename, vrs) { }
+
+  void Begin   (TFile & fin, TTree * gtree, NtpMCTreeHeader * thdr);
+  void Convert (Long64_t iev, NtpMCEventRecord * mcrec);
+  void End     (TFile & fin, TTree * gtree);
+
+private:
   //-- output tree branch variables
   //
   int    brIEv        = 0;  // Event number
@@ -2883,13 +2879,20 @@ void ConvertToGINuke(void)
   int    brNpim       = 0;  // Number of final state pi-
   int    brNpi0       = 0;  // Number of final state pi0
 
+
+  TFile * fout;      // output file
+  TTree * tEvtTree;  // output summary tree
+};
+//____________________________________________________________________________________
+void GNtpcGINukeConverter::Begin(TFile & /*fin*/, TTree * /*gtree*/, NtpMCTreeHeader * /*thdr*/)
+{
   //-- open output file & create output summary tree & create the tree branches
   //
   LOG("gntpc", pNOTICE)
-       << "*** Saving summary tree to: " << gOptOutFileName;
-  TFile fout(gOptOutFileName.c_str(),"recreate");
+       << "*** Saving summary tree to: " << fOutFileName;
+  fout = new TFile(fOutFileName.c_str(),"recreate");
    
-TTree * tEvtTree = new TTree("ginuke","GENIE INuke Summary Tree");
+  tEvtTree = new TTree("ginuke","GENIE INuke Summary Tree");
   assert(tEvtTree);
 
   //-- create tree branches
@@ -2922,144 +2925,380 @@ TTree * tEvtTree = new TTree("ginuke","GENIE INuke Summary Tree");
   tEvtTree->Branch("npim",      &brNpim,         "npim/I"      );
   tEvtTree->Branch("npi0",      &brNpi0,         "npi0/I"      );
 
+}
+//____________________________________________________________________________________
+void GNtpcGINukeConverter::Convert(Long64_t iev, NtpMCEventRecord * mcrec)
+{
+  brIEv = iev; 
+  NtpMCRecHeader rec_header = mcrec->hdr;
+  EventRecord &  event      = *(mcrec->event);
+
+  LOG("gntpc", pINFO) << rec_header;
+  LOG("gntpc", pINFO) << event;
+
+  // analyze current event and fill the summary ntuple
+
+  // clean-up arrays
+  //
+  for(int j=0; j<kNPmax; j++) {
+     brPdgh[j] = 0;
+     brEh  [j] = 0;
+     brPxh [j] = 0;
+     brPyh [j] = 0;
+     brPzh [j] = 0;
+     brMh  [j] = 0;
+  }
+
+  //
+  // convert the current event
+  //
+
+  GHepParticle * probe  = event.Particle(0);
+  GHepParticle * target = event.Particle(1);
+  assert(probe && target);
+
+  brProbe    = probe  -> Pdg();
+  brTarget   = target -> Pdg();
+  brKE       = probe  -> KinE();
+  brE        = probe  -> E();
+  brP        = probe  -> P4()->Vect().Mag();
+  brTgtA     = pdg::IonPdgCodeToA(target->Pdg()); 
+  brTgtZ     = pdg::IonPdgCodeToZ(target->Pdg());
+  brVtxX     = probe  -> Vx();
+  brVtxY     = probe  -> Vy();
+  brVtxZ     = probe  -> Vz();
+  brProbeFSI = probe  -> RescatterCode(); 
+  GHepParticle * rescattered_hadron  = event.Particle(probe->FirstDaughter());
+  assert(rescattered_hadron);
+  if(rescattered_hadron->Status() == kIStStableFinalState) {
+      brDist = -1; // hadron escaped nucleus before interacting;
+  }
+  else {
+    double x  = rescattered_hadron->Vx();
+    double y  = rescattered_hadron->Vy();
+    double z  = rescattered_hadron->Vz();
+    double d2 = TMath::Power(brVtxX-x,2) +
+                TMath::Power(brVtxY-y,2) +
+                TMath::Power(brVtxZ-z,2);
+    brDist = TMath::Sqrt(d2);
+  }
+
+  brNp       = 0;
+  brNn       = 0;
+  brNpip     = 0;
+  brNpim     = 0;
+  brNpi0     = 0;
+
+  int i=0;
+  GHepParticle * p = 0;
+  TIter event_iter(&event);
+  while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
+     if(pdg::IsPseudoParticle(p->Pdg())) continue;
+     if(p->Status() != kIStStableFinalState) continue;
+
+     brPdgh[i] = p->Pdg();
+     brEh  [i] = p->E();
+     brPxh [i] = p->Px();
+     brPyh [i] = p->Py();
+     brPzh [i] = p->Pz();
+     brPh  [i] =
+       TMath::Sqrt(brPxh[i]*brPxh[i]+brPyh[i]*brPyh[i]
+                   +brPzh[i]*brPzh[i]);
+     brCosth[i] = brPzh[i]/brPh[i];
+     brMh  [i] = p->Mass();
+
+     if ( p->Pdg() == kPdgProton  ) brNp++;
+     if ( p->Pdg() == kPdgNeutron ) brNn++;
+     if ( p->Pdg() == kPdgPiP     ) brNpip++;
+     if ( p->Pdg() == kPdgPiM     ) brNpim++;
+     if ( p->Pdg() == kPdgPi0     ) brNpi0++;
+
+     i++;
+  }
+  brNh = i;
+  
+  ///////////////Test Code///////////////////////
+  int tempProbeFSI = brProbeFSI;
+  brProbeFSI = HAProbeFSI(tempProbeFSI, brProbe, brNh, brEh, brPdgh, brNpip, brNpim, brNpi0);
+  //////////////End Test///////////////////////// 
+
+
+  // fill the summary tree
+  tEvtTree->Fill();
+}
+//____________________________________________________________________________________
+void GNtpcGINukeConverter::End(TFile & /*fin*/, TTree * /*gtree*/)
+{
+  fout->Write();
+  fout->Close();
+  delete fout;
+
+  LOG("gntpc", pINFO) << "\nDone converting GENIE's GHEP ntuple";
+}
+//____________________________________________________________________________________
+// DRIVING THE CONVERSION
+//____________________________________________________________________________________
+GNtpcConverter * CreateConverter(GNtpcFmt_t fmt, string filename)
+{
+  int vrs = (gOptVersion < 0) ? LatestFormatVersionNumber(fmt) : gOptVersion;
+
+  switch(fmt) {
+
+   case (kConvFmt_gst)  :
+
+	return new GNtpcGSTConverter(fmt, filename, vrs);
+
+   case (kConvFmt_gxml) :  
+
+	return new GNtpcGXMLConverter(fmt, filename, vrs);
+
+   case (kConvFmt_ghep_mock_data) :  
+
+	return new GNtpcGHepMockConverter(fmt, filename, vrs);
+
+   case (kConvFmt_rootracker          ) :  
+   case (kConvFmt_rootracker_mock_data) :  
+   case (kConvFmt_t2k_rootracker      ) :  
+   case (kConvFmt_numi_rootracker     ) :  
+
+	return new GNtpcGRooTrackerConverter(fmt, filename, vrs);
+
+   case (kConvFmt_t2k_tracker   )  :  
+   case (kConvFmt_nuance_tracker)  :  
+
+	return new GNtpcGTrackerConverter(fmt, filename, vrs);
+
+   case (kConvFmt_ghad) :  
+
+	return new GNtpcGHadConverter(fmt, filename, vrs);
+
+   case (kConvFmt_ginuke) :  
+
+	return new GNtpcGINukeConverter(fmt, filename, vrs);
+
+   default:
+     LOG("gntpc", pFATAL)
+          << "Invalid output format [" << fmt << "]";
+     PrintSyntax();
+     gAbortingInErr = true;
+     exit(3);
+  }
+  return 0;
+}
+//____________________________________________________________________________________
+void ConvertEvents(Long64_t first, Long64_t last, const vector<string> & filenames)
+{
+// Converts the input events in [first,last] to all requested output formats,
+// reading the input event tree only once
+
   //-- open the ROOT file and get the TTree & its header
   TFile fin(gOptInpFileName.c_str(),"READ");
-  TTree *           er_tree = 0;
-  NtpMCTreeHeader * thdr    = 0;
-  er_tree = dynamic_cast <TTree *>           ( fin.Get("gtree")  );
-  thdr    = dynamic_cast <NtpMCTreeHeader *> ( fin.Get("header") );
-  if (!er_tree) {
-    LOG("gntpc", pERROR) << "Null input tree";
-    return;
+  TTree *           gtree = 0;
+  NtpMCTreeHeader * thdr  = 0;
+  gtree = dynamic_cast <TTree *>           ( fin.Get("gtree")  );
+  thdr  = dynamic_cast <NtpMCTreeHeader *> ( fin.Get("header") );
+  if (!gtree || !thdr) {
+    LOG("gntpc", pFATAL) << "Null input GHEP event tree or tree header";
+    gAbortingInErr = true;
+    exit(1);
   }
   LOG("gntpc", pINFO) << "Input tree header: " << *thdr;
 
+  gFileMajorVrs = utils::system::GenieMajorVrsNum(thdr->cvstag.GetString().Data());
+  gFileMinorVrs = utils::system::GenieMinorVrsNum(thdr->cvstag.GetString().Data());
+  gFileRevisVrs = utils::system::GenieRevisVrsNum(thdr->cvstag.GetString().Data());
+
   //-- get the mc record
   NtpMCEventRecord * mcrec = 0;
-  er_tree->SetBranchAddress("gmcrec", &mcrec);
+  gtree->SetBranchAddress("gmcrec", &mcrec);
   if (!mcrec) {
-    LOG("gntpc", pERROR) << "Null MC record";
-    return;
+    LOG("gntpc", pFATAL) << "Null MC record";
+    gAbortingInErr = true;
+    exit(1);
   }
 
-  //-- figure out how many events to analyze
-  Long64_t nmax = (gOptN<0) ?
-       er_tree->GetEntries() : TMath::Min( er_tree->GetEntries(), gOptN );
-  if (nmax<0) {
-    LOG("gntpc", pERROR) << "Number of events = 0";
-    return;
+  //-- create and initialize the converters for all requested formats
+  vector<GNtpcConverter *> converters;
+  for(unsigned int i = 0; i < gOptOutFileFormats.size(); i++) {
+    converters.push_back( CreateConverter(gOptOutFileFormats[i], filenames[i]) );
+  }
+  for(unsigned int i = 0; i < converters.size(); i++) {
+    converters[i]->Begin(fin, gtree, thdr);
   }
-  LOG("gntpc", pNOTICE) << "*** Analyzing: " << nmax << " events";
-
-  for(Long64_t iev = 0; iev < nmax; iev++) {
-    brIEv = iev; 
-    er_tree->GetEntry(iev);
-    NtpMCRecHeader rec_header = mcrec->hdr;
-    EventRecord &  event      = *(mcrec->event);
-
-    LOG("gntpc", pINFO) << rec_header;
-    LOG("gntpc", pINFO) << event;
-
-    // analyze current event and fill the summary ntuple
 
-    // clean-up arrays
-    //
-    for(int j=0; j<kNPmax; j++) {
-       brPdgh[j] = 0;
-       brEh  [j] = 0;
-       brPxh [j] = 0;
-       brPyh [j] = 0;
-       brPzh [j] = 0;
-       brMh  [j] = 0;
+  //-- event loop
+  for(Long64_t iev = first; iev <= last; iev++) {
+    gtree->GetEntry(iev);
+    for(unsigned int i = 0; i < converters.size(); i++) {
+      converters[i]->Convert(iev, mcrec);
     }
+    mcrec->Clear();
+  } // event loop
 
-    //
-    // convert the current event
-    //
+  for(unsigned int i = 0; i < converters.size(); i++) {
+    converters[i]->End(fin, gtree);
+    delete converters[i];
+  }
 
-    GHepParticle * probe  = event.Particle(0);
-    GHepParticle * target = event.Particle(1);
-    assert(probe && target);
-
-    brProbe    = probe  -> Pdg();
-    brTarget   = target -> Pdg();
-    brKE       = probe  -> KinE();
-    brE        = probe  -> E();
-    brP        = probe  -> P4()->Vect().Mag();
-    brTgtA     = pdg::IonPdgCodeToA(target->Pdg()); 
-    brTgtZ     = pdg::IonPdgCodeToZ(target->Pdg());
-    brVtxX     = probe  -> Vx();
-    brVtxY     = probe  -> Vy();
-    brVtxZ     = probe  -> Vz();
-    brProbeFSI = probe  -> RescatterCode(); 
-    GHepParticle * rescattered_hadron  = event.Particle(probe->FirstDaughter());
-    assert(rescattered_hadron);
-    if(rescattered_hadron->Status() == kIStStableFinalState) {
-        brDist = -1; // hadron escaped nucleus before interacting;
-    }
-    else {
-      double x  = rescattered_hadron->Vx();
-      double y  = rescattered_hadron->Vy();
-      double z  = rescattered_hadron->Vz();
-      double d2 = TMath::Power(brVtxX-x,2) +
-                  TMath::Power(brVtxY-y,2) +
-                  TMath::Power(brVtxZ-z,2);
-      brDist = TMath::Sqrt(d2);
-    }
+  fin.Close();
+}
+//____________________________________________________________________________________
+void ConvertInChunks(Long64_t nev)
+{
+// Splits the input events in contiguous chunks, each converted by a separate
+// worker process to temporary output files, which are merged in order at the end.
+// Processes are used rather than threads as the converters rely on singletons
+// (RandomGen, Messenger, ...) which are not thread-safe.
 
-    brNp       = 0;
-    brNn       = 0;
-    brNpip     = 0;
-    brNpim     = 0;
-    brNpi0     = 0;
-
-    int i=0;
-    GHepParticle * p = 0;
-    TIter event_iter(&event);
-    while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
-       if(pdg::IsPseudoParticle(p->Pdg())) continue;
-       if(p->Status() != kIStStableFinalState) continue;
-
-       brPdgh[i] = p->Pdg();
-       brEh  [i] = p->E();
-       brPxh [i] = p->Px();
-       brPyh [i] = p->Py();
-       brPzh [i] = p->Pz();
-       brPh  [i] =
-         TMath::Sqrt(brPxh[i]*brPxh[i]+brPyh[i]*brPyh[i]
-                     +brPzh[i]*brPzh[i]);
-       brCosth[i] = brPzh[i]/brPh[i];
-       brMh  [i] = p->Mass();
-
-       if ( p->Pdg() == kPdgProton  ) brNp++;
-       if ( p->Pdg() == kPdgNeutron ) brNn++;
-       if ( p->Pdg() == kPdgPiP     ) brNpip++;
-       if ( p->Pdg() == kPdgPiM     ) brNpim++;
-       if ( p->Pdg() == kPdgPi0     ) brNpi0++;
-
-       i++;
-    }
-    brNh = i;
-    
-    ///////////////Test Code///////////////////////
-    int tempProbeFSI = brProbeFSI;
-    brProbeFSI = HAProbeFSI(tempProbeFSI, brProbe, brNh, brEh, brPdgh, brNpip, brNpim, brNpi0);
-    //////////////End Test///////////////////////// 
+  int nchunks = (int) TMath::Min( (Long64_t)gOptNWorkers, nev );
 
+  LOG("gntpc", pNOTICE) 
+     << "*** Converting in " << nchunks << " chunks, in parallel worker processes";
 
-    // fill the summary tree
-    tEvtTree->Fill();
+  vector<pid_t> workers;
+  for(int ic = 0; ic < nchunks; ic++) {
+    Long64_t first = (nev *  ic   ) / nchunks;
+    Long64_t last  = (nev * (ic+1)) / nchunks - 1;
 
-    mcrec->Clear();
+    std::cout.flush();
+    fflush(stdout);
+    fflush(stderr);
 
-  } // event loop
+    pid_t pid = fork();
+    if(pid < 0) {
+      LOG("gntpc", pFATAL) << "Could not start worker process for chunk " << ic;
+      gAbortingInErr = true;
+      exit(1);
+    }
+    if(pid == 0) {
+      // worker process
+      gIsFirstChunk = (ic == 0);
+      gIsLastChunk  = (ic == nchunks-1);
+      if(ic > 0) {
+        // each chunk gets its own random number sequence
+        RandomGen * rnd = RandomGen::Instance();
+        rnd->SetSeed(rnd->GetSeed() + ic);
+      }
+      LOG("gntpc", pNOTICE) 
+         << "*** Chunk " << ic << ": converting events " << first << " - " << last;
+      vector<string> filenames;
+      for(unsigned int i = 0; i < gOptOutFileNames.size(); i++) {
+        filenames.push_back( ChunkFileName(gOptOutFileNames[i], ic) );
+      }
+      ConvertEvents(first, last, filenames);
+      // the outputs are closed by ConvertEvents(): leave without running
+      // the static destructors & atexit handlers inherited from the parent
+      std::cout.flush();
+      std::cerr.flush();
+      fflush(stdout);
+      fflush(stderr);
+      _exit(0);
+    }
+    workers.push_back(pid);
+  }
 
-  fin.Close();
+  //-- wait for all workers to finish
+  bool ok = true;
+  for(int ic = 0; ic < nchunks; ic++) {
+    int status = 0;
+    waitpid(workers[ic], &status, 0);
+    if(!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+      LOG("gntpc", pERROR) << "Worker process for chunk " << ic << " failed";
+      ok = false;
+    }
+  }
+  if(!ok) {
+    LOG("gntpc", pFATAL) << "Conversion failed";
+    gAbortingInErr = true;
+    exit(1);
+  }
 
-  fout.Write();
-  fout.Close();
+  //-- merge the chunks of each output file
+  for(unsigned int i = 0; i < gOptOutFileFormats.size(); i++) {
+    MergeChunks(gOptOutFileFormats[i], gOptOutFileNames[i], nchunks);
+  }
+}
+//____________________________________________________________________________________
+void MergeChunks(GNtpcFmt_t fmt, string filename, int nchunks)
+{
+  LOG("gntpc", pNOTICE) 
+     << "*** Merging " << nchunks << " chunks into: " << filename;
+
+  if(IsRootFormat(fmt)) {
+    // ROOT formats: the trees of all chunks are chained and fast-cloned in
+    // order (keeping the weight & user info of the first chunk), any other
+    // object (eg job metadata) is copied from the first chunk
+    TFile * fchunk = TFile::Open(ChunkFileName(filename,0).c_str(), "READ");
+    if(!fchunk || fchunk->IsZombie()) {
+      LOG("gntpc", pFATAL) << "Could not read chunk file for: " << filename;
+      gAbortingInErr = true;
+      exit(1);
+    }
+    TFile fout(filename.c_str(), "RECREATE");
+    vector<string> done;
+    TIter next(fchunk->GetListOfKeys());
+    TKey * key = 0;
+    while( (key = (TKey *) next()) ) {
+      // keys are sorted by decreasing cycle number: keep the latest one
+      string name = key->GetName();
+      if(std::find(done.begin(), done.end(), name) != done.end()) continue;
+      done.push_back(name);
+
+      TClass * cl = TClass::GetClass(key->GetClassName());
+      if(cl && cl->InheritsFrom(TTree::Class())) {
+        TChain chain(name.c_str());
+        for(int ic = 0; ic < nchunks; ic++) {
+          chain.Add( ChunkFileName(filename,ic).c_str() );
+        }
+        chain.LoadTree(0);
+        fout.cd();
+        chain.CloneTree(-1,"fast");
+      } else {
+        TObject * obj = key->ReadObj();
+        fout.cd();
+        obj->Write(name.c_str());
+      }
+    }
+    fout.Write();
+    fout.Close();
+    fchunk->Close();
+    delete fchunk;
+  } else {
+    // text formats: the chunks are concatenated in order
+    ofstream output(filename.c_str(), ios::out | ios::binary);
+    for(int ic = 0; ic < nchunks; ic++) {
+      ifstream input(ChunkFileName(filename,ic).c_str(), ios::in | ios::binary);
+      if(!input) {
+        LOG("gntpc", pFATAL) << "Could not read chunk " << ic << " of: " << filename;
+        gAbortingInErr = true;
+        exit(1);
+      }
+      if(input.peek() != EOF) output << input.rdbuf();
+    }
+    output.close();
+  }
 
-  LOG("gntpc", pINFO) << "\nDone converting GENIE's GHEP ntuple";
+  for(int ic = 0; ic < nchunks; ic++) {
+    gSystem->Unlink( ChunkFileName(filename,ic).c_str() );
+  }
+}
+//____________________________________________________________________________________
+string ChunkFileName(string filename, int ichunk)
+{
+  ostringstream name;
+  name << filename << ".chunk" << ichunk;
+  return name.str();
+}
+//____________________________________________________________________________________
+bool IsRootFormat(GNtpcFmt_t fmt)
+{
+  return (fmt == kConvFmt_gst                  ||
+          fmt == kConvFmt_ghep_mock_data       ||
+          fmt == kConvFmt_rootracker           ||
+          fmt == kConvFmt_rootracker_mock_data ||
+          fmt == kConvFmt_t2k_rootracker       ||
+          fmt == kConvFmt_numi_rootracker      ||
+          fmt == kConvFmt_ginuke);
 }
 //____________________________________________________________________________________
 // FUNCTIONS FOR PARSING CMD-LINE ARGUMENTS 
@@ -3095,44 +3334,70 @@ void GetCommandLineArgs(int argc, char ** argv)
     exit(2);
   }
 
-  // get output file format
+  // get output file format(s)
+  vector<string> fmtv;
   if( parser.OptionExists('f') ) {
-    LOG("gntpc", pINFO) << "Reading output file format";
-    string fmt = parser.ArgAsString('f');
-
-         if (fmt == "gst")                   { gOptOutFileFormat = kConvFmt_gst;                   }
-    else if (fmt == "gxml")                  { gOptOutFileFormat = kConvFmt_gxml;                  }
-    else if (fmt == "ghep_mock_data")        { gOptOutFileFormat = kConvFmt_ghep_mock_data;        }
-    else if (fmt == "rootracker")            { gOptOutFileFormat = kConvFmt_rootracker;            }
-    else if (fmt == "rootracker_mock_data")  { gOptOutFileFormat = kConvFmt_rootracker_mock_data;  }
-    else if (fmt == "t2k_rootracker")        { gOptOutFileFormat = kConvFmt_t2k_rootracker;        }
-    else if (fmt == "numi_rootracker")       { gOptOutFileFormat = kConvFmt_numi_rootracker;       }
-    else if (fmt == "t2k_tracker")           { gOptOutFileFormat = kConvFmt_t2k_tracker;           }
-    else if (fmt == "nuance_tracker" )       { gOptOutFileFormat = kConvFmt_nuance_tracker;        }
-    else if (fmt == "ghad")                  { gOptOutFileFormat = kConvFmt_ghad;                  }
-    else if (fmt == "ginuke")                { gOptOutFileFormat = kConvFmt_ginuke;                }
-    else                                     { gOptOutFileFormat = kConvFmt_undef;                 }
-
-    if(gOptOutFileFormat == kConvFmt_undef) {
-      LOG("gntpc", pFATAL) << "Unknown output file format (" << fmt << ")";
-      gAbortingInErr = true;
-      exit(3);
+    LOG("gntpc", pINFO) << "Reading output file format(s)";
+    fmtv = parser.ArgAsStringTokens('f', ",");
+    for(unsigned int i = 0; i < fmtv.size(); i++) {
+      string fmt = fmtv[i];
+      GNtpcFmt_t ofmt;
+
+           if (fmt == "gst")                   { ofmt = kConvFmt_gst;                              }
+      else if (fmt == "gxml")                  { ofmt = kConvFmt_gxml;                             }
+      else if (fmt == "ghep_mock_data")        { ofmt = kConvFmt_ghep_mock_data;                   }
+      else if (fmt == "rootracker")            { ofmt = kConvFmt_rootracker;                       }
+      else if (fmt == "rootracker_mock_data")  { ofmt = kConvFmt_rootracker_mock_data;             }
+      else if (fmt == "t2k_rootracker")        { ofmt = kConvFmt_t2k_rootracker;                   }
+      else if (fmt == "numi_rootracker")       { ofmt = kConvFmt_numi_rootracker;                  }
+      else if (fmt == "t2k_tracker")           { ofmt = kConvFmt_t2k_tracker;                      }
+      else if (fmt == "nuance_tracker" )       { ofmt = kConvFmt_nuance_tracker;                   }
+      else if (fmt == "ghad")                  { ofmt = kConvFmt_ghad;                             }
+      else if (fmt == "ginuke")                { ofmt = kConvFmt_ginuke;                           }
+      else                                     { ofmt = kConvFmt_undef;                            }
+
+      if(ofmt == kConvFmt_undef) {
+        LOG("gntpc", pFATAL) << "Unknown output file format (" << fmt << ")";
+        gAbortingInErr = true;
+        exit(3);
+      }
+      gOptOutFileFormats.push_back(ofmt);
     }
-
-  } else {
+  }
+  if(gOptOutFileFormats.size() == 0) {
     LOG("gntpc", pFATAL) << "Unspecified output file format";
     gAbortingInErr = true;
     exit(4);
   }
 
-  // get output file name 
+  // get output file name(s), one per output file format
   if( parser.OptionExists('o') ) {
-    LOG("gntpc", pINFO) << "Reading output filename";
-    gOptOutFileName = parser.ArgAsString('o');
+    LOG("gntpc", pINFO) << "Reading output filename(s)";
+    gOptOutFileNames = parser.ArgAsStringTokens('o', ",");
+    if(gOptOutFileNames.size() != gOptOutFileFormats.size()) {
+      LOG("gntpc", pFATAL) 
+         << "Got " << gOptOutFileNames.size() << " output filename(s) for " 
+         << gOptOutFileFormats.size() << " output file format(s)";
+      gAbortingInErr = true;
+      exit(5);
+    }
   } else {
     LOG("gntpc", pINFO)
        << "Unspecified output filename - Using default";
-    gOptOutFileName = DefaultOutputFile();
+    for(unsigned int i = 0; i < gOptOutFileFormats.size(); i++) {
+      gOptOutFileNames.push_back( DefaultOutputFile(gOptOutFileFormats[i]) );
+    }
+  }
+  for(unsigned int i = 0; i < gOptOutFileNames.size(); i++) {
+    for(unsigned int j = 0; j < i; j++) {
+      if(gOptOutFileNames[i] == gOptOutFileNames[j]) {
+        LOG("gntpc", pFATAL) 
+           << "Output filename [" << gOptOutFileNames[i] 
+           << "] used for more than one output file format";
+        gAbortingInErr = true;
+        exit(5);
+      }
+    }
   }
 
   // get number of events to convert
@@ -3153,15 +3418,21 @@ void GetCommandLineArgs(int argc, char ** argv)
        << "Using version number: " << gOptVersion;
   } else {
     LOG("gntpc", pINFO)
-       << "Unspecified version number - Use latest";
-    gOptVersion = LatestFormatVersionNumber();
-    LOG("gntpc", pINFO)
-       << "Latest version number: " << gOptVersion;
+       << "Unspecified version number - Use latest of each format";
+    gOptVersion = -1;
   }
 
   // check whether to copy MC job metadata (only if output file is in ROOT format)
   gOptCopyJobMeta = parser.OptionExists('c');
 
+  // number of worker processes
+  if( parser.OptionExists('j') ) {
+    LOG("gntpc", pINFO) << "Reading number of worker processes";
+    gOptNWorkers = TMath::Max(1, parser.ArgAsInt('j'));
+  } else {
+    gOptNWorkers = 1;
+  }
+
   // random number seed
   if( parser.OptionExists("seed") ) {
     LOG("gntpc", pINFO) << "Reading random number seed";
@@ -3172,31 +3443,36 @@ void GetCommandLineArgs(int argc, char ** argv)
   }
  
   LOG("gntpc", pNOTICE) << "Input filename  = " << gOptInpFileName;
-  LOG("gntpc", pNOTICE) << "Output filename = " << gOptOutFileName;
-  LOG("gntpc", pNOTICE) << "Conversion to format = " << gOptRanSeed 
-                        << ", vrs = " << gOptVersion;
+  for(unsigned int i = 0; i < fmtv.size(); i++) {
+    LOG("gntpc", pNOTICE) 
+       << "Conversion to format = " << fmtv[i] 
+       << ", vrs = " << ((gOptVersion < 0) ? 
+              LatestFormatVersionNumber(gOptOutFileFormats[i]) : gOptVersion)
+       << ", output filename = " << gOptOutFileNames[i];
+  }
   LOG("gntpc", pNOTICE) << "Number of events to be converted = " << gOptN;
   LOG("gntpc", pNOTICE) << "Copy metadata? = " << ((gOptCopyJobMeta) ? "Yes" : "No");
+  LOG("gntpc", pNOTICE) << "Number of worker processes = " << gOptNWorkers;
   LOG("gntpc", pNOTICE) << "Random number seed = " << gOptRanSeed;
 
   LOG("gntpc", pNOTICE) << *RunOpt::Instance();
 }
 //____________________________________________________________________________________
-string DefaultOutputFile(void)
+string DefaultOutputFile(GNtpcFmt_t fmt)
 {
   // filename extension - depending on file format
   string ext="";
-  if      (gOptOutFileFormat == kConvFmt_gst                  ) { ext = "gst.root";         }
-  else if (gOptOutFileFormat == kConvFmt_gxml                 ) { ext = "gxml";             }
-  else if (gOptOutFileFormat == kConvFmt_ghep_mock_data       ) { ext = "mockd.ghep.root";  }
-  else if (gOptOutFileFormat == kConvFmt_rootracker           ) { ext = "gtrac.root";       }
-  else if (gOptOutFileFormat == kConvFmt_rootracker_mock_data ) { ext = "mockd.gtrac.root"; }
-  else if (gOptOutFileFormat == kConvFmt_t2k_rootracker       ) { ext = "gtrac.root";       }
-  else if (gOptOutFileFormat == kConvFmt_numi_rootracker      ) { ext = "gtrac.root";       }
-  else if (gOptOutFileFormat == kConvFmt_t2k_tracker          ) { ext = "gtrac.dat";        }
-  else if (gOptOutFileFormat == kConvFmt_nuance_tracker       ) { ext = "gtrac_legacy.dat"; }
-  else if (gOptOutFileFormat == kConvFmt_ghad                 ) { ext = "ghad.dat";         }
-  else if (gOptOutFileFormat == kConvFmt_ginuke               ) { ext = "ginuke.root";      }
+  if      (fmt == kConvFmt_gst                  ) { ext = "gst.root";         }
+  else if (fmt == kConvFmt_gxml                 ) { ext = "gxml";             }
+  else if (fmt == kConvFmt_ghep_mock_data       ) { ext = "mockd.ghep.root";  }
+  else if (fmt == kConvFmt_rootracker           ) { ext = "gtrac.root";       }
+  else if (fmt == kConvFmt_rootracker_mock_data ) { ext = "mockd.gtrac.root"; }
+  else if (fmt == kConvFmt_t2k_rootracker       ) { ext = "gtrac.root";       }
+  else if (fmt == kConvFmt_numi_rootracker      ) { ext = "gtrac.root";       }
+  else if (fmt == kConvFmt_t2k_tracker          ) { ext = "gtrac.dat";        }
+  else if (fmt == kConvFmt_nuance_tracker       ) { ext = "gtrac_legacy.dat"; }
+  else if (fmt == kConvFmt_ghad                 ) { ext = "ghad.dat";         }
+  else if (fmt == kConvFmt_ginuke               ) { ext = "ginuke.root";      }
 
   string inpname = gOptInpFileName;
   unsigned int L = inpname.length();
@@ -3219,19 +3495,19 @@ string DefaultOutputFile(void)
   return gSystem->BaseName(name.str().c_str());
 }
 //____________________________________________________________________________________
-int LatestFormatVersionNumber(void)
+int LatestFormatVersionNumber(GNtpcFmt_t fmt)
 {
-  if      (gOptOutFileFormat == kConvFmt_gst                  ) return 1;
-  else if (gOptOutFileFormat == kConvFmt_gxml                 ) return 1;
-  else if (gOptOutFileFormat == kConvFmt_ghep_mock_data       ) return 1;
-  else if (gOptOutFileFormat == kConvFmt_rootracker           ) return 1;
-  else if (gOptOutFileFormat == kConvFmt_rootracker_mock_data ) return 1;
-  else if (gOptOutFileFormat == kConvFmt_t2k_rootracker       ) return 1;
-  else if (gOptOutFileFormat == kConvFmt_numi_rootracker      ) return 1;
-  else if (gOptOutFileFormat == kConvFmt_t2k_tracker          ) return 2;
-  else if (gOptOutFileFormat == kConvFmt_nuance_tracker       ) return 1;
-  else if (gOptOutFileFormat == kConvFmt_ghad                 ) return 1;
-  else if (gOptOutFileFormat == kConvFmt_ginuke               ) return 1;
+  if      (fmt == kConvFmt_gst                  ) return 1;
+  else if (fmt == kConvFmt_gxml                 ) return 1;
+  else if (fmt == kConvFmt_ghep_mock_data       ) return 1;
+  else if (fmt == kConvFmt_rootracker           ) return 1;
+  else if (fmt == kConvFmt_rootracker_mock_data ) return 1;
+  else if (fmt == kConvFmt_t2k_rootracker       ) return 1;
+  else if (fmt == kConvFmt_numi_rootracker      ) return 1;
+  else if (fmt == kConvFmt_t2k_tracker          ) return 2;
+  else if (fmt == kConvFmt_nuance_tracker       ) return 1;
+  else if (fmt == kConvFmt_ghad                 ) return 1;
+  else if (fmt == kConvFmt_ginuke               ) return 1;
 
   return -1;
 }
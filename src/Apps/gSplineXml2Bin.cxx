@@ -0,0 +1,141 @@
+//____________________________________________________________________________
+/*!
+
+\program gspl2bin
+
+\brief   Converts GENIE XML cross section spline files into the binary spline
+         format that XSecSplineList can memory-map.
+
+         Binary spline files can be used anywhere an XML spline file is
+         accepted (eg via the --cross-sections option of the event generation
+         applications). They are mapped read-only, so all jobs running on the
+         same node share a single copy, and each spline is only built when it
+         is first requested. The knots are stored as the double precision
+         values read from the XML input, so the conversion is lossless.
+
+         Syntax :
+           gspl2bin -f file_list -o output.bin
+                    [--message-thresholds xml_file]
+
+         Options :
+           -f
+              A list of input xml cross-section files. If more than one then
+              separate using commas. All splines (for all tunes) are merged
+              into a single binary output file.
+           -o
+              output binary file
+           --message-thresholds
+              Allows users to customize the message stream thresholds.
+              The thresholds are specified using an XML file.
+              See $GENIE/config/Messenger.xml for the XML schema.
+
+         Examples :
+
+           shell% gspl2bin -f gxspl-FNALsmall.xml -o gxspl-FNALsmall.bin
+
+\author  GENIE Collaboration
+
+\created October 16, 2026
+
+\cpright Copyright (c) 2003-2023, The GENIE Collaboration
+         For the full text of the license visit http://copyright.genie-mc.org
+
+*/
+//____________________________________________________________________________
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "Framework/Conventions/XmlParserStatus.h"
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Utils/RunOpt.h"
+#include "Framework/Utils/AppInit.h"
+#include "Framework/Utils/XSecSplineList.h"
+#include "Framework/Utils/StringUtils.h"
+#include "Framework/Utils/CmdLnArgParser.h"
+
+using std::string;
+using std::vector;
+
+using namespace genie;
+
+void GetCommandLineArgs (int argc, char ** argv);
+void PrintSyntax        (void);
+
+//User-specified options:
+string         gOutFile;   ///< output binary file
+vector<string> gInpFiles;  ///< list of input XML files
+
+//____________________________________________________________________________
+int main(int argc, char ** argv)
+{
+  GetCommandLineArgs(argc,argv);
+
+  utils::app_init::MesgThresholds(RunOpt::Instance()->MesgThresholdFiles());
+
+  XSecSplineList * xspl = XSecSplineList::Instance();
+
+  vector<string>::const_iterator file_iter = gInpFiles.begin();
+  for( ; file_iter != gInpFiles.end(); ++file_iter) {
+    string filename = *file_iter;
+    LOG("gspl2bin", pNOTICE) << " ---- >> Loading file : " << filename;
+    XmlParserStatus_t ist = xspl->LoadFromXml(filename, true);
+    if(ist != kXmlOK) {
+      LOG("gspl2bin", pFATAL)
+        << "Problem reading file: " << filename << " : "
+        << XmlParserStatus::AsString(ist);
+      exit(1);
+    }
+  }
+
+  LOG("gspl2bin", pNOTICE)
+     << " ****** Saving all loaded splines into : " << gOutFile;
+  bool ok = xspl->SaveAsBinary(gOutFile);
+  if(!ok) {
+    LOG("gspl2bin", pFATAL) << "Could not write: " << gOutFile;
+    exit(1);
+  }
+
+  return 0;
+}
+//____________________________________________________________________________
+void GetCommandLineArgs(int argc, char ** argv)
+{
+  LOG("gspl2bin", pNOTICE) << "Parsing command line arguments";
+
+  // Common run options.
+  RunOpt::Instance()->ReadFromCommandLine(argc,argv);
+
+  // Parse run options for this app
+
+  CmdLnArgParser parser(argc,argv);
+
+  if( parser.OptionExists('f') ) {
+    LOG("gspl2bin", pINFO) << "Reading input files";
+    string inpfiles = parser.ArgAsString('f');
+    gInpFiles = utils::str::Split(inpfiles, ",");
+  } else {
+    LOG("gspl2bin", pFATAL) << "You must specify at least one input file";
+    PrintSyntax();
+    exit(1);
+  }
+
+  if( parser.OptionExists('o') ) {
+    LOG("gspl2bin", pINFO) << "Reading output file name";
+    gOutFile = parser.ArgAsString('o');
+  } else {
+    LOG("gspl2bin", pFATAL) << "You must specify an output file name";
+    PrintSyntax();
+    exit(1);
+  }
+}
+//____________________________________________________________________________
+void PrintSyntax(void)
+{
+  LOG("gspl2bin", pNOTICE)
+    << "\n\n" << "Syntax:" << "\n"
+    << "   gspl2bin -f file_list -o output.bin\n"
+    << "            [--message-thresholds xml_file]\n";
+}
+//____________________________________________________________________________
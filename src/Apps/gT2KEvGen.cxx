@@ -442,6 +442,7 @@
 
 #include "Framework/Conventions/Units.h"
 #include "Framework/EventGen/EventRecord.h"
+#include "Framework/EventGen/EventRecordPool.h"
 #include "Framework/EventGen/GFluxI.h"
 #include "Framework/EventGen/GMCJDriver.h"
 #include "Framework/EventGen/GMCJMonitor.h"
@@ -863,7 +864,7 @@ int main(int argc, char ** argv)
      // Add event at the output ntuple, refresh the mc job monitor & clean-up
      ntpw.AddEventRecord(ievent, event);
      mcjmonitor.Update(ievent,event);
-     delete event;
+     EventRecordPool::Instance()->Release(event);
      if(flux_info) delete flux_info;
      ievent++;
   } //1
@@ -9,10 +9,19 @@
 //____________________________________________________________________________
 
 #include <cstring>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <fstream>
 #include <sstream>
 #include <cstdlib>
+#include <algorithm>
+#include <set>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "libxml/xmlmemory.h"
 #include "libxml/parser.h"
@@ -27,6 +36,8 @@
 #include "Framework/Messenger/Messenger.h"
 #include "Framework/Registry/RegistryItemTypeDef.h"
 #include "Framework/Utils/XmlParserUtils.h"
+#include "Framework/Utils/RunOpt.h"
+#include "Framework/Utils/TuneId.h"
 
 #include "Framework/Utils/StringUtils.h"
 
@@ -37,6 +48,163 @@ using std::ostringstream;
 
 using namespace genie;
 
+//____________________________________________________________________________
+// Configuration bundle layout (all integers in host byte order; a bundle
+// written on a host of different endianness fails the magic word check):
+//
+//   CfgBundleHeader                              (fixed size)
+//   CfgBundleEntry[nentries]                     (sorted by key)
+//   CfgBundleParam[nparams]                      (in XML order, per entry)
+//   char strings[strings_size]                   (keys, types, names, values)
+//
+// The checksum covers everything after the header.
+//
+namespace {
+
+  const char     kCfgBundleMagic[8] = { 'G','C','F','G','B','N','D','L' };
+  const uint32_t kCfgBundleVersion  = 1;
+
+  struct CfgBundleHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t nentries;
+    uint64_t nparams;
+    uint64_t index_offset;
+    uint64_t params_offset;
+    uint64_t strings_offset;
+    uint64_t strings_size;
+    uint64_t checksum;
+    uint32_t tune_offset;
+    uint32_t tune_length;
+  };
+
+  struct CfgBundleEntry {
+    uint32_t key_offset;
+    uint32_t key_length;
+    uint32_t first_param;
+    uint32_t nparams;
+  };
+
+  struct CfgBundleParam {
+    uint32_t type_offset;
+    uint32_t type_length;
+    uint32_t name_offset;
+    uint32_t name_length;
+    uint32_t value_offset;
+    uint32_t value_length;
+    uint32_t delim_offset;
+    uint32_t delim_length;
+  };
+
+  // FNV-1a, 64 bit
+  uint64_t CfgBundleChecksum(const char * data, size_t size)
+  {
+    uint64_t h = 14695981039346656037ULL;
+    for(size_t i = 0; i < size; i++) {
+      h ^= (unsigned char) data[i];
+      h *= 1099511628211ULL;
+    }
+    return h;
+  }
+
+  // Append a string to the string block and return its offset
+  uint32_t AddBundleString(string & strings, const string & str)
+  {
+    uint32_t offset = strings.size();
+    strings += str;
+    return offset;
+  }
+
+  bool InStrings(uint64_t offset, uint64_t length, uint64_t strings_size)
+  {
+    return offset <= strings_size && length <= strings_size - offset;
+  }
+
+  // Checks that every offset in a mapped bundle of the given size stays in
+  // the file, so that nothing read from it later can go out of bounds
+  bool ValidCfgBundle(
+     const CfgBundleHeader * header, size_t size, string & reason)
+  {
+    if(memcmp(header->magic, kCfgBundleMagic, sizeof(kCfgBundleMagic)) != 0 ||
+       header->version != kCfgBundleVersion) {
+      reason = "unknown format or version";
+      return false;
+    }
+    if(header->index_offset != sizeof(CfgBundleHeader) ||
+       header->nentries > (size - header->index_offset) / sizeof(CfgBundleEntry) ||
+       header->params_offset != header->index_offset + header->nentries * sizeof(CfgBundleEntry) ||
+       header->nparams > (size - header->params_offset) / sizeof(CfgBundleParam) ||
+       header->strings_offset != header->params_offset + header->nparams * sizeof(CfgBundleParam) ||
+       header->strings_size != size - header->strings_offset) {
+      reason = "inconsistent block layout";
+      return false;
+    }
+    const char * body = (const char *) header + header->index_offset;
+    if(CfgBundleChecksum(body, size - header->index_offset) != header->checksum) {
+      reason = "checksum mismatch";
+      return false;
+    }
+    uint64_t nstr = header->strings_size;
+    if(!InStrings(header->tune_offset, header->tune_length, nstr)) {
+      reason = "tune name out of bounds";
+      return false;
+    }
+    const CfgBundleEntry * index = (const CfgBundleEntry *)
+                              ((const char *) header + header->index_offset);
+    const CfgBundleParam * params = (const CfgBundleParam *)
+                              ((const char *) header + header->params_offset);
+    for(uint64_t ie = 0; ie < header->nentries; ie++) {
+      const CfgBundleEntry & e = index[ie];
+      if(!InStrings(e.key_offset, e.key_length, nstr) ||
+         e.first_param > header->nparams ||
+         e.nparams > header->nparams - e.first_param) {
+        reason = "parameter set out of bounds";
+        return false;
+      }
+    }
+    for(uint64_t ip = 0; ip < header->nparams; ip++) {
+      const CfgBundleParam & p = params[ip];
+      if(!InStrings(p.type_offset,  p.type_length,  nstr) ||
+         !InStrings(p.name_offset,  p.name_length,  nstr) ||
+         !InStrings(p.value_offset, p.value_length, nstr) ||
+         !InStrings(p.delim_offset, p.delim_length, nstr)) {
+        reason = "parameter out of bounds";
+        return false;
+      }
+    }
+    return true;
+  }
+
+} // anonymous namespace
+
+//____________________________________________________________________________
+struct AlgConfigPool::Bundle {
+
+  string                  filename;
+  void *                  addr;
+  size_t                  size;
+  const CfgBundleHeader * header;
+  const CfgBundleEntry *  index;
+  const CfgBundleParam *  params;
+  const char *            strings;
+
+  string String(uint32_t offset, uint32_t length) const {
+    return string(strings + offset, length);
+  }
+  const CfgBundleEntry * Find(const string & key) const {
+    uint64_t lo = 0, hi = header->nentries;
+    while(lo < hi) {
+      uint64_t mid = (lo + hi) / 2;
+      const CfgBundleEntry & e = index[mid];
+      int c = key.compare(0, string::npos, strings + e.key_offset, e.key_length);
+      if(c == 0) return &e;
+      if(c < 0) hi = mid; else lo = mid + 1;
+    }
+    return 0;
+  }
+};
+
 //____________________________________________________________________________
 namespace genie {
   ostream & operator<<(ostream & stream, const AlgConfigPool & config_pool)
@@ -48,7 +216,8 @@ namespace genie {
 //____________________________________________________________________________
 AlgConfigPool * AlgConfigPool::fInstance = 0;
 //____________________________________________________________________________
-AlgConfigPool::AlgConfigPool()
+AlgConfigPool::AlgConfigPool() :
+fBundle(0)
 {
   if( ! this->LoadAlgConfig() )
   LOG("AlgConfigPool", pERROR) << "Could not load XML config file";
@@ -78,6 +247,7 @@ AlgConfigPool::~AlgConfigPool()
   fRegistryPool.clear();
   fConfigFiles.clear();
   fConfigKeyList.clear();
+  this->CloseBundle();
   fInstance = 0;
 }
 //____________________________________________________________________________
@@ -96,6 +266,21 @@ bool AlgConfigPool::LoadAlgConfig(void)
 // Loads all algorithm XML configurations and creates a map with all loaded
 // configuration registries
 
+  //-- use a compiled configuration bundle, if one was requested
+  string bundle = RunOpt::Instance()->ConfigBundle();
+  if(bundle.size() == 0 && gSystem->Getenv("GCONFIGBUNDLE")) {
+    bundle = gSystem->Getenv("GCONFIGBUNDLE");
+  }
+  if(bundle.size() > 0) {
+    if(!this->LoadBundle(bundle)) {
+      SLOG("AlgConfigPool", pFATAL)
+        << "Could not use the configuration bundle: " << bundle;
+      gAbortingInErr = true;
+      exit(1);
+    }
+    return true;
+  }
+
   SLOG("AlgConfigPool", pINFO)
         << "AlgConfigPool late initialization: Loading all XML config. files";
 
@@ -290,6 +475,33 @@ bool AlgConfigPool::LoadRegistries(
 
   SLOG("AlgConfigPool", pDEBUG) << "[-] Loading registries:";
 
+  vector<ParamSet_t> sets;
+  if(!this->ParseRegistries(key_prefix, file_name, root, sets)) return false;
+
+  vector<ParamSet_t>::const_iterator set_iter = sets.begin();
+  for( ; set_iter != sets.end(); ++set_iter) {
+    const string & key = set_iter->first;
+
+    // store the key in the key list
+    fConfigKeyList.push_back(key);
+
+    // create a new Registry and fill it with the configuration params
+    Registry * config = this->BuildRegistry(*set_iter);
+
+    pair<string, Registry *> single_reg(key, config);
+    if(!fRegistryPool.insert(single_reg).second) delete config;
+
+    SLOG("AlgConfigPool", pDEBUG) << " |---o " << key;
+  }
+  return true;
+}
+//____________________________________________________________________________
+bool AlgConfigPool::ParseRegistries(
+   string key_prefix, string file_name, string root,
+   vector<ParamSet_t> & sets) const
+{
+// Reads all the parameter sets from the input XML file
+
   bool is_accessible = ! (gSystem->AccessPathName(file_name.c_str()));
   if (!is_accessible) {
      SLOG("AlgConfigPool", pERROR)
@@ -333,51 +545,34 @@ bool AlgConfigPool::LoadRegistries(
       ostringstream key;
       key << key_prefix << "/" << param_set;
 
-      // store the key in the key list
-      fConfigKeyList.push_back(key.str());
-
-      // create a new Registry and fill it with the configuration params
-      Registry * config = new Registry(param_set,false);
+      sets.push_back(ParamSet_t(key.str(), vector<ParamRecord_t>()));
+      vector<ParamRecord_t> & params = sets.back().second;
 
       xmlNodePtr xml_param = xml_cur->xmlChildrenNode;
       while (xml_param != NULL) {
         if( (!xmlStrcmp(xml_param->name, (const xmlChar *) "param")) ) {
 
-            string param_type =
+            ParamRecord_t param;
+            param.type =
                    utils::str::TrimSpaces(
                        utils::xml::GetAttribute(xml_param, "type"));
-            string param_name =
+            param.name =
                    utils::str::TrimSpaces(
                        utils::xml::GetAttribute(xml_param, "name"));
-            string param_value =
+            param.value =
                     utils::xml::TrimSpaces(
                                xmlNodeListGetString(
                                  xml_doc, xml_param->xmlChildrenNode, 1));
-
-
-	    if ( param_type.find( "vec-" ) == 0 ) {
-
-	      param_type = param_type.substr( 4 ) ;
-
-	      string delim = utils::str::TrimSpaces( utils::xml::GetAttribute(xml_param, "delim"));
-
-	      this -> AddParameterVector( config, param_type, param_name, param_value, delim ) ;
-	    }
-	    else this->AddConfigParameter( config,
-					   param_type, param_name,
-					   param_value);
+            if ( param.type.find( "vec-" ) == 0 ) {
+              param.delim = utils::str::TrimSpaces(
+                       utils::xml::GetAttribute(xml_param, "delim"));
+            }
+            params.push_back(param);
         }
         xml_param = xml_param->next;
       }
       //xmlFree(xml_param);
       xmlFreeNode(xml_param);
-      config->SetName(param_set);
-      config->Lock();
-
-      pair<string, Registry *> single_reg(key.str(), config);
-      fRegistryPool.insert(single_reg);
-
-      SLOG("AlgConfigPool", pDEBUG) << " |---o " << key.str();
     }
     xml_cur = xml_cur->next;
   }
@@ -389,6 +584,30 @@ bool AlgConfigPool::LoadRegistries(
   return true;
 }
 //____________________________________________________________________________
+Registry * AlgConfigPool::BuildRegistry(const ParamSet_t & set)
+{
+// Creates a locked Registry holding the input parameter set
+
+  const string & key = set.first;
+  string param_set = key.substr(key.rfind('/') + 1);
+
+  Registry * config = new Registry(param_set,false);
+
+  vector<ParamRecord_t>::const_iterator it = set.second.begin();
+  for( ; it != set.second.end(); ++it) {
+    const ParamRecord_t & param = *it;
+    if ( param.type.find( "vec-" ) == 0 ) {
+      this -> AddParameterVector( config, param.type.substr( 4 ),
+                                  param.name, param.value, param.delim ) ;
+    }
+    else this->AddConfigParameter( config, param.type, param.name, param.value );
+  }
+  config->SetName(param_set);
+  config->Lock();
+
+  return config;
+}
+//____________________________________________________________________________
 int  AlgConfigPool::AddParameterVector  (Registry * r, string pt, string pn, string pv,
 					 const string & delim ) {
 
@@ -590,6 +809,9 @@ Registry * AlgConfigPool::FindRegistry(string key) const
      map<string, Registry *>::const_iterator config_entry =
                                                    fRegistryPool.find(key);
      return config_entry->second;
+  } else if( fBundle ) {
+     // build it from the configuration bundle at first use
+     return const_cast<AlgConfigPool*>( this ) -> MaterializeRegistry(key);
   } else {
      LOG("AlgConfigPool", pDEBUG) << "No config registry for key " << key;
      return 0;
@@ -613,10 +835,21 @@ Registry * AlgConfigPool::CommonList( const string & file_id, const string & set
   ostringstream key;
   key << "Common" << file_id << "List/" << set_name;
 
-  if ( ! this->FindRegistry(key.str()) ) {
-	const_cast<AlgConfigPool*>( this ) -> LoadCommonLists( file_id ) ;
+  Registry * config = this->FindRegistry(key.str()) ;
+  if ( config ) return config ;
+
+  // a configuration bundle holds all the common lists found in the XML path
+  // when it was compiled: a missing set means a stale bundle
+  if ( fBundle ) {
+    LOG("AlgConfigPool", pFATAL)
+      << "Common list " << key.str() << " is not in the configuration bundle "
+      << fBundle->filename << " - Recompile the bundle";
+    gAbortingInErr = true;
+    exit(1);
   }
 
+  const_cast<AlgConfigPool*>( this ) -> LoadCommonLists( file_id ) ;
+
   return this->FindRegistry(key.str()) ;
 }
 //____________________________________________________________________________
@@ -641,6 +874,12 @@ void AlgConfigPool::Print(ostream & stream) const
   typedef map<string, Registry *>::const_iterator  sregIter;
   typedef map<string, Registry *>::size_type       sregSize;
 
+  // build all the registries held only in a configuration bundle
+  if(fBundle) {
+    vector<string>::const_iterator kiter = fConfigKeyList.begin();
+    for( ; kiter != fConfigKeyList.end(); ++kiter) this->FindRegistry(*kiter);
+  }
+
   sregSize size = fRegistryPool.size();
 
   stream << frame
@@ -657,3 +896,270 @@ void AlgConfigPool::Print(ostream & stream) const
   }
 }
 //____________________________________________________________________________
+bool AlgConfigPool::SaveBundle(string filename)
+{
+// Compiles all parameter sets into a configuration bundle. The XML files are
+// looked-up exactly as in LoadAlgConfig(), so the bundle holds the resolved
+// configuration for the current tune and XML path. All common lists found
+// in the XML path are included as well.
+
+  SLOG("AlgConfigPool", pNOTICE)
+    << "Compiling configuration bundle: " << filename;
+
+  vector<ParamSet_t> sets;
+
+  this->ParseRegistries("GlobalParameterList",
+     utils::xml::GetXMLFilePath("ModelConfiguration.xml"),
+     "global_param_list", sets);
+
+  if(fConfigFiles.empty()) this->LoadMasterConfigs();
+
+  map<string, string>::const_iterator conf_file_iter = fConfigFiles.begin();
+  for( ; conf_file_iter != fConfigFiles.end(); ++conf_file_iter) {
+    string alg_name  = conf_file_iter->first;
+    string full_path = utils::xml::GetXMLFilePath(conf_file_iter->second);
+    SLOG("AlgConfigPool", pINFO)
+         << setfill('.') << setw(40) << alg_name << " -> " << full_path;
+    if(!this->ParseRegistries(alg_name, full_path, "alg_conf", sets)) {
+      SLOG("AlgConfigPool", pERROR)
+           << "Error in loading config sets for algorithm = " << alg_name;
+      return false;
+    }
+  }
+
+  this->ParseRegistries("TuneGeneratorList",
+     utils::xml::GetXMLFilePath("TuneGeneratorList.xml"),
+     "tune_generator_list", sets);
+
+  vector<string> common_ids = this->CommonListIds();
+  vector<string>::const_iterator id_iter = common_ids.begin();
+  for( ; id_iter != common_ids.end(); ++id_iter) {
+    const string & file_id = *id_iter;
+    this->ParseRegistries("Common" + file_id + "List",
+       utils::xml::GetXMLFilePath("Common" + file_id + ".xml"),
+       "common_" + file_id + "_list", sets);
+  }
+
+  // the first set loaded for a key takes precedence, as in the XML mode
+  map<string, const ParamSet_t *> sorted;
+  vector<ParamSet_t>::const_iterator set_iter = sets.begin();
+  for( ; set_iter != sets.end(); ++set_iter) {
+    sorted.insert(map<string, const ParamSet_t *>::value_type(
+                      set_iter->first, &(*set_iter)));
+  }
+
+  vector<CfgBundleEntry> index;
+  vector<CfgBundleParam> params;
+  string                 strings;
+
+  string tune = (RunOpt::Instance()->Tune()) ?
+                    RunOpt::Instance()->Tune()->Name() : "";
+  uint32_t tune_offset = AddBundleString(strings, tune);
+
+  map<string, const ParamSet_t *>::const_iterator sorted_iter = sorted.begin();
+  for( ; sorted_iter != sorted.end(); ++sorted_iter) {
+    const ParamSet_t & set = *(sorted_iter->second);
+    CfgBundleEntry entry;
+    entry.key_offset  = AddBundleString(strings, set.first);
+    entry.key_length  = set.first.size();
+    entry.first_param = params.size();
+    entry.nparams     = set.second.size();
+    vector<ParamRecord_t>::const_iterator it = set.second.begin();
+    for( ; it != set.second.end(); ++it) {
+      CfgBundleParam param;
+      param.type_offset  = AddBundleString(strings, it->type);
+      param.type_length  = it->type.size();
+      param.name_offset  = AddBundleString(strings, it->name);
+      param.name_length  = it->name.size();
+      param.value_offset = AddBundleString(strings, it->value);
+      param.value_length = it->value.size();
+      param.delim_offset = AddBundleString(strings, it->delim);
+      param.delim_length = it->delim.size();
+      params.push_back(param);
+    }
+    index.push_back(entry);
+  }
+
+  CfgBundleHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, kCfgBundleMagic, sizeof(kCfgBundleMagic));
+  header.version        = kCfgBundleVersion;
+  header.nentries       = index.size();
+  header.nparams        = params.size();
+  header.index_offset   = sizeof(CfgBundleHeader);
+  header.params_offset  = header.index_offset  + index.size()  * sizeof(CfgBundleEntry);
+  header.strings_offset = header.params_offset + params.size() * sizeof(CfgBundleParam);
+  header.strings_size   = strings.size();
+  header.tune_offset    = tune_offset;
+  header.tune_length    = tune.size();
+
+  string body;
+  if(!index.empty()) {
+    body.append((const char *) &index[0], index.size() * sizeof(CfgBundleEntry));
+  }
+  if(!params.empty()) {
+    body.append((const char *) &params[0], params.size() * sizeof(CfgBundleParam));
+  }
+  body += strings;
+  header.checksum = CfgBundleChecksum(body.data(), body.size());
+
+  std::ofstream out(filename.c_str(), std::ios::binary);
+  if(!out.is_open()) {
+    SLOG("AlgConfigPool", pERROR) << "Couldn't create file = " << filename;
+    return false;
+  }
+  out.write((const char *) &header, sizeof(header));
+  out.write(body.data(), body.size());
+  out.close();
+  if(out.fail()) {
+    SLOG("AlgConfigPool", pERROR) << "Failed writing file = " << filename;
+    return false;
+  }
+
+  SLOG("AlgConfigPool", pNOTICE)
+    << "Wrote " << index.size() << " parameter sets (" << params.size()
+    << " parameters) for tune " << (tune.size() ? tune : "(none)")
+    << " - checksum: " << std::hex << header.checksum << std::dec;
+
+  return true;
+}
+//____________________________________________________________________________
+bool AlgConfigPool::LoadBundle(string filename)
+{
+// Maps a configuration bundle. No registry is built at this point: registries
+// are built on their first FindRegistry() call.
+
+  SLOG("AlgConfigPool", pNOTICE)
+    << "AlgConfigPool late initialization: Mapping configuration bundle "
+    << filename;
+
+  int fd = open(filename.c_str(), O_RDONLY);
+  if(fd < 0) {
+    SLOG("AlgConfigPool", pERROR)
+      << "The configuration bundle doesn't exist! (filename : " << filename << ")";
+    return false;
+  }
+  struct stat st;
+  if(fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(CfgBundleHeader)) {
+    SLOG("AlgConfigPool", pERROR)
+      << "The configuration bundle is empty! (filename : " << filename << ")";
+    close(fd);
+    return false;
+  }
+  size_t size = st.st_size;
+  void * addr = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(addr == MAP_FAILED) {
+    SLOG("AlgConfigPool", pERROR)
+      << "The configuration bundle can't be mapped! (filename : " << filename << ")";
+    return false;
+  }
+
+  const CfgBundleHeader * header = (const CfgBundleHeader *) addr;
+  string reason;
+  bool valid = ValidCfgBundle(header, size, reason);
+  if(!valid) {
+    SLOG("AlgConfigPool", pERROR)
+      << "Invalid, modified or unsupported configuration bundle! (filename : "
+      << filename << ") - " << reason;
+    munmap(addr, size);
+    return false;
+  }
+
+  Bundle * bundle = new Bundle;
+  bundle->filename = filename;
+  bundle->addr     = addr;
+  bundle->size     = size;
+  bundle->header   = header;
+  bundle->index    = (const CfgBundleEntry *) ((const char *) addr + header->index_offset);
+  bundle->params   = (const CfgBundleParam *) ((const char *) addr + header->params_offset);
+  bundle->strings  = (const char *)           ((const char *) addr + header->strings_offset);
+
+  // the bundle holds the configuration of a single tune
+  string tune = bundle->String(header->tune_offset, header->tune_length);
+  TuneId * tune_id = RunOpt::Instance()->Tune();
+  if(tune_id && tune.size() > 0 && tune_id->Name() != tune) {
+    SLOG("AlgConfigPool", pERROR)
+      << "The configuration bundle was compiled for tune " << tune
+      << " but the requested tune is " << tune_id->Name();
+    munmap(addr, size);
+    delete bundle;
+    return false;
+  }
+
+  fBundle = bundle;
+  for(uint64_t ie = 0; ie < header->nentries; ie++) {
+    const CfgBundleEntry & e = bundle->index[ie];
+    fConfigKeyList.push_back(bundle->String(e.key_offset, e.key_length));
+  }
+
+  SLOG("AlgConfigPool", pNOTICE)
+    << "Mapped " << header->nentries << " parameter sets for tune "
+    << (tune.size() ? tune : "(none)")
+    << " - checksum: " << std::hex << header->checksum << std::dec;
+
+  return true;
+}
+//____________________________________________________________________________
+Registry * AlgConfigPool::MaterializeRegistry(string key)
+{
+  if(!fBundle) return 0;
+
+  const CfgBundleEntry * entry = fBundle->Find(key);
+  if(!entry) {
+    LOG("AlgConfigPool", pDEBUG) << "No config registry for key " << key;
+    return 0;
+  }
+
+  ParamSet_t set(key, vector<ParamRecord_t>());
+  for(uint32_t ip = 0; ip < entry->nparams; ip++) {
+    const CfgBundleParam & p = fBundle->params[entry->first_param + ip];
+    ParamRecord_t param;
+    param.type  = fBundle->String(p.type_offset,  p.type_length );
+    param.name  = fBundle->String(p.name_offset,  p.name_length );
+    param.value = fBundle->String(p.value_offset, p.value_length);
+    param.delim = fBundle->String(p.delim_offset, p.delim_length);
+    set.second.push_back(param);
+  }
+
+  LOG("AlgConfigPool", pINFO) << "Building registry " << key << " from bundle";
+
+  Registry * config = this->BuildRegistry(set);
+  fRegistryPool.insert(pair<string, Registry *>(key, config));
+  return config;
+}
+//____________________________________________________________________________
+void AlgConfigPool::CloseBundle(void)
+{
+  if(!fBundle) return;
+  munmap(fBundle->addr, fBundle->size);
+  delete fBundle;
+  fBundle = 0;
+}
+//____________________________________________________________________________
+vector<string> AlgConfigPool::CommonListIds(void) const
+{
+// Finds the ids of all common lists (Common<id>.xml) in the XML path
+
+  std::set<string> ids;
+
+  vector<string> paths =
+     utils::str::Split(utils::xml::GetXMLPathList(), ":;,");
+  vector<string>::const_iterator path_iter = paths.begin();
+  for( ; path_iter != paths.end(); ++path_iter) {
+    string dir = gSystem->ExpandPathName(path_iter->c_str());
+    void * dirp = gSystem->OpenDirectory(dir.c_str());
+    if(!dirp) continue;
+    const char * entry = 0;
+    while( (entry = gSystem->GetDirEntry(dirp)) ) {
+      string name(entry);
+      if(name.size() > 10 && name.compare(0, 6, "Common") == 0 &&
+         name.compare(name.size()-4, 4, ".xml") == 0) {
+        ids.insert(name.substr(6, name.size()-10));
+      }
+    }
+    gSystem->FreeDirectory(dirp);
+  }
+  return vector<string>(ids.begin(), ids.end());
+}
+//____________________________________________________________________________
@@ -6,6 +6,13 @@
 \brief    A singleton class holding all configuration registries built while
           parsing all loaded XML configuration files.
 
+          Alternatively, the pool can map a compiled configuration bundle
+          (see gcfgbundle), selected with the --config-bundle option or the
+          GCONFIGBUNDLE environment variable. The bundle holds all parameter
+          sets for one resolved tune; no XML is parsed and each registry is
+          only built when it is first requested. The bundle content is
+          checksummed and verified when mapped.
+
 \author   Costas Andreopoulos <constantinos.andreopoulos \at cern.ch>
           University of Liverpool & STFC Rutherford Appleton Laboratory
 
@@ -20,6 +27,7 @@
 #define _ALG_CONFIG_POOL_H_
 
 #include <map>
+#include <utility>
 #include <vector>
 #include <string>
 #include <iostream>
@@ -28,6 +36,7 @@
 #include "Framework/Registry/Registry.h"
 
 using std::map;
+using std::pair;
 using std::vector;
 using std::string;
 using std::ostream;
@@ -54,6 +63,11 @@ public:
 
   const vector<string> & ConfigKeyList (void) const;
 
+  //! Save all parameter sets (for the current tune & XML path) in a compiled
+  //! configuration bundle
+  bool SaveBundle  (string filename);
+  bool UsingBundle (void) const { return fBundle != 0; }
+
   void Print(ostream & stream) const;
   friend ostream & operator << (ostream & stream, const AlgConfigPool & cp);
 
@@ -62,6 +76,18 @@ private:
   AlgConfigPool(const AlgConfigPool & config_pool);
   virtual ~AlgConfigPool();
 
+  //! a parameter as read from an XML config file
+  struct ParamRecord_t {
+    string type;
+    string name;
+    string value;
+    string delim;
+  };
+  //! a named parameter set (key: prefix/param_set)
+  typedef pair<string, vector<ParamRecord_t> > ParamSet_t;
+
+  struct Bundle;
+
   // methods for loading all algorithm XML configuration files
   string BuildConfigKey      (string alg_name, string param_set) const;
   string BuildConfigKey      (const Algorithm * algorithm) const;
@@ -73,6 +99,12 @@ private:
   bool   LoadTuneGeneratorList(void);
   bool   LoadSingleAlgConfig (string alg_name, string file_name);
   bool   LoadRegistries      (string key_base, string file_name, string root);
+  bool   ParseRegistries     (string key_base, string file_name, string root, vector<ParamSet_t> & sets) const;
+  Registry * BuildRegistry   (const ParamSet_t & set);
+  bool   LoadBundle          (string filename);
+  void   CloseBundle         (void);
+  Registry * MaterializeRegistry (string key);
+  vector<string> CommonListIds (void) const;
   int    AddParameterVector  (Registry * r, string pt, string pn, string pv, const string & delim = ";" );
   void   AddConfigParameter  (Registry * r, string pt, string pn, string pv);
   void   AddBasicParameter   (Registry * r, string pt, string pn, string pv);
@@ -85,6 +117,7 @@ private:
   map<string, string>     fConfigFiles;   ///< algorithm -> XML config file
   vector<string>          fConfigKeyList; ///< list of all available configuration keys
   string                  fMasterConfig;  ///< lists config files for all algorithms
+  Bundle *                fBundle;        ///< mapped configuration bundle, if any
 
   struct Cleaner {
       void DummyMethodAndSilentCompiler() { }
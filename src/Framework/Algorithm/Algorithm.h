@@ -174,6 +174,11 @@ protected:
   template<class T>
     bool GetParam( const RgKey & name, T & p, bool is_top_call = true ) const ;
 
+  //! As above, using an interned key: the local registries are searched
+  //! without string comparisons (sub-algorithms are searched by name)
+  template<class T>
+    bool GetParam( const RgKeyHandle & key, T & p, bool is_top_call = true ) const ;
+
   //! Ideal access to a parameter value from the vector of registries,
   //! With default value. Returns true if the value is set from the
   //! registries, false if the value is the default
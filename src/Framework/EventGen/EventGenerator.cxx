@@ -29,6 +29,7 @@
 #include "Framework/GHEP/GHepRecord.h"
 #include "Framework/GHEP/GHepFlags.h"
 #include "Framework/Messenger/Messenger.h"
+#include "Framework/Utils/PerfMonitor.h"
 #include "Framework/Utils/PrintUtils.h"
 
 using std::ostringstream;
@@ -65,6 +66,8 @@ void EventGenerator::ProcessEventRecord(GHepRecord * event_rec) const
 {
   LOG("EventGenerator", pNOTICE) << "Generating Event...";
 
+  PerfTimer thread_timer(fPerf);
+
   //-- Clear previous virtual list folder
   LOG("EventGenerator", pNOTICE) << "Clearing the GHepVirtualListFolder";
   GHepVirtualListFolder * vlfolder = GHepVirtualListFolder::Instance();
@@ -79,10 +82,15 @@ void EventGenerator::ProcessEventRecord(GHepRecord * event_rec) const
   unsigned int nexceptions = 0;
 
   //-- Reset stop-watch
-  fWatch->Reset();
+  if(fModuleTiming) fWatch->Reset();
+
+  //-- The per-module messages are only formatted if they are to be printed
+  bool verbose =
+      (*Messenger::Instance())("EventGenerator").isPriorityEnabled(pNOTICE);
 
-  string mesgh = "Event generation thread: " + this->Id().Key() + 
-                 " -> Running module: ";
+  string mesgh = (verbose) ?
+     "Event generation thread: " + this->Id().Key() + " -> Running module: " :
+     "";
 
   //-- Loop over the event record processing modules
   int istep=0;
@@ -93,9 +101,11 @@ void EventGenerator::ProcessEventRecord(GHepRecord * event_rec) const
   {
     const EventRecordVisitorI * visitor = *miter; // generation module
 
-    string mesg = mesgh + visitor->Id().Key();
-    LOG("EventGenerator", pNOTICE)
-                 << utils::print::PrintFramedMesg(mesg,0,'~');
+    if(verbose) {
+      string mesg = mesgh + visitor->Id().Key();
+      LOG("EventGenerator", pNOTICE)
+                   << utils::print::PrintFramedMesg(mesg,0,'~');
+    }
     if(ffwd) {
       LOG("EventGenerator", pNOTICE)
            << "Fast Forward flag was set - Skipping processing step!";
@@ -103,11 +113,14 @@ void EventGenerator::ProcessEventRecord(GHepRecord * event_rec) const
     }
     try
     {
-      fWatch->Start();
-      visitor->ProcessEventRecord(event_rec);
-      fWatch->Stop();
+      if(fModuleTiming) fWatch->Start();
+      {
+        PerfTimer module_timer(fEVGPerf[istep]);
+        visitor->ProcessEventRecord(event_rec);
+      }
+      if(fModuleTiming) fWatch->Stop();
       fRecHistory.AddSnapshot(istep, event_rec);
-      (*fEVGTime)[istep] = fWatch->CpuTime(); // sec
+      if(fModuleTiming) (*fEVGTime)[istep] = fWatch->CpuTime(); // sec
     }
     catch (EVGThreadException exception)
     {
@@ -164,11 +177,14 @@ void EventGenerator::ProcessEventRecord(GHepRecord * event_rec) const
            // step we are about to return to
            LOG("EventGenerator", pNOTICE)
                   << "Restoring GHEP as it was just before the return step";
-           event_rec->ResetRecord();
            istep--;
-           GHepRecord * snapshot = fRecHistory[istep];
-           fRecHistory.PurgeRecentHistory(istep+1);
-           event_rec->Copy(*snapshot);
+           if(!fRecHistory.RestoreSnapshot(istep, event_rec)) {
+             LOG("EventGenerator", pFATAL)
+               << "Can not restore the event record before processing step "
+               << rstep << " - check the GHEPHISTENABLE setting";
+             gAbortingInErr = true;
+             exit(1);
+           }
          } // valid-return-step
       } // step-back
     } // catch exception
@@ -181,15 +197,18 @@ void EventGenerator::ProcessEventRecord(GHepRecord * event_rec) const
   LOG("EventGenerator", pNOTICE)
            << "The EventRecord was visited by all EventRecordVisitors";
 
-  LOG("EventGenerator", pINFO) << "** Event generation timing info **";
-  istep=0;
-  for(miter = fEVGModuleVec->begin();
-                               miter != fEVGModuleVec->end(); ++miter){
-    const EventRecordVisitorI * visitor = *miter;
-
-    BLOG("EventGenerator", pINFO)
-       << "module " << visitor->Id().Key() << " -> ~"
-                        << TMath::Max(0.,(*fEVGTime)[istep++]) << " s";
+  if(fModuleTiming &&
+     (*Messenger::Instance())("EventGenerator").isPriorityEnabled(pINFO)) {
+    LOG("EventGenerator", pINFO) << "** Event generation timing info **";
+    istep=0;
+    for(miter = fEVGModuleVec->begin();
+                                 miter != fEVGModuleVec->end(); ++miter){
+      const EventRecordVisitorI * visitor = *miter;
+
+      BLOG("EventGenerator", pINFO)
+         << "module " << visitor->Id().Key() << " -> ~"
+                          << TMath::Max(0.,(*fEVGTime)[istep++]) << " s";
+    }
   }
   LOG("EventGenerator", pNOTICE) << "Done generating event!";
 }
@@ -230,8 +249,10 @@ void EventGenerator::Init(void)
   fVldContext   = 0;
   fEVGModuleVec = 0;
   fEVGTime      = 0;
+  fPerf         = 0;
   fXSecModel    = 0;
   fIntListGen   = 0;
+  fModuleTiming = true;
 
   fFiltUnphysMask = new TBits(GHepFlags::NFlags());
   fFiltUnphysMask->ResetAllBits(false);
@@ -265,6 +286,8 @@ void EventGenerator::LoadConfig(void)
   fVldContext = new GVldContext;
   fVldContext->Decode( encoded_vld_context );
 
+  GetParamDef("ModuleTiming", fModuleTiming, true);
+
   LOG("EventGenerator", pDEBUG) << "Loading the event generation modules";
 
   int nsteps ;
@@ -277,6 +300,10 @@ void EventGenerator::LoadConfig(void)
 
   fEVGModuleVec = new vector<const EventRecordVisitorI *> (nsteps);
   fEVGTime      = new vector<double>(nsteps);
+  fEVGPerf.assign(nsteps, 0);
+
+  PerfMonitor * perf = PerfMonitor::Instance();
+  fPerf = perf->Counter("EventGenerator", this->Id().Key());
 
   for(int istep = 0; istep < nsteps; istep++) {
 
@@ -295,6 +322,7 @@ void EventGenerator::LoadConfig(void)
 
     (*fEVGModuleVec)[istep] = visitor;
     (*fEVGTime)[istep]      = 0;
+    fEVGPerf[istep] = perf->Counter("EventRecordVisitor", visitor->Id().Key());
   }
 
   //-- load the interaction list generator
@@ -35,6 +35,8 @@ using std::vector;
 
 namespace genie {
 
+class PerfCounter;
+
 class EventGenerator: public EventGeneratorI {
 
 public :
@@ -50,6 +52,9 @@ public :
   const InteractionListGeneratorI * IntListGenerator (void) const;
   const XSecAlgorithmI *            CrossSectionAlg  (void) const;
 
+  //-- the event generation modules, in processing order
+  const vector<const EventRecordVisitorI *> * Modules (void) const { return fEVGModuleVec; }
+
   //-- override the Algorithm::Configure methods to load configuration
   //   data to private data members
   void Configure (const Registry & config);
@@ -63,10 +68,13 @@ private:
   //-- private data members
   vector<const EventRecordVisitorI *> * fEVGModuleVec;   ///< list of modules
   vector<double> *                      fEVGTime;        ///< module timing info
+  vector<PerfCounter *>                 fEVGPerf;        ///< module performance counters
+  PerfCounter *                         fPerf;           ///< thread performance counter
   const XSecAlgorithmI *                fXSecModel;      ///< xsec model for events handled by thread
   const InteractionListGeneratorI *     fIntListGen;     ///< generates list of handled interactions
   GVldContext *                         fVldContext;     ///< validity context
   TStopwatch *                          fWatch;          ///< stopwatch for module timing
+  bool                                  fModuleTiming;   ///< time each module?
   TBits *                               fFiltUnphysMask; ///< mask for allowing unphysical events to pass through (if requested)
   mutable GHepRecordHistory             fRecHistory;     ///< event record history
 };
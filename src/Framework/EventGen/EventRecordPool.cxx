@@ -0,0 +1,102 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2023, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#include "Framework/EventGen/EventRecord.h"
+#include "Framework/EventGen/EventRecordPool.h"
+#include "Framework/Interaction/Interaction.h"
+#include "Framework/Messenger/Messenger.h"
+
+using namespace genie;
+
+//____________________________________________________________________________
+EventRecordPool * EventRecordPool::fInstance = 0;
+//____________________________________________________________________________
+EventRecordPool::EventRecordPool()
+{
+  fMaxSize  = 4;
+  fNCreated = 0;
+  fNReused  = 0;
+  fInstance = 0;
+}
+//____________________________________________________________________________
+EventRecordPool::~EventRecordPool()
+{
+  this->Purge();
+
+  LOG("EvRecPool", pINFO)
+    << "Event record pool: " << fNCreated << " records created, "
+    << fNReused << " re-used";
+
+  fInstance = 0;
+}
+//____________________________________________________________________________
+EventRecordPool * EventRecordPool::Instance()
+{
+  if(fInstance == 0) {
+    static EventRecordPool::Cleaner cleaner;
+    cleaner.DummyMethodAndSilentCompiler();
+    fInstance = new EventRecordPool;
+  }
+  return fInstance;
+}
+//____________________________________________________________________________
+EventRecord * EventRecordPool::Get(const Interaction * summary)
+{
+  EventRecord * evrec = 0;
+  if(fRecords.size() > 0) {
+    evrec = fRecords.back();
+    fRecords.pop_back();
+    fNReused++;
+  } else {
+    evrec = new EventRecord;
+    fNCreated++;
+  }
+
+  if(summary) {
+    Interaction * in = 0;
+    if(fSummaries.size() > 0) {
+      in = fSummaries.back();
+      fSummaries.pop_back();
+      *in = *summary;
+    } else {
+      in = new Interaction(*summary);
+    }
+    evrec->AttachSummary(in);
+  }
+
+  return evrec;
+}
+//____________________________________________________________________________
+void EventRecordPool::Release(EventRecord * evrec)
+{
+  if(!evrec) return;
+
+  if(fRecords.size() >= fMaxSize) {
+    delete evrec;
+    return;
+  }
+
+  // keep the summary for the next Get()
+  Interaction * in = evrec->Summary();
+  if(in) {
+    evrec->AttachSummary(0);
+    if(fSummaries.size() < fMaxSize) fSummaries.push_back(in);
+    else delete in;
+  }
+
+  evrec->RecycleRecord();
+  fRecords.push_back(evrec);
+}
+//____________________________________________________________________________
+void EventRecordPool::Purge(void)
+{
+  for(unsigned int i = 0; i < fRecords.size(); i++) delete fRecords[i];
+  fRecords.clear();
+  for(unsigned int i = 0; i < fSummaries.size(); i++) delete fSummaries[i];
+  fSummaries.clear();
+}
+//____________________________________________________________________________
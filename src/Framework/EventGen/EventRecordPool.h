@@ -0,0 +1,87 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::EventRecordPool
+
+\brief    Singleton pool of EventRecord objects with reset-and-reuse
+          semantics.
+
+          Event records handed out by Get() are either new or recycled ones
+          (see GHepRecord::RecycleRecord()) that keep their particle entries,
+          4-vectors, vertex, flags and summary allocated. Once a record has
+          been written out, returning it with Release() (instead of deleting
+          it) makes the event generation loop reach a steady state where no
+          event record memory is allocated per event.
+          Records obtained from the pool may still be deleted as usual.
+
+\author   GENIE Collaboration
+
+\created  October 16, 2026
+
+\cpright  Copyright (c) 2003-2023, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _EVENT_RECORD_POOL_H_
+#define _EVENT_RECORD_POOL_H_
+
+#include <vector>
+
+using std::vector;
+
+namespace genie {
+
+class EventRecord;
+class Interaction;
+
+class EventRecordPool
+{
+public:
+  static EventRecordPool * Instance(void);
+
+  //! Get an empty event record. If a summary is given, a copy is attached.
+  EventRecord * Get     (const Interaction * summary = 0);
+
+  //! Return an event record to the pool (the caller must not use it again)
+  void          Release (EventRecord * evrec);
+
+  //! Max number of idle records kept in the pool (the rest are deleted)
+  void          SetMaxSize (unsigned int n) { fMaxSize = n; }
+  unsigned int  MaxSize    (void) const     { return fMaxSize; }
+
+  unsigned int  NIdle      (void) const { return fRecords.size(); }
+  long          NCreated   (void) const { return fNCreated; }
+  long          NReused    (void) const { return fNReused;  }
+
+  //! Delete all idle records and summaries
+  void          Purge      (void);
+
+private:
+  EventRecordPool();
+  EventRecordPool(const EventRecordPool & pool);
+  virtual ~EventRecordPool();
+
+  static EventRecordPool * fInstance;
+
+  vector<EventRecord *> fRecords;    ///< idle event records
+  vector<Interaction *> fSummaries;  ///< idle summaries (detached from released records)
+  unsigned int          fMaxSize;    ///< max number of idle records
+  long                  fNCreated;   ///< number of records created by the pool
+  long                  fNReused;    ///< number of records served from the pool
+
+  struct Cleaner {
+      void DummyMethodAndSilentCompiler() { }
+      ~Cleaner() {
+         if (EventRecordPool::fInstance !=0) {
+            delete EventRecordPool::fInstance;
+            EventRecordPool::fInstance = 0;
+         }
+      }
+  };
+  friend struct Cleaner;
+};
+
+}      // genie namespace
+
+#endif // _EVENT_RECORD_POOL_H_
@@ -21,6 +21,7 @@
 #include "Framework/Conventions/Units.h"
 #include "Framework/EventGen/GEVGDriver.h"
 #include "Framework/EventGen/EventRecord.h"
+#include "Framework/EventGen/EventRecordPool.h"
 #include "Framework/EventGen/EventGeneratorList.h"
 #include "Framework/EventGen/EventGeneratorI.h"
 #include "Framework/EventGen/ToyInteractionSelector.h"
@@ -35,8 +36,10 @@
 #include "Framework/Messenger/Messenger.h"
 #include "Framework/Numerical/Spline.h"
 #include "Framework/ParticleData/PDGCodes.h"
+#include "Framework/ParticleData/PDGCodeList.h"
 #include "Framework/ParticleData/PDGUtils.h"
 #include "Framework/ParticleData/PDGLibrary.h"
+#include "Framework/Utils/PerfMonitor.h"
 #include "Framework/Utils/XSecSplineList.h"
 #include "Framework/Utils/PrintUtils.h"
 
@@ -155,10 +158,28 @@ void GEVGDriver::Configure(const InitialState & is)
   LOG("GEVGDriver", pNOTICE)
         << utils::print::PrintFramedMesg(mesg.str(), 0, '*');
 
+  // If loading the cross section splines was deferred, load those needed
+  // for this initial state (unless a GMCJDriver or another GEVGDriver has
+  // done so already)
+  XSecSplineList * xspl = XSecSplineList::Instance();
+  if(xspl->HasDeferredFiles()) {
+    PDGCodeList probes, targets;
+    probes.push_back (init_state.ProbePdg());
+    targets.push_back(init_state.TgtPdg());
+    XmlParserStatus_t status = xspl->LoadDeferred(probes, targets);
+    if(status != kXmlOK) {
+      LOG("GEVGDriver", pFATAL)
+        << "Problem loading the cross section splines: "
+        << XmlParserStatus::AsString(status);
+      exit(1);
+    }
+  }
+
   this -> BuildInitialState            (init_state);
   this -> BuildGeneratorList           ();
   this -> BuildInteractionGeneratorMap ();
   this -> BuildInteractionSelector     ();
+  this -> CompileInteractionSelector   ();
 
   LOG("GEVGDriver", pINFO) << "Done configuring. \n";
 }
@@ -216,6 +237,17 @@ void GEVGDriver::BuildInteractionSelector(void)
         algf->AdoptAlgorithm("genie::PhysInteractionSelector","Default"));
 }
 //___________________________________________________________________________
+void GEVGDriver::CompileInteractionSelector(void)
+{
+// Let the interaction selector resolve the cross section splines for all
+// interactions of this initial state once, rather than for every event.
+// Called again whenever the spline list may have changed.
+
+  PhysInteractionSelector * sel =
+        dynamic_cast<PhysInteractionSelector *> (fIntSelector);
+  if(sel) sel->Compile(fIntGenMap);
+}
+//___________________________________________________________________________
 void GEVGDriver::SetUnphysEventMask(const TBits & mask)
 {
   *fUnphysEventMask = mask;
@@ -295,6 +327,7 @@ EventRecord * GEVGDriver::GenerateEvent(const TLorentzVector & nu4p)
   if(!unphys) {
      LOG("GEVGDriver", pINFO) << "Returning the current event!";
      fNRecLevel = 0;
+     PerfMonitor::Instance()->CountEvent();
      return fCurrentRecord; // The client 'adopts' the event record
   } else {
      LOG("GEVGDriver", pWARN) << "An unphysical event was generated...";
@@ -304,12 +337,13 @@ EventRecord * GEVGDriver::GenerateEvent(const TLorentzVector & nu4p)
        LOG("GEVGDriver", pWARN)
           << "The generated unphysical event is accepted by the user";
        fNRecLevel = 0;
+       PerfMonitor::Instance()->CountEvent();
        return fCurrentRecord; // The client 'adopts' the event record
 
      } else {
        LOG("GEVGDriver", pWARN)
           << "The generated unphysical event is rejected";
-       delete fCurrentRecord;
+       EventRecordPool::Instance()->Release(fCurrentRecord);
        fCurrentRecord = 0;
        fNRecLevel++; // increase the nested level counter
 
@@ -321,7 +355,7 @@ EventRecord * GEVGDriver::GenerateEvent(const TLorentzVector & nu4p)
           LOG("GEVGDriver", pERROR)
                << "Could not produce a physical event after "
                       << kRecursiveModeMaxDepth << " attempts!";
-          delete fCurrentRecord;
+          EventRecordPool::Instance()->Release(fCurrentRecord);
           fCurrentRecord = 0;
           fNRecLevel = 0;
           return 0;
@@ -409,8 +443,10 @@ double GEVGDriver::XSecSum(const TLorentzVector & nup4)
      if (spline_exists && fUseSplines) {
         double E = nup4.Energy();
         xsec = xssl->GetSpline(xsec_alg,interaction)->Evaluate(E);
-     } else
+     } else {
+        PerfTimer timer(PerfMonitor::Instance()->IntegratorCounter(xsec_alg));
         xsec = xsec_alg->Integral(interaction);
+     }
 
      xsec = TMath::Max(0., xsec);
 
@@ -572,6 +608,8 @@ void GEVGDriver::UseSplines(void)
        }
      } // loop over interaction list
   }//use-splines?
+
+  this->CompileInteractionSelector();
 }
 //___________________________________________________________________________
 void GEVGDriver::CreateSplines(int nknots, double emax, bool useLogE)
@@ -652,8 +690,11 @@ void GEVGDriver::CreateSplines(int nknots, double emax, bool useLogE)
          SLOG("GEVGDriver", pINFO) << "Need xsec spline for " << code;
 
          // only create the spline if it does not already exists
+         // (in incremental mode existing splines are passed on as well: they
+         // are only rebuilt if knots they don't have are requested, and only
+         // those are computed)
          bool spl_exists = xsl->SplineExists(alg, interaction);
-         if(!spl_exists) {
+         if(!spl_exists || xsl->Incremental()) {
              SLOG("GEVGDriver", pDEBUG)
                << "The spline wasn't loaded at initialization. "
                << "I can build it now but it might take a while...";
@@ -669,6 +710,8 @@ void GEVGDriver::CreateSplines(int nknots, double emax, bool useLogE)
   LOG("GEVGDriver", pINFO) << *xsl; // print list of splines
 
   fUseSplines = true;
+
+  this->CompileInteractionSelector();
 }
 //___________________________________________________________________________
 Range1D_t GEVGDriver::ValidEnergyRange(void) const
@@ -79,6 +79,9 @@ public :
   // Get event generator thread list
   const EventGeneratorList * EventGenerators (void) const { return fEvGenList; }
 
+  // Get the interaction selector
+  const InteractionSelectorI * IntSelector (void) const { return fIntSelector; }
+
   // Get the event generator that is responsible for generating the input event
   const EventGeneratorI * FindGenerator(const Interaction * interaction) const;
 
@@ -112,6 +115,7 @@ private:
   void BuildGeneratorList           (void);
   void BuildInteractionGeneratorMap (void);
   void BuildInteractionSelector     (void);
+  void CompileInteractionSelector   (void);
   void AssertIsValidInitState       (void) const;
 
   // Private data members
@@ -32,6 +32,7 @@
 #include "Framework/Numerical/RandomGen.h"
 #include "Framework/Numerical/Spline.h"
 #include "Framework/ParticleData/PDGUtils.h"
+#include "Framework/Utils/PerfMonitor.h"
 #include "Framework/Utils/PrintUtils.h"
 #include "Framework/Utils/XSecSplineList.h"
 #include "Framework/Conventions/Constants.h"
@@ -405,6 +406,19 @@ void GMCJDriver::Configure(bool calc_prob_scales)
   // of target materials from the input geometry driver
   this->GetParticleLists();
 
+  // If loading the cross section splines was deferred, load them now but
+  // only those needed for the neutrinos and targets found above
+  XSecSplineList * xspl = XSecSplineList::Instance();
+  if(xspl->HasDeferredFiles()) {
+    XmlParserStatus_t status = xspl->LoadDeferred(fNuList, fTgtList);
+    if(status != kXmlOK) {
+      LOG("GMCJDriver", pFATAL)
+        << "Problem loading the cross section splines: "
+        << XmlParserStatus::AsString(status);
+      exit(1);
+    }
+  }
+
   // Ask the input GFluxI for the max. neutrino energy (to compute Pmax)
   this->GetMaxFluxEnergy();
 
@@ -544,6 +558,8 @@ void GMCJDriver::GetMaxPathLengthList(void)
   } else {
      LOG("GMCJDriver", pNOTICE)
        << "Querying the geometry driver to compute the max path-length list";
+     PerfTimer timer(PerfMonitor::Instance()->Counter(
+                                      "Geometry", "ComputeMaxPathLengths"));
      fMaxPathLengths = fGeomAnalyzer->ComputeMaxPathLengths();
   }
   // Print maximum path lengths & neutrino energy
@@ -1041,7 +1057,13 @@ bool GMCJDriver::GenerateFluxNeutrino(void)
 //
   LOG("GMCJDriver", pNOTICE) << "Generating a flux neutrino";
 
-  bool ok = fFluxDriver->GenerateNext();
+  static PerfCounter * perf =
+         PerfMonitor::Instance()->Counter("Flux", "GenerateNext");
+  bool ok = false;
+  {
+    PerfTimer timer(perf);
+    ok = fFluxDriver->GenerateNext();
+  }
   if(!ok) {
      LOG("GMCJDriver", pERROR)
          << "*** The flux driver couldn't generate a flux neutrino!!";
@@ -1089,7 +1111,12 @@ bool GMCJDriver::ComputePathLengths(void)
   const TLorentzVector & nup4  = fFluxDriver -> Momentum ();
   const TLorentzVector & nux4  = fFluxDriver -> Position ();
 
-  fCurPathLengths = fGeomAnalyzer->ComputePathLengths(nux4, nup4);
+  static PerfCounter * perf =
+         PerfMonitor::Instance()->Counter("Geometry", "ComputePathLengths");
+  {
+    PerfTimer timer(perf);
+    fCurPathLengths = fGeomAnalyzer->ComputePathLengths(nux4, nup4);
+  }
 
   LOG("GMCJDriver", pNOTICE) << fCurPathLengths;
 
@@ -1247,7 +1274,13 @@ void GMCJDriver::GenerateVertexPosition(void)
   const TLorentzVector & p4 = fFluxDriver->Momentum ();
   const TLorentzVector & x4 = fFluxDriver->Position ();
 
-  const TVector3 & vtx = fGeomAnalyzer->GenerateVertex(x4, p4, fSelTgtPdg);
+  static PerfCounter * perf =
+         PerfMonitor::Instance()->Counter("Geometry", "GenerateVertex");
+  TVector3 vtx;
+  {
+    PerfTimer timer(perf);
+    vtx = fGeomAnalyzer->GenerateVertex(x4, p4, fSelTgtPdg);
+  }
 
   TVector3 origin(x4.X(), x4.Y(), x4.Z());
   origin-=vtx; // computes vector dr = origin - vtx
@@ -19,6 +19,7 @@
 #include "Framework/EventGen/GMCJMonitor.h"
 #include "Framework/GHEP/GHepParticle.h"
 #include "Framework/Messenger/Messenger.h"
+#include "Framework/Utils/PerfMonitor.h"
 #include "Framework/Utils/PrintUtils.h"
 
 using std::ostringstream;
@@ -63,6 +64,7 @@ void GMCJMonitor::Update(int iev, const EventRecord * event)
                              << fCpuTime << " s" << endl;
   status << "Approximate processing time/event: "
                      << fCpuTime/(iev+1) << " s" << endl;
+  status << *PerfMonitor::Instance() << endl;
 
   if(!event) status << "NULL" << endl;
   else       status << *event << endl;
@@ -29,49 +29,51 @@ HybridXSecAlgorithm::~HybridXSecAlgorithm()
 //_________________________________________________________________________
 const XSecAlgorithmI* HybridXSecAlgorithm::ChooseXSecAlg(
   const Interaction& interaction) const
+{
+  ULong64_t fp = interaction.Fingerprint();
+  interaction.FingerprintFields( fFieldsBuffer );
+
+  std::map<ULong64_t, std::pair<std::vector<int>, const XSecAlgorithmI*> >
+    ::const_iterator citer = fXSecAlgMap.find( fp );
+
+  // If an entry was found in the map for the same interaction, then just
+  // use that
+  if ( citer != fXSecAlgMap.cend() ) {
+    if ( citer->second.first == fFieldsBuffer ) return citer->second.second;
+
+    // A different interaction with the same fingerprint: look it up in the
+    // registry every time, keeping the existing entry
+    LOG("HybridXSecAlgorithm", pWARN) << "Interaction fingerprint collision"
+      << " for " << interaction.AsString();
+    return this->FindXSecAlg( interaction );
+  }
+
+  // If the algorithm doesn't appear in the map, try to load it and store
+  // it for rapid retrieval later (a null pointer is stored if no suitable
+  // algorithm could be found for the requested interaction)
+  const XSecAlgorithmI* alg = this->FindXSecAlg( interaction );
+  fXSecAlgMap[ fp ] = std::make_pair( fFieldsBuffer, alg );
+  return alg;
+}
+//_________________________________________________________________________
+const XSecAlgorithmI* HybridXSecAlgorithm::FindXSecAlg(
+  const Interaction& interaction) const
 {
   std::string inter_str = interaction.AsString();
   RgKey key = "XSecAlg@Interaction=" + inter_str;
 
-  std::map<std::string, const XSecAlgorithmI*>::const_iterator
-    cend = fXSecAlgMap.cend();
-
-  std::map<std::string, const XSecAlgorithmI*>::const_iterator
-    citer = fXSecAlgMap.find( key );
-
-  // If the algorithm doesn't appear in the map, try to load it.
-  if ( citer == cend ) {
-
-    // If a key exists for the algorithm in the registry, load it
-    // and store it for rapid retrieval later
-    const Registry& temp_reg = this->GetConfig();
-    if ( temp_reg.Exists(key) ) {
-      const XSecAlgorithmI* temp_alg = dynamic_cast< const XSecAlgorithmI* >(
-        this->SubAlg(key) );
-      assert( temp_alg );
-
-      fXSecAlgMap[ inter_str ] = temp_alg;
-      return temp_alg;
-    }
-
-    // Otherwise, if the user has specified a default algorithm, then store a
-    // new entry for that one in the map
-    else if ( fDefaultXSecAlg ) {
-      fXSecAlgMap[ inter_str ] = fDefaultXSecAlg;
-      return fDefaultXSecAlg;
-    }
-
-    // Otherwise, store and return a null pointer. No suitable algorithm could
-    // be found for the requested interaction.
-    else {
-      fXSecAlgMap[ inter_str ] = NULL;
-      return NULL;
-    }
-
+  // If a key exists for the algorithm in the registry, load it
+  const Registry& temp_reg = this->GetConfig();
+  if ( temp_reg.Exists(key) ) {
+    const XSecAlgorithmI* temp_alg = dynamic_cast< const XSecAlgorithmI* >(
+      this->SubAlg(key) );
+    assert( temp_alg );
+    return temp_alg;
   }
 
-  // If an entry was found in the map, then just use that
-  else return citer->second;
+  // Otherwise, use the default algorithm if the user has specified one
+  // (or null)
+  return fDefaultXSecAlg;
 }
 //_________________________________________________________________________
 double HybridXSecAlgorithm::XSec(const Interaction* interaction,
@@ -115,6 +117,7 @@ void HybridXSecAlgorithm::Configure(std::string config)
 void HybridXSecAlgorithm::LoadConfig(void)
 {
   fDefaultXSecAlg = NULL;
+  fXSecAlgMap.clear();
 
   // The user can optionally configure a cross section algorithm
   // to use by default (i.e., whenever one wasn't explicitly specified
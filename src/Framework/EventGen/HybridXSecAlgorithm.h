@@ -28,6 +28,10 @@
 #ifndef _HYBRID_XSEC_ALG_H_
 #define _HYBRID_XSEC_ALG_H_
 
+#include <map>
+#include <utility>
+#include <vector>
+
 #include "Framework/EventGen/XSecAlgorithmI.h"
 
 namespace genie {
@@ -60,11 +64,20 @@ private:
   /// null pointer.
   const XSecAlgorithmI* ChooseXSecAlg(const Interaction& interaction) const;
 
-  /// Map specifying the managed cross section algorithms. Keys are strings
-  /// generated with Interaction::AsString() (identical to those used for
-  /// splines). Values are pointers to the corresponding cross section
-  /// algorithms.
-  mutable std::map<string, const XSecAlgorithmI*> fXSecAlgMap;
+  /// Look up the cross section algorithm for the interaction in the
+  /// registry (or the default one). Null if none was found.
+  const XSecAlgorithmI* FindXSecAlg(const Interaction& interaction) const;
+
+  /// Map specifying the managed cross section algorithms. Keys are the
+  /// Interaction::Fingerprint() values of the interactions (the registry
+  /// keys use Interaction::AsString(), identical to those used for splines).
+  /// Values are the Interaction::FingerprintFields() of the interactions,
+  /// compared on a hit to detect collisions, and pointers to the
+  /// corresponding cross section algorithms.
+  mutable std::map<ULong64_t, std::pair<std::vector<int>, const XSecAlgorithmI*> > fXSecAlgMap;
+
+  /// Scratch for Interaction::FingerprintFields()
+  mutable std::vector<int> fFieldsBuffer;
 
   /// Optional XSecAlgorithmI to use by default
   const XSecAlgorithmI* fDefaultXSecAlg;
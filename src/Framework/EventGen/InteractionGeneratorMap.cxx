@@ -64,6 +64,8 @@ void InteractionGeneratorMap::Init(void)
 
   fInitState       = new InitialState;
   fInteractionList = new InteractionList;
+
+  fUseFingerprints = false;
 }
 //___________________________________________________________________________
 void InteractionGeneratorMap::CleanUp(void)
@@ -72,6 +74,8 @@ void InteractionGeneratorMap::CleanUp(void)
   delete fInteractionList;
 
   this->clear();
+  fFingerprintMap.clear();
+  fUseFingerprints = false;
 }
 //___________________________________________________________________________
 void InteractionGeneratorMap::Copy(const InteractionGeneratorMap & xsmap)
@@ -91,6 +95,8 @@ void InteractionGeneratorMap::Copy(const InteractionGeneratorMap & xsmap)
 
     this->insert(map<string, const EventGeneratorI *>::value_type(code,evg));
   }
+
+  this->IndexFingerprints();
 }
 //___________________________________________________________________________
 void InteractionGeneratorMap::UseGeneratorList(const EventGeneratorList * l)
@@ -152,6 +158,46 @@ void InteractionGeneratorMap::BuildMap(const InitialState & init_state)
      delete ilst;
      ilst = 0;
   } // loop over event generators
+
+  this->IndexFingerprints();
+}
+//___________________________________________________________________________
+void InteractionGeneratorMap::IndexFingerprints(void)
+{
+// Index the map by interaction fingerprint too, so that look-ups don't need
+// to build the string code. In the (unlikely) case that two different string
+// codes share a fingerprint, keep using the string codes. The fingerprinted
+// fields are kept too, so that a look-up for an interaction outside the list
+// whose fingerprint collides with one in it is not taken as a hit.
+
+  fFingerprintMap.clear();
+  fUseFingerprints = true;
+
+  map<ULong64_t, string> codes;
+
+  InteractionList::const_iterator intliter = fInteractionList->begin();
+  for( ; intliter != fInteractionList->end(); ++intliter) {
+    const Interaction * interaction = *intliter;
+    string    code = interaction->AsString();
+    ULong64_t fp   = interaction->Fingerprint();
+
+    map<ULong64_t, string>::const_iterator cit = codes.find(fp);
+    if(cit != codes.end() && cit->second != code) {
+      LOG("IntGenMap", pWARN)
+        << "Interaction fingerprint collision: " << cit->second
+        << " and " << code << " - Look-ups will use the string codes";
+      fFingerprintMap.clear();
+      fUseFingerprints = false;
+      return;
+    }
+    codes[fp] = code;
+
+    InteractionGeneratorMap::const_iterator iter = this->find(code);
+    if(iter != this->end()) {
+      interaction->FingerprintFields(fFieldsBuffer);
+      fFingerprintMap[fp] = std::make_pair(fFieldsBuffer, iter->second);
+    }
+  }
 }
 //___________________________________________________________________________
 const EventGeneratorI * InteractionGeneratorMap::FindGenerator(
@@ -161,6 +207,14 @@ const EventGeneratorI * InteractionGeneratorMap::FindGenerator(
     LOG("IntGenMap", pWARN) << "Null interaction!!";
     return 0;
   }
+  if(fUseFingerprints) {
+    map<ULong64_t, pair<vector<int>, const EventGeneratorI *> >::const_iterator
+      fpiter = fFingerprintMap.find(interaction->Fingerprint());
+    if(fpiter != fFingerprintMap.end()) {
+      interaction->FingerprintFields(fFieldsBuffer);
+      if(fpiter->second.first == fFieldsBuffer) return fpiter->second.second;
+    }
+  }
   string code = interaction->AsString();
   InteractionGeneratorMap::const_iterator evgiter = this->find(code);
   if(evgiter == this->end()) {
@@ -23,12 +23,18 @@
 
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 #include <ostream>
 
+#include <Rtypes.h>
+
 #include "Framework/Interaction/Interaction.h"
 
 using std::map;
+using std::pair;
 using std::string;
+using std::vector;
 using std::ostream;
 
 namespace genie {
@@ -65,11 +71,16 @@ private:
 
   void Init    (void);
   void CleanUp (void);
+  void IndexFingerprints (void);
 
   const EventGeneratorList * fEventGeneratorList;
 
   InitialState *    fInitState;
   InteractionList * fInteractionList;
+
+  map<ULong64_t, pair<vector<int>, const EventGeneratorI *> > fFingerprintMap; ///< Interaction::Fingerprint() -> (Interaction::FingerprintFields(), generator)
+  mutable vector<int> fFieldsBuffer;   ///< scratch for Interaction::FingerprintFields()
+  bool                fUseFingerprints; ///< false if fingerprints collide (look-up by string code)
 };
 
 }      // genie namespace
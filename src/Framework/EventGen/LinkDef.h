@@ -8,6 +8,7 @@
 
 #pragma link C++ class genie::EventRecord;
 #pragma link C++ class genie::EventRecordVisitorI;
+#pragma link C++ class genie::EventRecordPool;
 #pragma link C++ class genie::GVldContext;
 #pragma link C++ class genie::EventGenerator;
 #pragma link C++ class genie::EventGeneratorI;
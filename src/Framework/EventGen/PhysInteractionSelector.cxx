@@ -12,20 +12,24 @@
 #include <sstream>
 #include <cstdlib>
 #include <iomanip>
+#include <algorithm>
 
 #include <TMath.h>
 #include <TLorentzVector.h>
+#include <TRandom3.h>
 
 #include "Framework/EventGen/XSecAlgorithmI.h"
 #include "Framework/Conventions/Units.h"
 #include "Framework/EventGen/PhysInteractionSelector.h"
 #include "Framework/EventGen/EventRecord.h"
+#include "Framework/EventGen/EventRecordPool.h"
 #include "Framework/EventGen/EventGeneratorI.h"
 #include "Framework/EventGen/InteractionList.h"
 #include "Framework/EventGen/InteractionGeneratorMap.h"
 #include "Framework/Messenger/Messenger.h"
 #include "Framework/Numerical/RandomGen.h"
 #include "Framework/Numerical/Spline.h"
+#include "Framework/Utils/PerfMonitor.h"
 #include "Framework/Utils/XSecSplineList.h"
 #include "Framework/Utils/PrintUtils.h"
 
@@ -40,13 +44,23 @@ using namespace genie;
 
 //___________________________________________________________________________
 PhysInteractionSelector::PhysInteractionSelector() :
-InteractionSelectorI("genie::PhysInteractionSelector")
+InteractionSelectorI("genie::PhysInteractionSelector"),
+fCompiledMap(0),
+fCompiledGeneration(0),
+fUseChannelTable(false),
+fChannelTableNKnots(200),
+fValidateChannelTable(0)
 {
 
 }
 //___________________________________________________________________________
 PhysInteractionSelector::PhysInteractionSelector(string config) :
-InteractionSelectorI("genie::PhysInteractionSelector", config)
+InteractionSelectorI("genie::PhysInteractionSelector", config),
+fCompiledMap(0),
+fCompiledGeneration(0),
+fUseChannelTable(false),
+fChannelTableNKnots(200),
+fValidateChannelTable(0)
 {
 
 }
@@ -70,6 +84,15 @@ EventRecord * PhysInteractionSelector::SelectInteraction
      return 0;
   }
 
+  // Fast path: splines resolved in advance for this interaction map.
+  // Resolve them again if the spline list replaced or dropped splines since.
+  if(fUseSplines && fCompiledMap == igmap && !this->IsCompiledFor(igmap)) {
+    this->Compile(igmap);
+  }
+  if(fUseSplines && this->IsCompiledFor(igmap)) {
+    return this->SelectCompiled(p4);
+  }
+
   // Get the list of spline objects
   // Should have been constructed at the job initialization
   XSecSplineList * xssl = 0;
@@ -78,26 +101,34 @@ EventRecord * PhysInteractionSelector::SelectInteraction
   const InteractionList & ilst = igmap->GetInteractionList();
   vector<double> xseclist(ilst.size());
 
-  string istate = ilst[0]->InitState().AsString();
-  ostringstream msg;
-  msg << "Selecting an interaction for the given initial state = "
-      << istate << " at E = " << p4.E() << " GeV";
+  // The cross section table is only formatted if it is going to be printed
+  bool print_table =
+      (*Messenger::Instance())("IntSel").isPriorityEnabled(pNOTICE);
 
-  LOG("IntSel", pNOTICE)
-             << utils::print::PrintFramedMesg(msg.str(), 0, '=');
-  LOG("IntSel", pNOTICE)
-     << "Computing xsecs for all relevant modeled interactions:";
+  if(print_table) {
+    string istate = ilst[0]->InitState().AsString();
+    ostringstream msg;
+    msg << "Selecting an interaction for the given initial state = "
+        << istate << " at E = " << p4.E() << " GeV";
+
+    LOG("IntSel", pNOTICE)
+               << utils::print::PrintFramedMesg(msg.str(), 0, '=');
+    LOG("IntSel", pNOTICE)
+       << "Computing xsecs for all relevant modeled interactions:";
+  }
 
   unsigned int i=0;
   InteractionList::const_iterator intliter = ilst.begin();
 
   ostringstream xsec_table_printout;
 
-  xsec_table_printout
-      << " |"  << setfill('-') << setw(112) << "|" << endl
-      << " | " << setfill(' ') << setw(80) << "interaction"
-      << " | cross-section (1E-38*cm^2) |" << endl
-      << " |"  << setfill('-') << setw(112) << "|" << endl;
+  if(print_table) {
+    xsec_table_printout
+        << " |"  << setfill('-') << setw(112) << "|" << endl
+        << " | " << setfill(' ') << setw(80) << "interaction"
+        << " | cross-section (1E-38*cm^2) |" << endl
+        << " |"  << setfill('-') << setw(112) << "|" << endl;
+  }
 
   for( ; intliter != ilst.end(); ++intliter) {
 
@@ -114,7 +145,7 @@ EventRecord * PhysInteractionSelector::SelectInteraction
 
      double xsec = 0; // cross section for this interaction
 
-     bool spline_computed = xssl->SplineExists(xsec_alg, interaction);
+     bool spline_computed = fUseSplines && xssl->SplineExists(xsec_alg, interaction);
      bool eval = fUseSplines && spline_computed;
      if (eval) {
            const InitialState & init = interaction->InitState();
@@ -129,6 +160,7 @@ EventRecord * PhysInteractionSelector::SelectInteraction
            if(spl->ClosestKnotValueIsZero(E,"-")) xsec = 0;
            else xsec = spl->Evaluate(E);
      } else {
+           PerfTimer timer(PerfMonitor::Instance()->IntegratorCounter(xsec_alg));
            xsec = xsec_alg->Integral(interaction);
      }
      TMath::Max(0., xsec);
@@ -138,21 +170,25 @@ EventRecord * PhysInteractionSelector::SelectInteraction
        << " --> xsec " << (eval ? "[**interp**]" : "[**calc**]")
        << " = " << xsec/genie::units::cm2 << " cm^2";
 */
-     xsec_table_printout
-           << " | " << setfill(' ') << setw(80) << interaction->AsString()
-           << " | " << setfill(' ') << setw(26) << xsec/(1E-38*genie::units::cm2)
-           << " | " << endl;
+     if(print_table) {
+       xsec_table_printout
+             << " | " << setfill(' ') << setw(80) << interaction->AsString()
+             << " | " << setfill(' ') << setw(26) << xsec/(1E-38*genie::units::cm2)
+             << " | " << endl;
+     }
 
      xseclist[i++] = xsec;
      delete interaction;
 
   } // loop over interaction that can be generated
 
-  xsec_table_printout
-      << " |"  << setfill('-') << setw(112) << "|" << endl;
+  if(print_table) {
+    xsec_table_printout
+        << " |"  << setfill('-') << setw(112) << "|" << endl;
 
-  LOG("IntSel", pNOTICE)
-    << "\n" << xsec_table_printout.str();
+    LOG("IntSel", pNOTICE)
+      << "\n" << xsec_table_printout.str();
+  }
 
   // select an interaction
 
@@ -178,30 +214,333 @@ EventRecord * PhysInteractionSelector::SelectInteraction
                << "Sum{xsec}(0->" << iint <<") = " << xseclist[iint];
 
      if( R < xseclist[iint] ) {
-       Interaction * selected_interaction = new Interaction (*ilst[iint]);
-       selected_interaction->InitStatePtr()->SetProbeP4(p4);
-
        // set the cross section for the selected interaction (just extract it
        // from the array of summed xsecs rather than recomputing it)
        double xsec_pedestal = (iint > 0) ? xseclist[iint-1] : 0.;
        double xsec = xseclist[iint] - xsec_pedestal;
        assert(xsec>0);
 
-       LOG("IntSel", pNOTICE)
-         << "Selected interaction: " << selected_interaction->AsString();
-
-       // bootstrap the event record
-       EventRecord * evrec = new EventRecord;
-       evrec->AttachSummary(selected_interaction);
-       evrec->SetXSec(xsec);
-
-       return evrec;
+       return this->Bootstrap(ilst[iint], p4, xsec);
      }
   }
   LOG("IntSel", pERROR) << "Could not select interaction";
   return 0;
 }
 //___________________________________________________________________________
+EventRecord * PhysInteractionSelector::SelectCompiled(
+                                          const TLorentzVector & p4) const
+{
+// Same selection as the generic path (same cross sections, same random
+// number consumption), using the splines resolved by Compile().
+// If enabled, the channel is picked from the precomputed cumulative cross
+// section table instead.
+
+  const double E = p4.E();
+  if(TMath::IsNaN(E)) {
+    BLOG("IntSel", pFATAL) << "E = " << E;
+    abort();
+  }
+
+  RandomGen * rnd = RandomGen::Instance();
+  double r = rnd->RndISel().Rndm();
+
+  double xsec = 0;
+  int iint = (this->HasChannelTable()) ?
+       this->SelectFromTable (E, r, xsec) :
+       this->SelectExact     (E, r, xsec);
+
+  if(iint < 0) {
+    LOG("IntSel", pERROR) << "Could not select interaction";
+    return 0;
+  }
+  assert(xsec>0);
+
+  return this->Bootstrap(fInteractions[iint], p4, xsec);
+}
+//___________________________________________________________________________
+double PhysInteractionSelector::ChannelXSec(int i, double E) const
+{
+  const Spline * spl = fSplines[i];
+  return (spl->ClosestKnotValueIsZero(E,"-")) ? 0. : spl->Evaluate(E);
+}
+//___________________________________________________________________________
+int PhysInteractionSelector::SelectExact(double E, double r, double & xsec) const
+{
+// Evaluate all channel splines at E, and pick the first channel for which
+// r * Sum{xsec} < running sum. Returns the channel index (-1 on failure).
+
+  const int n = fSplines.size();
+  double * sum = &fXSecSum[0];
+
+  double xsec_sum = 0;
+  for(int i = 0; i < n; i++) {
+    xsec_sum += this->ChannelXSec(i, E);
+    sum[i]    = xsec_sum;
+  }
+
+  double R = xsec_sum * r;
+
+  LOG("IntSel", pINFO)
+      << "Generating Rndm (0. -> max = " << xsec_sum << ") = " << R;
+
+  // first entry with R < running sum
+  const double * sel = std::upper_bound(sum, sum + n, R);
+  if(sel == sum + n) return -1;
+
+  int iint = sel - sum;
+
+  // set the cross section for the selected interaction (just extract it
+  // from the array of summed xsecs rather than recomputing it)
+  double xsec_pedestal = (iint > 0) ? sum[iint-1] : 0.;
+  xsec = sum[iint] - xsec_pedestal;
+
+  return iint;
+}
+//___________________________________________________________________________
+int PhysInteractionSelector::SelectFromTable(double E, double r, double & xsec) const
+{
+// Interpolate (linearly in log E) between the two table rows bracketing E.
+// Each row holds the running sum of the channel cross sections, so the
+// interpolated row is non-decreasing too and can be binary searched without
+// evaluating it in full. Only the cross section of the selected channel is
+// computed exactly.
+// Outside the table, and in the energy bins where a channel opens or closes
+// (its cross section is zero at one end only), the interpolated table gives
+// weight to channels below threshold: the exact selection is made there
+// instead, with the same random number. Returns the channel index (-1 on
+// failure).
+
+  const int nk = fTableE.size();
+  const int n  = fSplines.size();
+  if(nk < 2 || E < fTableE[0] || E > fTableE[nk-1]) {
+    return this->SelectExact(E, r, xsec);
+  }
+
+  int k = std::upper_bound(fTableE.begin(), fTableE.end(), E) - fTableE.begin() - 1;
+  k = TMath::Min(TMath::Max(k, 0), nk-2);
+  if(fTableThreshold[k]) return this->SelectExact(E, r, xsec);
+  double t = (TMath::Log(E) - TMath::Log(fTableE[k])) /
+             (TMath::Log(fTableE[k+1]) - TMath::Log(fTableE[k]));
+
+  const double * row0 = &fTableSum[k    *n];
+  const double * row1 = &fTableSum[(k+1)*n];
+
+  double R = r * ((1-t)*row0[n-1] + t*row1[n-1]);
+
+  // first entry with R < interpolated running sum
+  int lo = 0, hi = n;
+  while(lo < hi) {
+    int mid = (lo + hi) / 2;
+    double sum = (1-t)*row0[mid] + t*row1[mid];
+    if(R < sum) hi = mid;
+    else        lo = mid + 1;
+  }
+  if(lo >= n) return -1;
+
+  // only for a spline vanishing within a bin where it is non-zero at both
+  // ends
+  xsec = this->ChannelXSec(lo, E);
+  if(xsec <= 0) return this->SelectExact(E, r, xsec);
+
+  return lo;
+}
+//___________________________________________________________________________
+void PhysInteractionSelector::BuildChannelTable(void) const
+{
+// Tabulate the running sum of the channel cross sections on a grid of
+// energies, log-spaced over the range covered by the channel splines.
+
+  fTableE.clear();
+  fTableSum.clear();
+  fTableThreshold.clear();
+
+  const int n = fSplines.size();
+  if(n == 0 || fChannelTableNKnots < 2) return;
+
+  double Emin = fSplines[0]->XMin();
+  double Emax = fSplines[0]->XMax();
+  for(int i = 1; i < n; i++) {
+    Emin = TMath::Min(Emin, fSplines[i]->XMin());
+    Emax = TMath::Max(Emax, fSplines[i]->XMax());
+  }
+  Emin = TMath::Max(Emin, 1E-6);
+  if(Emax <= Emin) return;
+
+  const int nk = fChannelTableNKnots;
+  double dlogE = (TMath::Log(Emax) - TMath::Log(Emin)) / (nk-1);
+
+  fTableE.resize(nk);
+  fTableSum.resize(nk*n);
+  for(int k = 0; k < nk; k++) {
+    double E = (k == nk-1) ? Emax : TMath::Exp(TMath::Log(Emin) + k*dlogE);
+    fTableE[k] = E;
+    double xsec_sum = 0;
+    for(int i = 0; i < n; i++) {
+      xsec_sum += this->ChannelXSec(i, E);
+      fTableSum[k*n+i] = xsec_sum;
+    }
+  }
+
+  // flag the bins where a channel opens or closes
+  fTableThreshold.assign(nk-1, false);
+  int nthr = 0;
+  for(int k = 0; k < nk-1; k++) {
+    for(int i = 0; i < n && !fTableThreshold[k]; i++) {
+      double x0 = fTableSum[k*n+i]     - ((i > 0) ? fTableSum[k*n+i-1]     : 0.);
+      double x1 = fTableSum[(k+1)*n+i] - ((i > 0) ? fTableSum[(k+1)*n+i-1] : 0.);
+      fTableThreshold[k] = ((x0 > 0) != (x1 > 0));
+    }
+    if(fTableThreshold[k]) nthr++;
+  }
+
+  LOG("IntSel", pNOTICE)
+    << "Built cumulative cross section table for " << n << " channels at "
+    << nk << " energies in [" << Emin << ", " << Emax << "] GeV ("
+    << nthr << " threshold bins, selected exactly)";
+
+  if(fValidateChannelTable > 0) {
+    const int nE = 5;
+    for(int j = 0; j < nE; j++) {
+      double E = TMath::Exp(TMath::Log(Emin) +
+                 (j+0.5) * (TMath::Log(Emax) - TMath::Log(Emin)) / nE);
+      this->ValidateChannelTable(E, fValidateChannelTable);
+    }
+    // and just above each threshold bin, where the interpolated table is
+    // the least accurate
+    vector<double> Ethr = this->ChannelTableThresholds();
+    for(unsigned int j = 0; j < Ethr.size(); j++) {
+      this->ValidateChannelTable(Ethr[j], fValidateChannelTable);
+    }
+  }
+}
+//___________________________________________________________________________
+vector<double> PhysInteractionSelector::ChannelTableThresholds(void) const
+{
+// Energies in the middle of the table bins that follow a threshold bin
+
+  vector<double> E;
+  const int nk = fTableE.size();
+  for(int k = 0; k < nk-2; k++) {
+    if(fTableThreshold[k] && !fTableThreshold[k+1]) {
+      E.push_back(TMath::Sqrt(fTableE[k+1] * fTableE[k+2]));
+    }
+  }
+  return E;
+}
+//___________________________________________________________________________
+double PhysInteractionSelector::ValidateChannelTable(double E, int nsample) const
+{
+// Draw nsample channels at energy E with both the exact and the tabulated
+// selection and compare the channel frequencies. Uses its own random number
+// generator, so validating doesn't change the generated events.
+// Returns the chi2/ndf of the comparison (-1 if it can't be performed).
+
+  if(!this->HasChannelTable() || nsample <= 0) return -1;
+
+  const int n = fSplines.size();
+  vector<double> nexact(n, 0.), ntable(n, 0.);
+
+  TRandom3 rnd(65539);
+  double xsec = 0;
+  for(int is = 0; is < nsample; is++) {
+    int ie = this->SelectExact(E, rnd.Rndm(), xsec);
+    if(ie >= 0) nexact[ie]++;
+    int it = this->SelectFromTable(E, rnd.Rndm(), xsec);
+    if(it >= 0) ntable[it]++;
+  }
+
+  double chi2 = 0, maxdiff = 0;
+  int ndf = 0;
+  for(int i = 0; i < n; i++) {
+    double ntot = nexact[i] + ntable[i];
+    if(ntot <= 0) continue;
+    chi2 += TMath::Power(nexact[i] - ntable[i], 2) / ntot;
+    maxdiff = TMath::Max(maxdiff, TMath::Abs(nexact[i] - ntable[i]) / nsample);
+    ndf++;
+  }
+  double chi2ndf = (ndf > 0) ? chi2/ndf : 0.;
+
+  LOG("IntSel", pNOTICE)
+    << "Channel table validation at E = " << E << " GeV (" << nsample
+    << " samples): chi2/ndf = " << chi2ndf << " (ndf = " << ndf
+    << "), max. channel frequency difference = " << maxdiff;
+
+  return chi2ndf;
+}
+//___________________________________________________________________________
+EventRecord * PhysInteractionSelector::Bootstrap(
+  const Interaction * in, const TLorentzVector & p4, double xsec) const
+{
+  // bootstrap the event record (re-using a pooled record & summary)
+  EventRecord * evrec = EventRecordPool::Instance()->Get(in);
+  Interaction * selected_interaction = evrec->Summary();
+  selected_interaction->InitStatePtr()->SetProbeP4(p4);
+  evrec->SetXSec(xsec);
+
+  if( (*Messenger::Instance())("IntSel").isPriorityEnabled(pNOTICE) ) {
+    LOG("IntSel", pNOTICE)
+      << "Selected interaction: " << selected_interaction->AsString();
+  }
+
+  return evrec;
+}
+//___________________________________________________________________________
+bool PhysInteractionSelector::Compile(const InteractionGeneratorMap * igmap) const
+{
+  fCompiledMap = 0;
+  fInteractions.clear();
+  fSplines.clear();
+  fXSecSum.clear();
+  fTableE.clear();
+  fTableSum.clear();
+  fTableThreshold.clear();
+
+  if(!fUseSplines || !igmap || igmap->size() <= 0) return false;
+
+  XSecSplineList * xssl = XSecSplineList::Instance();
+
+  const InteractionList & ilst = igmap->GetInteractionList();
+  InteractionList::const_iterator intliter = ilst.begin();
+  for( ; intliter != ilst.end(); ++intliter) {
+     const Interaction * interaction = *intliter;
+     const XSecAlgorithmI * xsec_alg =
+               igmap->FindGenerator(interaction)->CrossSectionAlg();
+     assert(xsec_alg);
+     const Spline * spl = xssl->GetSpline(xsec_alg, interaction);
+     if(!spl) {
+       LOG("IntSel", pINFO)
+         << "No spline for " << interaction->AsString()
+         << " - Interactions for this initial state will be selected"
+         << " without the precompiled spline table";
+       fInteractions.clear();
+       fSplines.clear();
+       return false;
+     }
+     fInteractions.push_back(interaction);
+     fSplines.push_back(spl);
+  }
+  if(fSplines.size() == 0) return false;
+
+  fXSecSum.resize(fSplines.size(), 0.);
+  fCompiledMap = igmap;
+  fCompiledGeneration = xssl->Generation();
+
+  if(fUseChannelTable) this->BuildChannelTable();
+
+  LOG("IntSel", pINFO)
+    << "Compiled spline table with " << fSplines.size() << " interactions";
+
+  return true;
+}
+//___________________________________________________________________________
+bool PhysInteractionSelector::IsCompiledFor(
+                              const InteractionGeneratorMap * igmap) const
+{
+  return (fCompiledMap != 0 && fCompiledMap == igmap &&
+          fSplines.size() == igmap->GetInteractionList().size() &&
+          fCompiledGeneration == XSecSplineList::Instance()->Generation());
+}
+//___________________________________________________________________________
 void PhysInteractionSelector::Configure(const Registry & config)
 {
   Algorithm::Configure(config);
@@ -221,5 +560,14 @@ void PhysInteractionSelector::LoadConfigData(void)
   fUseSplines = false ;
   GetParam( "UseStoredXSecs", fUseSplines ) ;
 
+  // optionally pick channels from a table of cumulative cross sections,
+  // precomputed on an energy grid, rather than evaluating every spline
+  GetParamDef( "UseChannelTable",       fUseChannelTable,      false ) ;
+  GetParamDef( "ChannelTableNKnots",    fChannelTableNKnots,   200   ) ;
+  GetParamDef( "ValidateChannelTable",  fValidateChannelTable, 0     ) ;
+
+  // a change of configuration invalidates the compiled spline table
+  fCompiledMap = 0;
+
 }
 //___________________________________________________________________________
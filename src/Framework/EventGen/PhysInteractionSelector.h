@@ -7,6 +7,23 @@
 
          Is a concrete implementation of the InteractionSelectorI interface.
 
+         When the cross sections are evaluated from splines, the selector can
+         be compiled for the InteractionGeneratorMap of its driver (see
+         Compile(), called by GEVGDriver): the spline of every interaction is
+         looked-up once and kept in a dense array, so that selecting an
+         interaction only requires evaluating the splines and searching the
+         running sum of the cross sections, with no per-channel allocations
+         or string-keyed look-ups. The spline pointers are only valid as
+         long as the XSecSplineList does not replace or drop splines: the
+         selector is recompiled when the list generation changes.
+         Optionally (UseChannelTable), the running sum of the channel cross
+         sections is also tabulated on an energy grid at compile time and the
+         channel is picked by a binary search of the interpolated table; only
+         the cross section of the selected channel is then evaluated. In the
+         table bins where a channel opens or closes, the selection is always
+         exact. The ValidateChannelTable option compares the channel
+         frequencies obtained from the table against the exact selection.
+
 \author  Costas Andreopoulos <constantinos.andreopoulos \at cern.ch>
  University of Liverpool & STFC Rutherford Appleton Laboratory
 
@@ -20,10 +37,17 @@
 #ifndef _PHYS_INTERACTION_SELECTOR_H_
 #define _PHYS_INTERACTION_SELECTOR_H_
 
+#include <vector>
+
 #include "Framework/EventGen/InteractionSelectorI.h"
 
+using std::vector;
+
 namespace genie {
 
+class Interaction;
+class Spline;
+
 class PhysInteractionSelector : public InteractionSelectorI {
 
 public :
@@ -40,10 +64,44 @@ public :
   void Configure (const Registry & config);
   void Configure (string param_set);
 
+  //! resolve the cross section spline of every interaction in the input map;
+  //! returns false (and keeps using the generic selection) if any is missing
+  bool Compile     (const InteractionGeneratorMap * igmp) const;
+  bool IsCompiledFor (const InteractionGeneratorMap * igmp) const;
+
+  //! compare the channel frequencies of the tabulated and exact selection at
+  //! energy E over nsample draws; returns chi2/ndf (-1 if there is no table)
+  double ValidateChannelTable (double E, int nsample) const;
+  bool   HasChannelTable      (void) const { return fTableE.size() > 1; }
+
+  //! energies just above the table bins where a channel opens or closes
+  //! (the channels are selected exactly within these bins)
+  vector<double> ChannelTableThresholds (void) const;
+
 private:
   void LoadConfigData (void);
 
+  EventRecord * SelectCompiled (const TLorentzVector & p4) const;
+  EventRecord * Bootstrap      (const Interaction * in, const TLorentzVector & p4, double xsec) const;
+  double        ChannelXSec     (int i, double E) const;
+  int           SelectExact     (double E, double r, double & xsec) const;
+  int           SelectFromTable (double E, double r, double & xsec) const;
+  void          BuildChannelTable (void) const;
+
   bool fUseSplines;
+
+  mutable const InteractionGeneratorMap * fCompiledMap;  ///< map the selector is compiled for (null if not compiled)
+  mutable unsigned long                   fCompiledGeneration; ///< XSecSplineList generation it was compiled against
+  mutable vector<const Interaction *>     fInteractions; ///< interactions of the compiled map (not owned)
+  mutable vector<const Spline *>          fSplines;      ///< their cross section splines (not owned)
+  mutable vector<double>          fXSecSum;      ///< running sum of cross sections (preallocated work space)
+
+  bool           fUseChannelTable;      ///< select channels from the precomputed table?
+  int            fChannelTableNKnots;   ///< number of table energies
+  int            fValidateChannelTable; ///< number of samples for validating the table (0: off)
+  mutable vector<double> fTableE;       ///< table energies (log-spaced)
+  mutable vector<double> fTableSum;     ///< running sum of channel xsecs, [energy][channel]
+  mutable vector<bool>   fTableThreshold; ///< bins where a channel opens or closes, [energy bin]
 };
 
 }      // genie namespace
@@ -10,6 +10,7 @@
 
 #include "Framework/EventGen/XSecAlgorithmI.h"
 #include "Framework/Messenger/Messenger.h"
+#include "Framework/Utils/KineUtils.h"
 
 using namespace genie;
 
@@ -57,3 +58,31 @@ bool XSecAlgorithmI::ValidKinematics(const Interaction* interaction) const
   return true;
 }
 //___________________________________________________________________________
+void XSecAlgorithmI::XSecBatch(
+   Interaction* interaction, KinePhaseSpace_t kps,
+   const KineVar_t * vars, int nvar, int n, const double * pts,
+   double * xsec) const
+{
+  for(int i = 0; i < n; i++) {
+    this->SetBatchPoint(interaction, vars, nvar, pts + i*nvar);
+    xsec[i] = this->XSec(interaction, kps);
+  }
+}
+//___________________________________________________________________________
+void XSecAlgorithmI::SetBatchPoint(
+   Interaction* interaction, const KineVar_t * vars, int nvar,
+   const double * pt) const
+{
+// Sets the running values of the listed kinematic variables. As the kinematic
+// generators do, W and Q2 are updated for points given in (x,y).
+
+  Kinematics * kine = interaction->KinePtr();
+  bool has_x = false, has_y = false;
+  for(int j = 0; j < nvar; j++) {
+    kine->SetKV(vars[j], pt[j]);
+    if(vars[j] == kKVx) has_x = true;
+    if(vars[j] == kKVy) has_y = true;
+  }
+  if(has_x && has_y) utils::kinematics::UpdateWQ2FromXY(interaction);
+}
+//___________________________________________________________________________
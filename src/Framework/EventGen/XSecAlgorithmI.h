@@ -20,6 +20,7 @@
 
 #include "Framework/Algorithm/Algorithm.h"
 #include "Framework/Conventions/KinePhaseSpace.h"
+#include "Framework/Conventions/KineVar.h"
 #include "Framework/Interaction/Interaction.h"
 
 namespace genie {
@@ -42,10 +43,25 @@ public:
   //! Is the input kinematical point a physically allowed one?
   virtual bool ValidKinematics (const Interaction* i) const;
 
+  //! Compute the cross section at a batch of n kinematical points.
+  //! The values of the nvar kinematic variables listed in vars are read for
+  //! each point from the flat array pts (n x nvar, point after point) and set
+  //! as running values of the input interaction, and the cross sections are
+  //! written to the flat array xsec (n values). The interaction is left at
+  //! the kinematics of the last point. The default implementation calls
+  //! XSec() for each point; models can override it to hoist the work that
+  //! does not depend on the kinematics out of the loop.
+  virtual void XSecBatch (Interaction* i, KinePhaseSpace_t k,
+                          const KineVar_t * vars, int nvar,
+                          int n, const double * pts, double * xsec) const;
+
 protected:
   XSecAlgorithmI();
   XSecAlgorithmI(string name);
   XSecAlgorithmI(string name, string config);
+
+  //! Set the kinematics of the input interaction to a batch point
+  void SetBatchPoint (Interaction* i, const KineVar_t * vars, int nvar, const double * pt) const;
 };
 
 }       // genie namespace
@@ -58,6 +58,8 @@ void XSecAlgorithmMap::Init(void)
 
   fInitState       = new InitialState;
   fInteractionList = new InteractionList;
+
+  fUseFingerprints = false;
 }
 //___________________________________________________________________________
 void XSecAlgorithmMap::CleanUp(void)
@@ -66,6 +68,8 @@ void XSecAlgorithmMap::CleanUp(void)
   delete fInteractionList;
 
   this->clear();
+  fFingerprintMap.clear();
+  fUseFingerprints = false;
 }
 //___________________________________________________________________________
 void XSecAlgorithmMap::Copy(const XSecAlgorithmMap & xsmap)
@@ -85,6 +89,8 @@ void XSecAlgorithmMap::Copy(const XSecAlgorithmMap & xsmap)
 
     this->insert(map<string, const XSecAlgorithmI *>::value_type(code,alg));
   }
+
+  this->IndexFingerprints();
 }
 //___________________________________________________________________________
 void XSecAlgorithmMap::UseGeneratorList(const EventGeneratorList * list)
@@ -153,6 +159,46 @@ void XSecAlgorithmMap::BuildMap(const InitialState & init_state)
      delete ilst;
      ilst = 0;
   } // loop over event generators
+
+  this->IndexFingerprints();
+}
+//___________________________________________________________________________
+void XSecAlgorithmMap::IndexFingerprints(void)
+{
+// Index the map by interaction fingerprint too, so that look-ups don't need
+// to build the string code. In the (unlikely) case that two different string
+// codes share a fingerprint, keep using the string codes. The fingerprinted
+// fields are kept too, so that a look-up for an interaction outside the list
+// whose fingerprint collides with one in it is not taken as a hit.
+
+  fFingerprintMap.clear();
+  fUseFingerprints = true;
+
+  map<ULong64_t, string> codes;
+
+  InteractionList::const_iterator intliter = fInteractionList->begin();
+  for( ; intliter != fInteractionList->end(); ++intliter) {
+    const Interaction * interaction = *intliter;
+    string    code = interaction->AsString();
+    ULong64_t fp   = interaction->Fingerprint();
+
+    map<ULong64_t, string>::const_iterator cit = codes.find(fp);
+    if(cit != codes.end() && cit->second != code) {
+      LOG("XSecAlgMap", pWARN)
+        << "Interaction fingerprint collision: " << cit->second
+        << " and " << code << " - Look-ups will use the string codes";
+      fFingerprintMap.clear();
+      fUseFingerprints = false;
+      return;
+    }
+    codes[fp] = code;
+
+    XSecAlgorithmMap::const_iterator iter = this->find(code);
+    if(iter != this->end()) {
+      interaction->FingerprintFields(fFieldsBuffer);
+      fFingerprintMap[fp] = std::make_pair(fFieldsBuffer, iter->second);
+    }
+  }
 }
 //___________________________________________________________________________
 const XSecAlgorithmI * XSecAlgorithmMap::FindXSecAlgorithm(
@@ -163,6 +209,15 @@ const XSecAlgorithmI * XSecAlgorithmMap::FindXSecAlgorithm(
     return 0;
   }
 
+  if(fUseFingerprints) {
+    map<ULong64_t, pair<vector<int>, const XSecAlgorithmI *> >::const_iterator
+      fpiter = fFingerprintMap.find(interaction->Fingerprint());
+    if(fpiter != fFingerprintMap.end()) {
+      interaction->FingerprintFields(fFieldsBuffer);
+      if(fpiter->second.first == fFieldsBuffer) return fpiter->second.second;
+    }
+  }
+
   string code = interaction->AsString();
 
   XSecAlgorithmMap::const_iterator xsec_alg_iter = this->find(code);
@@ -22,10 +22,16 @@
 
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 #include <ostream>
 
+#include <Rtypes.h>
+
 using std::map;
+using std::pair;
 using std::string;
+using std::vector;
 using std::ostream;
 
 namespace genie {
@@ -64,11 +70,16 @@ private:
 
   void Init    (void);
   void CleanUp (void);
+  void IndexFingerprints (void);
 
   const EventGeneratorList * fEventGeneratorList;
 
   InitialState *    fInitState;
   InteractionList * fInteractionList;
+
+  map<ULong64_t, pair<vector<int>, const XSecAlgorithmI *> > fFingerprintMap; ///< Interaction::Fingerprint() -> (Interaction::FingerprintFields(), xsec algorithm)
+  mutable vector<int> fFieldsBuffer;   ///< scratch for Interaction::FingerprintFields()
+  bool                fUseFingerprints; ///< false if fingerprints collide (look-up by string code)
 };
 
 }      // genie namespace
@@ -227,6 +227,29 @@ TLorentzVector * GHepParticle::GetX4(void) const
   }
 }
 //___________________________________________________________________________
+void GHepParticle::Set(int pdg, GHepStatus_t status,
+        int mother1, int mother2, int daughter1, int daughter2,
+        double px, double py, double pz, double En,
+        double x, double y, double z, double t)
+{
+  this->SetPdgCode(pdg);
+
+  fStatus         = status;
+  fFirstMother    = mother1;
+  fLastMother     = mother2;
+  fFirstDaughter  = daughter1;
+  fLastDaughter   = daughter2;
+
+  this->SetMomentum(px,py,pz,En);
+  this->SetPosition(x,y,z,t);
+
+  fRescatterCode  = -1;
+  fPolzTheta      = -999;
+  fPolzPhi        = -999;
+  fIsBound        = false;
+  fRemovalEnergy  = 0.;
+}
+//___________________________________________________________________________
 void GHepParticle::SetPdgCode(int code)
 {
   fPdgCode = code;
@@ -512,6 +535,31 @@ bool GHepParticle::CompareMomentum(const GHepParticle * p) const
   return same_momentum;
 }
 //___________________________________________________________________________
+bool GHepParticle::IsIdentical(const GHepParticle & p) const
+{
+// Exact comparison of all data members, as needed to decide whether an
+// entry was modified (unlike Compare(), which is a physics comparison)
+
+  if( fPdgCode       != p.fPdgCode       ||
+      fStatus        != p.fStatus        ||
+      fRescatterCode != p.fRescatterCode ||
+      fFirstMother   != p.fFirstMother   ||
+      fLastMother    != p.fLastMother    ||
+      fFirstDaughter != p.fFirstDaughter ||
+      fLastDaughter  != p.fLastDaughter  ||
+      fPolzTheta     != p.fPolzTheta     ||
+      fPolzPhi       != p.fPolzPhi       ||
+      fRemovalEnergy != p.fRemovalEnergy ||
+      fIsBound       != p.fIsBound ) return false;
+
+  if( (fP4 == 0) != (p.fP4 == 0) ) return false;
+  if( fP4 && *fP4 != *p.fP4 )      return false;
+  if( (fX4 == 0) != (p.fX4 == 0) ) return false;
+  if( fX4 && *fX4 != *p.fX4 )      return false;
+
+  return true;
+}
+//___________________________________________________________________________
 void GHepParticle::Copy(const GHepParticle & particle)
 {
   this->SetStatus           (particle.Status()          );
@@ -105,6 +105,7 @@ public :
   bool CompareStatusCodes (const GHepParticle * p) const;
   bool CompareFamily      (const GHepParticle * p) const;
   bool CompareMomentum    (const GHepParticle * p) const;
+  bool IsIdentical        (const GHepParticle & p) const; ///< all data members equal (no tolerance)
 
   // On/Off "shellness" if mass from PDG != mass from 4-P
   bool IsOnMassShell  (void) const;
@@ -121,6 +122,13 @@ public :
   bool   PolzIsSet        (void) const;
   void   GetPolarization  (TVector3 & polz);
 
+  // Set all data members at once, re-using the allocated 4-vectors
+  // (equivalent to constructing a new particle, without memory allocation)
+  void Set (int pdg, GHepStatus_t status,
+            int mother1, int mother2, int daughter1, int daughter2,
+            double px, double py, double pz, double E,
+            double x, double y, double z, double t);
+
   // Set pdg code and status codes
   void SetPdgCode  (int c);
   void SetStatus   (GHepStatus_t s) { fStatus = s; }
@@ -506,7 +506,8 @@ void GHepRecord::AddParticle(const GHepParticle & p)
   LOG("GHEP", pINFO)
     << "Adding particle with pdgc = " << p.Pdg() << " at slot = " << pos;
 #endif
-  new ((*this)[pos]) GHepParticle(p);
+  GHepParticle * np = (GHepParticle *) this->ConstructedAt(pos);
+  np->Copy(p);
 
   // Update the mother's daughter list. If the newly inserted particle broke
   // compactification, then run CompactifyDaughterLists()
@@ -525,7 +526,9 @@ void GHepRecord::AddParticle(
   LOG("GHEP", pINFO)
            << "Adding particle with pdgc = " << pdg << " at slot = " << pos;
 #endif
-  new ((*this)[pos]) GHepParticle(pdg,status, mom1,mom2,dau1,dau2, p, v);
+  GHepParticle * np = (GHepParticle *) this->ConstructedAt(pos);
+  np->Set(pdg, status, mom1, mom2, dau1, dau2,
+          p.Px(), p.Py(), p.Pz(), p.E(), v.X(), v.Y(), v.Z(), v.T());
 
   // Update the mother's daughter list. If the newly inserted particle broke
   // compactification, then run CompactifyDaughterLists()
@@ -545,8 +548,8 @@ void GHepRecord::AddParticle(
   LOG("GHEP", pINFO)
            << "Adding particle with pdgc = " << pdg << " at slot = " << pos;
 #endif
-  new ( (*this)[pos] ) GHepParticle (
-            pdg, status, mom1, mom2, dau1, dau2, px, py, pz, E, x, y, z, t);
+  GHepParticle * np = (GHepParticle *) this->ConstructedAt(pos);
+  np->Set(pdg, status, mom1, mom2, dau1, dau2, px, py, pz, E, x, y, z, t);
 
   // Update the mother's daughter list. If the newly inserted particle broke
   // compactification, then run CompactifyDaughterLists()
@@ -880,6 +883,43 @@ void GHepRecord::ResetRecord(void)
   this->InitRecord();
 }
 //___________________________________________________________________________
+void GHepRecord::RecycleRecord(void)
+{
+// Resets the record to the state of a newly constructed one, like
+// ResetRecord(), without freeing memory: the entries are kept (with their
+// 4-vectors) by the TClonesArray and are re-used by later insertions, and
+// the vertex, flags and mask objects are reset in place. The summary is
+// deleted.
+
+#ifdef __GENIE_LOW_LEVEL_MESG_ENABLED__
+  LOG("GHEP", pDEBUG) << "Recycling GHepRecord";
+#endif
+
+  if (fInteraction) delete fInteraction;
+  fInteraction = 0;
+
+  // no "C" option: the entries are not cleared (which would free their
+  // 4-vectors) but they are kept for ConstructedAt()
+  TClonesArray::Clear();
+
+  fWeight       = 1.;
+  fProb         = 1.;
+  fXSec         = 0.;
+  fDiffXSec     = 0.;
+  fDiffXSecPhSp = kPSNull;
+
+  if(fVtx) fVtx->SetXYZT(0,0,0,0);
+  else     fVtx = new TLorentzVector(0,0,0,0);
+
+  if(!fEventFlags) fEventFlags = new TBits(GHepFlags::NFlags());
+  fEventFlags -> ResetAllBits(false);
+
+  if(!fEventMask) fEventMask = new TBits(GHepFlags::NFlags());
+  for(unsigned int i = 0; i < GHepFlags::NFlags(); i++) {
+   fEventMask->SetBitNumber(i, true);
+  }
+}
+//___________________________________________________________________________
 void GHepRecord::Clear(Option_t * opt)
 {
   if (fInteraction) delete fInteraction;
@@ -906,18 +946,29 @@ void GHepRecord::Clear(Option_t * opt)
 //___________________________________________________________________________
 void GHepRecord::Copy(const GHepRecord & record)
 {
-  // clean up
-  this->ResetRecord();
+  // clean up, keeping the allocated entries & summary for re-use
+  Interaction * summary = fInteraction;
+  fInteraction = 0;
+  this->RecycleRecord();
 
   // copy event record entries
   unsigned int ientry = 0;
   GHepParticle * p = 0;
   TIter ghepiter(&record);
-  while ( (p = (GHepParticle *) ghepiter.Next()) )
-                              new ( (*this)[ientry++] ) GHepParticle(*p);
+  while ( (p = (GHepParticle *) ghepiter.Next()) ) {
+    GHepParticle * np = (GHepParticle *) this->ConstructedAt(ientry++);
+    np->Copy(*p);
+  }
 
   // copy summary
-  fInteraction = new Interaction( *record.fInteraction );
+  if(record.fInteraction) {
+    if(summary) *summary = *record.fInteraction;
+    else summary = new Interaction( *record.fInteraction );
+  } else if(summary) {
+    delete summary;
+    summary = 0;
+  }
+  fInteraction = summary;
 
   // copy flags & mask
   *fEventFlags = *(record.EventFlags());
@@ -147,6 +147,7 @@ public :
   virtual void Copy        (const GHepRecord & record);
   virtual void Clear       (Option_t * opt="");
   virtual void ResetRecord (void);
+  virtual void RecycleRecord (void); ///< as ResetRecord(), but keeps the allocated entries & objects for re-use
   virtual void CompactifyDaughterLists     (void);
   virtual void RemoveIntermediateParticles (void);
 
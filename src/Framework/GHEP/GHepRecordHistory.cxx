@@ -12,6 +12,7 @@
 
 #include "Framework/GHEP/GHepRecordHistory.h"
 #include "Framework/GHEP/GHepRecord.h"
+#include "Framework/Interaction/Interaction.h"
 #include "Framework/Messenger/Messenger.h"
 #include "Framework/Utils/PrintUtils.h"
 
@@ -30,27 +31,43 @@ namespace genie {
 }
 //___________________________________________________________________________
 GHepRecordHistory::GHepRecordHistory() :
-map<int, GHepRecord*>()
+map<int, GHepRecord*>(),
+fNJournal(0),
+fNChanges(0),
+fNCurrent(0)
 {
   this->ReadFlags();
 }
 //___________________________________________________________________________
 GHepRecordHistory::GHepRecordHistory(const GHepRecordHistory & history) :
-map<int, GHepRecord*>()
+map<int, GHepRecord*>(),
+fNJournal(0),
+fNChanges(0),
+fNCurrent(0)
 {
-  this->Copy(history);
   this->ReadFlags();
+  this->Copy(history);
 }
 //___________________________________________________________________________
 GHepRecordHistory::~GHepRecordHistory()
 {
   this->PurgeHistory();
+
+  for(unsigned int i = 0; i < fJournal.size(); i++) {
+    if(fJournal[i].summary) delete fJournal[i].summary;
+  }
+  fJournal.clear();
 }
 //___________________________________________________________________________
 void GHepRecordHistory::AddSnapshot(int step, GHepRecord * record)
 {
 // Adds a GHepRecord 'snapshot' at the history buffer
 
+  if(fEnabledJournal) {
+    this->AddJournalStep(step, record);
+    return;
+  }
+
   bool go_on = (fEnabledFull || (fEnabledBootstrapStep && step==-1));
   if(!go_on) return;
 
@@ -77,10 +94,172 @@ void GHepRecordHistory::AddSnapshot(int step, GHepRecord * record)
   }
 }
 //___________________________________________________________________________
+bool GHepRecordHistory::RestoreSnapshot(int step, GHepRecord * record)
+{
+// Restores the input record as it was after the input processing step and
+// purges the history of all later steps
+
+  if(fEnabledJournal) return this->RestoreJournalStep(step, record);
+
+  GHepRecordHistory::const_iterator history_iter = this->find(step);
+  if(history_iter == this->end() || !history_iter->second) {
+    LOG("GHEP", pERROR)
+      << "No GHEP snapshot for processing step: " << step;
+    return false;
+  }
+  GHepRecord * snapshot = history_iter->second;
+  this->PurgeRecentHistory(step+1);
+  record->ResetRecord();
+  record->Copy(*snapshot);
+  return true;
+}
+//___________________________________________________________________________
+void GHepRecordHistory::AddJournalStep(int step, GHepRecord * record)
+{
+// Journals the entries added or modified by a processing step, by comparing
+// the record with its state after the previously journaled step
+
+  if(!record) {
+   LOG("GHEP", pWARN)
+    << "Input GHEP record snapshot is null. Is not added at history record";
+    return;
+  }
+
+  // the bootstrap record starts a new journal
+  if(step == -1) {
+    fNJournal = 0;
+    fNChanges = 0;
+    fNCurrent = 0;
+  }
+  if(fNJournal > 0 && fJournal[fNJournal-1].step >= step) {
+    LOG("GHEP", pWARN)
+      << "GHEP snapshot for processing step: " << step << " already exists!";
+    return;
+  }
+
+  unsigned int first_change = fNChanges;
+
+  int n = record->GetEntries();
+  for(int i = 0; i < n; i++) {
+    const GHepParticle * p = (const GHepParticle *) record->UncheckedAt(i);
+    if(!p) continue;
+    if(i < fNCurrent && p->IsIdentical(fCurrent[i])) continue;
+
+    if(i < (int)fCurrent.size()) fCurrent[i] = *p;
+    else                         fCurrent.push_back(*p);
+
+    if(fNChanges < fChanges.size()) {
+      fChanges  [fNChanges] = *p;
+      fChangeIdx[fNChanges] = i;
+    } else {
+      fChanges.push_back(*p);
+      fChangeIdx.push_back(i);
+    }
+    fNChanges++;
+  }
+  fNCurrent = n;
+
+  if(fNJournal == fJournal.size()) {
+    GHepJournalStep_t empty;
+    empty.summary = 0;
+    fJournal.push_back(empty);
+  }
+  GHepJournalStep_t & js = fJournal[fNJournal++];
+
+  js.step         = step;
+  js.nentries     = n;
+  js.first_change = first_change;
+  js.nchanges     = fNChanges - first_change;
+  js.vtx          = *record->Vertex();
+  js.flags        = *record->EventFlags();
+  js.mask         = *record->EventMask();
+  js.weight       = record->Weight();
+  js.prob         = record->Probability();
+  js.xsec         = record->XSec();
+  js.dxsec        = record->DiffXSec();
+  js.dxsec_ps     = record->DiffXSecVars();
+
+  const Interaction * summary = record->Summary();
+  if(summary) {
+    if(js.summary) *js.summary = *summary;
+    else js.summary = new Interaction(*summary);
+  } else if(js.summary) {
+    delete js.summary;
+    js.summary = 0;
+  }
+
+#ifdef __GENIE_LOW_LEVEL_MESG_ENABLED__
+  LOG("GHEP", pDEBUG)
+    << "Journaled processing step: " << step << " - " << js.nchanges
+    << " entries added or modified";
+#endif
+}
+//___________________________________________________________________________
+bool GHepRecordHistory::RestoreJournalStep(int step, GHepRecord * record)
+{
+// Rebuilds the record by replaying the journal up to the last step that was
+// processed at or before the input step
+
+  int last = -1;
+  for(unsigned int k = 0; k < fNJournal; k++) {
+    if(fJournal[k].step <= step) last = k;
+  }
+  if(last < 0) {
+    LOG("GHEP", pERROR)
+      << "No GHEP snapshot for processing step: " << step;
+    return false;
+  }
+
+  // replay the entries
+  vector<GHepParticle> entries;
+  for(int k = 0; k <= last; k++) {
+    const GHepJournalStep_t & js = fJournal[k];
+    for(unsigned int c = js.first_change; c < js.first_change + js.nchanges; c++) {
+      int idx = fChangeIdx[c];
+      if(idx < (int)entries.size()) entries[idx] = fChanges[c];
+      else                          entries.push_back(fChanges[c]);
+    }
+    if((int)entries.size() > js.nentries) {
+      entries.erase(entries.begin() + js.nentries, entries.end());
+    }
+  }
+
+  const GHepJournalStep_t & js = fJournal[last];
+
+  record->RecycleRecord();
+  for(unsigned int i = 0; i < entries.size(); i++) {
+    GHepParticle * p = (GHepParticle *) record->ConstructedAt(i);
+    p->Copy(entries[i]);
+  }
+  if(js.summary) record->AttachSummary(new Interaction(*js.summary));
+  record->SetVertex(js.vtx);
+  *record->EventFlags() = js.flags;
+  *record->EventMask()  = js.mask;
+  record->SetWeight     (js.weight);
+  record->SetProbability(js.prob);
+  record->SetXSec       (js.xsec);
+  record->SetDiffXSec   (js.dxsec, js.dxsec_ps);
+
+  // purge the later history
+  fNJournal = last + 1;
+  fNChanges = js.first_change + js.nchanges;
+  fCurrent  = entries;
+  fNCurrent = entries.size();
+
+  LOG("GHEP", pNOTICE)
+    << "Restored GHEP record as it was after processing step: " << js.step;
+
+  return true;
+}
+//___________________________________________________________________________
 void GHepRecordHistory::PurgeHistory(void)
 {
   LOG("GHEP", pNOTICE) << "Purging GHEP history buffer";
 
+  fNJournal = 0;
+  fNChanges = 0;
+  fNCurrent = 0;
+
   GHepRecordHistory::iterator history_iter;
   for(history_iter = this->begin();
                               history_iter != this->end(); ++history_iter) {
@@ -151,6 +330,21 @@ void GHepRecordHistory::Copy(const GHepRecordHistory & history)
 //___________________________________________________________________________
 void GHepRecordHistory::Print(ostream & stream) const
 {
+  if(fEnabledJournal) {
+    stream << "\n ****** Printing GHEP record journal"
+                                << " [depth: " << fNJournal << "]" << endl;
+    for(unsigned int k = 0; k < fNJournal; k++) {
+      const GHepJournalStep_t & js = fJournal[k];
+      stream << "\n[After processing step = " << js.step << "] : "
+             << js.nentries << " entries, " << js.nchanges
+             << " added or modified :";
+      for(unsigned int c = js.first_change; c < js.first_change + js.nchanges; c++) {
+        stream << "\n  entry " << fChangeIdx[c] << " : " << fChanges[c];
+      }
+    }
+    return;
+  }
+
   stream << "\n ****** Printing GHEP record history"
                               << " [depth: " << this->size() << "]" << endl;
 
@@ -180,11 +374,13 @@ void GHepRecordHistory::ReadFlags(void)
 
      fEnabledFull          = (envvar=="FULL")      ? true:false;
      fEnabledBootstrapStep = (envvar=="BOOTSTRAP") ? true:false;
+     fEnabledJournal       = (envvar=="JOURNAL")   ? true:false;
 
   } else {
      // set defaults
      fEnabledFull          = false;
-     fEnabledBootstrapStep = true;
+     fEnabledBootstrapStep = false;
+     fEnabledJournal       = true;
   }
 
   LOG("GHEP", pINFO) << "GHEP History Flags: ";
@@ -192,5 +388,7 @@ void GHepRecordHistory::ReadFlags(void)
                      << utils::print::BoolAsYNString(fEnabledFull);
   LOG("GHEP", pINFO) << "  - Keep Bootstrap Record Only: "
                      << utils::print::BoolAsYNString(fEnabledBootstrapStep);
+  LOG("GHEP", pINFO) << "  - Keep Journal of Changes:    "
+                     << utils::print::BoolAsYNString(fEnabledJournal);
 }
 //___________________________________________________________________________
@@ -9,6 +9,13 @@
           sequence if a processing step is to be re-run (this the GENIE event
           generation framework equivalent of an 'Undo')
 
+          The history mode is set by the GHEPHISTENABLE environment variable:
+          FULL keeps a copy of the record after every step, BOOTSTRAP keeps
+          a copy of the record only before the first step, and JOURNAL (the
+          default) keeps, for every step, only the entries the step added or
+          modified plus the record summary, so that any step can be restored
+          without copying the whole record at each step.
+
 \author   Costas Andreopoulos <constantinos.andreopoulos \at cern.ch>
           University of Liverpool & STFC Rutherford Appleton Laboratory
 
@@ -23,10 +30,18 @@
 #define _GHEP_RECORD_HISTORY_H_
 
 #include <map>
+#include <vector>
 #include <string>
 #include <ostream>
 
+#include <TBits.h>
+#include <TLorentzVector.h>
+
+#include "Framework/Conventions/KinePhaseSpace.h"
+#include "Framework/GHEP/GHepParticle.h"
+
 using std::map;
+using std::vector;
 using std::string;
 using std::ostream;
 
@@ -34,6 +49,24 @@ namespace genie {
 
 class GHepRecordHistory;
 class GHepRecord;
+class Interaction;
+
+//! State of the GHEP record after a processing step, as kept in JOURNAL mode
+struct GHepJournalStep_t {
+  int              step;          ///< processing step
+  int              nentries;      ///< number of record entries after the step
+  unsigned int     first_change;  ///< first entry of the step in the change buffer
+  unsigned int     nchanges;      ///< number of entries added or modified by the step
+  Interaction *    summary;       ///< record summary (owned, reused across events)
+  TLorentzVector   vtx;           ///< vertex
+  TBits            flags;         ///< event flags
+  TBits            mask;          ///< unphysical event mask
+  double           weight;        ///< event weight
+  double           prob;          ///< event probability
+  double           xsec;          ///< cross section
+  double           dxsec;         ///< differential cross section
+  KinePhaseSpace_t dxsec_ps;      ///< differential cross section variables
+};
 
 ostream & operator << (ostream & stream, const GHepRecordHistory & history);
 
@@ -46,6 +79,7 @@ public :
   ~GHepRecordHistory();
 
   void AddSnapshot        (int step, GHepRecord * r);
+  bool RestoreSnapshot    (int step, GHepRecord * r); ///< restore the record as it was after the input step and purge the later history
   void PurgeHistory       (void);
   void PurgeRecentHistory (int start_step);
   void ReadFlags          (void);
@@ -57,8 +91,21 @@ public :
 
 private:
 
+  void AddJournalStep     (int step, GHepRecord * r);
+  bool RestoreJournalStep (int step, GHepRecord * r);
+
   bool fEnabledFull;          ///< keep the full GHEP record history
   bool fEnabledBootstrapStep; ///< keep only the record that bootsrapped the generation cycle
+  bool fEnabledJournal;       ///< keep a journal of the entries modified at each step
+
+  // Journal (buffers are reused across events)
+  vector<GHepJournalStep_t> fJournal;     //! journaled steps, in processing order
+  unsigned int              fNJournal;    //! number of journaled steps in use
+  vector<GHepParticle>      fChanges;     //! entries added or modified, for all steps
+  vector<int>               fChangeIdx;   //! position of these entries in the record
+  unsigned int              fNChanges;    //! number of changes in use
+  vector<GHepParticle>      fCurrent;     //! record entries after the last journaled step
+  int                       fNCurrent;    //! number of record entries after the last journaled step
 };
 
 }      // genie namespace
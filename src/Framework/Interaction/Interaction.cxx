@@ -30,6 +30,7 @@ using namespace genie::constants;
 
 using std::endl;
 using std::ostringstream;
+using std::vector;
 
 ClassImp(Interaction)
 
@@ -284,6 +285,94 @@ string Interaction::AsString(void) const
   return interaction.str();
 }
 //___________________________________________________________________________
+namespace {
+  // FNV-1a, 64 bit, over the bytes of an integer
+  inline void HashInt(ULong64_t & h, int v)
+  {
+    unsigned int u = (unsigned int) v;
+    for(int i = 0; i < 4; i++) {
+      h ^= (u & 0xff);
+      h *= 1099511628211ULL;
+      u >>= 8;
+    }
+  }
+  struct FieldHasher {
+    ULong64_t h;
+    void operator() (int v) { HashInt(h, v); }
+  };
+  struct FieldCollector {
+    vector<int> & fields;
+    void operator() (int v) { fields.push_back(v); }
+  };
+  // Visits exactly the information encoded by AsString(): every field is
+  // preceded by a distinct tag and fields omitted from the string code are
+  // omitted here as well.
+  template<class Visitor>
+  void VisitFields(const InitialState & init, const ProcessInfo & proc,
+                   const XclsTag & xcls, Visitor & v)
+  {
+    const Target & tgt = init.Tgt();
+
+    v(1); v(init.ProbePdg());
+    v(2); v(tgt.Pdg());
+    if(tgt.HitNucIsSet()) {
+      v(3); v(tgt.HitNucPdg());
+    }
+    if(tgt.HitQrkIsSet()) {
+      v(4); v(tgt.HitQrkPdg()); v(tgt.HitSeaQrk());
+    }
+    v(5);
+    v((int) proc.InteractionTypeId());
+    v((int) proc.ScatteringTypeId());
+
+    if(xcls.IsCharmEvent()) {
+      v(6); v(xcls.CharmHadronPdg());
+    }
+    if(xcls.IsStrangeEvent()) {
+      v(7); v(xcls.StrangeHadronPdg());
+    }
+    bool multset =
+         xcls.NProtons()>0 || xcls.NNeutrons()>0 ||
+         xcls.NPiPlus()>0  || xcls.NPiMinus()>0  || xcls.NPi0()>0 ||
+         xcls.NSingleGammas()>0 ||
+         xcls.NRho0()>0 || xcls.NRhoPlus()>0 || xcls.NRhoMinus()>0;
+    if(multset) {
+      v(8);
+      v(xcls.NProtons());  v(xcls.NNeutrons());
+      v(xcls.NPiPlus());   v(xcls.NPiMinus());
+      v(xcls.NPi0());      v(xcls.NSingleGammas());
+      v(xcls.NRhoPlus());  v(xcls.NRhoMinus());
+      v(xcls.NRho0());
+    }
+    if(xcls.KnownResonance()) {
+      v(9); v((int) xcls.Resonance());
+    }
+    if(xcls.DecayMode() != -1) {
+      v(10); v(xcls.DecayMode());
+    }
+    if(xcls.IsFinalQuarkEvent()) {
+      v(11); v(xcls.FinalQuarkPdg());
+    }
+    if(xcls.IsFinalLeptonEvent()) {
+      v(12); v(xcls.FinalLeptonPdg());
+    }
+  }
+}
+//___________________________________________________________________________
+ULong64_t Interaction::Fingerprint(void) const
+{
+  FieldHasher hasher = { 14695981039346656037ULL };
+  VisitFields(*fInitialState, *fProcInfo, *fExclusiveTag, hasher);
+  return hasher.h;
+}
+//___________________________________________________________________________
+void Interaction::FingerprintFields(vector<int> & fields) const
+{
+  fields.clear();
+  FieldCollector collector = { fields };
+  VisitFields(*fInitialState, *fProcInfo, *fExclusiveTag, collector);
+}
+//___________________________________________________________________________
 void Interaction::Print(ostream & stream) const
 {
   const string line(110, '-');
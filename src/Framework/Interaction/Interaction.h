@@ -26,6 +26,7 @@
 
 #include <ostream>
 #include <string>
+#include <vector>
 
 #include <TObject.h>
 
@@ -39,6 +40,7 @@
 using std::ostream;
 using std::string;
 using std::pair;
+using std::vector;
 
 class TRootIOCtor;
 
@@ -96,6 +98,17 @@ public:
   string AsString (void) const;
   void   Print    (ostream & stream) const;
 
+  // 64-bit fingerprint identifying the same interaction as AsString() (two
+  // interactions have the same fingerprint iff they have the same string code,
+  // barring hash collisions). It is computed directly from the integer state,
+  // without formatting a string, and is meant for in-memory look-ups;
+  // AsString() remains the key used in files.
+  ULong64_t Fingerprint (void) const;
+
+  // The tagged integer fields hashed by Fingerprint(): equal fields mean an
+  // equal string code. Used to confirm fingerprint look-up hits.
+  void FingerprintFields (vector<int> & fields) const;
+
   // Overloaded operators
   Interaction &    operator =  (const Interaction & i);                   ///< copy
   friend ostream & operator << (ostream & stream, const Interaction & i); ///< print
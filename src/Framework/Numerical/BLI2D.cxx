@@ -21,13 +21,15 @@ using namespace genie;
 ClassImp(BLI2DGrid)
 
 //___________________________________________________________________________
-BLI2DGrid::BLI2DGrid()
+BLI2DGrid::BLI2DGrid() :
+fOwnsNodes(true)
 {
 
 }
 //___________________________________________________________________________
 BLI2DGrid::~BLI2DGrid()
 {
+  if (!fOwnsNodes) return;
   if (fX) { delete [] fX; }
   if (fY) { delete [] fY; }
   if (fZ) { delete [] fZ; }
@@ -195,6 +197,24 @@ BLI2DNonUnifGrid::BLI2DNonUnifGrid(
 
   this->Init(nx, xmin, xmax, ny, ymin, ymax);
 
+  // strictly increasing nodes (eg tables read back from file) are copied
+  // as they are, avoiding the O(nx*ny*(nx+ny)) node search of AddPoint
+  bool sorted = (nx>1 && ny>1);
+  for(int ix=1; sorted && ix<nx; ix++) sorted = x[ix-1] < x[ix];
+  for(int iy=1; sorted && iy<ny; iy++) sorted = y[iy-1] < y[iy];
+  if(sorted) {
+    for(int ix=0; ix<nx; ix++) fX[ix] = x[ix];
+    for(int iy=0; iy<ny; iy++) fY[iy] = y[iy];
+    for(int iz=0; iz<fNZ; iz++) {
+      fZ[iz] = z[iz];
+      fZmin = TMath::Min(z[iz], fZmin);
+      fZmax = TMath::Max(z[iz], fZmax);
+    }
+    fNFillX = nx;
+    fNFillY = ny;
+    return;
+  }
+
   for(int ix=0; ix<nx; ix++) {
     for(int iy=0; iy<ny; iy++) {
       this->AddPoint(x[ix], y[iy], z[this->IdxZ(ix,iy)]);
@@ -202,8 +222,40 @@ BLI2DNonUnifGrid::BLI2DNonUnifGrid(
   }
 }
 //___________________________________________________________________________
+BLI2DNonUnifGrid::BLI2DNonUnifGrid(int nx, int ny, int nfillx, int nfilly,
+  const double *x, const double *y, const double *z)
+{
+  this->Init();
+
+  if(nx<2 || ny<2 || nfillx<2 || nfilly<2 || nfillx>nx || nfilly>ny) return;
+
+  fOwnsNodes = false;
+  fNX     = nx;
+  fNY     = ny;
+  fNZ     = nx * ny;
+  fNFillX = nfillx;
+  fNFillY = nfilly;
+  fX      = const_cast<double *>(x);
+  fY      = const_cast<double *>(y);
+  fZ      = const_cast<double *>(z);
+
+  // filled nodes are kept in increasing order
+  fXmin   = x[0];
+  fXmax   = x[nfillx-1];
+  fYmin   = y[0];
+  fYmax   = y[nfilly-1];
+  for(int iz=0; iz<fNZ; iz++) {
+    fZmin = TMath::Min(z[iz], fZmin);
+    fZmax = TMath::Max(z[iz], fZmax);
+  }
+}
+//___________________________________________________________________________
 bool BLI2DNonUnifGrid::AddPoint(double x, double y, double z)
 {
+  if (!fOwnsNodes) {
+    LOG("BLI2DNonUnifGrid", pWARN) << "Can not add points to read-only grid";
+    return false;
+  }
 
   // check the x,y values' existence before moving anything
   //   if they do, use them
@@ -45,6 +45,13 @@ public:
   double ZMin (void) const { return fZmin; }
   double ZMax (void) const { return fZmax; }
 
+  // grid nodes
+  int            NX (void) const { return fNX; }
+  int            NY (void) const { return fNY; }
+  const double * X  (void) const { return fX;  }
+  const double * Y  (void) const { return fY;  }
+  const double * Z  (void) const { return fZ;  }
+
 protected:
 
   virtual void Init (int nx, double xmin, double xmax, int ny, double ymin, double ymax) =0;
@@ -65,6 +72,7 @@ protected:
   double   fYmax;
   double   fZmin;
   double   fZmax;
+  bool     fOwnsNodes; //! false if fX, fY, fZ point to nodes held elsewhere
 
   ClassDef(BLI2DGrid, 1)
   };
@@ -103,6 +111,13 @@ public:
   BLI2DNonUnifGrid();
   BLI2DNonUnifGrid(int nx, double xmin, double xmax, int ny, double ymin, double ymax);
   BLI2DNonUnifGrid(int nx, int ny, double *x, double *y, double *z);
+  //-- use read-only nodes held elsewhere (eg in a shared table) as they are:
+  //   the grid can not be filled and must not outlive them
+  BLI2DNonUnifGrid(int nx, int ny, int nfillx, int nfilly,
+                   const double *x, const double *y, const double *z);
+
+  int NFillX (void) const { return fNFillX; }
+  int NFillY (void) const { return fNFillY; }
 
   //-- add another point in the grid
   bool AddPoint(double x, double y, double z);
@@ -17,14 +17,15 @@ namespace genie {
               that implements the member functions operator*(double),
               operator*(const Object&), and operator+(const Object&)
 
-            * Rather than C-style arrays, the grid values are accessed via
-              pointers to std::vector objects
+            * The grid values are read from std::vector objects (which must
+              be filled before the grid is built and not resized afterwards)
+              or from arrays held elsewhere, eg in a shared read-only table
 
             * Upper and lower bounds on the grid are found using
               std::lower_bound() rather than a manual linear search
 
             * The genie::BLI2DNonUnifGrid object does not take ownership of the
-              grid vectors, which must be stored elsewhere
+              grid vectors or arrays, which must be stored elsewhere
 
 \tparam   ZObject Type of the object describing each z coordinate
 \tparam   IndexType Type to use when computing indices in the vectors
@@ -58,29 +59,39 @@ template<typename ZObject, typename IndexType = int, typename XType = double,
   /// of the grid
   BLI2DNonUnifObjectGrid(const std::vector<XType>* X,
     const std::vector<YType>* Y, const std::vector<ZObject>* Z,
-    bool extrapolate = false) : fX(X), fY(Y), fZ(Z), fExtrapolate(extrapolate)
+    bool extrapolate = false) : fX(X->data()), fY(Y->data()), fZ(Z->data()),
+    fNX(X->size()), fNY(Y->size()), fExtrapolate(extrapolate)
+  {}
+
+  /// \param[in] NX Number of x coordinates
+  /// \param[in] X Pointer to an array of NX x coordinates
+  /// \param[in] NY Number of y coordinates
+  /// \param[in] Y Pointer to an array of NY y coordinates
+  /// \param[in] Z Pointer to an array of NX*NY z coordinates
+  /// \param[in] extrapolate As above
+  BLI2DNonUnifObjectGrid(IndexType NX, const XType* X, IndexType NY,
+    const YType* Y, const ZObject* Z, bool extrapolate = false)
+    : fX(X), fY(Y), fZ(Z), fNX(NX), fNY(NY), fExtrapolate(extrapolate)
   {}
 
   /// Retrieve the minimum x value
-  inline XType x_min() const { return fX->front(); }
+  inline XType x_min() const { return fX[0]; }
 
   /// Retrieve the maximum x value
-  inline XType x_max() const { return fX->back(); }
+  inline XType x_max() const { return fX[fNX - 1]; }
 
   /// Retrieve the minimum y value
-  inline YType y_min() const { return fY->front(); }
+  inline YType y_min() const { return fY[0]; }
 
   /// Retrieve the maximum y value
-  inline YType y_max() const { return fY->back(); }
+  inline YType y_max() const { return fY[fNY - 1]; }
 
   /// Calculates the index in the vector of z coordinates that
   /// corresponds to a given set of x and y indices
   /// \param[in] ix Index of the desired grid point on the x axis
   /// \param[in] iy Index of the desired grid point on the y axis
   IndexType index_Z(IndexType ix, IndexType iy) const {
-    IndexType num_y_points = fY->size();
-
-    return (num_y_points * ix) + iy;
+    return (fNY * ix) + iy;
   }
 
   /// Uses bilinear interpolation to compute the z coordinate (represented
@@ -108,22 +119,22 @@ template<typename ZObject, typename IndexType = int, typename XType = double,
     // desired x and y values. If the desired point is outside of
     // the x or y grid limits, get the indices of the two closest
     // grid points to use for possible extrapolation.
-    get_bound_indices(fX, evalx, ix_lo, ix_hi);
-    get_bound_indices(fY, evaly, iy_lo, iy_hi);
+    get_bound_indices(fX, fNX, evalx, ix_lo, ix_hi);
+    get_bound_indices(fY, fNY, evaly, iy_lo, iy_hi);
 
     // Get the x and y values corresponding to the lower (x1, y1) and
     // upper (x2, y2) bounds found previously
-    XType x1 = fX->at( ix_lo );
-    XType x2 = fX->at( ix_hi );
-    YType y1 = fY->at( iy_lo );
-    YType y2 = fY->at( iy_hi );
+    XType x1 = fX[ ix_lo ];
+    XType x2 = fX[ ix_hi ];
+    YType y1 = fY[ iy_lo ];
+    YType y2 = fY[ iy_hi ];
 
     // Retrieve the z values corresponding to each of the four locations
     // that will be used for the bilinear interpolation
-    const ZObject& z11 = fZ->at( this->index_Z(ix_lo, iy_lo) );
-    const ZObject& z21 = fZ->at( this->index_Z(ix_hi, iy_lo) );
-    const ZObject& z12 = fZ->at( this->index_Z(ix_lo, iy_hi) );
-    const ZObject& z22 = fZ->at( this->index_Z(ix_hi, iy_hi) );
+    const ZObject& z11 = fZ[ this->index_Z(ix_lo, iy_lo) ];
+    const ZObject& z21 = fZ[ this->index_Z(ix_hi, iy_lo) ];
+    const ZObject& z12 = fZ[ this->index_Z(ix_lo, iy_hi) ];
+    const ZObject& z22 = fZ[ this->index_Z(ix_hi, iy_hi) ];
 
     // Perform the interpolation (first y, then x)
     ZObject z1  = z11 * (y2-evaly)/(y2-y1) + z12 * (evaly-y1)/(y2-y1);
@@ -135,11 +146,14 @@ template<typename ZObject, typename IndexType = int, typename XType = double,
 
 protected:
 
-  const std::vector<XType>* fX; ///< Pointer to the vector of x coordinates
-  const std::vector<YType>* fY; ///< Pointer to the vector of y coordinates
+  const XType* fX; ///< Pointer to the x coordinates
+  const YType* fY; ///< Pointer to the y coordinates
+
+  /// Pointer to the z coordinate objects
+  const ZObject* fZ;
 
-  /// Pointer to the vector of z coordinate objects
-  const std::vector<ZObject>* fZ;
+  IndexType fNX; ///< Number of x coordinates
+  IndexType fNY; ///< Number of y coordinates
 
   /// Whether to allow bilinear extrapolation (true) or to compute z values for
   /// x and coordinates outside of the grid using the grid endpoints (false)
@@ -148,7 +162,8 @@ protected:
   /// Determines the indices for the two gridpoints surrounding a requested
   /// x or y coordinate. If the x or y coordinate is outside of the grid,
   /// this function returns the two closest grid points.
-  /// \param[in] vec A vector of grid point coordinates
+  /// \param[in] vec An array of grid point coordinates
+  /// \param[in] num_points The number of grid point coordinates
   /// \param[in] val The requested x or y coordinate
   /// \param[out] lower_index The index of the closest grid point less than or
   /// equal to the requested value, or the lower of the two nearest grid points
@@ -158,16 +173,16 @@ protected:
   /// if the value falls outside of the grid
   /// \return true if the requested value is within the grid, or false
   /// otherwise
-  template <typename Type> bool get_bound_indices(const std::vector<Type>* vec,
-    Type val, int& lower_index, int& upper_index) const
+  template <typename Type> bool get_bound_indices(const Type* vec,
+    IndexType num_points, Type val, int& lower_index, int& upper_index) const
   {
     /// \todo Check that the vector contains at least two entries
 
     bool within = true;
 
-    typedef typename std::vector<Type>::const_iterator Iterator;
-    Iterator begin = vec->begin();
-    Iterator end = vec->end();
+    typedef const Type* Iterator;
+    Iterator begin = vec;
+    Iterator end = vec + num_points;
 
     // std::lower_bound returns an iterator to the first element of the
     // container which is not less than the supplied value
@@ -12,6 +12,7 @@
 #include <cstdlib>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
 
 #include <TH1F.h>
 #include <TH2F.h>
@@ -33,6 +34,62 @@ using std::cout;
 using std::endl;
 using std::ostringstream;
 
+//____________________________________________________________________________
+namespace {
+  // key intern table, shared by all registries
+  map<RgKey, unsigned int> & RgKeyIds(void) {
+    static map<RgKey, unsigned int> ids;
+    return ids;
+  }
+  vector<RgKey> & RgKeyNames(void) {
+    static vector<RgKey> names;
+    return names;
+  }
+  unsigned int RgKeyIntern(const RgKey & key) {
+    map<RgKey, unsigned int> & ids = RgKeyIds();
+    map<RgKey, unsigned int>::const_iterator it = ids.find(key);
+    if(it != ids.end()) return it->second;
+    unsigned int id = RgKeyNames().size();
+    RgKeyNames().push_back(key);
+    ids.insert(map<RgKey, unsigned int>::value_type(key, id));
+    return id;
+  }
+  bool CompareFlatEntry(const RgFlatEntry_t & e, unsigned int id) {
+    return e.id < id;
+  }
+
+  // debug mode: report keys looked-up by string this many times
+  bool RegistryDebugMode(void) {
+    static bool debug = (std::getenv("GREGISTRYDEBUG") != 0);
+    return debug;
+  }
+  const long kStringLookUpReportThreshold = 10000;
+}
+//____________________________________________________________________________
+const unsigned int RgKeyHandle::kInvalidId = (unsigned int) -1;
+//____________________________________________________________________________
+RgKeyHandle::RgKeyHandle() :
+fId(kInvalidId)
+{
+
+}
+//____________________________________________________________________________
+RgKeyHandle::RgKeyHandle(RgKey key) :
+fId(RgKeyIntern(key))
+{
+
+}
+//____________________________________________________________________________
+const RgKey & RgKeyHandle::Key(void) const
+{
+  static const RgKey kNoKey = "";
+  return this->IsValid() ? RgKeyNames()[fId] : kNoKey;
+}
+//____________________________________________________________________________
+bool RgKeyHandle::IsValid(void) const
+{
+  return fId != kInvalidId;
+}
 //____________________________________________________________________________
 namespace genie {
  //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -90,14 +147,16 @@ Registry::Registry()
 Registry::Registry(string name, bool isReadOnly) :
 fName             ( name       ),
 fIsReadOnly       ( isReadOnly ),
-fInhibitItemLocks ( false      )
+fInhibitItemLocks ( false      ),
+fFlatIsValid      ( false      )
 {
 
 }
 //____________________________________________________________________________
 Registry::Registry(const Registry & registry) :
 fName("uninitialised"),
-fIsReadOnly(false)
+fIsReadOnly(false),
+fFlatIsValid(false)
 {
   this->Copy(registry);
 }
@@ -196,6 +255,7 @@ void Registry::OverrideGlobalDef(RgKey key)
   if( this->Exists(key) ) {
      RgIMapConstIter entry = fRegistry.find(key);
      entry->second->SetLocal(true);
+     fFlatIsValid = false;
   } else {
      LOG("Registry", pWARN)
         << "*** Can't give 'local' status to  non-existem item ["
@@ -208,6 +268,7 @@ void Registry::LinkToGlobalDef(RgKey key)
   if( this->Exists(key) ) {
      RgIMapConstIter entry = fRegistry.find(key);
      entry->second->SetLocal(false);
+     fFlatIsValid = false;
   } else {
      LOG("Registry", pWARN)
         << "*** Can't give 'global' status to  non-existem item ["
@@ -270,6 +331,7 @@ void Registry::Set(RgIMapPair entry)
   if( this->CanSetItem(key) ) {
     this->DeleteEntry(key);
     fRegistry.insert(entry);
+    fFlatIsValid = false;
   } else {
      LOG("Registry", pWARN)
              << "*** Registry item [" << key << "] can not be set";
@@ -549,6 +611,8 @@ RgAlg Registry::GetAlgDef(RgKey key, RgAlg  def_opt, bool set_def)
 //____________________________________________________________________________
 RgIMapConstIter Registry::SafeFind(RgKey key) const
 {
+  if(RegistryDebugMode()) this->CountStringLookUp(key);
+
   RgIMapConstIter entry = fRegistry.find(key);
   if (entry!=fRegistry.end()) {
     return entry;
@@ -566,6 +630,107 @@ bool Registry::Exists(RgKey key) const
   return (entry!=fRegistry.end());
 }
 //____________________________________________________________________________
+bool Registry::Exists(const RgKeyHandle & key) const
+{
+  return (this->FindFlat(key) != 0);
+}
+//____________________________________________________________________________
+bool Registry::ItemIsLocal(const RgKeyHandle & key) const
+{
+  const RgFlatEntry_t * entry = this->FindFlat(key);
+  return (entry != 0 && entry->local);
+}
+//____________________________________________________________________________
+void Registry::Get(const RgKeyHandle & key, RgBool & item) const
+{
+  item = fFlatBool[ this->SafeFindFlat(key, kRgBool).slot ];
+}
+//____________________________________________________________________________
+void Registry::Get(const RgKeyHandle & key, RgInt & item) const
+{
+  item = fFlatInt[ this->SafeFindFlat(key, kRgInt).slot ];
+}
+//____________________________________________________________________________
+void Registry::Get(const RgKeyHandle & key, RgDbl & item) const
+{
+  item = fFlatDbl[ this->SafeFindFlat(key, kRgDbl).slot ];
+}
+//____________________________________________________________________________
+void Registry::Get(const RgKeyHandle & key, RgStr & item) const
+{
+  item = fFlatStr[ this->SafeFindFlat(key, kRgStr).slot ];
+}
+//____________________________________________________________________________
+void Registry::Get(const RgKeyHandle & key, RgAlg & item) const
+{
+  item = fFlatAlg[ this->SafeFindFlat(key, kRgAlg).slot ];
+}
+//____________________________________________________________________________
+RgBool Registry::GetBool(const RgKeyHandle & key) const
+{
+  return fFlatBool[ this->SafeFindFlat(key, kRgBool).slot ];
+}
+//____________________________________________________________________________
+RgInt Registry::GetInt(const RgKeyHandle & key) const
+{
+  return fFlatInt[ this->SafeFindFlat(key, kRgInt).slot ];
+}
+//____________________________________________________________________________
+RgDbl Registry::GetDouble(const RgKeyHandle & key) const
+{
+  return fFlatDbl[ this->SafeFindFlat(key, kRgDbl).slot ];
+}
+//____________________________________________________________________________
+RgStr Registry::GetString(const RgKeyHandle & key) const
+{
+  return fFlatStr[ this->SafeFindFlat(key, kRgStr).slot ];
+}
+//____________________________________________________________________________
+RgAlg Registry::GetAlg(const RgKeyHandle & key) const
+{
+  return fFlatAlg[ this->SafeFindFlat(key, kRgAlg).slot ];
+}
+//____________________________________________________________________________
+bool Registry::GetIfLocal(const RgKeyHandle & key, RgBool & item) const
+{
+  const RgFlatEntry_t * entry = this->FindFlat(key);
+  if(!entry || !entry->local) return false;
+  item = fFlatBool[ this->SafeFindFlat(key, kRgBool).slot ];
+  return true;
+}
+//____________________________________________________________________________
+bool Registry::GetIfLocal(const RgKeyHandle & key, RgInt & item) const
+{
+  const RgFlatEntry_t * entry = this->FindFlat(key);
+  if(!entry || !entry->local) return false;
+  item = fFlatInt[ this->SafeFindFlat(key, kRgInt).slot ];
+  return true;
+}
+//____________________________________________________________________________
+bool Registry::GetIfLocal(const RgKeyHandle & key, RgDbl & item) const
+{
+  const RgFlatEntry_t * entry = this->FindFlat(key);
+  if(!entry || !entry->local) return false;
+  item = fFlatDbl[ this->SafeFindFlat(key, kRgDbl).slot ];
+  return true;
+}
+//____________________________________________________________________________
+bool Registry::GetIfLocal(const RgKeyHandle & key, RgStr & item) const
+{
+  const RgFlatEntry_t * entry = this->FindFlat(key);
+  if(!entry || !entry->local) return false;
+  item = fFlatStr[ this->SafeFindFlat(key, kRgStr).slot ];
+  return true;
+}
+//____________________________________________________________________________
+bool Registry::GetIfLocal(const RgKeyHandle & key, RgAlg & item) const
+{
+  const RgFlatEntry_t * entry = this->FindFlat(key);
+  if(!entry || !entry->local) return false;
+  item = fFlatAlg[ this->SafeFindFlat(key, kRgAlg).slot ];
+  return true;
+}
+//____________________________________________________________________________
 bool Registry::DeleteEntry(RgKey key)
 {
   if(!fIsReadOnly && Exists(key)) {
@@ -574,6 +739,7 @@ bool Registry::DeleteEntry(RgKey key)
       delete item;
       item = 0;
       fRegistry.erase(entry);
+      fFlatIsValid = false;
       return true;
   }
   return false;
@@ -782,6 +948,8 @@ void Registry::Append(const Registry & registry, RgKey prefix)
     	 delete cri ;
      }
    } // loop on the incoming registry items
+
+  fFlatIsValid = false;
 }
 //____________________________________________________________________________
 void Registry::Merge(const Registry & registry, RgKey prefix)
@@ -825,6 +993,8 @@ void Registry::Merge(const Registry & registry, RgKey prefix)
 
    } // loop on the incoming registry items
 
+  fFlatIsValid = false;
+
 }//____________________________________________________________________________
 RgType_t Registry::ItemType(RgKey key) const
 {
@@ -859,6 +1029,7 @@ void Registry::Init(void)
   fName              = "NoName";
   fIsReadOnly        = false;
   fInhibitItemLocks  = false;
+  fFlatIsValid       = false;
 }
 //____________________________________________________________________________
 void Registry::Clear(bool force)
@@ -885,6 +1056,7 @@ void Registry::Clear(bool force)
      item = 0;
   }
   fRegistry.clear();
+  fFlatIsValid = false;
 }
 //____________________________________________________________________________
 RegistryItemI * Registry::CloneRegistryItem( const RgKey & key ) const {
@@ -953,3 +1125,103 @@ RegistryItemI * Registry::CloneRegistryItem( const RgKey & key ) const {
      return cri ;
 
 }
+//____________________________________________________________________________
+void Registry::BuildFlatStore(void) const
+{
+// Copies all bool, int, double, string and algorithm items into contiguous
+// typed vectors, indexed by the interned key id. Other item types are not
+// available through key handles.
+
+  fFlatIndex.clear();
+  fFlatBool.clear();
+  fFlatInt.clear();
+  fFlatDbl.clear();
+  fFlatStr.clear();
+  fFlatAlg.clear();
+
+  RgIMapConstIter rit = fRegistry.begin();
+  for( ; rit != fRegistry.end(); ++rit) {
+    const RegistryItemI * ri = rit->second;
+    if(!ri) continue;
+
+    RgFlatEntry_t entry;
+    entry.id    = RgKeyIntern(rit->first);
+    entry.type  = ri->TypeInfo();
+    entry.local = ri->IsLocal();
+
+    switch(entry.type) {
+    case kRgBool:
+      entry.slot = fFlatBool.size();
+      fFlatBool.push_back( static_cast<const RegistryItem<RgBool>*>(ri)->Data() );
+      break;
+    case kRgInt:
+      entry.slot = fFlatInt.size();
+      fFlatInt.push_back( static_cast<const RegistryItem<RgInt>*>(ri)->Data() );
+      break;
+    case kRgDbl:
+      entry.slot = fFlatDbl.size();
+      fFlatDbl.push_back( static_cast<const RegistryItem<RgDbl>*>(ri)->Data() );
+      break;
+    case kRgStr:
+      entry.slot = fFlatStr.size();
+      fFlatStr.push_back( static_cast<const RegistryItem<RgStr>*>(ri)->Data() );
+      break;
+    case kRgAlg:
+      entry.slot = fFlatAlg.size();
+      fFlatAlg.push_back( static_cast<const RegistryItem<RgAlg>*>(ri)->Data() );
+      break;
+    default:
+      continue;
+    }
+    fFlatIndex.push_back(entry);
+  }
+
+  std::sort(fFlatIndex.begin(), fFlatIndex.end(),
+     [](const RgFlatEntry_t & a, const RgFlatEntry_t & b) { return a.id < b.id; });
+
+  fFlatIsValid = true;
+}
+//____________________________________________________________________________
+const RgFlatEntry_t * Registry::FindFlat(const RgKeyHandle & key) const
+{
+  if(!fFlatIsValid) this->BuildFlatStore();
+
+  vector<RgFlatEntry_t>::const_iterator it = std::lower_bound(
+      fFlatIndex.begin(), fFlatIndex.end(), key.Id(), CompareFlatEntry);
+  if(it == fFlatIndex.end() || it->id != key.Id()) return 0;
+  return &(*it);
+}
+//____________________________________________________________________________
+const RgFlatEntry_t & Registry::SafeFindFlat(
+                             const RgKeyHandle & key, RgType_t type) const
+{
+  const RgFlatEntry_t * entry = this->FindFlat(key);
+  if(entry && entry->type == type) return *entry;
+
+  if(!entry) {
+    LOG("Registry/SafeFind", pFATAL)
+       << "*** Key: " << key.Key()
+       << " does not exist in registry: " << this->Name();
+  } else {
+    LOG("Registry/SafeFind", pFATAL)
+       << "*** Key: " << key.Key() << " in registry: " << this->Name()
+       << " holds an item of type " << RgType::AsString(entry->type)
+       << " - not " << RgType::AsString(type);
+  }
+  gAbortingInErr = true;
+  exit(1);
+}
+//____________________________________________________________________________
+void Registry::CountStringLookUp(const RgKey & key) const
+{
+  static map<pair<const Registry *, RgKey>, long> nlookups;
+
+  long n = ++nlookups[ pair<const Registry *, RgKey>(this, key) ];
+  if(n == kStringLookUpReportThreshold) {
+    LOG("Registry", pWARN)
+      << "Key: " << key << " was looked-up by string " << n
+      << " times in registry: " << this->Name()
+      << " - read it in LoadConfig() or use an RgKeyHandle";
+  }
+}
+//____________________________________________________________________________
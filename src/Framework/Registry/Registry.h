@@ -6,6 +6,17 @@
 \brief    A registry. Provides the container for algorithm configuration
           parameters.
 
+          Besides the string-keyed interface, items can be accessed through
+          RgKeyHandle objects (keys interned once, typically in LoadConfig).
+          Handle-based access uses a flat, typed copy of the bool, int,
+          double, string and algorithm items, built on first use and
+          rebuilt only after the registry is modified, so that no string
+          comparison or dynamic_cast is needed on hot paths.
+
+          Setting the GREGISTRYDEBUG environment variable reports any key
+          looked-up by string more than a large number of times in the same
+          registry, flagging string look-ups left on run-time paths.
+
 \author   Costas Andreopoulos <constantinos.andreopoulos \at cern.ch>
           University of Liverpool & STFC Rutherford Appleton Laboratory
 
@@ -26,6 +37,7 @@
 
 #include "Framework/Registry/RegistryItem.h"
 #include "Framework/Registry/RegistryItemTypeDef.h"
+#include "Framework/Registry/RegistryItemTypeId.h"
 
 class TH1F;
 class TH2F;
@@ -49,6 +61,33 @@ typedef map <RgKey, RegistryItemI *>::iterator       RgIMapIter;
 typedef map <RgKey, RegistryItemI *>::const_iterator RgIMapConstIter;
 typedef vector<RgKey>                                RgKeyList;
 
+// Interned registry key: a handle is created once from the string key and
+// then identifies the key with a single integer
+//
+class RgKeyHandle {
+public:
+  RgKeyHandle();
+  explicit RgKeyHandle(RgKey key);
+
+  unsigned int  Id      (void) const { return fId; }
+  const RgKey & Key     (void) const;
+  bool          IsValid (void) const;
+
+  static const unsigned int kInvalidId;
+
+private:
+  unsigned int fId;
+};
+
+// Entry of the flat item store: item type & slot in the typed value vector
+//
+struct RgFlatEntry_t {
+  unsigned int id;
+  RgType_t     type;
+  bool         local;
+  unsigned int slot;
+};
+
 // Templated utility methods to set/get registry items
 //
 class Registry;
@@ -138,6 +177,30 @@ public:
   RgStr  GetStringDef (RgKey key, RgStr  def_opt, bool set_def=true);
   RgAlg  GetAlgDef    (RgKey key, RgAlg  def_opt, bool set_def=true);
 
+  // Methods to retrieve Registry values using key handles
+  //
+  bool   Exists       (const RgKeyHandle & key) const;
+  bool   ItemIsLocal  (const RgKeyHandle & key) const;
+
+  void   Get (const RgKeyHandle & key, RgBool & item) const;
+  void   Get (const RgKeyHandle & key, RgInt &  item) const;
+  void   Get (const RgKeyHandle & key, RgDbl &  item) const;
+  void   Get (const RgKeyHandle & key, RgStr &  item) const;
+  void   Get (const RgKeyHandle & key, RgAlg &  item) const;
+
+  RgBool GetBool      (const RgKeyHandle & key) const;
+  RgInt  GetInt       (const RgKeyHandle & key) const;
+  RgDbl  GetDouble    (const RgKeyHandle & key) const;
+  RgStr  GetString    (const RgKeyHandle & key) const;
+  RgAlg  GetAlg       (const RgKeyHandle & key) const;
+
+  //! get the item only if it exists and is local (single look-up)
+  bool   GetIfLocal (const RgKeyHandle & key, RgBool & item) const;
+  bool   GetIfLocal (const RgKeyHandle & key, RgInt &  item) const;
+  bool   GetIfLocal (const RgKeyHandle & key, RgDbl &  item) const;
+  bool   GetIfLocal (const RgKeyHandle & key, RgStr &  item) const;
+  bool   GetIfLocal (const RgKeyHandle & key, RgAlg &  item) const;
+
   RgIMapConstIter SafeFind  (RgKey key) const;
 
   int    NEntries     (void) const;                     ///< get number of items
@@ -175,12 +238,27 @@ private:
 
   RegistryItemI * CloneRegistryItem( const RgKey & key ) const ;   ///< Properly clone a registry Item according to its type
 
+  void                  BuildFlatStore (void) const;                                ///< build the flat item store from the map
+  const RgFlatEntry_t * FindFlat       (const RgKeyHandle & key) const;             ///< find an item in the flat store
+  const RgFlatEntry_t & SafeFindFlat   (const RgKeyHandle & key, RgType_t t) const; ///< as above, exit if not found or of wrong type
+  void                  CountStringLookUp (const RgKey & key) const;                ///< debug mode book-keeping
+
   // Registry's private data members
   //
   string fName;              ///< registry's name
   bool   fIsReadOnly;        ///< is read only?
   bool   fInhibitItemLocks;  ///<
   RgIMap fRegistry;          ///< 'key' -> 'value' map
+
+  // Flat item store, derived from fRegistry and used by handle-based access
+  //
+  mutable bool                  fFlatIsValid;  //! is the flat store in sync with fRegistry?
+  mutable vector<RgFlatEntry_t> fFlatIndex;    //! items, sorted by key handle id
+  mutable vector<RgBool>        fFlatBool;     //! bool values
+  mutable vector<RgInt>         fFlatInt;      //! int values
+  mutable vector<RgDbl>         fFlatDbl;      //! double values
+  mutable vector<RgStr>         fFlatStr;      //! string values
+  mutable vector<RgAlg>         fFlatAlg;      //! algorithm values
 };
 
 }        // genie namespace
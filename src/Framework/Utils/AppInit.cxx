@@ -17,6 +17,7 @@
 #include "Framework/Messenger/Messenger.h"
 #include "Framework/Numerical/RandomGen.h"
 #include "Framework/Utils/Cache.h"
+#include "Framework/Utils/RunOpt.h"
 #include "Framework/Utils/XSecSplineList.h"
 #include "Framework/Utils/SystemUtils.h"
 #include "Framework/Utils/AppInit.h"
@@ -60,7 +61,23 @@ void genie::utils::app_init::XSecTable (string inpfile, bool require_table)
   // file was specified & exists - load table
   if (utils::system::FileExists(fullinpfile)) {
     xspl = XSecSplineList::Instance();
-    XmlParserStatus_t status = xspl->LoadFromXml(fullinpfile);
+    // binary spline files (see gspl2bin) are mapped, XML files are parsed
+    // (now, or once the event generation drivers know the initial states
+    // to be simulated, if so requested with --lazy-xsec-splines) unless
+    // they are shared, converted to binary, through the shared table store
+    XmlParserStatus_t status = kXmlOK;
+    if(XSecSplineList::IsBinaryFile(fullinpfile)) {
+      status = xspl->LoadFromBinary(fullinpfile);
+    }
+    else if(xspl->LoadFromSharedStore(fullinpfile)) {
+      status = kXmlOK;
+    }
+    else if(RunOpt::Instance()->LazyXSecSplines()) {
+      xspl->DeferLoadFromXml(fullinpfile);
+    }
+    else {
+      status = xspl->LoadFromXml(fullinpfile);
+    }
     if (status != kXmlOK) {
       LOG("AppInit", pFATAL)
          << "Problem reading file: " << expandedinpfile;
@@ -0,0 +1,255 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2023, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#include <algorithm>
+
+#include <TRandom3.h>
+#include <TMath.h>
+
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Utils/CacheBranchEnvelope.h"
+
+using namespace genie;
+
+ClassImp(CacheBranchEnvelope);
+
+//____________________________________________________________________________
+namespace genie
+{
+  ostream & operator << (ostream & stream, const CacheBranchEnvelope & cbenv)
+  {
+     cbenv.Print(stream);
+     return stream;
+  }
+}
+//____________________________________________________________________________
+namespace {
+  struct EnvelopeSample_t { double u, v, f; };
+}
+//____________________________________________________________________________
+CacheBranchEnvelope::CacheBranchEnvelope(void) :
+CacheBranchI()
+{
+  this->Init();
+}
+//____________________________________________________________________________
+CacheBranchEnvelope::CacheBranchEnvelope(string name) :
+CacheBranchI()
+{
+  this->Init();
+  fName = name;
+}
+//____________________________________________________________________________
+CacheBranchEnvelope::~CacheBranchEnvelope()
+{
+
+}
+//____________________________________________________________________________
+void CacheBranchEnvelope::Init(void)
+{
+  fName         = "";
+  fXDomain      = Range1D_t(0., 1.);
+  fYDomain      = Range1D_t(0., 1.);
+  fNWarmUpCalls = 0;
+  fNTrials      = 0;
+  fNAccepted    = 0;
+  fNOverweight  = 0;
+}
+//____________________________________________________________________________
+void CacheBranchEnvelope::Reset(void)
+{
+  fU0.clear(); fU1.clear(); fV0.clear(); fV1.clear();
+  fEnv.clear();
+  fCum.clear();
+  string name = fName;
+  this->Init();
+  fName = name;
+}
+//____________________________________________________________________________
+void CacheBranchEnvelope::Build(
+  EnvelopeFunc_t f, const Range1D_t & xr, const Range1D_t & yr,
+  int ncells, int nwarmup, double safety, TRandom3 & rnd)
+{
+  this->Reset();
+
+  // cells are kept in the unit square, mapped onto the domain
+  fXDomain = xr;
+  fYDomain = yr;
+  double dx = fXDomain.max - fXDomain.min;
+  double dy = fYDomain.max - fYDomain.min;
+
+  ncells  = TMath::Max(1, ncells);
+  nwarmup = TMath::Max(2, nwarmup);
+
+  vector< vector<EnvelopeSample_t> > samples;
+
+  fU0.push_back(0.); fU1.push_back(1.);
+  fV0.push_back(0.); fV1.push_back(1.);
+  samples.push_back(vector<EnvelopeSample_t>());
+
+  // top-up the samples of a cell to nwarmup
+  auto topup = [&](int c) {
+    while((int)samples[c].size() < nwarmup) {
+      EnvelopeSample_t s;
+      s.u = fU0[c] + (fU1[c]-fU0[c]) * rnd.Rndm();
+      s.v = fV0[c] + (fV1[c]-fV0[c]) * rnd.Rndm();
+      s.f = TMath::Max(0., f(fXDomain.min + dx*s.u, fYDomain.min + dy*s.v));
+      fNWarmUpCalls++;
+      samples[c].push_back(s);
+    }
+  };
+  auto cellmax = [&](const vector<EnvelopeSample_t> & sv) {
+    double m = 0;
+    for(unsigned int i = 0; i < sv.size(); i++) m = TMath::Max(m, sv[i].f);
+    return m;
+  };
+  auto volume = [&](int c) { return (fU1[c]-fU0[c]) * (fV1[c]-fV0[c]); };
+
+  topup(0);
+
+  while((int)fU0.size() < ncells) {
+
+    // cell where the envelope wastes most
+    int    worst = -1;
+    double wmax  = 0;
+    for(unsigned int c = 0; c < fU0.size(); c++) {
+      double m = cellmax(samples[c]);
+      double mean = 0;
+      for(unsigned int i = 0; i < samples[c].size(); i++) mean += samples[c][i].f;
+      mean /= samples[c].size();
+      double waste = volume(c) * (m - mean);
+      if(waste > wmax) { wmax = waste; worst = c; }
+    }
+    if(worst < 0) break; // flat (or zero) everywhere
+
+    // bisect along the direction reducing the envelope integral the most
+    double um = 0.5*(fU0[worst]+fU1[worst]);
+    double vm = 0.5*(fV0[worst]+fV1[worst]);
+    double pmax = cellmax(samples[worst]);
+    double score[2];
+    for(int dir = 0; dir < 2; dir++) {
+      vector<EnvelopeSample_t> a, b;
+      for(unsigned int i = 0; i < samples[worst].size(); i++) {
+        const EnvelopeSample_t & s = samples[worst][i];
+        bool lo = (dir == 0) ? (s.u < um) : (s.v < vm);
+        if(lo) a.push_back(s); else b.push_back(s);
+      }
+      // children without samples conservatively keep the parent maximum
+      double ma = (a.size() > 0) ? cellmax(a) : pmax;
+      double mb = (b.size() > 0) ? cellmax(b) : pmax;
+      score[dir] = 0.5 * volume(worst) * (ma + mb);
+    }
+    int dir = (score[0] <= score[1]) ? 0 : 1;
+
+    int child = fU0.size();
+    fU0.push_back(fU0[worst]); fU1.push_back(fU1[worst]);
+    fV0.push_back(fV0[worst]); fV1.push_back(fV1[worst]);
+    if(dir == 0) { fU1[worst] = um; fU0[child] = um; }
+    else         { fV1[worst] = vm; fV0[child] = vm; }
+
+    vector<EnvelopeSample_t> parent;
+    parent.swap(samples[worst]);
+    samples.push_back(vector<EnvelopeSample_t>());
+    for(unsigned int i = 0; i < parent.size(); i++) {
+      const EnvelopeSample_t & s = parent[i];
+      bool lo = (dir == 0) ? (s.u < um) : (s.v < vm);
+      samples[lo ? worst : child].push_back(s);
+    }
+    topup(worst);
+    topup(child);
+  }
+
+  // envelope = safety x max sampled value; cells where no non-zero value was
+  // sampled keep a small floor so that no part of the space is excluded
+  double gmax = 0;
+  fEnv.resize(fU0.size());
+  for(unsigned int c = 0; c < fU0.size(); c++) {
+    fEnv[c] = safety * cellmax(samples[c]);
+    gmax = TMath::Max(gmax, fEnv[c]);
+  }
+  for(unsigned int c = 0; c < fU0.size(); c++) {
+    fEnv[c] = TMath::Max(fEnv[c], 1E-3 * gmax);
+  }
+  this->BuildIntegral();
+
+  LOG("CacheBranch", pINFO)
+    << "Trained envelope " << fName << " with " << fEnv.size()
+    << " cells using " << fNWarmUpCalls << " function calls";
+}
+//____________________________________________________________________________
+void CacheBranchEnvelope::BuildIntegral(void)
+{
+  fCum.resize(fEnv.size());
+  double sum = 0;
+  for(unsigned int c = 0; c < fEnv.size(); c++) {
+    sum += fEnv[c] * (fU1[c]-fU0[c]) * (fV1[c]-fV0[c]);
+    fCum[c] = sum;
+  }
+}
+//____________________________________________________________________________
+int CacheBranchEnvelope::Sample(
+   TRandom3 & rnd, double & x, double & y, double & envelope) const
+{
+  if(this->Integral() <= 0) return -1;
+
+  double R = this->Integral() * rnd.Rndm();
+  int c = std::upper_bound(fCum.begin(), fCum.end(), R) - fCum.begin();
+  c = TMath::Min(c, (int)fCum.size()-1);
+
+  double u = fU0[c] + (fU1[c]-fU0[c]) * rnd.Rndm();
+  double v = fV0[c] + (fV1[c]-fV0[c]) * rnd.Rndm();
+  x = fXDomain.min + (fXDomain.max - fXDomain.min) * u;
+  y = fYDomain.min + (fYDomain.max - fYDomain.min) * v;
+  envelope = fEnv[c];
+
+  return c;
+}
+//____________________________________________________________________________
+void CacheBranchEnvelope::Raise(int cell, double envelope)
+{
+  if(cell < 0 || cell >= (int)fEnv.size()) return;
+  if(envelope <= fEnv[cell]) return;
+  fEnv[cell] = envelope;
+  this->BuildIntegral();
+}
+//____________________________________________________________________________
+double CacheBranchEnvelope::Envelope(int cell) const
+{
+  if(cell < 0 || cell >= (int)fEnv.size()) return 0.;
+  return fEnv[cell];
+}
+//____________________________________________________________________________
+bool CacheBranchEnvelope::Covers(const Range1D_t & xr, const Range1D_t & yr) const
+{
+  if(!this->IsTrained()) return false;
+  return (xr.min >= fXDomain.min && xr.max <= fXDomain.max &&
+          yr.min >= fYDomain.min && yr.max <= fYDomain.max);
+}
+//____________________________________________________________________________
+double CacheBranchEnvelope::Efficiency(void) const
+{
+  return (fNTrials > 0) ? (double)fNAccepted / fNTrials : 0.;
+}
+//____________________________________________________________________________
+double CacheBranchEnvelope::CallsPerEvent(void) const
+{
+  return (fNAccepted > 0) ? (double)(fNWarmUpCalls + fNTrials) / fNAccepted : 0.;
+}
+//____________________________________________________________________________
+void CacheBranchEnvelope::Print(ostream & stream) const
+{
+  stream << "type: [CacheBranchEnvelope] - nentries: " << fEnv.size()
+         << " cells over [" << fXDomain.min << ", " << fXDomain.max << "] x ["
+         << fYDomain.min << ", " << fYDomain.max << "]"
+         << " - warm-up calls: " << fNWarmUpCalls
+         << ", trials: " << fNTrials
+         << ", accepted: " << fNAccepted
+         << " (efficiency: " << this->Efficiency()
+         << ", xsec calls / event: " << this->CallsPerEvent()
+         << ", overweight: " << fNOverweight << ")";
+}
+//____________________________________________________________________________
@@ -0,0 +1,135 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::CacheBranchEnvelope
+
+\brief    A cache branch holding an adaptive, piecewise-constant envelope of
+          a non-negative function of two variables, defined over the
+          rectangular domain it was trained on.
+
+          The envelope is trained on the function in the spirit of VEGAS /
+          Foam: starting from a single cell, the cell where the envelope
+          wastes most (volume x (max - mean), as estimated from the warm-up
+          samples) is repeatedly bisected along the direction that reduces
+          the envelope integral the most, until the requested number of
+          cells is reached. Each cell carries the maximum sampled function
+          value times a safety factor.
+
+          Points are then drawn from the envelope (a cell with probability
+          proportional to its envelope integral, uniformly within the cell)
+          and accepted with probability f/envelope. If f exceeds the
+          envelope, the cell envelope is raised and the point is rejected,
+          so that events stay unweighted.
+
+          The domain is kept with the envelope: users whose variable limits
+          change (eg with the energy within an energy bin) check it with
+          Covers() and retrain the envelope over a wider domain if needed.
+
+          The branch also counts the function calls and trials, so that the
+          sampling efficiency can be reported.
+
+\author   GENIE Collaboration
+
+\created  October 16, 2026
+
+\cpright  Copyright (c) 2003-2023, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _CACHE_BRANCH_ENVELOPE_H_
+#define _CACHE_BRANCH_ENVELOPE_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "Framework/Utils/CacheBranchI.h"
+#include "Framework/Utils/Range1.h"
+
+class TRandom3;
+
+using std::string;
+using std::ostream;
+using std::vector;
+
+namespace genie {
+
+class CacheBranchEnvelope;
+ostream & operator << (ostream & stream, const CacheBranchEnvelope & cbenv);
+
+//! function sampled by the envelope: f(x,y), (x,y) in the envelope domain
+typedef std::function<double (double x, double y)> EnvelopeFunc_t;
+
+class CacheBranchEnvelope : public CacheBranchI
+{
+public:
+  using TObject::Print; // suppress clang 'hides overloaded virtual function [-Woverloaded-virtual]' warnings
+
+  CacheBranchEnvelope();
+  CacheBranchEnvelope(string name);
+  ~CacheBranchEnvelope();
+
+  //! Train the envelope on the input function over the domain xr x yr
+  void Build (EnvelopeFunc_t f, const Range1D_t & xr, const Range1D_t & yr,
+              int ncells, int nwarmup, double safety, TRandom3 & rnd);
+
+  //! Draw (x,y) from the envelope: returns the cell index and its envelope
+  int  Sample (TRandom3 & rnd, double & x, double & y, double & envelope) const;
+
+  //! Raise the envelope of a cell to the input value
+  void Raise (int cell, double envelope);
+
+  //! Current envelope of a cell
+  double Envelope (int cell) const;
+
+  //! Does the trained domain contain xr x yr?
+  bool Covers (const Range1D_t & xr, const Range1D_t & yr) const;
+  const Range1D_t & XDomain (void) const { return fXDomain; }
+  const Range1D_t & YDomain (void) const { return fYDomain; }
+
+  //! Book-keeping for the efficiency report
+  void CountTrial    (void) { fNTrials++;     }
+  void CountAccepted (void) { fNAccepted++;   }
+  void CountOverweight (void) { fNOverweight++; }
+
+  bool      IsTrained    (void) const { return fEnv.size() > 0; }
+  int       NCells       (void) const { return fEnv.size(); }
+  double    Integral     (void) const { return (fCum.size() > 0) ? fCum.back() : 0.; }
+  long      NWarmUpCalls (void) const { return fNWarmUpCalls; }
+  long      NTrials      (void) const { return fNTrials;      }
+  long      NAccepted    (void) const { return fNAccepted;    }
+  long      NOverweight  (void) const { return fNOverweight;  }
+  double    Efficiency   (void) const;  ///< accepted / trials
+  double    CallsPerEvent(void) const;  ///< (warm-up calls + trials) / accepted
+
+  void Reset (void);
+  void Print (ostream & stream) const;
+
+  friend ostream & operator << (ostream & stream, const CacheBranchEnvelope & cbenv);
+
+private:
+  void Init          (void);
+  void BuildIntegral (void);
+
+  string         fName;         ///< cache branch name
+  Range1D_t      fXDomain;      ///< x range mapped onto the unit square of the cells
+  Range1D_t      fYDomain;      ///< y range mapped onto the unit square of the cells
+  vector<double> fU0;           ///< cell lower edge in u
+  vector<double> fU1;           ///< cell upper edge in u
+  vector<double> fV0;           ///< cell lower edge in v
+  vector<double> fV1;           ///< cell upper edge in v
+  vector<double> fEnv;          ///< cell envelope (constant within the cell)
+  vector<double> fCum;          ///< running sum of the cell envelope integrals
+  long           fNWarmUpCalls; ///< function calls spent in training
+  long           fNTrials;      ///< points drawn from the envelope
+  long           fNAccepted;    ///< points accepted
+  long           fNOverweight;  ///< rejected points where f exceeded the envelope
+
+ClassDef(CacheBranchEnvelope,2)
+};
+
+}      // genie namespace
+
+#endif // _CACHE_BRANCH_ENVELOPE_H_
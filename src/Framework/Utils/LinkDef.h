@@ -26,8 +26,13 @@
 #pragma link C++ class genie::CacheBranchI;
 #pragma link C++ class genie::CacheBranchNtp;
 #pragma link C++ class genie::CacheBranchFx;
+#pragma link C++ class genie::CacheBranchEnvelope;
 #pragma link C++ class genie::CmdLnArgParser;
 #pragma link C++ class genie::XSecSplineList;
+#pragma link C++ class genie::MaxXSecTable;
+#pragma link C++ class genie::SharedTableStore;
+#pragma link C++ class genie::PerfCounter;
+#pragma link C++ class genie::PerfMonitor;
 #pragma link C++ class genie::Range1D_t;
 #pragma link C++ class genie::Range1F_t;
 #pragma link C++ class genie::Range1I_t;
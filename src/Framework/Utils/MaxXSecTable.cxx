@@ -0,0 +1,378 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2023, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Utils/MaxXSecTable.h"
+#include "Framework/Utils/RunOpt.h"
+
+using std::ofstream;
+
+using namespace genie;
+
+//____________________________________________________________________________
+// Max xsec table file layout (host byte order; files written on a host of
+// different endianness fail the magic word check):
+//
+//   MxtHeader                                    (fixed size)
+//   MxtEntry[nentries]                           (sorted by key)
+//   char  strings[strings_size]                  (tune name and keys)
+//   double knots[...]                            (per entry: E[n], xsec[n])
+//
+// The knot block is 8-byte aligned so it can be used in-place. The header
+// carries a checksum of everything that follows it.
+//
+namespace {
+
+  const char     kMxtMagic[8] = { 'G','M','X','X','S','T','B','L' };
+  const uint32_t kMxtVersion  = 2;
+
+  struct MxtHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t nentries;
+    uint64_t index_offset;
+    uint64_t strings_offset;
+    uint64_t strings_size;
+    uint64_t knots_offset;
+    uint64_t nknots_total;
+    uint32_t tune_offset;
+    uint32_t tune_length;
+    uint64_t checksum;     ///< MaxXSecTable::Hash of the bytes after the header
+  };
+
+  struct MxtEntry {
+    uint32_t key_offset;
+    uint32_t key_length;
+    uint64_t config_hash;
+    uint64_t knots_offset; ///< in units of double, from the start of the knot block
+    uint32_t nknots;
+    uint32_t reserved;
+  };
+
+  const MxtHeader * Header  (void * addr) { return (const MxtHeader *) addr; }
+  const MxtEntry  * Index   (void * addr) { return (const MxtEntry *) ((const char *) addr + Header(addr)->index_offset);   }
+  const char      * Strings (void * addr) { return (const char *)     ((const char *) addr + Header(addr)->strings_offset); }
+  const double    * Knots   (void * addr) { return (const double *)   ((const char *) addr + Header(addr)->knots_offset);   }
+
+  // 64-bit FNV-1a, continued from h
+  uint64_t HashBytes(const char * data, size_t n, uint64_t h = 14695981039346656037ULL)
+  {
+    for(size_t i = 0; i < n; i++) {
+      h ^= (unsigned char) data[i];
+      h *= 1099511628211ULL;
+    }
+    return h;
+  }
+
+  // Checks made when a table is mapped: every block must lie within the
+  // file, the body must match its checksum, and every entry must point within
+  // the string & knot blocks and follow the previous one in key order (as
+  // needed by the look-up). Sizes are compared so that corrupt values cannot
+  // overflow the offset arithmetic.
+  bool ValidTable(void * addr, size_t size, string & reason)
+  {
+    const MxtHeader * h = Header(addr);
+    if(memcmp(h->magic, kMxtMagic, sizeof(kMxtMagic)) != 0) {
+      reason = "bad magic word"; return false;
+    }
+    if(h->version != kMxtVersion) {
+      reason = "unsupported format version"; return false;
+    }
+    if(h->index_offset > size ||
+       h->nentries > (size - h->index_offset) / sizeof(MxtEntry)) {
+      reason = "index block beyond the end of file"; return false;
+    }
+    if(h->strings_offset > size || h->strings_size > size - h->strings_offset) {
+      reason = "string block beyond the end of file"; return false;
+    }
+    if(h->tune_offset > h->strings_size ||
+       h->tune_length > h->strings_size - h->tune_offset) {
+      reason = "tune name beyond the string block"; return false;
+    }
+    if(h->knots_offset > size || h->knots_offset % sizeof(double) != 0 ||
+       h->nknots_total > (size - h->knots_offset) / sizeof(double)) {
+      reason = "knot block misaligned or beyond the end of file"; return false;
+    }
+    size_t body_end = h->knots_offset + h->nknots_total * sizeof(double);
+    const char * base = (const char *) addr;
+    if(HashBytes(base + sizeof(MxtHeader), body_end - sizeof(MxtHeader)) != h->checksum) {
+      reason = "checksum mismatch"; return false;
+    }
+
+    const MxtEntry * index   = Index(addr);
+    const char     * strings = Strings(addr);
+    for(uint64_t ie = 0; ie < h->nentries; ie++) {
+      const MxtEntry & e = index[ie];
+      if(e.key_offset > h->strings_size ||
+         e.key_length > h->strings_size - e.key_offset ||
+         e.nknots < 1 || e.knots_offset > h->nknots_total ||
+         2*(uint64_t)e.nknots > h->nknots_total - e.knots_offset) {
+        reason = "entry " + std::to_string(ie) + " beyond the string or knot block";
+        return false;
+      }
+      if(ie > 0) {
+        const MxtEntry & p = index[ie-1];
+        string key(strings + e.key_offset, e.key_length);
+        if(key.compare(0, string::npos, strings + p.key_offset, p.key_length) <= 0) {
+          reason = "entry " + std::to_string(ie) + " not in key order";
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+} // anonymous namespace
+
+//____________________________________________________________________________
+MaxXSecTable * MaxXSecTable::fInstance = 0;
+//____________________________________________________________________________
+MaxXSecTable::MaxXSecTable()
+{
+  fInstance = 0;
+  fAddr     = 0;
+  fSize     = 0;
+
+  string filename = RunOpt::Instance()->MaxXSecTable();
+  if(filename.size() == 0) {
+    const char * env = std::getenv("GMAXXSECTABLE");
+    if(env) filename = env;
+  }
+  if(filename.size() > 0) this->Load(filename);
+}
+//____________________________________________________________________________
+MaxXSecTable::~MaxXSecTable()
+{
+  this->Close();
+  fInstance = 0;
+}
+//____________________________________________________________________________
+MaxXSecTable * MaxXSecTable::Instance()
+{
+  if(fInstance == 0) {
+    static MaxXSecTable::Cleaner cleaner;
+    cleaner.DummyMethodAndSilentCompiler();
+    fInstance = new MaxXSecTable;
+  }
+  return fInstance;
+}
+//____________________________________________________________________________
+bool MaxXSecTable::Load(string filename)
+{
+  this->Close();
+
+  LOG("MaxXSecTable", pNOTICE) << "Mapping max xsec table: " << filename;
+
+  int fd = open(filename.c_str(), O_RDONLY);
+  if(fd < 0) {
+    LOG("MaxXSecTable", pERROR) << "Max xsec table could not be opened: " << filename;
+    return false;
+  }
+  struct stat st;
+  if(fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(MxtHeader)) {
+    LOG("MaxXSecTable", pERROR) << "Max xsec table is empty or unreadable: " << filename;
+    close(fd);
+    return false;
+  }
+  size_t size = st.st_size;
+  void * addr = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(addr == MAP_FAILED) {
+    LOG("MaxXSecTable", pERROR) << "Max xsec table could not be mapped: " << filename;
+    return false;
+  }
+
+  const MxtHeader * header = Header(addr);
+  string reason = "";
+  if(!ValidTable(addr, size, reason)) {
+    LOG("MaxXSecTable", pERROR)
+      << "Invalid or unsupported max xsec table (" << reason << "): " << filename;
+    munmap(addr, size);
+    return false;
+  }
+
+  fFilename = filename;
+  fAddr     = addr;
+  fSize     = size;
+
+  // a table built for another tune is useless (and its entries would fail the
+  // configuration check anyway)
+  const TuneId * tune = RunOpt::Instance()->Tune();
+  if(tune && tune->Name() != this->Tune()) {
+    LOG("MaxXSecTable", pWARN)
+      << "Max xsec table " << filename << " was built for tune "
+      << this->Tune() << ", not " << tune->Name() << " - Ignoring it";
+    this->Close();
+    return false;
+  }
+
+  LOG("MaxXSecTable", pNOTICE)
+    << "Mapped " << header->nentries << " max xsec entries for tune "
+    << this->Tune();
+
+  return true;
+}
+//____________________________________________________________________________
+string MaxXSecTable::Tune(void) const
+{
+  if(!fAddr) return "";
+  const MxtHeader * header = Header(fAddr);
+  return string(Strings(fAddr) + header->tune_offset, header->tune_length);
+}
+//____________________________________________________________________________
+int MaxXSecTable::NEntries(void) const
+{
+  if(!fAddr) return 0;
+  return Header(fAddr)->nentries;
+}
+//____________________________________________________________________________
+bool MaxXSecTable::Find(const string & key, uint64_t config_hash,
+           int & n, const double * & E, const double * & xsec) const
+{
+  n = 0;
+  E = xsec = 0;
+  if(!fAddr) return false;
+
+  const MxtHeader * header  = Header(fAddr);
+  const MxtEntry  * index   = Index(fAddr);
+  const char      * strings = Strings(fAddr);
+
+  const MxtEntry * entry = 0;
+  uint64_t lo = 0, hi = header->nentries;
+  while(lo < hi) {
+    uint64_t mid = lo + (hi-lo)/2;
+    int c = key.compare(0, string::npos,
+                 strings + index[mid].key_offset, index[mid].key_length);
+    if      (c > 0) lo = mid+1;
+    else if (c < 0) hi = mid;
+    else { entry = &index[mid]; break; }
+  }
+  if(!entry) return false;
+
+  if(entry->config_hash != config_hash) {
+    LOG("MaxXSecTable", pWARN)
+      << "Ignoring max xsec table entry computed with a different configuration: "
+      << key;
+    return false;
+  }
+
+  n    = entry->nknots;
+  E    = Knots(fAddr) + entry->knots_offset;
+  xsec = E + n;
+  return true;
+}
+//____________________________________________________________________________
+void MaxXSecTable::Add(const string & key, uint64_t config_hash,
+           const vector<double> & E, const vector<double> & xsec)
+{
+  assert(E.size() == xsec.size());
+  NewEntry & entry = fNewEntries[key];
+  entry.hash = config_hash;
+  entry.E    = E;
+  entry.xsec = xsec;
+}
+//____________________________________________________________________________
+bool MaxXSecTable::Save(string filename, string tune) const
+{
+  LOG("MaxXSecTable", pNOTICE)
+    << "Saving " << fNewEntries.size() << " max xsec entries in: " << filename;
+
+  // the map keeps the keys sorted, as needed by the look-up
+  vector<MxtEntry> index;
+  string           strings = tune;
+  vector<double>   knots;
+
+  map<string, NewEntry>::const_iterator it = fNewEntries.begin();
+  for( ; it != fNewEntries.end(); ++it) {
+    MxtEntry entry;
+    entry.key_offset   = strings.size();
+    entry.key_length   = it->first.size();
+    entry.config_hash  = it->second.hash;
+    entry.knots_offset = knots.size();
+    entry.nknots       = it->second.E.size();
+    entry.reserved     = 0;
+    strings += it->first;
+    knots.insert(knots.end(), it->second.E.begin(),    it->second.E.end());
+    knots.insert(knots.end(), it->second.xsec.begin(), it->second.xsec.end());
+    index.push_back(entry);
+  }
+
+  MxtHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, kMxtMagic, sizeof(kMxtMagic));
+  header.version        = kMxtVersion;
+  header.nentries       = index.size();
+  header.index_offset   = sizeof(MxtHeader);
+  header.strings_offset = header.index_offset + index.size() * sizeof(MxtEntry);
+  header.strings_size   = strings.size();
+  header.knots_offset   = (header.strings_offset + header.strings_size + 7) & ~((uint64_t)7);
+  header.nknots_total   = knots.size();
+  header.tune_offset    = 0;
+  header.tune_length    = tune.size();
+
+  const char pad[8] = {0,0,0,0,0,0,0,0};
+  size_t npad = header.knots_offset - (header.strings_offset + header.strings_size);
+  uint64_t checksum = HashBytes(0, 0);
+  if(!index.empty()) {
+    checksum = HashBytes((const char *) &index[0], index.size() * sizeof(MxtEntry), checksum);
+  }
+  checksum = HashBytes(strings.data(), strings.size(), checksum);
+  checksum = HashBytes(pad, npad, checksum);
+  if(!knots.empty()) {
+    checksum = HashBytes((const char *) &knots[0], knots.size() * sizeof(double), checksum);
+  }
+  header.checksum = checksum;
+
+  ofstream out(filename.c_str(), std::ios::binary);
+  if(!out.is_open()) {
+    LOG("MaxXSecTable", pERROR) << "Couldn't create file = " << filename;
+    return false;
+  }
+  out.write((const char *) &header, sizeof(header));
+  if(!index.empty()) {
+    out.write((const char *) &index[0], index.size() * sizeof(MxtEntry));
+  }
+  out.write(strings.data(), strings.size());
+  out.write(pad, npad);
+  if(!knots.empty()) {
+    out.write((const char *) &knots[0], knots.size() * sizeof(double));
+  }
+  out.close();
+
+  if(out.fail()) {
+    LOG("MaxXSecTable", pERROR) << "Failed writing file = " << filename;
+    return false;
+  }
+  return true;
+}
+//____________________________________________________________________________
+uint64_t MaxXSecTable::Hash(const string & s)
+{
+// 64-bit FNV-1a
+
+  return HashBytes(s.data(), s.size());
+}
+//____________________________________________________________________________
+void MaxXSecTable::Close(void)
+{
+  if(fAddr) munmap(fAddr, fSize);
+  fAddr = 0;
+  fSize = 0;
+  fFilename = "";
+}
+//____________________________________________________________________________
@@ -0,0 +1,105 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::MaxXSecTable
+
+\brief    Singleton serving a precomputed table of the maximum differential
+          cross sections used by the kinematic generators in the rejection
+          method (see KineGeneratorWithCache), so that generation jobs start
+          warm instead of scanning the kinematic phase space per channel.
+
+          The table is a compact, read-only binary file (built by gmkmaxxsec)
+          which is memory mapped and shared, through the page cache, by all
+          jobs on a node. Each entry is keyed by the kinematic generator cache
+          branch key and carries a hash of the kinematic generator and cross
+          section model configuration: entries computed with a different
+          configuration are ignored. The table is loaded from the file given
+          with --max-xsec-table or, otherwise, from $GMAXXSECTABLE.
+
+\author   GENIE Collaboration
+
+\created  October 16, 2026
+
+\cpright  Copyright (c) 2003-2023, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _MAX_XSEC_TABLE_H_
+#define _MAX_XSEC_TABLE_H_
+
+#include <string>
+#include <map>
+#include <vector>
+
+#include <stdint.h>
+
+using std::string;
+using std::map;
+using std::vector;
+
+namespace genie {
+
+class MaxXSecTable
+{
+public:
+  static MaxXSecTable * Instance(void);
+
+  //! map a table file (replacing any mapped one)
+  bool   Load     (string filename);
+  bool   IsLoaded (void) const { return fAddr != 0; }
+  string Tune     (void) const;
+  int    NEntries (void) const;
+
+  //! look-up the max xsec knots (E[n], xsec[n]) stored for a cache branch key;
+  //! fails if the entry is missing or was built with a different configuration
+  bool   Find (const string & key, uint64_t config_hash,
+               int & n, const double * & E, const double * & xsec) const;
+
+  //! build a new table
+  void   Add  (const string & key, uint64_t config_hash,
+               const vector<double> & E, const vector<double> & xsec);
+  bool   Save (string filename, string tune) const;
+
+  //! hash used to tag entries with the configuration they were computed with
+  static uint64_t Hash (const string & s);
+
+  //! entries with at least this many points are interpolated, as the max
+  //! xsec values cached during generation (KineGeneratorWithCache)
+  static const int kNMinInterpolation = 41;
+
+private:
+  MaxXSecTable();
+  MaxXSecTable(const MaxXSecTable & table);
+  virtual ~MaxXSecTable();
+
+  void Close (void);
+
+  static MaxXSecTable * fInstance;
+
+  string  fFilename;   ///< mapped file
+  void *  fAddr;       ///< mapped file address
+  size_t  fSize;       ///< mapped file size
+
+  struct NewEntry {
+    uint64_t       hash;
+    vector<double> E;
+    vector<double> xsec;
+  };
+  map<string, NewEntry> fNewEntries; ///< entries added for a new table
+
+  struct Cleaner {
+      void DummyMethodAndSilentCompiler() { }
+      ~Cleaner() {
+         if (MaxXSecTable::fInstance !=0) {
+            delete MaxXSecTable::fInstance;
+            MaxXSecTable::fInstance = 0;
+         }
+      }
+  };
+  friend struct Cleaner;
+};
+
+}      // genie namespace
+
+#endif // _MAX_XSEC_TABLE_H_
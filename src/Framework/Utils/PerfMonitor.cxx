@@ -0,0 +1,244 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2023, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "Framework/Algorithm/Algorithm.h"
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Utils/PerfMonitor.h"
+#include "Framework/Utils/RunOpt.h"
+
+using std::endl;
+using std::setw;
+using std::vector;
+using std::ofstream;
+using std::ostringstream;
+
+using namespace genie;
+
+//____________________________________________________________________________
+namespace {
+  // report order: by category, then most expensive first
+  bool CounterOrder(const PerfCounter * a, const PerfCounter * b)
+  {
+    if(a->Category() != b->Category()) return a->Category() < b->Category();
+    if(a->Time()     != b->Time())     return a->Time()     > b->Time();
+    return a->Name() < b->Name();
+  }
+  string JSONString(const string & s)
+  {
+    ostringstream out;
+    out << "\"";
+    for(unsigned int i = 0; i < s.size(); i++) {
+      char c = s[i];
+      if     (c == '"' ) out << "\\\"";
+      else if(c == '\\') out << "\\\\";
+      else if((unsigned char) c < 0x20) {
+        char buf[8];
+        snprintf(buf, sizeof(buf), "\\u%04x", (unsigned char) c);
+        out << buf;
+      }
+      else out << c;
+    }
+    out << "\"";
+    return out.str();
+  }
+}
+//____________________________________________________________________________
+namespace genie {
+  ostream & operator << (ostream & stream, const PerfMonitor & mon)
+  {
+    mon.Print(stream);
+    return stream;
+  }
+}
+//____________________________________________________________________________
+PerfCounter::PerfCounter(const string & category, const string & name) :
+fCategory(category),
+fName(name),
+fCalls(0),
+fTime(0),
+fCount(0)
+{
+
+}
+//____________________________________________________________________________
+PerfMonitor * PerfMonitor::fInstance = 0;
+//____________________________________________________________________________
+PerfMonitor::PerfMonitor() :
+fNEvents(0),
+fReported(false),
+fStart(std::chrono::steady_clock::now())
+{
+  fInstance = 0;
+}
+//____________________________________________________________________________
+PerfMonitor::~PerfMonitor()
+{
+  if(!gAbortingInErr) this->Report();
+  fIntegratorCounters.clear();
+  fCounters.clear();
+  fInstance = 0;
+}
+//____________________________________________________________________________
+PerfMonitor * PerfMonitor::Instance()
+{
+  if(fInstance == 0) {
+    // the report is made when the monitor is deleted at exit: create the
+    // singletons it uses first, so that they are deleted after it
+    Messenger::Instance();
+    RunOpt::Instance();
+
+    static PerfMonitor::Cleaner cleaner;
+    cleaner.DummyMethodAndSilentCompiler();
+    fInstance = new PerfMonitor;
+  }
+  return fInstance;
+}
+//____________________________________________________________________________
+PerfCounter * PerfMonitor::Counter(const string & category, const string & name)
+{
+  pair<string,string> key(category, name);
+  map<pair<string,string>, PerfCounter>::iterator it = fCounters.find(key);
+  if(it == fCounters.end()) {
+    it = fCounters.insert(
+           std::make_pair(key, PerfCounter(category, name))).first;
+  }
+  return &(it->second);
+}
+//____________________________________________________________________________
+PerfCounter * PerfMonitor::IntegratorCounter(const Algorithm * xsec_model)
+{
+  map<const Algorithm *, PerfCounter *>::iterator it =
+                                  fIntegratorCounters.find(xsec_model);
+  if(it != fIntegratorCounters.end()) return it->second;
+
+  string name = xsec_model->Id().Key();
+  const Registry & config = xsec_model->GetConfig();
+  if(config.Exists("XSec-Integrator")) {
+    RgAlg integrator = config.GetAlg("XSec-Integrator");
+    name = integrator.name + "/" + integrator.config + " [" + name + "]";
+  }
+  PerfCounter * counter = this->Counter("XSecIntegrator", name);
+  fIntegratorCounters[xsec_model] = counter;
+  return counter;
+}
+//____________________________________________________________________________
+double PerfMonitor::JobTime(void) const
+{
+  return std::chrono::duration<double>(
+           std::chrono::steady_clock::now() - fStart).count();
+}
+//____________________________________________________________________________
+void PerfMonitor::Print(ostream & stream) const
+{
+  vector<const PerfCounter *> counters;
+  map<pair<string,string>, PerfCounter>::const_iterator it = fCounters.begin();
+  for( ; it != fCounters.end(); ++it) {
+    if(it->second.Calls() > 0 || it->second.NCounted() > 0) {
+      counters.push_back(&(it->second));
+    }
+  }
+  std::sort(counters.begin(), counters.end(), CounterOrder);
+
+  double nev = (double) fNEvents;
+
+  stream << "\n GENIE performance report: " << fNEvents << " events in "
+         << std::fixed << std::setprecision(2) << this->JobTime() << " s";
+  stream << "\n " << std::left << setw(48) << "counter" << std::right
+         << setw(12) << "calls"
+         << setw(12) << "time [s]"
+         << setw(14) << "t/call [us]"
+         << setw(12) << "calls/evt"
+         << setw(14) << "count"
+         << setw(12) << "count/call";
+
+  string category = "";
+  vector<const PerfCounter *>::const_iterator ic = counters.begin();
+  for( ; ic != counters.end(); ++ic) {
+    const PerfCounter * c = *ic;
+    if(c->Category() != category) {
+      category = c->Category();
+      stream << "\n [" << category << "]";
+    }
+    string name = c->Name();
+    if(name.size() > 46) name = "..." + name.substr(name.size()-43);
+
+    stream << "\n   " << std::left << setw(46) << name << std::right
+           << setw(12) << c->Calls()
+           << std::setprecision(3)
+           << setw(12) << c->Time()
+           << setw(14) << ((c->Calls() > 0) ? 1E+6*c->Time()/c->Calls() : 0.)
+           << setw(12) << ((nev > 0) ? c->Calls()/nev : 0.)
+           << setw(14) << c->NCounted()
+           << setw(12) << ((c->Calls() > 0) ? (double)c->NCounted()/c->Calls() : 0.);
+  }
+  stream << std::defaultfloat << std::setprecision(6) << endl;
+}
+//____________________________________________________________________________
+void PerfMonitor::PrintJSON(ostream & stream) const
+{
+  stream << "{" << endl;
+  stream << "  \"events\": " << fNEvents << "," << endl;
+  stream << "  \"job_time_s\": " << this->JobTime() << "," << endl;
+  stream << "  \"counters\": [";
+
+  bool first = true;
+  map<pair<string,string>, PerfCounter>::const_iterator it = fCounters.begin();
+  for( ; it != fCounters.end(); ++it) {
+    const PerfCounter & c = it->second;
+    if(c.Calls() == 0 && c.NCounted() == 0) continue;
+    stream << (first ? "" : ",") << endl;
+    stream << "    { \"category\": " << JSONString(c.Category())
+           << ", \"name\": "          << JSONString(c.Name())
+           << ", \"calls\": "         << c.Calls()
+           << ", \"time_s\": "        << c.Time()
+           << ", \"count\": "         << c.NCounted() << " }";
+    first = false;
+  }
+  stream << endl << "  ]" << endl << "}" << endl;
+}
+//____________________________________________________________________________
+void PerfMonitor::Report(void)
+{
+  if(fReported) return;
+
+  bool filled = false;
+  map<pair<string,string>, PerfCounter>::const_iterator it = fCounters.begin();
+  for( ; it != fCounters.end() && !filled; ++it) {
+    filled = (it->second.Calls() > 0 || it->second.NCounted() > 0);
+  }
+  if(!filled) return;
+  fReported = true;
+
+  LOG("PerfMonitor", pNOTICE) << *this;
+
+  string prefix = RunOpt::Instance()->PerfReport();
+  if(prefix.size() == 0 && std::getenv("GPERFREPORT")) {
+    prefix = std::getenv("GPERFREPORT");
+  }
+  if(prefix.size() == 0) return;
+
+  ofstream txt((prefix + ".txt").c_str());
+  this->Print(txt);
+  ofstream json((prefix + ".json").c_str());
+  this->PrintJSON(json);
+  if(txt.fail() || json.fail()) {
+    LOG("PerfMonitor", pWARN)
+      << "Could not write the performance report to " << prefix << ".{txt,json}";
+    return;
+  }
+  LOG("PerfMonitor", pNOTICE)
+    << "Wrote the performance report to " << prefix << ".{txt,json}";
+}
+//____________________________________________________________________________
@@ -0,0 +1,158 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::PerfMonitor
+
+\brief    Singleton collecting always-on performance counters and writing an
+          end-of-job report of where the CPU went.
+
+          Counters are identified by a category and a name and hold a number
+          of calls, the (wall-clock) time spent in them and a number of items
+          counted along the way. The framework fills:
+
+          EventGenerator     : event generation threads (key), all visitors
+          EventRecordVisitor : each visitor (key) in the event generation
+                               threads. For kinematic generators, the count
+                               is the number of rejection-loop iterations
+          XSecAlgorithm      : differential cross section evaluations of
+                               each model (key) by the kinematic generators
+          XSecIntegrator     : total cross section integrations, by
+                               integrator and model
+          Flux               : flux neutrinos thrown by GMCJDriver
+          Geometry           : path length computations and vertex
+                               generation (the geometry swim)
+
+          The report lists, for each counter, calls, time, time per call, and
+          calls & count per generated event (eg flux throws per event). It is
+          logged at the end of the job and, if a file prefix is given with
+          --perf-report or otherwise $GPERFREPORT, written to <prefix>.txt and
+          <prefix>.json.
+
+          To instrument code, get a counter once and keep the pointer (it
+          remains valid for the life of the job), then time scopes with a
+          PerfTimer:
+
+            static PerfCounter * c =
+                 PerfMonitor::Instance()->Counter("MyCategory", "MyModule");
+            PerfTimer timer(c);
+
+\author   GENIE Collaboration
+
+\created  October 16, 2026
+
+\cpright  Copyright (c) 2003-2023, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _PERF_MONITOR_H_
+#define _PERF_MONITOR_H_
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <utility>
+#include <ostream>
+
+#include <stdint.h>
+
+using std::map;
+using std::pair;
+using std::string;
+using std::ostream;
+
+namespace genie {
+
+class Algorithm;
+class PerfMonitor;
+ostream & operator << (ostream & stream, const PerfMonitor & mon);
+
+class PerfCounter
+{
+public:
+  PerfCounter(const string & category = "", const string & name = "");
+
+  void Add   (double seconds) { fCalls++; fTime += seconds; } ///< a timed call
+  void Call  (void)           { fCalls++;                   } ///< an untimed call
+  void Count (uint64_t n = 1) { fCount += n;                } ///< items counted during the calls
+
+  const string & Category (void) const { return fCategory; }
+  const string & Name     (void) const { return fName;     }
+  uint64_t       Calls    (void) const { return fCalls;    }
+  double         Time     (void) const { return fTime;     } ///< s
+  uint64_t       NCounted (void) const { return fCount;    }
+
+private:
+  string   fCategory;
+  string   fName;
+  uint64_t fCalls;
+  double   fTime;
+  uint64_t fCount;
+};
+
+//! times the scope it lives in and adds it to a counter (may be null)
+class PerfTimer
+{
+public:
+  PerfTimer(PerfCounter * counter) :
+    fCounter(counter), fStart(std::chrono::steady_clock::now()) { }
+  ~PerfTimer() {
+    if(fCounter) fCounter->Add( std::chrono::duration<double>(
+                   std::chrono::steady_clock::now() - fStart).count() );
+  }
+
+private:
+  PerfCounter * fCounter;
+  std::chrono::steady_clock::time_point fStart;
+};
+
+class PerfMonitor
+{
+public:
+  static PerfMonitor * Instance(void);
+
+  //! the counter of the given category and name (created if needed)
+  PerfCounter * Counter (const string & category, const string & name);
+
+  //! the XSecIntegrator counter of the given cross section model, named
+  //! after its integrator and itself
+  PerfCounter * IntegratorCounter (const Algorithm * xsec_model);
+
+  void     CountEvent (void)       { fNEvents++;      } ///< a generated event
+  uint64_t NEvents    (void) const { return fNEvents; }
+  double   JobTime    (void) const;                      ///< s, since the monitor was created
+
+  void Print     (ostream & stream) const;  ///< text report
+  void PrintJSON (ostream & stream) const;  ///< JSON report
+  void Report    (void);                    ///< log & write the report (once)
+
+  friend ostream & operator << (ostream & stream, const PerfMonitor & mon);
+
+private:
+  PerfMonitor();
+  PerfMonitor(const PerfMonitor & mon);
+  virtual ~PerfMonitor();
+
+  static PerfMonitor * fInstance;
+
+  map<pair<string,string>, PerfCounter> fCounters; ///< (category, name) -> counter
+  map<const Algorithm *, PerfCounter *> fIntegratorCounters; ///< xsec model -> integrator counter
+  uint64_t fNEvents;                               ///< generated events
+  bool     fReported;                              ///< report already made?
+  std::chrono::steady_clock::time_point fStart;    ///< job start
+
+  struct Cleaner {
+      void DummyMethodAndSilentCompiler() { }
+      ~Cleaner() {
+         if (PerfMonitor::fInstance !=0) {
+            delete PerfMonitor::fInstance;
+            PerfMonitor::fInstance = 0;
+         }
+      }
+  };
+  friend struct Cleaner;
+};
+
+}      // genie namespace
+
+#endif // _PERF_MONITOR_H_
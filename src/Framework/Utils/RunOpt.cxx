@@ -66,6 +66,10 @@ void RunOpt::Init(void)
   fTune = 0 ;
   fEnableBareXSecPreCalc = true;
   fCacheFile = "";
+  fMaxXSecTable = "";
+  fSharedTables = "";
+  fFluxProbTable = "";
+  fPerfReport = "";
   fMesgThresholds = "";
   fUnphysEventMask = new TBits(GHepFlags::NFlags());
 //fUnphysEventMask->ResetAllBits(true);
@@ -76,6 +80,8 @@ void RunOpt::Init(void)
   fEventRecordPrintLevel  = 3;
   fEventGeneratorList     = "Default";
   fXMLPath = "";
+  fConfigBundle = "";
+  fLazyXSecSplines = false;
 }
 //____________________________________________________________________________
 void RunOpt::SetTuneName(string tuneName)
@@ -108,10 +114,30 @@ void RunOpt::ReadFromCommandLine(int argc, char ** argv)
     fEnableBareXSecPreCalc = false;
   }
 
+  if( parser.OptionExists("lazy-xsec-splines") ) {
+    fLazyXSecSplines = true;
+  }
+
   if( parser.OptionExists("cache-file") ) {
     fCacheFile = parser.ArgAsString("cache-file");
   }
 
+  if( parser.OptionExists("max-xsec-table") ) {
+    fMaxXSecTable = parser.ArgAsString("max-xsec-table");
+  }
+
+  if( parser.OptionExists("shared-tables") ) {
+    fSharedTables = parser.ArgAsString("shared-tables");
+  }
+
+  if( parser.OptionExists("flux-prob-table") ) {
+    fFluxProbTable = parser.ArgAsString("flux-prob-table");
+  }
+
+  if( parser.OptionExists("perf-report") ) {
+    fPerfReport = parser.ArgAsString("perf-report");
+  }
+
   if( parser.OptionExists("message-thresholds") ) {
     fMesgThresholds = parser.ArgAsString("message-thresholds");
   }
@@ -133,6 +159,10 @@ void RunOpt::ReadFromCommandLine(int argc, char ** argv)
     fXMLPath = parser.ArgAsString("xml-path");
   }
 
+  if (parser.OptionExists("config-bundle")) {
+    fConfigBundle = parser.ArgAsString("config-bundle");
+  }
+
   if( parser.OptionExists("tune") ) {
     SetTuneName( parser.ArgAsString("tune") ) ;
   }
@@ -164,6 +194,7 @@ std::string RunOpt::RunOptSyntaxString(bool include_generator_specific)
     // G18_02a_00_000 is currently the default tune
     << "\n         [--tune tune_name]  // default \"" << gDefaultTune << "\" "
     << "\n         [--xml-path path]"
+    << "\n         [--config-bundle bundle_file]"
     << "\n         [--message-thresholds xml_file]";
 
   if (include_generator_specific) {
@@ -173,8 +204,13 @@ std::string RunOpt::RunOptSyntaxString(bool include_generator_specific)
       << "\n         [--event-record-print-level level]"
       << "\n         [--mc-job-status-refresh-rate rate]"
       << "\n         [--cache-file root_file]"
+      << "\n         [--max-xsec-table table_file]"
+      << "\n         [--shared-tables directory]"
+      << "\n         [--flux-prob-table emin,emax,ne,lmin,lmax,nl]"
+      << "\n         [--perf-report file_prefix]"
       << "\n         [--enable-bare-xsec-pre-calc]"
       << "\n         [--disable-bare-xsec-pre-calc]"
+      << "\n         [--lazy-xsec-splines]"
       << "\n         [--unphysical-event-mask mask]"
       << "\n";
   }
@@ -189,16 +225,25 @@ void RunOpt::Print(ostream & stream) const
   stream << "\n Event generator list: " << fEventGeneratorList;
   stream << "\n User-specified message thresholds : " << fMesgThresholds;
   stream << "\n Cache file : " << fCacheFile;
+  stream << "\n Max xsec table : " << fMaxXSecTable;
+  stream << "\n Shared tables : " << fSharedTables;
+  stream << "\n Flux mixing probability table : " << fFluxProbTable;
+  stream << "\n Performance report : " << fPerfReport;
   stream << "\n Unphysical event mask (bits: "
          << GHepFlags::NFlags()-1 << " -> 0) : " << *fUnphysEventMask;
   stream << "\n Event record print level : " << fEventRecordPrintLevel;
   stream << "\n MC job status file refresh rate: " << fMCJobStatusRefreshRate;
   stream << "\n Pre-calculate all free-nucleon cross-sections? : "
          << ((fEnableBareXSecPreCalc) ? "Yes" : "No");
+  stream << "\n Load only the needed cross-section splines? : "
+         << ((fLazyXSecSplines) ? "Yes" : "No");
 
   if (fXMLPath.size()) {
     stream << "\n XMLPath over-ride : "<<fXMLPath;
   }
+  if (fConfigBundle.size()) {
+    stream << "\n Configuration bundle : "<<fConfigBundle;
+  }
 
   stream << "\n";
 }
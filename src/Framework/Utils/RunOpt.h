@@ -46,12 +46,18 @@ public:
   TuneId * Tune                 (void) const { return fTune;                   }
   string EventGeneratorList     (void) const { return fEventGeneratorList;     }
   string CacheFile              (void) const { return fCacheFile;              }
+  string MaxXSecTable           (void) const { return fMaxXSecTable;           }
+  string SharedTables           (void) const { return fSharedTables;           }
+  string FluxProbTable          (void) const { return fFluxProbTable;          }
+  string PerfReport             (void) const { return fPerfReport;             }
   string MesgThresholdFiles     (void) const { return fMesgThresholds;         }
   TBits* UnphysEventMask        (void) const { return fUnphysEventMask;        }
   int    EventRecordPrintLevel  (void) const { return fEventRecordPrintLevel;  }
   int    MCJobStatusRefreshRate (void) const { return fMCJobStatusRefreshRate; }
   bool   BareXSecPreCalc        (void) const { return fEnableBareXSecPreCalc;  }
   string XMLPath                (void) const { return fXMLPath;  }
+  string ConfigBundle           (void) const { return fConfigBundle;  }
+  bool   LazyXSecSplines        (void) const { return fLazyXSecSplines;  }
 
   // If a user accesses the GENIE objects directly, then most of the options above
   // can be set directly to the relevant objects (Messenger, Cache, etc).
@@ -60,6 +66,7 @@ public:
   void BuildTune(); ///< build tune and inform XSecSplineList
   void SetEventGeneratorList(string evgenlist) { fEventGeneratorList = evgenlist; }
   void EnableBareXSecPreCalc(bool flag)        { fEnableBareXSecPreCalc = flag; }
+  void EnableLazyXSecSplines(bool flag)        { fLazyXSecSplines = flag; }
 
   // Print
   void   Print (ostream & stream) const;
@@ -73,6 +80,10 @@ private:
   TuneId * fTune;                    ///< GENIE comprehensive neutrino interaction model tune.
   string fEventGeneratorList;        ///< Name of event generator list to be loaded by the event generation drivers.
   string fCacheFile;                 ///< Name of cache file, is cache is to be re-used.
+  string fMaxXSecTable;              ///< Precomputed max xsec table for the kinematic generators. Higher priority than GMAXXSECTABLE
+  string fSharedTables;              ///< Directory of read-only tables shared by the jobs on a node. Higher priority than GSHAREDTABLES
+  string fFluxProbTable;             ///< Flavor mixing probability table for GFluxBlender (emin,emax,ne,lmin,lmax,nl). Higher priority than GFLUXPROBTABLE
+  string fPerfReport;                ///< Prefix of the end-of-job performance report files (.txt, .json). Higher priority than GPERFREPORT
   string fMesgThresholds;            ///< List of files (delimited with : if more than one) with custom mesg stream thresholds.
   TBits* fUnphysEventMask;           ///< Unphysical event mask.
   int    fEventRecordPrintLevel;     ///< GHEP event r ecord print level.
@@ -80,6 +91,8 @@ private:
   bool   fEnableBareXSecPreCalc;     ///< Cache calcs relevant to free-nucleon xsecs before any nuclear xsec computation?
                                      ///< The option switches on/off cacheing calculations which interfere with event reweighting.
   string fXMLPath;                   ///< An path to look for XML in. Higher priority than GXMLPATH
+  string fConfigBundle;              ///< Compiled configuration bundle to use instead of the XML files. Higher priority than GCONFIGBUNDLE
+  bool   fLazyXSecSplines;           ///< Only load the splines needed by the job's initial states, once these are known?
 
   // Self
   static RunOpt * fInstance;
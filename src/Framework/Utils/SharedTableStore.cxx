@@ -0,0 +1,248 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2023, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <algorithm>
+#include <vector>
+
+#include <dirent.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Utils/RunOpt.h"
+#include "Framework/Utils/SharedTableStore.h"
+
+using std::ostringstream;
+using std::vector;
+
+using namespace genie;
+
+//____________________________________________________________________________
+SharedTableStore * SharedTableStore::fInstance = 0;
+//____________________________________________________________________________
+SharedTableStore::SharedTableStore()
+{
+  fInstance = 0;
+
+  string dir = RunOpt::Instance()->SharedTables();
+  if(dir.size() == 0) {
+    const char * env = std::getenv("GSHAREDTABLES");
+    if(env) dir = env;
+  }
+  this->SetDirectory(dir);
+}
+//____________________________________________________________________________
+SharedTableStore::~SharedTableStore()
+{
+  vector<Mapping>::iterator it = fMappings.begin();
+  for( ; it != fMappings.end(); ++it) munmap(it->addr, it->size);
+  fMappings.clear();
+  fInstance = 0;
+}
+//____________________________________________________________________________
+SharedTableStore * SharedTableStore::Instance()
+{
+  if(fInstance == 0) {
+    static SharedTableStore::Cleaner cleaner;
+    cleaner.DummyMethodAndSilentCompiler();
+    fInstance = new SharedTableStore;
+  }
+  return fInstance;
+}
+//____________________________________________________________________________
+void SharedTableStore::SetDirectory(string dir)
+{
+  while(dir.size() > 1 && dir[dir.size()-1] == '/') dir.erase(dir.size()-1);
+  fDirectory = dir;
+  if(dir.size() == 0) return;
+
+  if(mkdir(dir.c_str(), 0777) != 0 && errno != EEXIST) {
+    LOG("SharedTables", pWARN)
+       << "Could not create shared table directory " << dir << ": "
+       << strerror(errno) << " - Tables will be loaded privately";
+    fDirectory = "";
+    return;
+  }
+  LOG("SharedTables", pNOTICE) << "Sharing read-only tables through: " << dir;
+}
+//____________________________________________________________________________
+string SharedTableStore::Acquire(
+  const string & name, uint64_t hash, SharedTableBuilder_t build, bool & built)
+{
+  built = false;
+  if(!this->IsEnabled()) return "";
+
+  // tag the table with its inputs and with the job configuration
+  ostringstream tag;
+  tag << name << "-" << std::hex << hash;
+  uint64_t key = Hash(tag.str(), this->ConfigHash());
+
+  ostringstream base;
+  base << fDirectory << "/" << name << "-" << std::hex << key;
+  string filename = base.str() + ".bin";
+  string lockname = base.str() + ".lock";
+
+  if(access(filename.c_str(), R_OK) == 0) return filename;
+
+  // only one process builds a table: the others wait on the lock and find
+  // the finished file when they get it
+  int lfd = open(lockname.c_str(), O_RDWR | O_CREAT, 0666);
+  if(lfd < 0) {
+    LOG("SharedTables", pWARN)
+       << "Could not open " << lockname << ": " << strerror(errno);
+    return "";
+  }
+  while(flock(lfd, LOCK_EX) != 0) {
+    if(errno != EINTR) {
+      LOG("SharedTables", pWARN)
+         << "Could not lock " << lockname << ": " << strerror(errno);
+      close(lfd);
+      return "";
+    }
+  }
+
+  bool ok = (access(filename.c_str(), R_OK) == 0);
+  if(!ok) {
+    LOG("SharedTables", pNOTICE) << "Building shared table: " << filename;
+
+    // write aside and rename, so that a table is either complete or absent
+    ostringstream tmpname;
+    tmpname << filename << ".tmp." << getpid();
+    built = true;
+    ok = build(tmpname.str()) &&
+         rename(tmpname.str().c_str(), filename.c_str()) == 0;
+    if(!ok) {
+      unlink(tmpname.str().c_str());
+      LOG("SharedTables", pWARN)
+         << "Could not build shared table: " << filename;
+    }
+  }
+
+  flock(lfd, LOCK_UN);
+  close(lfd);
+
+  return (ok) ? filename : "";
+}
+//____________________________________________________________________________
+const void * SharedTableStore::Map(const string & filename, size_t & size)
+{
+  size = 0;
+  int fd = open(filename.c_str(), O_RDONLY);
+  if(fd < 0) return 0;
+  struct stat st;
+  if(fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return 0;
+  }
+  void * addr = mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(addr == MAP_FAILED) return 0;
+
+  Mapping m;
+  m.addr = addr;
+  m.size = st.st_size;
+  fMappings.push_back(m);
+
+  size = m.size;
+  return addr;
+}
+//____________________________________________________________________________
+void SharedTableStore::Discard(const string & filename)
+{
+  LOG("SharedTables", pWARN) << "Discarding invalid shared table: " << filename;
+  unlink(filename.c_str());
+}
+//____________________________________________________________________________
+uint64_t SharedTableStore::Hash(const string & s, uint64_t seed)
+{
+// 64-bit FNV-1a
+
+  uint64_t h = seed;
+  for(unsigned int i = 0; i < s.size(); i++) {
+    h ^= (unsigned char) s[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+//____________________________________________________________________________
+uint64_t SharedTableStore::HashFile(const string & filename, uint64_t seed)
+{
+// Identify a file without reading it: a modified file gets a new hash
+
+  ostringstream id;
+  id << filename;
+  struct stat st;
+  if(stat(filename.c_str(), &st) == 0) {
+    id << ":" << st.st_size << ":" << st.st_mtime;
+  }
+  return Hash(id.str(), seed);
+}
+//____________________________________________________________________________
+uint64_t SharedTableStore::HashDir(const string & dirname, uint64_t seed)
+{
+// Identify a directory tree by its files: editing, adding or removing a file
+// at any depth gets a new hash (a directory's own time stamp only changes
+// when entries are added or removed, not when a file is edited in place)
+
+  vector<string> entries;
+  DIR * dir = opendir(dirname.c_str());
+  if(!dir) return HashFile(dirname, seed);
+  struct dirent * entry = 0;
+  while((entry = readdir(dir)) != 0) {
+    string name = entry->d_name;
+    if(name == "." || name == "..") continue;
+    entries.push_back(name);
+  }
+  closedir(dir);
+
+  // readdir order depends on the file system
+  std::sort(entries.begin(), entries.end());
+
+  uint64_t h = Hash(dirname, seed);
+  for(unsigned int i = 0; i < entries.size(); i++) {
+    string path = dirname + "/" + entries[i];
+    struct stat st;
+    if(stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+      h = HashDir(path, h);
+    } else {
+      h = HashFile(path, h);
+    }
+  }
+  return h;
+}
+//____________________________________________________________________________
+uint64_t SharedTableStore::ConfigHash(void) const
+{
+  RunOpt * opt = RunOpt::Instance();
+
+  uint64_t h = kHashSeed;
+  if(opt->Tune()) h = Hash(opt->Tune()->Name(), h);
+
+  string bundle = opt->ConfigBundle();
+  if(bundle.size() == 0 && std::getenv("GCONFIGBUNDLE")) {
+    bundle = std::getenv("GCONFIGBUNDLE");
+  }
+  if(bundle.size() > 0) h = HashFile(bundle, h);
+
+  string xmlpath = opt->XMLPath();
+  if(xmlpath.size() == 0 && std::getenv("GXMLPATH")) {
+    xmlpath = std::getenv("GXMLPATH");
+  }
+  h = Hash(xmlpath, h);
+
+  return h;
+}
+//____________________________________________________________________________
@@ -0,0 +1,105 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::SharedTableStore
+
+\brief    Singleton managing read-only tables shared by all GENIE processes
+          on a node (cross section splines, INTRANUKE hadron data, hadron
+          tensors, ...).
+
+          The store is a directory, ideally on tmpfs (eg /dev/shm/genie),
+          given with --shared-tables or, otherwise, with $GSHAREDTABLES. It
+          is off unless one of them is set. Each table is a binary file
+          named after the table and a hash of its inputs and of the job
+          configuration (tune, configuration bundle, XML path). The first
+          process needing a table builds it under a file lock while others
+          wait, then every process maps the same file, so the data are held
+          in memory once per node instead of once per process. A table whose
+          file cannot be made or read is loaded privately, as without store.
+
+\author   GENIE Collaboration
+
+\created  October 16, 2026
+
+\cpright  Copyright (c) 2003-2023, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#ifndef _SHARED_TABLE_STORE_H_
+#define _SHARED_TABLE_STORE_H_
+
+#include <string>
+#include <vector>
+#include <functional>
+
+#include <stdint.h>
+
+using std::string;
+using std::vector;
+
+namespace genie {
+
+//! writes a table to the file it is given; returns false on failure
+typedef std::function<bool (const string & filename)> SharedTableBuilder_t;
+
+class SharedTableStore
+{
+public:
+  static SharedTableStore * Instance(void);
+
+  bool   IsEnabled    (void) const { return fDirectory.size() > 0; }
+  string Directory    (void) const { return fDirectory; }
+  void   SetDirectory (string dir); ///< "" disables the store
+
+  //! path of the shared file of table `name` built from inputs with hash
+  //! `hash`. If no process has made it yet, it is made here by calling
+  //! `build` (and `built` is set). Returns "" if the store is disabled or
+  //! the file could not be made: the caller then loads its table privately.
+  string Acquire (const string & name, uint64_t hash,
+                  SharedTableBuilder_t build, bool & built);
+
+  //! map a shared file read-only, for as long as the store lives
+  const void * Map (const string & filename, size_t & size);
+
+  //! remove a shared file found to be invalid, so that it gets rebuilt
+  void   Discard (const string & filename);
+
+  //! hashes used to version the tables
+  static uint64_t Hash       (const string & s, uint64_t seed = kHashSeed);
+  static uint64_t HashFile   (const string & filename, uint64_t seed = kHashSeed); ///< name, size & time stamp
+  static uint64_t HashDir    (const string & dirname,  uint64_t seed = kHashSeed); ///< HashFile of every file below dirname
+  uint64_t        ConfigHash (void) const;
+
+  static const uint64_t kHashSeed = 14695981039346656037ULL; ///< FNV-1a offset basis
+
+private:
+  SharedTableStore();
+  SharedTableStore(const SharedTableStore & store);
+  virtual ~SharedTableStore();
+
+  static SharedTableStore * fInstance;
+
+  string fDirectory;           ///< store directory ("" if disabled)
+
+  struct Mapping {
+    void * addr;
+    size_t size;
+  };
+  vector<Mapping> fMappings;   ///< files mapped with Map()
+
+  struct Cleaner {
+      void DummyMethodAndSilentCompiler() { }
+      ~Cleaner() {
+         if (SharedTableStore::fInstance !=0) {
+            delete SharedTableStore::fInstance;
+            SharedTableStore::fInstance = 0;
+         }
+      }
+  };
+  friend struct Cleaner;
+};
+
+}      // genie namespace
+
+#endif // _SHARED_TABLE_STORE_H_
@@ -0,0 +1,245 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2023, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#include <cstdio>
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+#include <TSystem.h>
+
+#include "Framework/Algorithm/Algorithm.h"
+#include "Framework/EventGen/XSecAlgorithmI.h"
+#include "Framework/Interaction/Interaction.h"
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Numerical/Spline.h"
+#include "Framework/Registry/Registry.h"
+#include "Framework/Utils/XSecKnotStore.h"
+
+using std::ostringstream;
+using std::ifstream;
+using std::setprecision;
+using std::vector;
+
+using namespace genie;
+
+namespace {
+  // FNV-1a, 64 bit
+  string HashString(const string & text)
+  {
+    unsigned long long h = 14695981039346656037ULL;
+    for(string::size_type i = 0; i < text.size(); i++) {
+      h ^= (unsigned char) text[i];
+      h *= 1099511628211ULL;
+    }
+    char buf[17];
+    snprintf(buf, sizeof(buf), "%016llx", h);
+    return string(buf);
+  }
+
+  // Knots read back from XML files are stored with limited precision, so
+  // energies are matched within a small tolerance
+  bool SameEnergy(double E1, double E2)
+  {
+    double d = E1 - E2;
+    if(d < 0) d = -d;
+    double E = (E1 > 0) ? E1 : -E1;
+    return (d <= 1E-5 || d <= 1E-7*E);
+  }
+}
+
+//____________________________________________________________________________
+XSecKnotStore::XSecKnotStore(string directory) :
+fDirectory(directory),
+fNHits(0),
+fNMisses(0)
+{
+  if(fDirectory.size() > 0) {
+    if(gSystem->AccessPathName(fDirectory.c_str())) {
+      if(gSystem->mkdir(fDirectory.c_str(), true) != 0) {
+        LOG("XSecKnotStore", pERROR)
+          << "Could not create knot store directory: " << fDirectory
+          << " - Computed knots will only be kept in memory";
+        fDirectory = "";
+      }
+    }
+  }
+}
+//____________________________________________________________________________
+XSecKnotStore::~XSecKnotStore()
+{
+  if(fNHits + fNMisses > 0) {
+    LOG("XSecKnotStore", pNOTICE)
+      << "Knot store: " << fNHits << " cross sections reused, "
+      << fNMisses << " computed";
+  }
+}
+//____________________________________________________________________________
+string XSecKnotStore::Address(
+  const XSecAlgorithmI * alg, const Interaction * interaction) const
+{
+  string text;
+  set<string> visited;
+  ConfigText(alg, text, visited);
+  text += "\ninteraction: ";
+  text += interaction->AsString();
+  return HashString(text);
+}
+//____________________________________________________________________________
+bool XSecKnotStore::Get(const string & address, double E, double & xsec)
+{
+  KnotMap_t & knots = this->Knots(address);
+
+  // check the closest stored energies on either side
+  KnotMap_t::const_iterator it = knots.lower_bound(E);
+  if(it != knots.end() && SameEnergy(it->first, E)) {
+    xsec = it->second;
+    fNHits++;
+    return true;
+  }
+  if(it != knots.begin()) {
+    --it;
+    if(SameEnergy(it->first, E)) {
+      xsec = it->second;
+      fNHits++;
+      return true;
+    }
+  }
+  fNMisses++;
+  return false;
+}
+//____________________________________________________________________________
+void XSecKnotStore::Put(const string & address, double E, double xsec)
+{
+  KnotMap_t & knots = this->Knots(address);
+  knots[E] = xsec;
+
+  if(fDirectory.size() == 0) return;
+
+  // Append a single line; concurrent jobs may append to the same file
+  char line[64];
+  int n = snprintf(line, sizeof(line), "%.17g %.17g\n", E, xsec);
+  FILE * f = fopen(this->FileName(address).c_str(), "a");
+  if(!f) {
+    LOG("XSecKnotStore", pWARN)
+      << "Could not write to: " << this->FileName(address);
+    return;
+  }
+  fwrite(line, 1, n, f);
+  fclose(f);
+}
+//____________________________________________________________________________
+void XSecKnotStore::Seed(const string & address, const Spline & spline)
+{
+  KnotMap_t & knots = this->Knots(address);
+  for(int i = 0; i < spline.NKnots(); i++) {
+    double E = 0, xsec = 0;
+    spline.GetKnot(i, E, xsec);
+    if(knots.find(E) == knots.end()) knots[E] = xsec;
+  }
+}
+//____________________________________________________________________________
+void XSecKnotStore::Energies(
+  const string & address, double emin, double emax, vector<double> & E)
+{
+  E.clear();
+  KnotMap_t & knots = this->Knots(address);
+  KnotMap_t::const_iterator it = knots.begin();
+  for( ; it != knots.end(); ++it) {
+    double Ek = it->first;
+    bool inrange =
+      (Ek >= emin || SameEnergy(Ek, emin)) && (Ek <= emax || SameEnergy(Ek, emax));
+    if(!inrange) continue;
+    if(E.size() > 0 && SameEnergy(E.back(), Ek)) continue;
+    E.push_back(Ek);
+  }
+}
+//____________________________________________________________________________
+XSecKnotStore::KnotMap_t & XSecKnotStore::Knots(const string & address)
+{
+  map<string, KnotMap_t>::iterator it = fKnots.find(address);
+  if(it != fKnots.end()) return it->second;
+
+  KnotMap_t & knots = fKnots[address];
+  if(fDirectory.size() == 0) return knots;
+
+  ifstream in(this->FileName(address).c_str());
+  if(!in.good()) return knots;
+
+  double E = 0, xsec = 0;
+  while(in >> E >> xsec) {
+    knots[E] = xsec;
+  }
+  LOG("XSecKnotStore", pINFO)
+    << "Read " << knots.size() << " stored knots for " << address;
+
+  return knots;
+}
+//____________________________________________________________________________
+string XSecKnotStore::FileName(const string & address) const
+{
+  return fDirectory + "/" + address + ".knots";
+}
+//____________________________________________________________________________
+string XSecKnotStore::ConfigHash(const Algorithm * alg)
+{
+  string text;
+  set<string> visited;
+  ConfigText(alg, text, visited);
+  return HashString(text);
+}
+//____________________________________________________________________________
+void XSecKnotStore::ConfigText(
+  const Algorithm * alg, string & text, set<string> & visited)
+{
+// Canonical text form of the algorithm configuration: every registry item
+// (in key order) with full precision doubles, followed by the configuration
+// of each sub-algorithm
+
+  if(!alg) return;
+
+  string id = alg->Id().Key();
+  if(visited.count(id)) return;
+  visited.insert(id);
+
+  ostringstream os;
+  os << setprecision(17);
+  os << "[" << id << "]\n";
+
+  const Registry & config = alg->GetConfig();
+  const RgIMap & items = config.GetItemMap();
+
+  vector<string> subalgs;
+  RgIMapConstIter it = items.begin();
+  for( ; it != items.end(); ++it) {
+    const RgKey & key = it->first;
+    RgType_t type = config.ItemType(key);
+    os << key << " = ";
+    switch(type) {
+      case (kRgBool) : os << config.GetBool  (key); break;
+      case (kRgInt)  : os << config.GetInt   (key); break;
+      case (kRgDbl)  : os << config.GetDouble(key); break;
+      case (kRgStr)  : os << config.GetString(key); break;
+      case (kRgAlg)  :
+        os << config.GetAlg(key);
+        subalgs.push_back(key);
+        break;
+      default:
+        if(it->second) it->second->Print(os);
+        break;
+    }
+    os << "\n";
+  }
+  text += os.str();
+
+  vector<string>::const_iterator sit = subalgs.begin();
+  for( ; sit != subalgs.end(); ++sit) {
+    ConfigText(alg->SubAlg(*sit), text, visited);
+  }
+}
+//____________________________________________________________________________
@@ -0,0 +1,98 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::XSecKnotStore
+
+\brief    Content-addressed store of computed cross section spline knots.
+
+          Every (E, xsec) point computed while building a spline is kept
+          under an address derived from a hash of the full configuration of
+          the cross section algorithm (including its sub-algorithms) and of
+          the interaction. Building a spline for the same algorithm
+          configuration and interaction again (eg with an extended energy
+          range, more knots or in a later tune iteration that did not touch
+          that model) only computes the points that are not already stored.
+          Any change in the algorithm configuration changes the address, so
+          stale values are never reused.
+
+          The store can optionally be backed by a directory: each address is
+          kept in its own small text file, which is appended to as new
+          points are computed, so the store can be shared between jobs.
+
+\author   GENIE Collaboration
+
+\created  October 16, 2026
+
+\cpright  Copyright (c) 2003-2023, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+
+*/
+//____________________________________________________________________________
+
+#ifndef _XSEC_KNOT_STORE_H_
+#define _XSEC_KNOT_STORE_H_
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using std::map;
+using std::set;
+using std::string;
+using std::vector;
+
+namespace genie {
+
+class Algorithm;
+class XSecAlgorithmI;
+class Interaction;
+class Spline;
+
+class XSecKnotStore {
+
+public:
+  XSecKnotStore(string directory = "");
+ ~XSecKnotStore();
+
+  //! Address of the knots for the input algorithm configuration & interaction
+  string Address (const XSecAlgorithmI * alg, const Interaction * i) const;
+
+  //! Look-up a stored cross section at energy E
+  bool   Get     (const string & address, double E, double & xsec);
+
+  //! Store a computed cross section at energy E (written through to disk)
+  void   Put     (const string & address, double E, double xsec);
+
+  //! Add the knots of an existing spline (in memory only, not written out)
+  void   Seed    (const string & address, const Spline & spline);
+
+  //! Sorted energies of the stored knots in [emin, emax] (near-duplicates,
+  //! eg a knot read back from XML and recomputed, are listed once)
+  void   Energies (const string & address, double emin, double emax, vector<double> & E);
+
+  //! Hash of the full configuration of an algorithm and its sub-algorithms
+  static string ConfigHash (const Algorithm * alg);
+
+  const string & Directory (void) const { return fDirectory; }
+  int            NHits     (void) const { return fNHits;     }
+  int            NMisses   (void) const { return fNMisses;   }
+
+private:
+
+  typedef map<double, double> KnotMap_t;
+
+  KnotMap_t & Knots    (const string & address);
+  string      FileName (const string & address) const;
+
+  static void ConfigText (const Algorithm * alg, string & text, set<string> & visited);
+
+  string                   fDirectory; ///< backing directory, empty for an in-memory store
+  map<string, KnotMap_t>   fKnots;     ///< address -> { E -> xsec }
+  int                      fNHits;     ///< number of look-ups served from the store
+  int                      fNMisses;   ///< number of look-ups that required a computation
+};
+
+}      // genie namespace
+
+#endif // _XSEC_KNOT_STORE_H_
@@ -14,7 +14,17 @@
 #include <chrono>
 
 #include <fstream>
+#include <sstream>
 #include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <iterator>
+
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "libxml/parser.h"
 #include "libxml/xmlmemory.h"
@@ -28,8 +38,13 @@
 #include "Framework/Conventions/GBuild.h"
 #include "Framework/Messenger/Messenger.h"
 #include "Framework/Numerical/Spline.h"
+#include "Framework/ParticleData/PDGCodeList.h"
+#include "Framework/ParticleData/PDGCodes.h"
 #include "Framework/Utils/StringUtils.h"
+#include "Framework/Utils/PerfMonitor.h"
 #include "Framework/Utils/PrintUtils.h"
+#include "Framework/Utils/SharedTableStore.h"
+#include "Framework/Utils/XSecKnotStore.h"
 #include "Framework/Utils/XSecSplineList.h"
 #include "Framework/Utils/XmlParserUtils.h"
 
@@ -40,6 +55,180 @@ namespace genie {
 
   using namespace std::chrono ;
 
+//____________________________________________________________________________
+// Binary spline file layout (all integers little-endian, as written by the
+// host; a file written on a host of different endianness fails the magic
+// word check and is rejected):
+//
+//   BinSplHeader                                 (fixed size)
+//   BinSplEntry[nentries]                        (sorted by tune, then key)
+//   char  strings[strings_size]                  (tune names and keys)
+//   double knots[...]                            (per entry: E[n], xsec[n])
+//
+// The knot block is 8-byte aligned so it can be used in-place.
+//
+namespace {
+
+  const char     kBinSplMagic[8] = { 'G','X','S','P','L','B','I','N' };
+  const uint32_t kBinSplVersion  = 1;
+
+  struct BinSplHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t uselog;
+    uint64_t nentries;
+    uint64_t index_offset;
+    uint64_t strings_offset;
+    uint64_t strings_size;
+    uint64_t knots_offset;
+    uint64_t nknots_total;
+  };
+
+  struct BinSplEntry {
+    uint32_t tune_offset;
+    uint32_t tune_length;
+    uint32_t key_offset;
+    uint32_t key_length;
+    uint64_t knots_offset; ///< in units of double, from the start of the knot block
+    uint32_t nknots;
+    uint32_t reserved;
+  };
+
+  int CompareBinSplEntry(
+    const BinSplEntry & e, const char * strings,
+    const string & tune, const string & key)
+  {
+    int c = tune.compare(0, string::npos, strings + e.tune_offset, e.tune_length);
+    if(c != 0) return -c;
+    c = key.compare(0, string::npos, strings + e.key_offset, e.key_length);
+    return -c;
+  }
+
+  // Header & index checks made when a binary file is mapped: every block must
+  // lie within the file, every entry must point within the string & knot
+  // blocks, and entries must be sorted for the look-ups. Sizes are compared
+  // so that corrupt values cannot overflow the offset arithmetic.
+  bool ValidBinSplFile(const BinSplHeader * h, size_t size, string & reason)
+  {
+    if(memcmp(h->magic, kBinSplMagic, sizeof(kBinSplMagic)) != 0) {
+      reason = "bad magic word"; return false;
+    }
+    if(h->version != kBinSplVersion) {
+      reason = "unsupported format version"; return false;
+    }
+    if(h->index_offset > size ||
+       h->nentries > (size - h->index_offset) / sizeof(BinSplEntry)) {
+      reason = "index block beyond the end of file"; return false;
+    }
+    if(h->strings_offset > size || h->strings_size > size - h->strings_offset) {
+      reason = "string block beyond the end of file"; return false;
+    }
+    if(h->knots_offset > size || h->knots_offset % sizeof(double) != 0 ||
+       h->nknots_total > (size - h->knots_offset) / sizeof(double)) {
+      reason = "knot block misaligned or beyond the end of file"; return false;
+    }
+
+    const char *        base    = (const char *) h;
+    const BinSplEntry * index   = (const BinSplEntry *) (base + h->index_offset);
+    const char *        strings = base + h->strings_offset;
+    for(uint64_t ie = 0; ie < h->nentries; ie++) {
+      const BinSplEntry & e = index[ie];
+      std::ostringstream entry;
+      entry << "entry " << ie << ": ";
+      if(e.tune_offset > h->strings_size ||
+         e.tune_length > h->strings_size - e.tune_offset) {
+        reason = entry.str() + "tune name beyond the string block"; return false;
+      }
+      if(e.key_offset > h->strings_size ||
+         e.key_length > h->strings_size - e.key_offset) {
+        reason = entry.str() + "key beyond the string block"; return false;
+      }
+      if(e.nknots < 2 || e.knots_offset > h->nknots_total ||
+         2*(uint64_t)e.nknots > h->nknots_total - e.knots_offset) {
+        reason = entry.str() + "knots beyond the knot block"; return false;
+      }
+      if(ie > 0) {
+        const BinSplEntry & p = index[ie-1];
+        string tune(strings + e.tune_offset, e.tune_length);
+        string key (strings + e.key_offset,  e.key_length);
+        if(CompareBinSplEntry(p, strings, tune, key) >= 0) {
+          reason = entry.str() + "entries not sorted"; return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  // Is the requested knot E[i] covered by one of the stored knots, ie is one
+  // of them within half the requested spacing around it? The threshold knot
+  // (exact) is only covered by a stored knot at the same energy
+  bool KnotCovered(
+    const vector<double> & E, int i, bool exact, const vector<double> & Estored)
+  {
+    int n = E.size();
+    double h = -1;
+    if(i > 0)   h = E[i] - E[i-1];
+    if(i < n-1) h = (h < 0) ? E[i+1] - E[i] : TMath::Min(h, E[i+1] - E[i]);
+    double tol = 1E-7 * TMath::Abs(E[i]) + 1E-5;
+    if(!exact && h > 0) tol = TMath::Max(tol, 0.5 * h);
+
+    vector<double>::const_iterator it =
+              std::lower_bound(Estored.begin(), Estored.end(), E[i]);
+    if(it != Estored.end() && *it - E[i] <= tol) return true;
+    if(it != Estored.begin() && E[i] - *(it-1) <= tol) return true;
+    return false;
+  }
+
+} // anonymous namespace
+
+//____________________________________________________________________________
+struct XSecSplineList::BinaryFile {
+
+  string               filename;
+  void *               addr;
+  size_t               size;
+  const BinSplHeader * header;
+  const BinSplEntry  * index;
+  const char *         strings;
+  const double *       knots;
+
+  // Binary search of the sorted index; returns 0 if the spline is not in the file
+  const BinSplEntry * Find(const string & tune, const string & key) const
+  {
+    uint64_t lo = 0, hi = header->nentries;
+    while(lo < hi) {
+      uint64_t mid = lo + (hi-lo)/2;
+      int c = CompareBinSplEntry(index[mid], strings, tune, key);
+      if      (c < 0) lo = mid+1;
+      else if (c > 0) hi = mid;
+      else return &index[mid];
+    }
+    return 0;
+  }
+  // Range [first,last) of index entries belonging to the input tune
+  void TuneRange(const string & tune, uint64_t & first, uint64_t & last) const
+  {
+    uint64_t lo = 0, hi = header->nentries;
+    while(lo < hi) {
+      uint64_t mid = lo + (hi-lo)/2;
+      const BinSplEntry & e = index[mid];
+      if(tune.compare(0, string::npos, strings + e.tune_offset, e.tune_length) > 0) lo = mid+1;
+      else hi = mid;
+    }
+    first = lo;
+    hi = header->nentries;
+    while(lo < hi) {
+      uint64_t mid = lo + (hi-lo)/2;
+      const BinSplEntry & e = index[mid];
+      if(tune.compare(0, string::npos, strings + e.tune_offset, e.tune_length) >= 0) lo = mid+1;
+      else hi = mid;
+    }
+    last = lo;
+  }
+  string Tune (const BinSplEntry & e) const { return string(strings + e.tune_offset, e.tune_length); }
+  string Key  (const BinSplEntry & e) const { return string(strings + e.key_offset,  e.key_length ); }
+};
+
 //____________________________________________________________________________
 ostream & operator << (ostream & stream, const XSecSplineList & list)
 {
@@ -57,6 +246,12 @@ XSecSplineList::XSecSplineList()
   fNKnots      = 100;
   fEmin        =   0.01; // GeV
   fEmax        = 100.00; // GeV
+  fCurrentTuneOnly = false;
+  fAdaptiveKnots   = false;
+  fAdaptiveTol     = 0.005;
+  fIncremental     = false;
+  fKnotStore       = 0;
+  fGeneration      = 0;
 }
 //____________________________________________________________________________
 XSecSplineList::~XSecSplineList()
@@ -76,6 +271,9 @@ XSecSplineList::~XSecSplineList()
     spl_map_curr_tune.clear();
   }
   fSplineMap.clear();
+  this->CloseBinaryFiles();
+  if(fKnotStore) delete fKnotStore;
+  fKnotStore = 0;
   fInstance = 0;
 }
 //____________________________________________________________________________
@@ -92,11 +290,10 @@ XSecSplineList * XSecSplineList::Instance()
 bool XSecSplineList::SplineExists(
             const XSecAlgorithmI * alg, const Interaction * interaction) const
 {
-  string key = this->BuildSplineKey(alg,interaction);
-  return this->SplineExists(key);
+  return this->SplineExists(this->SplineKey(alg,interaction));
 }
 //____________________________________________________________________________
-bool XSecSplineList::SplineExists(string key) const
+bool XSecSplineList::SplineExists(const string & key) const
 {
 
   if ( fCurrentTune.size() == 0 ) {
@@ -107,15 +304,21 @@ bool XSecSplineList::SplineExists(string key) const
   SLOG("XSecSplLst", pDEBUG)
     << "Checking for spline: " << key << " in tune: " << fCurrentTune;
 
-  map<string,  map<string, Spline *> >::const_iterator //
-  mm_iter = fSplineMap.find(fCurrentTune);
-  if(mm_iter == fSplineMap.end()) {
+  if(!this->HasSplineFromTune(fCurrentTune)) {
     SLOG("XSecSplLst", pWARN)
        << "No splines for tune " << fCurrentTune << " were found!";
     return false;
   }
-  const map<string, Spline *> & spl_map_curr_tune = mm_iter->second;
-  bool exists = (spl_map_curr_tune.count(key) == 1);
+  bool exists = false;
+  map<string,  map<string, Spline *> >::const_iterator //
+  mm_iter = fSplineMap.find(fCurrentTune);
+  if(mm_iter != fSplineMap.end()) {
+    const map<string, Spline *> & spl_map_curr_tune = mm_iter->second;
+    exists = (spl_map_curr_tune.count(key) == 1);
+  }
+  for(unsigned int ib = 0; !exists && ib < fBinaryFiles.size(); ib++) {
+    exists = (fBinaryFiles[ib]->Find(fCurrentTune, key) != 0);
+  }
   SLOG("XSecSplLst", pDEBUG)
     << "Spline found?...." << utils::print::BoolAsYNString(exists);
   return exists;
@@ -124,11 +327,10 @@ bool XSecSplineList::SplineExists(string key) const
 const Spline * XSecSplineList::GetSpline(
             const XSecAlgorithmI * alg, const Interaction * interaction) const
 {
-  string key = this->BuildSplineKey(alg,interaction);
-  return this->GetSpline(key);
+  return this->GetSpline(this->SplineKey(alg,interaction));
 }
 //____________________________________________________________________________
-const Spline * XSecSplineList::GetSpline(string key) const
+const Spline * XSecSplineList::GetSpline(const string & key) const
 {
 
   if ( fCurrentTune.size() == 0 ) {
@@ -139,22 +341,28 @@ const Spline * XSecSplineList::GetSpline(string key) const
   SLOG("XSecSplLst", pDEBUG)
     << "Getting spline: " << key << " in tune: " << fCurrentTune;
 
-  map<string,  map<string, Spline *> >::const_iterator //\/
-  mm_iter = fSplineMap.find(fCurrentTune);
-  if(mm_iter == fSplineMap.end()) {
+  if(!this->HasSplineFromTune(fCurrentTune)) {
     SLOG("XSecSplLst", pWARN)
        << "No splines for tune " << fCurrentTune << " were found!";
     return 0;
   }
-  const map<string, Spline *> & spl_map_curr_tune = mm_iter->second;
-  map<string, Spline *>::const_iterator //\/
-  m_iter = spl_map_curr_tune.find(key);
-  if(m_iter == spl_map_curr_tune.end()) {
+  map<string,  map<string, Spline *> >::const_iterator //\/
+  mm_iter = fSplineMap.find(fCurrentTune);
+  if(mm_iter != fSplineMap.end()) {
+    const map<string, Spline *> & spl_map_curr_tune = mm_iter->second;
+    map<string, Spline *>::const_iterator //\/
+    m_iter = spl_map_curr_tune.find(key);
+    if(m_iter != spl_map_curr_tune.end()) return m_iter->second;
+  }
+
+  // not built yet - look it up in the memory-mapped binary files
+  Spline * spline = this->MaterializeSpline(fCurrentTune, key);
+  if(!spline) {
     SLOG("XSecSplLst", pWARN)
       << "Couldn't find spline: " << key << " in tune: " << fCurrentTune;
     return 0;
   }
-  return m_iter->second;
+  return spline;
 }
 //____________________________________________________________________________
 void XSecSplineList::CreateSpline(const XSecAlgorithmI * alg,
@@ -176,6 +384,19 @@ void XSecSplineList::CreateSpline(const XSecAlgorithmI * alg,
 
   string key = this->BuildSplineKey(alg,interaction);
 
+  // Points already computed for this algorithm configuration and interaction
+  // (and, in incremental mode, the knots of the spline being replaced) are
+  // taken from the knot store
+  fKnotAddress = "";
+  const Spline * existing = 0;
+  if(fKnotStore) {
+    fKnotAddress = fKnotStore->Address(alg, interaction);
+    if(fIncremental) {
+      existing = this->GetSpline(key);
+      if(existing) fKnotStore->Seed(fKnotAddress, *existing);
+    }
+  }
+
   // If any of the nknots,e_min,e_max was not set or its value is not acceptable
   // use the list values
   //
@@ -215,56 +436,78 @@ void XSecSplineList::CreateSpline(const XSecAlgorithmI * alg,
   for(int i=0; i<nkb; i++) {
      E[i] = e_min + i*dEb;
   }
-  // knots >= energy threshold
   double E0  = TMath::Max(Ethr,e_min);
-  double dEa = 0;
-  if(this->UseLogE())
-    dEa = (TMath::Log10(e_max) - TMath::Log10(E0)) /(nka-1);
-  else
-    dEa = (e_max-E0) /(nka-1);
-
-  for(int i=0; i<nka; i++) {
-     if(this->UseLogE())
-       E[i+nkb] = TMath::Power(10., TMath::Log10(E0) + i * dEa);
-     else
-       E[i+nkb] = E0 + i * dEa;
-  }
-  // force last point to avoid floating point cumulative slew
-  E[nknots-1] = e_max;
-
-  // Compute cross sections for the input interaction at the selected
-  // set of energies
-  //
-  double pr_mass = interaction->InitStatePtr()->Probe()->Mass();
-  for (int i = 0; i < nknots; i++) {
-    TLorentzVector p4(0,0,E[i],E[i]);
-    if (pr_mass > 0.) {
-      double pz = TMath::Max(0.,E[i]*E[i] - pr_mass*pr_mass);
-      pz = TMath::Sqrt(pz);
-      p4.SetPz(pz);
-    }
-    interaction->InitStatePtr()->SetProbeP4(p4);
-
-    steady_clock::time_point start = steady_clock::now();
-
-    xsec[i] = alg->Integral(interaction);
-
-    steady_clock::time_point end = steady_clock::now();
-
-    duration<double> time_span = duration_cast<duration<double>>(end - start);
 
+  if(fAdaptiveKnots) {
+    // Start from a coarse grid above threshold and refine it where needed
+    // (see PlaceKnots); nknots is used as the maximum number of knots
+    E.resize(nkb);
+    xsec.resize(nkb);
+    for(int i=0; i<nkb; i++) {
+      xsec[i] = this->KnotXSec(alg, interaction, E[i]);
+    }
+    double err = this->PlaceKnots(alg, interaction, E0, e_max, nka, E, xsec);
+    nknots = E.size();
     SLOG("XSecSplLst", pNOTICE)
-                       << "xsec(E = " << E[i] << ") =  "
-                       << (1E+38/units::cm2)*xsec[i] << " x 1E-38 cm^2, evaluated in " << time_span.count() << " s";
-    if ( std::isnan(xsec[i]) ) {
-      // this sometimes happens near threshold, warn and move on
-      SLOG("XSecSplLst", pWARN)
-                       << "xsec(E = " << E[i] << ") =  "
-                       << (1E+38/units::cm2)*xsec[i] << " x 1E-38 cm^2"
-                       << " : converting NaN to 0.0";
-      xsec[i] = 0.0;
+      << "Adaptive knot placement for " << key << ": " << nknots
+      << " knots, estimated max. relative"
+      << " interpolation error = " << err
+      << " (tolerance = " << fAdaptiveTol << ")";
+    fKnotErrors[key] = err;
+  }
+  else {
+    // knots >= energy threshold
+    double dEa = 0;
+    if(this->UseLogE())
+      dEa = (TMath::Log10(e_max) - TMath::Log10(E0)) /(nka-1);
+    else
+      dEa = (e_max-E0) /(nka-1);
+
+    for(int i=0; i<nka; i++) {
+       if(this->UseLogE())
+         E[i+nkb] = TMath::Power(10., TMath::Log10(E0) + i * dEa);
+       else
+         E[i+nkb] = E0 + i * dEa;
+    }
+    // force last point to avoid floating point cumulative slew
+    E[nknots-1] = e_max;
+
+    // In incremental mode the spline is built on the knots already in the
+    // store, adding only the requested energies they don't cover (eg beyond
+    // the previous energy range, or between them if more knots are asked
+    // for). An existing spline is kept as it is if nothing is to be added
+    if(fIncremental && fKnotStore) {
+      vector<double> Estored;
+      fKnotStore->Energies(fKnotAddress, e_min, e_max, Estored);
+      if(Estored.size() > 1) {
+        vector<double> Eadd;
+        for(int i = 0; i < nknots; i++) {
+          if(!KnotCovered(E, i, (i == nkb && nkb > 0), Estored)) {
+            Eadd.push_back(E[i]);
+          }
+        }
+        if(existing && Eadd.size() == 0) {
+          SLOG("XSecSplLst", pNOTICE)
+            << "No new knots requested for " << key << " - Keeping the existing spline";
+          return;
+        }
+        SLOG("XSecSplLst", pNOTICE)
+          << "Incremental build of " << key << ": " << Estored.size()
+          << " stored knots, " << Eadd.size() << " new";
+        E.clear();
+        std::merge(Estored.begin(), Estored.end(),
+                   Eadd.begin(), Eadd.end(), std::back_inserter(E));
+        nknots = E.size();
+        xsec.assign(nknots, 0.);
+      }
     }
 
+    // Compute cross sections for the input interaction at the selected
+    // set of energies
+    //
+    for (int i = 0; i < nknots; i++) {
+      xsec[i] = this->KnotXSec(alg, interaction, E[i]);
+    }
   }
 
   // Warn about odd case of decreasing cross section
@@ -293,20 +536,227 @@ void XSecSplineList::CreateSpline(const XSecAlgorithmI * alg,
     mm_iter = fSplineMap.find(fCurrentTune);
   }
   map<string, Spline *> & spl_map_curr_tune = mm_iter->second;
+  map<string, Spline *>::iterator old = spl_map_curr_tune.find(key);
+  if(old != spl_map_curr_tune.end()) {
+    // replacing a spline loaded from file (incremental mode)
+    delete old->second;
+    spl_map_curr_tune.erase(old);
+    fGeneration++;
+    fLoadedSplineSet[fCurrentTune].erase(key);
+  }
   spl_map_curr_tune.insert( map<string, Spline *>::value_type(key, spline) );
 }
 //____________________________________________________________________________
+double XSecSplineList::KnotXSec(
+  const XSecAlgorithmI * alg, const Interaction * interaction, double E) const
+{
+// Compute the cross section at a spline knot (or take it from the knot store)
+
+  if(fKnotStore && fKnotAddress.size() > 0) {
+    double xsec = 0;
+    if(fKnotStore->Get(fKnotAddress, E, xsec)) {
+      SLOG("XSecSplLst", pINFO)
+                     << "xsec(E = " << E << ") =  "
+                     << (1E+38/units::cm2)*xsec << " x 1E-38 cm^2 (from knot store)";
+      return xsec;
+    }
+  }
+
+  double pr_mass = interaction->InitStatePtr()->Probe()->Mass();
+  TLorentzVector p4(0,0,E,E);
+  if (pr_mass > 0.) {
+    double pz = TMath::Max(0.,E*E - pr_mass*pr_mass);
+    pz = TMath::Sqrt(pz);
+    p4.SetPz(pz);
+  }
+  interaction->InitStatePtr()->SetProbeP4(p4);
+
+  steady_clock::time_point start = steady_clock::now();
+
+  double xsec = alg->Integral(interaction);
+
+  steady_clock::time_point end = steady_clock::now();
+
+  duration<double> time_span = duration_cast<duration<double>>(end - start);
+  PerfMonitor::Instance()->IntegratorCounter(alg)->Add(time_span.count());
+
+  SLOG("XSecSplLst", pNOTICE)
+                     << "xsec(E = " << E << ") =  "
+                     << (1E+38/units::cm2)*xsec << " x 1E-38 cm^2, evaluated in " << time_span.count() << " s";
+  if ( std::isnan(xsec) ) {
+    // this sometimes happens near threshold, warn and move on
+    SLOG("XSecSplLst", pWARN)
+                     << "xsec(E = " << E << ") =  "
+                     << (1E+38/units::cm2)*xsec << " x 1E-38 cm^2"
+                     << " : converting NaN to 0.0";
+    xsec = 0.0;
+  }
+  if(fKnotStore && fKnotAddress.size() > 0) {
+    fKnotStore->Put(fKnotAddress, E, xsec);
+  }
+  return xsec;
+}
+//____________________________________________________________________________
+double XSecSplineList::PlaceKnots(
+  const XSecAlgorithmI * alg, const Interaction * interaction,
+  double e_min, double e_max, int nmax,
+  vector<double> & E, vector<double> & xsec) const
+{
+// Place up to nmax knots in [e_min, e_max] (appended to the input E, xsec
+// vectors which may already hold knots below e_min).
+// Starts from a coarse grid (in E or log E, as set by UseLogE) and, in
+// successive passes, evaluates the cross section at the midpoint of every
+// interval not yet converged. The midpoint value is compared with the value
+// interpolated from the spline built without it: intervals where the
+// difference, relative to max(|xsec|, 1% of the largest xsec seen), exceeds
+// the tolerance are split further. Every computed midpoint becomes a knot.
+// Returns the largest error estimate among the final intervals.
+
+  const bool   uselog   = this->UseLogE();
+  const double min_dlog = 1E-4; // smallest interval (in log10 E) worth splitting
+  const double yfloor   = 0.01; // error floor, as a fraction of the max xsec
+
+  int nkb = E.size();
+  int ncoarse = TMath::Min(nmax, TMath::Max(8, nmax/4));
+
+  double u0 = (uselog) ? TMath::Log10(e_min) : e_min;
+  double u1 = (uselog) ? TMath::Log10(e_max) : e_max;
+
+  // coarse grid; map knots by their (log) energy to keep them ordered
+  map<double, double> knots;
+  for(int i=0; i<ncoarse; i++) {
+    double u = (i == ncoarse-1) ? u1 : u0 + i*(u1-u0)/(ncoarse-1);
+    double e = (i == ncoarse-1) ? e_max : ((uselog) ? TMath::Power(10.,u) : u);
+    knots[u] = this->KnotXSec(alg, interaction, e);
+  }
+
+  // intervals to refine, identified by their lower edge
+  set<double> active;
+  map<double, double>::const_iterator kit = knots.begin();
+  for( ; kit != knots.end(); ++kit) {
+    if(kit->first < u1) active.insert(kit->first);
+  }
+  map<double, double> interval_err;
+
+  while(!active.empty() && (int)knots.size() < nmax) {
+
+    // interpolant through the current knots (incl. the ones below threshold)
+    vector<double> xk, yk;
+    xk.insert(xk.end(), E.begin(),    E.begin()    + nkb);
+    yk.insert(yk.end(), xsec.begin(), xsec.begin() + nkb);
+    double ymax = 0.;
+    for(kit = knots.begin(); kit != knots.end(); ++kit) {
+      xk.push_back( (uselog) ? TMath::Power(10.,kit->first) : kit->first );
+      yk.push_back( kit->second );
+      ymax = TMath::Max(ymax, TMath::Abs(kit->second));
+    }
+    xk.back() = e_max;
+    Spline current((int)xk.size(), xk.data(), yk.data());
+
+    set<double> next;
+    set<double>::const_iterator ait = active.begin();
+    for( ; ait != active.end(); ++ait) {
+      if((int)knots.size() >= nmax) break;
+
+      double ulo = *ait;
+      map<double, double>::const_iterator hi = knots.upper_bound(ulo);
+      if(hi == knots.end()) continue;
+      double uhi = hi->first;
+      double um  = 0.5*(ulo+uhi);
+      double em  = (uselog) ? TMath::Power(10.,um) : um;
+
+      double ypred = current.Evaluate(em);
+      double ytrue = this->KnotXSec(alg, interaction, em);
+      knots[um] = ytrue;
+
+      double scale = TMath::Max(TMath::Abs(ytrue), yfloor*ymax);
+      double err   = (scale > 0.) ? TMath::Abs(ypred-ytrue)/scale : 0.;
+      interval_err[ulo] = err;
+      interval_err[um]  = err;
+
+      double dlog = (uselog) ? (uhi-ulo) : TMath::Log10(uhi/TMath::Max(ulo,1E-12));
+      if(err > fAdaptiveTol && dlog > 2*min_dlog) {
+        next.insert(ulo);
+        next.insert(um);
+      }
+    }
+    active = next;
+  }
+
+  if(!active.empty()) {
+    SLOG("XSecSplLst", pWARN)
+      << "Reached the maximum number of knots (" << nmax
+      << ") before meeting the interpolation tolerance";
+  }
+
+  double maxerr = 0.;
+  map<double, double>::const_iterator eit = interval_err.begin();
+  for( ; eit != interval_err.end(); ++eit) {
+    maxerr = TMath::Max(maxerr, eit->second);
+  }
+
+  for(kit = knots.begin(); kit != knots.end(); ++kit) {
+    E.push_back( (uselog) ? TMath::Power(10.,kit->first) : kit->first );
+    xsec.push_back( kit->second );
+  }
+  // force last point to avoid floating point slew
+  E.back() = e_max;
+
+  return maxerr;
+}
+//____________________________________________________________________________
+void XSecSplineList::SetAdaptiveKnots(bool on, double tolerance)
+{
+  fAdaptiveKnots = on;
+  if(tolerance > 0.) fAdaptiveTol = tolerance;
+}
+//____________________________________________________________________________
+void XSecSplineList::SetKnotStore(XSecKnotStore * store)
+{
+  if(fKnotStore && fKnotStore != store) delete fKnotStore;
+  fKnotStore = store;
+}
+//____________________________________________________________________________
+void XSecSplineList::SetIncremental(bool on)
+{
+  fIncremental = on;
+  if(fIncremental && !fKnotStore) {
+    fKnotStore = new XSecKnotStore();
+  }
+}
+//____________________________________________________________________________
+double XSecSplineList::KnotPlacementError(string key) const
+{
+  map<string, double>::const_iterator it = fKnotErrors.find(key);
+  if(it == fKnotErrors.end()) return -1.;
+  return it->second;
+}
+//____________________________________________________________________________
 int XSecSplineList::NSplines(void) const
 {
-  map<string,  map<string, Spline *> >::const_iterator //
-  mm_iter = fSplineMap.find(fCurrentTune);
-  if(mm_iter == fSplineMap.end()) {
+  if(!this->HasSplineFromTune(fCurrentTune)) {
     SLOG("XSecSplLst", pWARN)
        << "No splines for tune " << fCurrentTune << " were found!";
     return 0;
   }
-  const map<string, Spline *> & spl_map_curr_tune = mm_iter->second;
-  return (int) spl_map_curr_tune.size();
+  int nspl = 0;
+  map<string,  map<string, Spline *> >::const_iterator //
+  mm_iter = fSplineMap.find(fCurrentTune);
+  if(mm_iter != fSplineMap.end()) {
+    nspl = (int) mm_iter->second.size();
+  }
+  return nspl + this->NBinarySplines(fCurrentTune);
+}
+//____________________________________________________________________________
+bool XSecSplineList::HasSplineFromTune(const string & tune) const
+{
+  if(fSplineMap.count(tune) > 0) return true;
+  for(unsigned int ib = 0; ib < fBinaryFiles.size(); ib++) {
+    uint64_t first = 0, last = 0;
+    fBinaryFiles[ib]->TuneRange(tune, first, last);
+    if(last > first) return true;
+  }
+  return false;
 }
 //____________________________________________________________________________
 bool XSecSplineList::IsEmpty(void) const
@@ -343,6 +793,9 @@ void XSecSplineList::SaveAsXml(const string & filename, bool save_init) const
   SLOG("XSecSplLst", pNOTICE)
        << "Saving XSecSplineList as XML in file: " << filename;
 
+  // splines still sitting in binary files need to be built before writing
+  this->MaterializeAll();
+
   ofstream outxml(filename.c_str());
   if(!outxml.is_open()) {
     SLOG("XSecSplLst", pERROR) << "Couldn't create file = " << filename;
@@ -411,7 +864,12 @@ XmlParserStatus_t XSecSplineList::LoadFromXml(const string & filename, bool keep
     << "Option to keep pre-existing splines is switched "
     << ( (keep) ? "ON" : "OFF" );
 
-  if(!keep) fSplineMap.clear();
+  if(!keep) {
+    fSplineMap.clear();
+    this->CloseBinaryFiles();
+    fDeferredLoaded.clear();
+    fGeneration++;
+  }
 
   const int kNodeTypeStartElement = 1;
   const int kNodeTypeEndElement   = 15;
@@ -424,11 +882,13 @@ XmlParserStatus_t XSecSplineList::LoadFromXml(const string & filename, bool keep
   double * E = 0, * xsec = 0;
   string spline_name = "";
   string temp_tune ;
+  int nskipped = 0;
 
   reader = xmlNewTextReaderFilename(filename.c_str());
   if (reader != NULL) {
         ret = xmlTextReaderRead(reader);
         while (ret == 1) {
+            bool skip = false;  // skip the current element and its children?
             xmlChar * name  = xmlTextReaderName     (reader);
             xmlChar * value = xmlTextReaderValue    (reader);
             int       type  = xmlTextReaderNodeType (reader);
@@ -460,8 +920,13 @@ XmlParserStatus_t XSecSplineList::LoadFromXml(const string & filename, bool keep
             if( (!xmlStrcmp(name, (const xmlChar *) "genie_tune")) && type==kNodeTypeStartElement) {
                xmlChar * xtune = xmlTextReaderGetAttribute(reader,(const xmlChar*)"name");
                temp_tune    = utils::str::TrimSpaces((const char *)xtune);
-               SLOG("XSecSplLst", pNOTICE) << "Loading x-section splines for GENIE tune: " << temp_tune;
                xmlFree(xtune);
+               if(fCurrentTuneOnly && fCurrentTune.size() > 0 && temp_tune != fCurrentTune) {
+                 SLOG("XSecSplLst", pNOTICE) << "Skipping x-section splines for GENIE tune: " << temp_tune;
+                 skip = true;
+               } else {
+                 SLOG("XSecSplLst", pNOTICE) << "Loading x-section splines for GENIE tune: " << temp_tune;
+               }
             }
 
             if( (!xmlStrcmp(name, (const xmlChar *) "spline")) && type==kNodeTypeStartElement) {
@@ -471,15 +936,21 @@ XmlParserStatus_t XSecSplineList::LoadFromXml(const string & filename, bool keep
                string snkn     = utils::str::TrimSpaces((const char *)xnkn);
 
                spline_name = sname;
-               SLOG("XSecSplLst", pNOTICE) << "Loading spline: " << spline_name;
-
-               nknots = atoi( snkn.c_str() );
-               iknot=0;
-               E     = new double[nknots];
-               xsec  = new double[nknots];
-
                xmlFree(xname);
                xmlFree(xnkn);
+
+               if(fLoadFilter && !fLoadFilter(temp_tune, spline_name)) {
+                 SLOG("XSecSplLst", pDEBUG) << "Skipping spline: " << spline_name;
+                 nskipped++;
+                 skip = true;
+               } else {
+                 SLOG("XSecSplLst", pNOTICE) << "Loading spline: " << spline_name;
+
+                 nknots = atoi( snkn.c_str() );
+                 iknot=0;
+                 E     = new double[nknots];
+                 xsec  = new double[nknots];
+               }
             }
 
             if( (!xmlStrcmp(name, (const xmlChar *) "E"))    && type==kNodeTypeStartElement) { val_type = kKnotX; }
@@ -520,9 +991,13 @@ XmlParserStatus_t XSecSplineList::LoadFromXml(const string & filename, bool keep
             }
             xmlFree(name);
             xmlFree(value);
-            ret = xmlTextReaderRead(reader);
+            ret = (skip) ? xmlTextReaderNext(reader) : xmlTextReaderRead(reader);
         }
         xmlFreeTextReader(reader);
+        if (nskipped > 0) {
+          SLOG("XSecSplLst", pNOTICE)
+            << "Skipped " << nskipped << " splines not passing the load filter";
+        }
         if (ret != 0) {
           LOG("XSecSplLst", pERROR)
             << "\nXML file could not be parsed! [filename: " << filename << "]";
@@ -539,44 +1014,79 @@ XmlParserStatus_t XSecSplineList::LoadFromXml(const string & filename, bool keep
 string XSecSplineList::BuildSplineKey(
             const XSecAlgorithmI * alg, const Interaction * interaction) const
 {
+  return this->SplineKey(alg, interaction);
+}
+//____________________________________________________________________________
+const string & XSecSplineList::SplineKey(
+            const XSecAlgorithmI * alg, const Interaction * interaction) const
+{
+  static const string empty_key = "";
+
   if(!alg) {
     LOG("XSecSplLst", pWARN)
             << "Null XSecAlgorithmI - Returning empty spline key";
-    return "";
+    return empty_key;
   }
 
   if(!interaction) {
     LOG("XSecSplLst", pWARN)
             << "Null Interaction - Returning empty spline key";
-    return "";
+    return empty_key;
   }
 
-  string alg_name  = alg->Id().Name();
-  string param_set = alg->Id().Config();
-  string intkey    = interaction->AsString();
-
-  string key = alg_name + "/" + param_set + "/" + intkey;
-
-  return key;
+  // spline keys are interned by (algorithm, interaction fingerprint), so
+  // that they are only formatted once. The algorithm id and fingerprinted
+  // fields are kept beside the key and compared on a hit: an entry for a
+  // reconfigured algorithm is replaced, and colliding interactions are not
+  // interned and have their key formatted every time
+  ULong64_t fp = interaction->Fingerprint();
+  interaction->FingerprintFields(fFieldsBuffer);
+  const AlgId & id = alg->Id();
+
+  InternedSplineKey & entry = fSplineKeys[std::make_pair(alg, fp)];
+  if(entry.key.size() == 0 || entry.alg_key != id.Key()) {
+    entry.alg_key = id.Key();
+    entry.fields  = fFieldsBuffer;
+    entry.key     = id.Name() + "/" + id.Config() + "/" + interaction->AsString();
+  }
+  else if(entry.fields != fFieldsBuffer) {
+    fCollidingKey = id.Name() + "/" + id.Config() + "/" + interaction->AsString();
+    LOG("XSecSplLst", pWARN)
+      << "Interaction fingerprint collision: " << fCollidingKey
+      << " vs " << entry.key;
+    return fCollidingKey;
+  }
+  return entry.key;
 }
 //____________________________________________________________________________
 const vector<string> * XSecSplineList::GetSplineKeys(void) const
 {
-  map<string,  map<string, Spline *> >::const_iterator //\/
-  mm_iter = fSplineMap.find(fCurrentTune);
-  if(mm_iter == fSplineMap.end()) {
+  if(!this->HasSplineFromTune(fCurrentTune)) {
     SLOG("XSecSplLst", pWARN)
        << "No splines for tune " << fCurrentTune << " were found!";
     return 0;
   }
-  const map<string, Spline *> & spl_map_curr_tune = mm_iter->second;
-  vector<string> * keyv = new vector<string>(spl_map_curr_tune.size());
-  unsigned int i=0;
-  map<string, Spline *>::const_iterator m_iter = spl_map_curr_tune.begin();
-  for( ; m_iter != spl_map_curr_tune.end(); ++m_iter) {
-    string key = m_iter->first;
-    (*keyv)[i++]=key;
+
+  // keys of splines already built and of splines still in binary files
+  set<string> keys;
+  map<string,  map<string, Spline *> >::const_iterator //\/
+  mm_iter = fSplineMap.find(fCurrentTune);
+  if(mm_iter != fSplineMap.end()) {
+    const map<string, Spline *> & spl_map_curr_tune = mm_iter->second;
+    map<string, Spline *>::const_iterator m_iter = spl_map_curr_tune.begin();
+    for( ; m_iter != spl_map_curr_tune.end(); ++m_iter) {
+      keys.insert(m_iter->first);
+    }
+  }
+  for(unsigned int ib = 0; ib < fBinaryFiles.size(); ib++) {
+    const BinaryFile * bf = fBinaryFiles[ib];
+    uint64_t first = 0, last = 0;
+    bf->TuneRange(fCurrentTune, first, last);
+    for(uint64_t ie = first; ie < last; ie++) {
+      keys.insert(bf->Key(bf->index[ie]));
+    }
   }
+  vector<string> * keyv = new vector<string>(keys.begin(), keys.end());
   return keyv;
 }
 //____________________________________________________________________________
@@ -589,8 +1099,23 @@ void XSecSplineList::Print(ostream & stream) const
   stream << "\n  |-----o  Spline Emin..............." << fEmin;
   stream << "\n  |-----o  Spline Emax..............." << fEmax;
   stream << "\n  |-----o  Spline NKnots............." << fNKnots;
+  stream << "\n  |-----o  Adaptive knots............" << fAdaptiveKnots;
+  if(fAdaptiveKnots) {
+    stream << "\n  |-----o  Adaptive knots tolerance.." << fAdaptiveTol;
+  }
+  stream << "\n  |-----o  Incremental.............." << fIncremental;
+  if(fKnotStore) {
+    stream << "\n  |-----o  Knot store..............."
+           << ((fKnotStore->Directory().size() > 0) ?
+                fKnotStore->Directory() : string("[in memory]"));
+  }
   stream << "\n  |";
 
+  for(unsigned int ib = 0; ib < fBinaryFiles.size(); ib++) {
+    stream << "\n [-] Mapped binary spline file: " << fBinaryFiles[ib]->filename
+           << " (" << fBinaryFiles[ib]->header->nentries << " splines, built on first use)";
+  }
+
   map<string, map<string, Spline *> >::const_iterator mm_iter;
   for(mm_iter = fSplineMap.begin(); mm_iter != fSplineMap.end(); ++mm_iter) {
 
@@ -607,6 +1132,368 @@ void XSecSplineList::Print(ostream & stream) const
     stream << "\n";
   }
 }
+//____________________________________________________________________________
+void XSecSplineList::SetInitStateFilter(
+                      const PDGCodeList & probes, const PDGCodeList & targets)
+{
+// Keep only splines whose key (see BuildSplineKey and Interaction::AsString)
+// refers to one of the input probes and to one of the input targets or to a
+// free nucleon. Keys that can not be decoded (eg dark matter probes) are kept.
+
+  set<int> probe_set  (probes.begin(),  probes.end());
+  set<int> target_set (targets.begin(), targets.end());
+  target_set.insert(kPdgTgtFreeP);
+  target_set.insert(kPdgTgtFreeN);
+
+  SLOG("XSecSplLst", pNOTICE)
+    << "Loading only splines for probes: " << probes
+    << " and targets: " << targets;
+
+  fLoadFilter = [probe_set, target_set](const string & /*tune*/, const string & key) {
+    size_t inu  = key.find("nu:");
+    size_t itgt = key.find("tgt:");
+    if(inu == string::npos || itgt == string::npos) return true;
+    int nu  = atoi(key.c_str() + inu  + 3);
+    int tgt = atoi(key.c_str() + itgt + 4);
+    return (probe_set.count(nu) == 1 && target_set.count(tgt) == 1);
+  };
+}
+//____________________________________________________________________________
+void XSecSplineList::DeferLoadFromXml(const string & filename)
+{
+  SLOG("XSecSplLst", pNOTICE)
+    << "Deferring loading of splines from: " << filename
+    << " until the list of initial states is known";
+  fDeferredFiles.push_back(filename);
+}
+//____________________________________________________________________________
+XmlParserStatus_t XSecSplineList::LoadDeferred(
+                const PDGCodeList & probes, const PDGCodeList & targets)
+{
+  // initial states not loaded yet for the current tune
+  set<pair<int,int> > & loaded = fDeferredLoaded[fCurrentTune];
+  set<pair<int,int> > missing;
+  set<int> missing_probes;
+  for(unsigned int ip = 0; ip < probes.size(); ip++) {
+    for(unsigned int it = 0; it < targets.size(); it++) {
+      pair<int,int> is(probes[ip], targets[it]);
+      if(loaded.count(is) == 1) continue;
+      missing.insert(is);
+      missing_probes.insert(probes[ip]);
+    }
+  }
+  if(missing.empty()) return kXmlOK;
+
+  SLOG("XSecSplLst", pNOTICE)
+    << "Loading deferred splines for " << missing.size() << " new initial states";
+
+  // keep the splines of the missing initial states (and the free-nucleon
+  // ones for their probes) that are not loaded yet and pass the user filter
+  XSecSplineFilter_t user_filter = fLoadFilter;
+  const map<string, map<string, Spline *> > & spline_map = fSplineMap;
+  fLoadFilter = [&](const string & tune, const string & key) {
+    if(user_filter && !user_filter(tune, key)) return false;
+    map<string, map<string, Spline *> >::const_iterator mm = spline_map.find(tune);
+    if(mm != spline_map.end() && mm->second.count(key) == 1) return false;
+    size_t inu  = key.find("nu:");
+    size_t itgt = key.find("tgt:");
+    if(inu == string::npos || itgt == string::npos) return true;
+    int nu  = atoi(key.c_str() + inu  + 3);
+    int tgt = atoi(key.c_str() + itgt + 4);
+    if(tgt == kPdgTgtFreeP || tgt == kPdgTgtFreeN) {
+      return (missing_probes.count(nu) == 1);
+    }
+    return (missing.count(pair<int,int>(nu, tgt)) == 1);
+  };
+
+  XmlParserStatus_t status = kXmlOK;
+
+  fCurrentTuneOnly = true;
+  vector<string>::const_iterator it = fDeferredFiles.begin();
+  for( ; it != fDeferredFiles.end(); ++it) {
+    status = this->LoadFromXml(*it, true);
+    if(status != kXmlOK) break;
+  }
+  fCurrentTuneOnly = false;
+  fLoadFilter = user_filter;
+
+  if(status == kXmlOK) loaded.insert(missing.begin(), missing.end());
+
+  return status;
+}
+//____________________________________________________________________________
+bool XSecSplineList::IsBinaryFile(const string & filename)
+{
+  std::ifstream in(filename.c_str(), std::ios::binary);
+  if(!in.is_open()) return false;
+  char magic[sizeof(kBinSplMagic)];
+  in.read(magic, sizeof(magic));
+  if(!in.good()) return false;
+  return (memcmp(magic, kBinSplMagic, sizeof(magic)) == 0);
+}
+//____________________________________________________________________________
+bool XSecSplineList::SaveAsBinary(const string & filename) const
+{
+//! Save XSecSplineList in the binary spline format.
+//! The knots are written as the doubles held by each spline, so converting
+//! a loaded XML file is lossless.
+
+  SLOG("XSecSplLst", pNOTICE)
+       << "Saving XSecSplineList as binary in file: " << filename;
+
+  this->MaterializeAll();
+
+  // Index entries, ordered by (tune, key) as the loader does a binary search
+  vector<BinSplEntry> index;
+  string              strings;
+  vector<double>      knots;
+
+  map<string,  map<string, Spline *> >::const_iterator //\/
+  mm_iter = fSplineMap.begin();
+  for( ; mm_iter != fSplineMap.end(); ++mm_iter) {
+    const string & tune_name = mm_iter->first;
+    uint32_t tune_offset = strings.size();
+    strings += tune_name;
+
+    const map<string, Spline *> & spl_map_curr_tune = mm_iter->second;
+    map<string, Spline *>::const_iterator //\/
+    m_iter = spl_map_curr_tune.begin();
+    for( ; m_iter != spl_map_curr_tune.end(); ++m_iter) {
+      const string & key    = m_iter->first;
+      const Spline * spline = m_iter->second;
+
+      BinSplEntry entry;
+      entry.tune_offset  = tune_offset;
+      entry.tune_length  = tune_name.size();
+      entry.key_offset   = strings.size();
+      entry.key_length   = key.size();
+      entry.knots_offset = knots.size();
+      entry.nknots       = spline->NKnots();
+      entry.reserved     = 0;
+      strings += key;
+
+      int nknots = spline->NKnots();
+      for(int i = 0; i < nknots; i++) knots.push_back(spline->GetKnotX(i));
+      for(int i = 0; i < nknots; i++) knots.push_back(spline->GetKnotY(i));
+
+      index.push_back(entry);
+    }
+  }
+
+  BinSplHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, kBinSplMagic, sizeof(kBinSplMagic));
+  header.version        = kBinSplVersion;
+  header.uselog         = (fUseLogE ? 1 : 0);
+  header.nentries       = index.size();
+  header.index_offset   = sizeof(BinSplHeader);
+  header.strings_offset = header.index_offset + index.size() * sizeof(BinSplEntry);
+  header.strings_size   = strings.size();
+  uint64_t knots_offset = header.strings_offset + header.strings_size;
+  knots_offset          = (knots_offset + 7) & ~((uint64_t)7);
+  header.knots_offset   = knots_offset;
+  header.nknots_total   = knots.size();
+
+  ofstream out(filename.c_str(), std::ios::binary);
+  if(!out.is_open()) {
+    SLOG("XSecSplLst", pERROR) << "Couldn't create file = " << filename;
+    return false;
+  }
+  out.write((const char *) &header, sizeof(header));
+  if(!index.empty()) {
+    out.write((const char *) &index[0], index.size() * sizeof(BinSplEntry));
+  }
+  out.write(strings.data(), strings.size());
+  uint64_t npad = knots_offset - (header.strings_offset + header.strings_size);
+  const char pad[8] = {0,0,0,0,0,0,0,0};
+  out.write(pad, npad);
+  if(!knots.empty()) {
+    out.write((const char *) &knots[0], knots.size() * sizeof(double));
+  }
+  out.close();
+
+  if(out.fail()) {
+    SLOG("XSecSplLst", pERROR) << "Failed writing file = " << filename;
+    return false;
+  }
+  return true;
+}
+//____________________________________________________________________________
+XmlParserStatus_t XSecSplineList::LoadFromBinary(const string & filename, bool keep)
+{
+//! Map a binary spline file. No spline is built at this point: splines are
+//! built on first GetSpline() call and the mapping is shared (through the page
+//! cache) with all other processes using the same file.
+//! The keep option behaves as in LoadFromXml.
+
+  SLOG("XSecSplLst", pNOTICE)
+    << "Mapping binary splines from: " << filename;
+
+  if(!keep) {
+    fSplineMap.clear();
+    this->CloseBinaryFiles();
+    fDeferredLoaded.clear();
+    fGeneration++;
+  }
+
+  int fd = open(filename.c_str(), O_RDONLY);
+  if(fd < 0) {
+    LOG("XSecSplLst", pERROR)
+          << "\nBinary spline file could not be found! [filename: " << filename << "]";
+    return kXmlNotParsed;
+  }
+  struct stat st;
+  if(fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(BinSplHeader)) {
+    LOG("XSecSplLst", pERROR)
+          << "\nBinary spline file is empty or unreadable! [filename: " << filename << "]";
+    close(fd);
+    return kXmlEmpty;
+  }
+  size_t size = st.st_size;
+  void * addr = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(addr == MAP_FAILED) {
+    LOG("XSecSplLst", pERROR)
+          << "\nBinary spline file could not be mapped! [filename: " << filename << "]";
+    return kXmlNotParsed;
+  }
+
+  // the whole index is checked now, so that a corrupt file is rejected
+  // rather than read out of bounds when its splines are built
+  const BinSplHeader * header = (const BinSplHeader *) addr;
+  string reason = "";
+  if(!ValidBinSplFile(header, size, reason)) {
+    LOG("XSecSplLst", pERROR)
+      << "\nInvalid or unsupported binary spline file (" << reason
+      << ")! [filename: " << filename << "]";
+    munmap(addr, size);
+    return kXmlInvalidRoot;
+  }
+
+  BinaryFile * bf = new BinaryFile;
+  bf->filename = filename;
+  bf->addr     = addr;
+  bf->size     = size;
+  bf->header   = header;
+  bf->index    = (const BinSplEntry *) ((const char *) addr + header->index_offset);
+  bf->strings  = (const char *)        ((const char *) addr + header->strings_offset);
+  bf->knots    = (const double *)      ((const char *) addr + header->knots_offset);
+
+  // the last file loaded takes precedence, as splines loaded later do for XML
+  fBinaryFiles.insert(fBinaryFiles.begin(), bf);
+
+  this->SetLogE(header->uselog == 1);
+
+  SLOG("XSecSplLst", pNOTICE)
+    << "Mapped " << header->nentries << " splines (format version "
+    << header->version << ")";
+
+  return kXmlOK;
+}
+//____________________________________________________________________________
+bool XSecSplineList::LoadFromSharedStore(const string & filename)
+{
+  SharedTableStore * store = SharedTableStore::Instance();
+  if(!store->IsEnabled()) return false;
+
+  std::ostringstream format;
+  format << "binary spline format v" << kBinSplVersion;
+  uint64_t hash = SharedTableStore::Hash(
+                     format.str(), SharedTableStore::HashFile(filename));
+
+  // the shared file holds all splines of the input file, whatever the load
+  // filter of the process converting it
+  bool loaded = false;
+  bool built  = false;
+  string shared_file = store->Acquire("xsec-splines", hash,
+    [this, &filename, &loaded](const string & out) {
+      XSecSplineFilter_t filter = fLoadFilter;
+      fLoadFilter = XSecSplineFilter_t();
+      loaded = (this->LoadFromXml(filename) == kXmlOK);
+      fLoadFilter = filter;
+      return loaded && this->SaveAsBinary(out);
+    },
+    built);
+
+  // the converting process keeps the splines it has just parsed
+  if(built) return loaded;
+  if(shared_file.size() == 0) return false;
+
+  if(this->LoadFromBinary(shared_file) == kXmlOK) return true;
+
+  store->Discard(shared_file);
+  return false;
+}
+//____________________________________________________________________________
+Spline * XSecSplineList::MaterializeSpline(
+                            const string & tune, const string & key) const
+{
+// Build the requested spline from the first binary file holding it and move
+// it to the list of built splines
+
+  for(unsigned int ib = 0; ib < fBinaryFiles.size(); ib++) {
+    const BinaryFile * bf = fBinaryFiles[ib];
+    const BinSplEntry * entry = bf->Find(tune, key);
+    if(!entry) continue;
+
+    SLOG("XSecSplLst", pINFO) << "Building spline: " << key << " from: " << bf->filename;
+
+    int nknots = entry->nknots;
+    const double * E    = bf->knots + entry->knots_offset;
+    const double * xsec = E + nknots;
+    vector<double> vE    (E,    E    + nknots);
+    vector<double> vxsec (xsec, xsec + nknots);
+
+    Spline * spline = new Spline(nknots, vE.data(), vxsec.data());
+    fSplineMap[tune].insert( map<string, Spline *>::value_type(key, spline) );
+    fLoadedSplineSet[tune].insert(key);
+    return spline;
+  }
+  return 0;
+}
+//____________________________________________________________________________
+void XSecSplineList::MaterializeAll(void) const
+{
+  for(unsigned int ib = 0; ib < fBinaryFiles.size(); ib++) {
+    const BinaryFile * bf = fBinaryFiles[ib];
+    for(uint64_t ie = 0; ie < bf->header->nentries; ie++) {
+      string tune = bf->Tune(bf->index[ie]);
+      string key  = bf->Key (bf->index[ie]);
+      map<string, map<string, Spline *> >::const_iterator mm_iter = fSplineMap.find(tune);
+      if(mm_iter != fSplineMap.end() && mm_iter->second.count(key) == 1) continue;
+      this->MaterializeSpline(tune, key);
+    }
+  }
+}
+//____________________________________________________________________________
+int XSecSplineList::NBinarySplines(const string & tune) const
+{
+// Number of splines for the input tune found only in binary files
+
+  set<string> keys;
+  map<string, map<string, Spline *> >::const_iterator mm_iter = fSplineMap.find(tune);
+  for(unsigned int ib = 0; ib < fBinaryFiles.size(); ib++) {
+    const BinaryFile * bf = fBinaryFiles[ib];
+    uint64_t first = 0, last = 0;
+    bf->TuneRange(tune, first, last);
+    for(uint64_t ie = first; ie < last; ie++) {
+      string key = bf->Key(bf->index[ie]);
+      if(mm_iter != fSplineMap.end() && mm_iter->second.count(key) == 1) continue;
+      keys.insert(key);
+    }
+  }
+  return (int) keys.size();
+}
+//____________________________________________________________________________
+void XSecSplineList::CloseBinaryFiles(void)
+{
+  vector<BinaryFile *>::iterator it = fBinaryFiles.begin();
+  for( ; it != fBinaryFiles.end(); ++it) {
+    munmap((*it)->addr, (*it)->size);
+    delete (*it);
+  }
+  fBinaryFiles.clear();
+}
 //___________________________________________________________________________
 
 } // genie namespace
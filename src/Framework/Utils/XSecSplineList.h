@@ -23,6 +23,9 @@
 #include <set>
 #include <vector>
 #include <string>
+#include <functional>
+
+#include <Rtypes.h>
 
 #include "Framework/Conventions/XmlParserStatus.h"
 
@@ -38,6 +41,11 @@ namespace genie {
 class XSecAlgorithmI;
 class Interaction;
 class Spline;
+class PDGCodeList;
+class XSecKnotStore;
+
+//! Predicate deciding whether a spline (tune, key) should be loaded from file
+typedef std::function<bool (const string & tune, const string & key)> XSecSplineFilter_t;
 
 class XSecSplineList;
 ostream & operator << (ostream & stream, const XSecSplineList & xsl);
@@ -52,6 +60,39 @@ public:
   void               SaveAsXml   (const string & filename, bool save_init = true) const;
   XmlParserStatus_t  LoadFromXml (const string & filename, bool keep = false);
 
+  // Save/load to/from the binary spline format.
+  // Binary files are memory-mapped (read-only, shared by all processes reading
+  // the same file) and individual splines are only built on first access.
+  bool               SaveAsBinary   (const string & filename) const;
+  XmlParserStatus_t  LoadFromBinary (const string & filename, bool keep = false);
+  static bool        IsBinaryFile   (const string & filename);
+
+  // Load an XML file through the shared table store (see SharedTableStore):
+  // the first process on the node converts it to the binary format and all
+  // processes map the converted file. Returns false, having loaded nothing,
+  // if the store is disabled or unusable.
+  bool               LoadFromSharedStore (const string & filename);
+
+  // Optional filter applied when loading splines from XML. Splines failing the
+  // filter are skipped by the parser, without reading their knots.
+  // SetInitStateFilter() keeps only the splines for the input probes and
+  // targets (plus the free-nucleon ones, which cross section algorithms may
+  // use to build nuclear cross sections).
+  void SetLoadFilter      (XSecSplineFilter_t filter) { fLoadFilter = filter; }
+  void SetInitStateFilter (const PDGCodeList & probes, const PDGCodeList & targets);
+  void ClearLoadFilter    (void) { fLoadFilter = XSecSplineFilter_t(); }
+
+  // Deferred loading: the file is only parsed once the job knows which
+  // initial states it will simulate (see GMCJDriver::Configure and
+  // GEVGDriver::Configure), and only the splines of the current tune for
+  // the input probes and targets (see SetInitStateFilter) are built. The
+  // files stay deferred: a later call (eg by another driver of a pool, or
+  // for another target) loads the splines of the initial states that were
+  // not loaded yet, and does nothing if there are none.
+  void              DeferLoadFromXml (const string & filename);
+  bool              HasDeferredFiles (void) const { return !fDeferredFiles.empty(); }
+  XmlParserStatus_t LoadDeferred     (const PDGCodeList & probes, const PDGCodeList & targets);
+
   // Print available splines
   void   Print (ostream & stream) const;
   friend ostream & operator << (ostream & stream, const XSecSplineList & xsl);
@@ -61,14 +102,14 @@ public:
   // one for each process, as instructed.
   void   SetCurrentTune (const string & tune) { fCurrentTune = tune; }
   string CurrentTune    (void) const  { return fCurrentTune; }
-  bool   HasSplineFromTune( const string & tune ) const { return fSplineMap.count(tune) > 0 ; }
+  bool   HasSplineFromTune( const string & tune ) const;
 
   // Query the existence, access or create a spline
   // The results of the following methods depend on the current tune setting
   bool           SplineExists (const XSecAlgorithmI * alg, const Interaction * i) const;
-  bool           SplineExists (string spline_key) const;
+  bool           SplineExists (const string & spline_key) const;
   const Spline * GetSpline    (const XSecAlgorithmI * alg, const Interaction * i) const;
-  const Spline * GetSpline    (string spline_key) const;
+  const Spline * GetSpline    (const string & spline_key) const;
   void           CreateSpline (const XSecAlgorithmI * alg, const Interaction * i,
                                int nknots = -1, double e_min = -1, double e_max = -1);
   int  NSplines (void) const;
@@ -90,6 +131,31 @@ public:
   double Emin      (void) const { return fEmin;     }
   double Emax      (void) const { return fEmax;     }
 
+  // Adaptive knot placement: when enabled, CreateSpline() starts from a coarse
+  // grid and keeps bisecting the intervals where the interpolated cross section
+  // differs from the computed one by more than the given relative tolerance.
+  // The requested number of knots becomes an upper limit.
+  void   SetAdaptiveKnots   (bool on, double tolerance = -1);
+  bool   UseAdaptiveKnots   (void) const { return fAdaptiveKnots; }
+  double AdaptiveKnotsTol   (void) const { return fAdaptiveTol;   }
+  double KnotPlacementError (string spline_key) const; ///< estimated max rel. error of an adaptively built spline (-1 if n/a)
+
+  // Incremental spline production: cross sections computed at spline knots
+  // are kept in a knot store (see XSecKnotStore; adopted by the list) and
+  // reused by later CreateSpline() calls for the same algorithm configuration
+  // and interaction. In incremental mode, CreateSpline() starts from the
+  // knots already stored (including those of a loaded spline) and only adds
+  // the requested energies they don't cover (eg to extend the energy range or
+  // add knots); a loaded spline is left untouched if there is nothing to add.
+  void            SetKnotStore   (XSecKnotStore * store);
+  XSecKnotStore * KnotStore      (void) const { return fKnotStore;   }
+  void            SetIncremental (bool on);
+  bool            Incremental    (void) const { return fIncremental; }
+
+  // Changes whenever splines are replaced or dropped, invalidating Spline
+  // pointers obtained earlier from the list
+  unsigned long   Generation     (void) const { return fGeneration;  }
+
 private:
 
   XSecSplineList();
@@ -98,15 +164,57 @@ private:
 
   static XSecSplineList * fInstance;
 
+  struct BinaryFile;
+
+  // Look-up / build splines kept in memory-mapped binary files
+  Spline * MaterializeSpline    (const string & tune, const string & key) const;
+  void     MaterializeAll       (void) const;
+  void     CloseBinaryFiles     (void);
+  int      NBinarySplines       (const string & tune) const;
+
+  // Spline key of an algorithm & interaction, interned (see BuildSplineKey)
+  const string & SplineKey (const XSecAlgorithmI * alg, const Interaction * i) const;
+
+  // Spline building helpers
+  double   KnotXSec      (const XSecAlgorithmI * alg, const Interaction * i, double E) const;
+  double   PlaceKnots    (const XSecAlgorithmI * alg, const Interaction * i,
+                          double e_min, double e_max, int nmax,
+                          vector<double> & E, vector<double> & xsec) const;
+
   bool   fUseLogE;
   int    fNKnots;
   double fEmin;
   double fEmax;
+  bool   fAdaptiveKnots; ///< place knots adaptively (see PlaceKnots)
+  double fAdaptiveTol;   ///< target max relative interpolation error for adaptive knots
+
+  map<string, double> fKnotErrors; ///< spline key -> estimated max rel. error (adaptive knots only)
+
+  bool            fIncremental; ///< rebuild existing splines reusing their knots
+  XSecKnotStore * fKnotStore;   ///< computed knots, reused across splines/jobs (owned)
+  string          fKnotAddress; ///< knot store address of the spline being built
 
   string fCurrentTune; ///< The `active' tune, out the many that can co-exist
 
-  map<string, map<string, Spline *> > fSplineMap;       ///< tune -> { xsec_alg/xsec_config/interaction -> Spline }
-  map<string, set<string>           > fLoadedSplineSet; ///< tune -> { set of initialy loaded splines             }
+  unsigned long fGeneration; ///< incremented when splines are replaced or dropped
+
+  mutable map<string, map<string, Spline *> > fSplineMap;       ///< tune -> { xsec_alg/xsec_config/interaction -> Spline }
+  mutable map<string, set<string>           > fLoadedSplineSet; ///< tune -> { set of initialy loaded splines             }
+  vector<BinaryFile *>                        fBinaryFiles;     ///< mapped binary spline files, splines built on demand
+
+  XSecSplineFilter_t fLoadFilter;      ///< if set, only splines passing it are loaded from XML
+  bool               fCurrentTuneOnly; ///< if set, other tunes are skipped when loading from XML
+  vector<string>     fDeferredFiles;   ///< XML files loaded on demand (see DeferLoadFromXml)
+  map<string, set<pair<int,int> > > fDeferredLoaded; ///< tune -> { (probe, target) loaded from the deferred files }
+
+  struct InternedSplineKey {
+    string      alg_key; ///< AlgId::Key() of the algorithm when the key was interned
+    vector<int> fields;  ///< Interaction::FingerprintFields()
+    string      key;     ///< spline key
+  };
+  mutable map<pair<const XSecAlgorithmI *, ULong64_t>, InternedSplineKey> fSplineKeys; ///< (xsec algorithm, Interaction::Fingerprint()) -> spline key
+  mutable vector<int> fFieldsBuffer;  ///< scratch for Interaction::FingerprintFields()
+  mutable string      fCollidingKey;  ///< spline key of an interaction whose fingerprint collided
 
   struct Cleaner {
       void DummyMethodAndSilentCompiler() { }
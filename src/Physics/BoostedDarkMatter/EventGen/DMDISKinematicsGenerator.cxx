@@ -117,6 +117,7 @@ void DMDISKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
   bool accept = false;
   while(1) {
      iter++;
+     this->CountRejectionIteration();
      if(iter > kRjMaxIterations) {
        LOG("DMDISKinematics", pWARN)
          << " Couldn't select kinematics after " << iter << " iterations";
@@ -140,7 +141,7 @@ void DMDISKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
         << " (Q2 = " << interaction->KinePtr()->Q2() << ")";
 
      //-- compute the cross section for current kinematics
-     xsec = fXSecModel->XSec(interaction, kPSxyfE);
+     xsec = this->EvalXSec(interaction, kPSxyfE);
 
      //-- decide whether to accept the current kinematics
      if(!fGenerateUniformly) {
@@ -299,7 +300,7 @@ double DMDISKinematicsGenerator::ComputeMaxXSec(
         interaction->KinePtr()->Setx(gx);
         kinematics::UpdateWQ2FromXY(interaction);
 
-        double xsec = fXSecModel->XSec(interaction, kPSxyfE);
+        double xsec = this->EvalXSec(interaction, kPSxyfE);
 #ifdef __GENIE_LOW_LEVEL_MESG_ENABLED__
         LOG("DMDISKinematics", pINFO) 
                 << "xsec(y=" << gy << ", x=" << gx << ") = " << xsec;
@@ -325,7 +326,7 @@ double DMDISKinematicsGenerator::ComputeMaxXSec(
    	     gx = gx - dxn;
              interaction->KinePtr()->Setx(gx);
              kinematics::UpdateWQ2FromXY(interaction);
-             xsec = fXSecModel->XSec(interaction, kPSxyfE);
+             xsec = this->EvalXSec(interaction, kPSxyfE);
 #ifdef __GENIE_LOW_LEVEL_MESG_ENABLED__
              LOG("DMDISKinematics", pINFO) 
                 << "xsec(y=" << gy << ", x=" << gx << ") = " << xsec;
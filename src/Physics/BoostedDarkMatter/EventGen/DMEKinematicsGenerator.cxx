@@ -92,6 +92,7 @@ void DMEKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
   bool accept = false;
   while(1) {
      iter++;
+     this->CountRejectionIteration();
      if(iter > kRjMaxIterations) {
         LOG("DMEKinematics", pWARN)
               << "*** Could not select a valid y after "
@@ -109,7 +110,7 @@ void DMEKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
      LOG("DMEKinematics", pINFO) << "Trying: y = " << y;
 
      //-- computing cross section for the current kinematics
-     xsec = fXSecModel->XSec(interaction, kPSyfE);
+     xsec = this->EvalXSec(interaction, kPSyfE);
 
      //-- decide whether to accept the current kinematics
      if(!fGenerateUniformly) {
@@ -181,7 +182,7 @@ double DMEKinematicsGenerator::ComputeMaxXSec(
   for(int i=0; i<N; i++) {
     double y = ymin + i * dy;
     interaction->KinePtr()->Sety(y);
-    double xsec = fXSecModel->XSec(interaction, kPSyfE);
+    double xsec = this->EvalXSec(interaction, kPSyfE);
 
     SLOG("DMEKinematics", pDEBUG) << "xsec(y = " << y << ") = " << xsec;
     max_xsec = TMath::Max(xsec, max_xsec);
@@ -198,7 +199,7 @@ double DMEKinematicsGenerator::ComputeMaxXSec(
 	 y = y-dy;
          if(y<ymin) break;
          interaction->KinePtr()->Sety(y);
-         xsec = fXSecModel->XSec(interaction, kPSyfE);
+         xsec = this->EvalXSec(interaction, kPSyfE);
          SLOG("DMEKinematics", pDEBUG) << "xsec(y = " << y << ") = " << xsec;
          max_xsec = TMath::Max(xsec, max_xsec);
        }
@@ -140,6 +140,7 @@ void DMELEventGenerator::ProcessEventRecord(GHepRecord * evrec) const
     while (1) {
 
         iter++;
+        this->CountRejectionIteration();
         LOG("DMELEvent", pINFO) << "Attempt #: " << iter;
         if(iter > kRjMaxIterations) {
             LOG("DMELEvent", pWARN)
@@ -125,6 +125,7 @@ void DMELKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
   bool accept = false;
   while(1) {
      iter++;
+     this->CountRejectionIteration();
      if(iter > kRjMaxIterations) {
         LOG("DMELKinematics", pWARN)
           << "Couldn't select a valid Q^2 after " << iter << " iterations";
@@ -151,7 +152,7 @@ void DMELKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
      LOG("DMELKinematics", pINFO) << "Trying: Q^2 = " << gQ2;
 
      //-- Computing cross section for the current kinematics
-     xsec = fXSecModel->XSec(interaction, kPSQ2fE);
+     xsec = this->EvalXSec(interaction, kPSQ2fE);
 
      //-- Decide whether to accept the current kinematics
      if(!fGenerateUniformly) {
@@ -321,6 +322,7 @@ void DMELKinematicsGenerator::SpectralFuncExperimentalCode(
   bool accept = false;
   while(1) {
      iter++;
+     this->CountRejectionIteration();
      if(iter > kRjMaxIterations) {
         LOG("DMELKinematics", pWARN)
           << "Couldn't select a valid Q^2 after " << iter << " iterations";
@@ -374,7 +376,7 @@ void DMELKinematicsGenerator::SpectralFuncExperimentalCode(
      interaction->KinePtr()->SetQ2(gQ2tilde);
 
      //-- Computing cross section for the current kinematics
-     xsec = fXSecModel->XSec(interaction, kPSQ2fE);
+     xsec = this->EvalXSec(interaction, kPSQ2fE);
 
      //-- Decide whether to accept the current kinematics
 //     if(!fGenerateUniformly) {
@@ -501,7 +503,7 @@ double DMELKinematicsGenerator::ComputeMaxXSec(
   for(int i=0; i<N; i++) {
      double Q2 = TMath::Exp(logQ2min + i * dlogQ2);
      interaction->KinePtr()->SetQ2(Q2);
-     double xsec = fXSecModel->XSec(interaction, kPSQ2fE);
+     double xsec = this->EvalXSec(interaction, kPSQ2fE);
 #ifdef __GENIE_LOW_LEVEL_MESG_ENABLED__
      LOG("DMELKinematics", pDEBUG)  << "xsec(Q2= " << Q2 << ") = " << xsec;
 #endif
@@ -518,7 +520,7 @@ double DMELKinematicsGenerator::ComputeMaxXSec(
 	 Q2 = TMath::Exp(TMath::Log(Q2) - dlogQ2);
          if(Q2 < rQ2.min) continue;
          interaction->KinePtr()->SetQ2(Q2);
-         xsec = fXSecModel->XSec(interaction, kPSQ2fE);
+         xsec = this->EvalXSec(interaction, kPSQ2fE);
 #ifdef __GENIE_LOW_LEVEL_MESG_ENABLED__
          LOG("DMELKinematics", pDEBUG)  << "xsec(Q2= " << Q2 << ") = " << xsec;
 #endif
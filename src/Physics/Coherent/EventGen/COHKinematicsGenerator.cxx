@@ -120,6 +120,7 @@ void COHKinematicsGenerator::CalculateKin_BergerSehgal(GHepRecord * evrec) const
 
   while(1) {
     iter++;
+    this->CountRejectionIteration();
     if(iter > kRjMaxIterations) this->throwOnTooManyIterations(iter,evrec);
 
     //-- Select unweighted kinematics using importance sampling method.
@@ -137,7 +138,7 @@ void COHKinematicsGenerator::CalculateKin_BergerSehgal(GHepRecord * evrec) const
     kinematics::UpdateXFromQ2Y(interaction);
 
     // computing cross section for the current kinematics
-    xsec = fXSecModel->XSec(interaction, kPSQ2yfE);
+    xsec = this->EvalXSec(interaction, kPSQ2yfE);
 
     //-- decide whether to accept the current kinematics
     accept = (xsec_max * rnd->RndKine().Rndm() < xsec);
@@ -239,6 +240,7 @@ void COHKinematicsGenerator::CalculateKin_BergerSehgalFM(GHepRecord * evrec) con
 
   while(1) {
     iter++;
+    this->CountRejectionIteration();
     if(iter > kRjMaxIterations) this->throwOnTooManyIterations(iter,evrec);
 
     //-- Select unweighted kinematics using importance sampling method.
@@ -257,7 +259,7 @@ void COHKinematicsGenerator::CalculateKin_BergerSehgalFM(GHepRecord * evrec) con
     interaction->KinePtr()->SetQ2(gQ2);
 
     // computing cross section for the current kinematics
-    xsec = fXSecModel->XSec(interaction, kPSxyfE);
+    xsec = this->EvalXSec(interaction, kPSxyfE);
 
     //-- decide whether to accept the current kinematics
     accept = (xsec_max * rnd->RndKine().Rndm() < xsec);
@@ -327,6 +329,7 @@ void COHKinematicsGenerator::CalculateKin_ReinSehgal(GHepRecord * evrec) const
 
   while(1) {
     iter++;
+    this->CountRejectionIteration();
     if(iter > kRjMaxIterations) this->throwOnTooManyIterations(iter,evrec);
 
     if(fGenerateUniformly) {
@@ -355,7 +358,7 @@ void COHKinematicsGenerator::CalculateKin_ReinSehgal(GHepRecord * evrec) const
     interaction->KinePtr()->Sety(gy);
 
     // computing cross section for the current kinematics
-    xsec = fXSecModel->XSec(interaction, kPSxyfE);
+    xsec = this->EvalXSec(interaction, kPSxyfE);
 
     //-- decide whether to accept the current kinematics
     if(!fGenerateUniformly) {
@@ -486,6 +489,7 @@ void COHKinematicsGenerator::CalculateKin_AlvarezRuso(GHepRecord * evrec) const
 
   while(1) {
     iter++;
+    this->CountRejectionIteration();
     if(iter > kRjMaxIterations) this->throwOnTooManyIterations(iter,evrec);
 
     //Select kinematic point
@@ -506,7 +510,7 @@ void COHKinematicsGenerator::CalculateKin_AlvarezRuso(GHepRecord * evrec) const
                         interaction, interaction->KinePtr());
 
     // computing cross section for the current kinematics
-    xsec = fXSecModel->XSec(interaction,kPSElOlOpifE) / (1E-38 * units::cm2);
+    xsec = this->EvalXSec(interaction,kPSElOlOpifE) / (1E-38 * units::cm2);
 
     if (!fGenerateUniformly) {
       //-- decide whether to accept the current kinematics
@@ -740,7 +744,7 @@ double COHKinematicsGenerator::MaxXSec_BergerSehgal(const Interaction * in) cons
       kinematics::UpdateXFromQ2Y(in);
 
       // Note: We're not stepping through log Q^2, log y - we "unpacked"
-      double xsec = fXSecModel->XSec(in, kPSQ2yfE);
+      double xsec = this->EvalXSec(in, kPSQ2yfE);
 #ifdef __GENIE_LOW_LEVEL_MESG_ENABLED__
       LOG("COHKinematics", pDEBUG)
         << "xsec(Q2= " << Q2 << ", y= " << gy << ", t = " << gt << ") = " << xsec;
@@ -793,7 +797,7 @@ double COHKinematicsGenerator::MaxXSec_BergerSehgalFM(const Interaction * in) co
         in->KinePtr()->Sety(gy);
         in->KinePtr()->Sett(gt);
 
-        double xsec = fXSecModel->XSec(in, kPSxyfE);
+        double xsec = this->EvalXSec(in, kPSxyfE);
 #ifdef __GENIE_LOW_LEVEL_MESG_ENABLED__
         LOG("COHKinematics", pDEBUG)
           << "xsec(Q2= " << Q2 << ", y= " << gy << ", t = " << gt << ") = " << xsec;
@@ -836,7 +840,7 @@ double COHKinematicsGenerator::MaxXSec_ReinSehgal(const Interaction * in) const
       in->KinePtr()->Setx(gx);
       in->KinePtr()->Sety(gy);
 
-      double xsec = fXSecModel->XSec(in, kPSxyfE);
+      double xsec = this->EvalXSec(in, kPSxyfE);
 #ifdef __GENIE_LOW_LEVEL_MESG_ENABLED__
       LOG("COHKinematics", pDEBUG)
         << "xsec(x= " << gx << ", y= " << gy << ") = " << xsec;
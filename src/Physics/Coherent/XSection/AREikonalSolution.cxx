@@ -12,6 +12,7 @@
 #include <TMath.h>
 
 #include <cstdlib>
+#include <vector>
 
 #include "Framework/Numerical/IntegrationTools.h"
 #include "Physics/Coherent/XSection/AREikonalSolution.h"
@@ -25,77 +26,97 @@ namespace alvarezruso {
 cdouble AREikonalSolution::Element(const double radius, const double cosine_rz,
                                    const double e_pion)
 {
+  cdouble uwaveik;
+  this->Elements(e_pion, 1, &radius, &cosine_rz, &uwaveik, false);
+  return uwaveik;
+}
 
+
+double AREikonalSolution::PionMomentum(const double e_pion)
+{
   const double mpik = this->Parent()->GetPiMass();
   const double mpi = this->Con()->PiPMass();
   const double hb = this->Con()->HBar() * 1000.0;
 
-  const double r = (radius);
+  const double ekin = (e_pion - mpik) * hb;
+  const double omepi = ekin / hb + mpi;
+  return TMath::Sqrt(omepi*omepi - mpi*mpi);
+}
+
+
+void AREikonalSolution::Elements(const double e_pion, const unsigned int n,
+                                 const double * radius, const double * cosine_rz,
+                                 cdouble * result, const bool distortion_only)
+{
+  // Quantities depending only on the pion energy are shared by all points
+  const double mpik = this->Parent()->GetPiMass();
+  const double mpi = this->Con()->PiPMass();
+  const double hb = this->Con()->HBar() * 1000.0;
 
   const double ekin = (e_pion - mpik) * hb;
+  const double omepi = ekin / hb + mpi;
+  const double ppim = TMath::Sqrt(omepi*omepi - mpi*mpi);
 
-  const double cosa = cosine_rz;
+  OsetParams oset;
+  this->OsetSalcedo(omepi, oset);
 
   const double rmax = this->Nucleus()->RadiusMax();
 
   const unsigned int nz = 1;
 
-  const double za = r * cosa;
-  const double be = r * TMath::Sqrt(1.0 - cosa*cosa);
-  const double omepi = ekin / hb + mpi;
-  const double ppim = TMath::Sqrt(omepi*omepi - mpi*mpi);
   unsigned int sampling = (this->Nucleus())->GetSampling();
 
-  double absiz[sampling];
-  double decoy[sampling];
+  std::vector<double>  absiz(sampling);
+  std::vector<double>  decoy(sampling);
+  std::vector<cdouble> ordez(sampling);
 
   unsigned int junk;
 
-  integrationtools::SGNR(za, rmax, nz, sampling, absiz, junk, decoy);
-
-  //do i=1,nzs
-//  cdouble ordez[sampling];
-  cdouble * ordez = new cdouble[sampling]; // CA
-  double zp, rp;
-  cdouble piself;
-
   unsigned int A = fNucleus->A();
   unsigned int Z = fNucleus->Z();
 
-  for(unsigned int i = 0; i != sampling; ++i)
+  for(unsigned int k = 0; k != n; ++k)
   {
-    // Sample point in nucleus
-    zp = absiz[i];
+    const double r = radius[k];
+    const double cosa = cosine_rz[k];
 
-    // Radius in nucleus
-    rp = TMath::Sqrt( be*be + zp*zp );
+    const double za = r * cosa;
+    const double be = r * TMath::Sqrt(1.0 - cosa*cosa);
 
-    // Get nuclear densities
-    double dens_cent = fNucleus->CalcNumberDensity(rp);
-    double dens_p_cent = dens_cent * Z / A ;
-    double dens_n_cent = dens_cent * (A-Z)/A;
+    integrationtools::SGNR(za, rmax, nz, sampling, &absiz[0], junk, &decoy[0]);
 
-    // Calculate pion self energy
-    piself = this->PionSelfEnergy(dens_p_cent, dens_n_cent, omepi, ppim);
+    //do i=1,nzs
+    for(unsigned int i = 0; i != sampling; ++i)
+    {
+      // Sample point in nucleus
+      double zp = absiz[i];
 
-    // Optical potential at each point in the nucleus
-    ordez[i] = piself / 2.0 / ppim;
+      // Radius in nucleus
+      double rp = TMath::Sqrt( be*be + zp*zp );
 
-  }
+      // Get nuclear densities
+      double dens_cent = fNucleus->CalcNumberDensity(rp);
+      double dens_p_cent = dens_cent * Z / A ;
+      double dens_n_cent = dens_cent * (A-Z)/A;
 
-  //Integrate the optical potential through the nucleus
-  cdouble resu = integrationtools::RGN1D(za, rmax, nz, sampling, ordez);
+      // Calculate pion self energy
+      cdouble piself = this->PionSelfEnergy(dens_p_cent, dens_n_cent, omepi, ppim, oset);
 
-  // Eikonal approximation to the wave function
-  cdouble uwaveik = exp( - cdouble(0,1) * ( ppim*za + resu ) );
+      // Optical potential at each point in the nucleus
+      ordez[i] = piself / 2.0 / ppim;
+    }
 
-  delete [] ordez; // CA
+    //Integrate the optical potential through the nucleus
+    cdouble resu = integrationtools::RGN1D(za, rmax, nz, sampling, &ordez[0]);
 
-  return uwaveik;
+    // Eikonal approximation to the wave function
+    if( distortion_only ) result[k] = exp( - cdouble(0,1) * resu );
+    else                  result[k] = exp( - cdouble(0,1) * ( ppim*za + resu ) );
+  }
 }
 
 
-cdouble AREikonalSolution::PionSelfEnergy(const double rhop_cent, const double rhon_cent, const double omepi, const double ppim)
+cdouble AREikonalSolution::PionSelfEnergy(const double rhop_cent, const double rhon_cent, const double omepi, const double ppim, const OsetParams& oset)
 {
   const double rho0 = this->Con()->Rho0();
   const double mn = this->Con()->NucleonMass();
@@ -118,7 +139,7 @@ cdouble AREikonalSolution::PionSelfEnergy(const double rhop_cent, const double r
   const double sqsdel = TMath::Sqrt(sdel);
 
   double gamdpb, imsig;
-  this->Deltamed(sdel, pf, rat, gamdpb, imsig, ppim, omepi);
+  this->Deltamed(sdel, pf, rat, gamdpb, imsig, ppim, omepi, oset);
 
   const cdouble pe = -1./6./pi*fs_mpi2*
     ( rhop_cent/(sqsdel-mdel-resig*(2.*rhon_cent/rho0)+ui*(gamdpb/2.-imsig)) +
@@ -134,7 +155,7 @@ cdouble AREikonalSolution::PionSelfEnergy(const double rhop_cent, const double r
 }
 
 
-void AREikonalSolution::Deltamed(const double sdel, const double pf, const double rat, double& gamdpb, double& imsig, const double ppim, const double omepi)
+void AREikonalSolution::Deltamed(const double sdel, const double pf, const double rat, double& gamdpb, double& imsig, const double ppim, const double omepi, const OsetParams& oset)
 {
   unsigned int iapr = 1; // approximation chosen to calculate gamdpb
 
@@ -181,8 +202,13 @@ void AREikonalSolution::Deltamed(const double sdel, const double pf, const doubl
     gamdpb = gamdfree * f;
   }
 
-  //Calculation of the delta selfenergy
+  //Calculation of the delta selfenergy: imaginary part
+  imsig = - ( oset.cq*TMath::Power(rat,oset.alpha) + oset.ca2*TMath::Power(rat, oset.beta) + oset.ca3*TMath::Power(rat,oset.gamma) );
+}
+
 
+void AREikonalSolution::OsetSalcedo(const double omepi, OsetParams& oset)
+{
   // Imaginary part: using Oset, Salcedo, NPA 468(87)631
   // Using eq. (3.5) to relate the energy of the delta with the pion energy used
   // in the parametrization
@@ -204,15 +230,13 @@ void AREikonalSolution::Deltamed(const double sdel, const double pf, const doubl
   if( ome >= (mpi + 315.0 / hb) ) ome = mpi + 315.0 / hb;
 
   // The parameterization of Oset, Salcedo, with ca3 extrapolated to zero at low kin. energies
-  const double cq   = this->Cc(-5.19,15.35,2.06,ome)/hb;
-  const double ca2  = this->Cc(1.06,-6.64,22.66,ome)/hb;
-  double ca3  = this->Cc(-13.46,46.17,-20.34,ome)/hb;
-  const double alpha= this->Cc(0.382,-1.322,1.466,ome);
-  const double beta = this->Cc(-0.038,0.204,0.613,ome);
-  const double gamma=2.*beta;
-  if( ome <= (mpi + 85.0/hb) ) ca3 = this->Cc(-13.46,46.17,-20.34,(mpi+85./hb))/85.*(ome-mpi);
-
-  imsig = - ( cq*TMath::Power(rat,alpha) + ca2*TMath::Power(rat, beta) + ca3*TMath::Power(rat,gamma) );
+  oset.cq   = this->Cc(-5.19,15.35,2.06,ome)/hb;
+  oset.ca2  = this->Cc(1.06,-6.64,22.66,ome)/hb;
+  oset.ca3  = this->Cc(-13.46,46.17,-20.34,ome)/hb;
+  oset.alpha= this->Cc(0.382,-1.322,1.466,ome);
+  oset.beta = this->Cc(-0.038,0.204,0.613,ome);
+  oset.gamma=2.*oset.beta;
+  if( ome <= (mpi + 85.0/hb) ) oset.ca3 = this->Cc(-13.46,46.17,-20.34,(mpi+85./hb))/85.*(ome-mpi);
 }
 
 
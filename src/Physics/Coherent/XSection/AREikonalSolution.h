@@ -41,6 +41,10 @@ class AREikonalSolution: public ARWFSolution
     virtual ~AREikonalSolution();
     virtual std::complex<double>  Element(const double radius, const double cosine_rz,
                  const double e_pion);
+    virtual void Elements(const double e_pion, const unsigned int n, const double * radius,
+                          const double * cosine_rz, std::complex<double> * result,
+                          const bool distortion_only);
+    virtual double PionMomentum(const double e_pion);
     void Solve();
 
   private:
@@ -49,10 +53,17 @@ class AREikonalSolution: public ARWFSolution
     ARSampledNucleus* Nucleus() { return fNucleus; }
     ARConstants* Con() { return this->constants_; }
 
+    // Density independent parameters of the Delta self energy (Oset, Salcedo),
+    // computed once per pion energy
+    struct OsetParams {
+      double cq, ca2, ca3, alpha, beta, gamma;
+    };
+    void OsetSalcedo(const double omepi, OsetParams& oset);
+
     std::complex<double>  PionSelfEnergy(const double rhop_cent, const double rhon_cent,
-                const double omepi, const double ppim);
+                const double omepi, const double ppim, const OsetParams& oset);
     void Deltamed(const double sdel, const double pf, const double rat, double& gamdpb,
-            double& imsig, const double ppim, const double omepi);
+            double& imsig, const double ppim, const double omepi, const OsetParams& oset);
     double Cc(const double a, const double b, const double c, const double ome);
     double Gamd(const double s);
     double Qcm(const double s);
@@ -127,6 +127,11 @@ void ARSampledNucleus::Fill()
 
   fR_max = 3.0 * TMath::Power(this->A(), (1.0/3.0));
 
+  // Normalisations are integrated once here rather than at every density
+  // evaluation (the wavefunction solver asks for many)
+  fDensity0        = Density0(fA,fNucRadius,fDiffuseness);
+  fDensity0Centres = Density0(fA,fRadiusCentres,fDiffusenessCentres);
+
 #ifdef __GENIE_LOW_LEVEL_MESG_ENABLED__
   LOG("AR_PiWFunction_Table", pDEBUG)<< "N:: fR_max = " << fR_max
   << "N:: z = " << fZ
@@ -214,7 +219,7 @@ unsigned int ARSampledNucleus::GetNDensities(void) const
   return fNDensities;
 }
 
-double ARSampledNucleus::CalcDensity(double r, double nuc_rad, double nuc_diff) const
+double ARSampledNucleus::CalcDensity(double r, double nuc_rad, double nuc_diff, double dens_0) const
 {
   double dens_rel;
   if (fUseHarmonicOscillator) {
@@ -225,8 +230,6 @@ double ARSampledNucleus::CalcDensity(double r, double nuc_rad, double nuc_diff)
   }
 
   //~ double dens_0  = utils::nuclear::Density(nuc_rad, fA);
-  double dens_0  = Density0(fA,nuc_rad,nuc_diff);
-
   return dens_0 * dens_rel;
 }
 
@@ -277,12 +280,12 @@ Double_t ARSampledNucleus::Density0FunctionFermiLiquid(Double_t* r_, Double_t* p
 
 double ARSampledNucleus::CalcMatterDensity(double r) const
 {
-  return this->CalcDensity(r,fNucRadius,fDiffuseness);
+  return this->CalcDensity(r,fNucRadius,fDiffuseness,fDensity0);
 }
 
 double ARSampledNucleus::CalcNumberDensity(double r) const
 {
-  return this->CalcDensity(r,fRadiusCentres,fDiffusenessCentres);
+  return this->CalcDensity(r,fRadiusCentres,fDiffusenessCentres,fDensity0Centres);
 }
 
 } //namespace alvarezruso
@@ -101,8 +101,11 @@ class ARSampledNucleus
     double fRadiusCentres;
   //double fRadiusCentresSq;
     double fUseHarmonicOscillator;
+    // Density0 normalisations, which only depend on the nucleus
+    double fDensity0;
+    double fDensity0Centres;
 
-    double CalcDensity(double radius, double nuc_rad, double nuc_diff) const;
+    double CalcDensity(double radius, double nuc_rad, double nuc_diff, double dens_0) const;
 
     // warning: in-class initializer for static data member of type 'const double' is a GNU extension [-Wgnu-static-float-init]
     // static const double mean_radius_squared = 0.69; // in fermi
@@ -36,6 +36,12 @@ class ARWFSolution
     ARWFSolution(bool debug = false);
     virtual ~ARWFSolution();
     virtual std::complex<double>  Element(const double radius, const double cosine_rz, const double e_pion) = 0;
+    // Solution at n points for the same pion energy. With distortion_only the
+    // free plane wave factor exp(-i p_pi z) is left out.
+    virtual void Elements(const double e_pion, const unsigned int n, const double * radius,
+                          const double * cosine_rz, std::complex<double> * result,
+                          const bool distortion_only) = 0;
+    virtual double PionMomentum(const double e_pion) = 0;
     virtual void Solve() = 0;
     bool debug_;
 };
@@ -17,6 +17,9 @@
 #include <string>
 #include <cstdlib>
 #include <complex>
+#include <map>
+#include <tuple>
+#include <vector>
 
 // Root
 #include <TVector3.h>
@@ -43,6 +46,20 @@ typedef std::complex<double> cdouble;
 typedef ROOT::Math::LorentzVector<ROOT::Math::PxPyPzE4D<double> > LorentzVector;
 typedef ROOT::Math::SVector< cdouble , 4> CVector;
 
+namespace {
+
+  // The distortion grids depend on the nucleus and the pion mass besides the
+  // pion energy, so they are shared by all the cross section objects (which
+  // are recreated for every interaction)
+  typedef std::map<int, std::vector<cdouble> > WfCache_t;
+  typedef std::tuple<unsigned int, unsigned int, double, double> WfCacheKey_t; // Z, A, m_pi, step
+  std::map<WfCacheKey_t, WfCache_t> gWfCaches;
+
+  // Energy nodes kept per cache (each takes 3 x n x n complex numbers)
+  const unsigned int kWfCacheMaxNodes = 1000;
+
+}
+
 namespace genie {
 namespace alvarezruso {
 
@@ -61,6 +78,8 @@ AlvarezRusoCOHPiPDXSec::AlvarezRusoCOHPiPDXSec(unsigned int Z_, unsigned int A_,
   fNucleus   ( new ARSampledNucleus(fZ, fA, fSampling) ),
   fWfsolution ( new AREikonalSolution(debug_, this) ),
   fLastE_pi  (-9999999.),
+  fWfCacheStep(0.),
+  fWfCache   (NULL),
   fUwave      ( new ARWavefunction(fSampling, debug_) ),
   fUwaveDr    ( new ARWavefunction(fSampling, debug_) ),
   fUwaveDtheta( new ARWavefunction(fSampling, debug_) )
@@ -293,24 +312,112 @@ void AlvarezRusoCOHPiPDXSec::SetCurrent()
  * Solve the wavefunctions
  */
 
-/// This is only a function of the nucleus and pion momentum/energy
-/// so if neither of those have changed there is no need to re-calculate
-/// the wavefunction values.
-/// Such a caching has not been implemented here yet!
+void AlvarezRusoCOHPiPDXSec::SetWavefunctionCacheStep(double step)
+{
+  fWfCacheStep = step;
+  fWfCache = (step > 0.0) ? &gWfCaches[WfCacheKey_t(fZ, fA, fM_pi, step)] : NULL;
+  fLastE_pi = -9999999.;
+}
+
+/// This is only a function of the nucleus and pion momentum/energy.
+/// With the cache enabled, the distortion of the wavefunction (a smooth
+/// function of the energy) is interpolated between the cached energy nodes
+/// and multiplied by the free plane wave at the actual pion momentum.
 
 void AlvarezRusoCOHPiPDXSec::SolveWavefunctions()
 {
-  unsigned int n_points = fNucleus->GetNDensities();
+  const unsigned int n_points = fNucleus->GetNDensities();
+  const unsigned int n2 = n_points*n_points;
+  const double e_pi = fP_pi.E();
+
+  if( fWfCache == NULL )
+  {
+    std::vector<cdouble> grids(3*n2);
+    this->SolveWavefunctionGrids(e_pi, false, &grids[0]);
+    for(unsigned int i = 0; i != n_points; ++i)
+    {
+      for(unsigned int j = 0; j != n_points; ++j)
+      {
+        const unsigned int ij = i*n_points + j;
+        fUwave      ->set(i, j, grids[       ij]);
+        fUwaveDr    ->set(i, j, grids[  n2 + ij]);
+        fUwaveDtheta->set(i, j, grids[2*n2 + ij]);
+      }
+    }
+    return;
+  }
+
+  // Energy nodes around e_pi (below the first node the first is used)
+  const double step = fWfCacheStep / (fConstants->HBar() * 1000.0);
+  const double t = (e_pi - fM_pi) / step - 1.0;
+  int k = (int) TMath::Floor(t);
+  double f = t - k;
+  if( k < 0 ) { k = 0; f = 0.0; }
+
+  this->CacheDistortions(k);
+  const std::vector<cdouble> & lo = (*fWfCache)[k];
+  const std::vector<cdouble> & hi = (*fWfCache)[k+1];
+
+  const double ppim = fWfsolution->PionMomentum(e_pi);
+  const cdouble I(0,1);
+
+  for(unsigned int i = 0; i != n_points; ++i)
+  {
+    for(unsigned int j = 0; j != n_points; ++j)
+    {
+      const unsigned int ij = i*n_points + j;
+
+      const cdouble d     = (1.0-f) * lo[       ij] + f * hi[       ij];
+      const cdouble ddr   = (1.0-f) * lo[  n2 + ij] + f * hi[  n2 + ij];
+      const cdouble ddcos = (1.0-f) * lo[2*n2 + ij] + f * hi[2*n2 + ij];
+
+      // za = -radius*cosine_rz along the pion direction (see SolveWavefunctionGrids)
+      const double radius    = fNucleus->Radius(i,j);
+      const double cosine_rz = fNucleus->SamplePoint2(j) / radius;
+      const cdouble plane = exp( -I * ppim * (-radius*cosine_rz) );
+
+      fUwave      ->set(i, j, plane * d);
+      fUwaveDr    ->set(i, j, plane * (ddr   + I * ppim * cosine_rz * d) );
+      fUwaveDtheta->set(i, j, plane * (ddcos + I * ppim * radius    * d) );
+    }
+  }
+}
+
+void AlvarezRusoCOHPiPDXSec::CacheDistortions(int k)
+{
+  // Dropping the whole cache when full is enough: the nodes in use are
+  // recomputed as needed
+  unsigned int nmissing = (fWfCache->count(k) ? 0 : 1) + (fWfCache->count(k+1) ? 0 : 1);
+  if( nmissing == 0 ) return;
+  if( fWfCache->size() + nmissing > kWfCacheMaxNodes )
+  {
+    LOG("AlvarezRusoCOHPiPDXSec",pINFO) << "Wavefunction cache is full -- clearing it";
+    fWfCache->clear();
+  }
 
-  double x2;
-  double radius;
-  double cosine_rz; // angle w.r.t the pion momentum
+  const unsigned int n_points = fNucleus->GetNDensities();
+  const double step = fWfCacheStep / (fConstants->HBar() * 1000.0);
 
-  // for calculating derivatives
-  double delta_r;
-  double delta_c;
-  cdouble uwave_plus;
-  cdouble uwave_minus;
+  for(int kk = k; kk <= k+1; ++kk)
+  {
+    if( fWfCache->count(kk) ) continue;
+    std::vector<cdouble> & grids = (*fWfCache)[kk];
+    grids.resize(3*n_points*n_points);
+    this->SolveWavefunctionGrids(fM_pi + (kk+1)*step, true, &grids[0]);
+  }
+}
+
+void AlvarezRusoCOHPiPDXSec::SolveWavefunctionGrids(double e_pi, bool distortion_only, cdouble * grids)
+{
+  const unsigned int n_points = fNucleus->GetNDensities();
+  const unsigned int n2 = n_points*n_points;
+
+  // Each grid point needs the solution at the point and at the 4 displaced
+  // points of the finite difference derivatives: all 5*n^2 are solved in one go
+  std::vector<double> radii  (5*n2);
+  std::vector<double> cosines(5*n2);
+  std::vector<double> deltas_r(n2);
+  std::vector<double> deltas_c(n2);
 
   // Loop over grid of points in the nuclear potential
   for(unsigned int i = 0; i != n_points; ++i)
@@ -318,41 +425,45 @@ void AlvarezRusoCOHPiPDXSec::SolveWavefunctions()
     for(unsigned int j = 0; j != n_points; ++j)
     {
       //double x1 = fNucleus->SamplePoint1(i); // unused
-      x2 = fNucleus->SamplePoint2(j);
+      double x2 = fNucleus->SamplePoint2(j);
 
       // radius of position in potential from centre
-      radius = fNucleus->Radius(i,j);
+      double radius = fNucleus->Radius(i,j);
       // angle of sampling point wrt to neutrino direction
-      cosine_rz = x2 / radius;
+      double cosine_rz = x2 / radius;
 
-      // Calculate wavefunction
-      fUwave->set(i, j, fWfsolution->Element(radius, -cosine_rz,
-                          fP_pi.E()));
-      delta_r = 0.0001;
+      // for calculating derivatives
+      double delta_r = 0.0001;
       if( radius < delta_r ) delta_r = radius;
 
-      // Calculate derivative of wavefunction in the radial direction
-      uwave_plus  = fWfsolution->Element( (radius+delta_r), -cosine_rz,
-                                     fP_pi.E());
-      uwave_minus = fWfsolution->Element( (radius-delta_r), -cosine_rz,
-                                     fP_pi.E());
-
-      fUwaveDr->set(i, j, (uwave_plus - uwave_minus) / (2.0 * delta_r) );
-
-      // Calculate derivative of wavefunction in the angle space
-      delta_c = 0.0001;
+      double delta_c = 0.0001;
       if     ( (cosine_rz - delta_c) <= -1.0 )  delta_c = cosine_rz + 1.0 - 1E-12;
       else if( (cosine_rz + delta_c) >=  1.0 )  delta_c = 1.0 - cosine_rz - 1E-12;
 
-      uwave_plus  = fWfsolution->Element(radius, -(cosine_rz+delta_c),
-                                        fP_pi.E());
-      uwave_minus = fWfsolution->Element(radius, -(cosine_rz-delta_c),
-                                        fP_pi.E());
-      fUwaveDtheta->set( i, j, (uwave_plus - uwave_minus) / (2.0 * delta_c) );
+      const unsigned int ij = i*n_points + j;
+      deltas_r[ij] = delta_r;
+      deltas_c[ij] = delta_c;
 
+      radii[5*ij  ] = radius;           cosines[5*ij  ] = -cosine_rz;
+      radii[5*ij+1] = radius + delta_r; cosines[5*ij+1] = -cosine_rz;
+      radii[5*ij+2] = radius - delta_r; cosines[5*ij+2] = -cosine_rz;
+      radii[5*ij+3] = radius;           cosines[5*ij+3] = -(cosine_rz+delta_c);
+      radii[5*ij+4] = radius;           cosines[5*ij+4] = -(cosine_rz-delta_c);
     }
   }
 
+  std::vector<cdouble> uwave(5*n2);
+  fWfsolution->Elements(e_pi, 5*n2, &radii[0], &cosines[0], &uwave[0], distortion_only);
+
+  for(unsigned int ij = 0; ij != n2; ++ij)
+  {
+    // Wavefunction
+    grids[ij] = uwave[5*ij];
+    // Derivative of wavefunction in the radial direction
+    grids[n2 + ij] = (uwave[5*ij+1] - uwave[5*ij+2]) / (2.0 * deltas_r[ij]);
+    // Derivative of wavefunction in the angle space
+    grids[2*n2 + ij] = (uwave[5*ij+3] - uwave[5*ij+4]) / (2.0 * deltas_c[ij]);
+  }
 }
 
 cdouble AlvarezRusoCOHPiPDXSec::DeltaPropagatorInMed(LorentzVector delta_momentum)
@@ -30,6 +30,8 @@
 #include "Physics/NuclearState/NuclearUtils.h"
 
 #include <complex>
+#include <map>
+#include <vector>
 
 namespace genie
 {
@@ -58,6 +60,10 @@ class AlvarezRusoCOHPiPDXSec
 
     void SetDebug(bool debug)  {  debug_ = debug;  };
 
+    // Width [MeV] of the pion energy bins of the wavefunction cache, or <=0
+    // to solve the wavefunctions at every pion energy
+    void SetWavefunctionCacheStep(double step);
+
     ARConstants      & GetConstants(void);
     ARSampledNucleus & GetNucleus  (void);
 
@@ -102,6 +108,13 @@ class AlvarezRusoCOHPiPDXSec
         // Fill the wavefunctions
         void SolveWavefunctions();
 
+        // Solve the wavefunction, its radial and its angular derivative on
+        // the nucleus grid (3 consecutive n x n grids) at a pion energy
+        void SolveWavefunctionGrids(double e_pi, bool distortion_only, std::complex<double> * grids);
+
+        // Make sure the distortion grids of energy nodes k and k+1 are cached
+        void CacheDistortions(int k);
+
         //______________________________________________________________
         // Properties
 
@@ -134,6 +147,11 @@ class AlvarezRusoCOHPiPDXSec
 
         double fLastE_pi;
 
+        // Wavefunction cache: distortion grids (wavefunction without the free
+        // plane wave) at the energy nodes E_k = m_pi + (k+1)*step
+        double fWfCacheStep;
+        std::map<int, std::vector<std::complex<double> > > * fWfCache;
+
         // Four-momenta of particles and transfers involved
         ROOT::Math::LorentzVector<ROOT::Math::PxPyPzE4D<double> > fQ;    // momentum-transfer
         ROOT::Math::LorentzVector<ROOT::Math::PxPyPzE4D<double> > fP_nu;    // incoming neutrino
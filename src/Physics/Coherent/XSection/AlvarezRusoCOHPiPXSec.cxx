@@ -43,6 +43,7 @@ XSecAlgorithmI("genie::AlvarezRusoCOHPiPXSec")
 {
   fMultidiff = NULL;
   fLastInteraction = NULL;
+  fWfCacheStep = 1.0;
 }
 //____________________________________________________________________________
 AlvarezRusoCOHPiPXSec::AlvarezRusoCOHPiPXSec(string config) :
@@ -50,6 +51,7 @@ XSecAlgorithmI("genie::AlvarezRusoCOHPiPXSec", config)
 {
   fMultidiff = NULL;
   fLastInteraction = NULL;
+  fWfCacheStep = 1.0;
 }
 //____________________________________________________________________________
 AlvarezRusoCOHPiPXSec::~AlvarezRusoCOHPiPXSec()
@@ -115,6 +117,7 @@ double AlvarezRusoCOHPiPXSec::XSec(
     }
 
     fMultidiff = new AlvarezRusoCOHPiPDXSec(Z, A ,current, flavour, nutype);
+    fMultidiff->SetWavefunctionCacheStep(fWfCacheStep);
     fLastInteraction = interaction;
   }
 
@@ -185,5 +188,8 @@ void AlvarezRusoCOHPiPXSec::LoadConfig(void)
       dynamic_cast<const XSecIntegratorI *> (this->SubAlg("XSec-Integrator"));
   assert(fXSecIntegrator);
 
+  // pion energy binning of the wavefunction cache (<=0 disables it)
+  this->GetParamDef("WavefunctionCache-Step", fWfCacheStep, 1.0);
+
 }
 //____________________________________________________________________________
@@ -56,6 +56,7 @@ private:
 
   mutable alvarezruso::AlvarezRusoCOHPiPDXSec * fMultidiff;
   mutable const Interaction * fLastInteraction;
+  double fWfCacheStep;  ///< pion energy step [MeV] of the wavefunction cache
   //Parameters
   //bool fUseLookupTable;
   //double fa4;
@@ -23,7 +23,11 @@
 #include "Framework/Messenger/Messenger.h"
 #include "Framework/Utils/Cache.h"
 #include "Framework/Utils/CacheBranchFx.h"
+#include "Framework/Utils/CacheBranchEnvelope.h"
+#include "Framework/Utils/MaxXSecTable.h"
+#include "Framework/Utils/PerfMonitor.h"
 #include "Framework/Numerical/MathUtils.h"
+#include "Framework/Numerical/RandomGen.h"
 
 using std::ostringstream;
 using std::map;
@@ -32,26 +36,44 @@ using namespace genie;
 
 //___________________________________________________________________________
 KineGeneratorWithCache::KineGeneratorWithCache() : 
-EventRecordVisitorI(), fSafetyFactor(1.), fNumOfSafetyFactors(-1), fNumOfInterpolatorTypes(-1)
+EventRecordVisitorI(), fSafetyFactor(1.), fNumOfSafetyFactors(-1), fNumOfInterpolatorTypes(-1),
+fXSecBatchSize(1), fXSecBatchNTrials(0), fXSecBatchNEvents(0), fUseAdaptiveEnvelope(false), fEnvelopeNCalls(0), fEnvelopeNTrials(0), fEnvelopeNAccepted(0),
+fEnvelopeNOverweight(0), fEnvelopeNRebuilds(0), fMaxXSecHashModel(0), fMaxXSecHash(0), fPerfVisitor(0), fPerfXSec(0),
+fPerfXSecModel(0)
 {
 
 }
 //___________________________________________________________________________
 KineGeneratorWithCache::KineGeneratorWithCache(string name) : 
-EventRecordVisitorI(name), fSafetyFactor(1.), fNumOfSafetyFactors(-1), fNumOfInterpolatorTypes(-1)
+EventRecordVisitorI(name), fSafetyFactor(1.), fNumOfSafetyFactors(-1), fNumOfInterpolatorTypes(-1),
+fXSecBatchSize(1), fXSecBatchNTrials(0), fXSecBatchNEvents(0), fUseAdaptiveEnvelope(false), fEnvelopeNCalls(0), fEnvelopeNTrials(0), fEnvelopeNAccepted(0),
+fEnvelopeNOverweight(0), fEnvelopeNRebuilds(0), fMaxXSecHashModel(0), fMaxXSecHash(0), fPerfVisitor(0), fPerfXSec(0),
+fPerfXSecModel(0)
 {
 
 }
 //___________________________________________________________________________
 KineGeneratorWithCache::KineGeneratorWithCache(string name, string config) : 
-EventRecordVisitorI(name, config), fSafetyFactor(1.), fNumOfSafetyFactors(-1), fNumOfInterpolatorTypes(-1)
+EventRecordVisitorI(name, config), fSafetyFactor(1.), fNumOfSafetyFactors(-1), fNumOfInterpolatorTypes(-1),
+fXSecBatchSize(1), fXSecBatchNTrials(0), fXSecBatchNEvents(0), fUseAdaptiveEnvelope(false), fEnvelopeNCalls(0), fEnvelopeNTrials(0), fEnvelopeNAccepted(0),
+fEnvelopeNOverweight(0), fEnvelopeNRebuilds(0), fMaxXSecHashModel(0), fMaxXSecHash(0), fPerfVisitor(0), fPerfXSec(0),
+fPerfXSecModel(0)
 {
 
 }
 //___________________________________________________________________________
 KineGeneratorWithCache::~KineGeneratorWithCache()
 {
-
+  if(fEnvelopeNTrials > 0) {
+    LOG("Kinematics", pNOTICE)
+      << "Adaptive envelope sampling for " << this->Id().Key() << ": "
+      << fEnvelopeNAccepted << " accepted / " << fEnvelopeNTrials
+      << " trials (efficiency = " << (double)fEnvelopeNAccepted/fEnvelopeNTrials
+      << "), xsec calls / event = "
+      << ((fEnvelopeNAccepted > 0) ? (double)fEnvelopeNCalls/fEnvelopeNAccepted : 0.)
+      << ", overweight points = " << fEnvelopeNOverweight
+      << ", envelopes retrained = " << fEnvelopeNRebuilds;
+  }
 }
 //___________________________________________________________________________
 double KineGeneratorWithCache::MaxXSec(GHepRecord * event_rec, const int nkey) const
@@ -221,6 +243,20 @@ double KineGeneratorWithCache::Energy(const Interaction * interaction) const
   return E;
 }
 //___________________________________________________________________________
+bool KineGeneratorWithCache::MaxXSecIsPrecomputable(
+                                      const Interaction * interaction) const
+{
+// Whether the max xsec (for nkey 0) computed for a bare interaction, with the
+// hit nucleon at rest and no event-time state, is the one computed during
+// event generation and can be taken from a precomputed max xsec table.
+// Not so for nucleons bound in a nucleus, which are off-shell and moving when
+// the kinematics are generated. Kinematic generators whose max xsec depends
+// on state set while processing the event record should override this method
+
+  const Target & tgt = interaction->InitState().Tgt();
+  return !(tgt.IsNucleus() && tgt.HitNucIsSet());
+}
+//___________________________________________________________________________
 CacheBranchFx * KineGeneratorWithCache::AccessCacheBranch(
                                       const Interaction * interaction, const int nkey) const
 {
@@ -229,10 +265,7 @@ CacheBranchFx * KineGeneratorWithCache::AccessCacheBranch(
 
   Cache * cache = Cache::Instance();
 
-  // build the cache branch key as: namespace::algorithm/config/interaction/nkey
-  string algkey = this->Id().Key();
-  string intkey = interaction->AsString();
-  string key    = cache->CacheBranchKey(algkey, intkey, std::to_string(nkey));
+  const string & key = this->CacheBranchKey(interaction, nkey);
 
   CacheBranchFx * cache_branch =
               dynamic_cast<CacheBranchFx *> (cache->FindCacheBranch(key));
@@ -243,12 +276,136 @@ CacheBranchFx * KineGeneratorWithCache::AccessCacheBranch(
 
     cache_branch = new CacheBranchFx("Max over phase space");
     cache->AddCacheBranch(key, cache_branch);
+
+    if(nkey == 0 && this->MaxXSecIsPrecomputable(interaction)) {
+      this->WarmStartCacheBranch(key, cache_branch, nkey);
+    }
   }
   assert(cache_branch);
 
   return cache_branch;
 }
 //___________________________________________________________________________
+const string & KineGeneratorWithCache::CacheBranchKey(
+                                      const Interaction * interaction, const int nkey) const
+{
+// Builds the cache branch key as: namespace::algorithm/config/interaction/nkey
+
+  return this->InternedKey(fCacheBranchKeys, interaction, nkey, std::to_string(nkey));
+}
+//___________________________________________________________________________
+const string & KineGeneratorWithCache::InternedKey(
+  map<pair<ULong64_t,int>, pair<vector<int>, string> > & keys,
+  const Interaction * interaction, int n, const string & subkey) const
+{
+// Cache branch key namespace::algorithm/config/interaction/subkey, built once
+// per interaction & n and then looked-up by fingerprint. A hit is confirmed
+// against the fingerprinted fields: colliding interactions have their key
+// built every time
+
+  pair<ULong64_t,int> id(interaction->Fingerprint(), n);
+  interaction->FingerprintFields(fFieldsBuffer);
+  map<pair<ULong64_t,int>, pair<vector<int>, string> >::const_iterator kiter =
+                                                               keys.find(id);
+  if(kiter == keys.end()) {
+    string algkey = this->Id().Key();
+    string intkey = interaction->AsString();
+    kiter = keys.insert(
+              map<pair<ULong64_t,int>, pair<vector<int>, string> >::value_type(
+                id, std::make_pair(fFieldsBuffer,
+                      Cache::Instance()->CacheBranchKey(algkey, intkey, subkey)))).first;
+  }
+  else if(kiter->second.first != fFieldsBuffer) {
+    LOG("Kinematics", pWARN)
+      << "Interaction fingerprint collision: " << interaction->AsString();
+    fCollidingKey = Cache::Instance()->CacheBranchKey(
+                      this->Id().Key(), interaction->AsString(), subkey);
+    return fCollidingKey;
+  }
+  return kiter->second.second;
+}
+//___________________________________________________________________________
+uint64_t KineGeneratorWithCache::MaxXSecConfigHash(void) const
+{
+// Hash of the configuration of this generator and of the current xsec model,
+// tagging the entries of precomputed max xsec tables
+
+  if(fXSecModel != fMaxXSecHashModel || fMaxXSecHash == 0) {
+    ostringstream config;
+    config << this->Id().Key() << "\n" << this->GetConfig();
+    if(fXSecModel) {
+      config << fXSecModel->Id().Key() << "\n" << fXSecModel->GetConfig();
+    }
+    fMaxXSecHash      = MaxXSecTable::Hash(config.str());
+    fMaxXSecHashModel = fXSecModel;
+  }
+  return fMaxXSecHash;
+}
+//___________________________________________________________________________
+void KineGeneratorWithCache::WarmStartCacheBranch(
+                 const string & key, CacheBranchFx * cb, const int nkey) const
+{
+// Fills a new cache branch with the matching entry of the precomputed max
+// xsec table, if any
+
+  MaxXSecTable * table = MaxXSecTable::Instance();
+  if(!table->IsLoaded() || !fXSecModel) return;
+
+  int n = 0;
+  const double * E    = 0;
+  const double * xsec = 0;
+  if(!table->Find(key, this->MaxXSecConfigHash(), n, E, xsec)) return;
+
+  for(int i = 0; i < n; i++) {
+    if(xsec[i] > 0) cb->AddValues(E[i], xsec[i]);
+  }
+  // interpolated only with as many points as values cached one at a time
+  // (see CacheMaxXSec), as fewer knots can undershoot the max between them
+  if( (int) cb->Map().size() >= MaxXSecTable::kNMinInterpolation ) {
+    cb->CreateSpline(nkey<=fNumOfInterpolatorTypes-1?vInterpolatorTypes[nkey]:"");
+  }
+
+  LOG("Kinematics", pINFO)
+    << "Warm-started cache branch " << key << " with " << n
+    << " precomputed max xsec values";
+}
+//___________________________________________________________________________
+bool KineGeneratorWithCache::AddToMaxXSecTable(
+   const XSecAlgorithmI * xsec_model, const Interaction * in,
+   const vector<double> & Ev, MaxXSecTable * table) const
+{
+  if(!this->MaxXSecIsPrecomputable(in)) {
+    LOG("Kinematics", pINFO)
+      << "Max xsec depends on the event state - Not tabulated for "
+      << this->Id().Key() << " / " << in->AsString();
+    return false;
+  }
+
+  fXSecModel = xsec_model;
+
+  Interaction interaction(*in);
+
+  vector<double> E, xsec;
+  for(unsigned int i = 0; i < Ev.size(); i++) {
+    interaction.InitStatePtr()->SetProbeE(Ev[i]);
+    double e = this->Energy(&interaction);
+    if(e < fEMin) continue;
+    double max_xsec = this->ComputeMaxXSec(&interaction);
+    if(max_xsec <= 0) continue;
+    E   .push_back(e);
+    xsec.push_back(max_xsec);
+  }
+  if(E.size() == 0) return false;
+
+  const string & key = this->CacheBranchKey(&interaction, 0);
+  table->Add(key, this->MaxXSecConfigHash(), E, xsec);
+
+  LOG("Kinematics", pNOTICE)
+    << "Computed " << E.size() << " max xsec values for " << key;
+
+  return true;
+}
+//___________________________________________________________________________
 void KineGeneratorWithCache::AssertXSecLimits(
          const Interaction * interaction, double xsec, double xsec_max) const
 {
@@ -292,3 +449,178 @@ double KineGeneratorWithCache::ComputeMaxXSec (const Interaction * in, const int
   }
 }
 //___________________________________________________________________________
+void KineGeneratorWithCache::LoadAdaptiveEnvelopeConfig(void)
+{
+// Reads the adaptive envelope sampling options. To be called from the
+// LoadConfig() of the concrete generators that support it.
+
+  this->GetParamDef("AdaptiveEnvelope",                fUseAdaptiveEnvelope,           false);
+  this->GetParamDef("AdaptiveEnvelope-NCells",         fAdaptiveEnvelopeNCells,        64);
+  this->GetParamDef("AdaptiveEnvelope-NWarmUp",        fAdaptiveEnvelopeNWarmUp,       32);
+  this->GetParamDef("AdaptiveEnvelope-BinsPerDecade",  fAdaptiveEnvelopeBinsPerDecade, 20);
+  this->GetParamDef("AdaptiveEnvelope-SafetyFactor",   fAdaptiveEnvelopeSafetyFactor,  1.2);
+
+  assert(fAdaptiveEnvelopeNCells        > 0);
+  assert(fAdaptiveEnvelopeNWarmUp       > 1);
+  assert(fAdaptiveEnvelopeBinsPerDecade > 0);
+  assert(fAdaptiveEnvelopeSafetyFactor >= 1);
+
+  fEnvelopeKeys.clear();
+}
+//___________________________________________________________________________
+bool KineGeneratorWithCache::UseAdaptiveEnvelope(
+                                      const Interaction * interaction) const
+{
+// Envelopes are only used above the minimum energy for which max xsec values
+// are cached, and never when generating uniformly over the phase space
+
+  if(!fUseAdaptiveEnvelope || fGenerateUniformly) return false;
+  return (this->Energy(interaction) >= fEMin);
+}
+//___________________________________________________________________________
+CacheBranchEnvelope * KineGeneratorWithCache::AccessAdaptiveEnvelope(
+  const Interaction * interaction, const Range1D_t & xr, const Range1D_t & yr,
+  EnvelopeFunc_t f) const
+{
+// Returns the envelope for this algorithm, interaction and energy bin. If no
+// envelope is found then one is trained on the input function over the input
+// limits (xr, yr) and cached. The limits vary within an energy bin (and with
+// the hit nucleon): an envelope whose domain does not contain them is
+// retrained over the union of its domain and the input limits. The domain
+// is padded so that small changes do not trigger another training.
+// The input function should return 0 outside the input limits.
+
+  Cache * cache = Cache::Instance();
+
+  double E = this->Energy(interaction);
+  int ebin = TMath::FloorNint(TMath::Log10(E) * fAdaptiveEnvelopeBinsPerDecade);
+
+  const string & key = this->InternedKey(
+           fEnvelopeKeys, interaction, ebin, "envelope" + std::to_string(ebin));
+
+  CacheBranchEnvelope * envelope =
+              dynamic_cast<CacheBranchEnvelope *> (cache->FindCacheBranch(key));
+  if(!envelope) {
+    LOG("Kinematics", pINFO) << "Creating envelope cache branch - key = " << key;
+    envelope = new CacheBranchEnvelope("Adaptive envelope");
+    cache->AddCacheBranch(key, envelope);
+  }
+  if(!envelope->Covers(xr, yr)) {
+    Range1D_t dx = xr, dy = yr;
+    if(envelope->IsTrained()) {
+      dx.min = TMath::Min(dx.min, envelope->XDomain().min);
+      dx.max = TMath::Max(dx.max, envelope->XDomain().max);
+      dy.min = TMath::Min(dy.min, envelope->YDomain().min);
+      dy.max = TMath::Max(dy.max, envelope->YDomain().max);
+      fEnvelopeNRebuilds++;
+      LOG("Kinematics", pINFO)
+        << "Limits not contained in the envelope domain - Retraining " << key;
+    }
+    const double pad = 0.02;
+    double px = pad * (dx.max - dx.min);
+    double py = pad * (dy.max - dy.min);
+    dx.min -= px; dx.max += px;
+    dy.min -= py; dy.max += py;
+    envelope->Build(f, dx, dy,
+       fAdaptiveEnvelopeNCells, fAdaptiveEnvelopeNWarmUp,
+       fAdaptiveEnvelopeSafetyFactor, RandomGen::Instance()->RndKine());
+    fEnvelopeNCalls += envelope->NWarmUpCalls();
+  }
+  return envelope;
+}
+//___________________________________________________________________________
+bool KineGeneratorWithCache::AdaptiveEnvelopeAccept(
+   CacheBranchEnvelope * env, int cell, double xsec) const
+{
+// Accept / reject a point drawn from an adaptive envelope (the current
+// envelope of the cell is used, as it may have been raised since the point
+// was drawn). If the xsec exceeds the envelope, the envelope of that cell is
+// raised and the point is rejected: events are never weighted.
+
+  env->CountTrial();
+  fEnvelopeNTrials++;
+  fEnvelopeNCalls++;
+
+  if(xsec <= 0) return false;
+
+  double envelope = env->Envelope(cell);
+  if(xsec > envelope) {
+    env->Raise(cell, fAdaptiveEnvelopeSafetyFactor * xsec);
+    env->CountOverweight();
+    fEnvelopeNOverweight++;
+    LOG("Kinematics", pWARN)
+      << "xsec: (curr) = " << xsec << " > (envelope) = " << envelope
+      << " - Raised the envelope and rejected the point";
+    return false;
+  }
+
+  double t = envelope * RandomGen::Instance()->RndKine().Rndm();
+  if(t >= xsec) return false;
+
+  env->CountAccepted();
+  fEnvelopeNAccepted++;
+  return true;
+}
+//___________________________________________________________________________
+double KineGeneratorWithCache::EvalXSec(
+  const Interaction * in, KinePhaseSpace_t k) const
+{
+  PerfCounter * perf = this->XSecPerfCounter();
+  perf->Count();
+  PerfTimer timer(perf);
+  return fXSecModel->XSec(in, k);
+}
+//___________________________________________________________________________
+void KineGeneratorWithCache::EvalXSecBatch(
+  Interaction * in, KinePhaseSpace_t k, const KineVar_t * vars, int nvar,
+  int n, const double * pts, double * xsec) const
+{
+  PerfCounter * perf = this->XSecPerfCounter();
+  perf->Count(n);
+  PerfTimer timer(perf);
+  fXSecModel->XSecBatch(in, k, vars, nvar, n, pts, xsec);
+}
+//___________________________________________________________________________
+void KineGeneratorWithCache::CountRejectionIteration(void) const
+{
+// Counted with the calls of this generator by the event generation thread,
+// so that the report gives the iterations per generated kinematics
+
+  if(!fPerfVisitor) {
+    fPerfVisitor = PerfMonitor::Instance()->Counter(
+                                   "EventRecordVisitor", this->Id().Key());
+  }
+  fPerfVisitor->Count();
+}
+//___________________________________________________________________________
+int KineGeneratorWithCache::XSecBatchSize(void) const
+{
+// The mean number of trials per event so far (rounded up), at most
+// XSec-BatchSize: a block is then about as large as the trials needed for
+// an event, and few evaluations are wasted when a trial is accepted.
+// Blocks of one trial (no batching) until the first event is generated.
+
+  if(fGenerateUniformly || fXSecBatchSize <= 1 || fXSecBatchNEvents == 0) return 1;
+
+  long n = (fXSecBatchNTrials + fXSecBatchNEvents - 1) / fXSecBatchNEvents;
+  return (int) TMath::Max(1L, TMath::Min(n, (long) fXSecBatchSize));
+}
+//___________________________________________________________________________
+void KineGeneratorWithCache::CountXSecBatchEvent(unsigned int ntrials) const
+{
+  fXSecBatchNTrials += ntrials;
+  fXSecBatchNEvents++;
+}
+//___________________________________________________________________________
+PerfCounter * KineGeneratorWithCache::XSecPerfCounter(void) const
+{
+// The xsec model changes with the event generation thread
+
+  if(fXSecModel != fPerfXSecModel || !fPerfXSec) {
+    fPerfXSec = PerfMonitor::Instance()->Counter(
+                                   "XSecAlgorithm", fXSecModel->Id().Key());
+    fPerfXSecModel = fXSecModel;
+  }
+  return fPerfXSec;
+}
+//___________________________________________________________________________
@@ -18,6 +18,33 @@
           The example of using this opportunity see in 
           the class QELEventGeneratorSM.
 
+          Optionally, concrete generators can sample their kinematics from
+          an adaptive piecewise envelope (see CacheBranchEnvelope) trained
+          for each interaction and energy bin, instead of a box with a single
+          maximum xsec. The envelope is kept in the cache with the limits it
+          was trained over, and is retrained over wider limits if those of
+          an event are not contained. Points where the xsec exceeds the
+          envelope raise it and are rejected, so events stay unweighted.
+          The sampling efficiency is reported at the end of the job.
+
+          The max xsec cache can be warm-started from a precomputed table
+          (see MaxXSecTable and gmkmaxxsec): a new cache branch is filled
+          with the table entry for the same key, provided that the entry
+          was computed with the same configuration. Only interactions whose
+          max xsec does not depend on event-time state are tabulated (see
+          MaxXSecIsPrecomputable).
+
+          In unweighted mode, rejection-loop trials can be drawn and their
+          cross sections evaluated in blocks (XSec-BatchSize). Trials left
+          in a block when one is accepted are discarded (they were drawn for
+          the kinematic limits & initial state of that event), so blocks are
+          sized after the mean number of trials per event so far, up to
+          XSec-BatchSize.
+
+          Concrete generators evaluate their cross section model through
+          EvalXSec() and count their rejection-loop iterations, so that
+          both appear in the job performance report (see PerfMonitor).
+
 \author   Costas Andreopoulos <constantinos.andreopoulos \at cern.ch>
           University of Liverpool & STFC Rutherford Appleton Laboratory \n
           Igor Kakorin <kakorin@jinr.ru>
@@ -34,20 +61,38 @@
 #define _KINE_GENERATOR_WITH_CACHE_H_
 
 #include <string>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <stdint.h>
 
 #include "Framework/EventGen/XSecAlgorithmI.h"
 #include "Framework/EventGen/EventRecordVisitorI.h"
 #include "Framework/Utils/Range1.h"
+#include "Framework/Utils/CacheBranchEnvelope.h"
 
 using std::string;
+using std::map;
+using std::pair;
+using std::vector;
 
 namespace genie {
 
 class CacheBranchFx;
 class XSecAlgorithmI;
+class MaxXSecTable;
+class PerfCounter;
 
 class KineGeneratorWithCache : public EventRecordVisitorI {
 
+public:
+  //! Compute the max xsec for the input interaction at each input (lab)
+  //! probe energy, and add it to a max xsec table under the cache branch key.
+  //! Returns false if nothing was added (see MaxXSecIsPrecomputable)
+  virtual bool AddToMaxXSecTable (const XSecAlgorithmI * xsec_model,
+             const Interaction * in, const vector<double> & Ev, MaxXSecTable * table) const;
+
 protected:
   KineGeneratorWithCache();
   KineGeneratorWithCache(string name);
@@ -60,11 +105,35 @@ protected:
   virtual double FindMaxXSec    (const Interaction * in, const int nkey=0) const;
   virtual void   CacheMaxXSec   (const Interaction * in, double xsec, const int nkey=0) const;
   virtual double Energy         (const Interaction * in) const;
+  virtual bool   MaxXSecIsPrecomputable (const Interaction * in) const;
 
   virtual CacheBranchFx * AccessCacheBranch (const Interaction * in, const int nkey=0) const;
+  const string &          CacheBranchKey    (const Interaction * in, const int nkey=0) const;
+  const string &          InternedKey       (map<pair<ULong64_t,int>, pair<vector<int>, string> > & keys,
+                                             const Interaction * in, int n, const string & subkey) const;
+  uint64_t                MaxXSecConfigHash (void) const;
+  void                    WarmStartCacheBranch (const string & key, CacheBranchFx * cb, const int nkey) const;
 
   virtual void AssertXSecLimits (const Interaction * in, double xsec, double xsec_max) const;
 
+  // cross section evaluations & rejection loops, counted in the job performance report
+  double EvalXSec                (const Interaction * in, KinePhaseSpace_t k) const;
+  void   EvalXSecBatch           (Interaction * in, KinePhaseSpace_t k, const KineVar_t * vars,
+                                  int nvar, int n, const double * pts, double * xsec) const;
+  void   CountRejectionIteration (void) const;
+
+  // trials drawn & evaluated per block in the rejection method
+  int    XSecBatchSize           (void) const;
+  void   CountXSecBatchEvent     (unsigned int ntrials) const;
+  PerfCounter * XSecPerfCounter  (void) const;
+
+  // adaptive envelope sampling
+  void                  LoadAdaptiveEnvelopeConfig (void);
+  bool                  UseAdaptiveEnvelope        (const Interaction * in) const;
+  CacheBranchEnvelope * AccessAdaptiveEnvelope     (const Interaction * in, const Range1D_t & xr,
+                                                    const Range1D_t & yr, EnvelopeFunc_t f) const;
+  bool                  AdaptiveEnvelopeAccept     (CacheBranchEnvelope * env, int cell, double xsec) const;
+
   mutable const XSecAlgorithmI * fXSecModel;
 
   double fSafetyFactor;                     ///< ComputeMaxXSec -> ComputeMaxXSec * fSafetyFactor
@@ -75,6 +144,33 @@ protected:
   double fMaxXSecDiffTolerance;             ///< max{100*(xsec-maxxsec)/.5*(xsec+maxxsec)} if xsec>maxxsec
   double fEMin;                             ///< min E for which maxxsec is cached - forcing explicit calc.
   bool   fGenerateUniformly;                ///< uniform over allowed phase space + event weight?
+  int    fXSecBatchSize;                    ///< max trials drawn & evaluated per block in the rejection method
+  mutable long fXSecBatchNTrials;           ///< rejection-loop trials of the events generated in blocks
+  mutable long fXSecBatchNEvents;           ///< events generated in blocks
+
+  mutable map<pair<ULong64_t,int>, pair<vector<int>, string> > fCacheBranchKeys; ///< (interaction fingerprint, nkey) -> (fingerprinted fields, cache branch key)
+  mutable vector<int> fFieldsBuffer;        ///< scratch for Interaction::FingerprintFields()
+  mutable string      fCollidingKey;        ///< key of an interaction whose fingerprint collided
+
+  mutable const XSecAlgorithmI * fMaxXSecHashModel; ///< xsec model for which fMaxXSecHash was computed
+  mutable uint64_t fMaxXSecHash;            ///< hash of this & xsec model configuration, tagging max xsec table entries
+
+  bool   fUseAdaptiveEnvelope;              ///< sample kinematics from an adaptive envelope?
+  int    fAdaptiveEnvelopeNCells;           ///< number of envelope cells
+  int    fAdaptiveEnvelopeNWarmUp;          ///< xsec calls per cell during training
+  int    fAdaptiveEnvelopeBinsPerDecade;    ///< envelopes per decade of energy
+  double fAdaptiveEnvelopeSafetyFactor;     ///< envelope = max sampled xsec * safety factor
+
+  mutable map<pair<ULong64_t,int>, pair<vector<int>, string> > fEnvelopeKeys; ///< (interaction fingerprint, energy bin) -> (fingerprinted fields, cache branch key)
+  mutable long fEnvelopeNCalls;             ///< xsec calls (training & trials) in envelope sampling
+  mutable long fEnvelopeNTrials;            ///< points drawn from envelopes
+  mutable long fEnvelopeNAccepted;          ///< points accepted
+  mutable long fEnvelopeNOverweight;        ///< points where the xsec exceeded the envelope (rejected)
+  mutable long fEnvelopeNRebuilds;          ///< envelopes retrained over wider limits
+
+  mutable PerfCounter * fPerfVisitor;       ///< performance counter of this generator
+  mutable PerfCounter * fPerfXSec;          ///< performance counter of the xsec model below
+  mutable const XSecAlgorithmI * fPerfXSecModel; ///< xsec model counted in fPerfXSec
 };
 
 }      // genie namespace
@@ -9,6 +9,7 @@
 //____________________________________________________________________________
 
 #include <cfloat>
+#include <vector>
 
 #include <TMath.h>
 
@@ -29,6 +30,8 @@
 #include "Framework/Utils/KineUtils.h"
 #include "Framework/ParticleData/PDGUtils.h"
 
+using std::vector;
+
 using namespace genie;
 using namespace genie::controls;
 using namespace genie::utils;
@@ -101,18 +104,62 @@ void DISKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
   //   value is found.
   //   If the kinematics are generated uniformly over the allowed phase
   //   space the max xsec is irrelevant
-  double xsec_max = (fGenerateUniformly) ? -1 : this->MaxXSec(evrec);
+  //   Optionally, (x,y) are sampled from an adaptive envelope trained on the
+  //   differential cross section for this interaction & energy bin, in
+  //   which case the max xsec is not needed either
+  double dx = xl.max - xl.min;
+  double dy = yl.max - yl.min;
+
+  // envelope points outside the (x,y) limits of this event are rejected
+  auto inlimits = [&](double x, double y) {
+    return (x >= xl.min && x <= xl.max && y >= yl.min && y <= yl.max);
+  };
+
+  CacheBranchEnvelope * envelope = 0;
+  if(this->UseAdaptiveEnvelope(interaction)) {
+    EnvelopeFunc_t f = [&](double x, double y) {
+      if(!inlimits(x,y)) return 0.;
+      interaction->KinePtr()->Setx(x);
+      interaction->KinePtr()->Sety(y);
+      kinematics::UpdateWQ2FromXY(interaction);
+      return this->EvalXSec(interaction, kPSxyfE);
+    };
+    envelope = this->AccessAdaptiveEnvelope(interaction, xl, yl, f);
+    if(envelope->Integral() <= 0) envelope = 0;
+  }
+
+  double xsec_max = (fGenerateUniformly || envelope) ? -1 : this->MaxXSec(evrec);
 
   //-- Try to select a valid (x,y) pair using the rejection method
 
-  double dx = xl.max - xl.min;
-  double dy = yl.max - yl.min;
   double gx=-1, gy=-1, gW=-1, gQ2=-1, xsec=-1;
+  int    cell=-1;
+
+  auto draw = [&](double & x, double & y, int & c) {
+     if(envelope) {
+       double e = 0;
+       c = envelope->Sample(rnd->RndKine(), x, y, e);
+     } else {
+       x = xl.min + dx * rnd->RndKine().Rndm();
+       y = yl.min + dy * rnd->RndKine().Rndm();
+     }
+  };
+
+  //-- In unweighted mode, trials can be drawn and their cross sections
+  //   computed in blocks (see XSecAlgorithmI::XSecBatch) sized after the
+  //   mean number of trials per event
+  const KineVar_t batch_vars[2] = { kKVx, kKVy };
+  int nbatch = this->XSecBatchSize();
+  int ibatch = nbatch;
+  vector<double> batch_pts  (2*nbatch);
+  vector<double> batch_xsec (nbatch);
+  vector<int>    batch_cell (nbatch);
 
   unsigned int iter = 0;
   bool accept = false;
   while(1) {
      iter++;
+     this->CountRejectionIteration();
      if(iter > kRjMaxIterations) {
        LOG("DISKinematics", pWARN)
          << " Couldn't select kinematics after " << iter << " iterations";
@@ -123,23 +170,43 @@ void DISKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
        throw exception;
      }
 
-     //-- random x,y
-     gx = xl.min + dx * rnd->RndKine().Rndm();
-     gy = yl.min + dy * rnd->RndKine().Rndm();
-     interaction->KinePtr()->Setx(gx);
-     interaction->KinePtr()->Sety(gy);
-     kinematics::UpdateWQ2FromXY(interaction);
+     //-- random x,y & cross section for current kinematics
+     if(nbatch > 1) {
+       if(ibatch == nbatch) {
+         for(int i = 0; i < nbatch; i++) {
+           draw(batch_pts[2*i], batch_pts[2*i+1], batch_cell[i]);
+         }
+         this->EvalXSecBatch(interaction, kPSxyfE, batch_vars, 2,
+                             nbatch, &batch_pts[0], &batch_xsec[0]);
+         ibatch = 0;
+       }
+       gx   = batch_pts [2*ibatch];
+       gy   = batch_pts [2*ibatch+1];
+       cell = batch_cell[ibatch];
+       xsec = (inlimits(gx,gy)) ? batch_xsec[ibatch] : 0.;
+       ibatch++;
+       interaction->KinePtr()->Setx(gx);
+       interaction->KinePtr()->Sety(gy);
+       kinematics::UpdateWQ2FromXY(interaction);
+     }
+     else {
+       draw(gx, gy, cell);
+       interaction->KinePtr()->Setx(gx);
+       interaction->KinePtr()->Sety(gy);
+       kinematics::UpdateWQ2FromXY(interaction);
+       xsec = (inlimits(gx,gy)) ? this->EvalXSec(interaction, kPSxyfE) : 0.;
+     }
 
      LOG("DISKinematics", pNOTICE)
         << "Trying: x = " << gx << ", y = " << gy
         << " (W  = " << interaction->KinePtr()->W()  << ","
         << " (Q2 = " << interaction->KinePtr()->Q2() << ")";
 
-     //-- compute the cross section for current kinematics
-     xsec = fXSecModel->XSec(interaction, kPSxyfE);
-
      //-- decide whether to accept the current kinematics
-     if(!fGenerateUniformly) {
+     if(envelope) {
+        accept = this->AdaptiveEnvelopeAccept(envelope, cell, xsec);
+     }
+     else if(!fGenerateUniformly) {
         this->AssertXSecLimits(interaction, xsec, xsec_max);
         double t = xsec_max * rnd->RndKine().Rndm();
 	double J = 1;
@@ -161,6 +228,9 @@ void DISKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
             << " (W  = " << interaction->KinePtr()->W()  << ","
             << " (Q2 = " << interaction->KinePtr()->Q2() << ")";
 
+         // trials needed for this event, sizing the next blocks
+         if(!fGenerateUniformly) this->CountXSecBatchEvent(iter);
+
          // reset trust bits
          interaction->ResetBit(kISkipProcessChk);
          interaction->ResetBit(kISkipKinematicChk);
@@ -233,6 +303,12 @@ void DISKinematicsGenerator::LoadConfig(void)
   //   an event weight?
     GetParamDef( "UniformOverPhaseSpace", fGenerateUniformly, false ) ;
 
+  //-- Number of trials drawn & evaluated per block in the rejection method
+    GetParamDef( "XSec-BatchSize", fXSecBatchSize, 1 ) ;
+
+  //-- Sample kinematics from an adaptive envelope?
+    this->LoadAdaptiveEnvelopeConfig();
+
 }
 //____________________________________________________________________________
 double DISKinematicsGenerator::ComputeMaxXSec(
@@ -314,7 +390,7 @@ double DISKinematicsGenerator::ComputeMaxXSec(
         interaction->KinePtr()->Setx(gx);
         kinematics::UpdateWQ2FromXY(interaction);
 
-        double xsec = fXSecModel->XSec(interaction, kPSxyfE);
+        double xsec = this->EvalXSec(interaction, kPSxyfE);
 #ifdef __GENIE_LOW_LEVEL_MESG_ENABLED__
         LOG("DISKinematics", pINFO)
                 << "xsec(y=" << gy << ", x=" << gx << ") = " << xsec;
@@ -340,7 +416,7 @@ double DISKinematicsGenerator::ComputeMaxXSec(
    	     gx = gx - dxn;
              interaction->KinePtr()->Setx(gx);
              kinematics::UpdateWQ2FromXY(interaction);
-             xsec = fXSecModel->XSec(interaction, kPSxyfE);
+             xsec = this->EvalXSec(interaction, kPSxyfE);
 #ifdef __GENIE_LOW_LEVEL_MESG_ENABLED__
              LOG("DISKinematics", pINFO)
                 << "xsec(y=" << gy << ", x=" << gx << ") = " << xsec;
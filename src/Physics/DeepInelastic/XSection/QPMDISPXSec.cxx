@@ -64,6 +64,61 @@ double QPMDISPXSec::XSec(
   if(! this -> ValidProcess    (interaction) ) return 0.;
   if(! this -> ValidKinematics (interaction) ) return 0.;
 
+  double xsec = this->XSecNoCharm(interaction, kps);
+
+  // If requested return the free nucleon xsec even for input nuclear tgt
+  if( interaction->TestBit(kIAssumeFreeNucleon) ) return xsec;
+
+  // Subtract the inclusive charm production cross section
+  interaction->ExclTagPtr()->SetCharm();
+  double xsec_charm = fCharmProdModel->XSec(interaction,kps);
+  interaction->ExclTagPtr()->UnsetCharm();
+#ifdef __GENIE_LOW_LEVEL_MESG_ENABLED__
+  LOG("DISPXSec", pINFO)
+       << "Subtracting charm piece: " << xsec_charm << " / out of " << xsec;
+#endif
+  xsec = TMath::Max(0., xsec-xsec_charm);
+  return xsec;
+}
+//____________________________________________________________________________
+void QPMDISPXSec::XSecBatch(
+     Interaction * interaction, KinePhaseSpace_t kps,
+     const KineVar_t * vars, int nvar, int n, const double * pts,
+     double * xsec) const
+{
+// The process is checked once for the whole batch, and the charm piece is
+// computed as a batch by the charm production model
+
+  if(! this -> ValidProcess (interaction) ) {
+    for(int i = 0; i < n; i++) xsec[i] = 0.;
+    return;
+  }
+
+  for(int i = 0; i < n; i++) {
+    this->SetBatchPoint(interaction, vars, nvar, pts + i*nvar);
+    xsec[i] = (this->ValidKinematics(interaction)) ?
+                  this->XSecNoCharm(interaction, kps) : 0.;
+  }
+
+  if( interaction->TestBit(kIAssumeFreeNucleon) ) return;
+
+  if((int)fBatchCharmXSec.size() < n) fBatchCharmXSec.resize(n);
+  interaction->ExclTagPtr()->SetCharm();
+  fCharmProdModel->XSecBatch(
+       interaction, kps, vars, nvar, n, pts, &fBatchCharmXSec[0]);
+  interaction->ExclTagPtr()->UnsetCharm();
+
+  for(int i = 0; i < n; i++) {
+    xsec[i] = TMath::Max(0., xsec[i]-fBatchCharmXSec[i]);
+  }
+}
+//____________________________________________________________________________
+double QPMDISPXSec::XSecNoCharm(
+     const Interaction * interaction, KinePhaseSpace_t kps) const
+{
+// Computes the cross section at the current kinematics, before subtracting
+// the inclusive charm production piece
+
   // Get kinematical & init-state parameters
   const Kinematics &   kinematics = interaction -> Kine();
   const InitialState & init_state = interaction -> InitState();
@@ -175,15 +230,6 @@ double QPMDISPXSec::XSec(
   else if( proc_info.IsWeakNC() )  xsec *= fEMScale;
   else if( proc_info.IsEM() )  xsec *= fEMScale;
 
-  // Subtract the inclusive charm production cross section
-  interaction->ExclTagPtr()->SetCharm();
-  double xsec_charm = fCharmProdModel->XSec(interaction,kps);
-  interaction->ExclTagPtr()->UnsetCharm();
-#ifdef __GENIE_LOW_LEVEL_MESG_ENABLED__
-  LOG("DISPXSec", pINFO)
-       << "Subtracting charm piece: " << xsec_charm << " / out of " << xsec;
-#endif
-  xsec = TMath::Max(0., xsec-xsec_charm);
   return xsec;
 }
 //____________________________________________________________________________
@@ -21,6 +21,8 @@
 #ifndef _DIS_PARTON_MODEL_PARTIAL_XSEC_H_
 #define _DIS_PARTON_MODEL_PARTIAL_XSEC_H_
 
+#include <vector>
+
 #include "Framework/EventGen/XSecAlgorithmI.h"
 #include "Physics/DeepInelastic/XSection/DISStructureFunc.h"
 
@@ -41,6 +43,9 @@ public:
   double XSec            (const Interaction * i, KinePhaseSpace_t k) const;
   double Integral        (const Interaction * i) const;
   bool   ValidProcess    (const Interaction * i) const;
+  void   XSecBatch       (Interaction * i, KinePhaseSpace_t k,
+                          const KineVar_t * vars, int nvar,
+                          int n, const double * pts, double * xsec) const;
 
   // overload the Algorithm::Configure() methods to load private data
   // members from configuration options
@@ -49,6 +54,7 @@ public:
 
 private:
   void   LoadConfig                  (void);
+  double XSecNoCharm                 (const Interaction * i, KinePhaseSpace_t k) const;
 
   mutable DISStructureFunc fDISSF;
   bool                     fInInitPhase;
@@ -58,6 +64,8 @@ private:
 
   const XSecAlgorithmI * fCharmProdModel;
 
+  mutable std::vector<double> fBatchCharmXSec; ///< charm xsec buffer used in XSecBatch()
+
   double fCCScale;            ///< cross section scaling factor
   double fNCScale;            ///< cross section scaling factor
   double fEMScale;            ///< cross section scaling factor
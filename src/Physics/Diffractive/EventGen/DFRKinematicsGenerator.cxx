@@ -128,6 +128,7 @@ void DFRKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
   bool accept = false;
   while(true) {
      iter++;
+     this->CountRejectionIteration();
      if(iter > kRjMaxIterations) {
        LOG("DFRKinematics", pWARN)
          << " Couldn't select kinematics after " << iter << " iterations";
@@ -151,7 +152,7 @@ void DFRKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
        << "Trying: x = " << gx << ", y = " << gy << ", t = " << gt;
 
      //-- compute the cross section for current kinematics
-     xsec = fXSecModel->XSec(interaction, kPSxytfE);
+     xsec = this->EvalXSec(interaction, kPSxytfE);
 
      //-- decide whether to accept the current kinematics
      if(!fGenerateUniformly) {
@@ -318,7 +319,7 @@ double DFRKinematicsGenerator::ComputeMaxXSec(
           double gt = tmin + k*dt;
           interaction->KinePtr()->Sett(gt);
 
-          double xsec = fXSecModel->XSec(interaction, kPSxytfE);
+          double xsec = this->EvalXSec(interaction, kPSxytfE);
 #ifdef __GENIE_LOW_LEVEL_MESG_ENABLED__
 	  LOG("DFRKinematics", pINFO)
 	    << "xsec(y=" << gy << ", x=" << gx << ", t=" << gt << ") = " << xsec;
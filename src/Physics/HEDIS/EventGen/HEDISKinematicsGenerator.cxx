@@ -123,6 +123,7 @@ void HEDISKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
   bool accept = false;
   while(1) {
      iter++;
+     this->CountRejectionIteration();
      if(iter > kRjMaxIterations) {
        LOG("HEDISKinematics", pWARN)
          << " Couldn't select kinematics after " << iter << " iterations";
@@ -146,7 +147,7 @@ void HEDISKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
         << "  y = " << interaction->KinePtr()->y() << ")";
 
      //-- compute the cross section for current kinematics
-     xsec = fXSecModel->XSec(interaction, kPSlog10xlog10Q2fE);
+     xsec = this->EvalXSec(interaction, kPSlog10xlog10Q2fE);
 
      //-- decide whether to accept the current kinematics
      this->AssertXSecLimits(interaction, xsec, xsec_max);
@@ -200,7 +201,7 @@ double HEDISKinematicsGenerator::Scan(Interaction * interaction, Range1D_t xrang
       interaction->KinePtr()->Setx(x_aux);
       interaction->KinePtr()->SetQ2(Q2_aux);
       kinematics::UpdateWYFromXQ2(interaction);      
-      double xsec_aux = fXSecModel->XSec(interaction, kPSlog10xlog10Q2fE);
+      double xsec_aux = this->EvalXSec(interaction, kPSlog10xlog10Q2fE);
       LOG("HEDISKinematics", pDEBUG) << "x = " << x_aux << " , Q2 = " << Q2_aux << ", xsec = " << xsec_aux; 
       if (xsec_aux>xsec_scan) {
         xsec_scan = xsec_aux;
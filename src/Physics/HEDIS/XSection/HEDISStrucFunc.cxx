@@ -24,6 +24,15 @@
 #include <TSystem.h>
 #include <TMath.h>
 
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
 #ifdef __GENIE_APFEL_ENABLED__
 #include "APFEL/APFEL.h"
 #endif
@@ -41,6 +50,37 @@ double Q2PDFmin;                 // Minimum values of Q2 in grid from LHPADF set
 double Q2PDFmax;                 // Maximum values of Q2 in grid from LHPADF set
 std::map<int, double> mPDFQrk;   // Mass of the quark from LHAPDF set
 
+//____________________________________________________________________________
+// Binary SF grid file layout (host byte order):
+//
+//   SfbHeader                                    (fixed size)
+//   double   q2[nq2]                             (Q2 nodes)
+//   double   x[nx]                               (x nodes)
+//   double   grid[nsf][nq2][nx]                  (F1, F2, F3)
+//
+namespace {
+
+  const char     kSfbMagic[8] = { 'H','E','D','I','S','S','F','B' };
+  const uint32_t kSfbVersion  = 1;
+
+  struct SfbHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t nsf;
+    uint64_t nq2;
+    uint64_t nx;
+    uint64_t q2_offset;
+    uint64_t x_offset;
+    uint64_t grid_offset;
+  };
+
+  // same relative tolerance used by BLI2DNonUnifGrid to match nodes
+  bool SameNode(double a, double b) {
+    return TMath::Abs(a-b) <= .5*.0000001*(TMath::Abs(a)+TMath::Abs(b));
+  }
+
+} // anonymous namespace
+
 //_________________________________________________________________________
 HEDISStrucFunc * HEDISStrucFunc::fgInstance = 0;
 //_________________________________________________________________________
@@ -49,6 +89,9 @@ HEDISStrucFunc::HEDISStrucFunc(SF_info sfinfo)
 
   fSF = sfinfo;
 
+  fNJobs = 1;
+  if ( gSystem->Getenv("HEDIS_SF_NJOBS") ) fNJobs = TMath::Max( 1, atoi(gSystem->Getenv("HEDIS_SF_NJOBS")) );
+
   string basedir = "";
   if ( gSystem->Getenv("HEDIS_SF_DATA_PATH")==NULL ) basedir = string(gSystem->Getenv("GENIE")) + "/data/evgen/hedis-sf";
   else                                               basedir = string(gSystem->Getenv("HEDIS_SF_DATA_PATH"));
@@ -204,25 +247,16 @@ HEDISStrucFunc::HEDISStrucFunc(SF_info sfinfo)
   // Load structure functions for each quark at LO
   for(InteractionList::iterator in=ilist->begin(); in!=ilist->end(); ++in) {
 
-    string sfFile = SFname + "/QrkSF_LO_" + QrkSFName(*in) + ".dat";
+    string sfBase = SFname + "/QrkSF_LO_" + QrkSFName(*in);
     // Make sure data files are available
-    LOG("HEDISStrucFunc", pINFO) << "Checking if file " << sfFile << " exists...";        
-    if ( gSystem->AccessPathName( sfFile.c_str()) ) {
-      LOG("HEDISStrucFunc", pWARN) << "File doesnt exist. SF table will be computed.";        
-      CreateQrkSF( *in, sfFile );
-    }
-    else if ( atoi(gSystem->GetFromPipe(("wc -w "+sfFile+" | awk '{print $1}'").c_str()))!=kSFT3*nx*ny ) {
-      LOG("HEDISStrucFunc", pWARN) << "File does not contain all the need points. SF table will be recomputed.";        
-      gSystem->Exec(("rm "+sfFile).c_str());
-      CreateQrkSF( *in, sfFile );
-    }
-    std::ifstream sf_stream(sfFile.c_str(), std::ios::in);
-    // Loop over F1,F2,F3
-    for(int sf = 1; sf < kSFnumber; ++sf) {
-      // Loop over x/Q2 bins
-      for ( int ij=0; ij<nx*ny; ij++ ) sf_stream >> z[ij];
-      // Create SF tables with BLI2DNonUnifGrid using x,Q2 binning
-      fQrkSFLOTables[QrkSFCode(*in)].Table[(HEDISStrucFuncType_t)sf] = new genie::BLI2DNonUnifGrid( nx, ny, x, y, z );
+    LOG("HEDISStrucFunc", pINFO) << "Checking if file " << sfBase << ".bin exists...";        
+    if ( LoadSFGrid( sfBase, fQrkSFLOTables[QrkSFCode(*in)] ) ) continue;
+    if ( LoadSFText( sfBase, fQrkSFLOTables[QrkSFCode(*in)] ) ) continue;
+    LOG("HEDISStrucFunc", pWARN) << "File doesnt exist or does not contain all the need points. SF table will be computed.";        
+    CreateQrkSF( *in, sfBase+".bin" );
+    if ( !LoadSFGrid( sfBase, fQrkSFLOTables[QrkSFCode(*in)] ) ) {
+      LOG("HEDISStrucFunc", pFATAL) << "SF table could not be loaded: " << sfBase << ".bin";
+      assert(0);
     }
   }
 
@@ -275,39 +309,25 @@ HEDISStrucFunc::HEDISStrucFunc(SF_info sfinfo)
       if ( nch==NucSFCode(*in) ) continue;
       nch = NucSFCode(*in);
       
-      string sfFile = SFname + "/NucSF_NLO_" + NucSFName(*in) + ".dat";
+      string sfBase = SFname + "/NucSF_NLO_" + NucSFName(*in);
       // Make sure data files are available
-      LOG("HEDISStrucFunc", pINFO) << "Checking if file " << sfFile << " exists...";        
-      if ( gSystem->AccessPathName( sfFile.c_str()) ) {
+      LOG("HEDISStrucFunc", pINFO) << "Checking if file " << sfBase << ".bin exists...";        
+      if ( !LoadSFGrid( sfBase, fNucSFNLOTables[nch] ) && !LoadSFText( sfBase, fNucSFNLOTables[nch] ) ) {
 #ifdef __GENIE_APFEL_ENABLED__
-        LOG("HEDISStrucFunc", pWARN) << "File doesnt exist. SF table will be computed.";        
-        CreateNucSF( *in, sfFile );
+        LOG("HEDISStrucFunc", pWARN) << "File doesnt exist or does not contain all the need points. SF table will be computed.";        
+        CreateNucSF( *in, sfBase+".bin" );
 #else
-        LOG("HEDISStrucFunc", pERROR) << "File doesnt exist. APFEL is needed for NLO SF";        
-        assert(0);
-#endif
-      }
-      else if ( atoi(gSystem->GetFromPipe(("wc -w "+sfFile+" | awk '{print $1}'").c_str()))!=kSFT3*nx*ny ) {
-#ifdef __GENIE_APFEL_ENABLED__
-        LOG("HEDISStrucFunc", pWARN) << "File does not contain all the need points. SF table will be recomputed.";        
-        gSystem->Exec(("rm "+sfFile).c_str());
-        CreateNucSF( *in, sfFile );
-#else
-        LOG("HEDISStrucFunc", pERROR) << "File does not contain all the need points. APFEL is needed for NLO SF";        
+        LOG("HEDISStrucFunc", pERROR) << "File doesnt exist or does not contain all the need points. APFEL is needed for NLO SF";        
         assert(0);
 #endif
+        if ( !LoadSFGrid( sfBase, fNucSFNLOTables[nch] ) ) {
+          LOG("HEDISStrucFunc", pFATAL) << "SF table could not be loaded: " << sfBase << ".bin";
+          assert(0);
+        }
       }
-      std::ifstream sf_stream(sfFile.c_str(), std::ios::in);
-      // Loop over F1,F2,F3
-      for(int sf = 1; sf < kSFnumber; ++sf) {
-        // Loop over x/Q2 bins
-        for ( int ij=0; ij<nx*ny; ij++ ) sf_stream >> z[ij];
-        // Create SF tables with BLI2DNonUnifGrid using x,Q2 binning
-        fNucSFNLOTables[nch].Table[(HEDISStrucFuncType_t)sf] = new genie::BLI2DNonUnifGrid( nx, ny, x, y, z );
-      }        
 
       //compute structure functions for each nucleon at LO using quark grids
-      LOG("HEDISStrucFunc", pDEBUG) << "Creating LO " << sfFile;              
+      LOG("HEDISStrucFunc", pDEBUG) << "Creating LO " << sfBase;              
       vector <int> qcodes;
       for(InteractionList::iterator in2=ilist->begin(); in2!=ilist->end(); ++in2) {
         if (NucSFCode(*in2)==nch) qcodes.push_back(QrkSFCode(*in2));
@@ -440,63 +460,59 @@ void HEDISStrucFunc::CreateQrkSF( const Interaction * in, string sfFile )
     else if ( pdg_iq==-5 &&  sea_iq && pdg_fq==-5 ) { qpdf1 = -5;                   Cp2 = c2d; Cp3 = -c3d; }
   }   
 
-  // open file in which SF will be stored
-  std::ofstream sf_stream(sfFile.c_str());
-
-  // loop over 3 different SF: F1,F2,F3
-  for(int sf = 1; sf < 4; sf++) {
-    for ( unsigned int i=0; i<sf_q2_array.size(); i++ ) {
-      double Q2 = sf_q2_array[i];
-      for ( unsigned int j=0; j<sf_x_array.size(); j++ ) {
-        double x = sf_x_array[j];
-
-        double z = x; // this variable is introduce in case you want to apply scaling
-
-        // W threshold
-        if      (fSF.QrkThrs==1) { 
-            if ( Q2*(1/z-1)+mass_nucl*mass_nucl <= TMath::Power(mass_nucl+mPDFQrk[TMath::Abs(pdg_fq)],2) ) { sf_stream << 0. << "  "; continue; }
-        } 
-        // W threshold and slow rescaling
-        else if (fSF.QrkThrs==2) {
-            if ( Q2*(1/z-1)+mass_nucl*mass_nucl <= TMath::Power(mass_nucl+mPDFQrk[TMath::Abs(pdg_fq)],2) ) { sf_stream << 0. << "  "; continue; }
-            z *= 1+mPDFQrk[TMath::Abs(pdg_fq)]*mPDFQrk[TMath::Abs(pdg_fq)]/Q2;
-        }
-        // Slow rescaling
-        else if (fSF.QrkThrs==3) {
-            z *= 1+mPDFQrk[TMath::Abs(pdg_fq)]*mPDFQrk[TMath::Abs(pdg_fq)]/Q2;
-        }
+  unsigned int nq2 = sf_q2_array.size();
+  unsigned int nx  = sf_x_array.size();
 
-        // Fill x,Q2 used to extract PDF. If values outside boundaries then freeze them.
-        double xPDF = TMath::Max( z, xPDFmin );
-        double Q2PDF = TMath::Max( Q2, Q2PDFmin );
-        Q2PDF = TMath::Min( Q2PDF, Q2PDFmax  );
+  // Compute the grid row by row: F1,F2,F3 share the PDF of each x,Q2 point
+  ComputeSFGrid( sfFile, [](){}, [&](unsigned int i, double * grid) {
+    double Q2 = sf_q2_array[i];
+    double * F1 = grid + (0*nq2+i)*nx;
+    double * F2 = grid + (1*nq2+i)*nx;
+    double * F3 = grid + (2*nq2+i)*nx;
+    for ( unsigned int j=0; j<nx; j++ ) {
+      double x = sf_x_array[j];
+
+      double z = x; // this variable is introduce in case you want to apply scaling
+
+      F1[j] = F2[j] = F3[j] = 0.;
+
+      // W threshold
+      if      (fSF.QrkThrs==1) { 
+          if ( Q2*(1/z-1)+mass_nucl*mass_nucl <= TMath::Power(mass_nucl+mPDFQrk[TMath::Abs(pdg_fq)],2) ) continue;
+      } 
+      // W threshold and slow rescaling
+      else if (fSF.QrkThrs==2) {
+          if ( Q2*(1/z-1)+mass_nucl*mass_nucl <= TMath::Power(mass_nucl+mPDFQrk[TMath::Abs(pdg_fq)],2) ) continue;
+          z *= 1+mPDFQrk[TMath::Abs(pdg_fq)]*mPDFQrk[TMath::Abs(pdg_fq)]/Q2;
+      }
+      // Slow rescaling
+      else if (fSF.QrkThrs==3) {
+          z *= 1+mPDFQrk[TMath::Abs(pdg_fq)]*mPDFQrk[TMath::Abs(pdg_fq)]/Q2;
+      }
+
+      // Fill x,Q2 used to extract PDF. If values outside boundaries then freeze them.
+      double xPDF = TMath::Max( z, xPDFmin );
+      double Q2PDF = TMath::Max( Q2, Q2PDFmin );
+      Q2PDF = TMath::Min( Q2PDF, Q2PDFmax  );
 
-        // Extract PDF requiring then to be higher than zero
+      // Extract PDF requiring then to be higher than zero
 #ifdef __GENIE_LHAPDF6_ENABLED__
-        double fPDF = fmax( pdf->xfxQ2(qpdf1, xPDF, Q2PDF)/z , 0.);
-        if (qpdf2!= -999) fPDF -= fmax( pdf->xfxQ2(qpdf2, xPDF, Q2PDF)/z , 0.);
+      double fPDF = fmax( pdf->xfxQ2(qpdf1, xPDF, Q2PDF)/z , 0.);
+      if (qpdf2!= -999) fPDF -= fmax( pdf->xfxQ2(qpdf2, xPDF, Q2PDF)/z , 0.);
 #endif
 #ifdef __GENIE_LHAPDF5_ENABLED__
-        double fPDF = fmax( LHAPDF::xfx(xPDF, TMath::Sqrt(Q2PDF), qpdf1)/z , 0.);
-        if (qpdf2!= -999) fPDF -= fmax( LHAPDF::xfx(xPDF, TMath::Sqrt(Q2PDF), qpdf2)/z , 0.);
+      double fPDF = fmax( LHAPDF::xfx(xPDF, TMath::Sqrt(Q2PDF), qpdf1)/z , 0.);
+      if (qpdf2!= -999) fPDF -= fmax( LHAPDF::xfx(xPDF, TMath::Sqrt(Q2PDF), qpdf2)/z , 0.);
 #endif
 
-        // Compute SF
-        double tmp = -999;
-        if      ( sf==1 ) tmp = fPDF*Cp2/2;
-        else if ( sf==2 ) tmp = fPDF*Cp2*z;
-        else if ( sf==3 ) tmp = fPDF*Cp3*sign3;
+      // Compute SF
+      F1[j] = fPDF*Cp2/2;
+      F2[j] = fPDF*Cp2*z;
+      F3[j] = fPDF*Cp3*sign3;
 
-        // Save SF for particular x and Q2 in file
-        LOG("HEDISStrucFunc", pDEBUG) << "QrkSFLO" << sf << "[x=" << x << "," << Q2 << "] = " << tmp;
-        sf_stream << tmp << "  ";
-        
-      }
+      LOG("HEDISStrucFunc", pDEBUG) << "QrkSFLO[x=" << x << "," << Q2 << "] = " << F1[j] << " " << F2[j] << " " << F3[j];
     }
-  }
-
-  // Close file in which SF are stored
-  sf_stream.close();
+  });
 
 }
 #ifdef __GENIE_APFEL_ENABLED__
@@ -517,58 +533,222 @@ void HEDISStrucFunc::CreateNucSF( const Interaction * in, string sfFile )
   if ( ispr ) APFEL::SetTargetDIS("proton");
   else        APFEL::SetTargetDIS("neutron");
 
-  APFEL::InitializeAPFEL_DIS();
-
-  // Using APFEL format to store the SF grid
-  int nx  = sf_x_array.size();
-  int nq2 = sf_q2_array.size();
-  double xlist[nx*nq2];
-  double q2list[nx*nq2];
-  double F2list[nx*nq2];
-  double FLlist[nx*nq2];
-  double xF3list[nx*nq2];
+  unsigned int nq2 = sf_q2_array.size();
+  unsigned int nx  = sf_x_array.size();
+  double sign3 = isnu ? +1. : -1.;  // sign change for nu/nubar in F3
 
-  int nlist = 0;
-  for ( unsigned int i=0; i<sf_q2_array.size(); i++ ) {
+  // APFEL evolves the PDFs for each Q2 row; every worker initialises it once
+  ComputeSFGrid( sfFile, [](){ APFEL::InitializeAPFEL_DIS(); }, [&](unsigned int i, double * grid) {
     double Q2 = sf_q2_array[i];
     double Q  = TMath::Sqrt(Q2);
     // SF from APFEL are multiplied by a prefactor in NC. We dont want that prefactor
     double norm = iscc ? 1. : 2./TMath::Power( Q2/(Q2 + TMath::Power(APFEL::GetZMass(),2))/4/APFEL::GetSin2ThetaW()/(1-APFEL::GetSin2ThetaW()), 2 );
     APFEL::SetAlphaQCDRef(pdf->alphasQ(Q),Q);
     APFEL::ComputeStructureFunctionsAPFEL(Q,Q);
-    for ( unsigned int j=0; j<sf_x_array.size(); j++ ) {
-      double x = sf_x_array[j];
-      q2list[nlist]  = Q2;
-      xlist[nlist]   = x;
-      FLlist[nlist]  = norm*APFEL::FLtotal(x);
-      F2list[nlist]  = norm*APFEL::F2total(x);
-      xF3list[nlist] = norm*APFEL::F3total(x);
-      nlist++;
+    double * F1 = grid + (0*nq2+i)*nx;
+    double * F2 = grid + (1*nq2+i)*nx;
+    double * F3 = grid + (2*nq2+i)*nx;
+    for ( unsigned int j=0; j<nx; j++ ) {
+      double x   = sf_x_array[j];
+      double FL  = norm*APFEL::FLtotal(x);
+      double xF3 = norm*APFEL::F3total(x);
+      F2[j] = norm*APFEL::F2total(x);
+      F1[j] = (F2[j]-FL)/2/x;
+      F3[j] = sign3 * xF3 / x;
+      LOG("HEDISStrucFunc", pDEBUG) << "NucSFNLO[x=" << x << "," << Q2 << "] = " << F1[j] << " " << F2[j] << " " << F3[j];
+    }
+  });
+
+}
+#endif
+//____________________________________________________________________________
+void HEDISStrucFunc::ComputeSFGrid( string sfFile, std::function<void(void)> init, std::function<void(unsigned int, double *)> row )
+{
+
+  unsigned int nq2 = sf_q2_array.size();
+  size_t size = (kSFnumber-1)*nq2*sf_x_array.size()*sizeof(double);
+
+  // Anonymous shared mapping: worker processes write their rows in place.
+  // Processes rather than threads are used since LHAPDF5 and APFEL keep
+  // their state in Fortran common blocks.
+  void * addr = mmap(0, size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_ANONYMOUS, -1, 0);
+  if ( addr==MAP_FAILED ) {
+    LOG("HEDISStrucFunc", pFATAL) << "Could not allocate SF grid for " << sfFile;
+    assert(0);
+  }
+  double * grid = (double *) addr;
+
+  bool ok = true;
+  int njobs = TMath::Min( fNJobs, (int)nq2 );
+  if ( njobs<=1 ) {
+    init();
+    for ( unsigned int i=0; i<nq2; i++ ) row(i,grid);
+  }
+  else {
+    LOG("HEDISStrucFunc", pNOTICE) << "Computing " << sfFile << " with " << njobs << " processes";
+    std::cout.flush();
+    std::cerr.flush();
+    vector<pid_t> pids;
+    for ( int ij=0; ij<njobs; ij++ ) {
+      pid_t pid = fork();
+      if ( pid==0 ) {
+        init();
+        // interleaved rows, so that every worker gets a similar range of Q2
+        for ( unsigned int i=ij; i<nq2; i+=njobs ) row(i,grid);
+        std::cout.flush();
+        std::cerr.flush();
+        _exit(0);
+      }
+      if ( pid<0 ) {
+        LOG("HEDISStrucFunc", pERROR) << "Could not fork SF worker process";
+        ok = false;
+        break;
+      }
+      pids.push_back(pid);
+    }
+    for ( unsigned int ip=0; ip<pids.size(); ip++ ) {
+      int status = 0;
+      if ( waitpid(pids[ip], &status, 0)<0 || !WIFEXITED(status) || WEXITSTATUS(status)!=0 ) {
+        LOG("HEDISStrucFunc", pERROR) << "SF worker process " << pids[ip] << " failed";
+        ok = false;
+      }
     }
   }
 
-  // open file in which SF will be stored
-  std::ofstream sf_stream(sfFile.c_str());
+  if ( !ok || !WriteSFGrid( sfFile, grid ) ) {
+    LOG("HEDISStrucFunc", pFATAL) << "SF table could not be computed: " << sfFile;
+    assert(0);
+  }
+  munmap(addr, size);
 
-  double sign3 = isnu ? +1. : -1.;  // sign change for nu/nubar in F3
-  // loop over 3 different SF: F1,F2,F3
-  for(int sf = 1; sf < 4; sf++) {
-    for (int i=0; i<nx*nq2; i++) {
-      double tmp = 0;
-      if      ( sf==1 ) tmp = (F2list[i]-FLlist[i])/2/xlist[i];
-      else if ( sf==2 ) tmp = F2list[i];
-      else if ( sf==3 ) tmp = sign3 * xF3list[i] / xlist[i];
-      // Save SF for particular x and Q2 in file
-      LOG("HEDISStrucFunc", pDEBUG) << "NucSFNLO" << sf << "[x=" << xlist[i] << "," << q2list[i] << "] = " << tmp;
-      sf_stream << tmp << "  ";
+}
+//____________________________________________________________________________
+bool HEDISStrucFunc::WriteSFGrid( string sfFile, const double * grid )
+{
+
+  SfbHeader h;
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, kSfbMagic, sizeof(kSfbMagic));
+  h.version     = kSfbVersion;
+  h.nsf         = kSFnumber-1;
+  h.nq2         = sf_q2_array.size();
+  h.nx          = sf_x_array.size();
+  h.q2_offset   = sizeof(SfbHeader);
+  h.x_offset    = h.q2_offset + h.nq2*sizeof(double);
+  h.grid_offset = h.x_offset  + h.nx*sizeof(double);
+
+  // Written aside and renamed, so that a job reading the directory never
+  // sees a partial table
+  string tmpFile = sfFile + ".tmp";
+  std::ofstream out(tmpFile.c_str(), std::ios::out | std::ios::binary);
+  if ( !out ) return false;
+  out.write((const char *)&h, sizeof(h));
+  out.write((const char *)&sf_q2_array[0], h.nq2*sizeof(double));
+  out.write((const char *)&sf_x_array[0],  h.nx*sizeof(double));
+  out.write((const char *)grid, h.nsf*h.nq2*h.nx*sizeof(double));
+  bool ok = out.good();
+  out.close();
+
+  if ( !ok || std::rename(tmpFile.c_str(), sfFile.c_str())!=0 ) {
+    std::remove(tmpFile.c_str());
+    return false;
+  }
+  return true;
+
+}
+//____________________________________________________________________________
+bool HEDISStrucFunc::LoadSFGrid( string sfBase, HEDISStrucFuncTable & table )
+{
+
+  string sfFile = sfBase + ".bin";
+
+  int fd = open(sfFile.c_str(), O_RDONLY);
+  if ( fd<0 ) return false;
+  struct stat st;
+  if ( fstat(fd, &st)!=0 || (size_t)st.st_size<sizeof(SfbHeader) ) {
+    close(fd);
+    return false;
+  }
+  size_t size = st.st_size;
+  void * addr = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if ( addr==MAP_FAILED ) return false;
+
+  uint64_t nq2 = sf_q2_array.size();
+  uint64_t nx  = sf_x_array.size();
+  const SfbHeader * h = (const SfbHeader *) addr;
+  bool valid =
+    memcmp(h->magic, kSfbMagic, sizeof(kSfbMagic))==0 &&
+    h->version == kSfbVersion &&
+    h->nsf     == kSFnumber-1 &&
+    h->nq2     == nq2 &&
+    h->nx      == nx  &&
+    h->q2_offset   + nq2*sizeof(double)            <= size &&
+    h->x_offset    + nx*sizeof(double)             <= size &&
+    h->grid_offset + h->nsf*nq2*nx*sizeof(double)  <= size;
+
+  const char * base = (const char *) addr;
+  double * q2   = valid ? (double *)(base + h->q2_offset)   : 0;
+  double * x    = valid ? (double *)(base + h->x_offset)    : 0;
+  double * grid = valid ? (double *)(base + h->grid_offset) : 0;
+
+  // Tables computed for another grid are recomputed
+  for ( unsigned int i=0; valid && i<nq2; i++ ) valid = SameNode( q2[i], sf_q2_array[i] );
+  for ( unsigned int j=0; valid && j<nx;  j++ ) valid = SameNode( x[j],  sf_x_array[j]  );
+
+  if ( valid ) {
+    // the grid is copied, the mapping is only read
+    FillSFTable( grid, table );
+  }
+  else {
+    LOG("HEDISStrucFunc", pWARN) << "File " << sfFile << " is invalid or does not match the SF grid";
+  }
+
+  munmap(addr, size);
+  return valid;
+
+}
+//____________________________________________________________________________
+void HEDISStrucFunc::FillSFTable( double * grid, HEDISStrucFuncTable & table )
+{
+
+  unsigned int nq2 = sf_q2_array.size();
+  unsigned int nx  = sf_x_array.size();
+  // Loop over F1,F2,F3
+  for(int sf = 1; sf < kSFnumber; ++sf) {
+    // Create SF tables with BLI2DNonUnifGrid using x,Q2 binning
+    table.Table[(HEDISStrucFuncType_t)sf] = new genie::BLI2DNonUnifGrid( nq2, nx, &sf_q2_array[0], &sf_x_array[0], grid + (sf-1)*nq2*nx );
+  }
+
+}
+//____________________________________________________________________________
+bool HEDISStrucFunc::LoadSFText( string sfBase, HEDISStrucFuncTable & table )
+{
+
+  // Text tables written by earlier versions: F1,F2,F3 x Q2 bins x x bins
+  string txtFile = sfBase + ".dat";
+  std::ifstream sf_stream(txtFile.c_str(), std::ios::in);
+  if ( !sf_stream ) return false;
+
+  size_t n = (kSFnumber-1)*sf_q2_array.size()*sf_x_array.size();
+  vector<double> grid(n);
+  for ( size_t ij=0; ij<n; ij++ ) {
+    if ( !(sf_stream >> grid[ij]) ) {
+      LOG("HEDISStrucFunc", pWARN) << "File " << txtFile << " does not contain all the need points";
+      return false;
     }
   }
-    
-  // Close file in which SF are stored
-  sf_stream.close();
+
+  // The conversion only speeds up later jobs: if the binary table can not
+  // be written (eg read-only data directory) the text table is used as read
+  LOG("HEDISStrucFunc", pNOTICE) << "Converting " << txtFile << " to binary format";
+  if ( WriteSFGrid( sfBase+".bin", &grid[0] ) && LoadSFGrid( sfBase, table ) ) return true;
+
+  LOG("HEDISStrucFunc", pWARN) << "Could not convert " << txtFile << " - Using the text table";
+  FillSFTable( &grid[0], table );
+  return true;
 
 }
-#endif
 //____________________________________________________________________________
 string HEDISStrucFunc::QrkSFName( const Interaction * in) 
 {
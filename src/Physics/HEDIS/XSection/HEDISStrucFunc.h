@@ -5,6 +5,13 @@
 
 \brief    Singleton class to load Structure Functions used in HEDIS.
 
+          The (Q2,x) grids of each channel are stored in binary files
+          (<channel>.bin) that are memory mapped at load time. Missing grids
+          are computed in parallel over the Q2 rows by a number of worker
+          processes set with the environment variable HEDIS_SF_NJOBS
+          (default 1) or with gmkhedissf --jobs. Text tables (<channel>.dat)
+          written by earlier versions are converted on first use.
+
 \author   Alfonso Garcia <alfonsog \at nikhef.nl>
           NIKHEF
 
@@ -27,6 +34,7 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <functional>
 
 
 using std::map;
@@ -235,6 +243,18 @@ namespace genie {
       void CreateQrkSF    ( const Interaction * in, string sfFile );
       void CreateNucSF    ( const Interaction * in, string sfFile );
 
+      // Grid files: sfBase is the channel file name without extension
+      bool LoadSFGrid     ( string sfBase, HEDISStrucFuncTable & table );
+      // Load the text table written by earlier versions, converting it to
+      // the binary format if the directory is writable
+      bool LoadSFText     ( string sfBase, HEDISStrucFuncTable & table );
+      bool WriteSFGrid    ( string sfFile, const double * grid );
+      void FillSFTable    ( double * grid, HEDISStrucFuncTable & table );
+      // Fill the grid [sf][iq2][ix] calling row(iq2,grid) for every Q2 bin,
+      // with the rows shared among fNJobs processes that each call init first
+      void ComputeSFGrid  ( string sfFile, std::function<void(void)> init,
+                            std::function<void(unsigned int, double *)> row );
+
       string  QrkSFName ( const Interaction * in ); 
       string  NucSFName ( const Interaction * in ) ;
       int     QrkSFCode ( const Interaction * in ); 
@@ -249,6 +269,7 @@ namespace genie {
       map<int, HEDISStrucFuncTable> fNucSFNLOTables;
 
       SF_info fSF;
+      int fNJobs;
       vector<double> sf_x_array;
       vector<double> sf_q2_array;
 
@@ -100,6 +100,7 @@ void HELeptonKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
     
     while(1) {
       iter++;
+      this->CountRejectionIteration();
       if(iter > 1000000) {
         LOG("HELeptonKinematics", pWARN)
               << "*** Could not select a valid y after "
@@ -123,7 +124,7 @@ void HELeptonKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
       LOG("HELeptonKinematics", pDEBUG) << "Trying: n1 = " << n1 << ", n2 = " << n2 << ", n3 = " << n3;
 
       //-- computing cross section for the current kinematics
-      xsec = fXSecModel->XSec(interaction, kPSn1n2n3fE);
+      xsec = this->EvalXSec(interaction, kPSn1n2n3fE);
 
       this->AssertXSecLimits(interaction, xsec, xsec_max);
 
@@ -162,6 +163,7 @@ void HELeptonKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
     
     while(1) {
       iter++;
+      this->CountRejectionIteration();
       if(iter > 1000000) {
         LOG("HELeptonKinematics", pWARN)
               << "*** Could not select a valid y after "
@@ -181,7 +183,7 @@ void HELeptonKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
       LOG("HELeptonKinematics", pDEBUG) << "Trying: n1 = " << n1 << ", n2 = " << n2;
 
       //-- computing cross section for the current kinematics
-      xsec = fXSecModel->XSec(interaction, kPSn1n2fE);
+      xsec = this->EvalXSec(interaction, kPSn1n2fE);
 
       this->AssertXSecLimits(interaction, xsec, xsec_max);
 
@@ -241,8 +243,8 @@ double HELeptonKinematicsGenerator::ComputeMaxXSec(
     interaction->KinePtr()->SetKV(kKVn1,min->X()[0]);
     interaction->KinePtr()->SetKV(kKVn2,min->X()[1]);
     interaction->KinePtr()->SetKV(kKVn3,min->X()[2]);
-    SLOG("HELeptonKinematics", pDEBUG) << "Minimum found -> n1: 1, n2: " << min->X()[1] << ", n3: " << min->X()[2] << ", xsec: " << fXSecModel->XSec(interaction, kPSn1n2n3fE);
-    max_xsec = TMath::Max(fXSecModel->XSec(interaction, kPSn1n2n3fE),max_xsec);
+    SLOG("HELeptonKinematics", pDEBUG) << "Minimum found -> n1: 1, n2: " << min->X()[1] << ", n3: " << min->X()[2] << ", xsec: " << this->EvalXSec(interaction, kPSn1n2n3fE);
+    max_xsec = TMath::Max(this->EvalXSec(interaction, kPSn1n2n3fE),max_xsec);
 
     min->SetFixedVariable   ( 0, "n1",   -1.);
     min->SetLimitedVariable ( 1, "n2",   0.,   0.01,  0., 1.);
@@ -254,8 +256,8 @@ double HELeptonKinematicsGenerator::ComputeMaxXSec(
     interaction->KinePtr()->SetKV(kKVn1,min->X()[0]);
     interaction->KinePtr()->SetKV(kKVn2,min->X()[1]);
     interaction->KinePtr()->SetKV(kKVn3,min->X()[2]);
-    SLOG("HELeptonKinematics", pDEBUG) << "Minimum found -> n1: -1, n2: " << min->X()[1] << ", n3: " << min->X()[2] << ", xsec: " << fXSecModel->XSec(interaction, kPSn1n2n3fE);
-    max_xsec = TMath::Max(fXSecModel->XSec(interaction, kPSn1n2n3fE),max_xsec);
+    SLOG("HELeptonKinematics", pDEBUG) << "Minimum found -> n1: -1, n2: " << min->X()[1] << ", n3: " << min->X()[2] << ", xsec: " << this->EvalXSec(interaction, kPSn1n2n3fE);
+    max_xsec = TMath::Max(this->EvalXSec(interaction, kPSn1n2n3fE),max_xsec);
 
   } 
   else {
@@ -277,7 +279,7 @@ double HELeptonKinematicsGenerator::ComputeMaxXSec(
         double n2 = n2min + dn2*j;
         interaction->KinePtr()->SetKV(kKVn1,n1);
         interaction->KinePtr()->SetKV(kKVn2,n2);
-        double dxsec = fXSecModel->XSec(interaction, kPSn1n2fE);
+        double dxsec = this->EvalXSec(interaction, kPSn1n2fE);
         if ( dxsec > max_xsec ) {
           scan_n1 = n1;
           scan_n2 = n2;
@@ -295,7 +297,7 @@ double HELeptonKinematicsGenerator::ComputeMaxXSec(
     min->Minimize();
     interaction->KinePtr()->SetKV(kKVn1,min->X()[0]);
     interaction->KinePtr()->SetKV(kKVn2,min->X()[1]);
-    max_xsec = fXSecModel->XSec(interaction, kPSn1n2fE);
+    max_xsec = this->EvalXSec(interaction, kPSn1n2fE);
     SLOG("HELeptonKinematics", pDEBUG) << "Minimum found -> n1: " << min->X()[0] << ", n2: " << min->X()[1];
 
   }
@@ -1,12 +1,16 @@
 // standard library includes
 #include <cmath>
+#include <cstring>
 #include <fstream>
+#include <sstream>
+#include <stdint.h>
 
 // GENIE includes
 #include "Framework/Conventions/Constants.h"
 #include "Framework/Conventions/Units.h"
 #include "Framework/ParticleData/PDGCodes.h"
 #include "Framework/Messenger/Messenger.h"
+#include "Framework/Utils/SharedTableStore.h"
 #include "Physics/HadronTensors/TabulatedLabFrameHadronTensor.h"
 
 // For retrieval of CKM-Vud
@@ -25,6 +29,20 @@ namespace {
     kHadronTensorGridFlag_COUNT = 2
   };
 
+  /// Layout of the shared copy of a table (see genie::SharedTableStore):
+  /// the header, the q0 and |q| grid points, and the table entries as
+  /// (W00, Wxx, Wzz, ImWxy, ReW0z), all in host byte order
+  const char kHtbMagic[8] = { 'G','H','A','D','T','E','N','S' };
+  const uint32_t kHtbVersion = 1;
+
+  struct HtbHeader {
+    char magic[8];
+    uint32_t version;
+    int32_t pdg;
+    uint64_t num_q0;
+    uint64_t num_q_mag;
+  };
+
   /// Definition of sqrt() that returns zero if the argument is negative.
   /// Used to prevent spurious NaNs due to numerical roundoff.
   double real_sqrt(double x) {
@@ -36,6 +54,16 @@ namespace {
 genie::TabulatedLabFrameHadronTensor::TabulatedLabFrameHadronTensor(
   const std::string& table_file_name)
   : fGrid(&fq0Points, &fqmagPoints, &fEntries)
+{
+  // Use the copy of the table shared by all processes on the node, if
+  // there is one, or read it from the file
+  if ( !this->LoadSharedTable(table_file_name) ) {
+    this->ReadTable(table_file_name);
+  }
+}
+
+void genie::TabulatedLabFrameHadronTensor::ReadTable(
+  const std::string& table_file_name)
 {
   // Read in the table
   std::ifstream in_file( table_file_name.c_str() );
@@ -97,6 +125,91 @@ genie::TabulatedLabFrameHadronTensor::TabulatedLabFrameHadronTensor(
       lineCount++;
     }
   }
+
+  // The grid points into the vectors, which are now filled
+  fGrid = BLI2DNonUnifObjectGrid<TableEntry>(&fq0Points, &fqmagPoints,
+    &fEntries);
+}
+
+bool genie::TabulatedLabFrameHadronTensor::LoadSharedTable(
+  const std::string& table_file_name)
+{
+  genie::SharedTableStore* store = genie::SharedTableStore::Instance();
+  if ( !store->IsEnabled() ) return false;
+
+  // The mapped entries are used in place
+  if ( sizeof(TableEntry) != 5*sizeof(double) ) return false;
+
+  std::ostringstream format;
+  format << "hadron tensor table v" << kHtbVersion;
+  uint64_t hash = genie::SharedTableStore::Hash( format.str(),
+    genie::SharedTableStore::HashFile(table_file_name) );
+
+  bool built = false;
+  std::string shared_file = store->Acquire("hadron-tensor", hash,
+    [this, &table_file_name](const std::string& out) {
+      this->ReadTable( table_file_name );
+      return this->SaveTable( out );
+    },
+    built);
+
+  // The building process keeps the table it has just read
+  if ( built ) return true;
+  if ( shared_file.empty() ) return false;
+
+  size_t size = 0;
+  const char* addr = static_cast<const char*>( store->Map(shared_file, size) );
+  const HtbHeader* header = reinterpret_cast<const HtbHeader*>( addr );
+  bool valid = addr && size >= sizeof(HtbHeader)
+    && std::memcmp(header->magic, kHtbMagic, sizeof(kHtbMagic)) == 0
+    && header->version == kHtbVersion
+    && header->num_q0 > 1 && header->num_q_mag > 1
+    && sizeof(HtbHeader) + sizeof(double) * ( header->num_q0
+      + header->num_q_mag + 5 * header->num_q0 * header->num_q_mag ) <= size;
+  if ( !valid ) {
+    store->Discard( shared_file );
+    return false;
+  }
+
+  const double* q0 = reinterpret_cast<const double*>( addr + sizeof(HtbHeader) );
+  const double* q_mag = q0 + header->num_q0;
+  const TableEntry* entries = reinterpret_cast<const TableEntry*>(
+    q_mag + header->num_q_mag );
+
+  set_pdg( header->pdg );
+  fGrid = BLI2DNonUnifObjectGrid<TableEntry>(header->num_q0, q0,
+    header->num_q_mag, q_mag, entries);
+
+  return true;
+}
+
+bool genie::TabulatedLabFrameHadronTensor::SaveTable(
+  const std::string& file_name) const
+{
+  if ( fEntries.size() != fq0Points.size() * fqmagPoints.size() ) return false;
+
+  HtbHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kHtbMagic, sizeof(kHtbMagic));
+  header.version = kHtbVersion;
+  header.pdg = pdg();
+  header.num_q0 = fq0Points.size();
+  header.num_q_mag = fqmagPoints.size();
+
+  std::ofstream out( file_name.c_str(), std::ios::out | std::ios::binary );
+  out.write( reinterpret_cast<const char*>(&header), sizeof(header) );
+  out.write( reinterpret_cast<const char*>(fq0Points.data()),
+    fq0Points.size() * sizeof(double) );
+  out.write( reinterpret_cast<const char*>(fqmagPoints.data()),
+    fqmagPoints.size() * sizeof(double) );
+  for ( size_t i = 0; i < fEntries.size(); ++i ) {
+    const TableEntry& e = fEntries[i];
+    double values[5] = { e.W00, e.Wxx, e.Wzz, e.ImWxy, e.ReW0z };
+    out.write( reinterpret_cast<const char*>(values), sizeof(values) );
+  }
+  out.close();
+
+  return !out.fail();
 }
 
 genie::TabulatedLabFrameHadronTensor::~TabulatedLabFrameHadronTensor()
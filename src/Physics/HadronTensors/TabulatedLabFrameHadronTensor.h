@@ -90,6 +90,17 @@ class TabulatedLabFrameHadronTensor : public LabFrameHadronTensorI {
   void read1DGridValues(int num_points, int flag, std::ifstream& in_file,
     std::vector<double>& vec_to_fill);
 
+  /// Reads the table from the data file
+  void ReadTable(const std::string& table_file_name);
+
+  /// Uses the copy of the table shared by all processes on the node (see
+  /// genie::SharedTableStore), making it first if needed. Returns false if
+  /// the store is disabled or unusable.
+  bool LoadSharedTable(const std::string& table_file_name);
+
+  /// Writes the table read with ReadTable() in the shared binary layout
+  bool SaveTable(const std::string& file_name) const;
+
   class TableEntry {
 
     public:
@@ -1545,6 +1545,7 @@ void HAIntranuke2018::LoadConfig(void)
   GetParam( "INUKE-XsecNNCorr",        fXsecNNCorr ) ;
   GetParamDef( "UseOset",              fUseOset, false ) ;
   GetParamDef( "AltOset",              fAltOset, false ) ;
+  GetParamDef( "INUKE-BatchTransport", fBatchTransport, false ) ;
 
   GetParam( "HAINUKE-DelRPion",    fDelRPion ) ;
   GetParam( "HAINUKE-DelRNucleon", fDelRNucleon ) ;
@@ -1577,6 +1578,7 @@ void HAIntranuke2018::LoadConfig(void)
   LOG("HAIntranuke2018", pINFO) << "DoFermi?    = " << ((fDoFermi)?(true):(false));
   LOG("HAIntranuke2018", pINFO) << "DoCmpndNuc? = " << ((fDoCompoundNucleus)?(true):(false));
   LOG("HAIntranuke2018", pINFO) << "XsecNNCorr? = " << ((fXsecNNCorr)?(true):(false));
+  LOG("HAIntranuke2018", pINFO) << "BatchTransp? = " << ((fBatchTransport)?(true):(false));
 }
 //___________________________________________________________________________
 /*
@@ -977,6 +977,7 @@ void HNIntranuke2018::LoadConfig(void)
   GetParam( "INUKE-DoFermi",           fDoFermi ) ;
   GetParam( "INUKE-XsecNNCorr",        fXsecNNCorr ) ;
   GetParamDef( "AltOset",              fAltOset, false ) ;
+  GetParamDef( "INUKE-BatchTransport", fBatchTransport, false ) ;
 
   GetParam( "HNINUKE-UseOset",     fUseOset ) ;
   GetParam( "HNINUKE-DelRPion",    fDelRPion ) ;
@@ -1004,6 +1005,7 @@ void HNIntranuke2018::LoadConfig(void)
   LOG("HNIntranuke2018", pWARN) << "useOset     = " << fUseOset;
   LOG("HNIntranuke2018", pWARN) << "altOset     = " << fAltOset;
   LOG("HNIntranuke2018", pWARN) << "XsecNNCorr? = " << ((fXsecNNCorr)?(true):(false));
+  LOG("HNIntranuke2018", pWARN) << "BatchTransp? = " << ((fBatchTransport)?(true):(false));
   LOG("HNIntranuke2018", pWARN) << "FSI-ChargedPion-MFPScale     = " << fChPionMFPScale;
   LOG("HNIntranuke2018", pWARN) << "FSI-NeutralPion-MFPScale     = " << fNeutralPionMFPScale;
 }
@@ -36,6 +36,9 @@
 //____________________________________________________________________________
 
 #include <cassert>
+#include <climits>
+#include <cstring>
+#include <fstream>
 #include <string>
 
 #include <TSystem.h>
@@ -53,6 +56,7 @@
 #include "Framework/Numerical/RandomGen.h"
 #include "Framework/Numerical/Spline.h"
 #include "Framework/ParticleData/PDGCodes.h"
+#include "Framework/Utils/SharedTableStore.h"
 
 using std::ostringstream;
 using std::ios;
@@ -69,7 +73,7 @@ double INukeHadroData2018::fMaxKinEnergyHN = 1799.0; // MeV
 //____________________________________________________________________________
 INukeHadroData2018::INukeHadroData2018()
 {
-  this->LoadCrossSections();
+  if(!this->LoadSharedTables()) this->LoadCrossSections();
   fInstance = 0;
 }
 //____________________________________________________________________________
@@ -188,10 +192,7 @@ void INukeHadroData2018::LoadCrossSections(void)
 // Loads hadronic x-section data
 
   //-- Get the top-level directory with input hadron cross-section data
-  //   (search for $GINUKEHADRONDATA or use default location)
-  string data_dir = (gSystem->Getenv("GINUKEHADRONDATA")) ?
-             string(gSystem->Getenv("GINUKEHADRONDATA")) :
-             string(gSystem->Getenv("GENIE")) + string("/data/evgen/intranuke");
+  string data_dir = this->DataDir();
 
   LOG("INukeData", pINFO)
       << "Loading INTRANUKE hadron data from: " << data_dir;
@@ -1177,6 +1178,296 @@ void INukeHadroData2018::LoadCrossSections(void)
    
 }
 //____________________________________________________________________________
+string INukeHadroData2018::DataDir(void) const
+{
+// Top-level directory with input hadron cross-section data
+// (search for $GINUKEHADRONDATA or use default location)
+
+  return (gSystem->Getenv("GINUKEHADRONDATA")) ?
+             string(gSystem->Getenv("GINUKEHADRONDATA")) :
+             string(gSystem->Getenv("GENIE")) + string("/data/evgen/intranuke");
+}
+//____________________________________________________________________________
+// Shared INTRANUKE hadron data layout (host byte order; files written on a
+// host of different endianness fail the magic word check):
+//
+//   IhdHeader                                    (fixed size)
+//   double data[ndata]:
+//     per spline : n, E[n], xsec[n]                      (n = 0: no spline)
+//     per grid   : nx, ny, nfillx, nfilly, x[nx], y[ny], z[nx*ny]
+//                                                        (nx = 0: no grid)
+//     per graph  : n, x[n], y[n], z[n]
+//
+// Splines, grids and graphs are listed in the order of SplineSlots(),
+// GridSlots() and GraphSlots().
+//
+namespace {
+
+  const char     kIhdMagic[8] = { 'G','I','N','U','K','E','H','D' };
+  const uint32_t kIhdVersion  = 1;
+
+  struct IhdHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t nsplines;
+    uint32_t ngrids;
+    uint32_t ngraphs;
+    uint64_t ndata;
+  };
+
+  const char * kIhdGraphNames[] = {
+    "TfracPipA_Abs", "TfracPipA_CEx", "TfracPipA_Inelas", "TfracPipA_PiPro"
+  };
+
+  // a count read from the data, if it is a whole number in [0, max] (and an
+  // int, as taken by Spline, BLI2DNonUnifGrid & TGraph2D); the comparison is
+  // made in double so that no file value is cast out of range
+  bool IhdCount(double value, size_t max, size_t & n)
+  {
+    if(!(value >= 0 && value <= (double) max && value <= INT_MAX) ||
+       value != (double)(size_t) value) {
+      return false;
+    }
+    n = (size_t) value;
+    return true;
+  }
+
+} // anonymous namespace
+//____________________________________________________________________________
+vector<Spline **> INukeHadroData2018::SplineSlots(void)
+{
+  Spline ** slots[] = {
+    &fXSecPipn_Tot, &fXSecPipn_CEx, &fXSecPipn_Elas, &fXSecPipn_Reac,
+    &fXSecPipp_Tot, &fXSecPipp_CEx, &fXSecPipp_Elas, &fXSecPipp_Reac,
+    &fXSecPipd_Abs,
+    &fXSecPi0n_Tot, &fXSecPi0n_CEx, &fXSecPi0n_Elas, &fXSecPi0n_Reac,
+    &fXSecPi0p_Tot, &fXSecPi0p_CEx, &fXSecPi0p_Elas, &fXSecPi0p_Reac,
+    &fXSecPi0d_Abs,
+    &fXSecPp_Tot,   &fXSecPp_Elas,  &fXSecPp_Reac,
+    &fXSecPn_Tot,   &fXSecPn_Elas,  &fXSecPn_Reac,
+    &fXSecNn_Tot,   &fXSecNn_Elas,  &fXSecNn_Reac,
+    &fXSecPp_Cmp,   &fXSecPn_Cmp,   &fXSecNn_Cmp,
+    &fXSecKpn_Elas, &fXSecKpp_Elas, &fXSecKpn_CEx, &fXSecKpN_Abs, &fXSecKpN_Tot,
+    &fXSecGamp_fs,  &fXSecGamn_fs,  &fXSecGamN_Tot,
+    &fFracPA_Tot,   &fFracPA_Inel,  &fFracPA_CEx,  &fFracPA_Abs,  &fFracPA_PiPro,
+    &fFracNA_Tot,   &fFracNA_Inel,  &fFracNA_CEx,  &fFracNA_Abs,  &fFracNA_PiPro,
+    &fFracPA_Cmp,   &fFracNA_Cmp,
+    &fFracKA_Tot,   &fFracKA_Elas,  &fFracKA_CEx,  &fFracKA_Inel, &fFracKA_Abs
+  };
+  return vector<Spline **>(slots, slots + sizeof(slots)/sizeof(slots[0]));
+}
+//____________________________________________________________________________
+vector<BLI2DNonUnifGrid **> INukeHadroData2018::GridSlots(void)
+{
+  BLI2DNonUnifGrid ** slots[] = {
+    &fhN2dXSecPP_Elas,   &fhN2dXSecNP_Elas,
+    &fhN2dXSecPipN_Elas, &fhN2dXSecPi0N_Elas, &fhN2dXSecPimN_Elas,
+    &fhN2dXSecKpN_Elas,  &fhN2dXSecKpP_Elas,  &fhN2dXSecKpN_CEx,
+    &fhN2dXSecPiN_CEx,   &fhN2dXSecPiN_Abs,
+    &fhN2dXSecGamPi0P_Inelas, &fhN2dXSecGamPi0N_Inelas,
+    &fhN2dXSecGamPipN_Inelas, &fhN2dXSecGamPimP_Inelas
+  };
+  return vector<BLI2DNonUnifGrid **>(slots, slots + sizeof(slots)/sizeof(slots[0]));
+}
+//____________________________________________________________________________
+vector<TGraph2D **> INukeHadroData2018::GraphSlots(void)
+{
+  TGraph2D ** slots[] = {
+    &TfracPipA_Abs, &TfracPipA_CEx, &TfracPipA_Inelas, &TfracPipA_PiPro
+  };
+  return vector<TGraph2D **>(slots, slots + sizeof(slots)/sizeof(slots[0]));
+}
+//____________________________________________________________________________
+bool INukeHadroData2018::LoadSharedTables(void)
+{
+  SharedTableStore * store = SharedTableStore::Instance();
+  if(!store->IsEnabled()) return false;
+
+  // version the tables against every data file read by LoadCrossSections()
+  // (the size & time stamp of all files below the data directories)
+  string data_dir = this->DataDir();
+  ostringstream format;
+  format << "intranuke hadron data v" << kIhdVersion;
+  uint64_t hash = SharedTableStore::Hash(format.str());
+  hash = SharedTableStore::HashDir(data_dir + "/tot_xsec", hash);
+  hash = SharedTableStore::HashDir(data_dir + "/diff_ang", hash);
+
+  bool built = false;
+  string shared_file = store->Acquire("intranuke-hadron-data", hash,
+    [this](const string & out) {
+      this->LoadCrossSections();
+      return this->SaveTables(out);
+    },
+    built);
+
+  // the building process keeps the tables it has just loaded
+  if(built) return true;
+  if(shared_file.size() == 0) return false;
+
+  size_t size = 0;
+  const void * addr = store->Map(shared_file, size);
+  if(addr && this->ReadTables(addr, size)) {
+    LOG("INukeData", pNOTICE)
+       << "Loaded INTRANUKE hadron data from shared table: " << shared_file;
+    return true;
+  }
+
+  store->Discard(shared_file);
+  return false;
+}
+//____________________________________________________________________________
+bool INukeHadroData2018::SaveTables(const string & filename)
+{
+  vector<Spline **>           splines = this->SplineSlots();
+  vector<BLI2DNonUnifGrid **> grids   = this->GridSlots();
+  vector<TGraph2D **>         graphs  = this->GraphSlots();
+
+  vector<double> data;
+
+  for(unsigned int i = 0; i < splines.size(); i++) {
+    const Spline * spl = *splines[i];
+    int n = (spl) ? spl->NKnots() : 0;
+    data.push_back(n);
+    for(int k = 0; k < n; k++) data.push_back(spl->GetKnotX(k));
+    for(int k = 0; k < n; k++) data.push_back(spl->GetKnotY(k));
+  }
+  for(unsigned int i = 0; i < grids.size(); i++) {
+    const BLI2DNonUnifGrid * grid = *grids[i];
+    int nx = (grid) ? grid->NX() : 0;
+    int ny = (grid) ? grid->NY() : 0;
+    data.push_back(nx);
+    data.push_back(ny);
+    data.push_back((grid) ? grid->NFillX() : 0);
+    data.push_back((grid) ? grid->NFillY() : 0);
+    if(nx == 0 || ny == 0) continue;
+    data.insert(data.end(), grid->X(), grid->X() + nx);
+    data.insert(data.end(), grid->Y(), grid->Y() + ny);
+    data.insert(data.end(), grid->Z(), grid->Z() + nx*ny);
+  }
+  for(unsigned int i = 0; i < graphs.size(); i++) {
+    TGraph2D * graph = *graphs[i];
+    int n = (graph) ? graph->GetN() : 0;
+    data.push_back(n);
+    if(n == 0) continue;
+    data.insert(data.end(), graph->GetX(), graph->GetX() + n);
+    data.insert(data.end(), graph->GetY(), graph->GetY() + n);
+    data.insert(data.end(), graph->GetZ(), graph->GetZ() + n);
+  }
+
+  IhdHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, kIhdMagic, sizeof(kIhdMagic));
+  header.version  = kIhdVersion;
+  header.nsplines = splines.size();
+  header.ngrids   = grids.size();
+  header.ngraphs  = graphs.size();
+  header.ndata    = data.size();
+
+  std::ofstream out(filename.c_str(), ios::out | ios::binary);
+  out.write((const char *) &header, sizeof(header));
+  out.write((const char *) &data[0], data.size() * sizeof(double));
+  out.close();
+
+  return !out.fail();
+}
+//____________________________________________________________________________
+bool INukeHadroData2018::ReadTables(const void * addr, size_t size)
+{
+  vector<Spline **>           splines = this->SplineSlots();
+  vector<BLI2DNonUnifGrid **> grids   = this->GridSlots();
+  vector<TGraph2D **>         graphs  = this->GraphSlots();
+
+  const IhdHeader * header = (const IhdHeader *) addr;
+  bool valid =
+     size >= sizeof(IhdHeader) &&
+     memcmp(header->magic, kIhdMagic, sizeof(kIhdMagic)) == 0 &&
+     header->version  == kIhdVersion    &&
+     header->nsplines == splines.size() &&
+     header->ngrids   == grids.size()   &&
+     header->ngraphs  == graphs.size()  &&
+     header->ndata <= (size - sizeof(IhdHeader)) / sizeof(double);
+  if(!valid) {
+    LOG("INukeData", pERROR) << "Invalid or unsupported shared INTRANUKE data";
+    return false;
+  }
+
+  const double * data = (const double *) ((const char *) addr + sizeof(IhdHeader));
+  const double * end  = data + header->ndata;
+
+  // check each block fits before using it; on failure nothing is kept
+  vector<Spline *>           new_splines;
+  vector<BLI2DNonUnifGrid *> new_grids;
+  vector<TGraph2D *>         new_graphs;
+  bool ok = true;
+
+  // sizes are checked against what is left of the data (end - data), in
+  // size_t, before any pointer is formed from them
+  for(unsigned int i = 0; ok && i < splines.size(); i++) {
+    size_t n = 0;
+    ok = (data < end);
+    if(ok) { double v = *data++; ok = IhdCount(v, (end - data)/2, n); }
+    if(!ok) break;
+    Spline * spl = 0;
+    if(n > 0) {
+      vector<double> E    (data,     data + n);
+      vector<double> xsec (data + n, data + 2*n);
+      spl = new Spline(n, E.data(), xsec.data());
+    }
+    new_splines.push_back(spl);
+    data += 2*n;
+  }
+  for(unsigned int i = 0; ok && i < grids.size(); i++) {
+    ok = (end - data >= 4);
+    if(!ok) break;
+    size_t left = (end - data) - 4;
+    size_t nx = 0, ny = 0, nfillx = 0, nfilly = 0;
+    // nx + ny + nx*ny <= left  <=>  (nx+1)*(ny+1) <= left+1
+    ok = IhdCount(data[0], left, nx) && IhdCount(data[1], left, ny) &&
+         ny + 1 <= (left + 1) / (nx + 1) &&
+         IhdCount(data[2], nx, nfillx) && IhdCount(data[3], ny, nfilly);
+    if(!ok) break;
+    data += 4;
+    BLI2DNonUnifGrid * grid = 0;
+    if(nx > 0 && ny > 0) {
+      grid = new BLI2DNonUnifGrid(nx, ny, nfillx, nfilly,
+                                  data, data + nx, data + nx + ny);
+    }
+    new_grids.push_back(grid);
+    data += nx + ny + nx*ny;
+  }
+  for(unsigned int i = 0; ok && i < graphs.size(); i++) {
+    size_t n = 0;
+    ok = (data < end);
+    if(ok) { double v = *data++; ok = IhdCount(v, (end - data)/3, n); }
+    if(!ok) break;
+    TGraph2D * graph = 0;
+    if(n > 0) {
+      vector<double> x (data,       data + n);
+      vector<double> y (data + n,   data + 2*n);
+      vector<double> z (data + 2*n, data + 3*n);
+      graph = new TGraph2D(n, x.data(), y.data(), z.data());
+      graph->SetNameTitle(kIhdGraphNames[i], kIhdGraphNames[i]);
+      graph->SetDirectory(0);
+    }
+    new_graphs.push_back(graph);
+    data += 3*n;
+  }
+
+  if(!ok) {
+    LOG("INukeData", pERROR) << "Truncated shared INTRANUKE data";
+    for(unsigned int i = 0; i < new_splines.size(); i++) delete new_splines[i];
+    for(unsigned int i = 0; i < new_grids.size();   i++) delete new_grids[i];
+    for(unsigned int i = 0; i < new_graphs.size();  i++) delete new_graphs[i];
+    return false;
+  }
+
+  for(unsigned int i = 0; i < splines.size(); i++) *splines[i] = new_splines[i];
+  for(unsigned int i = 0; i < grids.size();   i++) *grids[i]   = new_grids[i];
+  for(unsigned int i = 0; i < graphs.size();  i++) *graphs[i]  = new_graphs[i];
+
+  return true;
+}
+//____________________________________________________________________________
 void INukeHadroData2018::ReadhNFile(
   string filename, double ke, int npoints, int & curr_point,
   double * costh_array, double * xsec_array, int cols)
@@ -42,6 +42,12 @@
 #include "Framework/GHEP/GHepParticle.h"
 #include "Framework/Numerical/BLI2D.h"
 
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
 class TGraph2D;
 
 namespace genie {
@@ -153,6 +159,18 @@ private:
 
   void LoadCrossSections(void);
 
+  // Tables can be shared by all processes on a node (see SharedTableStore):
+  // the first process loads them from the data files and saves them, the
+  // others build them from the shared file (using its hN grid nodes as is)
+  bool   LoadSharedTables (void);
+  bool   SaveTables       (const string & filename);
+  bool   ReadTables       (const void * addr, size_t size);
+  string DataDir          (void) const;
+
+  vector<Spline **>           SplineSlots (void);
+  vector<BLI2DNonUnifGrid **> GridSlots   (void);
+  vector<TGraph2D **>         GraphSlots  (void);
+
   void ReadhNFile(
          string filename, double ke, int npoints, int & curr_point,
          /*double * ke_array,*/ double * costh_array, double * xsec_array, int cols);
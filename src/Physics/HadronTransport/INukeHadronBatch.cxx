@@ -0,0 +1,120 @@
+//____________________________________________________________________________
+/*
+ Copyright (c) 2003-2023, The GENIE Collaboration
+ For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#include <cassert>
+
+#include <TLorentzVector.h>
+#include <TVector3.h>
+
+#include "Framework/GHEP/GHepParticle.h"
+#include "Physics/HadronTransport/INukeHadronBatch.h"
+
+using namespace genie;
+
+//___________________________________________________________________________
+INukeHadronBatch::INukeHadronBatch() :
+fNInFlight(0)
+{
+
+}
+//___________________________________________________________________________
+INukeHadronBatch::~INukeHadronBatch()
+{
+  this->Clear();
+}
+//___________________________________________________________________________
+void INukeHadronBatch::Clear(void)
+{
+  vector<GHepParticle *>::iterator it = fParticle.begin();
+  for( ; it != fParticle.end(); ++it) {
+    if(*it) delete (*it);
+  }
+  fX.clear();  fY.clear();  fZ.clear();  fT.clear();
+  fUx.clear(); fUy.clear(); fUz.clear(); fMove.clear();
+  fPdg.clear();
+  fStatus.clear();
+  fParticle.clear();
+  fNInFlight = 0;
+}
+//___________________________________________________________________________
+void INukeHadronBatch::Add(GHepParticle * p)
+{
+  assert(p);
+
+  const TLorentzVector & x4 = *(p->X4());
+  TVector3 u = p->P4()->Vect().Unit();
+
+  fX.push_back(x4.X());
+  fY.push_back(x4.Y());
+  fZ.push_back(x4.Z());
+  fT.push_back(x4.T());
+  fUx.push_back(u.X());
+  fUy.push_back(u.Y());
+  fUz.push_back(u.Z());
+  fMove.push_back(1.);
+  fPdg.push_back(p->Pdg());
+  fStatus.push_back(kINukeBatchInFlight);
+  fParticle.push_back(p);
+  fNInFlight++;
+}
+//___________________________________________________________________________
+void INukeHadronBatch::Step(double step)
+{
+// Same straight-line step as utils::intranuke2018::StepParticle() (without
+// the nuclear boundary clamp), applied to all hadrons at once. Hadrons no
+// longer in flight have fMove=0 and are left in place.
+
+  const int n = this->Size();
+  double * x = &fX[0];
+  double * y = &fY[0];
+  double * z = &fZ[0];
+  const double * ux = &fUx[0];
+  const double * uy = &fUy[0];
+  const double * uz = &fUz[0];
+  const double * mv = &fMove[0];
+
+  for(int i = 0; i < n; i++) {
+    double ds = step * mv[i];
+    x[i] += ds * ux[i];
+    y[i] += ds * uy[i];
+    z[i] += ds * uz[i];
+  }
+}
+//___________________________________________________________________________
+int INukeHadronBatch::FlagEscaped(double rmax)
+{
+// Matches Intranuke2018::IsInNucleus(): a hadron is inside while r < rmax.
+
+  const int n = this->Size();
+  const double rmax2 = rmax*rmax;
+
+  int nesc = 0;
+  for(int i = 0; i < n; i++) {
+    double r2 = fX[i]*fX[i] + fY[i]*fY[i] + fZ[i]*fZ[i];
+    bool out = (fMove[i] > 0.) && (r2 >= rmax2);
+    if(out) {
+      this->SetStatus(i, kINukeBatchEscaped);
+      nesc++;
+    }
+  }
+  return nesc;
+}
+//___________________________________________________________________________
+void INukeHadronBatch::SetStatus(int i, INukeBatchStatus_t st)
+{
+  if(fStatus[i] == kINukeBatchInFlight && st != kINukeBatchInFlight) {
+    fNInFlight--;
+    fMove[i] = 0.;
+  }
+  fStatus[i] = st;
+}
+//___________________________________________________________________________
+void INukeHadronBatch::SyncPosition(int i)
+{
+  fParticle[i]->SetPosition(fX[i], fY[i], fZ[i], fT[i]);
+}
+//___________________________________________________________________________
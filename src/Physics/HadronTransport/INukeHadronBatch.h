@@ -0,0 +1,93 @@
+//____________________________________________________________________________
+/*!
+
+\class    genie::INukeHadronBatch
+
+\brief    Structure-of-arrays container for the hadrons propagated together
+          by the batched INTRANUKE cascade (see Intranuke2018).
+          Positions, directions, species and tracking status are kept in
+          contiguous arrays so that the geometric part of the stepping
+          (advancing all hadrons by a step and testing whether they have
+          left the nucleus) can be done in tight, vectorizable loops.
+          The GHepParticle clones are only touched when a hadron interacts
+          or escapes, at which point its position is synchronized back.
+
+\author   GENIE Collaboration
+
+\created  October 16, 2026
+
+\cpright  Copyright (c) 2003-2023, The GENIE Collaboration
+          For the full text of the license visit http://copyright.genie-mc.org
+
+*/
+//____________________________________________________________________________
+
+#ifndef _INUKE_HADRON_BATCH_H_
+#define _INUKE_HADRON_BATCH_H_
+
+#include <vector>
+
+using std::vector;
+
+namespace genie {
+
+class GHepParticle;
+
+typedef enum EINukeBatchStatus {
+  kINukeBatchInFlight = 0,
+  kINukeBatchInteracted,
+  kINukeBatchEscaped
+} INukeBatchStatus_t;
+
+class INukeHadronBatch {
+
+public :
+  INukeHadronBatch();
+ ~INukeHadronBatch();
+
+  //! Remove all entries (the owned particle clones are deleted)
+  void Clear (void);
+
+  //! Append a hadron, taking ownership of the input particle clone
+  void Add (GHepParticle * p);
+
+  //! Advance all in-flight hadrons by the input step (fm)
+  void Step (double step);
+
+  //! Mark in-flight hadrons at r >= rmax (fm) as escaped; returns their number
+  int FlagEscaped (double rmax);
+
+  //! Copy the tracked position of the i-th hadron back to its particle
+  void SyncPosition (int i);
+
+  int                  Size      (void)  const { return (int) fPdg.size(); }
+  int                  NInFlight (void)  const { return fNInFlight; }
+  int                  Pdg       (int i) const { return fPdg[i]; }
+  INukeBatchStatus_t   Status    (int i) const { return fStatus[i]; }
+  GHepParticle *       Particle  (int i) const { return fParticle[i]; }
+  double               X         (int i) const { return fX[i]; }
+  double               Y         (int i) const { return fY[i]; }
+  double               Z         (int i) const { return fZ[i]; }
+  double               T         (int i) const { return fT[i]; }
+
+  void SetStatus (int i, INukeBatchStatus_t st);
+
+private:
+
+  vector<double>             fX;         ///< x position (fm)
+  vector<double>             fY;         ///< y position (fm)
+  vector<double>             fZ;         ///< z position (fm)
+  vector<double>             fT;         ///< time coordinate
+  vector<double>             fUx;        ///< unit momentum direction, x
+  vector<double>             fUy;        ///< unit momentum direction, y
+  vector<double>             fUz;        ///< unit momentum direction, z
+  vector<double>             fMove;      ///< 1 while in flight, 0 otherwise (branch-free stepping)
+  vector<int>                fPdg;       ///< hadron species
+  vector<INukeBatchStatus_t> fStatus;    ///< tracking status
+  vector<GHepParticle *>     fParticle;  ///< owned clones of the GHEP entries being transported
+  int                        fNInFlight; ///< number of hadrons still being stepped
+};
+
+}      // genie namespace
+
+#endif // _INUKE_HADRON_BATCH_H_
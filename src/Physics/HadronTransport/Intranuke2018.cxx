@@ -72,6 +72,7 @@
 #include "Physics/HadronTransport/Intranuke2018.h"
 #include "Physics/HadronTransport/INukeHadroData2018.h"
 #include "Physics/HadronTransport/INukeHadroFates.h"
+#include "Physics/HadronTransport/INukeHadronBatch.h"
 #include "Physics/HadronTransport/INukeMode.h"
 #include "Physics/HadronTransport/INukeUtils2018.h"
 #include "Framework/Interaction/Interaction.h"
@@ -299,6 +300,13 @@ void Intranuke2018::TransportHadrons(GHepRecord * evrec) const
   const TLorentzVector & p4nucl = *(nucl->P4());
   fRemnP4 = p4nucl;
 
+  // Optionally, propagate all hadrons together using the batched engine
+  if(fBatchTransport) {
+    this->TransportHadronsBatch(evrec);
+    this->AddRemnantNucleus(evrec, inucl);
+    return;
+  }
+
   // Loop over GHEP and run intranuclear rescattering on handled particles
   TObjArrayIter piter(evrec);
   GHepParticle * p = 0;
@@ -375,6 +383,11 @@ void Intranuke2018::TransportHadrons(GHepRecord * evrec) const
 
   }// GHEP entries
 
+  this->AddRemnantNucleus(evrec, inucl);
+}
+//___________________________________________________________________________
+void Intranuke2018::AddRemnantNucleus(GHepRecord * evrec, int inucl) const
+{
   // Add remnant nucleus - that 'hadronic blob' has all the remaining hadronic
   // 4p not  put explicitly into the simulated particles
   TLorentzVector v4(0.,0.,0.,0.);
@@ -390,14 +403,128 @@ void Intranuke2018::TransportHadrons(GHepRecord * evrec) const
   }
 }
 //___________________________________________________________________________
+void Intranuke2018::TransportHadronsBatch(GHepRecord * evrec) const
+{
+// Alternative to the GHEP-walking loop in TransportHadrons().
+// All hadrons waiting to be rescattered are loaded in an INukeHadronBatch and
+// are stepped together. Each step, every in-flight hadron is tested against
+// the tracking radius, advanced by fHadStep and an interaction distance is
+// drawn for it (same sequence as for a single hadron in the scalar loop).
+// Hadrons that interact are handed, in GHEP order, to the mode-specific
+// SimulateHadronicFinalState(). Any hadrons that this pushes back into the
+// nucleus (hN mode) form the next batch, until nothing is left to transport.
+// GHEP entries are only created once a hadron's fate is known.
+//
+// The physics is the same as in the scalar path, but the order in which
+// hadrons see the evolving remnant (A,Z) and the order of the random number
+// draws differ, so the two agree statistically, not event by event (except
+// for a single hadron in hA mode). See the gtestINukeBatch test program.
+
+  INukeHadronBatch & batch = fBatch;
+
+  int ifirst = 0;
+  while(1) {
+
+    batch.Clear();
+
+    // Collect the hadrons to transport, starting from the first GHEP
+    // entry not yet examined
+    int nentries = evrec->GetEntries();
+    for(int icurr = ifirst; icurr < nentries; icurr++) {
+      GHepParticle * p = evrec->Particle(icurr);
+
+      if( ! this->NeedsRescattering(p) ) continue;
+
+      LOG("Intranuke2018", pNOTICE)
+        << " >> Batching a " << p->Name()
+                          << " with kinetic E = " << p->KinE() << " GeV";
+
+      // Rescatter a clone, not the original particle
+      GHepParticle * sp = new GHepParticle(*p);
+      sp->SetFirstMother(icurr);
+
+      if(!this->CanRescatter(sp)) {
+         LOG("Intranuke2018", pNOTICE)
+                << "... Current version can't rescatter a " << sp->Name();
+         sp->SetStatus(kIStStableFinalState);
+         evrec->AddParticle(*sp);
+         delete sp;
+         continue;
+      }
+      batch.Add(sp);
+    }
+    ifirst = nentries;
+
+    if(batch.Size() == 0) break;
+
+    LOG("Intranuke2018", pINFO)
+      << "Transporting a batch of " << batch.Size() << " hadrons";
+
+    const double rmax = fTrackingRadius + fHadStep;
+    const int n = batch.Size();
+
+    while(batch.NInFlight() > 0) {
+
+      // escape test, then advance everything still inside
+      batch.FlagEscaped(rmax);
+      if(batch.NInFlight() == 0) break;
+      batch.Step(fHadStep);
+
+      // draw interaction distances
+      for(int i = 0; i < n; i++) {
+        if(batch.Status(i) != kINukeBatchInFlight) continue;
+
+        GHepParticle * sp = batch.Particle(i);
+        TLorentzVector x4(batch.X(i), batch.Y(i), batch.Z(i), batch.T(i));
+        double d = this->GenerateStep(batch.Pdg(i), x4, *sp->P4());
+        if(d >= fHadStep) continue;
+
+        batch.SetStatus(i, kINukeBatchInteracted);
+        batch.SyncPosition(i);
+
+        if(fRemnA > 0) {
+          LOG("Intranuke2018", pNOTICE)
+            << "Particle has interacted at location:  "
+            << sp->X4()->Vect().Mag() << " / nucl rad= " << fTrackingRadius;
+          this->SimulateHadronicFinalState(evrec,sp);
+        } else {
+          LOG("Intranuke2018", pNOTICE)
+            << "*** Nothing left to interact with, escaping.";
+          sp->SetStatus(kIStStableFinalState);
+          evrec->AddParticle(*sp);
+          evrec->Particle(sp->FirstMother())->SetRescatterCode(1);
+        }
+      }
+    }//stepping
+
+    // Materialize the hadrons that left the nucleus without interacting
+    for(int i = 0; i < n; i++) {
+      if(batch.Status(i) != kINukeBatchEscaped) continue;
+      LOG("Intranuke2018", pNOTICE)
+        << "*** Hadron escaped the nucleus! Done with it.";
+      batch.SyncPosition(i);
+      GHepParticle * sp = batch.Particle(i);
+      sp->SetStatus(kIStStableFinalState);
+      evrec->AddParticle(*sp);
+      evrec->Particle(sp->FirstMother())->SetRescatterCode(1);
+    }
+  }// batches
+
+  batch.Clear();
+}
+//___________________________________________________________________________
 double Intranuke2018::GenerateStep(GHepRecord*  /*evrec*/, GHepParticle* p) const //Added ev to get tgt argument//
 {
-// Generate a step (in fermis) for particle p in the input event.
+  return this->GenerateStep(p->Pdg(), *p->X4(), *p->P4());
+}
+//___________________________________________________________________________
+double Intranuke2018::GenerateStep(
+  int pdgc, const TLorentzVector & x4, const TLorentzVector & p4) const
+{
+// Generate a step (in fermis) for a hadron of type pdgc at x4 with momentum p4.
 // Computes the mean free path L and generate an 'interaction' distance d
 // from an exp(-d/L) distribution
 
-  int pdgc = p->Pdg();
-
   double scale = 1.;
   if (pdgc==kPdgPiP || pdgc==kPdgPiM) {
     scale = fChPionMFPScale;
@@ -414,7 +541,7 @@ double Intranuke2018::GenerateStep(GHepRecord*  /*evrec*/, GHepParticle* p) cons
   string fINukeMode = this->GetINukeMode();
   string fINukeModeGen = this->GetGenINukeMode();
 
-  double L = utils::intranuke2018::MeanFreePath(p->Pdg(), *p->X4(), *p->P4(), fRemnA,
+  double L = utils::intranuke2018::MeanFreePath(pdgc, x4, p4, fRemnA,
 						fRemnZ, fDelRPion, fDelRNucleon, fUseOset, fAltOset, fXsecNNCorr, fINukeMode);
 
   LOG("Intranuke2018", pDEBUG)    << "mode= " << fINukeModeGen;
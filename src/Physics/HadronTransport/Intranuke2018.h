@@ -39,6 +39,7 @@
 #include "Framework/Conventions/GMode.h"
 #include "Physics/HadronTransport/INukeMode.h"
 #include "Physics/HadronTransport/INukeHadroFates2018.h"
+#include "Physics/HadronTransport/INukeHadronBatch.h"
 
 class TLorentzVector;
 class TVector3;
@@ -91,6 +92,7 @@ public :
   inline bool GetUseOset() const { return fUseOset; }
   inline bool GetAltOset() const { return fAltOset; }
   inline bool GetXsecNNCorr() const { return fXsecNNCorr; }
+  inline bool GetBatchTransport() const { return fBatchTransport; }
 
 protected:
 
@@ -105,6 +107,9 @@ protected:
   bool   IsInNucleus        (const GHepParticle* p) const;
   void   SetTrackingRadius  (const GHepParticle* p) const;
   double GenerateStep       (GHepRecord* ev, GHepParticle* p) const;
+  double GenerateStep       (int pdgc, const TLorentzVector & x4, const TLorentzVector & p4) const;
+  void   TransportHadronsBatch (GHepRecord * ev) const;
+  void   AddRemnantNucleus  (GHepRecord * ev, int inucl) const;
 
   // virtual functions for individual modes
   virtual void SimulateHadronicFinalState(GHepRecord* ev, GHepParticle* p) const = 0;
@@ -120,6 +125,7 @@ protected:
   mutable int            fRemnZ;         ///< remnant nucleus Z
   mutable TLorentzVector fRemnP4;        ///< P4 of remnant system
   mutable GEvGenMode_t   fGMode;         ///< event generation mode (lepton+A, hadron+A, ...)
+  mutable INukeHadronBatch fBatch;       ///< hadrons in flight, used by the batched transport
 
   // configuration parameters
   double       fR0;           ///< effective nuclear size param
@@ -139,6 +145,7 @@ protected:
   bool         fUseOset;      ///< Oset model for low energy pion in hN
   bool         fAltOset;      ///< NuWro's table-based implementation (not recommended)
   bool         fXsecNNCorr;   ///< use nuclear medium correction for NN cross section
+  bool         fBatchTransport; ///< step all hadrons of the event together (see TransportHadronsBatch)
 
   double       fChPionMFPScale;       ///< tweaking factors for tuning
   double       fNeutralPionMFPScale;
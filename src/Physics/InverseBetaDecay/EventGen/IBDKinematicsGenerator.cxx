@@ -117,6 +117,7 @@ void IBDKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
   bool accept = false;
   while(1) {
      iter++;
+     this->CountRejectionIteration();
      if(iter > kRjMaxIterations) {
         LOG("IBD", pWARN)
           << "Couldn't select a valid Q^2 after " << iter << " iterations";
@@ -133,7 +134,7 @@ void IBDKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
      LOG("IBD", pINFO) << "Trying: Q^2 = " << gQ2;
 
      //-- Computing cross section for the current kinematics
-     xsec = fXSecModel->XSec(interaction, kPSQ2fE);
+     xsec = this->EvalXSec(interaction, kPSQ2fE);
 
      //-- Decide whether to accept the current kinematics
      if(!fGenerateUniformly) {
@@ -271,7 +272,7 @@ double IBDKinematicsGenerator::ComputeMaxXSec(
   for(int i=0; i<N; i++) {
      double Q2 = TMath::Exp(logQ2min + i * dlogQ2);
      interaction->KinePtr()->SetQ2(Q2);
-     double xsec = fXSecModel->XSec(interaction, kPSQ2fE);
+     double xsec = this->EvalXSec(interaction, kPSQ2fE);
 #ifdef __GENIE_LOW_LEVEL_MESG_ENABLED__
      LOG("IBD", pDEBUG)  << "xsec(Q2= " << Q2 << ") = " << xsec;
 #endif
@@ -288,7 +289,7 @@ double IBDKinematicsGenerator::ComputeMaxXSec(
 	 Q2 = TMath::Exp(TMath::Log(Q2) - dlogQ2);
          if(Q2 < rQ2.min) continue;
          interaction->KinePtr()->SetQ2(Q2);
-         xsec = fXSecModel->XSec(interaction, kPSQ2fE);
+         xsec = this->EvalXSec(interaction, kPSQ2fE);
 #ifdef __GENIE_LOW_LEVEL_MESG_ENABLED__
          LOG("IBD", pDEBUG)  << "xsec(Q2= " << Q2 << ") = " << xsec;
 #endif
@@ -81,6 +81,7 @@ void NuEKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
   bool accept = false;
   while(1) {
      iter++;
+     this->CountRejectionIteration();
      if(iter > kRjMaxIterations) {
         LOG("NuEKinematics", pWARN)
               << "*** Could not select a valid y after "
@@ -98,7 +99,7 @@ void NuEKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
      LOG("NuEKinematics", pINFO) << "Trying: y = " << y;
 
      //-- computing cross section for the current kinematics
-     xsec = fXSecModel->XSec(interaction, kPSyfE);
+     xsec = this->EvalXSec(interaction, kPSyfE);
 
      //-- decide whether to accept the current kinematics
      if(!fGenerateUniformly) {
@@ -170,7 +171,7 @@ double NuEKinematicsGenerator::ComputeMaxXSec(
   for(int i=0; i<N; i++) {
     double y = ymin + i * dy;
     interaction->KinePtr()->Sety(y);
-    double xsec = fXSecModel->XSec(interaction, kPSyfE);
+    double xsec = this->EvalXSec(interaction, kPSyfE);
 
     SLOG("NuEKinematics", pDEBUG) << "xsec(y = " << y << ") = " << xsec;
     max_xsec = TMath::Max(xsec, max_xsec);
@@ -187,7 +188,7 @@ double NuEKinematicsGenerator::ComputeMaxXSec(
 	 y = y-dy;
          if(y<ymin) break;
          interaction->KinePtr()->Sety(y);
-         xsec = fXSecModel->XSec(interaction, kPSyfE);
+         xsec = this->EvalXSec(interaction, kPSyfE);
          SLOG("NuEKinematics", pDEBUG) << "xsec(y = " << y << ") = " << xsec;
          max_xsec = TMath::Max(xsec, max_xsec);
        }
@@ -51,7 +51,7 @@ NuclearModelI("genie::EffectiveSF", config)
 //____________________________________________________________________________
 EffectiveSF::~EffectiveSF()
 {
-  map<string, TH1D*>::iterator iter = fProbDistroMap.begin();
+  map<pair<int,int>, TH1D*>::iterator iter = fProbDistroMap.begin();
   for( ; iter != fProbDistroMap.begin(); ++iter) {
     TH1D * hst = iter->second;
     if(hst) {
@@ -145,7 +145,9 @@ double EffectiveSF::Prob(double mom, double w, const Target & target) const
 TH1D * EffectiveSF::ProbDistro(const Target & target) const
 {
   //-- return stored /if already computed/
-  map<string, TH1D*>::iterator it = fProbDistroMap.find(target.AsString());
+  //   (the distribution only depends on the nucleus and the hit nucleon)
+  pair<int,int> key(target.Pdg(), target.HitNucIsSet() ? target.HitNucPdg() : 0);
+  map<pair<int,int>, TH1D*>::iterator it = fProbDistroMap.find(key);
   if(it != fProbDistroMap.end()) return it->second;
 
   LOG("EffectiveSF", pNOTICE)
@@ -238,8 +240,9 @@ TH1D * EffectiveSF::MakeEffectiveSF(double bs, double bp, double alpha,
   prob->Scale( 1.0 / prob->Integral("width") );
 
   //-- store
+  pair<int,int> key(target.Pdg(), target.HitNucIsSet() ? target.HitNucPdg() : 0);
   fProbDistroMap.insert(
-      map<string, TH1D*>::value_type(target.AsString(),prob));
+      map<pair<int,int>, TH1D*>::value_type(key,prob));
   return prob;
 }
 //____________________________________________________________________________
@@ -22,12 +22,14 @@
 #define _EFFECTIVE_SF_H_
 
 #include <map>
+#include <utility>
 
 #include <TH1D.h>
 
 #include "Physics/NuclearState/NuclearModelI.h"
 
 using std::map;
+using std::pair;
 
 namespace genie {
 
@@ -69,7 +71,7 @@ private:
   double Returnf1p1h(const Target & target) const;
   void   LoadConfig (void);
 
-  mutable map<string, TH1D *> fProbDistroMap;
+  mutable map<pair<int,int>, TH1D *> fProbDistroMap; ///< (target pdg, hit nucleon pdg) -> P(p_nucleon)
   double fPMax;
   double fPCutOff;
   bool   fEjectSecondNucleon2p2h;
@@ -140,6 +140,7 @@ void QELEventGenerator::ProcessEventRecord(GHepRecord * evrec) const
     while (1) {
 
         iter++;
+        this->CountRejectionIteration();
         LOG("QELEvent", pINFO) << "Attempt #: " << iter;
         if(iter > kRjMaxIterations) {
             LOG("QELEvent", pWARN)
@@ -138,6 +138,7 @@ void QELEventGeneratorSM::ProcessEventRecord(GHepRecord * evrec) const
   TLorentzVector q;
   while(1)
   {
+     this->CountRejectionIteration();
      LOG("QELEvent", pINFO) << "Attempt #: " << iter;
      if(iter > 100*kRjMaxIterations)
      {
@@ -189,7 +190,7 @@ void QELEventGeneratorSM::ProcessEventRecord(GHepRecord * evrec) const
      kinematics->SetKV(kKVQ2, Q2);
      kinematics->SetKV(kKVv, v);
      kinematics->SetKV(kKVPn, kF);
-     xsec = fXSecModel->XSec(interaction, fkps);
+     xsec = this->EvalXSec(interaction, fkps);
      //-- Decide whether to accept the current kinematics
      if(!fGenerateUniformly)
      {
@@ -485,7 +486,7 @@ double QELEventGeneratorSM::ComputeMaxXSec(const Interaction * interaction) cons
           kinematics->SetKV(kKVv, v);
           kinematics->SetKV(kKVPn, pFmax);
           // Compute the QE cross section for the current kinematics
-          double xs = fXSecModel->XSec(interaction, fkps);
+          double xs = this->EvalXSec(interaction, fkps);
           if (xs > tmp_xsec_max)
           {
              tmp_xsec_max = xs;
@@ -569,7 +570,7 @@ double QELEventGeneratorSM::ComputeMaxXSec(const Interaction * interaction, cons
            kinematics->SetKV(kKVv, v);
            kinematics->SetKV(kKVPn, pFmax);
            // Compute the QE cross section for the current kinematics
-           double xs = fXSecModel->XSec(interaction, fkps);
+           double xs = this->EvalXSec(interaction, fkps);
            if (xs > tmp_xsec_max)
            {
               tmp_xsec_max = xs;
@@ -66,6 +66,7 @@ private:
   void   LoadConfig     (void);
   double ComputeMaxXSec(const Interaction * in) const;
   double ComputeMaxXSec (const Interaction * in, const int nkey) const;
+  bool   MaxXSecIsPrecomputable (const Interaction *) const { return false; } ///< max depends on the phase space & SM state set per event
   void AddTargetNucleusRemnant (GHepRecord * evrec) const; ///< add a recoiled nucleus remnant
 
   
@@ -169,6 +169,7 @@ void QELEventGeneratorSuSA::SelectLeptonKinematics (GHepRecord * event) const
   // loop over different (randomly) selected T and Costh
   while (!accept) {
       iter++;
+      this->CountRejectionIteration();
       if(iter > maxIter) {
           // error if try too many times
           LOG("QELEvent", pERROR)
@@ -210,7 +211,7 @@ void QELEventGeneratorSuSA::SelectLeptonKinematics (GHepRecord * event) const
           kinematics->SetKV(kKVctl, Costh);
           LOG("QELEvent", pDEBUG) << " T, Costh, Q2: " << T << ", " << Costh << ", " << Q2;
 
-          double XSec = fXSecModel->XSec(interaction, kPSTlctl);
+          double XSec = this->EvalXSec(interaction, kPSTlctl);
 
           // Some debugging if things go wrong here...
           if (XSec > XSecMax) {
@@ -416,6 +417,7 @@ void QELEventGeneratorSuSA::GenerateNucleon(GHepRecord * event) const
     // be allowed to affect the inclusive xsec.
     while(!accept){
         iter++;
+        this->CountRejectionIteration();
         if(iter > kRjMaxIterations) {
             // error if try too many times
             LOG("QELEvent", pWARN)
@@ -119,6 +119,7 @@ void QELKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
   bool accept = false;
   while(1) {
      iter++;
+     this->CountRejectionIteration();
      if(iter > kRjMaxIterations) {
         LOG("QELKinematics", pWARN)
           << "Couldn't select a valid Q^2 after " << iter << " iterations";
@@ -144,7 +145,7 @@ void QELKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
      LOG("QELKinematics", pINFO) << "Trying: Q^2 = " << gQ2;
 
      //-- Computing cross section for the current kinematics
-     xsec = fXSecModel->XSec(interaction, kPSQ2fE);
+     xsec = this->EvalXSec(interaction, kPSQ2fE);
 
      //-- Decide whether to accept the current kinematics
      if(!fGenerateUniformly) {
@@ -313,6 +314,7 @@ void QELKinematicsGenerator::SpectralFuncExperimentalCode(
   bool accept = false;
   while(1) {
      iter++;
+     this->CountRejectionIteration();
      if(iter > kRjMaxIterations) {
         LOG("QELKinematics", pWARN)
           << "Couldn't select a valid Q^2 after " << iter << " iterations";
@@ -366,7 +368,7 @@ void QELKinematicsGenerator::SpectralFuncExperimentalCode(
      interaction->KinePtr()->SetQ2(gQ2tilde);
 
      //-- Computing cross section for the current kinematics
-     xsec = fXSecModel->XSec(interaction, kPSQ2fE);
+     xsec = this->EvalXSec(interaction, kPSQ2fE);
 
      //-- Decide whether to accept the current kinematics
 //     if(!fGenerateUniformly) {
@@ -492,7 +494,7 @@ double QELKinematicsGenerator::ComputeMaxXSec(
   for(int i=0; i<N; i++) {
      double Q2 = TMath::Exp(logQ2min + i * dlogQ2);
      interaction->KinePtr()->SetQ2(Q2);
-     double xsec = fXSecModel->XSec(interaction, kPSQ2fE);
+     double xsec = this->EvalXSec(interaction, kPSQ2fE);
 #ifdef __GENIE_LOW_LEVEL_MESG_ENABLED__
      LOG("QELKinematics", pDEBUG)  << "xsec(Q2= " << Q2 << ") = " << xsec;
 #endif
@@ -509,7 +511,7 @@ double QELKinematicsGenerator::ComputeMaxXSec(
 	 Q2 = TMath::Exp(TMath::Log(Q2) - dlogQ2);
          if(Q2 < rQ2.min) continue;
          interaction->KinePtr()->SetQ2(Q2);
-         xsec = fXSecModel->XSec(interaction, kPSQ2fE);
+         xsec = this->EvalXSec(interaction, kPSQ2fE);
 #ifdef __GENIE_LOW_LEVEL_MESG_ENABLED__
          LOG("QELKinematics", pDEBUG)  << "xsec(Q2= " << Q2 << ") = " << xsec;
 #endif
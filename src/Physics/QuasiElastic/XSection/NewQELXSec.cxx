@@ -70,7 +70,7 @@ double NewQELXSec::Integrate(const XSecAlgorithmI* model, const Interaction* in)
   Target* tgt = interaction->InitState().TgtPtr();
   if ( tgt->IsNucleus() ) {
     std::string bind_mode_str = model->GetConfig()
-      .GetString( "IntegralNucleonBindingMode" );
+      .GetString( fBindingModeKey );
     bind_mode = genie::utils::StringToQELBindingMode( bind_mode_str );
   }
 
@@ -116,7 +116,7 @@ double NewQELXSec::Integrate(const XSecAlgorithmI* model, const Interaction* in)
   // energy for the probe. Beyond the cutoff, the effects of Fermi motion
   // and the removal energy are assumed to be small enough to be neglected
   double E_lab_cutoff = model->GetConfig()
-    .GetDouble("IntegralNuclearInfluenceCutoffEnergy");
+    .GetDouble( fCutoffEnergyKey );
 
   double probeE = interaction->InitState().ProbeE( kRfLab );
   if ( !tgt->IsNucleus() || probeE > E_lab_cutoff ) {
@@ -204,6 +204,10 @@ void NewQELXSec::LoadConfig(void)
   // If true, then the integration of the total cross section will include an
   // MC integration over the initial state nuclear model
   GetParamDef( "AverageOverNucleons", fAverageOverNucleons, true );
+
+  // Keys of the cross section model configuration read at each integration
+  fBindingModeKey  = RgKeyHandle( "IntegralNucleonBindingMode" );
+  fCutoffEnergyKey = RgKeyHandle( "IntegralNuclearInfluenceCutoffEnergy" );
 }
 
 genie::utils::gsl::FullQELdXSec::FullQELdXSec(const XSecAlgorithmI* xsec_model,
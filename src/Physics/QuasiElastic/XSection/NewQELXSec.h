@@ -81,6 +81,8 @@ private:
 
   // Configuration obtained from cross section model
   //QELEvGen_BindingMode_t fBindingMode;
+  RgKeyHandle fBindingModeKey;   ///< "IntegralNucleonBindingMode"
+  RgKeyHandle fCutoffEnergyKey;  ///< "IntegralNuclearInfluenceCutoffEnergy"
 
   // XML configuration parameters
   std::string fGSLIntgType;
@@ -53,13 +53,13 @@ using namespace genie::utils;
 NievesQELCCPXSec::NievesQELCCPXSec() :
 XSecAlgorithmI("genie::NievesQELCCPXSec")
 {
-
+  fVcrA = -1;
 }
 //____________________________________________________________________________
 NievesQELCCPXSec::NievesQELCCPXSec(string config) :
 XSecAlgorithmI("genie::NievesQELCCPXSec", config)
 {
-
+  fVcrA = -1;
 }
 //____________________________________________________________________________
 NievesQELCCPXSec::~NievesQELCCPXSec()
@@ -514,6 +514,9 @@ void NievesQELCCPXSec::LoadConfig(void)
 
   // Scaling factor for the Coulomb potential
   GetParamDef( "CoulombScale", fCoulombScale, 1.0 );
+
+  // Forget the Coulomb potential computed with the previous configuration
+  fVcrA = -1;
 }
 //___________________________________________________________________________
 void NievesQELCCPXSec::CNCTCLimUcalc(TLorentzVector qTildeP4,
@@ -833,6 +836,8 @@ double NievesQELCCPXSec::vcr(const Target * target, double Rcurr) const{
   if(target->IsNucleus()){
     int A = target->A();
     int Z = target->Z();
+    if(A == fVcrA && Z == fVcrZ && Rcurr == fVcrR) return fVcrValue;
+    double Rin = Rcurr;
     double Rmax = 0.;
 
     if ( fCoulombRmaxMode == kMatchNieves ) {
@@ -881,7 +886,11 @@ double NievesQELCCPXSec::vcr(const Target * target, double Rcurr) const{
     // Multiply by Z to normalize densities to number of protons
     // Multiply by hbarc to put result in GeV instead of fm
     // Multiply by an extra configurable scaling factor that defaults to unity
-    return -kAem*4*kPi*result*fhbarc*fCoulombScale;
+    fVcrA = A;
+    fVcrZ = Z;
+    fVcrR = Rin;
+    fVcrValue = -kAem*4*kPi*result*fhbarc*fCoulombScale;
+    return fVcrValue;
   }else{
     // If target is not a nucleus the potential will be 0
     return 0.0;
@@ -140,6 +140,14 @@ private:
   // Potential for coulomb correction
   double vcr(const Target * target, double r) const;
 
+  // Last computed Coulomb potential. The kinematic generators evaluate the
+  // cross section many times for the same hit nucleon position, so the
+  // integration in vcr() is only repeated when the nucleus or radius change.
+  mutable int    fVcrA;             ///< A of the last vcr() call (-1: none)
+  mutable int    fVcrZ;             ///< Z of the last vcr() call
+  mutable double fVcrR;             ///< radius of the last vcr() call
+  mutable double fVcrValue;         ///< potential from the last vcr() call
+
   //input must be length 4. Returns 1 if input is an even permutation of 0123,
   //-1 if input is an odd permutation of 0123, and 0 if any two elements
   //are equal
@@ -8,6 +8,8 @@
 */
 //____________________________________________________________________________
 
+#include <vector>
+
 #include <TMath.h>
 #include <TF2.h>
 #include <TROOT.h>
@@ -30,6 +32,8 @@
 #include "Framework/Utils/KineUtils.h"
 #include "Physics/Resonance/EventGen/RESKinematicsGenerator.h"
 
+using std::vector;
+
 using namespace genie;
 using namespace genie::controls;
 using namespace genie::utils;
@@ -97,16 +101,58 @@ void RESKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
   //   value is found.
   //   If the kinematics are generated uniformly over the allowed phase
   //   space the max xsec is irrelevant
-  double xsec_max = (fGenerateUniformly) ? -1 : this->MaxXSec(evrec);
+  //   Optionally, (W,QD2) are sampled from an adaptive envelope trained on
+  //   the differential cross section for this interaction & energy bin, in
+  //   which case the max xsec is not needed either
+  double dW   = W.max - W.min;
+
+  // QD2 range used in unweighted mode (evaluated at W.min)
+  interaction->KinePtr()->SetW(W.min);
+  Range1D_t Q2lim = kps.Q2Lim_W();
+  double Q2min  = (is_em) ? Q2lim.min + kASmallNum : 0 + kASmallNum;
+  double Q2max  = Q2lim.max - kASmallNum;
+  double QD2min = utils::kinematics::Q2toQD2(Q2max);
+  double QD2max = utils::kinematics::Q2toQD2(Q2min);
+
+  // envelope points outside the (W,QD2) limits of this event are rejected
+  Range1D_t QD2(QD2min, QD2max);
+  auto inlimits = [&](double w, double qd2) {
+    return (w >= W.min && w <= W.max && qd2 >= QD2.min && qd2 <= QD2.max);
+  };
+
+  CacheBranchEnvelope * envelope = 0;
+  if(this->UseAdaptiveEnvelope(interaction)) {
+    EnvelopeFunc_t f = [&](double w, double qd2) {
+      if(!inlimits(w,qd2)) return 0.;
+      interaction->KinePtr()->SetW (w);
+      interaction->KinePtr()->SetQ2(utils::kinematics::QD2toQ2(qd2));
+      return this->EvalXSec(interaction, kPSWQD2fE);
+    };
+    envelope = this->AccessAdaptiveEnvelope(interaction, W, QD2, f);
+    if(envelope->Integral() <= 0) envelope = 0;
+  }
+
+  double xsec_max = (fGenerateUniformly || envelope) ? -1 : this->MaxXSec(evrec);
 
   //-- Try to select a valid W, Q2 pair using the rejection method
-  double dW   = W.max - W.min;
   double xsec = -1;
+  int    cell = -1;
+
+  //-- In unweighted mode, trials can be drawn and their cross sections
+  //   computed in blocks (see XSecAlgorithmI::XSecBatch) sized after the
+  //   mean number of trials per event
+  const KineVar_t batch_vars[2] = { kKVW, kKVQ2 };
+  int nbatch = this->XSecBatchSize();
+  int ibatch = nbatch;
+  vector<double> batch_pts  (2*nbatch);
+  vector<double> batch_xsec (nbatch);
+  vector<int>    batch_cell (nbatch);
 
   unsigned int iter = 0;
   bool accept = false;
   while(1) {
      iter++;
+     this->CountRejectionIteration();
      if(iter > kRjMaxIterations) {
          LOG("RESKinematics", pWARN)
               << "*** Could not select a valid (W,Q^2) pair after "
@@ -120,7 +166,6 @@ void RESKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
 
      double gW   = 0; // current hadronic invariant mass
      double gQ2  = 0; // current momentum transfer
-     double gQD2 = 0; // tranformed Q2 to take out dipole form
 
      if(fGenerateUniformly) 
      {
@@ -139,24 +184,37 @@ void RESKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
         // neutrino scattering
         // Selecting unweighted event kinematics using an importance sampling
         // method. Q2 with be transformed to QD2 to take out the dipole form.
-        interaction->KinePtr()->SetW(W.min);
-        Range1D_t Q2 = kps.Q2Lim_W();
-        double Q2min  = -99.;
-        if (is_em) 
-            Q2min  = Q2.min + kASmallNum; 
-        else 
-            Q2min  = 0 + kASmallNum;
-        double Q2max  = Q2.max - kASmallNum;
-        
         // In unweighted mode - use transform that takes out the dipole form
-        double QD2min = utils::kinematics::Q2toQD2(Q2max);
-        double QD2max = utils::kinematics::Q2toQD2(Q2min);
-        
-        gW  = W.min + dW  * rnd->RndKine().Rndm();
-        gQD2 = QD2min + (QD2max - QD2min) * rnd->RndKine().Rndm();
-         
-        // QD2 -> Q2
-        gQ2 = utils::kinematics::QD2toQ2(gQD2);
+        auto draw = [&](double & w, double & q2, int & c) {
+          double qd2 = 0;
+          if(envelope) {
+            double e = 0;
+            c   = envelope->Sample(rnd->RndKine(), w, qd2, e);
+          } else {
+            w   = W.min + dW  * rnd->RndKine().Rndm();
+            qd2 = QD2min + (QD2max - QD2min) * rnd->RndKine().Rndm();
+          }
+          // QD2 -> Q2
+          q2 = utils::kinematics::QD2toQ2(qd2);
+        };
+
+        if(nbatch > 1) {
+          if(ibatch == nbatch) {
+            for(int i = 0; i < nbatch; i++) {
+              draw(batch_pts[2*i], batch_pts[2*i+1], batch_cell[i]);
+            }
+            this->EvalXSecBatch(interaction, kPSWQD2fE, batch_vars, 2,
+                                nbatch, &batch_pts[0], &batch_xsec[0]);
+            ibatch = 0;
+          }
+          gW   = batch_pts [2*ibatch];
+          gQ2  = batch_pts [2*ibatch+1];
+          cell = batch_cell[ibatch];
+          xsec = batch_xsec[ibatch];
+          ibatch++;
+        } else {
+          draw(gW, gQ2, cell);
+        }
      } // uniformly over phase space?
 
      LOG("RESKinematics", pINFO) << "Trying: W = " << gW << ", Q2 = " << gQ2;
@@ -166,10 +224,21 @@ void RESKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
      interaction->KinePtr()->SetQ2(gQ2);
 
      //-- Computing cross section for the current kinematics
-     xsec = fXSecModel->XSec(interaction, kPSWQD2fE);
+     //   (already computed if trials are evaluated in blocks)
+     bool inlim = !envelope || inlimits(gW, utils::kinematics::Q2toQD2(gQ2));
+     if(!inlim) {
+       xsec = 0;
+     }
+     else if(nbatch == 1) {
+       xsec = this->EvalXSec(interaction, kPSWQD2fE);
+     }
 
      //-- Decide whether to accept the current kinematics
-     if(!fGenerateUniformly) 
+     if(envelope)
+     {
+       accept = this->AdaptiveEnvelopeAccept(envelope, cell, xsec);
+     }
+     else if(!fGenerateUniformly) 
      {
        // unified neutrino / electron scattering
        double t   = xsec_max * rnd->RndKine().Rndm();
@@ -185,6 +254,9 @@ void RESKinematicsGenerator::ProcessEventRecord(GHepRecord * evrec) const
      if(accept) {
         LOG("RESKinematics", pINFO)
                             << "Selected: W = " << gW << ", Q2 = " << gQ2;
+        // trials needed for this event, sizing the next blocks
+        if(!fGenerateUniformly) this->CountXSecBatchEvent(iter);
+
         // reset 'trust' bits
         interaction->ResetBit(kISkipProcessChk);
         interaction->ResetBit(kISkipKinematicChk);
@@ -257,6 +329,12 @@ void RESKinematicsGenerator::LoadConfig(void)
   // an event weight?
   this->GetParamDef("UniformOverPhaseSpace", fGenerateUniformly, false);
 
+  // Number of trials drawn & evaluated per block in the rejection method
+  this->GetParamDef("XSec-BatchSize", fXSecBatchSize, 1);
+
+  // Sample kinematics from an adaptive envelope?
+  this->LoadAdaptiveEnvelopeConfig();
+
   // Envelope employed when importance sampling is used
   // (initialize with dummy range)
   if(fEnvelope) delete fEnvelope;
@@ -330,7 +408,7 @@ double RESKinematicsGenerator::ComputeMaxXSec(
       {
         double Q2 = TMath::Exp(logQ2min + iq2 * dlogQ2);
         interaction->KinePtr()->SetQ2(Q2);
-        double xsec = fXSecModel->XSec(interaction, kPSWQD2fE);
+        double xsec = this->EvalXSec(interaction, kPSWQD2fE);
         LOG("RESKinematics", pDEBUG)
                 << "xsec(W= " << W << ", Q2= " << Q2 << ") = " << xsec;
         max_xsec = TMath::Max(xsec, max_xsec);
@@ -348,7 +426,7 @@ double RESKinematicsGenerator::ComputeMaxXSec(
               Q2 = TMath::Exp(TMath::Log(Q2) - dlogQ2);
               if(Q2 < rQ2.min) continue;
               interaction->KinePtr()->SetQ2(Q2);
-              xsec = fXSecModel->XSec(interaction, kPSWQD2fE);
+              xsec = this->EvalXSec(interaction, kPSWQD2fE);
               LOG("RESKinematics", pDEBUG)
                       << "xsec(W= " << W << ", Q2= " << Q2 << ") = " << xsec;
               max_xsec = TMath::Max(xsec, max_xsec);
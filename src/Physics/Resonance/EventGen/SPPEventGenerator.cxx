@@ -136,6 +136,7 @@ void SPPEventGenerator::ProcessEventRecord(GHepRecord * evrec) const
   while(1) 
   {
      iter++;
+     this->CountRejectionIteration();
      if(iter > 100*kRjMaxIterations) {
          LOG("SPPEventGen", pWARN)
               << "*** Could not select a valid kinematics variable after "
@@ -738,6 +738,60 @@ double BSKLNBaseRESPXSec2014::XSec(
   return xsec;
 }
 //____________________________________________________________________________
+void BSKLNBaseRESPXSec2014::XSecBatch(
+    Interaction * interaction, KinePhaseSpace_t kps,
+    const KineVar_t * vars, int nvar, int n, const double * pts,
+    double * xsec) const
+{
+// The process and resonance are checked once for the whole batch, and points
+// outside the W range where the model applies (resonance window or DIS/RES
+// joining scheme) are set to zero without any further calculation
+
+  for(int i = 0; i < n; i++) xsec[i] = 0.;
+
+  if(! this -> ValidProcess (interaction) ) return;
+
+  const InitialState & init_state = interaction -> InitState();
+  Resonance_t resonance = interaction->ExclTag().Resonance();
+
+  if(interaction->ProcInfo().IsWeakCC() && !utils::res::IsDelta(resonance)) {
+    int nucpdgc   = init_state.Tgt().HitNucPdg();
+    int probepdgc = init_state.ProbePdg();
+    if((pdg::IsNeutrino    (probepdgc) && pdg::IsProton  (nucpdgc)) ||
+       (pdg::IsAntiNeutrino(probepdgc) && pdg::IsNeutron (nucpdgc))) {
+      for(int i = 0; i < n; i++) {
+        this->SetBatchPoint(interaction, vars, nvar, pts + i*nvar);
+      }
+      return;
+    }
+  }
+
+  // W window around the resonance peak (see XSec())
+  int    IR = utils::res::ResonanceIndex (resonance);
+  double MR = utils::res::Mass           (resonance);
+  double WR = utils::res::Width          (resonance);
+  double NW = fGnResMaxNWidths;
+  if(IR==0) NW = TMath::Min(NW, fN0ResMaxNWidths);
+  if(IR==2) NW = TMath::Min(NW, fN2ResMaxNWidths);
+  double Wwindow = MR + NW * WR;
+
+  int iW = -1;
+  for(int j = 0; j < nvar; j++) {
+    if(vars[j] == kKVW) iW = j;
+  }
+
+  for(int i = 0; i < n; i++) {
+    const double * pt = pts + i*nvar;
+    this->SetBatchPoint(interaction, vars, nvar, pt);
+    if(iW >= 0) {
+      double W = pt[iW];
+      if(fUsingDisResJoin && W >= fWcut)   continue;
+      if(fNormBW          && W >  Wwindow) continue;
+    }
+    xsec[i] = this->XSec(interaction, kps);
+  }
+}
+//____________________________________________________________________________
 double BSKLNBaseRESPXSec2014::Integral(const Interaction * interaction) const
 {
   double xsec = fXSecIntegrator->Integrate(this,interaction);
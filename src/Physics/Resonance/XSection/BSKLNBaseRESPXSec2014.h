@@ -62,6 +62,9 @@ namespace genie {
       double XSec         (const Interaction * i, KinePhaseSpace_t k) const;
       double Integral     (const Interaction * i) const;
       bool   ValidProcess (const Interaction * i) const;
+      void   XSecBatch    (Interaction * i, KinePhaseSpace_t k,
+                           const KineVar_t * vars, int nvar,
+                           int n, const double * pts, double * xsec) const;
 
       // overload the Algorithm::Configure() methods to load private data
       // members from configuration options
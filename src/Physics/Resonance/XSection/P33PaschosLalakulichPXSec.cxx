@@ -117,9 +117,9 @@ double P33PaschosLalakulichPXSec::XSec(
   double Gamma_R=Gamma_R0*pow((this->PPiStar(W,MN)/this->PPiStar(MR,MN)),3);
 
   // check for other option
-  if ( GetConfig().Exists("running-gamma") ) {
+  if ( fRunningGamma.size() > 0 ) {
 
-     string gamma_model = GetConfig().GetString("running-gamma");
+     const string & gamma_model = fRunningGamma;
 
      if ( gamma_model.find("Hagiwara") != string::npos )
      {
@@ -299,6 +299,11 @@ void P33PaschosLalakulichPXSec::LoadConfig(void)
 
   GetParamDef( "TurnOnPauliSuppr", fTurnOnPauliCorrection, false ) ;
 
+  fRunningGamma = "";
+  if ( GetConfig().Exists("running-gamma") ) {
+    fRunningGamma = GetConfig().GetString("running-gamma");
+  }
+
   //-- load the differential cross section integrator
   fXSecIntegrator =
       dynamic_cast<const XSecIntegratorI *> (this->SubAlg("XSec-Integrator"));
@@ -65,6 +65,7 @@ private:
   double fCos28c;
   
   bool   fTurnOnPauliCorrection;
+  string fRunningGamma;   ///< running Gamma model ("" for the default)
 };
 
 }       // genie namespace
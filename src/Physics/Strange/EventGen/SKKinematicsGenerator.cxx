@@ -137,6 +137,7 @@ void SKKinematicsGenerator::CalculateKin_AtharSingleKaon(GHepRecord * evrec) con
 
   while(1) {
      iter++;
+     this->CountRejectionIteration();
      if(iter > kRjMaxIterations) {
         LOG("SKKinematics", pWARN)
              << "*** Could not select a valid (tk, tl, costhetal) triplet after "
@@ -185,7 +186,7 @@ void SKKinematicsGenerator::CalculateKin_AtharSingleKaon(GHepRecord * evrec) con
 
 
      // computing cross section for the current kinematics
-     xsec = fXSecModel->XSec(interaction, kPSTkTlctl);
+     xsec = this->EvalXSec(interaction, kPSTkTlctl);
 
      //-- decide whether to accept the current kinematics
      if(!fGenerateUniformly) {
@@ -304,7 +305,7 @@ double SKKinematicsGenerator::ComputeMaxXSec(const Interaction * in) const
         in->KinePtr()->SetKV(kKVctl, ctl);
         in->KinePtr()->SetKV(kKVphikq, phikq);
 
-        double xsec = fXSecModel->XSec(in, kPSTkTlctl);
+        double xsec = this->EvalXSec(in, kPSTkTlctl);
 
         // xsec returned by model is d4sigma/(dtk dtl dcosthetal dphikq)
         // convert lepton theta to log(1-costheta) by multiplying by jacobian 1 - costheta
@@ -17,6 +17,7 @@
 #include "Framework/Interaction/Interaction.h"
 #include "Tools/EvtLib/EventLibraryInterface.h"
 #include "Tools/EvtLib/EvtLibRecordList.h"
+#include "Tools/EvtLib/MappedLibrary.h"
 #include "Tools/EvtLib/Utils.h"
 #include "Framework/Conventions/Constants.h"
 
@@ -28,7 +29,7 @@ using namespace genie::evtlib;
 //____________________________________________________________________________
 EventLibraryInterface::EventLibraryInterface() :
   EventRecordVisitorI("genie::evtlib::EventLibraryInterface"),
-  fRecordFile(0)
+  fRecordFile(0), fMappedLib(0)
 {
 
 }
@@ -36,7 +37,7 @@ EventLibraryInterface::EventLibraryInterface() :
 //____________________________________________________________________________
 EventLibraryInterface::EventLibraryInterface(string config) :
   EventRecordVisitorI("genie::evtlib::EventLibraryInterface", config),
-  fRecordFile(0)
+  fRecordFile(0), fMappedLib(0)
 {
 
 }
@@ -222,6 +223,8 @@ void EventLibraryInterface::Cleanup()
   fRecords.clear();
   delete fRecordFile;
   fRecordFile = 0;
+  delete fMappedLib;
+  fMappedLib = 0;
 }
 
 //___________________________________________________________________________
@@ -236,57 +239,26 @@ void EventLibraryInterface::LoadRecords()
   bool onDemand;
   GetParam("OnDemand", onDemand);
 
-  PDGLibrary* pdglib = PDGLibrary::Instance();
+  // Libraries converted to the mapped format (see gevtlib2bin) are used
+  // in-place, and need no loading
+  if(MappedLibrary::IsMappedLibrary(libPath)){
+    fMappedLib = new MappedLibrary;
+    if(!fMappedLib->Load(libPath)) exit(1);
+    fRecords = fMappedLib->MakeRecordLists();
+    return;
+  }
 
   fRecordFile = new TFile(libPath.c_str());
   if(fRecordFile->IsZombie()) exit(1);
 
-  TIter next(fRecordFile->GetListOfKeys());
-  while(TObject* dir = next()){
-    const std::string& tgtName = dir->GetName();
-    const TParticlePDG* tgtPart = pdglib->DBase()->GetParticle(tgtName.c_str());
-    if(!tgtPart){
-      LOG("ELI", pWARN) << "Unknown nucleus " << tgtName
-                        << " found in " << libPath
-                        << " -- skipping";
-      continue;
-    }
-
-    for(int pdg: {kPdgNuE,   kPdgAntiNuE,
-                  kPdgNuMu,  kPdgAntiNuMu,
-                  kPdgNuTau, kPdgAntiNuTau}){
-
-      for(bool iscc: {true, false}){
-        // NCs should be the same for all flavours. Use nu_mu as a convention
-        // internal to this code to index into the records map.
-        if(!iscc && abs(pdg) != kPdgNuMu) continue;
-
-        std::string nuName = pdglib->Find(pdg)->GetName();
-        if(!iscc) nuName = pdg::IsAntiNeutrino(pdg) ? "nu_bar" : "nu";
-
-        const std::string treeName =
-          TString::Format("%s/%s/%s/records",
-                          tgtName.c_str(),
-                          iscc ? "cc" : "nc",
-                          nuName.c_str()).Data();
-
-        const Key key(tgtPart->PdgCode(), pdg, iscc);
-
-        TTree* tr = (TTree*)fRecordFile->Get(treeName.c_str());
-
-        if(!tr){
-          LOG("ELI", pINFO) << treeName << " not found in "
-                            << libPath << " -- skipping";
-          continue;
-        }
-
-        if(onDemand)
-          fRecords[key] = new OnDemandRecordList(tr, treeName);
-        else
-          fRecords[key] = new SimpleRecordList(tr, treeName);
-      } // end for iscc
-    } // end for pdg
-  } // end for dir
+  ForEachRecordTree(fRecordFile, libPath,
+    [&](const Key& key, TTree* tr, const std::string& treeName)
+    {
+      if(onDemand)
+        fRecords[key] = new OnDemandRecordList(tr, treeName);
+      else
+        fRecords[key] = new SimpleRecordList(tr, treeName);
+    });
 
   // Need to keep the record file open for OnDemand, but not Simple
   if(!onDemand){delete fRecordFile; fRecordFile = 0;}
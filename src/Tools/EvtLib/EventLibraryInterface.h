@@ -39,6 +39,7 @@ namespace evtlib {
 
 class IEvtLibRecordList;
 class EvtLibRecord;
+class MappedLibrary;
 
 class EventLibraryInterface: public EventRecordVisitorI {
 
@@ -70,6 +71,7 @@ private:
 
   std::map<Key, const IEvtLibRecordList*> fRecords;
   TFile* fRecordFile;
+  MappedLibrary* fMappedLib;
 };
 
 } // evtlib namespace
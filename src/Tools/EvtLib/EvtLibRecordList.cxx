@@ -3,6 +3,7 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include "Tools/EvtLib/EvtLibRecordList.h"
+#include "Tools/EvtLib/MappedLibrary.h"
 
 #include "Framework/Messenger/Messenger.h"
 
@@ -161,4 +162,43 @@ namespace evtlib{
 
     return &fRecord;
   }
+
+  //---------------------------------------------------------------------------
+  MappedRecordList::MappedRecordList(const MappedLibrary* lib,
+                                     uint64_t first, uint64_t n)
+    : fLib(lib), fFirst(first), fN(n)
+  {
+  }
+
+  //---------------------------------------------------------------------------
+  const EvtLibRecord* MappedRecordList::GetRecord(float E) const
+  {
+    const float* begin = fLib->Energies() + fFirst;
+    const float* end   = begin + fN;
+
+    const float* it = std::lower_bound(begin, end, E);
+    if(it == end) return 0;
+
+    const uint64_t i = it - fLib->Energies();
+
+    fRecord.E = *it;
+    fRecord.prod_id = fLib->ProdIds()[i];
+
+    // Copy the particles out of the pool. The vector keeps its capacity
+    // between calls, so this doesn't allocate once warmed up. The record
+    // range and particle offsets were validated when the library was mapped.
+    const uint64_t p0 = fLib->FirstPart()[i];
+    const uint64_t p1 = fLib->FirstPart()[i+1];
+    fRecord.parts.resize(p1 - p0);
+    for(uint64_t j = p0; j < p1; ++j){
+      EvtLibParticle& part = fRecord.parts[j-p0];
+      part.pdg = fLib->Pdgs()[j];
+      part.E = fLib->Es()[j];
+      part.px = fLib->Pxs()[j];
+      part.py = fLib->Pys()[j];
+      part.pz = fLib->Pzs()[j];
+    } // end for j
+
+    return &fRecord;
+  }
 }} // namespaces
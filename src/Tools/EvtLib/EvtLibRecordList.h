@@ -8,6 +8,8 @@
 #include <vector>
 #include <string>
 
+#include <stdint.h>
+
 class TFile;
 class TTree;
 
@@ -100,6 +102,25 @@ namespace evtlib{
     mutable EvtLibRecord fRecord;
   };
 
+  class MappedLibrary;
+
+  //---------------------------------------------------------------------------
+  /// Records [first, first+n) of a \ref MappedLibrary, sorted by energy
+  class MappedRecordList: public IEvtLibRecordList
+  {
+  public:
+    MappedRecordList(const MappedLibrary* lib, uint64_t first, uint64_t n);
+    virtual ~MappedRecordList(){}
+
+    const EvtLibRecord* GetRecord(float E) const override;
+  protected:
+    const MappedLibrary* fLib;
+    uint64_t fFirst;
+    uint64_t fN;
+
+    mutable EvtLibRecord fRecord;
+  };
+
 }} // namespaces
 
 #endif
@@ -0,0 +1,354 @@
+////////////////////////////////////////////////////////////////////////
+// \author GENIE Collaboration
+////////////////////////////////////////////////////////////////////////
+
+#include "Tools/EvtLib/MappedLibrary.h"
+#include "Tools/EvtLib/EvtLibRecordList.h"
+#include "Tools/EvtLib/Utils.h"
+
+#include "Framework/Messenger/Messenger.h"
+
+#include "TFile.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+//____________________________________________________________________________
+// Mapped event library file layout (host byte order; files written on a host
+// of different endianness fail the magic word check):
+//
+//   ElbHeader                                    (fixed size)
+//   ElbList  lists[nlists]                       (records [first, first+n))
+//   uint64_t first_part[nrecords+1]              (offset into the particle pool)
+//   float    E[nrecords]                         (sorted within each list)
+//   int32_t  prod_id[nrecords]
+//   int32_t  pdg[nparts]
+//   float    E[nparts], px[nparts], py[nparts], pz[nparts]
+//
+// All columns are 8-byte aligned so they can be used in-place.
+//
+namespace {
+
+  const char     kElbMagic[8] = { 'G','E','V','T','L','I','B','M' };
+  const uint32_t kElbVersion  = 1;
+
+  struct ElbHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t nlists;
+    uint64_t nrecords;
+    uint64_t nparts;
+    uint64_t lists_offset;
+    uint64_t first_part_offset;
+    uint64_t energy_offset;
+    uint64_t prod_id_offset;
+    uint64_t pdg_offset;
+    uint64_t part_E_offset;
+    uint64_t part_px_offset;
+    uint64_t part_py_offset;
+    uint64_t part_pz_offset;
+  };
+
+  struct ElbList {
+    int32_t  nucl_pdg;
+    int32_t  nu_pdg;
+    uint32_t iscc;
+    uint32_t reserved;
+    uint64_t first_record;
+    uint64_t nrecords;
+  };
+
+  uint64_t Align(uint64_t offset) { return (offset + 7) & ~((uint64_t)7); }
+
+  // Does a column of n elements of the given size at offset fit in a file of
+  // the given size? (written so that corrupt values can't overflow)
+  bool InFile(uint64_t offset, uint64_t n, uint64_t elem_size, uint64_t size)
+  {
+    return offset <= size && offset % 8 == 0 && n <= (size - offset) / elem_size;
+  }
+
+  // Checks the header, the column bounds, the record ranges of the lists and
+  // the particle offsets of the records, so that nothing read from the mapped
+  // file later can go out of bounds
+  bool ValidElbFile(const ElbHeader* h, size_t size, std::string& reason)
+  {
+    if(memcmp(h->magic, kElbMagic, sizeof(kElbMagic)) != 0 ||
+       h->version != kElbVersion){
+      reason = "unknown format or version";
+      return false;
+    }
+    if(h->nrecords >= size / sizeof(uint64_t) ||
+       !InFile(h->lists_offset,      h->nlists,     sizeof(ElbList),  size) ||
+       !InFile(h->first_part_offset, h->nrecords+1, sizeof(uint64_t), size) ||
+       !InFile(h->energy_offset,     h->nrecords,   sizeof(float),    size) ||
+       !InFile(h->prod_id_offset,    h->nrecords,   sizeof(int32_t),  size) ||
+       !InFile(h->pdg_offset,        h->nparts,     sizeof(int32_t),  size) ||
+       !InFile(h->part_E_offset,     h->nparts,     sizeof(float),    size) ||
+       !InFile(h->part_px_offset,    h->nparts,     sizeof(float),    size) ||
+       !InFile(h->part_py_offset,    h->nparts,     sizeof(float),    size) ||
+       !InFile(h->part_pz_offset,    h->nparts,     sizeof(float),    size)){
+      reason = "column out of bounds";
+      return false;
+    }
+
+    const char* base = (const char*)h;
+    const ElbList* lists = (const ElbList*)(base + h->lists_offset);
+    for(uint64_t i = 0; i < h->nlists; ++i){
+      if(lists[i].first_record > h->nrecords ||
+         lists[i].nrecords > h->nrecords - lists[i].first_record){
+        reason = "record list out of bounds";
+        return false;
+      }
+    }
+
+    const uint64_t* first_part = (const uint64_t*)(base + h->first_part_offset);
+    for(uint64_t i = 0; i < h->nrecords; ++i){
+      if(first_part[i] > first_part[i+1]){
+        reason = "decreasing particle offsets";
+        return false;
+      }
+    }
+    if(first_part[h->nrecords] > h->nparts){
+      reason = "particle offsets out of bounds";
+      return false;
+    }
+    return true;
+  }
+
+  template<class T> bool WriteColumn(std::ofstream& out, uint64_t offset,
+                                     const std::vector<T>& col)
+  {
+    out.seekp(offset);
+    if(!col.empty()) out.write((const char*)&col[0], col.size()*sizeof(T));
+    return out.good();
+  }
+
+} // anonymous namespace
+
+namespace genie{
+namespace evtlib{
+
+  //---------------------------------------------------------------------------
+  MappedLibrary::MappedLibrary()
+    : fAddr(0), fSize(0),
+      fEnergies(0), fProdIds(0), fFirstPart(0),
+      fPdgs(0), fEs(0), fPxs(0), fPys(0), fPzs(0)
+  {
+  }
+
+  //---------------------------------------------------------------------------
+  MappedLibrary::~MappedLibrary()
+  {
+    Close();
+  }
+
+  //---------------------------------------------------------------------------
+  void MappedLibrary::Close()
+  {
+    if(fAddr) munmap(fAddr, fSize);
+    fAddr = 0;
+    fSize = 0;
+  }
+
+  //---------------------------------------------------------------------------
+  bool MappedLibrary::IsMappedLibrary(const std::string& path)
+  {
+    std::ifstream in(path.c_str(), std::ios::in | std::ios::binary);
+    char magic[8];
+    if(!in.read(magic, sizeof(magic))) return false;
+    return memcmp(magic, kElbMagic, sizeof(kElbMagic)) == 0;
+  }
+
+  //---------------------------------------------------------------------------
+  bool MappedLibrary::Load(const std::string& path)
+  {
+    Close();
+
+    LOG("ELI", pNOTICE) << "Mapping event library: " << path;
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0){
+      LOG("ELI", pERROR) << "Event library could not be opened: " << path;
+      return false;
+    }
+    struct stat st;
+    if(fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ElbHeader)){
+      LOG("ELI", pERROR) << "Event library is empty or unreadable: " << path;
+      close(fd);
+      return false;
+    }
+    const size_t size = st.st_size;
+    void* addr = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if(addr == MAP_FAILED){
+      LOG("ELI", pERROR) << "Event library could not be mapped: " << path;
+      return false;
+    }
+
+    const ElbHeader* h = (const ElbHeader*)addr;
+    std::string reason;
+    if(!ValidElbFile(h, size, reason)){
+      LOG("ELI", pERROR) << "Invalid or unsupported event library: " << path
+                         << " - " << reason;
+      munmap(addr, size);
+      return false;
+    }
+
+    fPath = path;
+    fAddr = addr;
+    fSize = size;
+
+    const char* base = (const char*)addr;
+    fFirstPart = (const uint64_t*)(base + h->first_part_offset);
+    fEnergies  = (const float*)   (base + h->energy_offset);
+    fProdIds   = (const int32_t*) (base + h->prod_id_offset);
+    fPdgs      = (const int32_t*) (base + h->pdg_offset);
+    fEs        = (const float*)   (base + h->part_E_offset);
+    fPxs       = (const float*)   (base + h->part_px_offset);
+    fPys       = (const float*)   (base + h->part_py_offset);
+    fPzs       = (const float*)   (base + h->part_pz_offset);
+
+    LOG("ELI", pNOTICE) << "Mapped " << h->nrecords << " records ("
+                        << h->nparts << " particles) in "
+                        << h->nlists << " lists";
+    return true;
+  }
+
+  //---------------------------------------------------------------------------
+  std::map<Key, const IEvtLibRecordList*> MappedLibrary::MakeRecordLists() const
+  {
+    std::map<Key, const IEvtLibRecordList*> ret;
+    if(!fAddr) return ret;
+
+    const ElbHeader* h = (const ElbHeader*)fAddr;
+    const ElbList* lists = (const ElbList*)((const char*)fAddr + h->lists_offset);
+
+    for(uint64_t i = 0; i < h->nlists; ++i){
+      const ElbList& l = lists[i]; // ranges checked in Load()
+      const Key key(l.nucl_pdg, l.nu_pdg, l.iscc != 0);
+      ret[key] = new MappedRecordList(this, l.first_record, l.nrecords);
+    }
+    return ret;
+  }
+
+  //---------------------------------------------------------------------------
+  bool MappedLibrary::Convert(const std::string& libPath,
+                              const std::string& outPath)
+  {
+    TFile f(libPath.c_str());
+    if(f.IsZombie()) return false;
+
+    std::vector<ElbList>  lists;
+    std::vector<uint64_t> first_part;
+    std::vector<float>    energy;
+    std::vector<int32_t>  prod_id;
+    std::vector<int32_t>  pdg;
+    std::vector<float>    pE, px, py, pz;
+
+    ForEachRecordTree(&f, libPath,
+      [&](const Key& key, TTree* tr, const std::string& treeName)
+      {
+        std::cout << "Converting " << treeName << std::flush;
+
+        // Read the records in file order (sequential I/O) and then append
+        // them sorted by energy
+        RecordLoader loader(tr);
+        const long N = loader.NRecords();
+        std::vector<EvtLibRecord> recs;
+        std::vector<std::pair<float, long>> order;
+        recs.reserve(N);
+        order.reserve(N);
+        for(long i = 0; i < N; ++i){
+          recs.push_back(loader.GetRecord(i));
+          order.emplace_back(recs.back().E, i);
+        }
+        std::sort(order.begin(), order.end());
+
+        ElbList l;
+        l.nucl_pdg = key.nucl_pdg;
+        l.nu_pdg = key.nu_pdg;
+        l.iscc = key.iscc;
+        l.reserved = 0;
+        l.first_record = energy.size();
+        l.nrecords = N;
+        lists.push_back(l);
+
+        for(long k = 0; k < N; ++k){
+          const EvtLibRecord& rec = recs[order[k].second];
+          first_part.push_back(pdg.size());
+          energy.push_back(rec.E);
+          prod_id.push_back(rec.prod_id);
+          for(const EvtLibParticle& part: rec.parts){
+            pdg.push_back(part.pdg);
+            pE.push_back(part.E);
+            px.push_back(part.px);
+            py.push_back(part.py);
+            pz.push_back(part.pz);
+          }
+        }
+        std::cout << " " << N << " records" << std::endl;
+      });
+
+    first_part.push_back(pdg.size());
+
+    ElbHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, kElbMagic, sizeof(kElbMagic));
+    h.version           = kElbVersion;
+    h.nlists            = lists.size();
+    h.nrecords          = energy.size();
+    h.nparts            = pdg.size();
+    h.lists_offset      = Align(sizeof(ElbHeader));
+    h.first_part_offset = Align(h.lists_offset      + lists.size()*sizeof(ElbList));
+    h.energy_offset     = Align(h.first_part_offset + first_part.size()*sizeof(uint64_t));
+    h.prod_id_offset    = Align(h.energy_offset     + energy.size()*sizeof(float));
+    h.pdg_offset        = Align(h.prod_id_offset    + prod_id.size()*sizeof(int32_t));
+    h.part_E_offset     = Align(h.pdg_offset        + pdg.size()*sizeof(int32_t));
+    h.part_px_offset    = Align(h.part_E_offset     + pE.size()*sizeof(float));
+    h.part_py_offset    = Align(h.part_px_offset    + px.size()*sizeof(float));
+    h.part_pz_offset    = Align(h.part_py_offset    + py.size()*sizeof(float));
+    const uint64_t size = h.part_pz_offset + pz.size()*sizeof(float);
+
+    std::ofstream out(outPath.c_str(), std::ios::out | std::ios::binary);
+    if(!out) return false;
+
+    // Pre-size the file (the alignment gaps are zero-filled)
+    if(size > 0){
+      out.seekp(size-1);
+      out.put(0);
+    }
+
+    out.seekp(0);
+    out.write((const char*)&h, sizeof(h));
+
+    bool ok = out.good();
+    ok = ok && WriteColumn(out, h.lists_offset,      lists);
+    ok = ok && WriteColumn(out, h.first_part_offset, first_part);
+    ok = ok && WriteColumn(out, h.energy_offset,     energy);
+    ok = ok && WriteColumn(out, h.prod_id_offset,    prod_id);
+    ok = ok && WriteColumn(out, h.pdg_offset,        pdg);
+    ok = ok && WriteColumn(out, h.part_E_offset,     pE);
+    ok = ok && WriteColumn(out, h.part_px_offset,    px);
+    ok = ok && WriteColumn(out, h.part_py_offset,    py);
+    ok = ok && WriteColumn(out, h.part_pz_offset,    pz);
+    out.close();
+
+    if(ok){
+      LOG("ELI", pNOTICE) << "Wrote " << h.nrecords << " records ("
+                          << h.nparts << " particles) in "
+                          << h.nlists << " lists to " << outPath;
+    }
+    return ok;
+  }
+
+}} // namespaces
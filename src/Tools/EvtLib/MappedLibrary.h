@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////
+// \author GENIE Collaboration
+////////////////////////////////////////////////////////////////////////
+
+#ifndef _EVTLIB_MAPPEDLIBRARY_H
+#define _EVTLIB_MAPPEDLIBRARY_H
+
+#include <map>
+#include <string>
+
+#include <stdint.h>
+
+#include "Tools/EvtLib/Key.h"
+
+namespace genie{
+namespace evtlib{
+
+  class IEvtLibRecordList;
+
+  //---------------------------------------------------------------------------
+  /// \brief Event library in a columnar binary layout that can be memory mapped
+  ///
+  /// The records of each list are sorted by energy and stored as contiguous
+  /// columns (energy, production id, offset into the particle pool), and the
+  /// particles of all records as a columnar pool (pdg, E, px, py, pz). The file
+  /// is mapped read-only, so startup costs no reading or allocation and all jobs
+  /// on a node share a single copy through the page cache. Libraries are
+  /// converted from the ROOT format with gevtlib2bin.
+  class MappedLibrary
+  {
+  public:
+    MappedLibrary();
+    ~MappedLibrary();
+
+    /// Does \a path start like a mapped event library?
+    static bool IsMappedLibrary(const std::string& path);
+
+    /// Convert the ROOT event library \a libPath to a mapped library \a outPath
+    static bool Convert(const std::string& libPath, const std::string& outPath);
+
+    bool Load(const std::string& path);
+
+    /// Create the record lists of all the keys found in the library. They
+    /// point into the mapped file, so must be deleted before the library.
+    std::map<Key, const IEvtLibRecordList*> MakeRecordLists() const;
+
+    // Columns of the mapped file, indexed by record / particle number
+    const float*    Energies()  const {return fEnergies;}
+    const int32_t*  ProdIds()   const {return fProdIds;}
+    const uint64_t* FirstPart() const {return fFirstPart;} ///< nrecords+1 entries
+    const int32_t*  Pdgs()      const {return fPdgs;}
+    const float*    Es()        const {return fEs;}
+    const float*    Pxs()       const {return fPxs;}
+    const float*    Pys()       const {return fPys;}
+    const float*    Pzs()       const {return fPzs;}
+
+  protected:
+    void Close();
+
+    std::string fPath;
+    void*  fAddr;
+    size_t fSize;
+
+    const float*    fEnergies;
+    const int32_t*  fProdIds;
+    const uint64_t* fFirstPart;
+    const int32_t*  fPdgs;
+    const float*    fEs;
+    const float*    fPxs;
+    const float*    fPys;
+    const float*    fPzs;
+  };
+
+}} // namespaces
+
+#endif
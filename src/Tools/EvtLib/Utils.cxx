@@ -1,6 +1,13 @@
 #include "Tools/EvtLib/Utils.h"
 
 #include "Framework/Messenger/Messenger.h"
+#include "Framework/ParticleData/PDGCodes.h"
+#include "Framework/ParticleData/PDGLibrary.h"
+#include "Framework/ParticleData/PDGUtils.h"
+
+#include "TFile.h"
+#include "TTree.h"
+#include "TString.h"
 
 #include <wordexp.h>
 
@@ -31,3 +38,54 @@ void genie::evtlib::Expand(std::string& s)
 
   wordfree(&p);
 }
+
+//___________________________________________________________________________
+void genie::evtlib::ForEachRecordTree(TFile* f, const std::string& libPath,
+                                      std::function<void(const Key&, TTree*, const std::string&)> func)
+{
+  PDGLibrary* pdglib = PDGLibrary::Instance();
+
+  TIter next(f->GetListOfKeys());
+  while(TObject* dir = next()){
+    const std::string& tgtName = dir->GetName();
+    const TParticlePDG* tgtPart = pdglib->DBase()->GetParticle(tgtName.c_str());
+    if(!tgtPart){
+      LOG("ELI", pWARN) << "Unknown nucleus " << tgtName
+                        << " found in " << libPath
+                        << " -- skipping";
+      continue;
+    }
+
+    for(int pdg: {kPdgNuE,   kPdgAntiNuE,
+                  kPdgNuMu,  kPdgAntiNuMu,
+                  kPdgNuTau, kPdgAntiNuTau}){
+
+      for(bool iscc: {true, false}){
+        // NCs should be the same for all flavours. Use nu_mu as a convention
+        // internal to this code to index into the records map.
+        if(!iscc && abs(pdg) != kPdgNuMu) continue;
+
+        std::string nuName = pdglib->Find(pdg)->GetName();
+        if(!iscc) nuName = pdg::IsAntiNeutrino(pdg) ? "nu_bar" : "nu";
+
+        const std::string treeName =
+          TString::Format("%s/%s/%s/records",
+                          tgtName.c_str(),
+                          iscc ? "cc" : "nc",
+                          nuName.c_str()).Data();
+
+        const Key key(tgtPart->PdgCode(), pdg, iscc);
+
+        TTree* tr = (TTree*)f->Get(treeName.c_str());
+
+        if(!tr){
+          LOG("ELI", pINFO) << treeName << " not found in "
+                            << libPath << " -- skipping";
+          continue;
+        }
+
+        func(key, tr, treeName);
+      } // end for iscc
+    } // end for pdg
+  } // end for dir
+}
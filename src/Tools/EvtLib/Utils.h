@@ -2,6 +2,12 @@
 #define _EVTLIB_UTILS_H_
 
 #include <string>
+#include <functional>
+
+#include "Tools/EvtLib/Key.h"
+
+class TFile;
+class TTree;
 
 namespace genie{
 namespace evtlib{
@@ -11,6 +17,13 @@ namespace evtlib{
 /// It is a fatal error if there is not exactly one result of the expansion
 void Expand(std::string& s);
 
+/// \brief Call \a func for each of the record trees of an event library file
+///
+/// The trees are laid out as \<target\>/\<cc|nc\>/\<nu\>/records. NC records are
+/// keyed as nu_mu (nu_mu_bar), a convention internal to this code.
+void ForEachRecordTree(TFile* f, const std::string& libPath,
+                       std::function<void(const Key&, TTree*, const std::string&)> func);
+
 }}
 
 #endif
@@ -9,14 +9,18 @@
 //____________________________________________________________________________
 
 #include <math.h>
+#include <cstdlib>
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
 //GENIE includes
 #include "Framework/ParticleData/PDGCodes.h"
 #include "Tools/Flux/GNuMIFlux.h"
 #include "Tools/Flux/GSimpleNtpFlux.h"
 #include "Framework/Numerical/RandomGen.h"
+#include "Framework/Utils/RunOpt.h"
+#include "Framework/Utils/StringUtils.h"
 
 #include "Tools/Flux/GFluxBlender.h"
 #include "Tools/Flux/GFlavorMixerI.h"
@@ -42,8 +46,24 @@ GFluxBlender::GFluxBlender() :
   fEnergy(0),
   fDistance(0),
   fPdgCGenerated(0),
-  fPdgCMixed(0)
-{ ; }
+  fPdgCMixed(0),
+  fProbTableEMin(0),
+  fProbTableEMax(0),
+  fProbTableNE(0),
+  fProbTableLMin(0),
+  fProbTableLMax(0),
+  fProbTableNL(0),
+  fProbTableMaxErr(0),
+  fNProbTableMiss(0),
+  fProbTableTried(false)
+{
+  std::string spec = RunOpt::Instance()->FluxProbTable();
+  if ( spec.size() == 0 ) {
+    const char * env = std::getenv("GFLUXPROBTABLE");
+    if ( env ) spec = env;
+  }
+  if ( spec.size() > 0 ) SetProbTableSpec(spec);
+}
 
 GFluxBlender::~GFluxBlender()
 {
@@ -83,6 +103,14 @@ const PDGCodeList& GFluxBlender::FluxParticles(void)
 //____________________________________________________________________________
 bool GFluxBlender::GenerateNext(void)
 {
+  // build the requested probability table once the mixer is known
+  if ( fFlavorMixer && ! fProbTableSpec.empty() && ! fProbTableTried ) {
+    fProbTableTried = true;
+    BuildProbTable(fProbTableSpec[0],fProbTableSpec[1],
+                   (size_t)fProbTableSpec[2],
+                   fProbTableSpec[3],fProbTableSpec[4],
+                   (size_t)fProbTableSpec[5]);
+  }
 
   bool gen1 = false;
   while ( ! gen1 ) {
@@ -140,6 +168,8 @@ GFluxI* GFluxBlender::AdoptFluxGenerator(GFluxI* generator)
   fGSimpleFlux = dynamic_cast<GSimpleNtpFlux*>(fRealGFluxI);
   // force evaluation of particle lists
   this->FluxParticles();
+  // a requested table must cover the new generator flavors
+  fProbTableTried = false;
 
   return oldgen;
 }
@@ -149,31 +179,216 @@ GFlavorMixerI* GFluxBlender::AdoptFlavorMixer(GFlavorMixerI* mixer)
 {
   GFlavorMixerI* oldmix = fFlavorMixer;
   fFlavorMixer = mixer;
+  // a table from the previous mixer no longer applies
+  ClearProbTable();
+  fProbTableTried = false;
   return oldmix;
 }
 
 //____________________________________________________________________________
-int GFluxBlender::ChooseFlavor(int pdg_init, double energy, double dist)
+bool GFluxBlender::SetProbTableSpec(std::string spec)
 {
-  // choose a new flavor
-  bool   isset = false;
-  int    pdg_out = 0;
-  double sumprob = 0;
+  std::vector<std::string> fields = utils::str::Split(spec,",");
+  std::vector<double> values;
+  for (size_t i = 0; i < fields.size(); ++i ) {
+    std::string field = utils::str::TrimSpaces(fields[i]);
+    char* end = 0;
+    double value = strtod(field.c_str(),&end);
+    if ( field.empty() || *end != '\0' ) break;
+    values.push_back(value);
+  }
+  if ( fields.size() != 6 || values.size() != 6 ||
+       values[2] < 0 || values[5] < 0 ) {
+    LOG_BEGIN("FluxBlender", pERROR)
+      << "Invalid probability table request \"" << spec
+      << "\" - expected emin,emax,ne,lmin,lmax,nl" << LOG_END;
+    return false;
+  }
+  fProbTableSpec  = values;
+  fProbTableTried = false;
+  return true;
+}
 
-  fRndm = RandomGen::Instance()->RndFlux().Rndm();
+//____________________________________________________________________________
+double GFluxBlender::BuildProbTable(double emin, double emax, size_t ne,
+                                    double lmin, double lmax, size_t nl)
+{
+  ClearProbTable();
+
+  if ( ! fRealGFluxI || ! fFlavorMixer ) {
+    LOG_BEGIN("FluxBlender", pERROR)
+      << "BuildProbTable() needs a flux generator and a flavor mixer"
+      << LOG_END;
+    return -1;
+  }
+  bool lok = ( nl == 1 ) ? ( lmax == lmin ) : ( nl > 1 && lmax > lmin );
+  if ( emin <= 0 || emax <= emin || ne < 2 || ! lok ) {
+    LOG_BEGIN("FluxBlender", pERROR)
+      << "Invalid probability table: E [" << emin << "," << emax
+      << "] n=" << ne << ", L [" << lmin << "," << lmax << "] n=" << nl
+      << LOG_END;
+    return -1;
+  }
+
+  fProbTablePdgIn.assign(fPDGListGenerator.begin(),fPDGListGenerator.end());
+  fProbTableEMin = emin;
+  fProbTableEMax = emax;
+  fProbTableNE   = ne;
+  fProbTableLMin = lmin;
+  fProbTableLMax = lmax;
+  fProbTableNL   = nl;
+
+  const size_t nin   = fProbTablePdgIn.size();
+  const double dloge = log(emax/emin)/(ne-1);
+  const double dl    = ( nl > 1 ) ? (lmax-lmin)/(nl-1) : 0;
+
+  // cumulative probabilities over the mixed flavors, so that choosing
+  // a flavor takes a single pass over the interpolated values
+  fProbTable.resize(nin*ne*nl*fNPDGOut);
+  for (size_t iin = 0; iin < nin; ++iin ) {
+    for (size_t ie = 0; ie < ne; ++ie ) {
+      double energy = emin*exp(ie*dloge);
+      for (size_t il = 0; il < nl; ++il ) {
+        double dist = lmin + il*dl;
+        double* cumprob = &fProbTable[((iin*ne + ie)*nl + il)*fNPDGOut];
+        double sumprob = 0;
+        for (size_t indx = 0; indx < fNPDGOut; ++indx ) {
+          sumprob += fFlavorMixer->Probability(fProbTablePdgIn[iin],
+                                               fPDGListMixed[indx],
+                                               energy,dist);
+          cumprob[indx] = sumprob;
+        }
+      }
+    }
+  }
+
+  // the interpolation is least accurate at the centres of the cells
+  double maxerr = 0;
+  for (size_t iin = 0; iin < nin; ++iin ) {
+    for (size_t ie = 0; ie+1 < ne; ++ie ) {
+      double energy = emin*exp((ie+0.5)*dloge);
+      for (size_t il = 0; il+1 < std::max(nl,(size_t)2); ++il ) {
+        double dist = ( nl > 1 ) ? lmin + (il+0.5)*dl : lmin;
+        InterpolateProbTable(fProbTablePdgIn[iin],energy,dist);
+        for (size_t indx = 0; indx < fNPDGOut; ++indx ) {
+          double prob = fFlavorMixer->Probability(fProbTablePdgIn[iin],
+                                                  fPDGListMixed[indx],
+                                                  energy,dist);
+          maxerr = std::max(maxerr,fabs(fProb[indx]-prob));
+        }
+      }
+    }
+  }
+  fProbTableMaxErr = maxerr;
+
+  LOG_BEGIN("FluxBlender", pNOTICE)
+    << "Built mixing probability table: " << nin << " flavors x "
+    << ne << " energies [" << emin << "," << emax << "] x "
+    << nl << " distances [" << lmin << "," << lmax << "]"
+    << ", max interpolation error " << maxerr << LOG_END;
+
+  return maxerr;
+}
+
+//____________________________________________________________________________
+void GFluxBlender::ClearProbTable(void)
+{
+  fProbTablePdgIn.clear();
+  fProbTable.clear();
+  fProbTableEMin   = 0;
+  fProbTableEMax   = 0;
+  fProbTableNE     = 0;
+  fProbTableLMin   = 0;
+  fProbTableLMax   = 0;
+  fProbTableNL     = 0;
+  fProbTableMaxErr = 0;
+  fNProbTableMiss  = 0;
+}
+
+//____________________________________________________________________________
+bool GFluxBlender::InterpolateProbTable(int pdg_init, double energy,
+                                        double dist)
+{
+  // fill fProb, fSumProb from the table; false if not covered by it
+  if ( fProbTable.empty() ) return false;
+  std::vector<int>::const_iterator itr =
+    std::find(fProbTablePdgIn.begin(),fProbTablePdgIn.end(),pdg_init);
+  if ( itr == fProbTablePdgIn.end() ) return false;
+  if ( energy < fProbTableEMin || energy > fProbTableEMax ||
+       dist   < fProbTableLMin || dist   > fProbTableLMax    ) return false;
+
+  const size_t iin = itr - fProbTablePdgIn.begin();
+  const size_t ne  = fProbTableNE;
+  const size_t nl  = fProbTableNL;
+
+  double ue = log(energy/fProbTableEMin) /
+              log(fProbTableEMax/fProbTableEMin) * (ne-1);
+  size_t ie = std::min((size_t)ue,ne-2);
+  double fe = ue - ie;
+
+  size_t il = 0;
+  double fl = 0;
+  if ( nl > 1 ) {
+    double ul = (dist-fProbTableLMin) /
+                (fProbTableLMax-fProbTableLMin) * (nl-1);
+    il = std::min((size_t)ul,nl-2);
+    fl = ul - il;
+  }
+
+  const double* c00 = &fProbTable[((iin*ne + ie)*nl + il)*fNPDGOut];
+  const double* c10 = c00 + nl*fNPDGOut;
+  const double* c01 = ( nl > 1 ) ? c00 + fNPDGOut : c00;
+  const double* c11 = ( nl > 1 ) ? c10 + fNPDGOut : c10;
+
+  double prevsum = 0;
   for (size_t indx = 0; indx < fNPDGOut; ++indx ) {
-    int pdg_test = fPDGListMixed[indx];
-    double prob = fFlavorMixer->Probability(pdg_init,pdg_test,energy,dist);
-    fProb[indx] = prob;
-    sumprob += fProb[indx];
+    double sumprob = (1-fe)*((1-fl)*c00[indx] + fl*c01[indx]) +
+                        fe *((1-fl)*c10[indx] + fl*c11[indx]);
     fSumProb[indx] = sumprob;
-    if ( ! isset && fRndm < sumprob ) {
-      isset   = true;
-      pdg_out = pdg_test;
+    fProb[indx]    = sumprob - prevsum;
+    prevsum        = sumprob;
+  }
+  return true;
+}
+
+//____________________________________________________________________________
+double GFluxBlender::ProbTableError(int pdg_init, double energy, double dist)
+{
+  if ( ! InterpolateProbTable(pdg_init,energy,dist) ) return -1;
+  double maxerr = 0;
+  for (size_t indx = 0; indx < fNPDGOut; ++indx ) {
+    double prob = fFlavorMixer->Probability(pdg_init,fPDGListMixed[indx],
+                                            energy,dist);
+    maxerr = std::max(maxerr,fabs(fProb[indx]-prob));
+  }
+  return maxerr;
+}
+
+//____________________________________________________________________________
+int GFluxBlender::ChooseFlavor(int pdg_init, double energy, double dist)
+{
+  fRndm = RandomGen::Instance()->RndFlux().Rndm();
+
+  // probabilities from the table if it covers this neutrino,
+  // otherwise from the mixer
+  if ( ! InterpolateProbTable(pdg_init,energy,dist) ) {
+    if ( ! fProbTable.empty() ) ++fNProbTableMiss;
+    double sumprob = 0;
+    for (size_t indx = 0; indx < fNPDGOut; ++indx ) {
+      int pdg_test = fPDGListMixed[indx];
+      double prob = fFlavorMixer->Probability(pdg_init,pdg_test,energy,dist);
+      fProb[indx] = prob;
+      sumprob += fProb[indx];
+      fSumProb[indx] = sumprob;
     }
   }
 
-  return pdg_out;
+  // choose a new flavor
+  for (size_t indx = 0; indx < fNPDGOut; ++indx ) {
+    if ( fRndm < fSumProb[indx] ) return fPDGListMixed[indx];
+  }
+
+  return 0;
 }
 
 //____________________________________________________________________________
@@ -205,6 +420,15 @@ void GFluxBlender::PrintConfig(void)
   LOG_BEGIN("FluxBlender", pINFO)
     << "PDG List after mixing (n=" << fNPDGOut << ")"
     << fPDGListMixed << LOG_END;
+  if ( ! fProbTable.empty() ) {
+    LOG_BEGIN("FluxBlender", pINFO)
+      << "   Probability table " << fProbTablePdgIn.size() << " flavors x "
+      << fProbTableNE << " E [" << fProbTableEMin << "," << fProbTableEMax
+      << "] x " << fProbTableNL << " L [" << fProbTableLMin << ","
+      << fProbTableLMax << "], max interpolation error "
+      << fProbTableMaxErr << ", " << fNProbTableMiss
+      << " neutrinos outside table" << LOG_END;
+  }
 
 }
 
@@ -19,6 +19,13 @@
          In such cases one would have to generate with a fixed flavor
          (energy/distance independent) swap and reweight after the fact.
 
+         For mixers that are costly to evaluate (e.g. with matter
+         effects) the probabilities can be tabulated once in (E,L)
+         with BuildProbTable() and interpolated for each neutrino.
+         Jobs can request the table without code changes with the
+         --flux-prob-table emin,emax,ne,lmin,lmax,nl option (or
+         $GFLUXPROBTABLE); it is then built before the first neutrino.
+
          Do not use this as a means of selecting only certain flavor
          from flux generators that support other means (e.g. GNuMIFlux,
          GSimpleNtpFlux which have SetFluxParticles(PDGCodeList)) as
@@ -37,6 +44,7 @@
 #ifndef GENIE_FLUX_GFLUXBLENDER_H
 #define GENIE_FLUX_GFLUXBLENDER_H
 
+#include <string>
 #include <vector>
 #include "Framework/EventGen/GFluxI.h"
 #include "Framework/ParticleData/PDGCodeList.h"
@@ -97,11 +105,39 @@ namespace flux {
     GFluxI*         GetFluxGenerator() { return fRealGFluxI; }  ///< access, not ownership
     GFlavorMixerI*  GetFlavorMixer()   { return fFlavorMixer; } ///< access, not ownership
 
+    //
+    // Optional table of the mixing probabilities, built from the flavor
+    // mixer for all generator => mixed flavor pairs on ne energies (log
+    // spaced) x nl distances (linear, meters) and interpolated for each
+    // neutrino; neutrinos outside the table use the mixer directly.
+    // Call after adopting the flux generator and the mixer (adopting a
+    // new mixer drops the table).  Returns the max interpolation error
+    // on the probabilities, estimated at the centres of the table cells.
+    //
+    double          BuildProbTable(double emin, double emax, size_t ne,
+                                   double lmin, double lmax, size_t nl);
+    void            ClearProbTable(void);
+    double          GetProbTableMaxError(void) { return fProbTableMaxErr; }
+    bool            HasProbTable(void) { return ! fProbTable.empty(); }
+    //
+    // Table requested as "emin,emax,ne,lmin,lmax,nl" and built by the
+    // first GenerateNext() (and again after adopting a new mixer).
+    // Defaults to RunOpt's --flux-prob-table, else $GFLUXPROBTABLE.
+    // Returns false if the string is malformed.
+    //
+    bool            SetProbTableSpec(std::string spec);
+    //
+    // Largest difference between the tabulated and the mixer's
+    // probabilities for one neutrino; negative if not in the table.
+    //
+    double          ProbTableError(int pdg_init, double energy, double dist);
+
     void            PrintConfig(void);
     void            PrintState(bool verbose=true);
 
   private:
     int             ChooseFlavor(int pdg_init, double energy, double dist);
+    bool            InterpolateProbTable(int pdg_init, double energy, double dist);
 
     GFluxI*         fRealGFluxI;        ///< actual flux generator
     GNuMIFlux*      fGNuMIFlux;         ///< ref to avoid repeat dynamic_cast
@@ -124,6 +160,19 @@ namespace flux {
     std::vector<double> fSumProb;       ///< cummulative probability
     double              fRndm;          ///< random # used to make choice
 
+    std::vector<int>    fProbTablePdgIn; ///< initial flavors in table
+    std::vector<double> fProbTable;      ///< cumulative probs [in][E][L][out]
+    double              fProbTableEMin;  ///< table energy range
+    double              fProbTableEMax;
+    size_t              fProbTableNE;    ///< # of energy nodes
+    double              fProbTableLMin;  ///< table distance range
+    double              fProbTableLMax;
+    size_t              fProbTableNL;    ///< # of distance nodes
+    double              fProbTableMaxErr; ///< max interpolation error
+    long int            fNProbTableMiss; ///< # of neutrinos outside table
+    std::vector<double> fProbTableSpec;  ///< requested table (emin,emax,ne,lmin,lmax,nl)
+    bool                fProbTableTried; ///< requested table already built (or failed)
+
   };
 
 } // namespace flux
@@ -3,14 +3,74 @@
 
 \program gevserv
 
-\brief   GENIE v+A event generation server 
+\brief   GENIE v+A event generation server
+
+         Starts up GENIE once (tune, cross section splines, event generation
+         drivers) and then serves event generation requests from local
+         clients over a Unix domain socket, so that client processes do not
+         pay GENIE's start-up time. Each client connection is served by a
+         forked copy of the warm server, so clients run concurrently and
+         share the initialized drivers and splines copy-on-write.
+
+         Requests are batched (initial state, energy, direction, number of
+         events) and events are streamed back as binary records. The wire
+         format is described in gEvServProtocol.h; client_test.C is an
+         example client.
 
          Syntax :
-           gevserv [-p port]
+           gevserv -p neutrino_codes -t target_codes
+                   --tune genie_tune
+                  [--socket path]
+                  [--max-clients n]
+                  [--warm-up-energy E]
+                  [--seed random_number_seed]
+                  [--cross-sections xml_file]
+                  [--event-generator-list list_name]
+                  [--message-thresholds xml_file]
+                  [--unphysical-event-mask mask]
+                  [--event-record-print-level level]
+                  [--cache-file root_file]
 
          Options :
            [] denotes an optional argument
-           -p port number (default: 9090)
+           -p Comma separated list of neutrino PDG codes to serve.
+           -t Comma separated list of target PDG codes to serve
+              (format: 10LZZZAAAI).
+           --socket
+              Path of the Unix domain socket (default: /tmp/gevserv.sock).
+              An existing socket at that path is replaced.
+           --max-clients
+              Maximum number of clients served concurrently (default: 0,
+              no limit). Further connections wait in the listen queue.
+           --warm-up-energy
+              If set, generate one event per initial state at this energy
+              (GeV) before accepting clients, so that tables loaded on
+              first use are already in memory in every client's server.
+           --seed
+              Random number seed. Client i is served with seed+i. If unset,
+              every client gets a seed derived from the time and its pid.
+           --cross-sections
+              Name (incl. full path) of an XML file with pre-computed
+              cross-section values used for constructing splines.
+           --tune
+              Specifies a GENIE comprehensive neutrino interaction model tune.
+           --event-generator-list
+              List of event generators to load in event generation drivers.
+           --message-thresholds
+              Specifies the GENIE verbosity level.
+           --unphysical-event-mask
+              Specify a 16-bit mask to allow certain types of unphysical
+              events to be written in the output file.
+           --event-record-print-level
+              Allows users to set the level of information shown when the
+              event is printed on the screen.
+           --cache-file
+              Allows users to specify a ROOT file so that results of
+              calculation cached throughout a MC job can be re-used in
+              subsequent MC jobs.
+
+         The server stops on SIGINT or SIGTERM, terminating any clients
+         still being served.
 
 \author  Costas Andreopoulos <constantinos.andreopoulos \at cern.ch>
  University of Liverpool & STFC Rutherford Appleton Laboratory
@@ -19,596 +79,551 @@
 
 \cpright Copyright (c) 2003-2023, The GENIE Collaboration
          For the full text of the license visit http://copyright.genie-mc.org
-         
+
 */
 //____________________________________________________________________________
 
-#include <cassert>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
 #include <iostream>
-#include <sstream>
+#include <set>
 #include <string>
 #include <vector>
 
-#include <TSystem.h>
-#include <TServerSocket.h>
-#include <TSocket.h>
-#include <TMessage.h>
-#include <TBits.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#include <TLorentzVector.h>
 #include <TMath.h>
 
-#include "Conventions/Units.h"
-#include "EVGCore/EventRecord.h"
-#include "EVGDrivers/GEVGDriver.h"
-#include "EVGDrivers/GEVGPool.h"
-#include "EVGDrivers/GMCJMonitor.h"
-#include "GHEP/GHepFlags.h"
-#include "GHEP/GHepParticle.h"
-#include "GHEP/GHepRecord.h"
-#include "Interaction/Interaction.h"
-#include "Messenger/Messenger.h"
-#include "Numerical/Spline.h"
-#include "PDG/PDGCodeList.h"
-#include "Utils/XSecSplineList.h"
-#include "Utils/StringUtils.h"
-#include "Utils/CmdLnArgParser.h"
+#include "Framework/Conventions/Units.h"
+#include "Framework/EventGen/EventRecord.h"
+#include "Framework/EventGen/GEVGDriver.h"
+#include "Framework/EventGen/GEVGPool.h"
+#include "Framework/GHEP/GHepParticle.h"
+#include "Framework/GHEP/GHepRecord.h"
+#include "Framework/Interaction/Interaction.h"
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Numerical/RandomGen.h"
+#include "Framework/ParticleData/PDGCodeList.h"
+#include "Framework/Utils/AppInit.h"
+#include "Framework/Utils/RunOpt.h"
+#include "Framework/Utils/StringUtils.h"
+#include "Framework/Utils/CmdLnArgParser.h"
+
+#include "gEvServProtocol.h"
 
 using std::string;
 using std::vector;
-using std::ostringstream;
+using std::set;
 
 using namespace genie;
-using namespace genie::utils;
+using namespace genie::evserv;
 
 // ** Prototypes
 //
 void GetCommandLineArgs (int argc, char ** argv);
 void PrintSyntax        (void);
-void RunInitChecks      (void);
-void HandleMesg         (string mesg);
-void Handshake          (void);
-void Configure          (string mesg);
-void CalcTotalXSec      (string mesg);
-void GenerateEvent      (string mesg);
-void Shutdown           (void);
+void Initialize         (void);
+void WarmUp             (void);
+int  OpenSocket         (void);
+void ServeClient        (int fd);
+bool GenerateBatch      (int fd, const Request & req);
+void ReapClients        (bool block);
+void OnSignal           (int sig);
+bool SendAll            (int fd, const void * buf, size_t n);
+bool RecvAll            (int fd, void * buf, size_t n);
 
 // ** Consts & Defaults
 //
-const int    kDefPortNum           = 9090;  // default port number
-const string kHandshakeCmdRecv     = "RUB GENIE LAMP";
-const string kHandshakeMesgSent    = "YOU HAVE 3 WISHES!";
-const string kConfigCmdRecv        = "CONFIG";
-const string kConfigOkMesgSent     = "CONFIG COMPLETED";
-const string kConfigCmdLdSpl       = "load-splines";
-const string kConfigCmdNeuList     = "neutrino-list";
-const string kConfigCmdTgtList     = "target-list";
-const string kXSecCmdRecv          = "XSEC";
-const string kXSecCmdSent          = "XSECSPL";
-const string kXSecOkMesgSent       = "XSEC SENT";
-const string kEvgenCmdRecv         = "EVTVTX";
-const string kEvgenHdrCmdSent      = "EVTREC";
-const string kEvgenStdhepCmdSent   = "STDHEP";
-const string kEvgenOkMesgSent      = "EVENT GENERATED";
-const string kShutdownCmdRecv      = "SHUTDOWN";
-const string kShutdownOkMesgSent   = "SHUTTING DOWN";
-const string kErrNoConf            = "*** NOT CONFIGURED! ***";
-const string kErrNoDriver          = "*** NO EVENT GENERATION DRIVER! ***";
-const string kErrNoEvent           = "*** NULL OR UNPHYSICAL EVENT! ***";
-const string kErr                  = "FAILED";
+const string   kDefSocketPath  = "/tmp/gevserv.sock";
+const uint32_t kMaxBatchSize   = 10000000; // events per request
+const int      kMaxEvgenTries  = 100;      // attempts per event before giving up
 
 // ** User-specified options:
 //
-int gOptPortNum;   // port number
+PDGCodeList gOptNuPdgCodes(false);    // neutrinos to serve
+PDGCodeList gOptTgtPdgCodes(false);   // targets to serve
+string      gOptSocketPath;           // Unix domain socket path
+int         gOptMaxClients;           // max concurrent clients (0: no limit)
+double      gOptWarmUpEnergy;         // warm-up energy (<=0: no warm-up)
+long int    gOptRanSeed;              // random number seed
+string      gOptInpXSecFile;          // cross-section splines
 
 // ** Globals
 //
-TSocket * gSock       = 0;      // tcp/ip socket
-bool      gShutDown   = false;  // 'shutting down?' flag
-bool      gConfigured = false;  // 'am I configured?' flag
-GEVGPool  gGPool;               // list of GENIE event generation drivers used in job
+GEVGPool                gGPool;              // warm event generation drivers
+vector<InitialState>    gInitStates;         // initial states served
+set<pid_t>              gClients;            // pids of the client servers
+volatile sig_atomic_t   gShutDown = 0;       // 'shutting down?' flag
 
 //____________________________________________________________________________
 int main(int argc, char ** argv)
 {
-  // Parse command line arguments
   GetCommandLineArgs(argc,argv);
 
-  // Run some checks
-  RunInitChecks();
+  Initialize();
+  WarmUp();
 
-  // Open a server socket
-  TServerSocket * serv_sock = new TServerSocket(gOptPortNum, kTRUE);
+  int lfd = OpenSocket();
 
-  // Accept a connection
-  gSock = serv_sock->Accept();
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = OnSignal;   // no SA_RESTART: poll/waitpid return EINTR
+  sigaction(SIGINT,  &sa, 0);
+  sigaction(SIGTERM, &sa, 0);
+  signal(SIGPIPE, SIG_IGN);   // a vanishing client must not kill its server
 
-  if(!gSock) exit(1);
-  LOG("gevserv", pNOTICE) << "Listening on port: " << gOptPortNum;
-  
-  // Set no TCP/IP NODELAY
-  int delay_ok = gSock->SetOption(kNoDelay,1);
-  LOG("gevserv", pNOTICE) << "TCP_NODELAY > " << delay_ok;
-
-  // Start listening for messages & take the corresponding actions
+  LOG("gevserv", pNOTICE)
+     << "Serving " << gInitStates.size() << " initial states on: "
+     << gOptSocketPath;
 
-  while(1) {
+  long int nclients = 0;
 
-    if(gShutDown) break;
+  while(!gShutDown) {
 
-    TMessage * mesg = 0;
+    ReapClients(false);
 
-    gSock->Recv(mesg);
+    // At the client limit, wait for one of the clients to finish
+    if(gOptMaxClients > 0 && (int)gClients.size() >= gOptMaxClients) {
+      ReapClients(true);
+      continue;
+    }
 
-    if(!mesg) continue;
-    if(mesg->What() != kMESS_STRING) continue;
+    struct pollfd pfd;
+    pfd.fd = lfd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if(poll(&pfd, 1, 1000) <= 0) continue;  // timeout (reap) or signal
+
+    int cfd = accept(lfd, 0, 0);
+    if(cfd < 0) continue;
+
+    long int seed = (gOptRanSeed >= 0) ?
+        gOptRanSeed + nclients : (long int) time(0) + 7919 * nclients;
+    nclients++;
+
+    // Log appenders are inherited by the child; do not let it replay
+    // buffered output
+    std::cout.flush();
+    std::cerr.flush();
+
+    pid_t pid = fork();
+    if(pid < 0) {
+      LOG("gevserv", pERROR) << "fork() failed: " << strerror(errno);
+      close(cfd);
+      continue;
+    }
+    if(pid == 0) {
+      close(lfd);
+      signal(SIGINT,  SIG_DFL);
+      signal(SIGTERM, SIG_DFL);
+      RandomGen::Instance()->SetSeed(
+          (gOptRanSeed >= 0) ? seed : seed ^ ((long int)getpid() << 16));
+      ServeClient(cfd);
+      close(cfd);
+      std::cout.flush();
+      std::cerr.flush();
+      _exit(0);
+    }
 
-    char mesg_content[2048];
-    mesg->ReadString(mesg_content, 2048);
+    close(cfd);
+    gClients.insert(pid);
+    LOG("gevserv", pNOTICE)
+       << "Client " << nclients << " served by pid " << pid
+       << " (" << gClients.size() << " active)";
+  }
 
-    LOG("gevserv", pNOTICE) << "Processing mesg > " << mesg_content;
+  LOG("gevserv", pNOTICE) << "Shutting GENIE event server down ...";
 
-    HandleMesg(mesg_content);
+  close(lfd);
+  unlink(gOptSocketPath.c_str());
 
-  } // while(1)
+  set<pid_t>::const_iterator it = gClients.begin();
+  for( ; it != gClients.end(); ++it) kill(*it, SIGTERM);
+  while(!gClients.empty()) ReapClients(true);
 
+  LOG("gevserv", pINFO) << "...done!";
   return 0;
 }
 //____________________________________________________________________________
-void HandleMesg(string mesg)
+void Initialize(void)
 {
-  if(mesg.find(kHandshakeCmdRecv.c_str()) != string::npos) 
-  { 
-    Handshake();
-  } 
-  else
-  if (mesg.find(kConfigCmdRecv.c_str()) != string::npos) 
-  {
-    Configure(mesg);
-  } 
-  else
-  if (mesg.find(kXSecCmdRecv.c_str()) != string::npos) 
-  {
-    CalcTotalXSec(mesg);
+  if ( ! RunOpt::Instance()->Tune() ) {
+    LOG("gevserv", pFATAL) << " No TuneId in RunOption";
+    exit(-1);
   }
-  else
-  if (mesg.find(kEvgenCmdRecv.c_str()) != string::npos) 
-  {
-    GenerateEvent(mesg);
-  } 
-  else
-  if (mesg.find(kShutdownCmdRecv.c_str()) != string::npos) 
-  {
-    Shutdown();
-  }
-}
-//____________________________________________________________________________
-void Handshake(void)
-{
-// Reply to client messages checking whether the event server is active
-//
-  LOG("gevserv", pNOTICE) 
-         << "GENIE was pinged by a client (lamp was rubbed)! Responding...";
-  
-  gSock->Send(kHandshakeMesgSent.c_str());
+  RunOpt::Instance()->BuildTune();
 
-  LOG("gevserv", pINFO) << "...done!";
-}
-//____________________________________________________________________________
-void Configure(string mesg)
-{
-// Configure the GENIE event server
-// ** Load splines 
-//    - if the "load-splines" command is contained in the mesg 
-//    - the splines are loaded from the the XML file specified in $GSPLOAD (server-side) 
-//    the "load-splines" mesg is sent
-// ** Specify the neutrino list
-//    - adding a "neutrino-list=<comma separated list of pdg codes>" in the mesg
-// ** Specify the target list
-//    - adding a "target-list=<comma separated list of pdg codes>" in the mesg
-//
-// Note:
-// - All nedded cross section splines for the specified neutrino/target lists must 
-//   be available in the specified XML file. If not GENIE will attempt building the
-//   the missing ones which may increase start-up overheads.
-// - You can further control GENIE (suppress modes, set messenger verbosity, ...)
-//   by setting all the std GENIE env vars at the server side. 
-//   See the GENIE web site.
-
-  LOG("gevserv", pNOTICE)  << "Configuring GENIE event server";
-
-  mesg = str::FilterString(kConfigCmdRecv, mesg); 
-  mesg = str::FilterString(":", mesg); 
-  mesg = str::TrimSpaces(mesg);             
-
-  LOG("gevserv", pNOTICE) << "Configure options: " << mesg;
-
-  // Autoload splines from the XML file pointed at the $GSPLOAD env. var.
-  // (if set at the server side)
-  //
-  if(mesg.find(kConfigCmdLdSpl) != string::npos) {
-     XSecSplineList * xspl = XSecSplineList::Instance();
-     xspl->AutoLoad();
-
-     mesg.erase(mesg.find(kConfigCmdLdSpl),12);
-     mesg = str::TrimSpaces(mesg);             
-  }
-
-  // Extract neutrino and target lists from the input mesg
-  //
-  bool allowdup = false;
-  PDGCodeList neutrinos(allowdup);
-  PDGCodeList targets(allowdup);
-
-  vector<string> conf_opt_v = str::Split(mesg," ");
-  vector<string>::iterator conf_opt_iter = conf_opt_v.begin();
-
-  for( ; conf_opt_iter != conf_opt_v.end(); ++conf_opt_iter) {
-    string conf_opt = *conf_opt_iter;
-    LOG("gevserv", pNOTICE) 
-          << "Processing config option: " << conf_opt;
-
-    vector<string> sv = str::Split(conf_opt, "=");
-    assert(sv.size()==2);
-    string list_name     = sv[0];
-    string particle_list = sv[1];
-
-    vector<string> particles = str::Split(particle_list, ",");
-    vector<string>::iterator particle_iter = particles.begin();
-
-    for( ; particle_iter != particles.end(); ++particle_iter) {
-      string particle_code_str = *particle_iter;
-      int particle_code = atoi(particle_code_str.c_str());
-
-      if(list_name.find(kConfigCmdNeuList) != string::npos) 
-      {
-         neutrinos.push_back(particle_code);
-      } else 
-      if(list_name.find(kConfigCmdTgtList) != string::npos) 
-      {
-	 targets.push_back(particle_code);
-      }
-    }
-  }
-
-  LOG("gevserv", pNOTICE) 
-        << "Specified neutrino list: " << neutrinos;
-  LOG("gevserv", pNOTICE) 
-        << "Specified target list: "   << targets;
+  utils::app_init::MesgThresholds(RunOpt::Instance()->MesgThresholdFiles());
+  utils::app_init::CacheFile(RunOpt::Instance()->CacheFile());
+  utils::app_init::RandGen(gOptRanSeed);
+  utils::app_init::XSecTable(gOptInpXSecFile, false);
 
+  GHepRecord::SetPrintLevel(RunOpt::Instance()->EventRecordPrintLevel());
 
-  // Loop over the specified neutrinos and targets and for each
-  // possible pair create / configure a GENIE event generation driver.
-  //
+  // Create / configure a driver for each requested initial state.
+  // UseSplines() also builds any spline missing from the XML file, which
+  // can make start-up slow, but is only paid once.
   PDGCodeList::const_iterator nuiter;
   PDGCodeList::const_iterator tgtiter;
+  for(nuiter = gOptNuPdgCodes.begin(); nuiter != gOptNuPdgCodes.end(); ++nuiter) {
+   for(tgtiter = gOptTgtPdgCodes.begin(); tgtiter != gOptTgtPdgCodes.end(); ++tgtiter) {
 
-  for(nuiter = neutrinos.begin(); nuiter != neutrinos.end(); ++nuiter) {
-   for(tgtiter = targets.begin(); tgtiter != targets.end(); ++tgtiter) {
-
-     int target_code   = *tgtiter;
-     int neutrino_code = *nuiter;
-
-     InitialState init_state(target_code, neutrino_code);
+     InitialState init_state(*tgtiter, *nuiter);
 
      LOG("gevserv", pNOTICE)
        << "\n\n ---- Creating a GEVGDriver object configured for init-state: "
        << init_state.AsString() << " ----\n\n";
 
      GEVGDriver * evgdriver = new GEVGDriver;
+     evgdriver->SetEventGeneratorList(RunOpt::Instance()->EventGeneratorList());
+     evgdriver->SetUnphysEventMask(*RunOpt::Instance()->UnphysEventMask());
      evgdriver->Configure(init_state);
-     evgdriver->UseSplines(); // will also check if all splines needed are loaded
+     evgdriver->UseSplines();
 
      gGPool.insert( GEVGPool::value_type(init_state.AsString(), evgdriver) );
+     gInitStates.push_back(init_state);
 
    } // targets
   } // neutrinos
 
   LOG("gevserv", pNOTICE)
        << "All necessary GEVGDriver object were pushed into GEVGPool\n";
+}
+//____________________________________________________________________________
+void WarmUp(void)
+{
+// Generate a throw-away event for each initial state so that anything
+// loaded lazily on the first event is in memory before forking
+//
+  if(gOptWarmUpEnergy <= 0) return;
 
-  gConfigured = true;
-
-  gSock->Send(kConfigOkMesgSent.c_str());
-
-  LOG("gevserv", pINFO) << "...done!";
+  LOG("gevserv", pNOTICE)
+     << "Warming up at E = " << gOptWarmUpEnergy << " GeV";
+
+  TLorentzVector p4(0., 0., gOptWarmUpEnergy, gOptWarmUpEnergy);
+
+  vector<InitialState>::const_iterator it = gInitStates.begin();
+  for( ; it != gInitStates.end(); ++it) {
+    GEVGDriver * evg_driver = gGPool.FindDriver(*it);
+    Range1D_t range = evg_driver->ValidEnergyRange();
+    if(gOptWarmUpEnergy < range.min || gOptWarmUpEnergy > range.max) {
+      LOG("gevserv", pWARN)
+         << "Warm-up energy outside the valid range for: " << it->AsString();
+      continue;
+    }
+    EventRecord * event = evg_driver->GenerateEvent(p4);
+    delete event;
+  }
 }
 //____________________________________________________________________________
-void CalcTotalXSec(string mesg)
+int OpenSocket(void)
 {
-  LOG("gevserv", pNOTICE) 
-       << "Sending total xsec for enabled channels  - Input info : " << mesg;
-
-  if(!gConfigured) {
-      LOG("gevserv", pERROR) 
-             << "Event server is not configured - Can not generate event";
-      gSock->Send(kErrNoConf.c_str());
-      gSock->Send(kErr.c_str());
-      return;
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if(gOptSocketPath.size() >= sizeof(addr.sun_path)) {
+    LOG("gevserv", pFATAL) << "Socket path is too long: " << gOptSocketPath;
+    gAbortingInErr = true;
+    exit(1);
   }
+  strncpy(addr.sun_path, gOptSocketPath.c_str(), sizeof(addr.sun_path)-1);
 
-  // Extract info from the input mesg
-
-  mesg = str::FilterString(kXSecCmdRecv, mesg); 
-  mesg = str::FilterString(":", mesg); 
-  mesg = str::TrimSpaces(mesg);             
-
-  vector<string> sv = str::Split(mesg," "); 
-  assert(sv.size()==2);
-
-  int ipdgnu  = atoi(sv[0].c_str());  // neutrino code
-  int ipdgtgt = atoi(sv[1].c_str());  // target code
-
-  // Find the appropriate event generation driver for the given initial state
-
-  InitialState init_state(ipdgtgt, ipdgnu);
-  GEVGDriver * evg_driver = gGPool.FindDriver(init_state);
-  if(!evg_driver) {
-     LOG("gevserv", pERROR)
-       << "No GEVGDriver object for init state: " << init_state.AsString();
-     gSock->Send(kErrNoDriver.c_str());
-     gSock->Send(kErr.c_str());
-     return;
+  int lfd = socket(AF_UNIX, SOCK_STREAM, 0);
+  unlink(gOptSocketPath.c_str());
+  if(lfd < 0 ||
+     bind(lfd, (struct sockaddr *) &addr, sizeof(addr)) != 0 ||
+     listen(lfd, 64) != 0)
+  {
+    LOG("gevserv", pFATAL)
+       << "Could not listen on " << gOptSocketPath << ": " << strerror(errno);
+    gAbortingInErr = true;
+    exit(1);
   }
+  return lfd;
+}
+//____________________________________________________________________________
+void ServeClient(int fd)
+{
+  // Announce the initial states this server can generate
+  ServerHello hello;
+  memset(&hello, 0, sizeof(hello));
+  memcpy(hello.magic, kServerMagic, sizeof(kServerMagic));
+  hello.version = kServerVersion;
+  hello.ninit   = gInitStates.size();
+
+  vector<InitStateRec> init(gInitStates.size());
+  for(unsigned int i = 0; i < gInitStates.size(); i++) {
+    init[i].nu_pdg  = gInitStates[i].ProbePdg();
+    init[i].tgt_pdg = gInitStates[i].Tgt().Pdg();
+  }
+  if(!SendAll(fd, &hello, sizeof(hello))) return;
+  if(!init.empty() &&
+     !SendAll(fd, &init[0], init.size()*sizeof(InitStateRec))) return;
 
-  // Ask the event generation driver to sum up the splines for all enabled
-  // channels
-
-   LOG("gevserv", pNOTICE)
-       << "Requesting total cross section for init state: " 
-       << init_state.AsString();
+  Request req;
+  while(RecvAll(fd, &req, sizeof(req))) {
 
-  evg_driver->CreateXSecSumSpline (
-     1000 /*nknots*/, 0.001 /*Emin*/, 300 /*Emax*/, true /*in-log*/);
+    if(req.op == kOpClose) break;
 
-  const Spline * total_xsec_spl = evg_driver->XSecSumSpline();
-  assert(total_xsec_spl);
+    Reply reply;
+    memset(&reply, 0, sizeof(reply));
 
-  // Send back the cross section data (use 200 MeV bins from 0.010 -> 200.010 GeV)
+    InitialState init_state(req.tgt_pdg, req.nu_pdg);
+    GEVGDriver * evg_driver = gGPool.FindDriver(init_state);
 
-  double dE   =   0.200;
-  double Emin =   0.010;
-  double Emax = 200.010;
-  int    np   = (int) TMath::Ceil((Emax-Emin)/dE);
+    bool valid_op = (req.op == kOpGenerate || req.op == kOpXSec);
+    if(!valid_op || !(req.energy > 0) ||
+       (req.op == kOpGenerate && req.nevents > kMaxBatchSize))
+    {
+      reply.status = kStBadRequest;
+    }
+    else if(!evg_driver) {
+      LOG("gevserv", pERROR)
+        << "No GEVGDriver object for init state: " << init_state.AsString();
+      reply.status = kStNoDriver;
+    }
+    if(reply.status != kStOk) {
+      if(!SendAll(fd, &reply, sizeof(reply))) return;
+      continue;
+    }
 
-  ostringstream xsec_hdr;
-  xsec_hdr <<  kXSecCmdSent << ":" << np;
-  gSock->Send(xsec_hdr.str().c_str());
+    if(req.op == kOpXSec) {
+      TLorentzVector p4(0., 0., req.energy, req.energy);
+      reply.xsec = evg_driver->XSecSum(p4) / units::cm2;
+      if(!SendAll(fd, &reply, sizeof(reply))) return;
+      continue;
+    }
 
-  for(int ip=0; ip<np; ip++) {
-     double E  = Emin + ip*dE;
-     double xs = TMath::Max(0., total_xsec_spl->Evaluate(E) / (1E-38*units::cm2));
-     
-     ostringstream xsec_spl_knot;
-     xsec_spl_knot << ip << " " << E << " " << Form("%15.8e",xs);
-     gSock->Send(xsec_spl_knot.str().c_str());
+    if(!GenerateBatch(fd, req)) return;
   }
-
-  gSock->Send(kXSecOkMesgSent.c_str());
-
-  LOG("gevserv", pINFO) << "...done!";
 }
 //____________________________________________________________________________
-void GenerateEvent(string mesg)
+bool GenerateBatch(int fd, const Request & req)
 {
-  LOG("gevserv", pNOTICE) << "Generating event - Input info : " << mesg;
-
-  if(!gConfigured) {
-      LOG("gevserv", pERROR) 
-             << "Event server is not configured - Can not generate event";
-      gSock->Send(kErrNoConf.c_str());
-      gSock->Send(kErr.c_str());
-      return;
-  }
-
-  // Extract info from the input mesg
-
-  mesg = str::FilterString(kEvgenCmdRecv, mesg); 
-  mesg = str::FilterString(":", mesg); 
-  mesg = str::TrimSpaces(mesg);             
-
-  vector<string> sv = str::Split(mesg," "); 
-
-  assert(sv.size()==11);
-  int    irun        = atoi(sv[0].c_str());  // just pass through
-  int    ievt        = atoi(sv[1].c_str());  // ...
-  int    ipdgnunoosc = atoi(sv[2].c_str());  // ...
-  double vtxx        = atof(sv[3].c_str());  // ...
-  double vtxy        = atof(sv[4].c_str());  // ...
-  double vtxz        = atof(sv[5].c_str());  // ...
-  int    ipdgnu      = atoi(sv[6].c_str());  // neutrino code
-  int    ipdgtgt     = atoi(sv[7].c_str());  // target code
-  double px          = atof(sv[8].c_str());  // neutrino px
-  double py          = atof(sv[9].c_str());  // neutrino py
-  double pz          = atof(sv[10].c_str()); // neutrino pz
-  double E           = TMath::Sqrt(px*px + py*py + pz*pz);
-
-  TLorentzVector p4(px,py,pz,E); 
-     
-  // Find the appropriate event generation driver for the given initial state
-
-  InitialState init_state(ipdgtgt, ipdgnu);
+  InitialState init_state(req.tgt_pdg, req.nu_pdg);
   GEVGDriver * evg_driver = gGPool.FindDriver(init_state);
-  if(!evg_driver) {
-     LOG("gevserv", pERROR)
-       << "No GEVGDriver object for init state: " << init_state.AsString();
-     gSock->Send(kErrNoDriver.c_str());
-     gSock->Send(kErr.c_str());
-     return;
-  }
 
-  // Generate the requested event
-
-  EventRecord * event = evg_driver->GenerateEvent(p4);
-
-  // Check/print the generated event
-  bool failed = (event==0) || event->IsUnphysical();
-  if(failed) {
-      LOG("gevserv", pWARN) 
-              << "Failed to generate the requested event";
-      gSock->Send(kErrNoEvent.c_str());
-      gSock->Send(kErr.c_str());
-      return;
-  }
-  LOG("gevserv", pINFO) << "Generated event: " << *event;
-
-  // Extract some summary info & convert to what MINOS expects
-
-  const Interaction * interaction = event->Summary();
-  const ProcessInfo &  proc_info  = interaction->ProcInfo();
-  const Kinematics &   kine       = interaction->Kine();
-
-  int int_type  = -1;
-  if      (proc_info.IsQuasiElastic())      int_type = 1;
-  else if (proc_info.IsResonant())          int_type = 2;
-  else if (proc_info.IsDeepInelastic())     int_type = 3;
-  else if (proc_info.IsCoherent())          int_type = 4;
-  else if (proc_info.IsInverseMuDecay())    int_type = 5;
-  else if (proc_info.IsNuElectronElastic()) int_type = 6;
-
-  int iaction   = -1;
-  if      (proc_info.IsWeakNC()) iaction = 0;
-  else if (proc_info.IsWeakCC()) iaction = 1;
-  else                           iaction = 2; // cc+nc interference
-
-  int nucleon = -1;
-  GHepParticle * hitnucl = event->HitNucleon();
-  if(hitnucl) {
-    nucleon = hitnucl->Pdg();
-  }
+  double dx = req.dir[0], dy = req.dir[1], dz = req.dir[2];
+  double dnorm = TMath::Sqrt(dx*dx + dy*dy + dz*dz);
+  if(dnorm <= 0) { dx = 0; dy = 0; dz = 1; dnorm = 1; }
+  double pscale = req.energy / dnorm;
+  TLorentzVector p4(dx*pscale, dy*pscale, dz*pscale, req.energy);
+
+  LOG("gevserv", pINFO)
+     << "Generating " << req.nevents << " events for "
+     << init_state.AsString() << " at E = " << req.energy << " GeV";
+
+  Reply reply;
+  memset(&reply, 0, sizeof(reply));
+  reply.status  = kStOk;
+  reply.nevents = req.nevents;
+  reply.xsec    = evg_driver->XSecSum(p4) / units::cm2;
+  if(!SendAll(fd, &reply, sizeof(reply))) return false;
+
+  vector<ParticleRec> parts;
+
+  for(uint32_t ievent = 0; ievent < req.nevents; ievent++) {
+
+    EventRecord * event = 0;
+    for(int itry = 0; itry < kMaxEvgenTries && !event; itry++) {
+      event = evg_driver->GenerateEvent(p4);
+      if(event && event->IsUnphysical()) {
+        delete event;
+        event = 0;
+      }
+    }
 
-  int hitquark  = interaction->InitState().Tgt().HitQrkPdg();
-
-  bool get_selected = true;
-  double xbj_sel   = kine.x (get_selected);
-  double y_sel     = kine.y (get_selected);
-  double W2_sel    = TMath::Power(kine.W (get_selected), 2.);
-  double q2_sel    = -1 * kine.Q2(get_selected);
-
-  double tot_xsec  = event->XSec();
-  double diff_xsec = event->DiffXSec();
-
-  int ihadmode  = 0; // need to fill
-
-  // Send back the event through the tcp/ip socket
-
-  ostringstream hdr1, hdr2, hdr3, hdr4, stdhep_hdr;
-
-  hdr1 
-    << kEvgenHdrCmdSent << ": "
-    << irun             << " " 
-    << ievt             << " " 
-    << ipdgnunoosc      << " "
-    << vtxx             << " " 
-    << vtxy             << " " 
-    << vtxz;
-  hdr2 
-    << ipdgnu  << " " 
-    << ipdgtgt << " " 
-    << px      << " " 
-    << py      << " " 
-    << pz;
-  hdr3 
-    << int_type << " " 
-    << iaction  << " " 
-    << nucleon  << " " 
-    << hitquark << " "
-    << xbj_sel  << " " 
-    << y_sel    << " "  
-    << W2_sel   << " " 
-    << q2_sel;
-  hdr4 
-    << tot_xsec  << " " 
-    << diff_xsec << " " 
-    << ihadmode;
-
-  stdhep_hdr 
-    << kEvgenStdhepCmdSent << ": " 
-    << event->GetEntriesFast();
-
-  gSock->Send(hdr1.str().c_str());
-  gSock->Send(hdr2.str().c_str());
-  gSock->Send(hdr3.str().c_str());
-  gSock->Send(hdr4.str().c_str());
-  gSock->Send(stdhep_hdr.str().c_str());
-
-  unsigned int i=0;
-  TIter event_iter(event);
-  GHepParticle * p = 0;
-  while ( (p = dynamic_cast<GHepParticle *>(event_iter.Next())) ) {
-
-      ostringstream stdhep_entry;
-
-      stdhep_entry 
-  	 << i << " " << p->Status() << " " << p->Pdg() << " "
-         << p->FirstMother()   << " " << p->LastMother()   << " "
-         << p->FirstDaughter() << " " << p->LastDaughter() << " "
-         << p->Px() << " " << p->Py() << " " << p->Pz() << " " << p->E() << " " 
-         << p->Mass() << " "
-         << p->Vx() << " " << p->Vy() << " " << p->Vz() << " " << p->Vt();
-
-      gSock->Send(stdhep_entry.str().c_str());
-      i++;
-  }
+    EventHdr hdr;
+    memset(&hdr, 0, sizeof(hdr));
 
-  // Clean-up and report success
+    if(!event) {
+      LOG("gevserv", pWARN)
+         << "Failed to generate event " << ievent << " - truncating batch";
+      hdr.status = kStFailedEvent;
+      return SendAll(fd, &hdr, sizeof(hdr));
+    }
 
-  delete event;
+    const Interaction * interaction = event->Summary();
+    const Kinematics &  kine        = interaction->Kine();
+    GHepParticle *      hitnucl     = event->HitNucleon();
+
+    bool get_selected = true;
+    hdr.status           = kStOk;
+    hdr.nparticles       = event->GetEntriesFast();
+    hdr.scattering_type  = interaction->ProcInfo().ScatteringTypeId();
+    hdr.interaction_type = interaction->ProcInfo().InteractionTypeId();
+    hdr.hit_nucleon_pdg  = (hitnucl) ? hitnucl->Pdg() : 0;
+    hdr.hit_quark_pdg    = interaction->InitState().Tgt().HitQrkPdg();
+    hdr.xsec             = event->XSec()     / units::cm2;
+    hdr.diff_xsec        = event->DiffXSec() / units::cm2;
+    hdr.weight           = event->Weight();
+    hdr.x                = kine.x (get_selected);
+    hdr.y                = kine.y (get_selected);
+    hdr.Q2               = kine.Q2(get_selected);
+    hdr.W                = kine.W (get_selected);
+
+    parts.resize(hdr.nparticles);
+    for(uint32_t i = 0; i < hdr.nparticles; i++) {
+      GHepParticle * p = event->Particle(i);
+      ParticleRec & rec = parts[i];
+      rec.pdg            = p->Pdg();
+      rec.status         = p->Status();
+      rec.first_mother   = p->FirstMother();
+      rec.last_mother    = p->LastMother();
+      rec.first_daughter = p->FirstDaughter();
+      rec.last_daughter  = p->LastDaughter();
+      rec.rescatter_code = p->RescatterCode();
+      rec.reserved       = 0;
+      rec.p4[0] = p->Px(); rec.p4[1] = p->Py(); rec.p4[2] = p->Pz(); rec.p4[3] = p->E();
+      rec.x4[0] = p->Vx(); rec.x4[1] = p->Vy(); rec.x4[2] = p->Vz(); rec.x4[3] = p->Vt();
+    }
 
-  gSock->Send(kEvgenOkMesgSent.c_str());
+    delete event;
 
-  LOG("gevserv", pINFO) << "...done!";
+    if(!SendAll(fd, &hdr, sizeof(hdr))) return false;
+    if(!parts.empty() &&
+       !SendAll(fd, &parts[0], parts.size()*sizeof(ParticleRec))) return false;
+  }
+  return true;
 }
 //____________________________________________________________________________
-void Shutdown(void)
+void ReapClients(bool block)
 {
-  LOG("gevserv", pNOTICE) << "Shutting GENIE event server down ...";
-
-  gShutDown = true;
-
-  gSock->Send(kShutdownOkMesgSent.c_str());
-
-  LOG("gevserv", pINFO) << "...done!";
+  int   wstatus = 0;
+  pid_t pid;
+  while((pid = waitpid(-1, &wstatus, block ? 0 : WNOHANG)) > 0) {
+    gClients.erase(pid);
+    if(!WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0) {
+      LOG("gevserv", pWARN) << "Client server " << pid << " ended abnormally";
+    }
+    block = false;  // one blocking wait is enough; collect the rest
+  }
 }
 //____________________________________________________________________________
-void RunInitChecks(void)
+void OnSignal(int /*sig*/)
 {
-  if(gSystem->Getenv("GSPLOAD")) {
-    string splines_filename = gSystem->Getenv("GSPLOAD");
-    bool is_accessible = ! (gSystem->AccessPathName( splines_filename.c_str() ));
-    if (!is_accessible) {
-       LOG("gevserv", pWARN) 
-          << "*** The file (" << splines_filename 
-          << ") specified in $GSPLOAD doesn't seem to be available!";
-       LOG("gevserv", pWARN) 
-          << "*** Expect a significant start-up overhead!";
-    }     
-  } else {
-     LOG("gevserv", pWARN) << "*** $GSPLOAD was not set!";
-     LOG("gevserv", pWARN) << "*** Expect a significant start-up overhead!";
+  gShutDown = 1;
+}
+//____________________________________________________________________________
+bool SendAll(int fd, const void * buf, size_t n)
+{
+  const char * p = (const char *) buf;
+  while(n > 0) {
+    ssize_t k = write(fd, p, n);
+    if(k < 0 && errno == EINTR) continue;
+    if(k <= 0) return false;
+    p += k;
+    n -= k;
+  }
+  return true;
+}
+//____________________________________________________________________________
+bool RecvAll(int fd, void * buf, size_t n)
+{
+  char * p = (char *) buf;
+  while(n > 0) {
+    ssize_t k = read(fd, p, n);
+    if(k < 0 && errno == EINTR) continue;
+    if(k <= 0) return false;   // error or client hung up
+    p += k;
+    n -= k;
   }
+  return true;
 }
 //____________________________________________________________________________
 void GetCommandLineArgs(int argc, char ** argv)
 {
   LOG("gevserv", pNOTICE) << "Parsing command line arguments";
 
+  // Common run options (tune, generator list, message thresholds, ...)
+  RunOpt::Instance()->ReadFromCommandLine(argc,argv);
+
   CmdLnArgParser parser(argc,argv);
 
-  // port number:
-  if( parser.OptionExists('p') ) {
-    LOG("gevserv", pINFO) << "Reading port number";
-    gOptPortNum = parser.ArgAsInt('p');
+  // help?
+  if(parser.OptionExists('h')) {
+    PrintSyntax();
+    exit(0);
+  }
+
+  // neutrino and target PDG codes
+  if( parser.OptionExists('p') && parser.OptionExists('t') ) {
+    vector<int> nus  = parser.ArgAsIntTokens('p', ",");
+    vector<int> tgts = parser.ArgAsIntTokens('t', ",");
+    for(unsigned int i = 0; i < nus.size();  i++) gOptNuPdgCodes .push_back(nus[i]);
+    for(unsigned int i = 0; i < tgts.size(); i++) gOptTgtPdgCodes.push_back(tgts[i]);
+  } else {
+    LOG("gevserv", pFATAL)
+       << "Unspecified neutrino or target PDG codes - Exiting";
+    PrintSyntax();
+    exit(1);
+  }
+
+  // socket path
+  if( parser.OptionExists("socket") ) {
+    gOptSocketPath = parser.ArgAsString("socket");
   } else {
     LOG("gevserv", pINFO)
-	<< "Unspecified port number - Using default (" << kDefPortNum << ")";
-    gOptPortNum = kDefPortNum;
+       << "Unspecified socket path - Using default (" << kDefSocketPath << ")";
+    gOptSocketPath = kDefSocketPath;
+  }
+
+  // max number of concurrent clients
+  gOptMaxClients = 0;
+  if( parser.OptionExists("max-clients") ) {
+    gOptMaxClients = parser.ArgAsInt("max-clients");
   }
+
+  // warm-up energy
+  gOptWarmUpEnergy = 0;
+  if( parser.OptionExists("warm-up-energy") ) {
+    gOptWarmUpEnergy = parser.ArgAsDouble("warm-up-energy");
+  }
+
+  // random number seed
+  if( parser.OptionExists("seed") ) {
+    LOG("gevserv", pINFO) << "Reading random number seed";
+    gOptRanSeed = parser.ArgAsLong("seed");
+  } else {
+    LOG("gevserv", pINFO) << "Unspecified random number seed - Using default";
+    gOptRanSeed = -1;
+  }
+
+  // input cross-section file
+  if( parser.OptionExists("cross-sections") ) {
+    LOG("gevserv", pINFO) << "Reading cross-section file";
+    gOptInpXSecFile = parser.ArgAsString("cross-sections");
+  } else {
+    LOG("gevserv", pWARN)
+       << "Unspecified cross-section file - Expect a significant start-up overhead!";
+    gOptInpXSecFile = "";
+  }
+
+  LOG("gevserv", pNOTICE) << "Neutrinos: " << gOptNuPdgCodes;
+  LOG("gevserv", pNOTICE) << "Targets: "   << gOptTgtPdgCodes;
+  LOG("gevserv", pNOTICE) << *RunOpt::Instance();
 }
 //____________________________________________________________________________
 void PrintSyntax(void)
 {
   LOG("gevserv", pNOTICE)
     << "\n\n" << "Syntax:" << "\n"
-    << "   gevserv [-p port] \n";
+    << "   gevserv -p neutrino_codes -t target_codes\n"
+    << "          [--socket path]\n"
+    << "          [--max-clients n]\n"
+    << "          [--warm-up-energy E]\n"
+    << "          [--seed random_number_seed]\n"
+    << "          [--cross-sections xml_file]\n"
+    << RunOpt::RunOptSyntaxString(true)
+    << "\n";
 }
 //____________________________________________________________________________
-
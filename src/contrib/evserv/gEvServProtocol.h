@@ -0,0 +1,116 @@
+//____________________________________________________________________________
+/*!
+
+\file    gEvServProtocol.h
+
+\brief   Wire format of the GENIE event server (gevserv).
+
+         The server listens on a Unix domain socket, so both ends share a
+         host and all fields are sent in host byte order without padding
+         surprises (every record is a multiple of 8 bytes).
+
+         On connection the server sends a ServerHello followed by
+         `ninit` InitStateRec, listing the initial states it can serve.
+         The client then sends any number of Requests:
+
+         kOpGenerate: the server replies with a Reply (status and number
+                      of events to follow) and then streams, per event,
+                      an EventHdr followed by `nparticles` ParticleRec.
+                      An EventHdr with a non-zero status and no particles
+                      ends the batch early.
+         kOpXSec:     the server replies with a Reply carrying the total
+                      cross section (cm^2) at the requested energy.
+         kOpClose:    the server closes the connection.
+
+         Energies and momenta are in GeV, positions in fm (as in GHEP).
+
+\author  GENIE Collaboration
+
+\created October 16, 2026
+
+\cpright Copyright (c) 2003-2023, The GENIE Collaboration
+         For the full text of the license visit http://copyright.genie-mc.org
+
+*/
+//____________________________________________________________________________
+
+#ifndef _GEVSERV_PROTOCOL_H_
+#define _GEVSERV_PROTOCOL_H_
+
+#include <stdint.h>
+
+namespace genie  {
+namespace evserv {
+
+const char     kServerMagic[8] = { 'G','E','V','S','E','R','V','1' };
+const uint32_t kServerVersion  = 1;
+
+typedef enum EOp {
+  kOpGenerate = 1,
+  kOpXSec     = 2,
+  kOpClose    = 3
+} Op_t;
+
+typedef enum EStatus {
+  kStOk          = 0,
+  kStNoDriver    = 1,  ///< no driver configured for the requested init state
+  kStBadRequest  = 2,  ///< unknown op, bad energy or too many events
+  kStFailedEvent = 3   ///< event generation kept failing; batch truncated
+} Status_t;
+
+struct ServerHello {
+  char     magic[8];
+  uint32_t version;
+  uint32_t ninit;
+};
+
+struct InitStateRec {
+  int32_t  nu_pdg;
+  int32_t  tgt_pdg;
+};
+
+struct Request {
+  uint32_t op;
+  uint32_t nevents;
+  int32_t  nu_pdg;
+  int32_t  tgt_pdg;
+  double   energy;   ///< neutrino energy
+  double   dir[3];   ///< neutrino direction (need not be normalized; 0 = +z)
+};
+
+struct Reply {
+  uint32_t status;
+  uint32_t nevents;
+  double   xsec;     ///< total cross section at the requested energy (cm^2)
+};
+
+struct EventHdr {
+  uint32_t status;
+  uint32_t nparticles;
+  int32_t  scattering_type;   ///< ScatteringType_t
+  int32_t  interaction_type;  ///< InteractionType_t
+  int32_t  hit_nucleon_pdg;   ///< 0 if none
+  int32_t  hit_quark_pdg;     ///< 0 if none
+  double   xsec;              ///< cm^2
+  double   diff_xsec;         ///< cm^2 / {K^n}
+  double   weight;
+  double   x, y, Q2, W;       ///< selected kinematics
+};
+
+struct ParticleRec {
+  int32_t  pdg;
+  int32_t  status;
+  int32_t  first_mother;
+  int32_t  last_mother;
+  int32_t  first_daughter;
+  int32_t  last_daughter;
+  int32_t  rescatter_code;
+  int32_t  reserved;
+  double   p4[4];             ///< px, py, pz, E
+  double   x4[4];             ///< x, y, z, t
+};
+
+} // evserv namespace
+} // genie namespace
+
+#endif // _GEVSERV_PROTOCOL_H_
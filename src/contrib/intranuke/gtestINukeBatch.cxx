@@ -0,0 +1,339 @@
+//____________________________________________________________________________
+/*!
+
+\program gtestINukeBatch
+
+\brief   INTRANUKE test program. Generates hadron-nucleus events with the
+         scalar and the batched (INUKE-BatchTransport) hadron transport of
+         Intranuke2018, starting both from the same random number seed, and
+         compares them.
+
+         With a single incident hadron, the hA mode transports only that
+         hadron, and the two paths draw the same random numbers in the same
+         order: the events must be identical, and the comparison is made
+         event by event.
+         In hN mode, the hadrons produced in the first interaction are
+         transported together by the batched path, so the two paths agree
+         statistically only: the mean final state multiplicities and
+         hadronic kinetic energy are compared.
+
+         Syntax :
+           gtestINukeBatch [-n nev] [-p probe] [-t tgt] [-k KE] [-m mode]
+                           [-s max_pull] [--seed seed] --tune tune
+
+         Options :
+           [] Denotes an optional argument
+           -n : Number of events to generate with each path (default: 1000)
+           -p : Incident hadron PDG code (default: 211)
+           -t : Nuclear target PDG code (default: 1000260560)
+           -k : Incident hadron kinetic energy in GeV (default: 0.5)
+           -m : INTRANUKE mode <hA, hN> (default: hA)
+           -s : Largest pull allowed between the mean values in hN mode
+                (default: 4)
+           --seed : Random number seed (default: 1)
+
+         The program returns 0 if the two paths agree, 1 otherwise.
+
+         Example:
+           % gtestINukeBatch -n 10000 -p 2212 -t 1000180400 -k 1.0 -m hN \
+                             --tune G18_10a_02_11b
+
+\author  GENIE Collaboration
+
+\created October 16, 2026
+
+\cpright Copyright (c) 2003-2023, The GENIE Collaboration
+         For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#include <cassert>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <TMath.h>
+#include <TLorentzVector.h>
+
+#include "Framework/Algorithm/AlgFactory.h"
+#include "Framework/Algorithm/Algorithm.h"
+#include "Framework/EventGen/EventRecord.h"
+#include "Framework/EventGen/EventRecordVisitorI.h"
+#include "Framework/GHEP/GHepParticle.h"
+#include "Framework/GHEP/GHepStatus.h"
+#include "Framework/Interaction/Interaction.h"
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/ParticleData/PDGCodes.h"
+#include "Framework/ParticleData/PDGLibrary.h"
+#include "Framework/ParticleData/PDGUtils.h"
+#include "Framework/Registry/Registry.h"
+#include "Framework/Utils/AppInit.h"
+#include "Framework/Utils/CmdLnArgParser.h"
+#include "Framework/Utils/RunOpt.h"
+
+using std::string;
+using std::vector;
+
+using namespace genie;
+
+// an event record entry, as compared between the two paths
+struct Entry_t {
+  int            pdg;
+  int            status;
+  int            mother;
+  TLorentzVector p4;
+};
+typedef vector<Entry_t> Event_t;
+
+// observables compared statistically in hN mode
+const int kNObs = 6;
+const char * kObsName[kNObs] =
+   { "n(p)", "n(n)", "n(pi+)", "n(pi-)", "n(pi0)", "sum KE(had) [GeV]" };
+
+void                  GetCommandLineArgs (int argc, char ** argv);
+void                  PrintSyntax        (void);
+EventRecordVisitorI * GetIntranuke       (bool batch);
+EventRecord *         InitializeEvent    (void);
+void                  Generate           (EventRecordVisitorI * intranuke,
+                                          vector<Event_t> & events);
+void                  Observables        (const Event_t & event, double * obs);
+bool                  SameEvent          (const Event_t & e1, const Event_t & e2);
+
+// command line options
+int      gOptNevents      = 1000;        ///< events per path
+int      gOptProbePdgCode = kPdgPiP;     ///< incident hadron
+int      gOptTgtPdgCode   = 1000260560;  ///< nuclear target
+double   gOptProbeKE      = 0.5;         ///< incident hadron kinetic energy (GeV)
+string   gOptMode         = "hA";        ///< INTRANUKE mode
+double   gOptMaxPull      = 4.;          ///< max pull between the means (hN mode)
+long int gOptRanSeed      = 1;           ///< random number seed
+
+//____________________________________________________________________________
+int main(int argc, char ** argv)
+{
+  GetCommandLineArgs(argc,argv);
+
+  if ( ! RunOpt::Instance()->Tune() ) {
+    LOG("gtestINukeBatch", pFATAL) << " No TuneId in RunOption";
+    exit(-1);
+  }
+  RunOpt::Instance()->BuildTune();
+
+  utils::app_init::MesgThresholds(RunOpt::Instance()->MesgThresholdFiles());
+
+  EventRecordVisitorI * scalar = GetIntranuke(false);
+  EventRecordVisitorI * batch  = GetIntranuke(true);
+
+  // same seed for both paths
+  vector<Event_t> scalar_events;
+  vector<Event_t> batch_events;
+  utils::app_init::RandGen(gOptRanSeed);
+  Generate(scalar, scalar_events);
+  utils::app_init::RandGen(gOptRanSeed);
+  Generate(batch, batch_events);
+
+  delete scalar;
+  delete batch;
+
+  bool ok = true;
+
+  if(gOptMode == "hA") {
+    // event by event
+    int nmismatch = 0;
+    for(int i = 0; i < gOptNevents; i++) {
+      if(SameEvent(scalar_events[i], batch_events[i])) continue;
+      if(nmismatch == 0) {
+        LOG("gtestINukeBatch", pERROR)
+          << "First mismatch between the scalar & batched transport at event "
+          << i;
+      }
+      nmismatch++;
+    }
+    LOG("gtestINukeBatch", pNOTICE)
+      << nmismatch << " / " << gOptNevents << " events differ between the"
+      << " scalar & batched transport";
+    ok = (nmismatch == 0);
+  }
+  else {
+    // statistically: pulls between the means of each observable
+    double sum [2][kNObs] = {{0}};
+    double sum2[2][kNObs] = {{0}};
+    for(int i = 0; i < gOptNevents; i++) {
+      double obs[kNObs];
+      for(int ipath = 0; ipath < 2; ipath++) {
+        Observables((ipath == 0) ? scalar_events[i] : batch_events[i], obs);
+        for(int k = 0; k < kNObs; k++) {
+          sum [ipath][k] += obs[k];
+          sum2[ipath][k] += obs[k]*obs[k];
+        }
+      }
+    }
+    double n = gOptNevents;
+    for(int k = 0; k < kNObs; k++) {
+      double mean[2], var[2];
+      for(int ipath = 0; ipath < 2; ipath++) {
+        mean[ipath] = sum[ipath][k] / n;
+        var [ipath] = TMath::Max(0., sum2[ipath][k]/n - mean[ipath]*mean[ipath]);
+      }
+      double err  = TMath::Sqrt((var[0] + var[1]) / n);
+      double pull = (err > 0) ? (mean[1] - mean[0]) / err : 0.;
+      bool   pass = (TMath::Abs(pull) < gOptMaxPull);
+      LOG("gtestINukeBatch", pNOTICE)
+        << kObsName[k] << " : scalar = " << mean[0] << ", batched = " << mean[1]
+        << ", pull = " << pull << (pass ? "" : "  <-- FAILED");
+      ok = ok && pass;
+    }
+  }
+
+  LOG("gtestINukeBatch", pNOTICE)
+    << "Scalar vs batched INTRANUKE transport (" << gOptMode << "): "
+    << (ok ? "PASSED" : "FAILED");
+
+  return (ok) ? 0 : 1;
+}
+//____________________________________________________________________________
+EventRecordVisitorI * GetIntranuke(bool batch)
+{
+// An INTRANUKE instance owned by the caller, with the batched transport
+// switched on or off
+
+  string sname = "";
+  if      (gOptMode == "hA") sname = "genie::HAIntranuke2018";
+  else if (gOptMode == "hN") sname = "genie::HNIntranuke2018";
+  else {
+    LOG("gtestINukeBatch", pFATAL) << "Invalid Intranuke mode - Exiting";
+    gAbortingInErr = true;
+    exit(1);
+  }
+
+  AlgFactory * algf = AlgFactory::Instance();
+  Algorithm * alg = algf->AdoptAlgorithm(sname, "Default");
+  EventRecordVisitorI * intranuke = dynamic_cast<EventRecordVisitorI *> (alg);
+  assert(intranuke);
+
+  Registry r(alg->GetConfig());
+  r.UnLock();
+  r.Set("INUKE-BatchTransport", batch);
+  alg->Configure(r);
+
+  return intranuke;
+}
+//____________________________________________________________________________
+EventRecord * InitializeEvent(void)
+{
+// Event record with the probe & target entries, as in gevgen_hadron
+
+  EventRecord * evrec = new EventRecord();
+  Interaction * interaction = new Interaction;
+  evrec->AttachSummary(interaction);
+
+  TLorentzVector x4null(0.,0.,0.,0.);
+
+  PDGLibrary * pdglib = PDGLibrary::Instance();
+  double mh  = pdglib -> Find (gOptProbePdgCode) -> Mass();
+  double M   = pdglib -> Find (gOptTgtPdgCode  ) -> Mass();
+
+  double Eh  = mh + gOptProbeKE;
+  double pzh = TMath::Sqrt(TMath::Max(0.,Eh*Eh-mh*mh));
+  TLorentzVector p4h   (0.,0.,pzh,Eh);
+  TLorentzVector p4tgt (0.,0.,0., M);
+
+  GHepStatus_t ist = kIStInitialState;
+  evrec->AddParticle(gOptProbePdgCode, ist, -1,-1,-1,-1, p4h,   x4null);
+  evrec->AddParticle(gOptTgtPdgCode,   ist, -1,-1,-1,-1, p4tgt, x4null);
+
+  return evrec;
+}
+//____________________________________________________________________________
+void Generate(EventRecordVisitorI * intranuke, vector<Event_t> & events)
+{
+  events.clear();
+  for(int ievent = 0; ievent < gOptNevents; ievent++) {
+    EventRecord * evrec = InitializeEvent();
+    intranuke->ProcessEventRecord(evrec);
+
+    Event_t event;
+    for(int i = 0; i < evrec->GetEntries(); i++) {
+      GHepParticle * p = evrec->Particle(i);
+      Entry_t entry;
+      entry.pdg    = p->Pdg();
+      entry.status = p->Status();
+      entry.mother = p->FirstMother();
+      entry.p4     = *(p->P4());
+      event.push_back(entry);
+    }
+    events.push_back(event);
+    delete evrec;
+  }
+}
+//____________________________________________________________________________
+void Observables(const Event_t & event, double * obs)
+{
+  for(int k = 0; k < kNObs; k++) obs[k] = 0;
+
+  Event_t::const_iterator it = event.begin();
+  for( ; it != event.end(); ++it) {
+    if(it->status != kIStStableFinalState) continue;
+    if(it->pdg == kPdgProton ) obs[0]++;
+    if(it->pdg == kPdgNeutron) obs[1]++;
+    if(it->pdg == kPdgPiP    ) obs[2]++;
+    if(it->pdg == kPdgPiM    ) obs[3]++;
+    if(it->pdg == kPdgPi0    ) obs[4]++;
+    if(pdg::IsHadron(it->pdg)) obs[5] += it->p4.E() - it->p4.M();
+  }
+}
+//____________________________________________________________________________
+bool SameEvent(const Event_t & e1, const Event_t & e2)
+{
+  if(e1.size() != e2.size()) return false;
+  for(unsigned int i = 0; i < e1.size(); i++) {
+    const Entry_t & a = e1[i];
+    const Entry_t & b = e2[i];
+    if(a.pdg != b.pdg || a.status != b.status || a.mother != b.mother) return false;
+    for(int j = 0; j < 4; j++) {
+      if(TMath::Abs(a.p4[j] - b.p4[j]) > 1E-9 * TMath::Max(1., TMath::Abs(a.p4[j]))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+//____________________________________________________________________________
+void GetCommandLineArgs(int argc, char ** argv)
+{
+  LOG("gtestINukeBatch", pINFO) << "Parsing command line arguments";
+
+  RunOpt::Instance()->ReadFromCommandLine(argc,argv);
+
+  CmdLnArgParser parser(argc,argv);
+
+  if( parser.OptionExists('n') ) gOptNevents      = parser.ArgAsInt('n');
+  if( parser.OptionExists('p') ) gOptProbePdgCode = parser.ArgAsInt('p');
+  if( parser.OptionExists('t') ) gOptTgtPdgCode   = parser.ArgAsInt('t');
+  if( parser.OptionExists('k') ) gOptProbeKE      = parser.ArgAsDouble('k');
+  if( parser.OptionExists('m') ) gOptMode         = parser.ArgAsString('m');
+  if( parser.OptionExists('s') ) gOptMaxPull      = parser.ArgAsDouble('s');
+  if( parser.OptionExists("seed") ) gOptRanSeed   = parser.ArgAsLong("seed");
+
+  if(gOptNevents <= 0 || gOptProbeKE <= 0 ||
+     (gOptMode != "hA" && gOptMode != "hN")) {
+    PrintSyntax();
+    gAbortingInErr = true;
+    exit(1);
+  }
+
+  LOG("gtestINukeBatch", pNOTICE)
+    << "Comparing the scalar & batched transport with " << gOptNevents
+    << " events of " << gOptProbePdgCode << " + " << gOptTgtPdgCode
+    << " at KE = " << gOptProbeKE << " GeV (mode: " << gOptMode
+    << ", seed: " << gOptRanSeed << ")";
+}
+//____________________________________________________________________________
+void PrintSyntax(void)
+{
+  LOG("gtestINukeBatch", pNOTICE)
+    << "\n\n" << "Syntax:" << "\n"
+    << "   gtestINukeBatch [-n nev] [-p probe] [-t tgt] [-k KE] [-m mode]\n"
+    << "                   [-s max_pull] [--seed seed] --tune tune\n";
+}
+//____________________________________________________________________________
@@ -0,0 +1,164 @@
+//____________________________________________________________________________
+/*!
+
+\program gtestChannelTable
+
+\brief   Tests the tabulated channel selection of PhysInteractionSelector
+         (UseChannelTable) near the channel thresholds.
+
+         Builds an event generation driver for the input initial state with
+         the channel table switched on, and compares the channel frequencies
+         of the tabulated and exact selection just above every table bin
+         where a channel opens or closes, where the interpolated table is
+         the least accurate (see PhysInteractionSelector::ValidateChannelTable).
+
+         Syntax :
+           gtestChannelTable -p probe -t tgt --cross-sections xml_file
+                             [-n nsample] [-c max_chi2ndf] --tune tune
+
+         Options :
+           [] Denotes an optional argument
+           -p : Neutrino PDG code
+           -t : Target PDG code
+           --cross-sections : Cross section splines (XML file)
+           -n : Number of channels drawn per energy (default: 100000)
+           -c : Largest chi2/ndf allowed between the channel frequencies
+                (default: 3)
+
+         The program returns 0 if the tabulated and exact selection agree,
+         1 otherwise.
+
+\author  GENIE Collaboration
+
+\created October 16, 2026
+
+\cpright Copyright (c) 2003-2023, The GENIE Collaboration
+         For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "Framework/Algorithm/AlgConfigPool.h"
+#include "Framework/EventGen/GEVGDriver.h"
+#include "Framework/EventGen/PhysInteractionSelector.h"
+#include "Framework/Interaction/InitialState.h"
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Registry/Registry.h"
+#include "Framework/Utils/AppInit.h"
+#include "Framework/Utils/CmdLnArgParser.h"
+#include "Framework/Utils/RunOpt.h"
+
+using std::string;
+using std::vector;
+
+using namespace genie;
+
+void GetCommandLineArgs (int argc, char ** argv);
+void PrintSyntax        (void);
+
+int    gOptNuPdgCode  = 0;      ///< neutrino
+int    gOptTgtPdgCode = 0;      ///< target
+string gOptXSecFile   = "";     ///< cross section splines
+int    gOptNSample    = 100000; ///< channels drawn per energy
+double gOptMaxChi2    = 3.;     ///< max chi2/ndf
+
+//____________________________________________________________________________
+int main(int argc, char ** argv)
+{
+  GetCommandLineArgs(argc,argv);
+
+  if ( ! RunOpt::Instance()->Tune() ) {
+    LOG("gtestChannelTable", pFATAL) << " No TuneId in RunOption";
+    exit(-1);
+  }
+  RunOpt::Instance()->BuildTune();
+
+  utils::app_init::MesgThresholds(RunOpt::Instance()->MesgThresholdFiles());
+  utils::app_init::XSecTable(gOptXSecFile, true);
+
+  // switch the channel table on, before the driver builds its selector
+  Registry * config = AlgConfigPool::Instance()->FindRegistry(
+                              "genie::PhysInteractionSelector/Default");
+  if(!config) {
+    LOG("gtestChannelTable", pFATAL)
+      << "No configuration for genie::PhysInteractionSelector/Default";
+    exit(1);
+  }
+  config->UnLock();
+  if(config->Exists("UseChannelTable")) config->UnLockItem("UseChannelTable");
+  config->Set("UseChannelTable", true);
+
+  InitialState init_state(gOptTgtPdgCode, gOptNuPdgCode);
+
+  GEVGDriver driver;
+  driver.SetEventGeneratorList(RunOpt::Instance()->EventGeneratorList());
+  driver.UseSplines();
+  driver.Configure(init_state);
+
+  const PhysInteractionSelector * sel =
+     dynamic_cast<const PhysInteractionSelector *> (driver.IntSelector());
+  if(!sel || !sel->HasChannelTable()) {
+    LOG("gtestChannelTable", pFATAL)
+      << "No channel table was built for " << init_state.AsString()
+      << " - Are all the splines in " << gOptXSecFile << "?";
+    exit(1);
+  }
+
+  vector<double> Ethr = sel->ChannelTableThresholds();
+  if(Ethr.empty()) {
+    LOG("gtestChannelTable", pWARN)
+      << "No channel threshold within the table for " << init_state.AsString();
+  }
+
+  bool ok = true;
+  for(unsigned int i = 0; i < Ethr.size(); i++) {
+    double chi2ndf = sel->ValidateChannelTable(Ethr[i], gOptNSample);
+    bool pass = (chi2ndf >= 0 && chi2ndf < gOptMaxChi2);
+    LOG("gtestChannelTable", pNOTICE)
+      << "E = " << Ethr[i] << " GeV: chi2/ndf = " << chi2ndf
+      << (pass ? "" : "  <-- FAILED");
+    ok = ok && pass;
+  }
+
+  LOG("gtestChannelTable", pNOTICE)
+    << "Tabulated vs exact channel selection near " << Ethr.size()
+    << " thresholds: " << (ok ? "PASSED" : "FAILED");
+
+  return (ok) ? 0 : 1;
+}
+//____________________________________________________________________________
+void GetCommandLineArgs(int argc, char ** argv)
+{
+  LOG("gtestChannelTable", pINFO) << "Parsing command line arguments";
+
+  RunOpt::Instance()->ReadFromCommandLine(argc,argv);
+
+  CmdLnArgParser parser(argc,argv);
+
+  if( parser.OptionExists('p') ) gOptNuPdgCode  = parser.ArgAsInt('p');
+  if( parser.OptionExists('t') ) gOptTgtPdgCode = parser.ArgAsInt('t');
+  if( parser.OptionExists('n') ) gOptNSample    = parser.ArgAsInt('n');
+  if( parser.OptionExists('c') ) gOptMaxChi2    = parser.ArgAsDouble('c');
+  if( parser.OptionExists("cross-sections") ) {
+    gOptXSecFile = parser.ArgAsString("cross-sections");
+  }
+
+  if(gOptNuPdgCode == 0 || gOptTgtPdgCode == 0 ||
+     gOptXSecFile.size() == 0 || gOptNSample <= 0) {
+    PrintSyntax();
+    gAbortingInErr = true;
+    exit(1);
+  }
+}
+//____________________________________________________________________________
+void PrintSyntax(void)
+{
+  LOG("gtestChannelTable", pNOTICE)
+    << "\n\n" << "Syntax:" << "\n"
+    << "   gtestChannelTable -p probe -t tgt --cross-sections xml_file\n"
+    << "                     [-n nsample] [-c max_chi2ndf] --tune tune\n";
+}
+//____________________________________________________________________________
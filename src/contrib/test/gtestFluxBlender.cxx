@@ -0,0 +1,170 @@
+//____________________________________________________________________________
+/*!
+
+\program gtestFluxBlender
+
+\brief   Tests the tabulated flavor mixing probabilities of GFluxBlender
+         (--flux-prob-table) against the ones computed by the flavor mixer.
+
+         Mixes a mono-energetic numu flux with two-flavor vacuum
+         oscillations (numu -> nutau), requests the probability table the
+         way a job would, and compares the interpolated probabilities with
+         the exact ones at random (E,L) points within the table.
+
+         Syntax :
+           gtestFluxBlender [--flux-prob-table emin,emax,ne,lmin,lmax,nl]
+                            [-n npoints] [-e max_error]
+
+         Options :
+           [] Denotes an optional argument
+           --flux-prob-table : Table of the mixing probabilities
+                               (default: 0.5,10,200,700000,900000,21)
+           -n : Number of (E,L) points checked (default: 100000)
+           -e : Largest difference allowed between the tabulated and the
+                exact probabilities (default: 0.01)
+
+         The program returns 0 if the tabulated and exact probabilities
+         agree, 1 otherwise.
+
+\author  GENIE Collaboration
+
+\created October 16, 2026
+
+\cpright Copyright (c) 2003-2023, The GENIE Collaboration
+         For the full text of the license visit http://copyright.genie-mc.org
+*/
+//____________________________________________________________________________
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "Framework/Messenger/Messenger.h"
+#include "Framework/Numerical/RandomGen.h"
+#include "Framework/ParticleData/PDGCodes.h"
+#include "Framework/Utils/CmdLnArgParser.h"
+#include "Framework/Utils/RunOpt.h"
+#include "Framework/Utils/StringUtils.h"
+#include "Tools/Flux/GFlavorMixerI.h"
+#include "Tools/Flux/GFluxBlender.h"
+#include "Tools/Flux/GMonoEnergeticFlux.h"
+
+using std::string;
+using std::vector;
+
+using namespace genie;
+using namespace genie::flux;
+
+// two-flavor vacuum oscillations numu <-> nutau, at the atmospheric
+// mass splitting, as a mixer that depends on both energy and distance
+class TwoFlavorMixer : public GFlavorMixerI {
+public:
+  TwoFlavorMixer() : fDm2(2.5e-3), fSin22Theta(1.) { }
+  void   Config(std::string) { }
+  double Probability(int pdg_initial, int pdg_final,
+                     double energy, double dist)
+  {
+    // dist in m, energy in GeV
+    double s = sin(1.267*fDm2*(dist/1000.)/energy);
+    double p = fSin22Theta*s*s;
+    if ( pdg_final == pdg_initial ) return 1.-p;
+    if ( pdg_initial == kPdgNuMu  && pdg_final == kPdgNuTau ) return p;
+    if ( pdg_initial == kPdgNuTau && pdg_final == kPdgNuMu  ) return p;
+    return 0.;
+  }
+  void   PrintConfig(bool) { }
+private:
+  double fDm2;
+  double fSin22Theta;
+};
+
+void GetCommandLineArgs (int argc, char ** argv);
+void PrintSyntax        (void);
+
+int    gOptNPoints  = 100000; ///< (E,L) points checked
+double gOptMaxError = 0.01;   ///< max probability difference
+
+//____________________________________________________________________________
+int main(int argc, char ** argv)
+{
+  GetCommandLineArgs(argc,argv);
+
+  // the blender picks up --flux-prob-table (or $GFLUXPROBTABLE) itself
+  string spec = RunOpt::Instance()->FluxProbTable();
+  if ( spec.size() == 0 && std::getenv("GFLUXPROBTABLE") ) {
+    spec = std::getenv("GFLUXPROBTABLE");
+  }
+  GFluxBlender blender;
+  if ( spec.size() == 0 ) {
+    spec = "0.5,10,200,700000,900000,21";
+    blender.SetProbTableSpec(spec);
+  }
+  blender.AdoptFluxGenerator(new GMonoEnergeticFlux(2., kPdgNuMu));
+  blender.AdoptFlavorMixer(new TwoFlavorMixer);
+  blender.SetBaselineDist(810000.);
+
+  // the table is built before the first neutrino
+  blender.GenerateNext();
+  if ( ! blender.HasProbTable() ) {
+    LOG("gtestFluxBlender", pFATAL)
+      << "No probability table was built for " << spec;
+    exit(1);
+  }
+
+  vector<string> fields = utils::str::Split(spec, ",");
+  double emin = atof(fields[0].c_str());
+  double emax = atof(fields[1].c_str());
+  double lmin = atof(fields[3].c_str());
+  double lmax = atof(fields[4].c_str());
+
+  RandomGen * rnd = RandomGen::Instance();
+  double maxerr = 0;
+  int    nmiss  = 0;
+  for ( int i = 0; i < gOptNPoints; i++ ) {
+    double energy = emin * pow(emax/emin, rnd->RndGen().Rndm());
+    double dist   = lmin + (lmax-lmin) * rnd->RndGen().Rndm();
+    double err = blender.ProbTableError(kPdgNuMu,energy,dist);
+    if ( err < 0 ) { nmiss++; continue; }
+    if ( err > maxerr ) maxerr = err;
+  }
+
+  bool ok = ( nmiss == 0 && maxerr <= gOptMaxError );
+
+  LOG("gtestFluxBlender", pNOTICE)
+    << "Tabulated vs exact mixing probabilities for E = [" << emin
+    << ", " << emax << "] GeV, L = [" << lmin << ", " << lmax << "] m: "
+    << "max difference " << maxerr << " (estimated at build: "
+    << blender.GetProbTableMaxError() << ", allowed: " << gOptMaxError
+    << "), " << nmiss << " points outside the table: "
+    << (ok ? "PASSED" : "FAILED");
+
+  return (ok) ? 0 : 1;
+}
+//____________________________________________________________________________
+void GetCommandLineArgs(int argc, char ** argv)
+{
+  LOG("gtestFluxBlender", pINFO) << "Parsing command line arguments";
+
+  RunOpt::Instance()->ReadFromCommandLine(argc,argv);
+
+  CmdLnArgParser parser(argc,argv);
+
+  if( parser.OptionExists('n') ) gOptNPoints  = parser.ArgAsInt('n');
+  if( parser.OptionExists('e') ) gOptMaxError = parser.ArgAsDouble('e');
+
+  if(gOptNPoints <= 0 || gOptMaxError <= 0) {
+    PrintSyntax();
+    gAbortingInErr = true;
+    exit(1);
+  }
+}
+//____________________________________________________________________________
+void PrintSyntax(void)
+{
+  LOG("gtestFluxBlender", pNOTICE)
+    << "\n\n" << "Syntax:" << "\n"
+    << "   gtestFluxBlender [--flux-prob-table emin,emax,ne,lmin,lmax,nl]\n"
+    << "                    [-n npoints] [-e max_error]\n";
+}
+//____________________________________________________________________________